@@ -22,6 +22,13 @@
 #define CLOCK_UPDATE_INTERVAL_MS 1000  // Update every second
 #define MAX_WIFI_RETRY_COUNT 5
 
+// LVGL Task Configuration
+#define LVGL_TICKLESS 1                // 1: sleep until the next LVGL timer, touch or posted update; 0: poll
+#define LVGL_POLL_PERIOD_MS 10         // Loop period if LVGL_TICKLESS is 0
+#define LVGL_STATS_PERIOD_MS 10000     // Log the wakeups/s and the idle % this often, 0 to disable
+#define TOUCH_INT_GPIO 39              // INT line of the touch controller, -1 if it's not wired
+#define TOUCH_IDLE_POLL_MS 1000        // Touch read period while released, use ~100 without TOUCH_INT_GPIO
+
 // Colors (in hex format)
 #define CLOCK_BG_COLOR 0x001122        // Dark blue background
 #define TIME_TEXT_COLOR 0xFFFFFF       // White time text
@@ -0,0 +1,114 @@
+/**
+ * @file clock_ui.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "clock_ui.h"
+#include "clock_config.h"
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_obj_t *time_label;
+static lv_obj_t *date_label;
+static lv_obj_t *wifi_status_label;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+// Create landscape digital clock screen
+lv_obj_t *clock_ui_create(void)
+{
+    // Create a new screen
+    lv_obj_t *clock_screen = lv_obj_create(NULL);
+    
+    // Set background color to dark blue/black
+    lv_obj_set_style_bg_color(clock_screen, lv_color_hex(CLOCK_BG_COLOR), 0);
+    
+    // Create main container for clock elements
+    lv_obj_t *main_container = lv_obj_create(clock_screen);
+    lv_obj_set_size(main_container, LV_HOR_RES, LV_VER_RES);
+    lv_obj_set_style_bg_opa(main_container, LV_OPA_TRANSP, 0);
+    lv_obj_set_style_border_opa(main_container, LV_OPA_TRANSP, 0);
+    lv_obj_center(main_container);
+    
+    // Create time label (large font)
+    time_label = lv_label_create(main_container);
+    lv_obj_set_style_text_font(time_label, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_color(time_label, lv_color_hex(TIME_TEXT_COLOR), 0);
+    lv_label_set_text(time_label, "00:00:00");
+    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -40);
+    
+    // Create date label (medium font)
+    date_label = lv_label_create(main_container);
+    lv_obj_set_style_text_font(date_label, &lv_font_montserrat_20, 0);
+    lv_obj_set_style_text_color(date_label, lv_color_hex(DATE_TEXT_COLOR), 0);
+    lv_label_set_text(date_label, "Loading...");
+    lv_obj_align(date_label, LV_ALIGN_CENTER, 0, 20);
+    
+    // // Create simson image below the clock
+    // lv_obj_t *simson_img_ = lv_gif_create(main_container);
+    // lv_gif_set_src(simson_img_, &simson);
+    // lv_obj_set_size(simson_img_, 320, 320);  // Set the specified size
+    // lv_obj_align(simson_img_, LV_ALIGN_CENTER, 0, 250);  // Position below the date label
+    
+    // Create WiFi status indicator
+    wifi_status_label = lv_label_create(main_container);
+    lv_obj_set_style_text_font(wifi_status_label, &lv_font_montserrat_14, 0);
+    lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(0x888888), 0);
+    lv_label_set_text(wifi_status_label, "WiFi: Connecting...");
+    lv_obj_align(wifi_status_label, LV_ALIGN_TOP_RIGHT, -10, 10);
+    
+    // Create decorative elements
+    lv_obj_t *line1 = lv_line_create(main_container);
+    static lv_point_t line_points1[] = {{50, 0}, {854 - 100, 0}};
+    lv_line_set_points(line1, line_points1, 2);
+    lv_obj_set_style_line_color(line1, lv_color_hex(ACCENT_LINE_COLOR), 0);
+    lv_obj_set_style_line_width(line1, 2, 0);
+    lv_obj_align(line1, LV_ALIGN_CENTER, 0, -10);
+
+    return clock_screen;
+}
+
+// Update clock display
+void clock_ui_update(const char *time_str, const char *date_str, bool wifi_connected)
+{
+    // Update time
+    lv_label_set_text(time_label, time_str);
+    
+    // Update date
+    lv_label_set_text(date_label, date_str);
+    
+    // Update WiFi status
+    if (wifi_connected) {
+        lv_label_set_text(wifi_status_label, "WiFi: Connected");
+        lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(WIFI_CONNECTED_COLOR), 0);
+    } else {
+        lv_label_set_text(wifi_status_label, "WiFi: Disconnected");
+        lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(WIFI_DISCONNECTED_COLOR), 0);
+    }
+}
+
+// Post the clock changes to the LVGL task
+bool clock_ui_post_update(const char *time_str, const char *date_str, bool wifi_connected)
+{
+    bool ok = true;
+    ok &= lv_cmd_queue_post_text(time_label, time_str);
+    ok &= lv_cmd_queue_post_text(date_label, date_str);
+
+    lv_style_value_t color;
+    if (wifi_connected) {
+        ok &= lv_cmd_queue_post_text(wifi_status_label, "WiFi: Connected");
+        color.color = lv_color_hex(WIFI_CONNECTED_COLOR);
+    } else {
+        ok &= lv_cmd_queue_post_text(wifi_status_label, "WiFi: Disconnected");
+        color.color = lv_color_hex(WIFI_DISCONNECTED_COLOR);
+    }
+    ok &= lv_cmd_queue_post_style(wifi_status_label, LV_STYLE_TEXT_COLOR, color, 0);
+
+    return ok;
+}
@@ -0,0 +1,39 @@
+/**
+ * @file clock_ui.h
+ *
+ * The clock screen. It depends only on LVGL so it's used by the host benchmark too.
+ */
+
+#ifndef CLOCK_UI_H
+#define CLOCK_UI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdbool.h>
+#include "lvgl.h"
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+// Create the clock screen, it's not loaded
+lv_obj_t *clock_ui_create(void);
+
+// Show the time, the date and the WiFi state on the clock screen
+void clock_ui_update(const char *time_str, const char *date_str, bool wifi_connected);
+
+// Same as clock_ui_update() but it can be called from any task.
+// The changes are applied by the LVGL task in its next lv_timer_handler().
+// Returns false if a change was dropped because the command queue was full.
+bool clock_ui_post_update(const char *time_str, const char *date_str, bool wifi_connected);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*CLOCK_UI_H*/
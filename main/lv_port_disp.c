@@ -8,10 +8,15 @@
 // add this 
 #define CONFIG_EXAMPLE_AVOID_TEAR_EFFECT_WITH_SEM 1
 #define CONFIG_EXAMPLE_DOUBLE_FB 0
+// copy the dirty areas into the panel's two frame buffers and swap them once per frame
+#define CONFIG_EXAMPLE_DIRTY_SYNC_FB 1
+// flush in a worker task so LVGL renders the next area while the previous one is transferred
+#define CONFIG_EXAMPLE_ASYNC_FLUSH 1
 /*********************
  *      INCLUDES
  *********************/
 #include "lv_port_disp.h"
+#include "lv_port_fb.h"
 #include "lvgl.h"
 
 /*********************
@@ -23,6 +28,13 @@ esp_lcd_panel_handle_t panel_handle = NULL;
 /**********************
  *      TYPEDEFS
  **********************/
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+typedef struct {
+    lv_disp_drv_t *drv;
+    lv_area_t area;
+    lv_color_t *color_map;
+} flush_job_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -37,11 +49,31 @@ SemaphoreHandle_t sem_vsync_end;
 SemaphoreHandle_t sem_gui_ready;
 #endif
 
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+static lv_port_fb_t fb_backend;
+static lv_port_fb_panel_t fb_panel;
+#endif
+
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+static QueueHandle_t flush_queue;
+static SemaphoreHandle_t sem_flush_done;
+#endif
+
 /**********************
  *      MACROS
  **********************/
 static bool rgb_on_vsync_event(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_panel_event_data_t *event_data, void *user_data);
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void panel_transfer(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map);
+static void flush_done_cb(lv_disp_drv_t *drv);
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+static void fb_backend_init(esp_lcd_panel_handle_t panel);
+static void rgb_panel_swap_cb(lv_port_fb_panel_t *panel, lv_color_t *fb);
+#endif
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+static void flush_worker_task(void *arg);
+static void lvgl_wait_cb(lv_disp_drv_t *drv);
+#endif
 
 /**
  * @brief Clear LCD screen with specified color (line by line)
@@ -142,7 +174,7 @@ esp_err_t lcd_reconfigure_pclk(uint32_t new_pclk_hz) {
 #endif
         },
         .flags.fb_in_psram = true,
-#if CONFIG_EXAMPLE_DOUBLE_FB
+#if CONFIG_EXAMPLE_DOUBLE_FB || CONFIG_EXAMPLE_DIRTY_SYNC_FB
         .flags.double_fb = true,
 #endif
     };
@@ -160,6 +192,11 @@ esp_err_t lcd_reconfigure_pclk(uint32_t new_pclk_hz) {
     ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
 
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+    // The new panel has new frame buffers
+    fb_backend_init(panel_handle);
+#endif
+
     return ESP_OK;
 }
 
@@ -190,6 +227,13 @@ esp_err_t lcd_change_pclk(uint32_t new_pclk_hz)
         lv_disp_enable_invalidation(disp, false);
     }
     
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    // Don't delete the panel under the flush worker
+    while (drv->draw_buf->flushing) {
+        lvgl_wait_cb(drv);
+    }
+#endif
+
     // Reconfigure LCD with new pixel clock
     esp_err_t ret = lcd_reconfigure_pclk(new_pclk_hz);
     if (ret != ESP_OK) {
@@ -275,6 +319,16 @@ void lv_port_disp_init(uint32_t pclk_hz_value)
     assert(sem_gui_ready);
 #endif
 
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    // LVGL has only one flush in progress at a time
+    flush_queue = xQueueCreate(1, sizeof(flush_job_t));
+    assert(flush_queue);
+    sem_flush_done = xSemaphoreCreateBinary();
+    assert(sem_flush_done);
+    BaseType_t task_res = xTaskCreate(flush_worker_task, "lvgl_flush", 1024 * 4, NULL, 5, NULL);
+    assert(task_res == pdPASS);
+#endif
+
     gpio_config_t bk_gpio_config = {
         .mode = GPIO_MODE_OUTPUT,
         .pin_bit_mask = 1ULL << GPIO_LCD_BL};
@@ -366,7 +420,7 @@ void lv_port_disp_init(uint32_t pclk_hz_value)
 #endif
         },
         .flags.fb_in_psram = true,
-#if CONFIG_EXAMPLE_DOUBLE_FB
+#if CONFIG_EXAMPLE_DOUBLE_FB || CONFIG_EXAMPLE_DIRTY_SYNC_FB
         .flags.double_fb = true,
 #endif
     };
@@ -380,6 +434,10 @@ void lv_port_disp_init(uint32_t pclk_hz_value)
     ESP_ERROR_CHECK(esp_lcd_panel_reset(panel_handle));
     ESP_ERROR_CHECK(esp_lcd_panel_init(panel_handle));
 
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+    fb_backend_init(panel_handle);
+#endif
+
     ESP_LOGI(TAG, "Turn on LCD backlight");
     gpio_set_level(GPIO_LCD_BL, 1);
     ESP_LOGI(TAG, "LCD resolution: %dx%d", LCD_WIDTH, LCD_HEIGHT);
@@ -393,10 +451,17 @@ void lv_port_disp_init(uint32_t pclk_hz_value)
     lv_disp_draw_buf_init(&disp_buf, buf1, buf2, LCD_WIDTH * LCD_HEIGHT);
 #else
     ESP_LOGI(TAG, "Allocate separate LVGL draw buffers from PSRAM");
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    // LVGL renders into one partial buffer while the other one is flushed.
+    // (With full screen sized buffers LVGL would wait for the flush before rendering.)
+    uint16_t fact = LCD_HEIGHT / 4;
+#else
     uint16_t fact = LCD_HEIGHT;
+#endif
     buf1 = heap_caps_malloc(LCD_WIDTH * fact * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     assert(buf1);
-#if 1
+    // the frame buffer backend flushes synchronously, without the worker a second draw buffer wouldn't be used
+#if !CONFIG_EXAMPLE_DIRTY_SYNC_FB || CONFIG_EXAMPLE_ASYNC_FLUSH
     buf2 = heap_caps_malloc(LCD_WIDTH * fact * sizeof(lv_color_t), MALLOC_CAP_SPIRAM);
     assert(buf2);
     lv_disp_draw_buf_init(&disp_buf, buf1, buf2, LCD_WIDTH * fact);
@@ -409,12 +474,17 @@ void lv_port_disp_init(uint32_t pclk_hz_value)
     disp_drv.hor_res = LCD_WIDTH;
     disp_drv.ver_res = LCD_HEIGHT;
     disp_drv.flush_cb = lvgl_flush_cb;
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    disp_drv.wait_cb = lvgl_wait_cb;
+#endif
     disp_drv.draw_buf = &disp_buf;
     disp_drv.user_data = panel_handle;
 
     // Enable software rotation
     disp_drv.sw_rotate = 1;
     disp_drv.rotated = LV_DISP_ROT_270;
+    // Render directly in the panel orientation, no rotation pass before flushing
+    disp_drv.render_rotated = 1;
 
 #if CONFIG_EXAMPLE_DOUBLE_FB
     disp_drv.full_refresh = true;
@@ -440,6 +510,26 @@ static bool rgb_on_vsync_event(esp_lcd_panel_handle_t panel, const esp_lcd_rgb_p
 
 static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
 {
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    // Hand the area over to the flush worker and return to rendering
+    flush_job_t job = {
+        .drv = drv,
+        .area = *area,
+        .color_map = color_map,
+    };
+    xQueueSend(flush_queue, &job, portMAX_DELAY);
+#else
+    panel_transfer(drv, area, color_map);
+    flush_done_cb(drv);
+#endif
+}
+
+static void panel_transfer(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_map)
+{
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+    // Copy the area into the back buffer, the buffers are swapped after the last area of the frame
+    lv_port_fb_flush(&fb_backend, area, color_map, lv_disp_flush_is_last(drv));
+#else
     esp_lcd_panel_handle_t panel_handle = (esp_lcd_panel_handle_t)drv->user_data;
     int offsetx1 = area->x1;
     int offsetx2 = area->x2;
@@ -462,10 +552,70 @@ static void lvgl_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t
 
     // Draw the bitmap
     esp_lcd_panel_draw_bitmap(panel_handle, offsetx1, offsety1, offsetx2 + 1, offsety2 + 1, color_map);
-    
+#endif
+}
+
+// Called when the transfer of an area is done
+static void flush_done_cb(lv_disp_drv_t *drv)
+{
     // Notify LVGL that flush is done
     lv_disp_flush_ready(drv);
+
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+    xSemaphoreGive(sem_flush_done);
+#endif
+}
+
+#if CONFIG_EXAMPLE_ASYNC_FLUSH
+static void flush_worker_task(void *arg)
+{
+    flush_job_t job;
+    while (1) {
+        if (xQueueReceive(flush_queue, &job, portMAX_DELAY) != pdTRUE) {
+            continue;
+        }
+
+        panel_transfer(job.drv, &job.area, job.color_map);
+        flush_done_cb(job.drv);
+    }
+}
+
+// Called by LVGL while it waits for the flush worker, block instead of spinning
+static void lvgl_wait_cb(lv_disp_drv_t *drv)
+{
+    xSemaphoreTake(sem_flush_done, pdMS_TO_TICKS(10));
 }
+#endif
+
+#if CONFIG_EXAMPLE_DIRTY_SYNC_FB
+static void fb_backend_init(esp_lcd_panel_handle_t panel)
+{
+    void *fb0 = NULL;
+    void *fb1 = NULL;
+    ESP_ERROR_CHECK(esp_lcd_rgb_panel_get_frame_buffer(panel, 2, &fb0, &fb1));
+
+    fb_panel.swap_cb = rgb_panel_swap_cb;
+    fb_panel.user_data = panel;
+    // The panel shows the first frame buffer after init
+    lv_port_fb_init(&fb_backend, &fb_panel, fb0, fb1, LCD_WIDTH, LCD_HEIGHT);
+}
+
+static void rgb_panel_swap_cb(lv_port_fb_panel_t *panel, lv_color_t *fb)
+{
+    esp_lcd_panel_handle_t handle = (esp_lcd_panel_handle_t)panel->user_data;
+
+    // Passing one of the panel's own frame buffers doesn't copy, the driver switches to it on the next VSYNC
+    esp_lcd_panel_draw_bitmap(handle, 0, 0, LCD_WIDTH, LCD_HEIGHT, fb);
+
+#if CONFIG_EXAMPLE_AVOID_TEAR_EFFECT_WITH_SEM
+    // Wait until the old frame buffer is released, only once per frame
+    xSemaphoreGive(sem_gui_ready);
+    if (xSemaphoreTake(sem_vsync_end, pdMS_TO_TICKS(2000)) != pdTRUE) {
+        ESP_LOGW("LVGL_DISP", "Timeout waiting for VSYNC - proceeding anyway");
+    }
+#endif
+}
+#endif
 
 static void lv_tick_inc_cb(void *data)
 {
@@ -0,0 +1,165 @@
+/**
+ * @file lv_port_fb.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_port_fb.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void copy_area(lv_port_fb_t * fb, lv_color_t * dest, const lv_area_t * area, const lv_color_t * src,
+                      lv_coord_t src_stride);
+static void sync_areas(lv_port_fb_t * fb);
+static void add_area(lv_ll_t * ll, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_port_fb_init(lv_port_fb_t * fb, lv_port_fb_panel_t * panel, lv_color_t * fb0, lv_color_t * fb1,
+                     lv_coord_t hor_res, lv_coord_t ver_res)
+{
+    /*Initialized earlier, drop the areas of the old buffers*/
+    if(fb->areas.n_size) {
+        _lv_ll_clear(&fb->areas);
+        _lv_ll_clear(&fb->sync_areas);
+    }
+
+    lv_memset_00(fb, sizeof(lv_port_fb_t));
+    fb->panel = panel;
+    fb->fb[0] = fb0;
+    fb->fb[1] = fb1;
+    fb->back = 1;
+    fb->hor_res = hor_res;
+    fb->ver_res = ver_res;
+    _lv_ll_init(&fb->areas, sizeof(lv_area_t));
+    _lv_ll_init(&fb->sync_areas, sizeof(lv_area_t));
+}
+
+void lv_port_fb_flush(lv_port_fb_t * fb, const lv_area_t * area, const lv_color_t * color_p, bool last)
+{
+    lv_area_t a;
+    lv_area_t scr = {0, 0, fb->hor_res - 1, fb->ver_res - 1};
+    if(_lv_area_intersect(&a, area, &scr)) {
+        /*Skip the pixels out of the frame buffer*/
+        lv_coord_t src_stride = lv_area_get_width(area);
+        color_p += (a.y1 - area->y1) * src_stride + (a.x1 - area->x1);
+
+        copy_area(fb, fb->fb[fb->back], &a, color_p, src_stride);
+        add_area(&fb->areas, &a);
+        fb->stats.areas++;
+        fb->stats.px_copied += lv_area_get_size(&a);
+    }
+
+    if(!last) return;
+
+    /*Nothing was drawn in this frame, no reason to swap*/
+    if(_lv_ll_is_empty(&fb->areas)) return;
+
+    sync_areas(fb);
+
+    fb->panel->swap_cb(fb->panel, fb->fb[fb->back]);
+    fb->back ^= 1;
+    fb->stats.frames++;
+}
+
+lv_color_t * lv_port_fb_get_front(lv_port_fb_t * fb)
+{
+    return fb->fb[fb->back ^ 1];
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void copy_area(lv_port_fb_t * fb, lv_color_t * dest, const lv_area_t * area, const lv_color_t * src,
+                      lv_coord_t src_stride)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    dest += (int32_t)area->y1 * fb->hor_res + area->x1;
+
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(dest, src, w * sizeof(lv_color_t));
+        dest += fb->hor_res;
+        src += src_stride;
+    }
+}
+
+/**
+ * Copy the areas of the previous frame which were not redrawn in this frame from the front buffer.
+ * Works the same way as `refr_sync_areas()` in direct mode.
+ */
+static void sync_areas(lv_port_fb_t * fb)
+{
+    lv_area_t res[4];
+    int8_t res_c;
+    int8_t j;
+    lv_area_t * area;
+    lv_area_t * sync_area;
+    lv_area_t * next_area;
+    lv_area_t * new_area;
+
+    /*Remove the redrawn parts from the sync areas*/
+    _LV_LL_READ(&fb->areas, area) {
+        sync_area = _lv_ll_get_head(&fb->sync_areas);
+        while(sync_area != NULL) {
+            next_area = _lv_ll_get_next(&fb->sync_areas, sync_area);
+
+            res_c = _lv_area_diff(res, sync_area, area);
+            if(res_c != -1) {
+                for(j = 0; j < res_c; j++) {
+                    new_area = _lv_ll_ins_prev(&fb->sync_areas, sync_area);
+                    LV_ASSERT_MALLOC(new_area);
+                    if(new_area == NULL) break;
+                    *new_area = res[j];
+                }
+                _lv_ll_remove(&fb->sync_areas, sync_area);
+                lv_mem_free(sync_area);
+            }
+
+            sync_area = next_area;
+        }
+    }
+
+    /*Copy what remained from the front buffer*/
+    lv_color_t * front = lv_port_fb_get_front(fb);
+    _LV_LL_READ(&fb->sync_areas, sync_area) {
+        copy_area(fb, fb->fb[fb->back], sync_area, front + (int32_t)sync_area->y1 * fb->hor_res + sync_area->x1,
+                  fb->hor_res);
+        fb->stats.px_synced += lv_area_get_size(sync_area);
+    }
+
+    /*The areas of this frame will be missing from the other buffer*/
+    _lv_ll_clear(&fb->sync_areas);
+    fb->sync_areas = fb->areas;
+    _lv_ll_init(&fb->areas, sizeof(lv_area_t));
+}
+
+static void add_area(lv_ll_t * ll, const lv_area_t * area)
+{
+    lv_area_t * new_area = _lv_ll_ins_tail(ll);
+    LV_ASSERT_MALLOC(new_area);
+    if(new_area == NULL) return;
+    *new_area = *area;
+}
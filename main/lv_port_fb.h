@@ -0,0 +1,100 @@
+/**
+ * @file lv_port_fb.h
+ *
+ * Flush backend for panels with two frame buffers.
+ * The dirty areas of a frame are copied into the back buffer and the buffers
+ * are swapped once per frame, so there is only one VSYNC wait per frame.
+ * It depends only on LVGL, the panel is accessed through `lv_port_fb_panel_t`.
+ */
+
+#ifndef LV_PORT_FB_H
+#define LV_PORT_FB_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lvgl.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+struct _lv_port_fb_panel_t;
+
+/**
+ * The panel's part of the backend
+ */
+typedef struct _lv_port_fb_panel_t {
+    /** Start showing `fb` and return only when the previously shown buffer is not read anymore,
+     *  i.e. wait for the next VSYNC. Called once per frame.*/
+    void (*swap_cb)(struct _lv_port_fb_panel_t * panel, lv_color_t * fb);
+    void * user_data;
+} lv_port_fb_panel_t;
+
+typedef struct {
+    uint32_t frames;        /*Number of buffer swaps*/
+    uint32_t areas;         /*Number of flushed areas*/
+    uint32_t px_copied;     /*Pixels copied from LVGL's draw buffer*/
+    uint32_t px_synced;     /*Pixels copied from the front buffer to keep the back buffer up to date*/
+} lv_port_fb_stats_t;
+
+typedef struct {
+    lv_port_fb_panel_t * panel;
+    lv_color_t * fb[2];
+    uint8_t back;           /*Index of the buffer which is not shown*/
+    lv_coord_t hor_res;
+    lv_coord_t ver_res;
+    lv_ll_t areas;          /*Areas flushed in the current frame*/
+    lv_ll_t sync_areas;     /*Areas flushed in the previous frame, missing from the back buffer*/
+    lv_port_fb_stats_t stats;
+} lv_port_fb_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize a frame buffer flush backend. Can be called again e.g. when the panel is recreated.
+ * @param fb        pointer to an uninitialized or a previously initialized backend
+ * @param panel     pointer to the panel's callbacks. Only the pointer is saved.
+ * @param fb0       the frame buffer shown currently
+ * @param fb1       the other frame buffer
+ * @param hor_res   horizontal resolution of the frame buffers
+ * @param ver_res   vertical resolution of the frame buffers
+ */
+void lv_port_fb_init(lv_port_fb_t * fb, lv_port_fb_panel_t * panel, lv_color_t * fb0, lv_color_t * fb1,
+                     lv_coord_t hor_res, lv_coord_t ver_res);
+
+/**
+ * Copy a rendered area into the back buffer. After the last area of a frame the areas of the previous frame
+ * which were not redrawn are synced from the front buffer and the buffers are swapped.
+ * @param fb        pointer to a backend
+ * @param area      the area to copy, in the frame buffers' coordinates
+ * @param color_p   the rendered pixels of `area`
+ * @param last      true: this is the last area of the frame (see `lv_disp_flush_is_last()`)
+ */
+void lv_port_fb_flush(lv_port_fb_t * fb, const lv_area_t * area, const lv_color_t * color_p, bool last);
+
+/**
+ * Get the buffer which is shown currently
+ * @param fb        pointer to a backend
+ * @return          pointer to the front buffer
+ */
+lv_color_t * lv_port_fb_get_front(lv_port_fb_t * fb);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PORT_FB_H*/
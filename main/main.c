@@ -5,6 +5,8 @@
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
 #include "freertos/event_groups.h"
+#include "freertos/queue.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_system.h"
 #include "esp_wifi.h"
@@ -13,19 +15,25 @@
 #include "esp_sntp.h"
 #include "nvs_flash.h"
 #include "lvgl.h"
+#include "src/draw/sw/lv_draw_sw.h"
 #include "lv_port_disp.h"
 #include "lv_port_indev.h"
 #include <dirent.h>          // Added for DIR/opendir/readdir/closedir
 
 #include "esp_spiffs.h"
+#include "esp_partition.h"
 #include "esp_heap_caps.h"
+#include "esp_timer.h"
+#include "driver/gpio.h"
 #include "clock_config.h"
+#include "clock_ui.h"
 
 // External declaration for simson image
 // LV_IMG_DECLARE(simson);
 
 static const char *TAG = "digital_clock";
 static const char *LOG_SPIFFS = "spiffs";
+static const char *LOG_IMGPACK = "imgpack";
 
 // WiFi credentials - modify these in clock_config.h
 #define WIFI_SSID DEFAULT_WIFI_SSID
@@ -37,9 +45,6 @@ static EventGroupHandle_t s_wifi_event_group;
 #define WIFI_FAIL_BIT      BIT1
 
 // Clock UI elements
-static lv_obj_t *time_label;
-static lv_obj_t *date_label;
-static lv_obj_t *wifi_status_label;
 static lv_obj_t *clock_screen;
 
 // Task handles
@@ -213,11 +218,194 @@ void list_files_in_spiffs(void) {
 
     closedir(dir);
 }
+
+// Images converted by lvgl/scripts/imgpack_conv.py, e.g. lv_img_set_src(img, lv_imgpack_get(&img_pack, "name"))
+static lv_imgpack_t img_pack;
+
+// Map the image pack partition into the address space. Its uncompressed images are drawn from flash without copying.
+static void init_imgpack(void)
+{
+    const esp_partition_t *part = esp_partition_find_first(ESP_PARTITION_TYPE_DATA, 0x40, "imgpack");
+    if (part == NULL) {
+        ESP_LOGW(LOG_IMGPACK, "No imgpack partition");
+        return;
+    }
+
+    const void *data;
+    esp_partition_mmap_handle_t handle;
+    esp_err_t ret = esp_partition_mmap(part, 0, part->size, ESP_PARTITION_MMAP_DATA, &data, &handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(LOG_IMGPACK, "Failed to map the imgpack partition (%s)", esp_err_to_name(ret));
+        return;
+    }
+
+    if (lv_imgpack_open_data(&img_pack, data, part->size) != LV_RES_OK) {
+        ESP_LOGW(LOG_IMGPACK, "No valid image pack in the partition");
+        esp_partition_munmap(handle);
+        return;
+    }
+    ESP_LOGI(LOG_IMGPACK, "%lu images", (unsigned long)img_pack.img_cnt);
+}
+
+static void *img_cache_alloc(size_t size)
+{
+    return heap_caps_malloc(size, MALLOC_CAP_SPIRAM);
+}
+
+// Decode the next fragment of the JPGs in advance in another task while LVGL draws
+static QueueHandle_t sjpg_queue;
+static SemaphoreHandle_t sjpg_done;
+
+static void sjpg_worker_task(void *arg)
+{
+    lv_sjpg_job_t *job;
+    while (1) {
+        if (xQueueReceive(sjpg_queue, &job, portMAX_DELAY) == pdTRUE) {
+            lv_sjpg_job_run(job);
+            xSemaphoreGive(sjpg_done);
+        }
+    }
+}
+
+static bool sjpg_submit(lv_sjpg_job_t *job)
+{
+    return xQueueSend(sjpg_queue, &job, 0) == pdTRUE;
+}
+
+static void sjpg_wait(lv_sjpg_job_t *job)
+{
+    while (!job->done) {
+        xSemaphoreTake(sjpg_done, portMAX_DELAY);
+    }
+}
+
+static void init_sjpg_worker(void)
+{
+    sjpg_queue = xQueueCreate(4, sizeof(lv_sjpg_job_t *));
+    sjpg_done = xSemaphoreCreateBinary();
+    if (sjpg_queue == NULL || sjpg_done == NULL ||
+        xTaskCreate(sjpg_worker_task, "sjpg_worker", 1024 * 4, NULL, 3, NULL) != pdPASS) {
+        ESP_LOGW(TAG, "No JPG worker, the fragments are decoded in the LVGL task");
+        return;
+    }
+    lv_sjpg_set_worker(sjpg_submit, sjpg_wait);
+}
+
+// Decode the PNGs of the async images in another task while LVGL keeps refreshing
+static QueueHandle_t img_async_queue;
+static SemaphoreHandle_t img_async_done;
+
+static void img_async_worker_task(void *arg)
+{
+    lv_img_async_job_t *job;
+    while (1) {
+        if (xQueueReceive(img_async_queue, &job, portMAX_DELAY) == pdTRUE) {
+            lv_img_async_job_run(job);
+            xSemaphoreGive(img_async_done);
+        }
+    }
+}
+
+static bool img_async_submit(lv_img_async_job_t *job)
+{
+    return xQueueSend(img_async_queue, &job, 0) == pdTRUE;
+}
+
+static void img_async_wait(lv_img_async_job_t *job)
+{
+    while (!job->done) {
+        xSemaphoreTake(img_async_done, portMAX_DELAY);
+    }
+}
+
+static void init_img_async_worker(void)
+{
+    img_async_queue = xQueueCreate(1, sizeof(lv_img_async_job_t *));
+    img_async_done = xSemaphoreCreateBinary();
+    if (img_async_queue == NULL || img_async_done == NULL ||
+        xTaskCreate(img_async_worker_task, "img_async_worker", 1024 * 6, NULL, 2, NULL) != pdPASS) {
+        ESP_LOGW(TAG, "No image worker, the async images are decoded in the LVGL task");
+        return;
+    }
+    lv_img_async_set_worker(img_async_submit, img_async_wait);
+}
+
+// Draw the lower band of large blends and images on the other core while the LVGL task draws the upper one
+static QueueHandle_t draw_bands_queue;
+static SemaphoreHandle_t draw_bands_done;
+
+static void draw_bands_worker_task(void *arg)
+{
+    lv_draw_sw_bands_job_t *job;
+    while (1) {
+        if (xQueueReceive(draw_bands_queue, &job, portMAX_DELAY) == pdTRUE) {
+            lv_draw_sw_bands_job_run(job);
+            xSemaphoreGive(draw_bands_done);
+        }
+    }
+}
+
+static bool draw_bands_submit(lv_draw_sw_bands_job_t *job)
+{
+    return xQueueSend(draw_bands_queue, &job, 0) == pdTRUE;
+}
+
+static void draw_bands_wait(lv_draw_sw_bands_job_t *job)
+{
+    while (!job->done) {
+        xSemaphoreTake(draw_bands_done, portMAX_DELAY);
+    }
+}
+
+static void init_draw_bands_worker(void)
+{
+    draw_bands_queue = xQueueCreate(LV_DRAW_SW_BANDS - 1, sizeof(lv_draw_sw_bands_job_t *));
+    draw_bands_done = xSemaphoreCreateBinary();
+    if (draw_bands_queue == NULL || draw_bands_done == NULL ||
+        xTaskCreatePinnedToCore(draw_bands_worker_task, "draw_bands", 1024 * 4, NULL, 4, NULL, 0) != pdPASS) {
+        ESP_LOGW(TAG, "No band worker, everything is drawn in the LVGL task");
+        return;
+    }
+    lv_draw_sw_bands_set_worker(draw_bands_submit, draw_bands_wait);
+}
+
+#if LVGL_TICKLESS
+static uint32_t lvgl_tick_get(void)
+{
+    return (uint32_t)(esp_timer_get_time() / 1000);
+}
+
+// Called when another task (or an interrupt) posts a UI update to the command queue
+static void lvgl_wakeup(void)
+{
+    if (lvgl_task_handle == NULL) return;
+    if (xPortInIsrContext()) {
+        BaseType_t woken = pdFALSE;
+        vTaskNotifyGiveFromISR(lvgl_task_handle, &woken);
+        portYIELD_FROM_ISR(woken);
+    } else {
+        xTaskNotifyGive(lvgl_task_handle);
+    }
+}
+#endif
+
 // Initialize LVGL hardware
 void lvgl_hardware_init()
 {
     ESP_ERROR_CHECK(bsp_i2c_init(I2C_NUM_0, 400000));
     lv_init();
+
+    // Keep the decoded PNG/JPG pixels of the image cache, the cached GIF frames, JPG fragments, glyphs and file blocks in PSRAM
+    lv_img_cache_set_mem_cb(img_cache_alloc, heap_caps_free);
+    lv_gif_set_cache_mem_cb(img_cache_alloc, heap_caps_free);
+    lv_sjpg_set_cache_mem_cb(img_cache_alloc, heap_caps_free);
+    lv_glyph_cache_set_mem_cb(img_cache_alloc, heap_caps_free);
+    lv_fs_cache_set_mem_cb(img_cache_alloc, heap_caps_free);
+    init_sjpg_worker();
+    init_img_async_worker();
+    init_draw_bands_worker();
+
+    init_imgpack();
     
     // Use consistent pixel clock speed
     uint32_t pclk = 10 * 1000 * 1000;  // 10 MHz
@@ -225,7 +413,13 @@ void lvgl_hardware_init()
     ESP_LOGI("LCD PCLK", "Using PCLK: %lu MHz", pclk / 1000000);
     
     lv_port_indev_init();
+#if LVGL_TICKLESS
+    // The tick is read from the monotonic clock, no periodic interrupt is needed for it
+    lv_tick_set_cb(lvgl_tick_get);
+    lv_cmd_queue_set_notify_cb(lvgl_wakeup);
+#else
     lv_port_tick_init();
+#endif
     // lv_port_fs_init(); // Initialize file system support for GIF
 }
 
@@ -274,55 +468,7 @@ void touch_io_reset(void)
 // Create landscape digital clock screen
 void create_clock_screen(void)
 {
-    // Create a new screen
-    clock_screen = lv_obj_create(NULL);
-    
-    // Set background color to dark blue/black
-    lv_obj_set_style_bg_color(clock_screen, lv_color_hex(CLOCK_BG_COLOR), 0);
-    
-    // Create main container for clock elements
-    lv_obj_t *main_container = lv_obj_create(clock_screen);
-    lv_obj_set_size(main_container, LV_HOR_RES, LV_VER_RES);
-    lv_obj_set_style_bg_opa(main_container, LV_OPA_TRANSP, 0);
-    lv_obj_set_style_border_opa(main_container, LV_OPA_TRANSP, 0);
-    lv_obj_center(main_container);
-    
-    // Create time label (large font)
-    time_label = lv_label_create(main_container);
-    lv_obj_set_style_text_font(time_label, &lv_font_montserrat_48, 0);
-    lv_obj_set_style_text_color(time_label, lv_color_hex(TIME_TEXT_COLOR), 0);
-    lv_label_set_text(time_label, "00:00:00");
-    lv_obj_align(time_label, LV_ALIGN_CENTER, 0, -40);
-    
-    // Create date label (medium font)
-    date_label = lv_label_create(main_container);
-    lv_obj_set_style_text_font(date_label, &lv_font_montserrat_20, 0);
-    lv_obj_set_style_text_color(date_label, lv_color_hex(DATE_TEXT_COLOR), 0);
-    lv_label_set_text(date_label, "Loading...");
-    lv_obj_align(date_label, LV_ALIGN_CENTER, 0, 20);
-    
-    // // Create simson image below the clock
-    // lv_obj_t *simson_img_ = lv_gif_create(main_container);
-    // lv_gif_set_src(simson_img_, &simson);
-    // lv_obj_set_size(simson_img_, 320, 320);  // Set the specified size
-    // lv_obj_align(simson_img_, LV_ALIGN_CENTER, 0, 250);  // Position below the date label
-    
-    // Create WiFi status indicator
-    wifi_status_label = lv_label_create(main_container);
-    lv_obj_set_style_text_font(wifi_status_label, &lv_font_montserrat_14, 0);
-    lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(0x888888), 0);
-    lv_label_set_text(wifi_status_label, "WiFi: Connecting...");
-    lv_obj_align(wifi_status_label, LV_ALIGN_TOP_RIGHT, -10, 10);
-    
-    // Create decorative elements
-    lv_obj_t *line1 = lv_line_create(main_container);
-    static lv_point_t line_points1[] = {{50, 0}, {854 - 100, 0}};
-    lv_line_set_points(line1, line_points1, 2);
-    lv_obj_set_style_line_color(line1, lv_color_hex(ACCENT_LINE_COLOR), 0);
-    lv_obj_set_style_line_width(line1, 2, 0);
-    lv_obj_align(line1, LV_ALIGN_CENTER, 0, -10);
-
-
+    clock_screen = clock_ui_create();
 
     // Load the screen
     lv_scr_load(clock_screen);
@@ -331,29 +477,17 @@ void create_clock_screen(void)
 }
 
 // Update clock display
+// Runs in the clock task, so the changes are posted to the LVGL task instead of setting the labels here
 void update_clock_display(void)
 {
     char time_str[32];
     char date_str[64];
-    char wifi_str[32];
     
-    // Update time
     get_time_string(time_str, sizeof(time_str));
-    lv_label_set_text(time_label, time_str);
-    
-    // Update date
     get_date_string(date_str, sizeof(date_str));
-    lv_label_set_text(date_label, date_str);
-    
-    // Update WiFi status
-    if (wifi_connected) {
-        snprintf(wifi_str, sizeof(wifi_str), "WiFi: Connected");
-        lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(WIFI_CONNECTED_COLOR), 0);
-    } else {
-        snprintf(wifi_str, sizeof(wifi_str), "WiFi: Disconnected");
-        lv_obj_set_style_text_color(wifi_status_label, lv_color_hex(WIFI_DISCONNECTED_COLOR), 0);
+    if (!clock_ui_post_update(time_str, date_str, wifi_connected)) {
+        ESP_LOGW(TAG, "UI command queue is full, the clock is updated on the next tick");
     }
-    lv_label_set_text(wifi_status_label, wifi_str);
 }
 
 // Clock update task
@@ -365,12 +499,92 @@ void clock_update_task(void *arg)
     }
 }
 
+#if TOUCH_INT_GPIO >= 0
+// The touch controller pulls its INT line when it has new data. Read it at once then and
+// poll only slowly while the screen isn't touched, in case an edge was missed.
+extern lv_indev_t *indev_touchpad;
+static volatile bool touch_irq;
+
+static void IRAM_ATTR touch_isr(void *arg)
+{
+    touch_irq = true;
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(lvgl_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
+
+static void init_touch_irq(void)
+{
+    gpio_config_t io_conf = {
+        .pin_bit_mask = 1ULL << TOUCH_INT_GPIO,
+        .mode = GPIO_MODE_INPUT,
+        .pull_up_en = GPIO_PULLUP_ENABLE,
+        .intr_type = GPIO_INTR_NEGEDGE,
+    };
+    esp_err_t err = gpio_config(&io_conf);
+    if (err == ESP_OK) {
+        err = gpio_install_isr_service(0);
+        if (err == ESP_ERR_INVALID_STATE) err = ESP_OK;   // Already installed
+    }
+    if (err == ESP_OK) err = gpio_isr_handler_add(TOUCH_INT_GPIO, touch_isr, NULL);
+    if (err != ESP_OK) {
+        ESP_LOGW(TAG, "No touch interrupt (%s), the touch is polled", esp_err_to_name(err));
+        return;
+    }
+    lv_timer_set_period(indev_touchpad->driver->read_timer, TOUCH_IDLE_POLL_MS);
+}
+
+static void touch_update_read_period(void)
+{
+    lv_timer_t *read_timer = indev_touchpad->driver->read_timer;
+    if (touch_irq) {
+        touch_irq = false;
+        lv_timer_set_period(read_timer, LV_INDEV_DEF_READ_PERIOD);
+        lv_timer_ready(read_timer);
+    } else if (indev_touchpad->proc.state == LV_INDEV_STATE_RELEASED) {
+        lv_timer_set_period(read_timer, TOUCH_IDLE_POLL_MS);
+    }
+}
+#endif
+
+// Log how often the LVGL task woke up and how much of the time it was busy
+static void lvgl_log_stats(uint32_t busy_us)
+{
+#if LVGL_STATS_PERIOD_MS
+    static int64_t start_us;
+    static uint32_t wakeups;
+    static uint64_t busy_sum_us;
+
+    int64_t now_us = esp_timer_get_time();
+    if (start_us == 0) start_us = now_us;
+    wakeups++;
+    busy_sum_us += busy_us;
+
+    int64_t elapsed_us = now_us - start_us;
+    if (elapsed_us < LVGL_STATS_PERIOD_MS * 1000LL) return;
+
+    uint32_t wakeups_x10 = (uint32_t)(wakeups * 10000000ULL / elapsed_us);
+    uint32_t idle_x100 = (uint32_t)(10000 - busy_sum_us * 10000 / elapsed_us);
+    ESP_LOGI(TAG, "LVGL: %lu.%lu wakeups/s, busy %lu us/s, %lu.%02lu%% idle",
+             wakeups_x10 / 10, wakeups_x10 % 10, (uint32_t)(busy_sum_us * 1000000 / elapsed_us),
+             idle_x100 / 100, idle_x100 % 100);
+    start_us = now_us;
+    wakeups = 0;
+    busy_sum_us = 0;
+#else
+    (void)busy_us;
+#endif
+}
+
 // Main LVGL task
 void lvgl_task(void *arg)
 {
     // Initialize touch and hardware
     touch_io_reset();
     lvgl_hardware_init();
+#if LVGL_TICKLESS && TOUCH_INT_GPIO >= 0
+    init_touch_irq();
+#endif
     ESP_LOGI(TAG, "LVGL initialized");
 
     // Create and display clock screen
@@ -382,8 +596,22 @@ void lvgl_task(void *arg)
     // Main LVGL loop
     while (1)
     {
-        lv_task_handler();
-        vTaskDelay(pdMS_TO_TICKS(10));
+        int64_t start_us = esp_timer_get_time();
+#if LVGL_TICKLESS && TOUCH_INT_GPIO >= 0
+        touch_update_read_period();
+#endif
+        uint32_t wait_ms = lv_task_handler();
+        lvgl_log_stats((uint32_t)(esp_timer_get_time() - start_us));
+
+#if LVGL_TICKLESS
+        // Sleep until the next LVGL timer is due or a touch or a posted update wakes us up
+        TickType_t wait_ticks = portMAX_DELAY;
+        if (wait_ms != LV_NO_TIMER_READY) wait_ticks = (wait_ms + portTICK_PERIOD_MS - 1) / portTICK_PERIOD_MS;
+        ulTaskNotifyTake(pdTRUE, wait_ticks);
+#else
+        (void)wait_ms;
+        vTaskDelay(pdMS_TO_TICKS(LVGL_POLL_PERIOD_MS));
+#endif
     }
 }
 
@@ -428,7 +656,7 @@ void app_main(void)
     }
     
     // Create LVGL task on Core 1
-    xTaskCreate(lvgl_task, "lvgl_task", 1024*80, NULL, 4, &lvgl_task_handle);
+    xTaskCreatePinnedToCore(lvgl_task, "lvgl_task", 1024*80, NULL, 4, &lvgl_task_handle, 1);
     
     // Log memory info
     ESP_LOGI("MEM", "Internal RAM free: %zu bytes", heap_caps_get_free_size(MALLOC_CAP_INTERNAL));
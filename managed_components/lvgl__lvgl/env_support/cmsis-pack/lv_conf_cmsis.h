@@ -79,6 +79,15 @@
 /*Input device read period in milliseconds*/
 #define LV_INDEV_DEF_READ_PERIOD 30     /*[ms]*/
 
+/*Number of commands which can wait in the queue of `lv_cmd_queue_post_...()`.
+ *Other threads post text, style and value changes there without locks and `lv_timer_handler` applies them.
+ *Must be a power of 2. 0: to disable the command queue*/
+#define LV_CMD_QUEUE_LEN 0
+
+/*Maximal length of a text posted with `lv_cmd_queue_post_text()`, including the terminating 0.
+ *Every command of the queue has this size at least.*/
+#define LV_CMD_QUEUE_TEXT_LEN 32
+
 
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
@@ -130,6 +139,11 @@
     #define LV_CIRCLE_CACHE_SIZE 4
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Max. number of horizontal bands the software renderer splits large blends and images into.
+ *The bands are drawn in parallel by the workers set with `lv_draw_sw_bands_set_worker()`.
+ *1: draw everything in the LVGL thread*/
+#define LV_DRAW_SW_BANDS 1
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -153,6 +167,17 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE 0
 
+/*Default memory budget of the image cache in bytes.
+ *The least recently used images are closed to stay within the budget and larger images are not cached.
+ *0: no limit, only the number of images is limited*/
+#define LV_IMG_CACHE_DEF_BUDGET 0
+
+/*Number of images which can wait to be decoded in the background for `lv_img`s with `lv_img_set_async`.
+ *A placeholder is drawn until the image is decoded into the image cache by the worker thread
+ *set with `lv_img_async_set_worker` or in `lv_timer_handler`. Requires LV_IMG_CACHE_DEF_SIZE.
+ *0: to disable decoding in the background*/
+#define LV_IMG_ASYNC_QUEUE_LEN 0
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS 2
@@ -179,6 +204,12 @@
  *Only used if software rotation is enabled in the display driver.*/
 #define LV_DISP_ROT_MAX_BUF (10*1024)
 
+/*Number of style snapshots. A snapshot keeps the resolved draw properties (colors, opacities, widths, font etc.)
+ *of a part of an object in a state, so redrawing the object doesn't search its styles again.
+ *About 64 * sizeof(lv_style_value_t) bytes are used per snapshot.
+ *0: to disable the snapshots*/
+#define LV_OBJ_STYLE_SNAPSHOT_CNT 0
+
 /*-------------
  * GPU
  *-----------*/
@@ -407,6 +438,18 @@
 /*Enable drawing placeholders when glyph dsc is not found*/
 #define LV_USE_FONT_PLACEHOLDER 1
 
+/*Default memory budget of the glyph cache in bytes.
+ *The unpacked glyphs are cached to draw the letters faster.
+ *0: to disable the glyph cache*/
+#define LV_GLYPH_CACHE_DEF_BUDGET 0
+
+/*Find the glyphs of the letters of the built-in (lv_font_fmt_txt) fonts with an index instead of searching the cmaps.
+ *The index is built at the first use or can be generated into the font's C file with `scripts/font_index_gen.py`
+ *0: no index, search the cmaps
+ *1: hash table of the code points (~12 bytes/glyph)
+ *2: hash table plus direct lookup pages for the dense blocks of the BMP (e.g. CJK). Fastest but uses more memory*/
+#define LV_FONT_FMT_TXT_INDEX 0
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -601,6 +644,14 @@
 
 /*File system interfaces for common APIs */
 
+/*Default memory budget of the block cache of the files in bytes.
+ *The files of the drivers below are read in blocks which are shared by the opened files of the same path.
+ *0: to disable the block cache*/
+#define LV_FS_CACHE_DEF_BUDGET 0
+
+/*Size of a cached block in bytes*/
+#define LV_FS_CACHE_BLOCK_SIZE 512
+
 /*API for fopen, fread, etc*/
 #define LV_USE_FS_STDIO 0
 #if LV_USE_FS_STDIO
@@ -29,6 +29,7 @@ extern "C" {
 #include "src/misc/lv_async.h"
 #include "src/misc/lv_anim_timeline.h"
 #include "src/misc/lv_printf.h"
+#include "src/misc/lv_fs_cache.h"
 
 #include "src/hal/lv_hal.h"
 
@@ -38,10 +39,12 @@ extern "C" {
 #include "src/core/lv_refr.h"
 #include "src/core/lv_disp.h"
 #include "src/core/lv_theme.h"
+#include "src/core/lv_cmd_queue.h"
 
 #include "src/font/lv_font.h"
 #include "src/font/lv_font_loader.h"
 #include "src/font/lv_font_fmt_txt.h"
+#include "src/font/lv_glyph_cache.h"
 
 #include "src/widgets/lv_arc.h"
 #include "src/widgets/lv_btn.h"
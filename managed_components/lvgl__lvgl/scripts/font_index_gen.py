@@ -0,0 +1,212 @@
+#!/usr/bin/env python3
+
+'''
+Generates the code point index (lv_font_fmt_txt_index_t) of a font converted to C by lv_font_conv
+and adds it to the font's C file. With the index the glyph of a letter is found without searching the cmaps
+and without building the index in RAM at the first use of the font.
+
+Usage: font_index_gen.py [--mode hash|pages] [--page-min N] lv_font_xyz.c
+
+The file is updated in place. Running it again replaces the index.
+'''
+
+import argparse
+import re
+import sys
+
+INDEX_BEGIN = "/*--------------------\n *  CODE POINT INDEX\n *--------------------*/\n"
+INDEX_END = "/*End of the code point index*/\n"
+CUSTOM_DATA = "/*--------------------\n *  ALL CUSTOM DATA\n *--------------------*/\n"
+
+CMAP_FORMAT0_TINY = "LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY"
+CMAP_FORMAT0_FULL = "LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL"
+CMAP_SPARSE_TINY = "LV_FONT_FMT_TXT_CMAP_SPARSE_TINY"
+CMAP_SPARSE_FULL = "LV_FONT_FMT_TXT_CMAP_SPARSE_FULL"
+
+
+def parse_array(src, name):
+    m = re.search(r"\b" + re.escape(name) + r"\[\]\s*=\s*\{(.*?)\};", src, re.S)
+    if not m:
+        sys.exit("Array %s not found" % name)
+    body = re.sub(r"/\*.*?\*/", "", m.group(1), flags=re.S)
+    return [int(v, 0) for v in body.replace("\n", " ").split(",") if v.strip()]
+
+
+def parse_cmaps(src):
+    m = re.search(r"lv_font_fmt_txt_cmap_t cmaps\[\]\s*=\s*\{(.*?)\n\};", src, re.S)
+    if not m:
+        sys.exit("cmaps not found")
+
+    cmaps = []
+    for entry in re.findall(r"\{([^{}]*)\}", m.group(1)):
+        fields = dict(re.findall(r"\.(\w+)\s*=\s*([\w]+)", entry))
+        cmap = {
+            "start": int(fields["range_start"], 0),
+            "length": int(fields["range_length"], 0),
+            "gid_start": int(fields["glyph_id_start"], 0),
+            "type": fields["type"],
+            "unicode_list": None,
+            "gid_ofs_list": None,
+        }
+        if fields["unicode_list"] != "NULL":
+            cmap["unicode_list"] = parse_array(src, fields["unicode_list"])
+        if fields["glyph_id_ofs_list"] != "NULL":
+            cmap["gid_ofs_list"] = parse_array(src, fields["glyph_id_ofs_list"])
+        cmaps.append(cmap)
+    return cmaps
+
+
+def search_glyph_id(cmaps, letter):
+    '''The same as search_glyph_dsc_id() in lv_font_fmt_txt.c: the first cmap whose range has the letter decides'''
+    for cmap in cmaps:
+        rcp = letter - cmap["start"]
+        if rcp < 0 or rcp >= cmap["length"]:
+            continue
+        if cmap["type"] == CMAP_FORMAT0_TINY:
+            return cmap["gid_start"] + rcp
+        if cmap["type"] == CMAP_FORMAT0_FULL:
+            return cmap["gid_start"] + cmap["gid_ofs_list"][rcp]
+        ulist = cmap["unicode_list"]
+        if rcp not in ulist:
+            return 0
+        ofs = ulist.index(rcp)
+        if cmap["type"] == CMAP_SPARSE_TINY:
+            return cmap["gid_start"] + ofs
+        return cmap["gid_start"] + cmap["gid_ofs_list"][ofs]
+    return 0
+
+
+def in_first_tiny_cmap(cmaps, letter):
+    '''These letters are found without the index, see get_glyph_dsc_id() in lv_font_fmt_txt.c'''
+    return cmaps[0]["type"] == CMAP_FORMAT0_TINY and 0 <= letter - cmaps[0]["start"] < cmaps[0]["length"]
+
+
+def collect_glyphs(cmaps):
+    glyphs = {}
+    for cmap in cmaps:
+        if cmap["type"] in (CMAP_FORMAT0_TINY, CMAP_FORMAT0_FULL):
+            letters = range(cmap["start"], cmap["start"] + cmap["length"])
+        else:
+            letters = [cmap["start"] + u for u in cmap["unicode_list"]]
+        for letter in letters:
+            if in_first_tiny_cmap(cmaps, letter):
+                continue
+            gid = search_glyph_id(cmaps, letter)
+            if gid:
+                glyphs[letter] = gid
+    if glyphs and max(glyphs.values()) > 0xFFFF:
+        sys.exit("Can't index fonts with more than 65535 glyphs")
+    return glyphs
+
+
+def index_hash(letter, bits):
+    return ((letter * 0x9E3779B1) & 0xFFFFFFFF) >> (32 - bits)
+
+
+def build_index(glyphs, mode, page_min):
+    block_cnt = [0] * 256
+    for letter in glyphs:
+        if letter <= 0xFFFF:
+            block_cnt[letter >> 8] += 1
+
+    page_map = [0] * 256
+    page_cnt = 0
+    if mode == "pages":
+        for b in range(256):
+            if block_cnt[b] >= page_min:
+                page_cnt += 1
+                page_map[b] = page_cnt
+
+    pages = [0] * (page_cnt * 256)
+    hashed = {}
+    for letter, gid in glyphs.items():
+        if letter <= 0xFFFF and page_map[letter >> 8]:
+            pages[(page_map[letter >> 8] - 1) * 256 + (letter & 0xFF)] = gid
+        else:
+            hashed[letter] = gid
+
+    # At most 3/4 full as in index_build() in lv_font_fmt_txt.c
+    bits = 0
+    if hashed:
+        bits = 1
+        while (1 << bits) * 3 < len(hashed) * 4:
+            bits += 1
+
+    keys = [0] * (1 << bits) if bits else []
+    gids = [0] * (1 << bits) if bits else []
+    for letter in sorted(hashed):
+        slot = index_hash(letter, bits)
+        while keys[slot]:
+            slot = (slot + 1) & ((1 << bits) - 1)
+        keys[slot] = letter
+        gids[slot] = hashed[letter]
+
+    return page_map if page_cnt else None, pages, keys, gids, page_cnt, bits
+
+
+def c_array(ctype, name, values):
+    lines = []
+    for i in range(0, len(values), 16):
+        lines.append("    " + ", ".join(hex(v) for v in values[i:i + 16]))
+    return "static const %s %s[] = {\n%s\n};\n\n" % (ctype, name, ",\n".join(lines))
+
+
+def gen_index(glyphs, mode, page_min):
+    page_map, pages, keys, gids, page_cnt, bits = build_index(glyphs, mode, page_min)
+
+    out = INDEX_BEGIN + "\n"
+    out += "/*Generated by scripts/font_index_gen.py --mode %s --page-min %d*/\n" % (mode, page_min)
+    if page_cnt:
+        out += c_array("uint16_t", "index_page_map", page_map)
+        out += c_array("uint16_t", "index_pages", pages)
+    if bits:
+        out += c_array("uint32_t", "index_hash_keys", keys)
+        out += c_array("uint16_t", "index_hash_glyph_ids", gids)
+
+    out += "static const lv_font_fmt_txt_index_t font_index = {\n"
+    out += "    .page_map = %s, .pages = %s,\n" % (("index_page_map", "index_pages") if page_cnt else ("NULL", "NULL"))
+    out += "    .hash_keys = %s, .hash_glyph_ids = %s,\n" % (
+        ("index_hash_keys", "index_hash_glyph_ids") if bits else ("NULL", "NULL"))
+    out += "    .page_cnt = %d, .hash_bits = %d\n" % (page_cnt, bits)
+    out += "};\n\n" + INDEX_END + "\n"
+
+    size = (256 + len(pages)) * 2 if page_cnt else 0
+    size += len(keys) * 6
+    return out, size, page_cnt, bits
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--mode", choices=["hash", "pages"], default="pages",
+                        help="pages: direct lookup pages for the dense blocks of the BMP, hash table for the rest")
+    parser.add_argument("--page-min", type=int, default=48,
+                        help="minimal number of glyphs in a 256 code point block to get a page")
+    parser.add_argument("font", help="C file of the font")
+    args = parser.parse_args()
+
+    with open(args.font, "r", encoding="utf-8") as f:
+        src = f.read()
+
+    # Drop the previous index
+    if INDEX_BEGIN in src:
+        start = src.index(INDEX_BEGIN)
+        end = src.index(INDEX_END) + len(INDEX_END) + 1
+        src = src[:start] + src[end:]
+    src = src.replace("    .cache = &cache,\n    .index = &font_index\n", "    .cache = &cache\n")
+
+    glyphs = collect_glyphs(parse_cmaps(src))
+    index, size, page_cnt, bits = gen_index(glyphs, args.mode, args.page_min)
+
+    if CUSTOM_DATA not in src or "    .cache = &cache\n" not in src:
+        sys.exit("Not a font generated by lv_font_conv")
+    src = src.replace(CUSTOM_DATA, index + CUSTOM_DATA, 1)
+    src = src.replace("    .cache = &cache\n", "    .cache = &cache,\n    .index = &font_index\n", 1)
+
+    with open(args.font, "w", encoding="utf-8") as f:
+        f.write(src)
+
+    print("%d glyphs, %d pages, %d hash slots, %d bytes" % (len(glyphs), page_cnt, (1 << bits) if bits else 0, size))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,413 @@
+#!/usr/bin/env python3
+
+'''
+Converts PNG images into an image pack for lv_imgpack: the pixels are stored in LVGL's color formats
+for the color depth of the target, so they are drawn without decoding. The images can be compressed
+in tiles of rows with RLE or LZ4 to decode only the rows that are drawn.
+
+Usage: imgpack_conv.py -o pack.lvip --color-depth 8|16|32 [--swap] [--compress none|rle|lz4] [--tile-h N]
+                       [name=]image.png[:cf] ...
+
+The name of an image is the file name without extension if it's not given.
+The color format (cf) is one of auto, true_color, true_color_alpha, rgb565a8, a8, i1, i2, i4, i8.
+auto: indexed with palette images, rgb565a8 (16 bit) or true_color_alpha with transparent pixels, else true_color.
+'''
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+PACK_MAGIC = b"LVIP"
+PACK_VERSION = 1
+PACK_FLAG_16_SWAP = 0x01
+NAME_MAX = 32
+
+# lv_img_cf_t of LVGL
+CF_TRUE_COLOR = 4
+CF_TRUE_COLOR_ALPHA = 5
+CF_INDEXED_1BIT = 7
+CF_INDEXED_2BIT = 8
+CF_INDEXED_4BIT = 9
+CF_INDEXED_8BIT = 10
+CF_ALPHA_8BIT = 14
+CF_RGB565A8 = 20
+
+CF_NAMES = {
+    "true_color": CF_TRUE_COLOR,
+    "true_color_alpha": CF_TRUE_COLOR_ALPHA,
+    "rgb565a8": CF_RGB565A8,
+    "a8": CF_ALPHA_8BIT,
+    "i1": CF_INDEXED_1BIT,
+    "i2": CF_INDEXED_2BIT,
+    "i4": CF_INDEXED_4BIT,
+    "i8": CF_INDEXED_8BIT,
+}
+
+COMPRESS = {"none": 0, "rle": 1, "lz4": 2}
+
+
+class Png:
+    '''A decoded PNG: RGBA pixels, and the palette and the indices of palette images'''
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            data = f.read()
+        if data[:8] != b"\x89PNG\r\n\x1a\n":
+            sys.exit("%s: not a PNG file" % path)
+
+        idat = b""
+        plte = None
+        trns = None
+        pos = 8
+        while pos + 8 <= len(data):
+            length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+            chunk = data[pos + 8:pos + 8 + length]
+            pos += 12 + length
+            if kind == b"IHDR":
+                self.w, self.h, depth, color_type, _, _, interlace = struct.unpack(">IIBBBBB", chunk)
+            elif kind == b"PLTE":
+                plte = chunk
+            elif kind == b"tRNS":
+                trns = chunk
+            elif kind == b"IDAT":
+                idat += chunk
+            elif kind == b"IEND":
+                break
+
+        if interlace:
+            sys.exit("%s: interlaced images are not supported" % path)
+
+        channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[color_type]
+        bpp = channels * depth
+        stride = (self.w * bpp + 7) // 8
+        raw = unfilter(zlib.decompress(idat), self.h, stride, max(1, bpp // 8))
+
+        self.palette = None
+        self.indices = None
+        if color_type == 3:
+            self.palette = []
+            for i in range(len(plte) // 3):
+                a = trns[i] if trns and i < len(trns) else 255
+                self.palette.append(tuple(plte[i * 3:i * 3 + 3]) + (a,))
+
+        self.rgba = []
+        if color_type == 3:
+            self.indices = []
+        for y in range(self.h):
+            row = raw[y * stride:(y + 1) * stride]
+            samples = unpack_samples(row, self.w * channels, depth)
+            for x in range(self.w):
+                s = samples[x * channels:(x + 1) * channels]
+                if color_type == 3:
+                    self.indices.append(s[0])
+                    self.rgba.append(self.palette[s[0]])
+                    continue
+                key = tuple(s)
+                s = [to_8bit(v, depth) for v in s]
+                if color_type == 0:
+                    a = 0 if trns and key[0] == struct.unpack(">H", trns[:2])[0] else 255
+                    self.rgba.append((s[0], s[0], s[0], a))
+                elif color_type == 2:
+                    a = 0 if trns and key == struct.unpack(">HHH", trns[:6]) else 255
+                    self.rgba.append((s[0], s[1], s[2], a))
+                elif color_type == 4:
+                    self.rgba.append((s[0], s[0], s[0], s[1]))
+                else:
+                    self.rgba.append(tuple(s))
+
+    def has_alpha(self):
+        return any(p[3] != 255 for p in self.rgba)
+
+
+def unfilter(data, h, stride, bpp):
+    out = bytearray()
+    prev = bytearray(stride)
+    pos = 0
+    for _ in range(h):
+        ftype = data[pos]
+        line = bytearray(data[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + ((a + b) >> 1)) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                pred = a if pa <= pb and pa <= pc else (b if pb <= pc else c)
+                line[i] = (line[i] + pred) & 0xFF
+        out += line
+        prev = line
+    return out
+
+
+def unpack_samples(row, cnt, depth):
+    if depth == 8:
+        return list(row[:cnt])
+    if depth == 16:
+        return [row[i * 2] << 8 | row[i * 2 + 1] for i in range(cnt)]
+    mask = (1 << depth) - 1
+    return [(row[(i * depth) >> 3] >> (8 - depth - ((i * depth) & 7))) & mask for i in range(cnt)]
+
+
+def to_8bit(v, depth):
+    if depth == 16:
+        return v >> 8
+    if depth < 8:
+        return v * 255 // ((1 << depth) - 1)
+    return v
+
+
+def color_bytes(rgb, depth, swap):
+    '''The same as lv_color_make()'''
+    r, g, b = rgb[:3]
+    if depth == 8:
+        return bytes([(r >> 5) << 5 | (g >> 5) << 2 | b >> 6])
+    if depth == 16:
+        c = (r >> 3) << 11 | (g >> 2) << 5 | b >> 3
+        return struct.pack(">H" if swap else "<H", c)
+    return bytes([b, g, r, 0xFF])
+
+
+def convert(png, cf, depth, swap):
+    '''Get the rows of an image in LVGL's layout, the palette of indexed images and the alpha plane of RGB565A8'''
+    w = png.w
+    palette = b""
+    rows = []
+    alpha = []
+
+    if cf in (CF_TRUE_COLOR, CF_TRUE_COLOR_ALPHA, CF_RGB565A8):
+        for y in range(png.h):
+            line = bytearray()
+            for p in png.rgba[y * w:(y + 1) * w]:
+                line += color_bytes(p, depth, swap)
+                if cf == CF_TRUE_COLOR_ALPHA:
+                    if depth == 32:
+                        line[-1] = p[3]
+                    else:
+                        line.append(p[3])
+            rows.append(bytes(line))
+            if cf == CF_RGB565A8:
+                alpha.append(bytes(p[3] for p in png.rgba[y * w:(y + 1) * w]))
+    elif cf == CF_ALPHA_8BIT:
+        for y in range(png.h):
+            rows.append(bytes(p[3] for p in png.rgba[y * w:(y + 1) * w]))
+    else:
+        bpp = 1 << (cf - CF_INDEXED_1BIT)
+        if png.palette is not None:
+            colors = png.palette
+            indices = png.indices
+        else:
+            colors = sorted(set(png.rgba))
+            lookup = {c: i for i, c in enumerate(colors)}
+            indices = [lookup[p] for p in png.rgba]
+        if max(indices) >= 1 << bpp:
+            sys.exit("Too many colors for %d bit indexed image" % bpp)
+        colors = list(colors) + [(0, 0, 0, 0)] * ((1 << bpp) - len(colors))
+        # lv_color32_t: blue, green, red, alpha
+        palette = b"".join(bytes([c[2], c[1], c[0], c[3]]) for c in colors[:1 << bpp])
+        for y in range(png.h):
+            line = bytearray((w * bpp + 7) // 8)
+            for x, idx in enumerate(indices[y * w:(y + 1) * w]):
+                bit = x * bpp
+                line[bit >> 3] |= idx << (8 - bpp - (bit & 7))
+            rows.append(bytes(line))
+
+    return palette, rows, alpha
+
+
+def auto_cf(png, depth):
+    if png.palette is not None:
+        cnt = max(png.indices) + 1
+        for cf in (CF_INDEXED_1BIT, CF_INDEXED_2BIT, CF_INDEXED_4BIT, CF_INDEXED_8BIT):
+            if cnt <= 1 << (1 << (cf - CF_INDEXED_1BIT)):
+                return cf
+    if png.has_alpha():
+        return CF_RGB565A8 if depth == 16 else CF_TRUE_COLOR_ALPHA
+    return CF_TRUE_COLOR
+
+
+def rle_encode(data, unit):
+    '''A control byte c: bit 7 set, one unit repeated (c & 0x7F) + 1 times; else c + 1 different units'''
+    units = [data[i:i + unit] for i in range(0, len(data), unit)]
+    out = bytearray()
+    literals = []
+
+    def flush():
+        while literals:
+            part = literals[:128]
+            del literals[:128]
+            out.append(len(part) - 1)
+            out.extend(b"".join(part))
+
+    i = 0
+    while i < len(units):
+        run = 1
+        while i + run < len(units) and run < 128 and units[i + run] == units[i]:
+            run += 1
+        if run >= 2:
+            flush()
+            out.append(0x80 | (run - 1))
+            out.extend(units[i])
+            i += run
+        else:
+            literals.append(units[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def lz4_length(out, n):
+    while n >= 255:
+        out.append(255)
+        n -= 255
+    out.append(n)
+
+
+def lz4_encode(data):
+    '''Greedy LZ4 block compression. The end of the block follows the rules of the LZ4 block format.'''
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    match_limit = len(data) - 12
+    while i < match_limit:
+        key = data[i:i + 4]
+        ref = table.get(key)
+        table[key] = i
+        if ref is None or i - ref > 0xFFFF:
+            i += 1
+            continue
+        length = 4
+        while i + length < len(data) - 5 and data[ref + length] == data[i + length]:
+            length += 1
+
+        lit = i - anchor
+        out.append((min(lit, 15) << 4) | min(length - 4, 15))
+        if lit >= 15:
+            lz4_length(out, lit - 15)
+        out += data[anchor:i]
+        out += struct.pack("<H", i - ref)
+        if length - 4 >= 15:
+            lz4_length(out, length - 4 - 15)
+
+        i += length
+        anchor = i
+
+    lit = len(data) - anchor
+    out.append(min(lit, 15) << 4)
+    if lit >= 15:
+        lz4_length(out, lit - 15)
+    out += data[anchor:]
+    return bytes(out)
+
+
+def pack_image(png, cf, depth, swap, compress, tile_h):
+    palette, rows, alpha = convert(png, cf, depth, swap)
+    if compress == "none":
+        return palette + b"".join(rows) + b"".join(alpha), png.h
+
+    if cf in (CF_TRUE_COLOR, CF_RGB565A8):
+        unit = depth // 8
+    elif cf == CF_TRUE_COLOR_ALPHA:
+        unit = 4 if depth == 32 else depth // 8 + 1
+    else:
+        unit = 1
+
+    tiles = []
+    for y in range(0, png.h, tile_h):
+        color = b"".join(rows[y:y + tile_h])
+        alpha_plane = b"".join(alpha[y:y + tile_h])
+        if compress == "lz4":
+            tiles.append(lz4_encode(color + alpha_plane))
+        else:
+            tiles.append(rle_encode(color, unit) + rle_encode(alpha_plane, 1))
+
+    # Offsets of the tiles from the start of the image and the end of the last tile
+    ofs = len(palette) + (len(tiles) + 1) * 4
+    table = bytearray()
+    for t in tiles:
+        table += struct.pack("<I", ofs)
+        ofs += len(t)
+    table += struct.pack("<I", ofs)
+    return palette + bytes(table) + b"".join(tiles), tile_h
+
+
+def parse_input(arg):
+    name = None
+    cf = "auto"
+    if "=" in arg:
+        name, arg = arg.split("=", 1)
+    if ":" in arg and arg.rsplit(":", 1)[1] in list(CF_NAMES) + ["auto"]:
+        arg, cf = arg.rsplit(":", 1)
+    if name is None:
+        name = os.path.splitext(os.path.basename(arg))[0]
+    if len(name.encode()) >= NAME_MAX:
+        sys.exit("Image name %s is too long" % name)
+    return name, arg, cf
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-o", "--output", required=True, help="the pack file to write")
+    parser.add_argument("--color-depth", type=int, choices=[8, 16, 32], required=True, help="LV_COLOR_DEPTH")
+    parser.add_argument("--swap", action="store_true", help="LV_COLOR_16_SWAP is enabled")
+    parser.add_argument("--compress", choices=list(COMPRESS), default="none",
+                        help="compression of the tiles. Uncompressed images can be drawn directly from memory.")
+    parser.add_argument("--tile-h", type=int, default=16, help="rows per compressed tile")
+    parser.add_argument("images", nargs="+", help="[name=]image.png[:cf]")
+    args = parser.parse_args()
+
+    if args.swap and args.color_depth != 16:
+        sys.exit("--swap is only for 16 bit colors")
+    if not 1 <= args.tile_h <= 0xFFFF:
+        sys.exit("Invalid tile height")
+
+    entries = {}
+    for arg in args.images:
+        name, path, cf_name = parse_input(arg)
+        if name in entries:
+            sys.exit("Image name %s is used twice" % name)
+        png = Png(path)
+        if not (1 <= png.w <= 2047 and 1 <= png.h <= 2047):
+            sys.exit("%s: the size of the images is limited to 2047x2047" % path)
+        cf = auto_cf(png, args.color_depth) if cf_name == "auto" else CF_NAMES[cf_name]
+        if cf == CF_RGB565A8 and args.color_depth != 16:
+            sys.exit("%s: rgb565a8 is only for 16 bit colors" % path)
+        data, tile_h = pack_image(png, cf, args.color_depth, args.swap, args.compress, args.tile_h)
+        entries[name] = (png, cf, data, tile_h)
+
+    names = sorted(entries, key=lambda n: n.encode())
+    out = bytearray(PACK_MAGIC)
+    out += struct.pack("<BBBBII", PACK_VERSION, args.color_depth, PACK_FLAG_16_SWAP if args.swap else 0, 0,
+                       len(names), 0)
+
+    # The image data is aligned to 4 bytes to draw the pixels in place
+    ofs = len(out) + len(names) * 48
+    index = bytearray()
+    blobs = bytearray()
+    for name in names:
+        png, cf, data, tile_h = entries[name]
+        ofs = (ofs + 3) & ~3
+        blobs += bytes(ofs - len(out) - len(names) * 48 - len(blobs))
+        index += struct.pack("<32sIIHHBBH", name.encode(), ofs, len(data), png.w, png.h, cf,
+                             COMPRESS[args.compress], tile_h)
+        blobs += data
+        ofs += len(data)
+
+    with open(args.output, "wb") as f:
+        f.write(out + index + blobs)
+
+    print("%s: %d images, %d bytes" % (args.output, len(names), len(out) + len(index) + len(blobs)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,358 @@
+/**
+ * @file lv_cmd_queue.c
+ *
+ * A bounded multi-producer single-consumer ring (D. Vyukov's design).
+ * Every slot has a sequence number telling the producers and the consumer whose turn it is:
+ * - `seq == pos`: free, the producer reserving `pos` fills it
+ * - `seq == pos + 1`: filled, the LVGL thread can apply it
+ * - `seq == pos + LEN`: applied, free for the next round
+ * The producers reserve a position with a compare-and-swap and the slot is published by
+ * the release store of its sequence number, so neither side waits for a lock.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_cmd_queue.h"
+#include "lv_obj.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_log.h"
+#include "../widgets/lv_label.h"
+
+#if LV_CMD_QUEUE_LEN
+
+#if (LV_CMD_QUEUE_LEN & (LV_CMD_QUEUE_LEN - 1)) != 0
+    #error "LV_CMD_QUEUE_LEN must be a power of 2"
+#endif
+
+#if !defined(__GNUC__) && !defined(__clang__)
+    #error "The command queue requires the __atomic builtins of GCC or Clang"
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#define QUEUE_MASK (LV_CMD_QUEUE_LEN - 1)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef enum {
+    CMD_TEXT,
+    CMD_STYLE,
+    CMD_VALUE,
+} cmd_type_t;
+
+typedef struct {
+    uint32_t seq;
+    uint8_t type;
+    lv_obj_t * obj;
+    union {
+        char text[LV_CMD_QUEUE_TEXT_LEN];
+        struct {
+            lv_style_value_t value;
+            lv_style_selector_t selector;
+            lv_style_prop_t prop;
+        } style;
+        struct {
+            lv_cmd_queue_value_cb_t cb;
+            int32_t value;
+        } value;
+    } data;
+} cmd_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static cmd_t * reserve(void);
+static void publish(cmd_t * cmd);
+static bool same_target(const cmd_t * a, const cmd_t * b);
+static void apply(cmd_t * cmd);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static cmd_t queue[LV_CMD_QUEUE_LEN];
+static uint32_t enqueue_pos;            /*Shared by the producers*/
+static uint32_t dequeue_pos;            /*Used only by the LVGL thread*/
+static lv_cmd_queue_notify_cb_t notify_cb;
+static lv_cmd_queue_stats_t stats;
+
+#endif /*LV_CMD_QUEUE_LEN*/
+
+/**********************
+ *      MACROS
+ **********************/
+#define STAT_INC(field) __atomic_fetch_add(&stats.field, 1, __ATOMIC_RELAXED)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void _lv_cmd_queue_init(void)
+{
+#if LV_CMD_QUEUE_LEN
+    uint32_t i;
+    for(i = 0; i < LV_CMD_QUEUE_LEN; i++) {
+        __atomic_store_n(&queue[i].seq, i, __ATOMIC_RELAXED);
+    }
+    __atomic_store_n(&enqueue_pos, 0, __ATOMIC_RELAXED);
+    dequeue_pos = 0;
+    lv_memset_00(&stats, sizeof(stats));
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+#endif
+}
+
+uint32_t _lv_cmd_queue_drain(void)
+{
+#if LV_CMD_QUEUE_LEN
+    /*Take the commands posted so far. The ones posted while applying them wait for the next call*/
+    uint32_t cnt = 0;
+    while(cnt < LV_CMD_QUEUE_LEN) {
+        uint32_t pos = dequeue_pos + cnt;
+        if(__atomic_load_n(&queue[pos & QUEUE_MASK].seq, __ATOMIC_ACQUIRE) != pos + 1) break;
+        cnt++;
+    }
+    if(cnt == 0) return 0;
+
+    stats.batches++;
+
+    uint32_t applied = 0;
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        uint32_t pos = dequeue_pos + i;
+        cmd_t * cmd = &queue[pos & QUEUE_MASK];
+
+        /*A later command of the batch overwrites the same property anyway*/
+        bool superseded = false;
+        uint32_t j;
+        for(j = i + 1; j < cnt; j++) {
+            if(same_target(cmd, &queue[(dequeue_pos + j) & QUEUE_MASK])) {
+                superseded = true;
+                break;
+            }
+        }
+
+        if(superseded) {
+            stats.coalesced++;
+        }
+        else if(!lv_obj_is_valid(cmd->obj)) {
+            stats.invalid++;
+        }
+        else {
+            apply(cmd);
+            stats.applied++;
+            applied++;
+        }
+
+        /*Give the slot back to the producers for the next round*/
+        __atomic_store_n(&cmd->seq, pos + LV_CMD_QUEUE_LEN, __ATOMIC_RELEASE);
+    }
+
+    dequeue_pos += cnt;
+
+    return applied;
+#else
+    return 0;
+#endif
+}
+
+bool lv_cmd_queue_post_text(lv_obj_t * obj, const char * text)
+{
+#if LV_CMD_QUEUE_LEN
+    LV_ASSERT_NULL(text);
+
+    size_t len = strlen(text);
+    if(len >= LV_CMD_QUEUE_TEXT_LEN) {
+        LV_LOG_WARN("The text is longer than LV_CMD_QUEUE_TEXT_LEN - 1");
+        return false;
+    }
+
+    cmd_t * cmd = reserve();
+    if(cmd == NULL) return false;
+
+    cmd->type = CMD_TEXT;
+    cmd->obj = obj;
+    lv_memcpy_small(cmd->data.text, text, len + 1);
+    publish(cmd);
+    return true;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(text);
+    return false;
+#endif
+}
+
+bool lv_cmd_queue_post_style(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
+                             lv_style_selector_t selector)
+{
+#if LV_CMD_QUEUE_LEN
+    cmd_t * cmd = reserve();
+    if(cmd == NULL) return false;
+
+    cmd->type = CMD_STYLE;
+    cmd->obj = obj;
+    cmd->data.style.prop = prop;
+    cmd->data.style.value = value;
+    cmd->data.style.selector = selector;
+    publish(cmd);
+    return true;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(prop);
+    LV_UNUSED(value);
+    LV_UNUSED(selector);
+    return false;
+#endif
+}
+
+bool lv_cmd_queue_post_value(lv_obj_t * obj, lv_cmd_queue_value_cb_t cb, int32_t value)
+{
+#if LV_CMD_QUEUE_LEN
+    LV_ASSERT_NULL(cb);
+
+    cmd_t * cmd = reserve();
+    if(cmd == NULL) return false;
+
+    cmd->type = CMD_VALUE;
+    cmd->obj = obj;
+    cmd->data.value.cb = cb;
+    cmd->data.value.value = value;
+    publish(cmd);
+    return true;
+#else
+    LV_UNUSED(obj);
+    LV_UNUSED(cb);
+    LV_UNUSED(value);
+    return false;
+#endif
+}
+
+void lv_cmd_queue_set_notify_cb(lv_cmd_queue_notify_cb_t cb)
+{
+#if LV_CMD_QUEUE_LEN
+    __atomic_store_n(&notify_cb, cb, __ATOMIC_RELEASE);
+#else
+    LV_UNUSED(cb);
+#endif
+}
+
+void lv_cmd_queue_get_stats(lv_cmd_queue_stats_t * stats_out)
+{
+#if LV_CMD_QUEUE_LEN
+    stats_out->posted = __atomic_load_n(&stats.posted, __ATOMIC_RELAXED);
+    stats_out->dropped = __atomic_load_n(&stats.dropped, __ATOMIC_RELAXED);
+    stats_out->applied = stats.applied;
+    stats_out->coalesced = stats.coalesced;
+    stats_out->invalid = stats.invalid;
+    stats_out->batches = stats.batches;
+#else
+    lv_memset_00(stats_out, sizeof(lv_cmd_queue_stats_t));
+#endif
+}
+
+void lv_cmd_queue_reset_stats(void)
+{
+#if LV_CMD_QUEUE_LEN
+    __atomic_store_n(&stats.posted, 0, __ATOMIC_RELAXED);
+    __atomic_store_n(&stats.dropped, 0, __ATOMIC_RELAXED);
+    stats.applied = 0;
+    stats.coalesced = 0;
+    stats.invalid = 0;
+    stats.batches = 0;
+#endif
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_CMD_QUEUE_LEN
+
+/**
+ * Reserve the next free slot for a producer.
+ * @return the slot to fill, or NULL if the queue is full
+ */
+static cmd_t * reserve(void)
+{
+    uint32_t pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+    while(1) {
+        cmd_t * cmd = &queue[pos & QUEUE_MASK];
+        uint32_t seq = __atomic_load_n(&cmd->seq, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(seq - pos);
+        if(diff == 0) {
+            /*Free in this round, take it if no other producer was faster. `pos` is reloaded if not*/
+            if(__atomic_compare_exchange_n(&enqueue_pos, &pos, pos + 1, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                return cmd;
+            }
+        }
+        else if(diff < 0) {
+            /*Not applied yet since the previous round*/
+            STAT_INC(dropped);
+            return NULL;
+        }
+        else {
+            /*Another producer has taken it*/
+            pos = __atomic_load_n(&enqueue_pos, __ATOMIC_RELAXED);
+        }
+    }
+}
+
+/**
+ * Hand over a filled slot to the LVGL thread
+ * @param cmd   a slot returned by `reserve()`
+ */
+static void publish(cmd_t * cmd)
+{
+    /*The slot was reserved at `seq`, so the filled state is `seq + 1`*/
+    uint32_t seq = __atomic_load_n(&cmd->seq, __ATOMIC_RELAXED);
+    __atomic_store_n(&cmd->seq, seq + 1, __ATOMIC_RELEASE);
+    STAT_INC(posted);
+
+    lv_cmd_queue_notify_cb_t cb = __atomic_load_n(&notify_cb, __ATOMIC_ACQUIRE);
+    if(cb) cb();
+}
+
+static bool same_target(const cmd_t * a, const cmd_t * b)
+{
+    if(a->obj != b->obj || a->type != b->type) return false;
+
+    switch(a->type) {
+        case CMD_TEXT:
+            return true;
+        case CMD_STYLE:
+            return a->data.style.prop == b->data.style.prop && a->data.style.selector == b->data.style.selector;
+        case CMD_VALUE:
+            return a->data.value.cb == b->data.value.cb;
+        default:
+            return false;
+    }
+}
+
+static void apply(cmd_t * cmd)
+{
+    switch(cmd->type) {
+        case CMD_TEXT:
+#if LV_USE_LABEL
+            /*The address might be reused by an other type of object since posting*/
+            if(lv_obj_check_type(cmd->obj, &lv_label_class)) {
+                lv_label_set_text(cmd->obj, cmd->data.text);
+            }
+            else {
+                LV_LOG_WARN("The text was posted to an object which is not a label");
+            }
+#else
+            LV_LOG_WARN("The text can't be applied because LV_USE_LABEL is disabled");
+#endif
+            break;
+        case CMD_STYLE:
+            lv_obj_set_local_style_prop(cmd->obj, cmd->data.style.prop, cmd->data.style.value, cmd->data.style.selector);
+            break;
+        case CMD_VALUE:
+            cmd->data.value.cb(cmd->obj, cmd->data.value.value);
+            break;
+    }
+}
+
+#endif /*LV_CMD_QUEUE_LEN*/
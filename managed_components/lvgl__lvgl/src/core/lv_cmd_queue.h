@@ -0,0 +1,123 @@
+/**
+ * @file lv_cmd_queue.h
+ *
+ * Commands posted to the objects from other threads or interrupts. The commands are stored in a bounded
+ * ring without locks or memory allocation, and the LVGL thread applies them at the start of `lv_timer_handler`.
+ * If a property of an object is changed several times before that, only the latest value is applied.
+ */
+
+#ifndef LV_CMD_QUEUE_H
+#define LV_CMD_QUEUE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+#include "lv_obj.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Apply a value to an object in the LVGL thread. See `lv_cmd_queue_post_value`
+ * @param obj       the object of the command, it's valid
+ * @param value     the latest posted value
+ */
+typedef void (*lv_cmd_queue_value_cb_t)(lv_obj_t * obj, int32_t value);
+
+/**
+ * Called by the posting thread after a command was put into the queue,
+ * e.g. to wake up the LVGL thread waiting for the time returned by `lv_timer_handler`.
+ * It's called from the interrupt if the command was posted in an interrupt.
+ */
+typedef void (*lv_cmd_queue_notify_cb_t)(void);
+
+/** Statistics of the command queue*/
+typedef struct {
+    uint32_t posted;            /**< Commands put into the queue*/
+    uint32_t dropped;           /**< Commands not posted because the queue was full*/
+    uint32_t applied;           /**< Commands applied by the LVGL thread*/
+    uint32_t coalesced;         /**< Commands skipped because a later one set the same property*/
+    uint32_t invalid;           /**< Commands skipped because their object was deleted*/
+    uint32_t batches;           /**< Calls of `lv_timer_handler` which found commands*/
+} lv_cmd_queue_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the command queue
+ */
+void _lv_cmd_queue_init(void);
+
+/**
+ * Apply the commands posted so far. Called by the LVGL thread at the start of `lv_timer_handler`.
+ * @return the number of applied commands
+ */
+uint32_t _lv_cmd_queue_drain(void);
+
+/**
+ * Set the text of a label from any thread. The text is copied into the queue.
+ * @param obj       pointer to a label
+ * @param text      the new text, shorter than `LV_CMD_QUEUE_TEXT_LEN`
+ * @return          true: posted; false: the queue is full or the text is too long
+ */
+bool lv_cmd_queue_post_text(lv_obj_t * obj, const char * text);
+
+/**
+ * Set a local style property of an object from any thread.
+ * @param obj       pointer to an object
+ * @param prop      the property, e.g. `LV_STYLE_TEXT_COLOR`
+ * @param value     the new value
+ * @param selector  OR-ed value of parts and state to which the style should be added
+ * @return          true: posted; false: the queue is full
+ */
+bool lv_cmd_queue_post_style(lv_obj_t * obj, lv_style_prop_t prop, lv_style_value_t value,
+                             lv_style_selector_t selector);
+
+/**
+ * Call `cb(obj, value)` in the LVGL thread, e.g. to set the value of a bar from a sensor task.
+ * Only the latest value is applied for the same object and callback.
+ * @param obj       pointer to an object
+ * @param cb        function to apply the value
+ * @param value     the new value
+ * @return          true: posted; false: the queue is full
+ */
+bool lv_cmd_queue_post_value(lv_obj_t * obj, lv_cmd_queue_value_cb_t cb, int32_t value);
+
+/**
+ * Set a function to call when a command is posted.
+ * @param cb        function to wake up the LVGL thread or NULL
+ */
+void lv_cmd_queue_set_notify_cb(lv_cmd_queue_notify_cb_t cb);
+
+/**
+ * Get the statistics of the command queue.
+ * @param stats     store the statistics here
+ */
+void lv_cmd_queue_get_stats(lv_cmd_queue_stats_t * stats);
+
+/**
+ * Clear the counters of the command queue.
+ */
+void lv_cmd_queue_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_CMD_QUEUE_H*/
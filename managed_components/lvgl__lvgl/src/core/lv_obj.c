@@ -12,15 +12,18 @@
 #include "lv_group.h"
 #include "lv_disp.h"
 #include "lv_theme.h"
+#include "lv_cmd_queue.h"
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
 #include "../misc/lv_anim.h"
 #include "../misc/lv_timer.h"
 #include "../misc/lv_async.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_fs_cache.h"
 #include "../misc/lv_gc.h"
 #include "../misc/lv_math.h"
 #include "../misc/lv_log.h"
+#include "../font/lv_glyph_cache.h"
 #include "../hal/lv_hal.h"
 #include "../extra/lv_extra.h"
 #include <stdint.h>
@@ -64,6 +67,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_scrollbar(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx);
 static lv_res_t scrollbar_init_draw_dsc(lv_obj_t * obj, lv_draw_rect_dsc_t * dsc);
 static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_find);
+static bool depends_on_parent_size(lv_obj_t * obj);
 static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state);
 
 /**********************
@@ -109,8 +113,10 @@ void lv_init(void)
     lv_mem_init();
 
     _lv_timer_core_init();
+    _lv_cmd_queue_init();
 
     _lv_fs_init();
+    _lv_fs_cache_init();
 
     _lv_anim_core_init();
 
@@ -148,6 +154,11 @@ void lv_init(void)
 #if LV_IMG_CACHE_DEF_SIZE
     lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
 #endif
+    _lv_img_async_init();
+    _lv_glyph_cache_init();
+
+    _lv_font_fmt_txt_index_init();
+
     /*Test if the IDE has UTF-8 encoding*/
     const char * txt = "Á";
 
@@ -196,6 +207,9 @@ void lv_init(void)
 
 void lv_deinit(void)
 {
+    /*The built-in fonts would keep pointing to the freed indexes*/
+    _lv_font_fmt_txt_index_deinit();
+
     _lv_gc_clear_roots();
 
     lv_disp_set_default(NULL);
@@ -849,7 +863,7 @@ static void lv_obj_event(const lv_obj_class_t * class_p, lv_event_t * e)
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
-            lv_obj_mark_layout_as_dirty(child);
+            if(depends_on_parent_size(child)) lv_obj_mark_layout_as_dirty(child);
         }
     }
     else if(code == LV_EVENT_CHILD_CHANGED) {
@@ -889,6 +903,9 @@ static void lv_obj_set_state(lv_obj_t * obj, lv_state_t new_state)
     lv_state_t prev_state = obj->state;
     obj->state = new_state;
 
+    /*The snapshots are per state, but the children can inherit properties of the new state*/
+    _lv_obj_style_snapshot_invalidate(obj);
+
     _lv_style_state_cmp_t cmp_res = _lv_obj_style_state_compare(obj, prev_state, new_state);
     /*If there is no difference in styles there is nothing else to do*/
     if(cmp_res == _LV_STYLE_STATE_CMP_SAME) return;
@@ -973,3 +990,29 @@ static bool obj_valid_child(const lv_obj_t * parent, const lv_obj_t * obj_to_fin
     }
     return false;
 }
+
+/**
+ * Tell if the size or position of an object needs to be recalculated when its parent's size changes.
+ * The objects positioned by a layout and not sized in percentage are handled by the parent's layout,
+ * so e.g. the labels of a resized flex container are not measured again.
+ * @param obj       pointer to an object
+ * @return          true: it depends on the parent's size
+ */
+static bool depends_on_parent_size(lv_obj_t * obj)
+{
+    if(!lv_obj_is_layout_positioned(obj)) return true;
+
+    if(!obj->w_layout) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_width(obj, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_min_width(obj, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_max_width(obj, LV_PART_MAIN))) return true;
+    }
+
+    if(!obj->h_layout) {
+        if(LV_COORD_IS_PCT(lv_obj_get_style_height(obj, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_min_height(obj, LV_PART_MAIN))) return true;
+        if(LV_COORD_IS_PCT(lv_obj_get_style_max_height(obj, LV_PART_MAIN))) return true;
+    }
+
+    return false;
+}
@@ -26,12 +26,15 @@
 static lv_coord_t calc_content_width(lv_obj_t * obj);
 static lv_coord_t calc_content_height(lv_obj_t * obj);
 static void layout_update_core(lv_obj_t * obj);
+static void layout_mark_ancestors(lv_obj_t * obj);
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t layout_cnt;
+static lv_obj_layout_stats_t layout_stats;
+static bool layout_updating;
 
 /**********************
  *      MACROS
@@ -202,6 +205,9 @@ bool lv_obj_refr_size(lv_obj_t * obj)
 
     obj->readjust_scroll_after_layout = 1;
 
+    /*In a layout update the scroll is readjusted when the object's visit ends*/
+    if(!layout_updating) layout_mark_ancestors(obj);
+
     /*If the object was out of the parent invalidate the new scrollbar area too.
      *If it wasn't out of the parent but out now, also invalidate the scrollbars*/
     bool on2 = _lv_area_is_in(&obj->coords, &parent_fit_area, 0);
@@ -288,24 +294,16 @@ bool lv_obj_is_layout_positioned(const lv_obj_t * obj)
 void lv_obj_mark_layout_as_dirty(lv_obj_t * obj)
 {
     obj->layout_inv = 1;
-
-    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
-    lv_obj_t * scr = lv_obj_get_screen(obj);
-    scr->scr_layout_inv = 1;
-
-    /*Make the display refreshing*/
-    lv_disp_t * disp = lv_obj_get_disp(scr);
-    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+    layout_mark_ancestors(obj);
 }
 
 void lv_obj_update_layout(const lv_obj_t * obj)
 {
-    static bool mutex = false;
-    if(mutex) {
+    if(layout_updating) {
         LV_LOG_TRACE("Already running, returning");
         return;
     }
-    mutex = true;
+    layout_updating = true;
 
     lv_obj_t * scr = lv_obj_get_screen(obj);
 
@@ -313,11 +311,12 @@ void lv_obj_update_layout(const lv_obj_t * obj)
     while(scr->scr_layout_inv) {
         LV_LOG_INFO("Layout update begin");
         scr->scr_layout_inv = 0;
+        layout_stats.updates++;
         layout_update_core(scr);
         LV_LOG_TRACE("Layout update end");
     }
 
-    mutex = false;
+    layout_updating = false;
 }
 
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
@@ -331,6 +330,16 @@ uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data)
     return layout_cnt;  /*No -1 to skip 0th index*/
 }
 
+void lv_obj_layout_get_stats(lv_obj_layout_stats_t * stats)
+{
+    *stats = layout_stats;
+}
+
+void lv_obj_layout_reset_stats(void)
+{
+    lv_memset_00(&layout_stats, sizeof(layout_stats));
+}
+
 void lv_obj_set_align(lv_obj_t * obj, lv_align_t align)
 {
     lv_obj_set_style_align(obj, align, 0);
@@ -824,11 +833,15 @@ void lv_obj_get_transformed_area(const lv_obj_t * obj, lv_area_t * area, bool re
     lv_obj_transform_point(obj, &p[2], recursive, inv);
     lv_obj_transform_point(obj, &p[3], recursive, inv);
 
+    lv_area_t ori = *area;
     area->x1 = LV_MIN4(p[0].x, p[1].x, p[2].x, p[3].x);
     area->x2 = LV_MAX4(p[0].x, p[1].x, p[2].x, p[3].x);
     area->y1 = LV_MIN4(p[0].y, p[1].y, p[2].y, p[3].y);
     area->y2 = LV_MAX4(p[0].y, p[1].y, p[2].y, p[3].y);
-    lv_area_increase(area, 5, 5);
+
+    /*Add some margin for the rounding of the transformation.
+     *Not transformed areas are kept as they are to not redraw the surroundings of every invalidated area.*/
+    if(!_lv_area_is_equal(&ori, area)) lv_area_increase(area, 5, 5);
 }
 
 void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
@@ -1123,15 +1136,24 @@ static lv_coord_t calc_content_height(lv_obj_t * obj)
 
 static void layout_update_core(lv_obj_t * obj)
 {
+    layout_stats.visited++;
+
+    /*Descend only into the branches which have something to do*/
     uint32_t i;
     uint32_t child_cnt = lv_obj_get_child_cnt(obj);
-    for(i = 0; i < child_cnt; i++) {
-        lv_obj_t * child = obj->spec_attr->children[i];
-        layout_update_core(child);
+    if(obj->child_layout_inv) {
+        obj->child_layout_inv = 0;
+        for(i = 0; i < child_cnt; i++) {
+            lv_obj_t * child = obj->spec_attr->children[i];
+            if(child->layout_inv || child->child_layout_inv || child->readjust_scroll_after_layout) {
+                layout_update_core(child);
+            }
+        }
     }
 
     if(obj->layout_inv) {
         obj->layout_inv = 0;
+        layout_stats.refreshed++;
         lv_obj_refr_size(obj);
         lv_obj_refr_pos(obj);
 
@@ -1150,6 +1172,26 @@ static void layout_update_core(lv_obj_t * obj)
     }
 }
 
+/**
+ * Mark the path from the screen to an object so that the next layout update visits the object.
+ * @param obj       pointer to an object
+ */
+static void layout_mark_ancestors(lv_obj_t * obj)
+{
+    lv_obj_t * scr = obj;
+    while(scr->parent) {
+        scr = scr->parent;
+        scr->child_layout_inv = 1;
+    }
+
+    /*Mark the screen as dirty too to mark that there is something to do on this screen*/
+    scr->scr_layout_inv = 1;
+
+    /*Make the display refreshing*/
+    lv_disp_t * disp = lv_obj_get_disp(scr);
+    if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
+}
+
 static void transform_point(const lv_obj_t * obj, lv_point_t * p, bool inv)
 {
     int16_t angle = lv_obj_get_style_transform_angle(obj, 0);
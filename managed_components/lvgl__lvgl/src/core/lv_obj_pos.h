@@ -30,6 +30,13 @@ typedef struct {
     void * user_data;
 } lv_layout_dsc_t;
 
+/** Statistics of the layout updates*/
+typedef struct {
+    uint32_t updates;           /**< Passes of `lv_obj_update_layout` over a screen*/
+    uint32_t visited;           /**< Objects visited by the passes*/
+    uint32_t refreshed;         /**< Objects whose size, position and layout were recalculated*/
+} lv_obj_layout_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -160,6 +167,17 @@ void lv_obj_update_layout(const struct _lv_obj_t * obj);
  */
 uint32_t lv_layout_register(lv_layout_update_cb_t cb, void * user_data);
 
+/**
+ * Get the statistics of the layout updates.
+ * @param stats     store the statistics here
+ */
+void lv_obj_layout_get_stats(lv_obj_layout_stats_t * stats);
+
+/**
+ * Clear the counters of the layout updates.
+ */
+void lv_obj_layout_reset_stats(void);
+
 /**
  * Change the alignment of an object.
  * @param obj       pointer to an object to align
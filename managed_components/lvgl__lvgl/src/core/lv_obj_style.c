@@ -15,6 +15,13 @@
  *********************/
 #define MY_CLASS &lv_obj_class
 
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+/*The parts of an object are stored in the same set, so an object with a few parts doesn't evict other objects*/
+#define SNAPSHOT_WAYS   4
+#define SNAPSHOT_SETS   ((LV_OBJ_STYLE_SNAPSHOT_CNT + SNAPSHOT_WAYS - 1) / SNAPSHOT_WAYS)
+#define SNAPSHOT_SLOTS  64
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -27,6 +34,18 @@ typedef struct {
     lv_style_value_t end_value;
 } trans_t;
 
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+/*The resolved draw properties of a part of an object in a state*/
+typedef struct {
+    const lv_obj_t * obj;       /*NULL if unused*/
+    lv_part_t part;
+    lv_state_t state;
+    uint32_t last_use;
+    uint64_t valid;             /*A bit for each slot of `values` with a resolved value*/
+    lv_style_value_t values[SNAPSHOT_SLOTS];
+} snapshot_t;
+#endif
+
 typedef enum {
     CACHE_ZERO = 0,
     CACHE_TRUE = 1,
@@ -54,15 +73,61 @@ static void trans_anim_ready_cb(lv_anim_t * a);
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj);
 static void fade_anim_cb(void * obj, int32_t v);
 static void fade_in_anim_ready(lv_anim_t * a);
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    static snapshot_t * snapshot_get(const lv_obj_t * obj, lv_part_t part);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool style_refr = true;
 
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+/*The properties used by `lv_obj_init_draw_..._dsc()` and the widgets' draw functions*/
+static const lv_style_prop_t snapshot_props[] = {
+    LV_STYLE_RADIUS, LV_STYLE_BASE_DIR, LV_STYLE_CLIP_CORNER,
+    LV_STYLE_BG_COLOR, LV_STYLE_BG_OPA, LV_STYLE_BG_GRAD_COLOR, LV_STYLE_BG_GRAD_DIR, LV_STYLE_BG_MAIN_STOP,
+    LV_STYLE_BG_GRAD_STOP, LV_STYLE_BG_GRAD, LV_STYLE_BG_DITHER_MODE, LV_STYLE_BG_IMG_SRC, LV_STYLE_BG_IMG_OPA,
+    LV_STYLE_BG_IMG_RECOLOR, LV_STYLE_BG_IMG_RECOLOR_OPA, LV_STYLE_BG_IMG_TILED,
+    LV_STYLE_BORDER_COLOR, LV_STYLE_BORDER_OPA, LV_STYLE_BORDER_WIDTH, LV_STYLE_BORDER_SIDE, LV_STYLE_BORDER_POST,
+    LV_STYLE_OUTLINE_WIDTH, LV_STYLE_OUTLINE_COLOR, LV_STYLE_OUTLINE_OPA, LV_STYLE_OUTLINE_PAD,
+    LV_STYLE_SHADOW_WIDTH, LV_STYLE_SHADOW_OFS_X, LV_STYLE_SHADOW_OFS_Y, LV_STYLE_SHADOW_SPREAD, LV_STYLE_SHADOW_COLOR,
+    LV_STYLE_SHADOW_OPA,
+    LV_STYLE_IMG_OPA, LV_STYLE_IMG_RECOLOR, LV_STYLE_IMG_RECOLOR_OPA,
+    LV_STYLE_LINE_WIDTH, LV_STYLE_LINE_DASH_WIDTH, LV_STYLE_LINE_DASH_GAP, LV_STYLE_LINE_ROUNDED, LV_STYLE_LINE_COLOR,
+    LV_STYLE_LINE_OPA,
+    LV_STYLE_ARC_WIDTH, LV_STYLE_ARC_ROUNDED, LV_STYLE_ARC_COLOR, LV_STYLE_ARC_OPA, LV_STYLE_ARC_IMG_SRC,
+    LV_STYLE_TEXT_COLOR, LV_STYLE_TEXT_OPA, LV_STYLE_TEXT_FONT, LV_STYLE_TEXT_LETTER_SPACE, LV_STYLE_TEXT_LINE_SPACE,
+    LV_STYLE_TEXT_DECOR, LV_STYLE_TEXT_ALIGN,
+    LV_STYLE_OPA, LV_STYLE_COLOR_FILTER_DSC, LV_STYLE_COLOR_FILTER_OPA, LV_STYLE_BLEND_MODE,
+    LV_STYLE_TRANSFORM_WIDTH, LV_STYLE_TRANSFORM_HEIGHT,
+};
+
+static uint8_t snapshot_slot[_LV_STYLE_NUM_BUILT_IN_PROPS];  /*1 + index in `snapshot_props` or 0 if not stored*/
+static snapshot_t snapshots[SNAPSHOT_SETS * SNAPSHOT_WAYS];
+static snapshot_t * snapshot_last;                          /*The last used snapshot to find it quickly again*/
+static uint32_t snapshot_used;
+static uint32_t snapshot_tick;
+static bool snapshot_en;
+static uint32_t snapshot_style_change_cnt;   /*`_lv_style_get_change_cnt()` when the snapshots were last checked*/
+#endif
+static lv_obj_style_snapshot_stats_t snapshot_stats;
+
 /**********************
  *      MACROS
  **********************/
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+/*The local and transition styles of an object are changed with a precise invalidation of the snapshots.
+ *Don't let these changes drop every snapshot like the changes of the other styles do.*/
+#define OWN_STYLE_CHANGE(call)                                                      \
+    do {                                                                            \
+        bool synced = snapshot_style_change_cnt == _lv_style_get_change_cnt();      \
+        call;                                                                       \
+        if(synced) snapshot_style_change_cnt = _lv_style_get_change_cnt();          \
+    } while(0)
+#else
+#define OWN_STYLE_CHANGE(call) call
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -71,6 +136,25 @@ static bool style_refr = true;
 void _lv_obj_style_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_obj_style_trans_ll), sizeof(trans_t));
+
+    lv_memset_00(&snapshot_stats, sizeof(snapshot_stats));
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    uint32_t prop_cnt = sizeof(snapshot_props) / sizeof(snapshot_props[0]);
+    LV_ASSERT(prop_cnt <= SNAPSHOT_SLOTS);
+
+    lv_memset_00(snapshot_slot, sizeof(snapshot_slot));
+    uint32_t i;
+    for(i = 0; i < prop_cnt; i++) {
+        snapshot_slot[snapshot_props[i]] = i + 1;
+    }
+
+    lv_memset_00(snapshots, sizeof(snapshots));
+    snapshot_last = NULL;
+    snapshot_used = 0;
+    snapshot_tick = 0;
+    snapshot_en = true;
+    snapshot_style_change_cnt = _lv_style_get_change_cnt();
+#endif
 }
 
 void lv_obj_add_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t selector)
@@ -127,7 +211,7 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
         }
 
         if(obj->styles[i].is_local || obj->styles[i].is_trans) {
-            lv_style_reset(obj->styles[i].style);
+            OWN_STYLE_CHANGE(lv_style_reset(obj->styles[i].style));
             lv_mem_free(obj->styles[i].style);
             obj->styles[i].style = NULL;
         }
@@ -152,7 +236,11 @@ void lv_obj_remove_style(lv_obj_t * obj, lv_style_t * style, lv_style_selector_t
 
 void lv_obj_report_style_change(lv_style_t * style)
 {
-    if(!style_refr) return;
+    if(!style_refr) {
+        /*The objects aren't refreshed but they shouldn't be drawn with the old properties*/
+        _lv_obj_style_snapshot_invalidate(NULL);
+        return;
+    }
     lv_disp_t * d = lv_disp_get_next(NULL);
 
     while(d) {
@@ -168,6 +256,9 @@ void lv_obj_refresh_style(lv_obj_t * obj, lv_style_selector_t selector, lv_style
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+    /*The children can inherit the changed properties*/
+    _lv_obj_style_snapshot_invalidate(obj);
+
     if(!style_refr) return;
 
     lv_obj_invalidate(obj);
@@ -220,9 +311,82 @@ void lv_obj_enable_style_refresh(bool en)
     style_refr = en;
 }
 
+void lv_obj_enable_style_snapshot(bool en)
+{
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    if(!en) _lv_obj_style_snapshot_invalidate(NULL);
+    snapshot_en = en;
+#else
+    LV_UNUSED(en);
+    LV_LOG_WARN("Can't enable the style snapshots because they are disabled by LV_OBJ_STYLE_SNAPSHOT_CNT = 0");
+#endif
+}
+
+void lv_obj_style_snapshot_get_stats(lv_obj_style_snapshot_stats_t * stats_out)
+{
+    *stats_out = snapshot_stats;
+}
+
+void lv_obj_style_snapshot_reset_stats(void)
+{
+    lv_memset_00(&snapshot_stats, sizeof(snapshot_stats));
+}
+
+void _lv_obj_style_snapshot_invalidate(const lv_obj_t * obj)
+{
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    if(snapshot_used == 0) return;
+
+    snapshot_last = NULL;
+
+    /*Without children only the snapshots of the object itself need to be dropped.
+     *Not `lv_obj_get_child_cnt()` because a deleted object is not valid anymore.*/
+    bool deep = obj == NULL || (obj->spec_attr && obj->spec_attr->child_cnt != 0);
+    uint32_t i;
+    for(i = 0; i < SNAPSHOT_SETS * SNAPSHOT_WAYS; i++) {
+        snapshot_t * snapshot = &snapshots[i];
+        if(snapshot->obj == NULL) continue;
+
+        const lv_obj_t * o = snapshot->obj;
+        if(obj && deep) {
+            while(o && o != obj) o = o->parent;
+        }
+        if(obj && o != obj) continue;
+
+        snapshot->obj = NULL;
+        snapshot->valid = 0;
+        snapshot_used--;
+        snapshot_stats.invalidations++;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
 lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop)
 {
     lv_style_value_t value_act;
+
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    /*The transitions get the values without the transition styles, they are not stored*/
+    snapshot_t * snapshot = NULL;
+    uint32_t slot = prop < _LV_STYLE_NUM_BUILT_IN_PROPS ? snapshot_slot[prop] : 0;
+    if(slot && snapshot_en && !obj->skip_trans) {
+        /*A shared style was changed and maybe only a redraw was requested*/
+        if(snapshot_style_change_cnt != _lv_style_get_change_cnt()) {
+            _lv_obj_style_snapshot_invalidate(NULL);
+            snapshot_style_change_cnt = _lv_style_get_change_cnt();
+        }
+
+        slot--;
+        snapshot = snapshot_get(obj, part);
+        if(snapshot->valid & ((uint64_t)1 << slot)) {
+            snapshot_stats.hits++;
+            return snapshot->values[slot];
+        }
+    }
+#endif
+
     bool inheritable = lv_style_prop_has_flag(prop, LV_STYLE_PROP_INHERIT);
     lv_style_res_t found = LV_STYLE_RES_NOT_FOUND;
     while(obj) {
@@ -264,6 +428,15 @@ lv_style_value_t lv_obj_get_style_prop(const lv_obj_t * obj, lv_part_t part, lv_
             value_act = lv_style_prop_get_default(prop);
         }
     }
+
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+    if(snapshot) {
+        snapshot->values[slot] = value_act;
+        snapshot->valid |= (uint64_t)1 << slot;
+        snapshot_stats.misses++;
+    }
+#endif
+
     return value_act;
 }
 
@@ -271,7 +444,7 @@ void lv_obj_set_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_style_
                                  lv_style_selector_t selector)
 {
     lv_style_t * style = get_local_style(obj, selector);
-    lv_style_set_prop(style, prop, value);
+    OWN_STYLE_CHANGE(lv_style_set_prop(style, prop, value));
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -279,7 +452,7 @@ void lv_obj_set_local_style_prop_meta(lv_obj_t * obj, lv_style_prop_t prop, uint
                                       lv_style_selector_t selector)
 {
     lv_style_t * style = get_local_style(obj, selector);
-    lv_style_set_prop_meta(style, prop, meta);
+    OWN_STYLE_CHANGE(lv_style_set_prop_meta(style, prop, meta));
     lv_obj_refresh_style(obj, selector, prop);
 }
 
@@ -313,7 +486,8 @@ bool lv_obj_remove_local_style_prop(lv_obj_t * obj, lv_style_prop_t prop, lv_sty
     /*The style is not found*/
     if(i == obj->style_cnt) return false;
 
-    lv_res_t res = lv_style_remove_prop(obj->styles[i].style, prop);
+    lv_res_t res;
+    OWN_STYLE_CHANGE(res = lv_style_remove_prop(obj->styles[i].style, prop));
     if(res == LV_RES_OK) {
         lv_obj_refresh_style(obj, selector, prop);
     }
@@ -340,7 +514,8 @@ void _lv_obj_style_create_transition(lv_obj_t * obj, lv_part_t part, lv_state_t
     obj->state = new_state;
 
     _lv_obj_style_t * style_trans = get_trans_style(obj, part);
-    lv_style_set_prop(style_trans->style, tr_dsc->prop, v1);   /*Be sure `trans_style` has a valid value*/
+    OWN_STYLE_CHANGE(lv_style_set_prop(style_trans->style, tr_dsc->prop, v1));   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_snapshot_invalidate(obj);
 
     if(tr_dsc->prop == LV_STYLE_RADIUS) {
         if(v1.num == LV_RADIUS_CIRCLE || v2.num == LV_RADIUS_CIRCLE) {
@@ -732,7 +907,7 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
             uint32_t i;
             for(i = 0; i < obj->style_cnt; i++) {
                 if(obj->styles[i].is_trans && (part == LV_PART_ANY || obj->styles[i].selector == part)) {
-                    lv_style_remove_prop(obj->styles[i].style, tr->prop);
+                    OWN_STYLE_CHANGE(lv_style_remove_prop(obj->styles[i].style, tr->prop));
                 }
             }
 
@@ -745,6 +920,8 @@ static bool trans_del(lv_obj_t * obj, lv_part_t part, lv_style_prop_t prop, tran
         }
         tr = tr_prev;
     }
+
+    if(removed) _lv_obj_style_snapshot_invalidate(obj);
     return removed;
 }
 
@@ -804,7 +981,7 @@ static void trans_anim_cb(void * _tr, int32_t v)
                 refr = false;
             }
         }
-        lv_style_set_prop(obj->styles[i].style, tr->prop, value_final);
+        OWN_STYLE_CHANGE(lv_style_set_prop(obj->styles[i].style, tr->prop, value_final));
         if(refr) lv_obj_refresh_style(tr->obj, tr->selector, tr->prop);
         break;
 
@@ -829,7 +1006,8 @@ static void trans_anim_start_cb(lv_anim_t * a)
     tr->prop = prop_tmp;
 
     _lv_obj_style_t * style_trans = get_trans_style(tr->obj, tr->selector);
-    lv_style_set_prop(style_trans->style, tr->prop, tr->start_value);   /*Be sure `trans_style` has a valid value*/
+    OWN_STYLE_CHANGE(lv_style_set_prop(style_trans->style, tr->prop, tr->start_value));   /*Be sure `trans_style` has a valid value*/
+    _lv_obj_style_snapshot_invalidate(tr->obj);
 
 }
 
@@ -859,7 +1037,8 @@ static void trans_anim_ready_cb(lv_anim_t * a)
                 lv_mem_free(tr);
 
                 _lv_obj_style_t * obj_style = &obj->styles[i];
-                lv_style_remove_prop(obj_style->style, prop);
+                OWN_STYLE_CHANGE(lv_style_remove_prop(obj_style->style, prop));
+                _lv_obj_style_snapshot_invalidate(obj);
 
                 if(lv_style_is_empty(obj->styles[i].style)) {
                     lv_obj_remove_style(obj, obj_style->style, obj_style->selector);
@@ -871,6 +1050,51 @@ static void trans_anim_ready_cb(lv_anim_t * a)
     }
 }
 
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+/**
+ * Get the snapshot of a part of an object in its current state.
+ * If there is no such snapshot, an unused or the least recently used one of the set is cleared for it.
+ * @param obj pointer to an object
+ * @param part the part of the object
+ * @return the snapshot. Its `valid` bits tell which properties are resolved already.
+ */
+static snapshot_t * snapshot_get(const lv_obj_t * obj, lv_part_t part)
+{
+    lv_state_t state = obj->state;
+    snapshot_t * snapshot = snapshot_last;
+    if(snapshot && snapshot->obj == obj && snapshot->part == part && snapshot->state == state) return snapshot;
+
+    uint32_t hash = (uint32_t)((lv_uintptr_t)obj >> 3) * 2654435761u;
+    snapshot_t * set = &snapshots[(hash >> 8) % SNAPSHOT_SETS * SNAPSHOT_WAYS];
+    snapshot_t * victim = NULL;
+    uint32_t i;
+    snapshot_tick++;
+    for(i = 0; i < SNAPSHOT_WAYS; i++) {
+        snapshot = &set[i];
+        if(snapshot->obj == obj && snapshot->part == part && snapshot->state == state) {
+            snapshot->last_use = snapshot_tick;
+            snapshot_last = snapshot;
+            return snapshot;
+        }
+
+        if(victim == NULL || victim->obj != NULL) {
+            if(snapshot->obj == NULL || victim == NULL || snapshot->last_use < victim->last_use) victim = snapshot;
+        }
+    }
+
+    if(victim->obj) snapshot_stats.evictions++;
+    else snapshot_used++;
+
+    victim->obj = obj;
+    victim->part = part;
+    victim->state = state;
+    victim->valid = 0;
+    victim->last_use = snapshot_tick;
+    snapshot_last = victim;
+    return victim;
+}
+#endif
+
 static lv_layer_type_t calculate_layer_type(lv_obj_t * obj)
 {
     if(lv_obj_get_style_transform_angle(obj, 0) != 0) return LV_LAYER_TYPE_TRANSFORM;
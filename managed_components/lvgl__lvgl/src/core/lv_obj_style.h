@@ -54,6 +54,13 @@ typedef struct {
 #endif
 } _lv_obj_style_transition_dsc_t;
 
+typedef struct {
+    uint32_t hits;          /**< Properties read from a snapshot, i.e. style lookups avoided*/
+    uint32_t misses;        /**< Properties looked up in the styles and stored in a snapshot*/
+    uint32_t evictions;     /**< Snapshots replaced by the snapshot of an other part, state or object*/
+    uint32_t invalidations; /**< Snapshots dropped because the styles, the state or the parent changed*/
+} lv_obj_style_snapshot_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -118,6 +125,32 @@ void lv_obj_refresh_style(struct _lv_obj_t * obj, lv_part_t part, lv_style_prop_
  */
 void lv_obj_enable_style_refresh(bool en);
 
+/**
+ * Enable or disable the style snapshots. A snapshot keeps the resolved draw properties of an object's part
+ * so they are looked up in the styles only once until the styles, the state or the parent of the object change.
+ * Disabling drops the snapshots. Only has effect if `LV_OBJ_STYLE_SNAPSHOT_CNT > 0`.
+ * @param en        true: use the snapshots; false: always look up the properties in the styles
+ */
+void lv_obj_enable_style_snapshot(bool en);
+
+/**
+ * Get the statistics of the style snapshots.
+ * @param stats_out     store the statistics here
+ */
+void lv_obj_style_snapshot_get_stats(lv_obj_style_snapshot_stats_t * stats_out);
+
+/**
+ * Clear the counters of the style snapshots.
+ */
+void lv_obj_style_snapshot_reset_stats(void);
+
+/**
+ * Drop the style snapshots of an object and its children.
+ * Used internally when the styles, the state or the parent of an object change and when it's deleted.
+ * @param obj       pointer to an object or NULL to drop every snapshot
+ */
+void _lv_obj_style_snapshot_invalidate(const struct _lv_obj_t * obj);
+
 /**
  * Get the value of a style property. The current state of the object will be considered.
  * Inherited properties will be inherited.
@@ -166,6 +166,7 @@ void lv_obj_set_parent(lv_obj_t * obj, lv_obj_t * parent)
     parent->spec_attr->children[lv_obj_get_child_cnt(parent) - 1] = obj;
 
     obj->parent = parent;
+    _lv_obj_style_snapshot_invalidate(obj);
 
     /*Notify the original parent because one of its children is lost*/
     lv_obj_scrollbar_invalidate(old_parent);
@@ -413,6 +414,7 @@ static void obj_del_core(lv_obj_t * obj)
     }
 
     /*Free the object itself*/
+    _lv_obj_style_snapshot_invalidate(obj);
     lv_mem_free(obj);
 }
 
@@ -26,6 +26,7 @@
 /*********************
  *      DEFINES
  *********************/
+#define MONITOR_PERIOD  300     /*Update the performance and memory monitors this often [ms]*/
 
 /**********************
  *      TYPEDEFS
@@ -36,6 +37,7 @@ typedef struct {
     uint32_t    frame_cnt;
     uint32_t    fps_sum_cnt;
     uint32_t    fps_sum_all;
+    uint32_t    flush_blocked_sum;  /*Time the rendering waited for the flushing*/
 #if LV_USE_LABEL
     lv_obj_t  * perf_label;
 #endif
@@ -52,6 +54,8 @@ typedef struct {
  *  STATIC PROTOTYPES
  **********************/
 static void lv_refr_join_area(void);
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2, lv_area_t * joined);
+static void add_overdraw(lv_disp_t * disp, const lv_area_t * joined, const lv_area_t * a1, const lv_area_t * a2);
 static void refr_invalid_areas(void);
 static void refr_sync_areas(void);
 static void refr_area(const lv_area_t * area_p);
@@ -61,6 +65,8 @@ static void refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static void refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
 static void draw_buf_flush(lv_disp_t * disp);
+static void wait_for_flushing(lv_disp_drv_t * drv);
+static void area_to_native(lv_disp_drv_t * drv, lv_area_t * area);
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
 
 #if LV_USE_PERF_MONITOR
@@ -69,6 +75,9 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
 #if LV_USE_MEM_MONITOR
     static void mem_monitor_init(mem_monitor_t * mem_monitor);
 #endif
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+    static void monitor_timer_cb(lv_timer_t * timer);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -84,6 +93,10 @@ static lv_disp_t * disp_refr; /*Display being refreshed*/
     static mem_monitor_t    mem_monitor;
 #endif
 
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+    static lv_timer_t * monitor_timer;
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -108,6 +121,9 @@ void _lv_refr_init(void)
 #if LV_USE_MEM_MONITOR
     mem_monitor_init(&mem_monitor);
 #endif
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+    monitor_timer = NULL;
+#endif
 }
 
 void lv_refr_now(lv_disp_t * disp)
@@ -241,6 +257,8 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
 
     if(disp->driver->rounder_cb) disp->driver->rounder_cb(disp->driver, &com_area);
 
+    disp->inv_stats.areas_in++;
+
     /*Save only if this area is not in one of the saved areas*/
     uint16_t i;
     for(i = 0; i < disp->inv_p; i++) {
@@ -250,12 +268,25 @@ void _lv_inv_area(lv_disp_t * disp, const lv_area_t * area_p)
     /*Save the area*/
     if(disp->inv_p < LV_INV_BUF_SIZE) {
         lv_area_copy(&disp->inv_areas[disp->inv_p], &com_area);
+        disp->inv_p++;
     }
-    else {   /*If no place for the area add the screen*/
-        disp->inv_p = 0;
-        lv_area_copy(&disp->inv_areas[disp->inv_p], &scr_area);
+    else {
+        /*If no place for the area join it into the saved area where it's the cheapest*/
+        uint16_t best_i = 0;
+        int32_t best_cost = INT32_MAX;
+        lv_area_t joined_area;
+        for(i = 0; i < disp->inv_p; i++) {
+            int32_t cost = get_join_cost(&disp->inv_areas[i], &com_area, &joined_area);
+            if(cost < best_cost) {
+                best_cost = cost;
+                best_i = i;
+            }
+        }
+
+        _lv_area_join(&joined_area, &disp->inv_areas[best_i], &com_area);
+        add_overdraw(disp, &joined_area, &disp->inv_areas[best_i], &com_area);
+        lv_area_copy(&disp->inv_areas[best_i], &joined_area);
     }
-    disp->inv_p++;
     if(disp->refr_timer) lv_timer_resume(disp->refr_timer);
 }
 
@@ -292,13 +323,6 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
 
     if(tmr) {
         disp_refr = tmr->user_data;
-#if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
-        /**
-         * Ensure the timer does not run again automatically.
-         * This is done before refreshing in case refreshing invalidates something else.
-         */
-        lv_timer_pause(tmr);
-#endif
     }
     else {
         disp_refr = lv_disp_get_default();
@@ -311,6 +335,19 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     lv_obj_update_layout(disp_refr->top_layer);
     lv_obj_update_layout(disp_refr->sys_layer);
 
+    if(tmr) {
+        /**
+         * Ensure the timer does not run again automatically.
+         * This is done before refreshing in case refreshing invalidates something else,
+         * but after the layout update as its invalidations are refreshed now.
+         * The monitors have their own timer to be updated when nothing else is refreshed.
+         */
+        lv_timer_pause(tmr);
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+        if(monitor_timer == NULL) monitor_timer = lv_timer_create(monitor_timer_cb, MONITOR_PERIOD, NULL);
+#endif
+    }
+
     /*Do nothing if there is no active screen*/
     if(disp_refr->act_scr == NULL) {
         disp_refr->inv_p = 0;
@@ -376,7 +413,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.perf_label = perf_label;
     }
 
-    if(lv_tick_elaps(perf_monitor.perf_last_time) < 300) {
+    if(lv_tick_elaps(perf_monitor.perf_last_time) < MONITOR_PERIOD) {
         if(px_num > 5000) {
             perf_monitor.elaps_sum += elaps;
             perf_monitor.frame_cnt ++;
@@ -412,7 +449,18 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         perf_monitor.fps_sum_all += fps;
         perf_monitor.fps_sum_cnt ++;
         uint32_t cpu = 100 - lv_timer_get_idle();
-        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU", fps, cpu);
+
+        /*The part of the flushing time when rendering could continue*/
+        lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
+        uint32_t flush_time = draw_buf->flush_time_sum;
+        uint32_t overlap = 0;
+        if(flush_time > perf_monitor.flush_blocked_sum) {
+            overlap = ((flush_time - perf_monitor.flush_blocked_sum) * 100) / flush_time;
+        }
+        draw_buf->flush_time_sum = 0;
+        perf_monitor.flush_blocked_sum = 0;
+
+        lv_label_set_text_fmt(perf_label, "%"LV_PRIu32" FPS\n%"LV_PRIu32"%% CPU\n%"LV_PRIu32"%% overlap", fps, cpu, overlap);
     }
 #endif
 
@@ -432,7 +480,7 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
         mem_monitor.mem_label = mem_label;
     }
 
-    if(lv_tick_elaps(mem_monitor.mem_last_time) > 300) {
+    if(lv_tick_elaps(mem_monitor.mem_last_time) > MONITOR_PERIOD) {
         mem_monitor.mem_last_time = lv_tick_get();
         lv_mem_monitor_t mon;
         lv_mem_monitor(&mon);
@@ -471,7 +519,7 @@ uint32_t lv_refr_get_fps_avg(void)
  **********************/
 
 /**
- * Join the areas which has got common parts
+ * Join the areas which are cheaper to redraw together than separately
  */
 static void lv_refr_join_area(void)
 {
@@ -488,16 +536,9 @@ static void lv_refr_join_area(void)
                 continue;
             }
 
-            /*Check if the areas are on each other*/
-            if(_lv_area_is_on(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]) == false) {
-                continue;
-            }
-
-            _lv_area_join(&joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
-
-            /*Join two area only if the joined area size is smaller*/
-            if(lv_area_get_size(&joined_area) < (lv_area_get_size(&disp_refr->inv_areas[join_in]) +
-                                                 lv_area_get_size(&disp_refr->inv_areas[join_from]))) {
+            /*Join two area only if it's cheaper to redraw the joined area*/
+            if(get_join_cost(&disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from], &joined_area) < 0) {
+                add_overdraw(disp_refr, &joined_area, &disp_refr->inv_areas[join_in], &disp_refr->inv_areas[join_from]);
                 lv_area_copy(&disp_refr->inv_areas[join_in], &joined_area);
 
                 /*Mark 'join_form' is joined into 'join_in'*/
@@ -507,6 +548,40 @@ static void lv_refr_join_area(void)
     }
 }
 
+/**
+ * Get how much more it costs to redraw two areas as one joined area than separately.
+ * The cost is the number of redrawn pixels plus `LV_INV_AREA_OVERHEAD` per area.
+ * @param a1        pointer to an area
+ * @param a2        pointer to an other area
+ * @param joined    store the joined area here
+ * @return          the cost of joining, negative if the joined area is cheaper to redraw
+ */
+static int32_t get_join_cost(const lv_area_t * a1, const lv_area_t * a2, lv_area_t * joined)
+{
+    _lv_area_join(joined, a1, a2);
+    return (int32_t)lv_area_get_size(joined) - (int32_t)lv_area_get_size(a1) - (int32_t)lv_area_get_size(a2) -
+           LV_INV_AREA_OVERHEAD;
+}
+
+/**
+ * Count the pixels which are in a joined area but were not in the original areas
+ * @param disp      pointer to a display
+ * @param joined    the joined area
+ * @param a1        the first area before joining
+ * @param a2        the second area before joining
+ */
+static void add_overdraw(lv_disp_t * disp, const lv_area_t * joined, const lv_area_t * a1, const lv_area_t * a2)
+{
+    int32_t overdraw = (int32_t)lv_area_get_size(joined) - (int32_t)lv_area_get_size(a1) -
+                       (int32_t)lv_area_get_size(a2);
+
+    /*Add back the common part which was subtracted twice*/
+    lv_area_t common;
+    if(_lv_area_intersect(&common, a1, a2)) overdraw += lv_area_get_size(&common);
+
+    if(overdraw > 0) disp->inv_stats.overdraw_px += overdraw;
+}
+
 /**
  * Refresh the sync areas
  */
@@ -616,6 +691,7 @@ static void refr_invalid_areas(void)
             refr_area(&disp_refr->inv_areas[i]);
 
             px_num += lv_area_get_size(&disp_refr->inv_areas[i]);
+            disp_refr->inv_stats.areas_out++;
         }
     }
 
@@ -706,9 +782,7 @@ static void refr_area_part(lv_draw_ctx_t * draw_ctx)
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if((draw_buf->buf1 && !draw_buf->buf2) ||
        (draw_buf->buf1 && draw_buf->buf2 && full_sized)) {
-        while(draw_buf->flushing) {
-            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-        }
+        wait_for_flushing(disp_refr->driver);
 
         /*If the screen is transparent initialize it when the flushing is ready*/
 #if LV_COLOR_SCREEN_TRANSP
@@ -1187,8 +1261,6 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
         call_flush_cb(drv, area, color_p);
     }
     else if(drv->rotated == LV_DISP_ROT_90 || drv->rotated == LV_DISP_ROT_270) {
-        /*Allocate a temporary buffer to store rotated image*/
-        lv_color_t * rot_buf = NULL;
         lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(disp_refr);
         lv_coord_t area_w = lv_area_get_width(area);
         lv_coord_t area_h = lv_area_get_height(area);
@@ -1205,11 +1277,13 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             area->y2 = area->y1 + area_w - 1;
         }
 
-        /*Rotate the screen in chunks, flushing after each one*/
+        /*Rotate the screen in chunks, flushing after each one.
+         *The chunks are rotated into two buffers in turns, so a chunk is rotated while the previous one is flushed*/
         lv_coord_t row = 0;
+        uint32_t rot_buf_id = 0;
         while(row < area_h) {
             lv_coord_t height = LV_MIN(max_row, area_h - row);
-            draw_buf->flushing = 1;
+            lv_color_t * flush_buf;
             if((row == 0) && (area_h >= area_w)) {
                 /*Rotate the initial area as a square*/
                 height = area_w;
@@ -1222,11 +1296,21 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
                     area->x2 = drv->hor_res - 1 - init_y_off;
                     area->x1 = area->x2 - area_w + 1;
                 }
+                flush_buf = color_p;
             }
             else {
                 /*Rotate other areas using a maximum buffer size*/
-                if(rot_buf == NULL) rot_buf = lv_mem_buf_get(LV_DISP_ROT_MAX_BUF);
-                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, rot_buf);
+                if(disp_refr->rot_bufs[rot_buf_id] == NULL) {
+                    disp_refr->rot_bufs[rot_buf_id] = lv_mem_alloc(LV_DISP_ROT_MAX_BUF);
+                    LV_ASSERT_MALLOC(disp_refr->rot_bufs[rot_buf_id]);
+                    if(disp_refr->rot_bufs[rot_buf_id] == NULL) {
+                        LV_LOG_ERROR("couldn't allocate the rotation buffer");
+                        break;
+                    }
+                }
+                flush_buf = disp_refr->rot_bufs[rot_buf_id];
+                rot_buf_id = rot_buf_id == 0 ? 1 : 0;
+                draw_buf_rotate_90(drv->rotated == LV_DISP_ROT_270, area_w, height, color_p, flush_buf);
 
                 if(drv->rotated == LV_DISP_ROT_90) {
                     area->x1 = init_y_off + row;
@@ -1238,6 +1322,11 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
                 }
             }
 
+            /*The previous chunk was flushed while this one was rotated. Wait only now if it's still not ready.
+             *Nothing is flushed yet when the first chunk is rotated.*/
+            if(row != 0) wait_for_flushing(drv);
+            draw_buf->flushing = 1;
+
             /* The original part (chunk of the current area) were split into more parts here.
              * Set the original last_part flag on the last part of rotation. */
             if(row + height >= area_h && draw_buf->last_area && draw_buf->last_part) {
@@ -1248,16 +1337,10 @@ static void draw_buf_rotate(lv_area_t * area, lv_color_t * color_p)
             }
 
             /*Flush the completed area to the display*/
-            call_flush_cb(drv, area, rot_buf == NULL ? color_p : rot_buf);
-            /*FIXME: Rotation forces legacy behavior where rendering and flushing are done serially*/
-            while(draw_buf->flushing) {
-                if(drv->wait_cb) drv->wait_cb(drv);
-            }
+            call_flush_cb(drv, area, flush_buf);
             color_p += area_w * height;
             row += height;
         }
-        /*Free the allocated buffer at the end if necessary*/
-        if(rot_buf != NULL) lv_mem_buf_release(rot_buf);
     }
 }
 
@@ -1276,9 +1359,7 @@ static void draw_buf_flush(lv_disp_t * disp)
      * and driver is ready to receive the new buffer */
     bool full_sized = draw_buf->size == (uint32_t)disp_refr->driver->hor_res * disp_refr->driver->ver_res;
     if(draw_buf->buf1 && draw_buf->buf2 && !full_sized) {
-        while(draw_buf->flushing) {
-            if(disp_refr->driver->wait_cb) disp_refr->driver->wait_cb(disp_refr->driver);
-        }
+        wait_for_flushing(disp_refr->driver);
     }
 
     draw_buf->flushing = 1;
@@ -1289,8 +1370,14 @@ static void draw_buf_flush(lv_disp_t * disp)
     bool flushing_last = draw_buf->flushing_last;
 
     if(disp->driver->flush_cb) {
+        /*The buffer is already rendered in the display's native orientation, only the area needs to be converted*/
+        if(disp->driver->rotated != LV_DISP_ROT_NONE && disp->driver->sw_rotate && disp->driver->render_rotated) {
+            lv_area_t native_area = *draw_ctx->buf_area;
+            area_to_native(disp->driver, &native_area);
+            call_flush_cb(disp->driver, &native_area, draw_ctx->buf);
+        }
         /*Rotate the buffer to the display's native orientation if necessary*/
-        if(disp->driver->rotated != LV_DISP_ROT_NONE && disp->driver->sw_rotate) {
+        else if(disp->driver->rotated != LV_DISP_ROT_NONE && disp->driver->sw_rotate) {
             draw_buf_rotate(draw_ctx->buf_area, draw_ctx->buf);
         }
         else {
@@ -1307,6 +1394,54 @@ static void draw_buf_flush(lv_disp_t * disp)
     }
 }
 
+/**
+ * Wait until the flushing of the previous area is ready
+ */
+static void wait_for_flushing(lv_disp_drv_t * drv)
+{
+#if LV_USE_PERF_MONITOR
+    uint32_t start = lv_tick_get();
+#endif
+
+    while(drv->draw_buf->flushing) {
+        if(drv->wait_cb) drv->wait_cb(drv);
+    }
+
+#if LV_USE_PERF_MONITOR
+    perf_monitor.flush_blocked_sum += lv_tick_elaps(start);
+#endif
+}
+
+/**
+ * Convert an area from the rotated coordinates to the display's native orientation.
+ */
+static void area_to_native(lv_disp_drv_t * drv, lv_area_t * area)
+{
+    lv_area_t ori = *area;
+    switch(drv->rotated) {
+        case LV_DISP_ROT_90:
+            area->x1 = ori.y1;
+            area->x2 = ori.y2;
+            area->y1 = drv->ver_res - ori.x2 - 1;
+            area->y2 = drv->ver_res - ori.x1 - 1;
+            break;
+        case LV_DISP_ROT_180:
+            area->x1 = drv->hor_res - ori.x2 - 1;
+            area->x2 = drv->hor_res - ori.x1 - 1;
+            area->y1 = drv->ver_res - ori.y2 - 1;
+            area->y2 = drv->ver_res - ori.y1 - 1;
+            break;
+        case LV_DISP_ROT_270:
+            area->x1 = drv->hor_res - ori.y2 - 1;
+            area->x2 = drv->hor_res - ori.y1 - 1;
+            area->y1 = ori.x1;
+            area->y2 = ori.x2;
+            break;
+        default:
+            break;
+    }
+}
+
 static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
 {
     REFR_TRACE("Calling flush_cb on (%d;%d)(%d;%d) area with %p image pointer", area->x1, area->y1, area->x2, area->y2,
@@ -1319,7 +1454,17 @@ static void call_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_
         .y2 = area->y2 + drv->offset_y
     };
 
+#if LV_USE_PERF_MONITOR
+    uint32_t start = lv_tick_get();
+    drv->draw_buf->flush_start = start;
+#endif
+
     drv->flush_cb(drv, &offset_area, color_p);
+
+#if LV_USE_PERF_MONITOR
+    /*Rendering can't continue while `flush_cb` is running*/
+    perf_monitor.flush_blocked_sum += lv_tick_elaps(start);
+#endif
 }
 
 #if LV_USE_PERF_MONITOR
@@ -1330,6 +1475,7 @@ static void perf_monitor_init(perf_monitor_t * _perf_monitor)
     _perf_monitor->fps_sum_all = 0;
     _perf_monitor->fps_sum_cnt = 0;
     _perf_monitor->frame_cnt = 0;
+    _perf_monitor->flush_blocked_sum = 0;
     _perf_monitor->perf_last_time = 0;
     _perf_monitor->perf_label = NULL;
 }
@@ -1343,3 +1489,16 @@ static void mem_monitor_init(mem_monitor_t * _mem_monitor)
     _mem_monitor->mem_label = NULL;
 }
 #endif
+
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+/**
+ * Refresh the display of the monitors periodically, even if nothing else changes
+ * @param timer pointer to the timer
+ */
+static void monitor_timer_cb(lv_timer_t * timer)
+{
+    LV_UNUSED(timer);
+    lv_disp_t * disp = lv_disp_get_default();
+    if(disp && disp->refr_timer) lv_timer_resume(disp->refr_timer);
+}
+#endif
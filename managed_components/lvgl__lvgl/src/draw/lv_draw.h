@@ -19,6 +19,7 @@ extern "C" {
 #include "../misc/lv_txt.h"
 #include "lv_img_decoder.h"
 #include "lv_img_cache.h"
+#include "lv_img_async.h"
 
 #include "lv_draw_rect.h"
 #include "lv_draw_label.h"
@@ -53,6 +54,7 @@ typedef struct _lv_draw_layer_ctx_t {
         lv_area_t * buf_area;
         void * buf;
         bool screen_transp;
+        bool render_rotated;
     } original;
 } lv_draw_layer_ctx_t;
 
@@ -8,6 +8,7 @@ CSRCS += lv_draw_rect.c
 CSRCS += lv_draw_transform.c
 CSRCS += lv_draw_layer.c
 CSRCS += lv_draw_triangle.c
+CSRCS += lv_img_async.c
 CSRCS += lv_img_buf.c
 CSRCS += lv_img_cache.c
 CSRCS += lv_img_decoder.c
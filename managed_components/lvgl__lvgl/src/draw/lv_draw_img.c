@@ -262,6 +262,18 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         }
     }
 
+    /*Transformed images need all the pixels at once. Decode them temporarily if the decoder reads lines*/
+    uint8_t * tmp_data = NULL;
+    if(cdsc->dec_dsc.img_data == NULL && cdsc->dec_dsc.error_msg == NULL && cdsc->dec_dsc.decoder->decode_cb &&
+       (draw_dsc->angle || draw_dsc->zoom != LV_IMG_ZOOM_NONE)) {
+        tmp_data = lv_mem_alloc(lv_img_buf_get_img_size(cdsc->dec_dsc.header.w, cdsc->dec_dsc.header.h,
+                                                        cdsc->dec_dsc.header.cf));
+        LV_ASSERT_MALLOC(tmp_data);
+        if(tmp_data && lv_img_decoder_decode(&cdsc->dec_dsc, tmp_data) == LV_RES_OK) {
+            cdsc->dec_dsc.img_data = tmp_data;
+        }
+    }
+
     if(cdsc->dec_dsc.error_msg != NULL) {
         LV_LOG_WARN("Image draw error");
 
@@ -287,16 +299,15 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         lv_area_t clip_com; /*Common area of mask and coords*/
         bool union_ok;
         union_ok = _lv_area_intersect(&clip_com, draw_ctx->clip_area, &map_area_rot);
-        /*Out of mask. There is nothing to draw so the image is drawn successfully.*/
-        if(union_ok == false) {
-            draw_cleanup(cdsc);
-            return LV_RES_OK;
+        /*If it's out of the mask there is nothing to draw so the image is drawn successfully.*/
+        if(union_ok) {
+            const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+            draw_ctx->clip_area = &clip_com;
+            lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
+            draw_ctx->clip_area = clip_area_ori;
         }
 
-        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
-        draw_ctx->clip_area = &clip_com;
-        lv_draw_img_decoded(draw_ctx, draw_dsc, coords, cdsc->dec_dsc.img_data, cf);
-        draw_ctx->clip_area = clip_area_ori;
+        if(tmp_data) cdsc->dec_dsc.img_data = NULL;
     }
     /*The whole uncompressed image is not available. Try to read it line-by-line*/
     else {
@@ -347,6 +358,7 @@ static lv_res_t LV_ATTRIBUTE_FAST_MEM decode_and_draw(lv_draw_ctx_t * draw_ctx,
         lv_mem_buf_release(buf);
     }
 
+    if(tmp_data) lv_mem_free(tmp_data);
     draw_cleanup(cdsc);
     return LV_RES_OK;
 }
@@ -365,10 +377,6 @@ static void show_error(lv_draw_ctx_t * draw_ctx, const lv_area_t * coords, const
 
 static void draw_cleanup(_lv_img_cache_entry_t * cache)
 {
-    /*Automatically close images with no caching*/
-#if LV_IMG_CACHE_DEF_SIZE == 0
-    lv_img_decoder_close(&cache->dec_dsc);
-#else
-    LV_UNUSED(cache);
-#endif
+    /*Automatically close images which couldn't be cached*/
+    _lv_img_cache_release(cache);
 }
@@ -284,7 +284,7 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
             if(cmd_state == CMD_STATE_IN) color = recolor;
 
-            letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+            letter_w = _lv_txt_get_letter_width(font, letter, letter_next, dsc->flag);
 
             if(sel_start != 0xFFFF && sel_end != 0xFFFF) {
                 if(logical_char_pos >= sel_start && logical_char_pos < sel_end) {
@@ -299,7 +299,15 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
             }
 
             dsc_mod.color = color;
-            lv_draw_letter(draw_ctx, &dsc_mod, &pos, letter);
+            if((dsc->flag & LV_TEXT_FLAG_FIXED_DIGITS) && letter >= '0' && letter <= '9') {
+                /*Center the digit in its cell*/
+                lv_point_t digit_pos = pos;
+                digit_pos.x += (letter_w - lv_font_get_glyph_width(font, letter, '\0')) / 2;
+                lv_draw_letter(draw_ctx, &dsc_mod, &digit_pos, letter);
+            }
+            else {
+                lv_draw_letter(draw_ctx, &dsc_mod, &pos, letter);
+            }
 
             if(letter_w > 0) {
                 pos.x += letter_w + dsc->letter_space;
@@ -0,0 +1,568 @@
+/**
+ * @file lv_img_async.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_async.h"
+#include "lv_img_decoder.h"
+#include "../core/lv_obj.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_fs.h"
+#include "../misc/lv_timer.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*The worker calls the decoders which allocate with `lv_mem_alloc`*/
+#define WORKER_SAFE     LV_MEM_CUSTOM
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    JOB_QUEUED,
+    JOB_RUNNING,    /*Submitted to the worker*/
+    JOB_DONE,       /*Kept while objects refer to it to draw the image at once if it was evicted*/
+    JOB_FAILED,     /*Kept while objects refer to it to not decode it again*/
+} job_state_t;
+
+typedef struct {
+    lv_img_async_job_t job;     /*Given to the worker, needs to be the first*/
+
+    /*Set before the job is submitted and used by the worker*/
+    lv_img_decoder_t * decoder;
+    lv_img_dsc_t data;          /*The encoded image: the bytes of the file or a copy of the variable*/
+    lv_img_header_t header;
+    lv_color_t color;
+    uint8_t * pixels;
+    uint32_t size;
+    lv_res_t res;
+
+    /*Used only in the LVGL thread*/
+    const void * src;           /*The variable or a copy of the path*/
+    uint8_t * file_data;
+    lv_img_cache_free_cb_t pixels_free;
+    lv_ll_t obj_ll;             /*The objects drawing the image*/
+    job_state_t state;
+} job_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_IMG_ASYNC_QUEUE_LEN
+    static job_t * job_create(const void * src, lv_color_t color, lv_img_decoder_t * decoder,
+                              const lv_img_header_t * header);
+    static void job_free(job_t * job);
+    static job_t * job_find(const void * src, lv_color_t color);
+    static job_t * job_next(void);
+    static lv_res_t job_prepare(job_t * job);
+    static void job_unprepare(job_t * job);
+    static void job_finish(job_t * job, lv_res_t res);
+    static void worker_finish(job_t * job);
+    static void timer_decode(job_t * job);
+    static void timer_cb(lv_timer_t * t);
+    static uint32_t pixels_size(const lv_img_header_t * header);
+    static lv_img_decoder_t * decoder_find(const void * src, lv_img_header_t * header);
+    static bool obj_find(job_t * job, lv_obj_t * obj);
+    static bool obj_add(job_t * job, lv_obj_t * obj);
+    static bool obj_remove(job_t * job, lv_obj_t * obj);
+    static bool src_match(const void * src1, const void * src2);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_img_async_stats_t stats;
+#if LV_IMG_ASYNC_QUEUE_LEN
+    static lv_img_async_submit_cb_t worker_submit_cb;
+    static lv_img_async_wait_cb_t worker_wait_cb;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the background decoding of the images
+ */
+void _lv_img_async_init(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+#if LV_IMG_ASYNC_QUEUE_LEN
+    _lv_ll_init(&LV_GC_ROOT(_lv_img_async_ll), sizeof(job_t));
+    LV_GC_ROOT(_lv_img_async_timer) = NULL;
+    worker_submit_cb = NULL;
+    worker_wait_cb = NULL;
+#endif
+}
+
+/**
+ * Queue an image to be decoded into the image cache in the background.
+ * The object is invalidated when the image is decoded.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param obj the object which draws the image
+ * @return LV_RES_OK: the image is being decoded, draw a placeholder;
+ *         LV_RES_INV: draw the image now (it's cached, can't be queued or couldn't be decoded)
+ */
+lv_res_t _lv_img_async_request(const void * src, lv_color_t color, lv_obj_t * obj)
+{
+#if LV_IMG_ASYNC_QUEUE_LEN
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type != LV_IMG_SRC_FILE && src_type != LV_IMG_SRC_VARIABLE) return LV_RES_INV;
+    if(src_type == LV_IMG_SRC_VARIABLE && ((const lv_img_dsc_t *)src)->data == NULL) return LV_RES_INV;
+
+    job_t * job = job_find(src, color);
+    if(job == NULL) {
+        if(_lv_img_cache_contains(src, color)) return LV_RES_INV;
+
+        /*Only the images decoded into the cache can be drawn later*/
+        lv_img_header_t header;
+        lv_img_decoder_t * decoder = decoder_find(src, &header);
+        if(decoder == NULL || decoder->open_cb == lv_img_decoder_built_in_open) return LV_RES_INV;
+        if(!_lv_img_cache_fits(pixels_size(&header))) return LV_RES_INV;
+
+        if(stats.queued >= LV_IMG_ASYNC_QUEUE_LEN) {
+            stats.rejected++;
+            LV_LOG_INFO("the queue is full, the image is decoded now");
+            return LV_RES_INV;
+        }
+
+        job = job_create(src, color, decoder, &header);
+        if(job == NULL) return LV_RES_INV;
+        stats.requests++;
+    }
+
+    if(!obj_find(job, obj)) {
+        /*The object might have waited for another image before*/
+        _lv_img_async_cancel(obj);
+        if(!obj_add(job, obj)) {
+            if(_lv_ll_is_empty(&job->obj_ll) && job->state == JOB_QUEUED) {
+                stats.queued--;
+                job_free(job);
+            }
+            return LV_RES_INV;
+        }
+    }
+
+    if(job->state != JOB_QUEUED && job->state != JOB_RUNNING) return LV_RES_INV;
+
+    lv_timer_t * timer = LV_GC_ROOT(_lv_img_async_timer);
+    if(timer == NULL) {
+        timer = lv_timer_create(timer_cb, LV_DISP_DEF_REFR_PERIOD, NULL);
+        LV_ASSERT_MALLOC(timer);
+        LV_GC_ROOT(_lv_img_async_timer) = timer;
+    }
+    if(timer) lv_timer_resume(timer);
+
+    return LV_RES_OK;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_UNUSED(obj);
+    return LV_RES_INV;
+#endif
+}
+
+/**
+ * Forget the image requested by an object. The image isn't decoded if no other object waits for it.
+ * @param obj an object given to `_lv_img_async_request`
+ */
+void _lv_img_async_cancel(lv_obj_t * obj)
+{
+#if LV_IMG_ASYNC_QUEUE_LEN
+    job_t * job;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_async_ll), job) {
+        if(!obj_remove(job, obj)) continue;
+
+        /*The running job is freed when it's finished, its image is still cached*/
+        if(_lv_ll_is_empty(&job->obj_ll) && job->state != JOB_RUNNING) {
+            if(job->state == JOB_QUEUED) {
+                stats.canceled++;
+                stats.queued--;
+            }
+            job_free(job);
+        }
+        /*An object waits only for one image*/
+        return;
+    }
+#else
+    LV_UNUSED(obj);
+#endif
+}
+
+/**
+ * Decode the images in another thread instead of the LVGL thread.
+ * Only the decoders marked `thread_safe` can be used by the worker and only if `lv_mem_alloc` is thread safe,
+ * the images of other decoders are decoded in `lv_timer_handler`.
+ * @param submit_cb     function to pass a job to the worker or NULL to decode in `lv_timer_handler`
+ * @param wait_cb       function to wait for a finished job
+ */
+void lv_img_async_set_worker(lv_img_async_submit_cb_t submit_cb, lv_img_async_wait_cb_t wait_cb)
+{
+#if LV_IMG_ASYNC_QUEUE_LEN == 0
+    LV_UNUSED(submit_cb);
+    LV_UNUSED(wait_cb);
+    LV_LOG_WARN("Can't set the worker because the background decoding is disabled by LV_IMG_ASYNC_QUEUE_LEN = 0");
+#elif WORKER_SAFE == 0
+    LV_UNUSED(submit_cb);
+    LV_UNUSED(wait_cb);
+    LV_LOG_WARN("Can't set the worker because lv_mem_alloc is not thread safe with LV_MEM_CUSTOM = 0");
+#else
+    /*The running job is finished by the timer with the old callbacks*/
+    job_t * job;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_async_ll), job) {
+        if(job->state == JOB_RUNNING) {
+            if(worker_wait_cb) worker_wait_cb(&job->job);
+            while(!job->job.done) {}
+            worker_finish(job);
+            break;
+        }
+    }
+
+    worker_submit_cb = submit_cb;
+    worker_wait_cb = wait_cb;
+#endif
+}
+
+/**
+ * Decode the image of a job. Can be called from any thread, it uses only the memory of the job.
+ * @param job       pointer to a job given to `submit_cb`
+ */
+void lv_img_async_job_run(lv_img_async_job_t * job)
+{
+#if LV_IMG_ASYNC_QUEUE_LEN
+    job_t * j = (job_t *)job;
+    lv_img_decoder_t * decoder = j->decoder;
+
+    /*Decode the bytes in memory like a C array, the file is read by the LVGL thread*/
+    lv_img_decoder_dsc_t dsc;
+    lv_memset_00(&dsc, sizeof(dsc));
+    dsc.decoder = decoder;
+    dsc.src = &j->data;
+    dsc.src_type = LV_IMG_SRC_VARIABLE;
+    dsc.color = j->color;
+    dsc.header = j->header;
+
+    lv_res_t res = decoder->open_cb(decoder, &dsc);
+    if(res == LV_RES_OK) {
+        uint32_t size = lv_img_buf_get_img_size(dsc.header.w, dsc.header.h, dsc.header.cf);
+        if(size == 0 || size > j->size) res = LV_RES_INV;
+        else if(dsc.img_data) lv_memcpy(j->pixels, dsc.img_data, size);
+        else if(decoder->decode_cb) res = decoder->decode_cb(decoder, &dsc, j->pixels);
+        else res = LV_RES_INV;
+
+        j->header = dsc.header;
+        if(decoder->close_cb) decoder->close_cb(decoder, &dsc);
+    }
+
+    j->res = res;
+    job->done = true;
+#else
+    LV_UNUSED(job);
+#endif
+}
+
+/**
+ * Get the statistics of the background decoding.
+ * @param stats_out     store the statistics here
+ */
+void lv_img_async_get_stats(lv_img_async_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+/**
+ * Clear the counters of the background decoding.
+ */
+void lv_img_async_reset_stats(void)
+{
+    uint16_t queued = stats.queued;
+    lv_memset_00(&stats, sizeof(stats));
+    stats.queued = queued;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_IMG_ASYNC_QUEUE_LEN
+
+static job_t * job_create(const void * src, lv_color_t color, lv_img_decoder_t * decoder,
+                          const lv_img_header_t * header)
+{
+    job_t * job = _lv_ll_ins_tail(&LV_GC_ROOT(_lv_img_async_ll));
+    LV_ASSERT_MALLOC(job);
+    if(job == NULL) return NULL;
+    lv_memset_00(job, sizeof(job_t));
+
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        char * path = lv_mem_alloc(strlen(src) + 1);
+        LV_ASSERT_MALLOC(path);
+        if(path == NULL) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_img_async_ll), job);
+            lv_mem_free(job);
+            return NULL;
+        }
+        strcpy(path, src);
+        job->src = path;
+    }
+    else {
+        job->src = src;
+    }
+
+    job->decoder = decoder;
+    job->header = *header;
+    job->color = color;
+    job->size = pixels_size(header);
+    job->state = JOB_QUEUED;
+    _lv_ll_init(&job->obj_ll, sizeof(lv_obj_t *));
+    stats.queued++;
+
+    return job;
+}
+
+static void job_free(job_t * job)
+{
+    job_unprepare(job);
+    if(lv_img_src_get_type(job->src) == LV_IMG_SRC_FILE) lv_mem_free((void *)job->src);
+    _lv_ll_clear(&job->obj_ll);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_async_ll), job);
+    lv_mem_free(job);
+}
+
+static job_t * job_find(const void * src, lv_color_t color)
+{
+    job_t * job;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_async_ll), job) {
+        if(job->color.full == color.full && src_match(src, job->src)) return job;
+    }
+
+    return NULL;
+}
+
+/*Get the oldest queued image of a visible object or the oldest queued image if none of them is visible*/
+static job_t * job_next(void)
+{
+    job_t * first = NULL;
+    job_t * job;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_async_ll), job) {
+        if(job->state != JOB_QUEUED) continue;
+        if(first == NULL) first = job;
+
+        lv_obj_t ** obj_p;
+        _LV_LL_READ(&job->obj_ll, obj_p) {
+            if(lv_obj_is_visible(*obj_p)) return job;
+        }
+    }
+
+    return first;
+}
+
+/*Read the file and allocate the pixels for the worker*/
+static lv_res_t job_prepare(job_t * job)
+{
+    job->pixels = _lv_img_cache_alloc_pixels(job->size, &job->pixels_free);
+    if(job->pixels == NULL) {
+        LV_LOG_WARN("couldn't allocate %" LV_PRIu32 " bytes for the image", job->size);
+        return LV_RES_INV;
+    }
+
+    if(lv_img_src_get_type(job->src) == LV_IMG_SRC_VARIABLE) {
+        job->data = *(const lv_img_dsc_t *)job->src;
+    }
+    else {
+        lv_fs_file_t f;
+        if(lv_fs_open(&f, job->src, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            job_unprepare(job);
+            return LV_RES_INV;
+        }
+
+        uint32_t file_size = 0;
+        lv_fs_res_t res = lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+        if(res == LV_FS_RES_OK) res = lv_fs_tell(&f, &file_size);
+        if(res == LV_FS_RES_OK) res = lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+        if(res == LV_FS_RES_OK && file_size) {
+            job->file_data = lv_mem_alloc(file_size);
+            LV_ASSERT_MALLOC(job->file_data);
+            uint32_t br = 0;
+            if(job->file_data) res = lv_fs_read(&f, job->file_data, file_size, &br);
+            if(job->file_data == NULL || br != file_size) res = LV_FS_RES_UNKNOWN;
+        }
+        lv_fs_close(&f);
+
+        if(res != LV_FS_RES_OK || job->file_data == NULL) {
+            job_unprepare(job);
+            return LV_RES_INV;
+        }
+
+        lv_memset_00(&job->data, sizeof(job->data));
+        job->data.data = job->file_data;
+        job->data.data_size = file_size;
+    }
+
+    job->job.user_data = NULL;
+    job->job.done = false;
+    job->res = LV_RES_INV;
+    return LV_RES_OK;
+}
+
+static void job_unprepare(job_t * job)
+{
+    if(job->file_data) {
+        lv_mem_free(job->file_data);
+        job->file_data = NULL;
+    }
+
+    if(job->pixels) {
+        job->pixels_free(job->pixels);
+        job->pixels = NULL;
+    }
+}
+
+/*Redraw the objects with the decoded image or without it if it failed*/
+static void job_finish(job_t * job, lv_res_t res)
+{
+    job->state = res == LV_RES_OK ? JOB_DONE : JOB_FAILED;
+    stats.queued--;
+    if(res != LV_RES_OK) stats.failed++;
+
+    lv_obj_t ** obj_p;
+    _LV_LL_READ(&job->obj_ll, obj_p) {
+        lv_obj_invalidate(*obj_p);
+    }
+
+    if(_lv_ll_is_empty(&job->obj_ll)) job_free(job);
+}
+
+/*Give the pixels decoded by the worker to the image cache*/
+static void worker_finish(job_t * job)
+{
+    lv_res_t res = job->res;
+    if(res == LV_RES_OK) {
+        stats.worker_decodes++;
+        res = _lv_img_cache_add(job->src, job->color, job->decoder, &job->header, job->pixels, job->pixels_free);
+        job->pixels = NULL;
+    }
+    job_unprepare(job);
+
+    job_finish(job, res);
+}
+
+/*Open the image in the cache in the LVGL thread*/
+static void timer_decode(job_t * job)
+{
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(job->src, job->color, 0);
+    lv_res_t res = entry ? LV_RES_OK : LV_RES_INV;
+    _lv_img_cache_release(entry);
+    stats.timer_decodes++;
+
+    job_finish(job, res);
+}
+
+static void timer_cb(lv_timer_t * t)
+{
+    job_t * job;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_async_ll), job) {
+        if(job->state != JOB_RUNNING) continue;
+
+        /*One image is decoded at once to decode the visible ones first*/
+        if(!job->job.done) return;
+        if(worker_wait_cb) worker_wait_cb(&job->job);
+        worker_finish(job);
+        break;
+    }
+
+    job = job_next();
+    if(job == NULL) {
+        lv_timer_pause(t);
+        return;
+    }
+
+    if(WORKER_SAFE && worker_submit_cb && job->decoder->thread_safe && job_prepare(job) == LV_RES_OK) {
+        job->state = JOB_RUNNING;
+        if(worker_submit_cb(&job->job)) return;
+
+        /*The worker is busy*/
+        job->state = JOB_QUEUED;
+        job_unprepare(job);
+    }
+
+    /*Only one image in a call to not block the rendering for long*/
+    timer_decode(job);
+}
+
+/*Size of the decoded pixels. The decoders of raw images tell the format only when they are opened*/
+static uint32_t pixels_size(const lv_img_header_t * header)
+{
+    uint32_t size = lv_img_buf_get_img_size(header->w, header->h, header->cf);
+    if(size == 0) size = (uint32_t)header->w * header->h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    return size;
+}
+
+/*Find the decoder which can open an image and get its header*/
+static lv_img_decoder_t * decoder_find(const void * src, lv_img_header_t * header)
+{
+    lv_img_decoder_t * decoder;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), decoder) {
+        if(decoder->info_cb == NULL || decoder->open_cb == NULL) continue;
+
+        lv_memset_00(header, sizeof(lv_img_header_t));
+        if(decoder->info_cb(decoder, src, header) == LV_RES_OK) return decoder;
+    }
+
+    return NULL;
+}
+
+static bool obj_find(job_t * job, lv_obj_t * obj)
+{
+    lv_obj_t ** obj_p;
+    _LV_LL_READ(&job->obj_ll, obj_p) {
+        if(*obj_p == obj) return true;
+    }
+
+    return false;
+}
+
+static bool obj_add(job_t * job, lv_obj_t * obj)
+{
+    lv_obj_t ** obj_p = _lv_ll_ins_tail(&job->obj_ll);
+    LV_ASSERT_MALLOC(obj_p);
+    if(obj_p == NULL) return false;
+
+    *obj_p = obj;
+    return true;
+}
+
+static bool obj_remove(job_t * job, lv_obj_t * obj)
+{
+    lv_obj_t ** obj_p;
+    _LV_LL_READ(&job->obj_ll, obj_p) {
+        if(*obj_p == obj) {
+            _lv_ll_remove(&job->obj_ll, obj_p);
+            lv_mem_free(obj_p);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static bool src_match(const void * src1, const void * src2)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src1);
+    if(src_type != lv_img_src_get_type(src2)) return false;
+    if(src_type == LV_IMG_SRC_VARIABLE) return src1 == src2;
+    return strcmp(src1, src2) == 0;
+}
+
+#endif /*LV_IMG_ASYNC_QUEUE_LEN*/
@@ -0,0 +1,118 @@
+/**
+ * @file lv_img_async.h
+ *
+ */
+
+#ifndef LV_IMG_ASYNC_H
+#define LV_IMG_ASYNC_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_img_cache.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+/** An image to decode by a worker. See `lv_img_async_set_worker`*/
+typedef struct {
+    void * user_data;       /**< Free to use by the worker. NULL when the job is submitted*/
+    volatile bool done;     /**< Set by `lv_img_async_job_run` when the image is decoded*/
+} lv_img_async_job_t;
+
+/**
+ * Pass a job to a worker thread which calls `lv_img_async_job_run(job)`. Called from the LVGL thread.
+ * Return false if the job can't be queued now, LVGL decodes the image in `lv_timer_handler` then.
+ */
+typedef bool (*lv_img_async_submit_cb_t)(lv_img_async_job_t * job);
+
+/**
+ * Wait until the worker has finished a submitted job. Called from the LVGL thread when `done` was seen set
+ * or the worker is changed. The pixels written by the worker need to be visible when it returns,
+ * e.g. wait for a semaphore given by the worker after `lv_img_async_job_run`.
+ */
+typedef void (*lv_img_async_wait_cb_t)(lv_img_async_job_t * job);
+
+/** Statistics of the images decoded in the background*/
+typedef struct {
+    uint32_t requests;          /**< Images which weren't in the image cache when they were drawn*/
+    uint32_t worker_decodes;    /**< Images decoded by the worker*/
+    uint32_t timer_decodes;     /**< Images decoded in `lv_timer_handler`*/
+    uint32_t canceled;          /**< Images not decoded because their objects were deleted or changed*/
+    uint32_t rejected;          /**< Images decoded while drawn because the queue was full*/
+    uint32_t failed;            /**< Images which couldn't be decoded or cached*/
+    uint16_t queued;            /**< Images waiting to be decoded, including the one being decoded*/
+} lv_img_async_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the background decoding of the images
+ */
+void _lv_img_async_init(void);
+
+/**
+ * Queue an image to be decoded into the image cache in the background.
+ * The object is invalidated when the image is decoded.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param obj the object which draws the image
+ * @return LV_RES_OK: the image is being decoded, draw a placeholder;
+ *         LV_RES_INV: draw the image now (it's cached, can't be queued or couldn't be decoded)
+ */
+lv_res_t _lv_img_async_request(const void * src, lv_color_t color, struct _lv_obj_t * obj);
+
+/**
+ * Forget the image requested by an object. The image isn't decoded if no other object waits for it.
+ * @param obj an object given to `_lv_img_async_request`
+ */
+void _lv_img_async_cancel(struct _lv_obj_t * obj);
+
+/**
+ * Decode the images in another thread instead of the LVGL thread.
+ * Only the decoders marked `thread_safe` can be used by the worker and only if `lv_mem_alloc` is thread safe,
+ * the images of other decoders are decoded in `lv_timer_handler`.
+ * @param submit_cb     function to pass a job to the worker or NULL to decode in `lv_timer_handler`
+ * @param wait_cb       function to wait for a finished job
+ */
+void lv_img_async_set_worker(lv_img_async_submit_cb_t submit_cb, lv_img_async_wait_cb_t wait_cb);
+
+/**
+ * Decode the image of a job. Can be called from any thread, it uses only the memory of the job.
+ * @param job       pointer to a job given to `submit_cb`
+ */
+void lv_img_async_job_run(lv_img_async_job_t * job);
+
+/**
+ * Get the statistics of the background decoding.
+ * @param stats     store the statistics here
+ */
+void lv_img_async_get_stats(lv_img_async_stats_t * stats);
+
+/**
+ * Clear the counters of the background decoding.
+ */
+void lv_img_async_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMG_ASYNC_H*/
@@ -12,36 +12,55 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "../misc/lv_lru.h"
 
 /*********************
  *      DEFINES
  *********************/
-/*Decrement life with this value on every open*/
-#define LV_IMG_CACHE_AGING 1
-
-/*Boost life by this factor (multiply time_to_open with this value)*/
-#define LV_IMG_CACHE_LIFE_GAIN 1
-
-/*Don't let life to be greater than this limit because it would require a lot of time to
- * "die" from very high values*/
-#define LV_IMG_CACHE_LIFE_LIMIT 1000
 
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*The fixed part of the LRU keys. The source's pointer or path follows it*/
+typedef struct {
+    int32_t frame_id;
+    lv_color_t color;
+    uint8_t src_type;
+} cache_key_head_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static lv_res_t entry_open(_lv_img_cache_entry_t * entry, const void * src, lv_color_t color, int32_t frame_id);
 #if LV_IMG_CACHE_DEF_SIZE
+    static void entry_close(_lv_img_cache_entry_t * entry);
+    static _lv_img_cache_entry_t * cache_find(const void * src, lv_color_t color, int32_t frame_id);
+    static _lv_img_cache_entry_t * cache_find_pinned(const void * src, lv_color_t color, int32_t frame_id);
+    static lv_res_t cache_insert(_lv_img_cache_entry_t * entry);
+    static void cache_remove(_lv_img_cache_entry_t * entry);
+    static void cache_clear(bool pinned_too);
+    static void cache_create(void);
+    static void lru_value_free(void * v);
+    static uint8_t * key_create(const void * src, lv_color_t color, int32_t frame_id, size_t * key_len);
+    static uint32_t entry_data_size(const lv_img_decoder_dsc_t * dsc);
+    static void entry_take_pixels(_lv_img_cache_entry_t * entry);
+    static void pixels_free(void * p);
     static bool lv_img_cache_match(const void * src1, const void * src2);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_img_cache_stats_t stats;
 #if LV_IMG_CACHE_DEF_SIZE
     static uint16_t entry_cnt;
+    static uint16_t lru_cnt;
+    static uint16_t pinned_cnt;
+    static uint32_t budget = LV_IMG_CACHE_DEF_BUDGET;
+    static lv_img_cache_alloc_cb_t mem_alloc_cb;
+    static lv_img_cache_free_cb_t mem_free_cb;
+    static bool invalidating;
 #endif
 
 /**********************
@@ -55,89 +74,200 @@
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
- * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * The least recently used images are closed when the new image doesn't fit into the cache.
+ * If the image can't be cached it's opened only until `_lv_img_cache_release` is called.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @return pointer to the cache entry or NULL if can open the image
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id)
 {
-    /*Is the image cached?*/
-    _lv_img_cache_entry_t * cached_src = NULL;
+    _lv_img_cache_entry_t * entry;
 
 #if LV_IMG_CACHE_DEF_SIZE
-    if(entry_cnt == 0) {
-        LV_LOG_WARN("lv_img_cache_open: the cache size is 0");
-        return NULL;
-    }
+    if(LV_GC_ROOT(_lv_img_cache_lru) && lv_img_src_get_type(src) != LV_IMG_SRC_SYMBOL) {
+        /*Is the image cached?*/
+        entry = cache_find(src, color, frame_id);
+        if(entry) {
+            stats.hits++;
+            LV_LOG_TRACE("image source found in the cache");
+            return entry;
+        }
 
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+        entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_cache_ll));
+        LV_ASSERT_MALLOC(entry);
+        if(entry) {
+            lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+            if(entry_open(entry, src, color, frame_id) != LV_RES_OK) {
+                _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+                lv_mem_free(entry);
+                return NULL;
+            }
 
-    /*Decrement all lifes. Make the entries older*/
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(cache[i].life > INT32_MIN + LV_IMG_CACHE_AGING) {
-            cache[i].life -= LV_IMG_CACHE_AGING;
+            if(cache_insert(entry) == LV_RES_OK) {
+                LV_LOG_INFO("image draw: cache miss, image cached");
+                return entry;
+            }
+
+            /*Too large for the cache: keep it open only while it's drawn*/
+            LV_LOG_INFO("image draw: cache miss, the image doesn't fit into the cache");
+            LV_GC_ROOT(_lv_img_cache_single) = *entry;
+            _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+            lv_mem_free(entry);
+            entry = &LV_GC_ROOT(_lv_img_cache_single);
+            entry->transient = 1;
+            return entry;
         }
     }
+#endif
 
-    for(i = 0; i < entry_cnt; i++) {
-        if(color.full == cache[i].dec_dsc.color.full &&
-           frame_id == cache[i].dec_dsc.frame_id &&
-           lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            /*If opened increment its life.
-             *Image difficult to open should live longer to keep avoid frequent their recaching.
-             *Therefore increase `life` with `time_to_open`*/
-            cached_src = &cache[i];
-            cached_src->life += cached_src->dec_dsc.time_to_open * LV_IMG_CACHE_LIFE_GAIN;
-            if(cached_src->life > LV_IMG_CACHE_LIFE_LIMIT) cached_src->life = LV_IMG_CACHE_LIFE_LIMIT;
-            LV_LOG_TRACE("image source found in the cache");
-            break;
-        }
+    entry = &LV_GC_ROOT(_lv_img_cache_single);
+    if(entry_open(entry, src, color, frame_id) != LV_RES_OK) return NULL;
+    entry->transient = 1;
+    return entry;
+}
+
+/**
+ * Release an entry returned by `_lv_img_cache_open` when it's not used anymore.
+ * Closes the image if it wasn't cached.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_release(_lv_img_cache_entry_t * entry)
+{
+    if(entry == NULL || !entry->transient) return;
+
+    lv_img_decoder_close(&entry->dec_dsc);
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+}
+
+/**
+ * Tell if an image is in the cache without opening it.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return true: the image is cached or pinned
+ */
+bool _lv_img_cache_contains(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL || lv_img_src_get_type(src) == LV_IMG_SRC_SYMBOL) return false;
+    return cache_find(src, color, 0) != NULL;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    return false;
+#endif
+}
+
+/**
+ * Tell if the decoded pixels of an image can be kept in the cache.
+ * @param size size of the decoded pixels in bytes
+ * @return true: the cache is enabled and `size` is within its budget
+ */
+bool _lv_img_cache_fits(uint32_t size)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_lru_t * lru = LV_GC_ROOT(_lv_img_cache_lru);
+    return lru && entry_cnt && sizeof(_lv_img_cache_entry_t) + size <= lru->total_memory;
+#else
+    LV_UNUSED(size);
+    return false;
+#endif
+}
+
+/**
+ * Allocate memory for the pixels of an image decoded outside of the cache.
+ * The same memory is used as for the cached pixels, see `lv_img_cache_set_mem_cb`.
+ * @param size size of the decoded pixels in bytes
+ * @param free_cb store the function to free the pixels with here
+ * @return pointer to the allocated memory or NULL if there is no memory
+ */
+uint8_t * _lv_img_cache_alloc_pixels(uint32_t size, lv_img_cache_free_cb_t * free_cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    *free_cb = mem_free_cb ? mem_free_cb : lv_mem_free;
+    return mem_alloc_cb ? mem_alloc_cb(size) : lv_mem_alloc(size);
+#else
+    *free_cb = lv_mem_free;
+    return lv_mem_alloc(size);
+#endif
+}
+
+/**
+ * Add the pixels of an image decoded outside of the cache, e.g. in another thread.
+ * The cache takes the pixels and frees them when the image is closed.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param decoder the decoder which can open the image
+ * @param header the header of the decoded image
+ * @param pixels the decoded pixels allocated with `_lv_img_cache_alloc_pixels`
+ * @param free_cb the function returned by `_lv_img_cache_alloc_pixels`
+ * @return LV_RES_OK: the image is cached; LV_RES_INV: it can't be cached, the pixels are freed
+ */
+lv_res_t _lv_img_cache_add(const void * src, lv_color_t color, lv_img_decoder_t * decoder,
+                           const lv_img_header_t * header, uint8_t * pixels, lv_img_cache_free_cb_t free_cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE
+    /*The memory of the cache was changed since the pixels were allocated*/
+    if(free_cb != (mem_free_cb ? mem_free_cb : lv_mem_free)) {
+        free_cb(pixels);
+        return LV_RES_INV;
     }
 
-    /*The image is not cached then cache it now*/
-    if(cached_src) return cached_src;
+    /*It was opened while it was decoded*/
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL || cache_find(src, color, 0)) {
+        free_cb(pixels);
+        return LV_GC_ROOT(_lv_img_cache_lru) ? LV_RES_OK : LV_RES_INV;
+    }
 
-    /*Find an entry to reuse. Select the entry with the least life*/
-    cached_src = &cache[0];
-    for(i = 1; i < entry_cnt; i++) {
-        if(cache[i].life < cached_src->life) {
-            cached_src = &cache[i];
-        }
+    _lv_img_cache_entry_t * entry = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_cache_ll));
+    LV_ASSERT_MALLOC(entry);
+    if(entry == NULL) {
+        free_cb(pixels);
+        return LV_RES_INV;
     }
+    lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
 
-    /*Close the decoder to reuse if it was opened (has a valid source)*/
-    if(cached_src->dec_dsc.src) {
-        lv_img_decoder_close(&cached_src->dec_dsc);
-        LV_LOG_INFO("image draw: cache miss, close and reuse an entry");
+    lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    dsc->src_type = lv_img_src_get_type(src);
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        char * path = lv_mem_alloc(strlen(src) + 1);
+        LV_ASSERT_MALLOC(path);
+        if(path == NULL) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+            lv_mem_free(entry);
+            free_cb(pixels);
+            return LV_RES_INV;
+        }
+        strcpy(path, src);
+        dsc->src = path;
     }
     else {
-        LV_LOG_INFO("image draw: cache miss, cached to an empty entry");
-    }
-#else
-    cached_src = &LV_GC_ROOT(_lv_img_cache_single);
-#endif
-    /*Open the image and measure the time to open*/
-    uint32_t t_start  = lv_tick_get();
-    lv_res_t open_res = lv_img_decoder_open(&cached_src->dec_dsc, src, color, frame_id);
-    if(open_res == LV_RES_INV) {
-        LV_LOG_WARN("Image draw cannot open the image resource");
-        lv_memset_00(cached_src, sizeof(_lv_img_cache_entry_t));
-        cached_src->life = INT32_MIN; /*Make the empty entry very "weak" to force its us*/
-        return NULL;
+        dsc->src = src;
     }
 
-    cached_src->life = 0;
+    dsc->decoder = decoder;
+    dsc->color = color;
+    dsc->header = *header;
+    dsc->img_data = pixels;
+    dsc->time_to_open = 1;
+    entry->cache_mem = 1;
+    entry->size = sizeof(_lv_img_cache_entry_t) + entry_data_size(dsc);
+    stats.misses++;
 
-    /*If `time_to_open` was not set in the open function set it here*/
-    if(cached_src->dec_dsc.time_to_open == 0) {
-        cached_src->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    if(cache_insert(entry) != LV_RES_OK) {
+        entry_close(entry);
+        return LV_RES_INV;
     }
 
-    if(cached_src->dec_dsc.time_to_open == 0) cached_src->dec_dsc.time_to_open = 1;
-
-    return cached_src;
+    return LV_RES_OK;
+#else
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_UNUSED(decoder);
+    LV_UNUSED(header);
+    free_cb(pixels);
+    return LV_RES_INV;
+#endif
 }
 
 /**
@@ -152,55 +282,425 @@ void lv_img_cache_set_size(uint16_t new_entry_cnt)
     LV_UNUSED(new_entry_cnt);
     LV_LOG_WARN("Can't change cache size because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
 #else
-    if(LV_GC_ROOT(_lv_img_cache_array) != NULL) {
-        /*Clean the cache before free it*/
-        lv_img_cache_invalidate_src(NULL);
-        lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL) {
+        /*First call: initialize the list of all entries*/
+        _lv_ll_init(&LV_GC_ROOT(_lv_img_cache_ll), sizeof(_lv_img_cache_entry_t));
     }
 
-    /*Reallocate the cache*/
-    LV_GC_ROOT(_lv_img_cache_array) = lv_mem_alloc(sizeof(_lv_img_cache_entry_t) * new_entry_cnt);
-    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_array));
-    if(LV_GC_ROOT(_lv_img_cache_array) == NULL) {
-        entry_cnt = 0;
-        return;
-    }
     entry_cnt = new_entry_cnt;
+    cache_create();
+#endif
+}
+
+/**
+ * Set the memory the cached images can use.
+ * The least recently used images are closed to stay within the budget.
+ * Images larger than the budget are not cached.
+ * @param new_budget size in bytes. 0: no limit, only the number of images is limited.
+ */
+void lv_img_cache_set_budget(uint32_t new_budget)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(new_budget);
+    LV_LOG_WARN("Can't change cache budget because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    budget = new_budget;
+    if(LV_GC_ROOT(_lv_img_cache_lru)) cache_create();
+#endif
+}
+
+/**
+ * Set where the decoded pixels of the cached images are stored. E.g. in external RAM.
+ * When set, the pixels of fully decoded images are copied to this memory and the decoder is closed
+ * to free its own buffers. Decoders reading lines decode the cached images directly into it.
+ * @param alloc_cb  function to allocate memory or NULL to keep the pixels in the decoder's buffer
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_img_cache_set_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(alloc_cb);
+    LV_UNUSED(free_cb);
+    LV_LOG_WARN("Can't set the cache memory because it's disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+#else
+    /*The cached pixels need to be freed with the callback they were allocated with*/
+    lv_img_cache_invalidate_src(NULL);
+
+    mem_alloc_cb = free_cb ? alloc_cb : NULL;
+    mem_free_cb = free_cb;
+#endif
+}
+
+/**
+ * Pin an image in the cache so it's never evicted.
+ * The image is opened if it's not cached yet. Pinned images don't count in the budget.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor of the image as it will be drawn
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+    LV_LOG_WARN("Can't pin an image because the cache is disabled by LV_IMG_CACHE_DEF_SIZE = 0");
+    return LV_RES_INV;
+#else
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL || lv_img_src_get_type(src) == LV_IMG_SRC_SYMBOL) {
+        LV_LOG_WARN("lv_img_cache_pin: the image can't be cached");
+        return LV_RES_INV;
+    }
+
+    _lv_img_cache_entry_t * entry = _lv_img_cache_open(src, color, 0);
+    if(entry == NULL) return LV_RES_INV;
+    if(entry->pinned) return LV_RES_OK;
+
+    if(entry->transient) {
+        /*It didn't fit into the budget but the pinned images are not limited*/
+        _lv_img_cache_entry_t * pinned = _lv_ll_ins_head(&LV_GC_ROOT(_lv_img_cache_ll));
+        LV_ASSERT_MALLOC(pinned);
+        if(pinned == NULL) {
+            _lv_img_cache_release(entry);
+            return LV_RES_INV;
+        }
+        *pinned = *entry;
+        lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+        entry = pinned;
+        entry->transient = 0;
+        entry_take_pixels(entry);
+    }
+    else {
+        /*Remove it from the LRU without closing it*/
+        entry->pinned = 1;
+        cache_remove(entry);
+        lru_cnt--;
+    }
+
+    entry->pinned = 1;
+    pinned_cnt++;
+    stats.pinned_size += entry->size;
+    return LV_RES_OK;
+#endif
+}
+
+/**
+ * Let the cache evict a pinned image again.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor used in `lv_img_cache_pin`
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color)
+{
+#if LV_IMG_CACHE_DEF_SIZE == 0
+    LV_UNUSED(src);
+    LV_UNUSED(color);
+#else
+    _lv_img_cache_entry_t * entry = cache_find_pinned(src, color, 0);
+    if(entry == NULL) return;
 
-    /*Clean the cache*/
-    lv_memset_00(LV_GC_ROOT(_lv_img_cache_array), entry_cnt * sizeof(_lv_img_cache_entry_t));
+    entry->pinned = 0;
+    pinned_cnt--;
+    stats.pinned_size -= entry->size;
+
+    if(cache_insert(entry) != LV_RES_OK) entry_close(entry);
 #endif
 }
 
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The pinned images of the source are closed too.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL) return;
 
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
+    invalidating = true;
+    _lv_img_cache_entry_t * entry = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_ll));
+    while(entry) {
+        _lv_img_cache_entry_t * next = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+        if(src == NULL || lv_img_cache_match(src, entry->dec_dsc.src)) {
+            if(entry->pinned) {
+                pinned_cnt--;
+                stats.pinned_size -= entry->size;
+                entry_close(entry);
+            }
+            else {
+                cache_remove(entry);
             }
-
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
         }
+        entry = next;
     }
+    invalidating = false;
 #endif
 }
 
+/**
+ * Get the statistics of the image cache.
+ * @param stats_out store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_lru_t * lru = LV_GC_ROOT(_lv_img_cache_lru);
+    if(lru) stats_out->size = (uint32_t)(lru->total_memory - lru->free_memory);
+    stats_out->entry_cnt = lru_cnt + pinned_cnt;
+#endif
+}
+
+/**
+ * Clear the hit, miss and eviction counters.
+ */
+void lv_img_cache_reset_stats(void)
+{
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+static lv_res_t entry_open(_lv_img_cache_entry_t * entry, const void * src, lv_color_t color, int32_t frame_id)
+{
+    stats.misses++;
+
+    /*Open the image and measure the time to open*/
+    uint32_t t_start  = lv_tick_get();
+    lv_res_t open_res = lv_img_decoder_open(&entry->dec_dsc, src, color, frame_id);
+    if(open_res == LV_RES_INV) {
+        LV_LOG_WARN("Image draw cannot open the image resource");
+        lv_memset_00(entry, sizeof(_lv_img_cache_entry_t));
+        return LV_RES_INV;
+    }
+
+    /*If `time_to_open` was not set in the open function set it here*/
+    if(entry->dec_dsc.time_to_open == 0) {
+        entry->dec_dsc.time_to_open = lv_tick_elaps(t_start);
+    }
+
+    if(entry->dec_dsc.time_to_open == 0) entry->dec_dsc.time_to_open = 1;
+
 #if LV_IMG_CACHE_DEF_SIZE
+    entry->size = sizeof(_lv_img_cache_entry_t) + entry_data_size(&entry->dec_dsc);
+#endif
+
+    return LV_RES_OK;
+}
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+static void entry_close(_lv_img_cache_entry_t * entry)
+{
+    if(entry->cache_mem) {
+        /*The decoder was closed when the pixels were moved*/
+        pixels_free((void *)entry->dec_dsc.img_data);
+        if(entry->dec_dsc.src_type == LV_IMG_SRC_FILE) lv_mem_free((void *)entry->dec_dsc.src);
+    }
+    else {
+        lv_img_decoder_close(&entry->dec_dsc);
+    }
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+    lv_mem_free(entry);
+}
+
+static _lv_img_cache_entry_t * cache_find(const void * src, lv_color_t color, int32_t frame_id)
+{
+    if(pinned_cnt) {
+        _lv_img_cache_entry_t * entry = cache_find_pinned(src, color, frame_id);
+        if(entry) return entry;
+    }
+
+    size_t key_len;
+    uint8_t * key = key_create(src, color, frame_id, &key_len);
+    void * value = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_img_cache_lru), key, key_len, &value);
+    lv_mem_buf_release(key);
+
+    return value;
+}
+
+static _lv_img_cache_entry_t * cache_find_pinned(const void * src, lv_color_t color, int32_t frame_id)
+{
+    if(LV_GC_ROOT(_lv_img_cache_lru) == NULL) return NULL;
+
+    _lv_img_cache_entry_t * entry;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_cache_ll), entry) {
+        if(entry->pinned &&
+           color.full == entry->dec_dsc.color.full &&
+           frame_id == entry->dec_dsc.frame_id &&
+           lv_img_cache_match(src, entry->dec_dsc.src)) {
+            return entry;
+        }
+    }
+
+    return NULL;
+}
+
+/*Add an opened entry to the LRU. Older images are closed to stay within the limits*/
+static lv_res_t cache_insert(_lv_img_cache_entry_t * entry)
+{
+    lv_lru_t * lru = LV_GC_ROOT(_lv_img_cache_lru);
+    if(lru == NULL || entry_cnt == 0 || entry->size > lru->total_memory) return LV_RES_INV;
+
+    while(lru_cnt >= entry_cnt) lv_lru_remove_lru_item(lru);
+
+    entry_take_pixels(entry);
+
+    size_t key_len;
+    uint8_t * key = key_create(entry->dec_dsc.src, entry->dec_dsc.color, entry->dec_dsc.frame_id, &key_len);
+    lv_lru_set(lru, key, key_len, entry, entry->size);
+    lv_mem_buf_release(key);
+    lru_cnt++;
+
+    return LV_RES_OK;
+}
+
+/*Remove an entry from the LRU. `lru_value_free` closes it unless it's pinned*/
+static void cache_remove(_lv_img_cache_entry_t * entry)
+{
+    size_t key_len;
+    uint8_t * key = key_create(entry->dec_dsc.src, entry->dec_dsc.color, entry->dec_dsc.frame_id, &key_len);
+    lv_lru_remove(LV_GC_ROOT(_lv_img_cache_lru), key, key_len);
+    lv_mem_buf_release(key);
+}
+
+static void cache_clear(bool pinned_too)
+{
+    if(pinned_too) {
+        lv_img_cache_invalidate_src(NULL);
+        return;
+    }
+
+    invalidating = true;
+    _lv_img_cache_entry_t * entry = _lv_ll_get_head(&LV_GC_ROOT(_lv_img_cache_ll));
+    while(entry) {
+        _lv_img_cache_entry_t * next = _lv_ll_get_next(&LV_GC_ROOT(_lv_img_cache_ll), entry);
+        if(!entry->pinned) cache_remove(entry);
+        entry = next;
+    }
+    invalidating = false;
+}
+
+/*(Re)create the LRU with the current entry count and budget. The pinned images are kept*/
+static void cache_create(void)
+{
+    if(LV_GC_ROOT(_lv_img_cache_lru)) {
+        cache_clear(false);
+        lv_lru_del(LV_GC_ROOT(_lv_img_cache_lru));
+        LV_GC_ROOT(_lv_img_cache_lru) = NULL;
+    }
+
+    /*Keep a valid LRU even with 0 entries to find the pinned images*/
+    size_t total = budget ? budget : SIZE_MAX;
+    size_t avg_len = total / LV_MAX(entry_cnt, 1);
+    if(avg_len == 0) avg_len = 1;
+
+    LV_GC_ROOT(_lv_img_cache_lru) = lv_lru_create(total, avg_len, lru_value_free, NULL);
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_img_cache_lru));
+}
+
+/*Called by the LRU when an entry is evicted or removed*/
+static void lru_value_free(void * v)
+{
+    _lv_img_cache_entry_t * entry = v;
+
+    /*It's moved to the pinned images, keep it open*/
+    if(entry->pinned) return;
+
+    if(!invalidating) {
+        stats.evictions++;
+        LV_LOG_INFO("image cache: close the least recently used image");
+    }
+
+    lru_cnt--;
+    entry_close(entry);
+}
+
+/*Create a key from the source and the parameters. Free it with `lv_mem_buf_release`*/
+static uint8_t * key_create(const void * src, lv_color_t color, int32_t frame_id, size_t * key_len)
+{
+    cache_key_head_t head;
+    lv_memset_00(&head, sizeof(head));
+    head.frame_id = frame_id;
+    head.color = color;
+    head.src_type = lv_img_src_get_type(src);
+
+    size_t src_len = head.src_type == LV_IMG_SRC_VARIABLE ? sizeof(src) : strlen(src);
+    *key_len = sizeof(head) + src_len;
+
+    uint8_t * key = lv_mem_buf_get(*key_len);
+    lv_memcpy(key, &head, sizeof(head));
+    if(head.src_type == LV_IMG_SRC_VARIABLE) lv_memcpy(key + sizeof(head), &src, src_len);
+    else lv_memcpy(key + sizeof(head), src, src_len);
+
+    return key;
+}
+
+/*Estimate the memory held by an opened image*/
+static uint32_t entry_data_size(const lv_img_decoder_dsc_t * dsc)
+{
+    /*The built-in decoder uses the pixels in place*/
+    if(dsc->decoder && dsc->decoder->open_cb == lv_img_decoder_built_in_open) return 0;
+
+    /*Decoders reading line-by-line usually keep a similar amount of decoded data*/
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    if(size == 0) size = (uint32_t)dsc->header.w * dsc->header.h * LV_IMG_PX_SIZE_ALPHA_BYTE;
+
+    return size;
+}
+
+/*Give the pixels of an entry to the cache and close the decoder.
+ *Decoders reading lines decode the whole image into the cache's memory if they can,
+ *the pixels of the others are moved to the memory of `lv_img_cache_set_mem_cb`.*/
+static void entry_take_pixels(_lv_img_cache_entry_t * entry)
+{
+    lv_img_decoder_dsc_t * dsc = &entry->dec_dsc;
+    if(entry->cache_mem) return;
+    if(dsc->decoder->open_cb == lv_img_decoder_built_in_open) return;
+
+    bool decode = dsc->img_data == NULL && dsc->decoder->decode_cb;
+    if(!decode && (mem_alloc_cb == NULL || dsc->img_data == NULL)) return;
+
+    uint32_t size = lv_img_buf_get_img_size(dsc->header.w, dsc->header.h, dsc->header.cf);
+    if(size == 0) return;
+
+    uint8_t * pixels = mem_alloc_cb ? mem_alloc_cb(size) : lv_mem_alloc(size);
+    if(pixels == NULL) {
+        LV_LOG_WARN("image cache: couldn't allocate %" LV_PRIu32 " bytes, the decoder's buffer is kept", size);
+        return;
+    }
+
+    if(decode) {
+        if(lv_img_decoder_decode(dsc, pixels) != LV_RES_OK) {
+            LV_LOG_WARN("image cache: couldn't decode the whole image, it will be read line-by-line");
+            pixels_free(pixels);
+            return;
+        }
+    }
+    else {
+        lv_memcpy(pixels, dsc->img_data, size);
+    }
+
+    /*Close only the decoder, the path of the file is still used as the source*/
+    if(dsc->decoder->close_cb) dsc->decoder->close_cb(dsc->decoder, dsc);
+    dsc->img_data = pixels;
+    dsc->user_data = NULL;
+    entry->cache_mem = 1;
+}
+
+static void pixels_free(void * p)
+{
+    /*The cache is cleared when the callbacks change, so they are the ones the pixels were allocated with*/
+    if(mem_free_cb) mem_free_cb(p);
+    else lv_mem_free(p);
+}
+
 static bool lv_img_cache_match(const void * src1, const void * src2)
 {
     lv_img_src_t src_type = lv_img_src_get_type(src1);
@@ -212,4 +712,5 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
-#endif
+
+#endif /*LV_IMG_CACHE_DEF_SIZE*/
@@ -31,12 +31,33 @@ extern "C" {
 typedef struct {
     lv_img_decoder_dsc_t dec_dsc; /**< Image information*/
 
-    /** Count the cache entries's life. Add `time_to_open` to `life` when the entry is used.
-     * Decrement all lifes by one every in every ::lv_img_cache_open.
-     * If life == 0 the entry can be reused*/
-    int32_t life;
+    /** Number of bytes the entry is counted with in the cache's budget*/
+    uint32_t size;
+
+    /** 1: the decoded pixels are in the memory of the cache (given in `lv_img_cache_set_mem_cb`
+     * or allocated with `lv_mem_alloc`) and the decoder is already closed*/
+    uint8_t cache_mem : 1;
+
+    /** 1: the entry is pinned and is never evicted*/
+    uint8_t pinned : 1;
+
+    /** 1: the entry is not in the cache and will be closed by `_lv_img_cache_release`*/
+    uint8_t transient : 1;
 } _lv_img_cache_entry_t;
 
+/** Statistics of the image cache*/
+typedef struct {
+    uint32_t hits;          /**< Number of opens served from the cache*/
+    uint32_t misses;        /**< Number of opens which needed to decode the image*/
+    uint32_t evictions;     /**< Number of entries closed to make space for new ones*/
+    uint32_t size;          /**< Bytes used by the evictable entries*/
+    uint32_t pinned_size;   /**< Bytes used by the pinned entries*/
+    uint16_t entry_cnt;     /**< Number of cached images, including the pinned ones*/
+} lv_img_cache_stats_t;
+
+typedef void * (*lv_img_cache_alloc_cb_t)(size_t size);
+typedef void (*lv_img_cache_free_cb_t)(void * p);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -44,7 +65,8 @@ typedef struct {
 /**
  * Open an image using the image decoder interface and cache it.
  * The image will be left open meaning if the image decoder open callback allocated memory then it will remain.
- * The image is closed if a new image is opened and the new image takes its place in the cache.
+ * The least recently used images are closed when the new image doesn't fit into the cache.
+ * If the image can't be cached it's opened only until `_lv_img_cache_release` is called.
  * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
  * @param color The color of the image with `LV_IMG_CF_ALPHA_...`
  * @param frame_id the index of the frame. Used only with animated images, set 0 for normal images
@@ -52,6 +74,51 @@ typedef struct {
  */
 _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, int32_t frame_id);
 
+/**
+ * Release an entry returned by `_lv_img_cache_open` when it's not used anymore.
+ * Closes the image if it wasn't cached.
+ * @param entry pointer to a cache entry
+ */
+void _lv_img_cache_release(_lv_img_cache_entry_t * entry);
+
+/**
+ * Tell if an image is in the cache without opening it.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @return true: the image is cached or pinned
+ */
+bool _lv_img_cache_contains(const void * src, lv_color_t color);
+
+/**
+ * Tell if the decoded pixels of an image can be kept in the cache.
+ * @param size size of the decoded pixels in bytes
+ * @return true: the cache is enabled and `size` is within its budget
+ */
+bool _lv_img_cache_fits(uint32_t size);
+
+/**
+ * Allocate memory for the pixels of an image decoded outside of the cache.
+ * The same memory is used as for the cached pixels, see `lv_img_cache_set_mem_cb`.
+ * @param size size of the decoded pixels in bytes
+ * @param free_cb store the function to free the pixels with here
+ * @return pointer to the allocated memory or NULL if there is no memory
+ */
+uint8_t * _lv_img_cache_alloc_pixels(uint32_t size, lv_img_cache_free_cb_t * free_cb);
+
+/**
+ * Add the pixels of an image decoded outside of the cache, e.g. in another thread.
+ * The cache takes the pixels and frees them when the image is closed.
+ * @param src source of the image. Path to file or pointer to an `lv_img_dsc_t` variable
+ * @param color the color of the image with `LV_IMG_CF_ALPHA_...`
+ * @param decoder the decoder which can open the image
+ * @param header the header of the decoded image
+ * @param pixels the decoded pixels allocated with `_lv_img_cache_alloc_pixels`
+ * @param free_cb the function returned by `_lv_img_cache_alloc_pixels`
+ * @return LV_RES_OK: the image is cached; LV_RES_INV: it can't be cached, the pixels are freed
+ */
+lv_res_t _lv_img_cache_add(const void * src, lv_color_t color, lv_img_decoder_t * decoder,
+                           const lv_img_header_t * header, uint8_t * pixels, lv_img_cache_free_cb_t free_cb);
+
 /**
  * Set the number of images to be cached.
  * More cached images mean more opened image at same time which might mean more memory usage.
@@ -60,13 +127,58 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
  */
 void lv_img_cache_set_size(uint16_t new_slot_num);
 
+/**
+ * Set the memory the cached images can use.
+ * The least recently used images are closed to stay within the budget.
+ * Images larger than the budget are not cached.
+ * @param budget size in bytes. 0: no limit, only the number of images is limited.
+ */
+void lv_img_cache_set_budget(uint32_t budget);
+
+/**
+ * Set where the decoded pixels of the cached images are stored. E.g. in external RAM.
+ * When set, the pixels of fully decoded images are copied to this memory and the decoder is closed
+ * to free its own buffers. Decoders reading lines decode the cached images directly into it.
+ * @param alloc_cb  function to allocate memory or NULL to keep the pixels in the decoder's buffer
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_img_cache_set_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb);
+
+/**
+ * Pin an image in the cache so it's never evicted.
+ * The image is opened if it's not cached yet. Pinned images don't count in the budget.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor of the image as it will be drawn
+ * @return LV_RES_OK: the image is pinned; LV_RES_INV: the image can't be opened
+ */
+lv_res_t lv_img_cache_pin(const void * src, lv_color_t color);
+
+/**
+ * Let the cache evict a pinned image again.
+ * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
+ * @param color the recolor used in `lv_img_cache_pin`
+ */
+void lv_img_cache_unpin(const void * src, lv_color_t color);
+
 /**
  * Invalidate an image source in the cache.
  * Useful if the image source is updated therefore it needs to be cached again.
+ * The pinned images of the source are closed too.
  * @param src an image source path to a file or pointer to an `lv_img_dsc_t` variable.
  */
 void lv_img_cache_invalidate_src(const void * src);
 
+/**
+ * Get the statistics of the image cache.
+ * @param stats store the statistics here
+ */
+void lv_img_cache_get_stats(lv_img_cache_stats_t * stats);
+
+/**
+ * Clear the hit, miss and eviction counters.
+ */
+void lv_img_cache_reset_stats(void);
+
 /**********************
  *      MACROS
  **********************/
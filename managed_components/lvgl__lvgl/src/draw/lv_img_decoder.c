@@ -181,6 +181,21 @@ lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_c
     return res;
 }
 
+/**
+ * Decode the whole image of an opened decoding session into a buffer.
+ * Can be used if `dsc->img_data` is NULL after opening.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param buf a buffer of `lv_img_buf_get_img_size(w, h, cf)` bytes to store the pixels
+ * @return LV_RES_OK: success; LV_RES_INV: the decoder can't decode the whole image or an error occurred
+ */
+lv_res_t lv_img_decoder_decode(lv_img_decoder_dsc_t * dsc, uint8_t * buf)
+{
+    lv_res_t res = LV_RES_INV;
+    if(dsc->decoder->decode_cb) res = dsc->decoder->decode_cb(dsc->decoder, dsc, buf);
+
+    return res;
+}
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -263,6 +278,16 @@ void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_clos
     decoder->close_cb = close_cb;
 }
 
+/**
+ * Set a callback to decode the whole image into a buffer given by the caller
+ * @param decoder pointer to an image decoder
+ * @param decode_cb a function to decode the whole image
+ */
+void lv_img_decoder_set_decode_cb(lv_img_decoder_t * decoder, lv_img_decoder_decode_f_t decode_cb)
+{
+    decoder->decode_cb = decode_cb;
+}
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
@@ -75,6 +75,18 @@ typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder_t * decoder,
 typedef lv_res_t (*lv_img_decoder_read_line_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
                                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
 
+/**
+ * Decode the whole image into a buffer given by the caller.
+ * Optional, for decoders whose "open" function doesn't return the whole decoded pixel array.
+ * Used e.g. by the image cache to decode directly into the memory of the cached pixels.
+ * @param decoder pointer to the decoder the function associated with
+ * @param dsc pointer to decoder descriptor
+ * @param buf a buffer of `lv_img_buf_get_img_size(w, h, cf)` bytes to store the decoded pixels
+ * @return LV_RES_OK: ok; LV_RES_INV: failed
+ */
+typedef lv_res_t (*lv_img_decoder_decode_f_t)(struct _lv_img_decoder_t * decoder, struct _lv_img_decoder_dsc_t * dsc,
+                                              uint8_t * buf);
+
 /**
  * Close the pending decoding. Free resources etc.
  * @param decoder pointer to the decoder the function associated with
@@ -87,6 +99,11 @@ typedef struct _lv_img_decoder_t {
     lv_img_decoder_open_f_t open_cb;
     lv_img_decoder_read_line_f_t read_line_cb;
     lv_img_decoder_close_f_t close_cb;
+    lv_img_decoder_decode_f_t decode_cb;
+
+    /** 1: `open_cb`, `decode_cb` and `close_cb` can run in another thread for an `lv_img_dsc_t` source
+     *  if `lv_mem_alloc` is thread safe. Used by `lv_img_async` to decode in a worker thread.*/
+    uint8_t thread_safe : 1;
 
 #if LV_USE_USER_DATA
     void * user_data;
@@ -177,6 +194,15 @@ lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t * dsc, const void * src, lv_co
 lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t * dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len,
                                   uint8_t * buf);
 
+/**
+ * Decode the whole image of an opened decoding session into a buffer.
+ * Can be used if `dsc->img_data` is NULL after opening.
+ * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
+ * @param buf a buffer of `lv_img_buf_get_img_size(w, h, cf)` bytes to store the pixels
+ * @return LV_RES_OK: success; LV_RES_INV: the decoder can't decode the whole image or an error occurred
+ */
+lv_res_t lv_img_decoder_decode(lv_img_decoder_dsc_t * dsc, uint8_t * buf);
+
 /**
  * Close a decoding session
  * @param dsc pointer to `lv_img_decoder_dsc_t` used in `lv_img_decoder_open`
@@ -223,6 +249,13 @@ void lv_img_decoder_set_read_line_cb(lv_img_decoder_t * decoder, lv_img_decoder_
  */
 void lv_img_decoder_set_close_cb(lv_img_decoder_t * decoder, lv_img_decoder_close_f_t close_cb);
 
+/**
+ * Set a callback to decode the whole image into a buffer given by the caller
+ * @param decoder pointer to an image decoder
+ * @param decode_cb a function to decode the whole image
+ */
+void lv_img_decoder_set_decode_cb(lv_img_decoder_t * decoder, lv_img_decoder_decode_f_t decode_cb);
+
 /**
  * Get info about a built-in image
  * @param decoder the decoder where this function belongs
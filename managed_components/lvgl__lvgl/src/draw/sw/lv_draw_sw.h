@@ -14,6 +14,8 @@ extern "C" {
  *      INCLUDES
  *********************/
 #include "lv_draw_sw_blend.h"
+#include "lv_draw_sw_blend_kernels.h"
+#include "lv_draw_sw_bands.h"
 #include "../lv_draw.h"
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_color.h"
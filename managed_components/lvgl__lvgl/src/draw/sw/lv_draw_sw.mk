@@ -1,6 +1,8 @@
 CSRCS += lv_draw_sw.c
 CSRCS += lv_draw_sw_arc.c
+CSRCS += lv_draw_sw_bands.c
 CSRCS += lv_draw_sw_blend.c
+CSRCS += lv_draw_sw_blend_kernels.c
 CSRCS += lv_draw_sw_dither.c
 CSRCS += lv_draw_sw_gradient.c
 CSRCS += lv_draw_sw_img.c
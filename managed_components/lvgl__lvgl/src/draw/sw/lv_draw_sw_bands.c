@@ -0,0 +1,192 @@
+/**
+ * @file lv_draw_sw_bands.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw.h"
+#include "../../core/lv_refr.h"
+#include "../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_DRAW_SW_BANDS > 1
+    #define BAND_CNT_MAX LV_DRAW_SW_BANDS
+#else
+    #define BAND_CNT_MAX 1
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    lv_draw_sw_bands_job_t job;     /*Keep it first, the job is the band for the worker*/
+    lv_draw_sw_ctx_t ctx;
+    lv_area_t clip_area;
+    lv_draw_sw_bands_cb_t cb;
+    void * scratch;
+    void * user_data;
+    bool submitted;
+} band_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void band_init(band_t * band, lv_draw_ctx_t * draw_ctx, const lv_area_t * clip_area,
+                      lv_draw_sw_bands_cb_t cb, void * user_data);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static band_t bands[BAND_CNT_MAX];
+static bool drawing;
+static lv_draw_sw_bands_submit_cb_t worker_submit_cb;
+static lv_draw_sw_bands_wait_cb_t worker_wait_cb;
+static lv_draw_sw_bands_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_bands_draw(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, uint32_t min_px, uint32_t scratch_size,
+                           lv_draw_sw_bands_cb_t cb, void * user_data)
+{
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, area, draw_ctx->clip_area)) return;
+
+    /*A band drawing again (e.g. blending its image) draws at once. It has no scratch memory to give.*/
+    if(drawing) {
+        LV_ASSERT_MSG(scratch_size == 0, "Can't allocate scratch memory in a band");
+        const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+        draw_ctx->clip_area = &draw_area;
+        cb(draw_ctx, NULL, user_data);
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+
+    lv_coord_t h = lv_area_get_height(&draw_area);
+    uint32_t band_cnt = BAND_CNT_MAX;
+    if(worker_submit_cb == NULL || lv_area_get_size(&draw_area) < min_px ||
+       !lv_draw_sw_bands_allowed(draw_ctx)) {
+        band_cnt = 1;
+    }
+    if(band_cnt > (uint32_t)h) band_cnt = h;
+
+    lv_coord_t band_h = (h + band_cnt - 1) / band_cnt;
+    uint32_t i;
+    for(i = 0; i < band_cnt; i++) {
+        lv_area_t clip_area = draw_area;
+        clip_area.y1 = draw_area.y1 + i * band_h;
+        clip_area.y2 = LV_MIN(clip_area.y1 + band_h - 1, draw_area.y2);
+        if(clip_area.y1 > draw_area.y2) {
+            band_cnt = i;
+            break;
+        }
+        band_init(&bands[i], draw_ctx, &clip_area, cb, user_data);
+        bands[i].scratch = scratch_size ? lv_mem_buf_get(scratch_size) : NULL;
+    }
+
+    drawing = true;
+    if(band_cnt > 1) stats.split++;
+
+    /*Give the other bands to the workers and draw the first one meanwhile*/
+    for(i = 1; i < band_cnt; i++) {
+        bands[i].submitted = worker_submit_cb(&bands[i].job);
+        if(bands[i].submitted) stats.worker_bands++;
+        else stats.rejected++;
+    }
+
+    lv_draw_sw_bands_job_run(&bands[0].job);
+
+    for(i = 1; i < band_cnt; i++) {
+        if(!bands[i].submitted) lv_draw_sw_bands_job_run(&bands[i].job);
+    }
+
+    for(i = 1; i < band_cnt; i++) {
+        if(bands[i].submitted) {
+            if(worker_wait_cb) worker_wait_cb(&bands[i].job);
+            while(!bands[i].job.done) {}
+        }
+    }
+
+    drawing = false;
+
+    /*Release in reverse order to give back the buffers the way they were taken*/
+    for(i = band_cnt; i > 0; i--) {
+        if(bands[i - 1].scratch) lv_mem_buf_release(bands[i - 1].scratch);
+        bands[i - 1].scratch = NULL;
+    }
+}
+
+bool lv_draw_sw_bands_allowed(const lv_draw_ctx_t * draw_ctx)
+{
+    const lv_draw_sw_ctx_t * sw_ctx = (const lv_draw_sw_ctx_t *)draw_ctx;
+    if(sw_ctx->blend != lv_draw_sw_blend_basic) return false;
+    if(draw_ctx->wait_for_finish != lv_draw_sw_wait_for_finish) return false;
+#if LV_DRAW_COMPLEX
+    if(draw_ctx->draw_transform != lv_draw_sw_transform) return false;
+#endif
+
+    /*`set_px_cb` is the user's code and the ARGB blending caches its last color*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp == NULL) return false;
+    if(disp->driver->set_px_cb) return false;
+    if(disp->driver->screen_transp) return false;
+
+    return true;
+}
+
+void lv_draw_sw_bands_set_worker(lv_draw_sw_bands_submit_cb_t submit_cb, lv_draw_sw_bands_wait_cb_t wait_cb)
+{
+#if LV_DRAW_SW_BANDS < 2
+    LV_UNUSED(submit_cb);
+    LV_UNUSED(wait_cb);
+    LV_LOG_WARN("Can't set the worker because the band drawing is disabled by LV_DRAW_SW_BANDS < 2");
+#else
+    /*No band is in progress as the bands are waited for before returning to the caller*/
+    worker_submit_cb = submit_cb;
+    worker_wait_cb = wait_cb;
+#endif
+}
+
+void lv_draw_sw_bands_job_run(lv_draw_sw_bands_job_t * job)
+{
+    band_t * band = (band_t *)job;
+    band->cb(&band->ctx.base_draw, band->scratch, band->user_data);
+    job->done = true;
+}
+
+void lv_draw_sw_bands_get_stats(lv_draw_sw_bands_stats_t * stats_out)
+{
+    *stats_out = stats;
+}
+
+void lv_draw_sw_bands_reset_stats(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void band_init(band_t * band, lv_draw_ctx_t * draw_ctx, const lv_area_t * clip_area,
+                      lv_draw_sw_bands_cb_t cb, void * user_data)
+{
+    band->job.user_data = NULL;
+    band->job.done = false;
+    band->ctx = *(lv_draw_sw_ctx_t *)draw_ctx;
+    band->clip_area = *clip_area;
+    band->ctx.base_draw.clip_area = &band->clip_area;
+    band->cb = cb;
+    band->user_data = user_data;
+    band->submitted = false;
+}
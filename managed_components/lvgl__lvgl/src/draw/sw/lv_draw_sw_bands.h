@@ -0,0 +1,122 @@
+/**
+ * @file lv_draw_sw_bands.h
+ *
+ * Split the pixel work of a drawing into horizontal bands and draw them in parallel.
+ * The LVGL thread draws the first band while workers draw the others, then it waits for all of them.
+ * A band only writes its own rows of the draw buffer and uses only its own scratch memory,
+ * so the result is the same as drawing the area at once.
+ */
+
+#ifndef LV_DRAW_SW_BANDS_H
+#define LV_DRAW_SW_BANDS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** A band to draw by a worker. See `lv_draw_sw_bands_set_worker`*/
+typedef struct {
+    void * user_data;       /**< Free to use by the worker. NULL when the job is submitted*/
+    volatile bool done;     /**< Set by `lv_draw_sw_bands_job_run` when the band is drawn*/
+} lv_draw_sw_bands_job_t;
+
+/**
+ * Pass a job to a worker thread which calls `lv_draw_sw_bands_job_run(job)`. Called from the LVGL thread.
+ * Return false if the job can't be taken now, the LVGL thread draws the band then.
+ */
+typedef bool (*lv_draw_sw_bands_submit_cb_t)(lv_draw_sw_bands_job_t * job);
+
+/**
+ * Wait until the worker has finished a submitted job. Called from the LVGL thread for every submitted job.
+ * The pixels written by the worker need to be visible when it returns,
+ * e.g. wait for a semaphore given by the worker after `lv_draw_sw_bands_job_run`.
+ */
+typedef void (*lv_draw_sw_bands_wait_cb_t)(lv_draw_sw_bands_job_t * job);
+
+/**
+ * Draw the part of a drawing in `draw_ctx->clip_area`. Can run in any thread:
+ * it must not add or remove masks, allocate memory or draw with other `draw_ctx` functions than `blend`.
+ * @param draw_ctx      a copy of the draw context with the band as clip area
+ * @param scratch       memory of the band, `scratch_size` bytes given to `lv_draw_sw_bands_draw`
+ * @param user_data     the `user_data` given to `lv_draw_sw_bands_draw`
+ */
+typedef void (*lv_draw_sw_bands_cb_t)(lv_draw_ctx_t * draw_ctx, void * scratch, void * user_data);
+
+/** Statistics of the band drawing*/
+typedef struct {
+    uint32_t split;             /**< Drawings split into bands*/
+    uint32_t worker_bands;      /**< Bands drawn by the workers*/
+    uint32_t rejected;          /**< Bands drawn by the LVGL thread because the worker didn't take them*/
+} lv_draw_sw_bands_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Draw an area in at most `LV_DRAW_SW_BANDS` bands of rows.
+ * Without workers, for small areas and when called from a band the area is drawn at once by `cb`.
+ * @param draw_ctx      pointer to a software draw context
+ * @param area          the area to draw with absolute coordinates, clipped to `draw_ctx->clip_area`
+ * @param min_px        don't split areas smaller than this
+ * @param scratch_size  size of the memory needed by a band
+ * @param cb            function to draw a band
+ * @param user_data     passed to `cb`
+ */
+void lv_draw_sw_bands_draw(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, uint32_t min_px, uint32_t scratch_size,
+                           lv_draw_sw_bands_cb_t cb, void * user_data);
+
+/**
+ * Tell whether the software renderer can split its drawings on a draw context.
+ * The blending, the transformation and the display's buffer format have to be the thread safe software ones.
+ * @param draw_ctx      pointer to a draw context
+ * @return              true: the bands can be drawn by workers
+ */
+bool lv_draw_sw_bands_allowed(const lv_draw_ctx_t * draw_ctx);
+
+/**
+ * Draw the bands in other threads too. The blending and image drawing of large areas is shared with the workers.
+ * @param submit_cb     function to pass a job to a worker or NULL to draw everything in the LVGL thread
+ * @param wait_cb       function to wait for a finished job
+ */
+void lv_draw_sw_bands_set_worker(lv_draw_sw_bands_submit_cb_t submit_cb, lv_draw_sw_bands_wait_cb_t wait_cb);
+
+/**
+ * Draw the band of a job. Can be called from any thread.
+ * @param job       pointer to a job given to `submit_cb`
+ */
+void lv_draw_sw_bands_job_run(lv_draw_sw_bands_job_t * job);
+
+/**
+ * Get the statistics of the band drawing.
+ * @param stats     store the statistics here
+ */
+void lv_draw_sw_bands_get_stats(lv_draw_sw_bands_stats_t * stats);
+
+/**
+ * Clear the counters of the band drawing.
+ */
+void lv_draw_sw_bands_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BANDS_H*/
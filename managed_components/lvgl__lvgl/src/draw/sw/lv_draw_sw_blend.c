@@ -14,6 +14,8 @@
 /*********************
  *      DEFINES
  *********************/
+/*Smaller areas are blended at once, handing them to a worker would take longer*/
+#define BLEND_BANDS_MIN_PX   (8 * 1024)
 
 /**********************
  *      TYPEDEFS
@@ -23,6 +25,8 @@
  *  STATIC PROTOTYPES
  **********************/
 
+static void blend_band_cb(lv_draw_ctx_t * draw_ctx, void * scratch, void * user_data);
+
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide);
 
@@ -45,6 +49,14 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
                        const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
                        const lv_opa_t * mask, lv_coord_t mask_stride);
 
+static void fill_rotated(lv_color_t * dest_buf, const lv_area_t * dest_area, int32_t dest_px_step,
+                         int32_t dest_line_step, lv_color_t color, lv_opa_t opa,
+                         const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
+
+static void map_rotated(lv_color_t * dest_buf, const lv_area_t * dest_area, int32_t dest_px_step,
+                        int32_t dest_line_step, const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                        const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode);
+
 static void /* LV_ATTRIBUTE_FAST_MEM */ map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                                    lv_coord_t dest_stride, const lv_color_t * src_buf,
                                                    lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
@@ -75,18 +87,6 @@ static inline lv_color_t color_blend_true_color_multiply(lv_color_t fg, lv_color
 /**********************
  *      MACROS
  **********************/
-#define FILL_NORMAL_MASK_PX(color)                                                          \
-    if(*mask == LV_OPA_COVER) *dest_buf = color;                                 \
-    else *dest_buf = lv_color_mix(color, *dest_buf, *mask);            \
-    mask++;                                                         \
-    dest_buf++;
-
-#define MAP_NORMAL_MASK_PX(x)                                                          \
-    if(*mask_tmp_x) {          \
-        if(*mask_tmp_x == LV_OPA_COVER) dest_buf[x] = src_buf[x];                                 \
-        else dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], *mask_tmp_x);            \
-    }                                                                                               \
-    mask_tmp_x++;
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -102,7 +102,12 @@ void lv_draw_sw_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * d
 
     if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
 
-    ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    if(LV_DRAW_SW_BANDS > 1 && lv_area_get_size(&blend_area) >= BLEND_BANDS_MIN_PX) {
+        lv_draw_sw_bands_draw(draw_ctx, &blend_area, BLEND_BANDS_MIN_PX, 0, blend_band_cb, (void *)dsc);
+    }
+    else {
+        ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, dsc);
+    }
 }
 
 void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
@@ -121,7 +126,16 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
 
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
     lv_color_t * dest_buf = draw_ctx->buf;
-    if(disp->driver->set_px_cb == NULL) {
+
+    /*With `render_rotated` the buffer is in the display's native orientation.
+     *Address it with a pixel and a line step instead of the row stride*/
+    bool rotated = _lv_draw_sw_is_buf_rotated(disp->driver);
+    int32_t dest_px_step = 1;
+    int32_t dest_line_step = dest_stride;
+    if(rotated) {
+        dest_buf = lv_draw_sw_get_buf_px(draw_ctx, blend_area.x1, blend_area.y1, &dest_px_step, &dest_line_step);
+    }
+    else if(disp->driver->set_px_cb == NULL) {
         if(disp->driver->screen_transp == 0) {
             dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
         }
@@ -146,18 +160,23 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
 
     lv_coord_t mask_stride;
     if(mask) {
-        /*Round the values in the mask if anti-aliasing is disabled*/
+        mask_stride = lv_area_get_width(dsc->mask_area);
+        mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
+
+        /*Round the values in the mask if anti-aliasing is disabled.
+         *Only the blended part as the other bands of the area might use the rest of the mask*/
         if(disp->driver->antialiasing == 0) {
-            int32_t mask_size = lv_area_get_size(dsc->mask_area);
+            int32_t blend_w = lv_area_get_width(&blend_area);
+            lv_opa_t * mask_tmp = mask;
+            lv_coord_t y;
             int32_t i;
-            for(i = 0; i < mask_size; i++) {
-                mask[i] = mask[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+            for(y = blend_area.y1; y <= blend_area.y2; y++) {
+                for(i = 0; i < blend_w; i++) {
+                    mask_tmp[i] = mask_tmp[i] > 128 ? LV_OPA_COVER : LV_OPA_TRANSP;
+                }
+                mask_tmp += mask_stride;
             }
         }
-
-        mask_stride = lv_area_get_width(dsc->mask_area);
-        mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
-
     }
     else {
         mask_stride = 0;
@@ -165,7 +184,17 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
 
     lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
 
-    if(disp->driver->set_px_cb) {
+    if(rotated) {
+        if(dsc->src_buf == NULL) {
+            fill_rotated(dest_buf, &blend_area, dest_px_step, dest_line_step, dsc->color, dsc->opa, mask, mask_stride,
+                         dsc->blend_mode);
+        }
+        else {
+            map_rotated(dest_buf, &blend_area, dest_px_step, dest_line_step, src_buf, src_stride, dsc->opa, mask, mask_stride,
+                        dsc->blend_mode);
+        }
+    }
+    else if(disp->driver->set_px_cb) {
         if(dsc->src_buf == NULL) {
             fill_set_px(dest_buf, &blend_area, dest_stride, dsc->color, dsc->opa, mask, mask_stride);
         }
@@ -203,10 +232,50 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx,
     }
 }
 
+lv_color_t * lv_draw_sw_get_buf_px(struct _lv_draw_ctx_t * draw_ctx, lv_coord_t x, lv_coord_t y,
+                                   int32_t * px_step, int32_t * line_step)
+{
+    lv_color_t * buf = draw_ctx->buf;
+    int32_t buf_w = lv_area_get_width(draw_ctx->buf_area);
+    int32_t buf_h = lv_area_get_height(draw_ctx->buf_area);
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    lv_disp_rot_t rot = _lv_draw_sw_is_buf_rotated(disp->driver) ? disp->driver->rotated : LV_DISP_ROT_NONE;
+    switch(rot) {
+        case LV_DISP_ROT_90:
+            buf += (buf_w - 1) * buf_h;
+            *px_step = -buf_h;
+            *line_step = 1;
+            break;
+        case LV_DISP_ROT_180:
+            buf += buf_w * buf_h - 1;
+            *px_step = -1;
+            *line_step = -buf_w;
+            break;
+        case LV_DISP_ROT_270:
+            buf += buf_h - 1;
+            *px_step = buf_h;
+            *line_step = -1;
+            break;
+        default:
+            *px_step = 1;
+            *line_step = buf_w;
+            break;
+    }
+
+    return buf + *px_step * (x - draw_ctx->buf_area->x1) + *line_step * (y - draw_ctx->buf_area->y1);
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+static void blend_band_cb(lv_draw_ctx_t * draw_ctx, void * scratch, void * user_data)
+{
+    LV_UNUSED(scratch);
+    ((lv_draw_sw_ctx_t *)draw_ctx)->blend(draw_ctx, user_data);
+}
+
 static void fill_set_px(lv_color_t * dest_buf, const lv_area_t * blend_area, lv_coord_t dest_stride,
                         lv_color_t color, lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stide)
 {
@@ -246,8 +315,8 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
-    int32_t x;
     int32_t y;
+    const lv_draw_sw_blend_kernels_t * k = lv_draw_sw_blend_get_kernels();
 
     /*No mask*/
     if(mask == NULL) {
@@ -259,116 +328,28 @@ static LV_ATTRIBUTE_FAST_MEM void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
-            lv_color_t last_dest_color = lv_color_black();
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
-
-#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
-            /*lv_color_mix work with an optimized algorithm with 16 bit color depth.
-             *However, it introduces some rounded error on opa.
-             *Introduce the same error here too to make lv_color_premult produces the same result */
-            opa = (uint32_t)((uint32_t)opa + 4) >> 3;
-            opa = opa << 3;
-#endif
-
-            uint16_t color_premult[3];
-            lv_color_premult(color, opa, color_premult);
-            lv_opa_t opa_inv = 255 - opa;
-
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(last_dest_color.full != dest_buf[x].full) {
-                        last_dest_color = dest_buf[x];
-                        last_res_color = lv_color_mix_premult(color_premult, dest_buf[x], opa_inv);
-                    }
-                    dest_buf[x] = last_res_color;
-                }
+                k->fill_opa(dest_buf, w, color, opa);
                 dest_buf += dest_stride;
             }
         }
     }
     /*Masked*/
     else {
-#if LV_COLOR_DEPTH == 16
-        uint32_t c32 = color.full + ((uint32_t)color.full << 16);
-#endif
         /*Only the mask matters*/
         if(opa >= LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w && ((lv_uintptr_t)(mask) & 0x3); x++) {
-                    FILL_NORMAL_MASK_PX(color)
-                }
-
-                for(; x <= x_end4; x += 4) {
-                    uint32_t mask32 = *((uint32_t *)mask);
-                    if(mask32 == 0xFFFFFFFF) {
-#if LV_COLOR_DEPTH == 16
-                        if((lv_uintptr_t)dest_buf & 0x3) {
-                            *(dest_buf + 0) = color;
-                            uint32_t * d = (uint32_t *)(dest_buf + 1);
-                            *d = c32;
-                            *(dest_buf + 3) = color;
-                        }
-                        else {
-                            uint32_t * d = (uint32_t *)dest_buf;
-                            *d = c32;
-                            *(d + 1) = c32;
-                        }
-#else
-                        dest_buf[0] = color;
-                        dest_buf[1] = color;
-                        dest_buf[2] = color;
-                        dest_buf[3] = color;
-#endif
-                        dest_buf += 4;
-                        mask += 4;
-                    }
-                    else if(mask32) {
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                        FILL_NORMAL_MASK_PX(color)
-                    }
-                    else {
-                        mask += 4;
-                        dest_buf += 4;
-                    }
-                }
-
-                for(; x < w ; x++) {
-                    FILL_NORMAL_MASK_PX(color)
-                }
-                dest_buf += (dest_stride - w);
-                mask += (mask_stride - w);
+                k->fill_mask(dest_buf, w, color, mask);
+                dest_buf += dest_stride;
+                mask += mask_stride;
             }
         }
         /*With opacity*/
         else {
-            /*Buffer the result color to avoid recalculating the same color*/
-            lv_color_t last_dest_color;
-            lv_color_t last_res_color;
-            lv_opa_t last_mask = LV_OPA_TRANSP;
-            last_dest_color.full = dest_buf[0].full;
-            last_res_color.full = dest_buf[0].full;
-            lv_opa_t opa_tmp = LV_OPA_TRANSP;
-
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(*mask) {
-                        if(*mask != last_mask) opa_tmp = *mask == LV_OPA_COVER ? opa :
-                                                             (uint32_t)((uint32_t)(*mask) * opa) >> 8;
-                        if(*mask != last_mask || last_dest_color.full != dest_buf[x].full) {
-                            if(opa_tmp == LV_OPA_COVER) last_res_color = color;
-                            else last_res_color = lv_color_mix(color, dest_buf[x], opa_tmp);
-                            last_mask = *mask;
-                            last_dest_color.full = dest_buf[x].full;
-                        }
-                        dest_buf[x] = last_res_color;
-                    }
-                    mask++;
-                }
+                k->fill_mask_opa(dest_buf, w, color, opa, mask);
                 dest_buf += dest_stride;
-                mask += (mask_stride - w);
+                mask += mask_stride;
             }
         }
     }
@@ -638,6 +619,202 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
     }
 }
 
+static lv_color_t (*get_blend_fp(lv_blend_mode_t blend_mode))(lv_color_t, lv_color_t, lv_opa_t)
+{
+#if LV_DRAW_COMPLEX
+    switch(blend_mode) {
+        case LV_BLEND_MODE_ADDITIVE:
+            return color_blend_true_color_additive;
+        case LV_BLEND_MODE_SUBTRACTIVE:
+            return color_blend_true_color_subtractive;
+        case LV_BLEND_MODE_MULTIPLY:
+            return color_blend_true_color_multiply;
+        default:
+            return NULL;
+    }
+#else
+    LV_UNUSED(blend_mode);
+    return NULL;
+#endif
+}
+
+/**
+ * Fill an area of a buffer stored in the display's native orientation.
+ * `dest_buf` points to the pixel of the first column of the first row, and the next pixel of a row
+ * and the first pixel of the next row are `dest_px_step` and `dest_line_step` pixels away.
+ * Produces the same colors as `fill_normal` and `fill_blended`.
+ */
+static void LV_ATTRIBUTE_FAST_MEM fill_rotated(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                               int32_t dest_px_step, int32_t dest_line_step, lv_color_t color,
+                                               lv_opa_t opa, const lv_opa_t * mask, lv_coord_t mask_stride,
+                                               lv_blend_mode_t blend_mode)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+    lv_color_t * dest_px;
+
+    lv_color_t (*blend_fp)(lv_color_t, lv_color_t, lv_opa_t) = NULL;
+    if(blend_mode != LV_BLEND_MODE_NORMAL) {
+        blend_fp = get_blend_fp(blend_mode);
+        if(blend_fp == NULL) {
+            LV_LOG_WARN("fill_rotated: unsupported blend mode");
+            return;
+        }
+    }
+
+    /*No mask*/
+    if(mask == NULL) {
+        if(blend_fp) {
+            for(y = 0; y < h; y++) {
+                dest_px = dest_buf;
+                for(x = 0; x < w; x++) {
+                    *dest_px = blend_fp(color, *dest_px, opa);
+                    dest_px += dest_px_step;
+                }
+                dest_buf += dest_line_step;
+            }
+        }
+        else if(opa >= LV_OPA_MAX) {
+            for(y = 0; y < h; y++) {
+                dest_px = dest_buf;
+                for(x = 0; x < w; x++) {
+                    *dest_px = color;
+                    dest_px += dest_px_step;
+                }
+                dest_buf += dest_line_step;
+            }
+        }
+        else {
+            /*The result depends only on the destination pixel so the pixels can be processed in any order.
+             *Blend the rows or the columns, whichever are contiguous in the memory.*/
+            int32_t run_len = w;
+            int32_t run_cnt = h;
+            int32_t run_step = dest_line_step;
+            int32_t run_dir = dest_px_step;
+            if(dest_px_step != 1 && dest_px_step != -1) {
+                run_len = h;
+                run_cnt = w;
+                run_step = dest_px_step;
+                run_dir = dest_line_step;
+            }
+
+            const lv_draw_sw_blend_kernels_t * k = lv_draw_sw_blend_get_kernels();
+            int32_t i;
+            for(i = 0; i < run_cnt; i++) {
+                k->fill_opa(run_dir > 0 ? dest_buf : dest_buf - (run_len - 1), run_len, color, opa);
+                dest_buf += run_step;
+            }
+        }
+    }
+    /*Masked*/
+    else {
+        for(y = 0; y < h; y++) {
+            dest_px = dest_buf;
+            for(x = 0; x < w; x++) {
+                if(mask[x]) {
+                    if(blend_fp) {
+                        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                        *dest_px = blend_fp(color, *dest_px, opa_tmp);
+                    }
+                    else if(opa >= LV_OPA_MAX) {
+                        if(mask[x] == LV_OPA_COVER) *dest_px = color;
+                        else *dest_px = lv_color_mix(color, *dest_px, mask[x]);
+                    }
+                    else {
+                        lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+                        *dest_px = lv_color_mix(color, *dest_px, opa_tmp);
+                    }
+                }
+                dest_px += dest_px_step;
+            }
+            dest_buf += dest_line_step;
+            mask += mask_stride;
+        }
+    }
+}
+
+/**
+ * Blend an image to a buffer stored in the display's native orientation.
+ * The destination is addressed the same way as in `fill_rotated`.
+ * Produces the same colors as `map_normal` and `map_blended`.
+ */
+static void LV_ATTRIBUTE_FAST_MEM map_rotated(lv_color_t * dest_buf, const lv_area_t * dest_area,
+                                              int32_t dest_px_step, int32_t dest_line_step,
+                                              const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa,
+                                              const lv_opa_t * mask, lv_coord_t mask_stride, lv_blend_mode_t blend_mode)
+{
+    int32_t w = lv_area_get_width(dest_area);
+    int32_t h = lv_area_get_height(dest_area);
+
+    int32_t x;
+    int32_t y;
+    lv_color_t * dest_px;
+
+    lv_color_t (*blend_fp)(lv_color_t, lv_color_t, lv_opa_t) = NULL;
+    if(blend_mode != LV_BLEND_MODE_NORMAL) {
+        blend_fp = get_blend_fp(blend_mode);
+        if(blend_fp == NULL) {
+            LV_LOG_WARN("map_rotated: unsupported blend mode");
+            return;
+        }
+    }
+
+    /*No mask*/
+    if(mask == NULL) {
+        for(y = 0; y < h; y++) {
+            dest_px = dest_buf;
+            if(blend_fp) {
+                for(x = 0; x < w; x++) {
+                    *dest_px = blend_fp(src_buf[x], *dest_px, opa);
+                    dest_px += dest_px_step;
+                }
+            }
+            else if(opa >= LV_OPA_MAX) {
+                for(x = 0; x < w; x++) {
+                    *dest_px = src_buf[x];
+                    dest_px += dest_px_step;
+                }
+            }
+            else {
+                for(x = 0; x < w; x++) {
+                    *dest_px = lv_color_mix(src_buf[x], *dest_px, opa);
+                    dest_px += dest_px_step;
+                }
+            }
+            dest_buf += dest_line_step;
+            src_buf += src_stride;
+        }
+    }
+    /*Masked*/
+    else {
+        for(y = 0; y < h; y++) {
+            dest_px = dest_buf;
+            for(x = 0; x < w; x++) {
+                if(mask[x]) {
+                    lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+                    if(blend_fp) {
+                        *dest_px = blend_fp(src_buf[x], *dest_px, opa_tmp);
+                    }
+                    else if(opa > LV_OPA_MAX) {
+                        if(mask[x] == LV_OPA_COVER) *dest_px = src_buf[x];
+                        else *dest_px = lv_color_mix(src_buf[x], *dest_px, mask[x]);
+                    }
+                    else {
+                        *dest_px = lv_color_mix(src_buf[x], *dest_px, opa_tmp);
+                    }
+                }
+                dest_px += dest_px_step;
+            }
+            dest_buf += dest_line_step;
+            src_buf += src_stride;
+            mask += mask_stride;
+        }
+    }
+}
+
 static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_area_t * dest_area,
                                              lv_coord_t dest_stride, const lv_color_t * src_buf,
                                              lv_coord_t src_stride, lv_opa_t opa, const lv_opa_t * mask,
@@ -647,8 +824,8 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
-    int32_t x;
     int32_t y;
+    const lv_draw_sw_blend_kernels_t * k = lv_draw_sw_blend_get_kernels();
 
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
@@ -661,9 +838,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
         }
         else {
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
-                }
+                k->map_opa(dest_buf, src_buf, w, opa);
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
@@ -673,44 +848,8 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
     else {
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
-            int32_t x_end4 = w - 4;
-
             for(y = 0; y < h; y++) {
-                const lv_opa_t * mask_tmp_x = mask;
-#if 0
-                for(x = 0; x < w; x++) {
-                    MAP_NORMAL_MASK_PX(x);
-                }
-#else
-                for(x = 0; x < w && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
-                    MAP_NORMAL_MASK_PX(x)
-                }
-
-                uint32_t * mask32 = (uint32_t *)mask_tmp_x;
-                for(; x < x_end4; x += 4) {
-                    if(*mask32) {
-                        if((*mask32) == 0xFFFFFFFF) {
-                            dest_buf[x] = src_buf[x];
-                            dest_buf[x + 1] = src_buf[x + 1];
-                            dest_buf[x + 2] = src_buf[x + 2];
-                            dest_buf[x + 3] = src_buf[x + 3];
-                        }
-                        else {
-                            mask_tmp_x = (const lv_opa_t *)mask32;
-                            MAP_NORMAL_MASK_PX(x)
-                            MAP_NORMAL_MASK_PX(x + 1)
-                            MAP_NORMAL_MASK_PX(x + 2)
-                            MAP_NORMAL_MASK_PX(x + 3)
-                        }
-                    }
-                    mask32++;
-                }
-
-                mask_tmp_x = (const lv_opa_t *)mask32;
-                for(; x < w ; x++) {
-                    MAP_NORMAL_MASK_PX(x)
-                }
-#endif
+                k->map_mask(dest_buf, src_buf, w, mask);
                 dest_buf += dest_stride;
                 src_buf += src_stride;
                 mask += mask_stride;
@@ -719,12 +858,7 @@ static void LV_ATTRIBUTE_FAST_MEM map_normal(lv_color_t * dest_buf, const lv_are
         /*Handle opa and mask values too*/
         else {
             for(y = 0; y < h; y++) {
-                for(x = 0; x < w; x++) {
-                    if(mask[x]) {
-                        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
-                        dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa_tmp);
-                    }
-                }
+                k->map_mask_opa(dest_buf, src_buf, w, opa, mask);
                 dest_buf += dest_stride;
                 src_buf += src_stride;
                 mask += mask_stride;
@@ -17,6 +17,7 @@ extern "C" {
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../lv_draw_mask.h"
+#include "../../hal/lv_hal_disp.h"
 
 /*********************
  *      DEFINES
@@ -59,6 +60,31 @@ void lv_draw_sw_blend(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_d
 void /* LV_ATTRIBUTE_FAST_MEM */ lv_draw_sw_blend_basic(struct _lv_draw_ctx_t * draw_ctx,
                                                         const lv_draw_sw_blend_dsc_t * dsc);
 
+/**
+ * Get a pointer to a pixel of `draw_ctx->buf` and the distance of its neighbors.
+ * With `render_rotated` the buffer is stored in the display's native orientation so the next pixel
+ * of a row is not necessarily the next pixel in the memory.
+ * Not usable with `set_px_cb` and `screen_transp`.
+ * @param draw_ctx      pointer to a draw context
+ * @param x             absolute X coordinate of the pixel
+ * @param y             absolute Y coordinate of the pixel
+ * @param px_step       store the distance of the next pixel in the same row here (in pixels)
+ * @param line_step     store the distance of the pixel below here (in pixels)
+ * @return              pointer to the pixel
+ */
+lv_color_t * lv_draw_sw_get_buf_px(struct _lv_draw_ctx_t * draw_ctx, lv_coord_t x, lv_coord_t y,
+                                   int32_t * px_step, int32_t * line_step);
+
+/**
+ * Tell whether the display buffer is drawn in the display's native orientation
+ * @param drv           pointer to a display driver
+ * @return              true: `render_rotated` is active on a rotated display
+ */
+static inline bool _lv_draw_sw_is_buf_rotated(const lv_disp_drv_t * drv)
+{
+    return drv->render_rotated && drv->sw_rotate && drv->rotated != LV_DISP_ROT_NONE;
+}
+
 /**********************
  *      MACROS
  **********************/
@@ -0,0 +1,774 @@
+/**
+ * @file lv_draw_sw_blend_kernels.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_blend_kernels.h"
+#include "../../misc/lv_math.h"
+#include "../lv_img_buf.h"
+
+#if LV_DRAW_SW_BLEND_SSE2
+#include <emmintrin.h>
+#endif
+
+/*********************
+ *      DEFINES
+ *********************/
+#if LV_DRAW_SW_BLEND_SSE2
+    #define DEFAULT_KERNELS lv_draw_sw_blend_kernels_sse2
+#elif LV_DRAW_SW_BLEND_SWAR
+    #define DEFAULT_KERNELS lv_draw_sw_blend_kernels_swar
+#else
+    #define DEFAULT_KERNELS lv_draw_sw_blend_kernels_scalar
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void fill_opa_scalar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+static void fill_mask_scalar(lv_color_t * dest, int32_t len, lv_color_t color, const lv_opa_t * mask);
+static void fill_mask_opa_scalar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa,
+                                 const lv_opa_t * mask);
+static void map_opa_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+static void map_mask_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len, const lv_opa_t * mask);
+static void map_mask_opa_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa,
+                                const lv_opa_t * mask);
+static void argb_split_scalar(lv_color_t * cbuf, lv_opa_t * abuf, const uint8_t * src, int32_t len);
+
+#if LV_DRAW_SW_BLEND_SWAR
+static void fill_opa_swar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+static void fill_mask_swar(lv_color_t * dest, int32_t len, lv_color_t color, const lv_opa_t * mask);
+static void fill_mask_opa_swar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa,
+                               const lv_opa_t * mask);
+static void map_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+static void map_mask_swar(lv_color_t * dest, const lv_color_t * src, int32_t len, const lv_opa_t * mask);
+static void map_mask_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa,
+                              const lv_opa_t * mask);
+#endif
+
+#if LV_DRAW_SW_BLEND_SSE2
+static void fill_opa_sse2(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+static void fill_mask_sse2(lv_color_t * dest, int32_t len, lv_color_t color, const lv_opa_t * mask);
+static void fill_mask_opa_sse2(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa,
+                               const lv_opa_t * mask);
+static void map_opa_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+static void map_mask_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len, const lv_opa_t * mask);
+static void map_mask_opa_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa,
+                              const lv_opa_t * mask);
+#endif
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_scalar = {
+    .fill_opa = fill_opa_scalar,
+    .fill_mask = fill_mask_scalar,
+    .fill_mask_opa = fill_mask_opa_scalar,
+    .map_opa = map_opa_scalar,
+    .map_mask = map_mask_scalar,
+    .map_mask_opa = map_mask_opa_scalar,
+    .argb_split = argb_split_scalar,
+};
+
+#if LV_DRAW_SW_BLEND_SWAR
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_swar = {
+    .fill_opa = fill_opa_swar,
+    .fill_mask = fill_mask_swar,
+    .fill_mask_opa = fill_mask_opa_swar,
+    .map_opa = map_opa_swar,
+    .map_mask = map_mask_swar,
+    .map_mask_opa = map_mask_opa_swar,
+    .argb_split = argb_split_scalar,
+};
+#endif
+
+#if LV_DRAW_SW_BLEND_SSE2
+const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_sse2 = {
+    .fill_opa = fill_opa_sse2,
+    .fill_mask = fill_mask_sse2,
+    .fill_mask_opa = fill_mask_opa_sse2,
+    .map_opa = map_opa_sse2,
+    .map_mask = map_mask_sse2,
+    .map_mask_opa = map_mask_opa_sse2,
+    .argb_split = argb_split_scalar,
+};
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const lv_draw_sw_blend_kernels_t * kernels = &DEFAULT_KERNELS;
+
+/**********************
+ *      MACROS
+ **********************/
+#define FILL_NORMAL_MASK_PX(color)                                  \
+    if(*mask == LV_OPA_COVER) *dest = color;                        \
+    else *dest = lv_color_mix(color, *dest, *mask);                 \
+    mask++;                                                         \
+    dest++;
+
+#define MAP_NORMAL_MASK_PX(x)                                                   \
+    if(*mask_tmp_x) {                                                           \
+        if(*mask_tmp_x == LV_OPA_COVER) dest[x] = src[x];                       \
+        else dest[x] = lv_color_mix(src[x], dest[x], *mask_tmp_x);              \
+    }                                                                           \
+    mask_tmp_x++;
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void)
+{
+    return kernels;
+}
+
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * new_kernels)
+{
+    kernels = new_kernels ? new_kernels : &DEFAULT_KERNELS;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void LV_ATTRIBUTE_FAST_MEM fill_opa_scalar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+    /*lv_color_mix work with an optimized algorithm with 16 bit color depth.
+     *However, it introduces some rounded error on opa.
+     *Introduce the same error here too to make lv_color_premult produces the same result */
+    opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa = opa << 3;
+#endif
+
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    lv_opa_t opa_inv = 255 - opa;
+
+    /*Buffer the result color to avoid recalculating the same color*/
+    lv_color_t last_dest_color = lv_color_black();
+    lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(last_dest_color.full != dest[x].full) {
+            last_dest_color = dest[x];
+            last_res_color = lv_color_mix_premult(color_premult, dest[x], opa_inv);
+        }
+        dest[x] = last_res_color;
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_scalar(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                   const lv_opa_t * mask)
+{
+#if LV_COLOR_DEPTH == 16
+    uint32_t c32 = color.full + ((uint32_t)color.full << 16);
+#endif
+    int32_t x_end4 = len - 4;
+    int32_t x;
+    for(x = 0; x < len && ((lv_uintptr_t)(mask) & 0x3); x++) {
+        FILL_NORMAL_MASK_PX(color)
+    }
+
+    for(; x <= x_end4; x += 4) {
+        uint32_t mask32 = *((uint32_t *)mask);
+        if(mask32 == 0xFFFFFFFF) {
+#if LV_COLOR_DEPTH == 16
+            if((lv_uintptr_t)dest & 0x3) {
+                *(dest + 0) = color;
+                uint32_t * d = (uint32_t *)(dest + 1);
+                *d = c32;
+                *(dest + 3) = color;
+            }
+            else {
+                uint32_t * d = (uint32_t *)dest;
+                *d = c32;
+                *(d + 1) = c32;
+            }
+#else
+            dest[0] = color;
+            dest[1] = color;
+            dest[2] = color;
+            dest[3] = color;
+#endif
+            dest += 4;
+            mask += 4;
+        }
+        else if(mask32) {
+            FILL_NORMAL_MASK_PX(color)
+            FILL_NORMAL_MASK_PX(color)
+            FILL_NORMAL_MASK_PX(color)
+            FILL_NORMAL_MASK_PX(color)
+        }
+        else {
+            mask += 4;
+            dest += 4;
+        }
+    }
+
+    for(; x < len ; x++) {
+        FILL_NORMAL_MASK_PX(color)
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_opa_scalar(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                       lv_opa_t opa, const lv_opa_t * mask)
+{
+    /*Buffer the result color to avoid recalculating the same color*/
+    lv_color_t last_dest_color;
+    lv_color_t last_res_color;
+    lv_opa_t last_mask = LV_OPA_TRANSP;
+    last_dest_color.full = dest[0].full;
+    last_res_color.full = dest[0].full;
+    lv_opa_t opa_tmp = LV_OPA_TRANSP;
+
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x]) {
+            if(mask[x] != last_mask) opa_tmp = mask[x] == LV_OPA_COVER ? opa :
+                                                   (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+            if(mask[x] != last_mask || last_dest_color.full != dest[x].full) {
+                if(opa_tmp == LV_OPA_COVER) last_res_color = color;
+                else last_res_color = lv_color_mix(color, dest[x], opa_tmp);
+                last_mask = mask[x];
+                last_dest_color.full = dest[x].full;
+            }
+            dest[x] = last_res_color;
+        }
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_opa_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                 lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        dest[x] = lv_color_mix(src[x], dest[x], opa);
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                  const lv_opa_t * mask)
+{
+    int32_t x_end4 = len - 4;
+    int32_t x;
+    const lv_opa_t * mask_tmp_x = mask;
+    for(x = 0; x < len && ((lv_uintptr_t)mask_tmp_x & 0x3); x++) {
+        MAP_NORMAL_MASK_PX(x)
+    }
+
+    uint32_t * mask32 = (uint32_t *)mask_tmp_x;
+    for(; x < x_end4; x += 4) {
+        if(*mask32) {
+            if((*mask32) == 0xFFFFFFFF) {
+                dest[x] = src[x];
+                dest[x + 1] = src[x + 1];
+                dest[x + 2] = src[x + 2];
+                dest[x + 3] = src[x + 3];
+            }
+            else {
+                mask_tmp_x = (const lv_opa_t *)mask32;
+                MAP_NORMAL_MASK_PX(x)
+                MAP_NORMAL_MASK_PX(x + 1)
+                MAP_NORMAL_MASK_PX(x + 2)
+                MAP_NORMAL_MASK_PX(x + 3)
+            }
+        }
+        mask32++;
+    }
+
+    mask_tmp_x = (const lv_opa_t *)mask32;
+    for(; x < len ; x++) {
+        MAP_NORMAL_MASK_PX(x)
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_opa_scalar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                      lv_opa_t opa, const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x]) {
+            lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+            dest[x] = lv_color_mix(src[x], dest[x], opa_tmp);
+        }
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM argb_split_scalar(lv_color_t * cbuf, lv_opa_t * abuf, const uint8_t * src,
+                                                    int32_t len)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        abuf[x] = src[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
+        cbuf[x].full = *src;
+#elif LV_COLOR_DEPTH == 16
+        cbuf[x].full = *src + ((*(src + 1)) << 8);
+#elif LV_COLOR_DEPTH == 32
+        cbuf[x] = *((lv_color_t *) src);
+        cbuf[x].ch.alpha = 0xff;
+#endif
+        src += LV_IMG_PX_SIZE_ALPHA_BYTE;
+    }
+}
+
+#if LV_DRAW_SW_BLEND_SWAR
+
+/*
+ * Two RGB565 pixels are stored in a 32 bit word and each color channel is extracted to the
+ * 16 bit lanes of a word. A lane holds at most 63 * 255 + 255 during mixing so the lanes never overflow
+ * into each other and both pixels are mixed with the same instructions.
+ *
+ * With LV_COLOR_MIX_ROUND_OFS == 0 `lv_color_mix` uses a 5 bit ratio and calculates
+ * `bg + (fg - bg) * mix / 32` rounded down in every channel, i.e. `(fg * mix + bg * (32 - mix)) >> 5`.
+ * Otherwise it calculates `(fg * mix + bg * (255 - mix) + LV_COLOR_MIX_ROUND_OFS) / 255`.
+ * The kernels do the same so the results are bit-identical.
+ */
+
+#define SWAR_LANES      0x00010001U
+#define SWAR_R(w)       (((w) >> 11) & 0x001F001FU)
+#define SWAR_G(w)       (((w) >> 5) & 0x003F003FU)
+#define SWAR_B(w)       ((w) & 0x001F001FU)
+
+static inline uint32_t swar_load(const lv_color_t * p)
+{
+    uint32_t w = (uint32_t)p[0].full | ((uint32_t)p[1].full << 16);
+#if LV_COLOR_16_SWAP
+    w = ((w >> 8) & 0x00FF00FFU) | ((w << 8) & 0xFF00FF00U);
+#endif
+    return w;
+}
+
+static inline void swar_store(lv_color_t * p, uint32_t w)
+{
+#if LV_COLOR_16_SWAP
+    w = ((w >> 8) & 0x00FF00FFU) | ((w << 8) & 0xFF00FF00U);
+#endif
+    p[0].full = (uint16_t)w;
+    p[1].full = (uint16_t)(w >> 16);
+}
+
+static inline uint32_t swar_splat(lv_color_t c)
+{
+    lv_color_t tmp[2] = {c, c};
+    return swar_load(tmp);
+}
+
+/*Exact `x / 255` in both lanes if the lanes are less than 0xFF00*/
+static inline uint32_t swar_div255(uint32_t x)
+{
+    return ((x + SWAR_LANES + ((x >> 8) & 0x00FF00FFU)) >> 8) & 0x00FF00FFU;
+}
+
+/*Multiply the lanes of `a` by `m0` and `m1`*/
+static inline uint32_t swar_mul2(uint32_t a, uint32_t m0, uint32_t m1)
+{
+    return ((a & 0xFFFFU) * m0) | (((a >> 16) * m1) << 16);
+}
+
+/*`(fg * mix + bg * (255 - mix) + LV_COLOR_MIX_ROUND_OFS) / 255` in every channel of both pixels*/
+static inline uint32_t swar_mix255(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+    uint32_t mix_inv = 255 - mix;
+    uint32_t ofs = LV_COLOR_MIX_ROUND_OFS * SWAR_LANES;
+    uint32_t r = swar_div255(SWAR_R(fg) * mix + SWAR_R(bg) * mix_inv + ofs);
+    uint32_t g = swar_div255(SWAR_G(fg) * mix + SWAR_G(bg) * mix_inv + ofs);
+    uint32_t b = swar_div255(SWAR_B(fg) * mix + SWAR_B(bg) * mix_inv + ofs);
+    return (r << 11) | (g << 5) | b;
+}
+
+/*`lv_color_mix()` for both pixels with the same ratio*/
+static inline uint32_t swar_mix(uint32_t fg, uint32_t bg, uint32_t mix)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    mix = (mix + 4) >> 3;
+    uint32_t mix_inv = 32 - mix;
+    uint32_t r = ((SWAR_R(fg) * mix + SWAR_R(bg) * mix_inv) >> 5) & 0x001F001FU;
+    uint32_t g = ((SWAR_G(fg) * mix + SWAR_G(bg) * mix_inv) >> 5) & 0x003F003FU;
+    uint32_t b = ((SWAR_B(fg) * mix + SWAR_B(bg) * mix_inv) >> 5) & 0x001F001FU;
+    return (r << 11) | (g << 5) | b;
+#else
+    return swar_mix255(fg, bg, mix);
+#endif
+}
+
+/*`lv_color_mix()` with the ratio `mix0` for the first and `mix1` for the second pixel*/
+static inline uint32_t swar_mix2(uint32_t fg, uint32_t bg, uint32_t mix0, uint32_t mix1)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    mix0 = (mix0 + 4) >> 3;
+    mix1 = (mix1 + 4) >> 3;
+    uint32_t inv0 = 32 - mix0;
+    uint32_t inv1 = 32 - mix1;
+    uint32_t r = ((swar_mul2(SWAR_R(fg), mix0, mix1) + swar_mul2(SWAR_R(bg), inv0, inv1)) >> 5) & 0x001F001FU;
+    uint32_t g = ((swar_mul2(SWAR_G(fg), mix0, mix1) + swar_mul2(SWAR_G(bg), inv0, inv1)) >> 5) & 0x003F003FU;
+    uint32_t b = ((swar_mul2(SWAR_B(fg), mix0, mix1) + swar_mul2(SWAR_B(bg), inv0, inv1)) >> 5) & 0x001F001FU;
+#else
+    uint32_t inv0 = 255 - mix0;
+    uint32_t inv1 = 255 - mix1;
+    uint32_t ofs = LV_COLOR_MIX_ROUND_OFS * SWAR_LANES;
+    uint32_t r = swar_div255(swar_mul2(SWAR_R(fg), mix0, mix1) + swar_mul2(SWAR_R(bg), inv0, inv1) + ofs);
+    uint32_t g = swar_div255(swar_mul2(SWAR_G(fg), mix0, mix1) + swar_mul2(SWAR_G(bg), inv0, inv1) + ofs);
+    uint32_t b = swar_div255(swar_mul2(SWAR_B(fg), mix0, mix1) + swar_mul2(SWAR_B(bg), inv0, inv1) + ofs);
+#endif
+    return (r << 11) | (g << 5) | b;
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_opa_swar(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    /*The same rounding as in `fill_opa_scalar`*/
+    opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa = opa << 3;
+#endif
+
+    uint32_t fg = swar_splat(color);
+
+    /*Buffer the result to avoid recalculating it on plain backgrounds*/
+    uint32_t last_dest = 0;
+    uint32_t last_res = swar_mix255(fg, last_dest, opa);
+
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        uint32_t d = swar_load(&dest[x]);
+        if(d != last_dest) {
+            last_dest = d;
+            last_res = swar_mix255(fg, d, opa);
+        }
+        swar_store(&dest[x], last_res);
+    }
+
+    if(x < len) {
+        lv_color_t tmp[2] = {dest[x], dest[x]};
+        swar_store(tmp, swar_mix255(fg, swar_load(tmp), opa));
+        dest[x] = tmp[0];
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_swar(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                 const lv_opa_t * mask)
+{
+    uint32_t fg = swar_splat(color);
+
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        lv_opa_t m0 = mask[x];
+        lv_opa_t m1 = mask[x + 1];
+        if((m0 & m1) == LV_OPA_COVER) {
+            dest[x] = color;
+            dest[x + 1] = color;
+        }
+        else if(m0 | m1) {
+            swar_store(&dest[x], swar_mix2(fg, swar_load(&dest[x]), m0, m1));
+        }
+    }
+
+    if(x < len) {
+        if(mask[x] == LV_OPA_COVER) dest[x] = color;
+        else dest[x] = lv_color_mix(color, dest[x], mask[x]);
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_opa_swar(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                     lv_opa_t opa, const lv_opa_t * mask)
+{
+    uint32_t fg = swar_splat(color);
+
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        lv_opa_t m0 = mask[x];
+        lv_opa_t m1 = mask[x + 1];
+        if((m0 | m1) == 0) continue;
+
+        /*A zero ratio keeps the destination so transparent pixels need no special care*/
+        uint32_t opa0 = m0 == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)m0 * opa) >> 8;
+        uint32_t opa1 = m1 == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)m1 * opa) >> 8;
+        swar_store(&dest[x], swar_mix2(fg, swar_load(&dest[x]), opa0, opa1));
+    }
+
+    if(x < len && mask[x]) {
+        lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+        dest[x] = lv_color_mix(color, dest[x], opa_tmp);
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                               lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        swar_store(&dest[x], swar_mix(swar_load(&src[x]), swar_load(&dest[x]), opa));
+    }
+
+    if(x < len) dest[x] = lv_color_mix(src[x], dest[x], opa);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_swar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        lv_opa_t m0 = mask[x];
+        lv_opa_t m1 = mask[x + 1];
+        if((m0 & m1) == LV_OPA_COVER) {
+            dest[x] = src[x];
+            dest[x + 1] = src[x + 1];
+        }
+        else if(m0 | m1) {
+            swar_store(&dest[x], swar_mix2(swar_load(&src[x]), swar_load(&dest[x]), m0, m1));
+        }
+    }
+
+    if(x < len && mask[x]) {
+        if(mask[x] == LV_OPA_COVER) dest[x] = src[x];
+        else dest[x] = lv_color_mix(src[x], dest[x], mask[x]);
+    }
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_opa_swar(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                    lv_opa_t opa, const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len - 1; x += 2) {
+        lv_opa_t m0 = mask[x];
+        lv_opa_t m1 = mask[x + 1];
+        if((m0 | m1) == 0) continue;
+
+        uint32_t opa0 = m0 >= LV_OPA_MAX ? opa : ((opa * m0) >> 8);
+        uint32_t opa1 = m1 >= LV_OPA_MAX ? opa : ((opa * m1) >> 8);
+        swar_store(&dest[x], swar_mix2(swar_load(&src[x]), swar_load(&dest[x]), opa0, opa1));
+    }
+
+    if(x < len && mask[x]) {
+        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+        dest[x] = lv_color_mix(src[x], dest[x], opa_tmp);
+    }
+}
+
+#endif /*LV_DRAW_SW_BLEND_SWAR*/
+
+#if LV_DRAW_SW_BLEND_SSE2
+
+/*
+ * The same calculations as the SWAR kernels but with 8 pixels in a 128 bit register.
+ * The remaining pixels of a row are blended by the SWAR kernels.
+ */
+
+static inline __m128i sse2_load(const lv_color_t * p)
+{
+    __m128i v = _mm_loadu_si128((const __m128i *)p);
+#if LV_COLOR_16_SWAP
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    return v;
+}
+
+static inline void sse2_store(lv_color_t * p, __m128i v)
+{
+#if LV_COLOR_16_SWAP
+    v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+#endif
+    _mm_storeu_si128((__m128i *)p, v);
+}
+
+/*Load 8 mask values to 16 bit lanes*/
+static inline __m128i sse2_load_mask(const lv_opa_t * mask)
+{
+    return _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+}
+
+/*`cond ? a : b` in every lane*/
+static inline __m128i sse2_select(__m128i cond, __m128i a, __m128i b)
+{
+    return _mm_or_si128(_mm_and_si128(cond, a), _mm_andnot_si128(cond, b));
+}
+
+static inline __m128i sse2_div255(__m128i x)
+{
+    __m128i t = _mm_add_epi16(_mm_add_epi16(x, _mm_set1_epi16(1)), _mm_srli_epi16(x, 8));
+    return _mm_srli_epi16(t, 8);
+}
+
+/*`(fg * mix + bg * (255 - mix) + LV_COLOR_MIX_ROUND_OFS) / 255` in every channel*/
+static inline __m128i sse2_mix255(__m128i fg, __m128i bg, __m128i mix)
+{
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(255), mix);
+    __m128i ofs = _mm_set1_epi16(LV_COLOR_MIX_ROUND_OFS);
+    __m128i mask_g = _mm_set1_epi16(0x3F);
+    __m128i mask_b = _mm_set1_epi16(0x1F);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), mix_inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), mask_g), mix),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), mask_g), mix_inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, mask_b), mix),
+                              _mm_mullo_epi16(_mm_and_si128(bg, mask_b), mix_inv));
+
+    r = sse2_div255(_mm_add_epi16(r, ofs));
+    g = sse2_div255(_mm_add_epi16(g, ofs));
+    b = sse2_div255(_mm_add_epi16(b, ofs));
+
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+}
+
+/*`lv_color_mix()` in every lane*/
+static inline __m128i sse2_mix(__m128i fg, __m128i bg, __m128i mix)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    mix = _mm_srli_epi16(_mm_add_epi16(mix, _mm_set1_epi16(4)), 3);
+    __m128i mix_inv = _mm_sub_epi16(_mm_set1_epi16(32), mix);
+    __m128i mask_g = _mm_set1_epi16(0x3F);
+    __m128i mask_b = _mm_set1_epi16(0x1F);
+
+    __m128i r = _mm_add_epi16(_mm_mullo_epi16(_mm_srli_epi16(fg, 11), mix),
+                              _mm_mullo_epi16(_mm_srli_epi16(bg, 11), mix_inv));
+    __m128i g = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(fg, 5), mask_g), mix),
+                              _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(bg, 5), mask_g), mix_inv));
+    __m128i b = _mm_add_epi16(_mm_mullo_epi16(_mm_and_si128(fg, mask_b), mix),
+                              _mm_mullo_epi16(_mm_and_si128(bg, mask_b), mix_inv));
+
+    r = _mm_srli_epi16(r, 5);
+    g = _mm_srli_epi16(g, 5);
+    b = _mm_srli_epi16(b, 5);
+
+    return _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+#else
+    return sse2_mix255(fg, bg, mix);
+#endif
+}
+
+static inline __m128i sse2_splat(lv_color_t c)
+{
+    lv_color_t tmp[8] = {c, c, c, c, c, c, c, c};
+    return sse2_load(tmp);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_opa_sse2(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+    lv_opa_t opa_round = opa;
+#if LV_COLOR_MIX_ROUND_OFS == 0
+    /*The same rounding as in `fill_opa_scalar`*/
+    opa_round = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa_round = opa_round << 3;
+#endif
+
+    __m128i fg = sse2_splat(color);
+    __m128i mix = _mm_set1_epi16(opa_round);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        sse2_store(&dest[x], sse2_mix255(fg, sse2_load(&dest[x]), mix));
+    }
+
+    if(x < len) fill_opa_swar(&dest[x], len - x, color, opa);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_sse2(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                 const lv_opa_t * mask)
+{
+    __m128i fg = sse2_splat(color);
+    __m128i zero = _mm_setzero_si128();
+    __m128i cover = _mm_set1_epi16(LV_OPA_COVER);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        __m128i m = sse2_load_mask(&mask[x]);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, zero)) == 0xFFFF) continue;
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, cover)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)&dest[x], _mm_set1_epi16((short)color.full));
+            continue;
+        }
+
+        sse2_store(&dest[x], sse2_mix(fg, sse2_load(&dest[x]), m));
+    }
+
+    if(x < len) fill_mask_swar(&dest[x], len - x, color, &mask[x]);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM fill_mask_opa_sse2(lv_color_t * dest, int32_t len, lv_color_t color,
+                                                     lv_opa_t opa, const lv_opa_t * mask)
+{
+    __m128i fg = sse2_splat(color);
+    __m128i zero = _mm_setzero_si128();
+    __m128i cover = _mm_set1_epi16(LV_OPA_COVER);
+    __m128i opa_v = _mm_set1_epi16(opa);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        __m128i m = sse2_load_mask(&mask[x]);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, zero)) == 0xFFFF) continue;
+
+        __m128i opa_tmp = sse2_select(_mm_cmpeq_epi16(m, cover), opa_v,
+                                      _mm_srli_epi16(_mm_mullo_epi16(m, opa_v), 8));
+        sse2_store(&dest[x], sse2_mix(fg, sse2_load(&dest[x]), opa_tmp));
+    }
+
+    if(x < len) fill_mask_opa_swar(&dest[x], len - x, color, opa, &mask[x]);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_opa_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                               lv_opa_t opa)
+{
+    __m128i mix = _mm_set1_epi16(opa);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        sse2_store(&dest[x], sse2_mix(sse2_load(&src[x]), sse2_load(&dest[x]), mix));
+    }
+
+    if(x < len) map_opa_swar(&dest[x], &src[x], len - x, opa);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                const lv_opa_t * mask)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i cover = _mm_set1_epi16(LV_OPA_COVER);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        __m128i m = sse2_load_mask(&mask[x]);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, zero)) == 0xFFFF) continue;
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, cover)) == 0xFFFF) {
+            _mm_storeu_si128((__m128i *)&dest[x], _mm_loadu_si128((const __m128i *)&src[x]));
+            continue;
+        }
+
+        sse2_store(&dest[x], sse2_mix(sse2_load(&src[x]), sse2_load(&dest[x]), m));
+    }
+
+    if(x < len) map_mask_swar(&dest[x], &src[x], len - x, &mask[x]);
+}
+
+static void LV_ATTRIBUTE_FAST_MEM map_mask_opa_sse2(lv_color_t * dest, const lv_color_t * src, int32_t len,
+                                                    lv_opa_t opa, const lv_opa_t * mask)
+{
+    __m128i zero = _mm_setzero_si128();
+    __m128i opa_max = _mm_set1_epi16(LV_OPA_MAX - 1);
+    __m128i opa_v = _mm_set1_epi16(opa);
+
+    int32_t x;
+    for(x = 0; x < len - 7; x += 8) {
+        __m128i m = sse2_load_mask(&mask[x]);
+        if(_mm_movemask_epi8(_mm_cmpeq_epi16(m, zero)) == 0xFFFF) continue;
+
+        __m128i opa_tmp = sse2_select(_mm_cmpgt_epi16(m, opa_max), opa_v,
+                                      _mm_srli_epi16(_mm_mullo_epi16(m, opa_v), 8));
+        sse2_store(&dest[x], sse2_mix(sse2_load(&src[x]), sse2_load(&dest[x]), opa_tmp));
+    }
+
+    if(x < len) map_mask_opa_swar(&dest[x], &src[x], len - x, opa, &mask[x]);
+}
+
+#endif /*LV_DRAW_SW_BLEND_SSE2*/
@@ -0,0 +1,123 @@
+/**
+ * @file lv_draw_sw_blend_kernels.h
+ *
+ * Row kernels of the software blending. `fill_normal`, `map_normal` and the image drawing
+ * call them for each row, so they can be replaced with faster implementations.
+ * Every implementation produces exactly the same pixels as the scalar one.
+ */
+
+#ifndef LV_DRAW_SW_BLEND_KERNELS_H
+#define LV_DRAW_SW_BLEND_KERNELS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/*1: blend RGB565 pixels with the SWAR (2 pixels in a 32 bit word) or SIMD kernels*/
+#ifndef LV_DRAW_SW_BLEND_SIMD
+#define LV_DRAW_SW_BLEND_SIMD 1
+#endif
+
+#if LV_DRAW_SW_BLEND_SIMD && LV_COLOR_DEPTH == 16
+#define LV_DRAW_SW_BLEND_SWAR 1
+#if defined(__SSE2__)
+#define LV_DRAW_SW_BLEND_SSE2 1
+#endif
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_SWAR
+#define LV_DRAW_SW_BLEND_SWAR 0
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_SSE2
+#define LV_DRAW_SW_BLEND_SSE2 0
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Blend functions working on one row of `len` pixels.
+ * `mask` and `src` have `len` elements too.
+ */
+typedef struct {
+    /** Fill with `color` and `opa` (`opa < LV_OPA_MAX`)*/
+    void (*fill_opa)(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa);
+
+    /** Fill with `color` using only the mask (`opa >= LV_OPA_MAX`)*/
+    void (*fill_mask)(lv_color_t * dest, int32_t len, lv_color_t color, const lv_opa_t * mask);
+
+    /** Fill with `color` using the mask and `opa` (`opa < LV_OPA_MAX`)*/
+    void (*fill_mask_opa)(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa, const lv_opa_t * mask);
+
+    /** Blend `src` with `opa` (`opa < LV_OPA_MAX`)*/
+    void (*map_opa)(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa);
+
+    /** Blend `src` using only the mask (`opa > LV_OPA_MAX`)*/
+    void (*map_mask)(lv_color_t * dest, const lv_color_t * src, int32_t len, const lv_opa_t * mask);
+
+    /** Blend `src` using the mask and `opa` (`opa <= LV_OPA_MAX`)*/
+    void (*map_mask_opa)(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa,
+                         const lv_opa_t * mask);
+
+    /** Split the pixels of an `LV_IMG_CF_TRUE_COLOR_ALPHA` image to colors and alpha values*/
+    void (*argb_split)(lv_color_t * cbuf, lv_opa_t * abuf, const uint8_t * src, int32_t len);
+} lv_draw_sw_blend_kernels_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the kernels used by the software renderer.
+ * @return      pointer to the kernel table
+ */
+const lv_draw_sw_blend_kernels_t * lv_draw_sw_blend_get_kernels(void);
+
+/**
+ * Replace the kernels used by the software renderer, e.g. with a platform specific assembly
+ * implementation (like the PIE instructions of the ESP32-S3).
+ * The kernels must produce exactly the same pixels as `lv_draw_sw_blend_kernels_scalar`.
+ * A convenient way is to copy the table returned by `lv_draw_sw_blend_get_kernels()` and replace
+ * some of its functions.
+ * @param kernels   pointer to a kernel table. Only the pointer is saved.
+ *                  NULL to use the default kernels again.
+ */
+void lv_draw_sw_blend_set_kernels(const lv_draw_sw_blend_kernels_t * kernels);
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+
+/*Portable implementation, one pixel at a time*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_scalar;
+
+#if LV_DRAW_SW_BLEND_SWAR
+/*Portable implementation for RGB565, two pixels in a 32 bit word*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_swar;
+#endif
+
+#if LV_DRAW_SW_BLEND_SSE2
+/*RGB565 with SSE2 intrinsics, 8 pixels at a time*/
+extern const lv_draw_sw_blend_kernels_t lv_draw_sw_blend_kernels_sse2;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_KERNELS_H*/
@@ -19,13 +19,27 @@
  *********************/
 #define MAX_BUF_SIZE (uint32_t) lv_disp_get_hor_res(_lv_refr_get_disp_refreshing())
 
+/*Smaller images are drawn at once, handing them to a worker would take longer*/
+#define IMG_BANDS_MIN_PX   (2 * 1024)
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+typedef struct {
+    const lv_draw_img_dsc_t * draw_dsc;
+    const lv_area_t * coords;
+    const uint8_t * src_buf;
+    lv_img_cf_t cf;
+    bool mask_any;
+    bool transform;
+    uint32_t buf_h;
+} img_band_dsc_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static void img_band_cb(lv_draw_ctx_t * draw_ctx, void * scratch, void * user_data);
 static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coord_t src_w, lv_coord_t src_h,
                        lv_coord_t src_stride, const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf);
 
@@ -96,20 +110,12 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
 #endif
     /*In the other cases every pixel need to be checked one-by-one*/
     else {
-        blend_area.x1 = draw_ctx->clip_area->x1;
-        blend_area.x2 = draw_ctx->clip_area->x2;
-        blend_area.y1 = draw_ctx->clip_area->y1;
-        blend_area.y2 = draw_ctx->clip_area->y2;
-
-        lv_coord_t src_w = lv_area_get_width(coords);
-        lv_coord_t src_h = lv_area_get_height(coords);
-        lv_coord_t blend_h = lv_area_get_height(&blend_area);
-        lv_coord_t blend_w = lv_area_get_width(&blend_area);
+        lv_coord_t blend_h = lv_area_get_height(draw_ctx->clip_area);
+        lv_coord_t blend_w = lv_area_get_width(draw_ctx->clip_area);
 
         uint32_t max_buf_size = MAX_BUF_SIZE;
-        uint32_t blend_size = lv_area_get_size(&blend_area);
+        uint32_t blend_size = lv_area_get_size(draw_ctx->clip_area);
         uint32_t buf_h;
-        uint32_t buf_w = blend_w;
         if(blend_size <= max_buf_size) {
             buf_h = blend_h;
         }
@@ -118,87 +124,120 @@ void LV_ATTRIBUTE_FAST_MEM lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
             buf_h = max_buf_size / blend_w;
         }
 
-        /*Create buffers and masks*/
-        uint32_t buf_size = buf_w * buf_h;
+        img_band_dsc_t band_dsc;
+        band_dsc.draw_dsc = draw_dsc;
+        band_dsc.coords = coords;
+        band_dsc.src_buf = src_buf;
+        band_dsc.cf = cf;
+        band_dsc.mask_any = mask_any;
+        band_dsc.transform = transform;
+        band_dsc.buf_h = buf_h;
+
+        /*Every band converts its rows into its own buffers*/
+        uint32_t scratch_size = blend_w * buf_h * (sizeof(lv_color_t) + sizeof(lv_opa_t));
+        lv_draw_sw_bands_draw(draw_ctx, draw_ctx->clip_area, IMG_BANDS_MIN_PX, scratch_size, img_band_cb, &band_dsc);
+    }
+}
 
-        lv_color_t * rgb_buf = lv_mem_buf_get(buf_size * sizeof(lv_color_t));
-        lv_opa_t * mask_buf = lv_mem_buf_get(buf_size);
-        blend_dsc.mask_buf = mask_buf;
-        blend_dsc.mask_area = &blend_area;
-        blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
-        blend_dsc.src_buf = rgb_buf;
-        lv_coord_t y_last = blend_area.y2;
-        blend_area.y2 = blend_area.y1 + buf_h - 1;
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
 
-        lv_draw_mask_res_t mask_res_def = (cf != LV_IMG_CF_TRUE_COLOR || draw_dsc->angle ||
-                                           draw_dsc->zoom != LV_IMG_ZOOM_NONE) ?
-                                          LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
-        blend_dsc.mask_res = mask_res_def;
-
-        while(blend_area.y1 <= y_last) {
-            /*Apply transformations if any or separate the channels*/
-            lv_area_t transform_area;
-            lv_area_copy(&transform_area, &blend_area);
-            lv_area_move(&transform_area, -coords->x1, -coords->y1);
-            if(transform) {
-                lv_draw_transform(draw_ctx, &transform_area, src_buf, src_w, src_h, src_w,
-                                  draw_dsc, cf, rgb_buf, mask_buf);
-            }
-            else {
-                convert_cb(&transform_area, src_buf, src_w, src_h, src_w, draw_dsc, cf, rgb_buf, mask_buf);
-            }
+/*Transform or convert, recolor, mask and blend the rows of the image in `draw_ctx->clip_area`*/
+static void LV_ATTRIBUTE_FAST_MEM img_band_cb(lv_draw_ctx_t * draw_ctx, void * scratch, void * user_data)
+{
+    img_band_dsc_t * band_dsc = user_data;
+    const lv_draw_img_dsc_t * draw_dsc = band_dsc->draw_dsc;
+    const lv_area_t * coords = band_dsc->coords;
+    const uint8_t * src_buf = band_dsc->src_buf;
+    lv_img_cf_t cf = band_dsc->cf;
 
-            /*Apply recolor*/
-            if(draw_dsc->recolor_opa > LV_OPA_MIN) {
-                uint16_t premult_v[3];
-                lv_opa_t recolor_opa = draw_dsc->recolor_opa;
-                lv_color_t recolor = draw_dsc->recolor;
-                lv_color_premult(recolor, recolor_opa, premult_v);
-                recolor_opa = 255 - recolor_opa;
-                uint32_t i;
-                for(i = 0; i < buf_size; i++) {
-                    rgb_buf[i] = lv_color_mix_premult(premult_v, rgb_buf[i], recolor_opa);
-                }
+    lv_area_t blend_area;
+    lv_area_copy(&blend_area, draw_ctx->clip_area);
+
+    lv_coord_t src_w = lv_area_get_width(coords);
+    lv_coord_t src_h = lv_area_get_height(coords);
+    lv_coord_t blend_w = lv_area_get_width(&blend_area);
+
+    uint32_t buf_h = LV_MIN(band_dsc->buf_h, (uint32_t)lv_area_get_height(&blend_area));
+    uint32_t buf_size = blend_w * buf_h;
+
+    uint8_t * mem = scratch;
+    lv_color_t * rgb_buf = (lv_color_t *)mem;
+    lv_opa_t * mask_buf = mem + buf_size * sizeof(lv_color_t);
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(lv_draw_sw_blend_dsc_t));
+    blend_dsc.opa = draw_dsc->opa;
+    blend_dsc.blend_mode = draw_dsc->blend_mode;
+    blend_dsc.blend_area = &blend_area;
+    blend_dsc.mask_buf = mask_buf;
+    blend_dsc.mask_area = &blend_area;
+    blend_dsc.src_buf = rgb_buf;
+    lv_coord_t y_last = blend_area.y2;
+    blend_area.y2 = blend_area.y1 + buf_h - 1;
+
+    lv_draw_mask_res_t mask_res_def = (cf != LV_IMG_CF_TRUE_COLOR || draw_dsc->angle ||
+                                       draw_dsc->zoom != LV_IMG_ZOOM_NONE) ?
+                                      LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    blend_dsc.mask_res = mask_res_def;
+
+    while(blend_area.y1 <= y_last) {
+        /*Apply transformations if any or separate the channels*/
+        lv_area_t transform_area;
+        lv_area_copy(&transform_area, &blend_area);
+        lv_area_move(&transform_area, -coords->x1, -coords->y1);
+        if(band_dsc->transform) {
+            lv_draw_transform(draw_ctx, &transform_area, src_buf, src_w, src_h, src_w,
+                              draw_dsc, cf, rgb_buf, mask_buf);
+        }
+        else {
+            convert_cb(&transform_area, src_buf, src_w, src_h, src_w, draw_dsc, cf, rgb_buf, mask_buf);
+        }
+
+        /*Apply recolor*/
+        if(draw_dsc->recolor_opa > LV_OPA_MIN) {
+            uint16_t premult_v[3];
+            lv_opa_t recolor_opa = draw_dsc->recolor_opa;
+            lv_color_t recolor = draw_dsc->recolor;
+            lv_color_premult(recolor, recolor_opa, premult_v);
+            recolor_opa = 255 - recolor_opa;
+            uint32_t i;
+            for(i = 0; i < buf_size; i++) {
+                rgb_buf[i] = lv_color_mix_premult(premult_v, rgb_buf[i], recolor_opa);
             }
+        }
 #if LV_DRAW_COMPLEX
-            /*Apply the masks if any*/
-            if(mask_any) {
-                lv_coord_t y;
-                lv_opa_t * mask_buf_tmp = mask_buf;
-                for(y = blend_area.y1; y <= blend_area.y2; y++) {
-                    lv_draw_mask_res_t mask_res_line;
-                    mask_res_line = lv_draw_mask_apply(mask_buf_tmp, blend_area.x1, y, blend_w);
-
-                    if(mask_res_line == LV_DRAW_MASK_RES_TRANSP) {
-                        lv_memset_00(mask_buf_tmp, blend_w);
-                        blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
-                    }
-                    else if(mask_res_line == LV_DRAW_MASK_RES_CHANGED) {
-                        blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
-                    }
-                    mask_buf_tmp += blend_w;
+        /*Apply the masks if any*/
+        if(band_dsc->mask_any) {
+            lv_coord_t y;
+            lv_opa_t * mask_buf_tmp = mask_buf;
+            for(y = blend_area.y1; y <= blend_area.y2; y++) {
+                lv_draw_mask_res_t mask_res_line;
+                mask_res_line = lv_draw_mask_apply(mask_buf_tmp, blend_area.x1, y, blend_w);
+
+                if(mask_res_line == LV_DRAW_MASK_RES_TRANSP) {
+                    lv_memset_00(mask_buf_tmp, blend_w);
+                    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+                }
+                else if(mask_res_line == LV_DRAW_MASK_RES_CHANGED) {
+                    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
                 }
+                mask_buf_tmp += blend_w;
             }
+        }
 #endif
 
-            /*Blend*/
-            lv_draw_sw_blend(draw_ctx, &blend_dsc);
-
-            /*Go the the next lines*/
-            blend_area.y1 = blend_area.y2 + 1;
-            blend_area.y2 = blend_area.y1 + buf_h - 1;
-            if(blend_area.y2 > y_last) blend_area.y2 = y_last;
-        }
+        /*Blend*/
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
 
-        lv_mem_buf_release(mask_buf);
-        lv_mem_buf_release(rgb_buf);
+        /*Go the the next lines*/
+        blend_area.y1 = blend_area.y2 + 1;
+        blend_area.y2 = blend_area.y1 + buf_h - 1;
+        if(blend_area.y2 > y_last) blend_area.y2 = y_last;
     }
 }
 
-/**********************
- *   STATIC FUNCTIONS
- **********************/
-
 /* Separate the image channels to RGB and Alpha to match LV_COLOR_DEPTH settings*/
 static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coord_t src_w, lv_coord_t src_h,
                        lv_coord_t src_stride, const lv_draw_img_dsc_t * draw_dsc, lv_img_cf_t cf, lv_color_t * cbuf, lv_opa_t * abuf)
@@ -209,7 +248,6 @@ static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coo
 
     const uint8_t * src_tmp8 = (const uint8_t *)src_buf;
     lv_coord_t y;
-    lv_coord_t x;
 
     if(cf == LV_IMG_CF_TRUE_COLOR || cf == LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED) {
         uint32_t px_cnt = lv_area_get_size(dest_area);
@@ -254,23 +292,12 @@ static void convert_cb(const lv_area_t * dest_area, const void * src_buf, lv_coo
 
         lv_coord_t dest_h = lv_area_get_height(dest_area);
         lv_coord_t dest_w = lv_area_get_width(dest_area);
+        const lv_draw_sw_blend_kernels_t * k = lv_draw_sw_blend_get_kernels();
         for(y = 0; y < dest_h; y++) {
-            for(x = 0; x < dest_w; x++) {
-                abuf[x] = src_tmp8[LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
-#if LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-                cbuf[x].full = *src_tmp8;
-#elif LV_COLOR_DEPTH == 16
-                cbuf[x].full = *src_tmp8 + ((*(src_tmp8 + 1)) << 8);
-#elif LV_COLOR_DEPTH == 32
-                cbuf[x] = *((lv_color_t *) src_tmp8);
-                cbuf[x].ch.alpha = 0xff;
-#endif
-                src_tmp8 += LV_IMG_PX_SIZE_ALPHA_BYTE;
-
-            }
+            k->argb_split(cbuf, abuf, src_tmp8, dest_w);
             cbuf += dest_w;
             abuf += dest_w;
-            src_tmp8 += src_new_line_step_byte;
+            src_tmp8 += dest_w * LV_IMG_PX_SIZE_ALPHA_BYTE + src_new_line_step_byte;
         }
     }
     else if(cf == LV_IMG_CF_RGB565A8) {
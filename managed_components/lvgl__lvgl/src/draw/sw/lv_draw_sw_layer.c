@@ -85,6 +85,8 @@ struct _lv_draw_layer_ctx_t * lv_draw_sw_layer_create(struct _lv_draw_ctx_t * dr
 
         lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
         disp_refr->driver->screen_transp = flags & LV_DRAW_LAYER_FLAG_HAS_ALPHA ? 1 : 0;
+        /*The layer's buffer is never rotated, only the result is blended rotated*/
+        disp_refr->driver->render_rotated = 0;
     }
 
     return layer_ctx;
@@ -105,6 +107,7 @@ void lv_draw_sw_layer_adjust(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_l
         layer_sw_ctx->has_alpha = 0;
         disp_refr->driver->screen_transp = 0;
     }
+    disp_refr->driver->render_rotated = 0;
 
     draw_ctx->buf = layer_ctx->buf;
     draw_ctx->buf_area = &layer_ctx->area_act;
@@ -129,6 +132,7 @@ void lv_draw_sw_layer_blend(struct _lv_draw_ctx_t * draw_ctx, struct _lv_draw_la
     draw_ctx->clip_area = layer_ctx->original.clip_area;
     lv_disp_t * disp_refr = _lv_refr_get_disp_refreshing();
     disp_refr->driver->screen_transp = layer_ctx->original.screen_transp;
+    disp_refr->driver->render_rotated = layer_ctx->original.render_rotated;
 
     /*Blend the layer*/
     lv_draw_img(draw_ctx, draw_dsc, &layer_ctx->area_act, &img);
@@ -13,6 +13,7 @@
 #include "../../misc/lv_area.h"
 #include "../../misc/lv_style.h"
 #include "../../font/lv_font.h"
+#include "../../font/lv_glyph_cache.h"
 #include "../../core/lv_refr.h"
 
 /*********************
@@ -30,6 +31,9 @@
 static void /* LV_ATTRIBUTE_FAST_MEM */ draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                            const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 
+static void /* LV_ATTRIBUTE_FAST_MEM */ draw_letter_a8(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                       const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const lv_opa_t * map_p);
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p);
@@ -95,7 +99,13 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
                        uint32_t letter)
 {
     lv_font_glyph_dsc_t g;
-    bool g_ret = lv_font_get_glyph_dsc(dsc->font, &g, letter, '\0');
+
+    /*Use the unpacked glyph if it's cached*/
+    const _lv_glyph_cache_entry_t * cached = _lv_glyph_cache_get(dsc->font, letter);
+    bool g_ret = true;
+    if(cached) g = cached->dsc;
+    else g_ret = lv_font_get_glyph_dsc(dsc->font, &g, letter, '\0');
+
     if(g_ret == false) {
         /*Add warning if the dsc is not found
          *but do not print warning for non printable ASCII chars (e.g. '\n')*/
@@ -139,6 +149,11 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
         return;
     }
 
+    if(cached) {
+        draw_letter_a8(draw_ctx, dsc, &gpos, &g, cached->map);
+        return;
+    }
+
     const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
@@ -350,6 +365,127 @@ static void LV_ATTRIBUTE_FAST_MEM draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     lv_mem_buf_release(mask_buf);
 }
 
+/**
+ * Draw a letter from an unpacked glyph of the glyph cache.
+ * The glyph already has 8 bit opacities so it can be used as a mask directly.
+ */
+static void LV_ATTRIBUTE_FAST_MEM draw_letter_a8(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                 const lv_point_t * pos, const lv_font_glyph_dsc_t * g, const lv_opa_t * map_p)
+{
+    int32_t box_w = g->box_w;
+    int32_t box_h = g->box_h;
+    lv_opa_t opa = dsc->opa;
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+    lv_area_t fill_area;
+    fill_area.x1 = pos->x;
+    fill_area.x2 = pos->x + box_w - 1;
+    fill_area.y1 = pos->y;
+    fill_area.y2 = pos->y + box_h - 1;
+
+#if LV_DRAW_COMPLEX
+    bool mask_any = lv_draw_mask_is_any(&fill_area);
+#else
+    bool mask_any = false;
+#endif
+
+    /*Blend the whole glyph at once. The blending clips it.
+     *It's not possible if the mask needs to be modified:
+     *other masks are applied, the opacity is remapped or rounded for the disabled anti-aliasing*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(!mask_any && opa >= LV_OPA_MAX && disp->driver->antialiasing) {
+        blend_dsc.blend_area = &fill_area;
+        blend_dsc.mask_area = &fill_area;
+        blend_dsc.mask_buf = (lv_opa_t *)map_p;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        return;
+    }
+
+    static lv_opa_t opa_table[256];
+    static lv_opa_t prev_opa = LV_OPA_TRANSP;
+    if(opa < LV_OPA_MAX && prev_opa != opa) {
+        uint32_t i;
+        for(i = 0; i < 256; i++) {
+            opa_table[i] = i == LV_OPA_COVER ? opa : ((i * opa) >> 8);
+        }
+        prev_opa = opa;
+    }
+
+    /*Calculate the col/row start/end on the map*/
+    int32_t col_start = pos->x >= draw_ctx->clip_area->x1 ? 0 : draw_ctx->clip_area->x1 - pos->x;
+    int32_t col_end   = pos->x + box_w <= draw_ctx->clip_area->x2 ? box_w : draw_ctx->clip_area->x2 - pos->x + 1;
+    int32_t row_start = pos->y >= draw_ctx->clip_area->y1 ? 0 : draw_ctx->clip_area->y1 - pos->y;
+    int32_t row_end   = pos->y + box_h <= draw_ctx->clip_area->y2 ? box_h : draw_ctx->clip_area->y2 - pos->y + 1;
+    int32_t fill_w = col_end - col_start;
+
+    lv_coord_t hor_res = lv_disp_get_hor_res(disp);
+    uint32_t mask_buf_size = box_w * box_h > hor_res ? hor_res : box_w * box_h;
+    lv_opa_t * mask_buf = lv_mem_buf_get(mask_buf_size);
+    blend_dsc.mask_buf = mask_buf;
+    int32_t mask_p = 0;
+
+    fill_area.x1 = col_start + pos->x;
+    fill_area.x2 = col_end  + pos->x - 1;
+    fill_area.y1 = row_start + pos->y;
+    fill_area.y2 = fill_area.y1;
+    blend_dsc.blend_area = &fill_area;
+    blend_dsc.mask_area = &fill_area;
+
+    map_p += row_start * box_w + col_start;
+
+    int32_t row;
+    for(row = row_start ; row < row_end; row++) {
+        if(opa < LV_OPA_MAX) {
+            int32_t col;
+            for(col = 0; col < fill_w; col++) {
+                mask_buf[mask_p + col] = opa_table[map_p[col]];
+            }
+        }
+        else {
+            lv_memcpy_small(mask_buf + mask_p, map_p, fill_w);
+        }
+
+#if LV_DRAW_COMPLEX
+        /*Apply masks if any*/
+        if(mask_any) {
+            blend_dsc.mask_res = lv_draw_mask_apply(mask_buf + mask_p, fill_area.x1, fill_area.y2, fill_w);
+            if(blend_dsc.mask_res == LV_DRAW_MASK_RES_TRANSP) {
+                lv_memset_00(mask_buf + mask_p, fill_w);
+            }
+        }
+#endif
+        mask_p += fill_w;
+        map_p += box_w;
+
+        if((uint32_t) mask_p + fill_w < mask_buf_size) {
+            fill_area.y2 ++;
+        }
+        else {
+            blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+            lv_draw_sw_blend(draw_ctx, &blend_dsc);
+
+            fill_area.y1 = fill_area.y2 + 1;
+            fill_area.y2 = fill_area.y1;
+            mask_p = 0;
+        }
+    }
+
+    /*Flush the last part*/
+    if(fill_area.y1 != fill_area.y2) {
+        fill_area.y2--;
+        blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+
+    lv_mem_buf_release(mask_buf);
+}
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p)
@@ -419,14 +555,12 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
 
     lv_color_t * color_buf = lv_mem_buf_get(mask_buf_size * sizeof(lv_color_t));
 
-    int32_t dest_buf_stride = lv_area_get_width(draw_ctx->buf_area);
-    lv_color_t * dest_buf_tmp = draw_ctx->buf;
-
-    /*Set a pointer on draw_buf to the first pixel of the letter*/
-    dest_buf_tmp += ((pos->y - draw_ctx->buf_area->y1) * dest_buf_stride) + pos->x - draw_ctx->buf_area->x1;
-
-    /*If the letter is partially out of mask the move there on draw_buf*/
-    dest_buf_tmp += (row_start * dest_buf_stride) + col_start / 3;
+    /*Set a pointer on draw_buf to the first pixel of the letter.
+     *If the letter is partially out of mask the move there on draw_buf*/
+    int32_t dest_px_step;
+    int32_t dest_line_step;
+    lv_color_t * dest_buf_tmp = lv_draw_sw_get_buf_px(draw_ctx, pos->x + col_start / 3, pos->y + row_start,
+                                                      &dest_px_step, &dest_line_step);
 
     lv_area_t mask_area;
     lv_area_copy(&mask_area, &map_area);
@@ -513,7 +647,7 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
 
                 /*Next mask byte*/
                 mask_p++;
-                dest_buf_tmp++;
+                dest_buf_tmp += dest_px_step;
             }
 
             /*Go to the next column*/
@@ -555,7 +689,7 @@ static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_
         col_bit = col_bit & 0x7;
 
         /*Next row in draw_buf*/
-        dest_buf_tmp += dest_buf_stride - (col_end - col_start) / 3;
+        dest_buf_tmp += dest_line_step - dest_px_step * ((col_end - col_start) / 3);
     }
 
     /*Flush the last part*/
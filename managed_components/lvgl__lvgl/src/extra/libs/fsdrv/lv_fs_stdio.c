@@ -75,6 +75,7 @@ void lv_fs_stdio_init(void)
     /*Set up fields...*/
     fs_drv.letter = LV_FS_STDIO_LETTER;
     fs_drv.cache_size = LV_FS_STDIO_CACHE_SIZE;
+    fs_drv.block_cache = true;
 
     fs_drv.open_cb = fs_open;
     fs_drv.close_cb = fs_close;
@@ -2,6 +2,7 @@
 #include "../../../misc/lv_log.h"
 #include "../../../misc/lv_mem.h"
 #include "../../../misc/lv_color.h"
+#include "../../../draw/lv_img_buf.h"
 #if LV_USE_GIF
 
 #include <stdlib.h>
@@ -23,11 +24,25 @@ typedef struct Table {
     Entry *entries;
 } Table;
 
+/* Size of the window the LZW data of file sources is read through. */
+#define READ_BUF_SIZE 512
+
+/* Buffered reader of the LZW data of an image. */
+typedef struct Reader {
+    const uint8_t *p, *end; /* Unread bytes of the window. */
+    size_t left;            /* Bytes of the image data after the window. */
+    uint8_t *buf;           /* Window of file sources. */
+    uint8_t sub_len;        /* Bytes left in the current sub-block. */
+    uint32_t bits;          /* Bits read but not used yet. */
+    int nbits;
+} Reader;
+
 static gd_GIF *  gif_open(gd_GIF * gif);
 static bool f_gif_open(gd_GIF * gif, const void * path, bool is_file);
 static void f_gif_read(gd_GIF * gif, void * buf, size_t len);
 static int f_gif_seek(gd_GIF * gif, size_t pos, int k);
 static void f_gif_close(gd_GIF * gif);
+static void discard_sub_blocks(gd_GIF *gif);
 
 static uint16_t
 read_num(gd_GIF * gif)
@@ -65,14 +80,116 @@ gd_open_gif_data(const void *data)
     return gif_open(&gif_base);
 }
 
+/* Convert a palette entry to the display's color format. */
+static lv_color_t
+palette_color(const uint8_t *color)
+{
+#if LV_COLOR_DEPTH == 1
+    lv_color_t c;
+    c.full = ((*(color + 0)) | (*(color + 1)) | (*(color + 2))) > 128 ? 1 : 0;
+    return c;
+#else
+    return lv_color_make(*(color + 0), *(color + 1), *(color + 2));
+#endif
+}
+
+/* Convert the current palette unless it was already done. The LCT can
+ * change with each frame, so it's always converted. */
+static void
+update_lut(gd_GIF *gif)
+{
+    int i;
+
+    if (gif->lut_palette == gif->palette && gif->palette == &gif->gct)
+        return;
+    for (i = 0; i < 0x100; i++)
+        gif->lut[i] = palette_color(&gif->palette->colors[i*3]);
+    gif->lut_palette = gif->palette;
+}
+
+/* Store the i-th pixel of a canvas. Opaque canvases have no alpha byte.
+ * Return 1 if the pixel was changed. */
+static inline int
+set_pixel(gd_GIF *gif, uint8_t *buffer, int i, lv_color_t c, uint8_t opa)
+{
+    if (gif->opaque) {
+        lv_color_t *px = &((lv_color_t *) buffer)[i];
+        if (px->full == c.full) return 0;
+        *px = c;
+    } else {
+        uint8_t *px = &buffer[i * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        if (px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] == opa &&
+            memcmp(px, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1) == 0) return 0;
+        memcpy(px, &c, LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+        px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = opa;
+    }
+    return 1;
+}
+
+/* Add a pixel to the changed rectangle of the canvas. */
+static void
+mark_changed(gd_GIF *gif, uint16_t x, uint16_t y)
+{
+    if (!gif->changed) {
+        gif->cx1 = gif->cx2 = x;
+        gif->cy1 = gif->cy2 = y;
+        gif->changed = 1;
+        return;
+    }
+    gif->cx1 = MIN(gif->cx1, x);
+    gif->cy1 = MIN(gif->cy1, y);
+    gif->cx2 = MAX(gif->cx2, x);
+    gif->cy2 = MAX(gif->cy2, y);
+}
+
+/* Scan the blocks after the GCT. Return 1 if a frame is restored to a
+ * transparent background, i.e. the canvas needs an alpha channel.
+ * Transparent pixels of other frames leave the canvas unchanged. */
+static int
+has_transparent_bg(gd_GIF *gif)
+{
+    uint8_t sep, label, size, rdit, fisrz;
+
+    for (;;) {
+        f_gif_read(gif, &sep, 1);
+        if (sep == '!') {
+            f_gif_read(gif, &label, 1);
+            if (label == 0xF9) {
+                f_gif_read(gif, &size, 1);
+                f_gif_read(gif, &rdit, 1);
+                if (((rdit >> 2) & 3) == 2 && (rdit & 1))
+                    return 1;
+                f_gif_seek(gif, size - 1, LV_FS_SEEK_CUR);
+            }
+            discard_sub_blocks(gif);
+        } else if (sep == ',') {
+            /* Skip the position and size. */
+            f_gif_seek(gif, 8, LV_FS_SEEK_CUR);
+            f_gif_read(gif, &fisrz, 1);
+            if (fisrz & 0x80)
+                f_gif_seek(gif, 3 * (1 << ((fisrz & 0x07) + 1)), LV_FS_SEEK_CUR);
+            /* Skip the LZW minimum code size. */
+            f_gif_seek(gif, 1, LV_FS_SEEK_CUR);
+            discard_sub_blocks(gif);
+        } else if (sep == ';') {
+            return 0;
+        } else {
+            /* Unknown block, don't assume anything. */
+            return 1;
+        }
+    }
+}
+
 static gd_GIF * gif_open(gd_GIF * gif_base)
 {
     uint8_t sigver[3];
     uint16_t width, height, depth;
     uint8_t fdsz, bgidx, aspect;
     int i;
-    uint8_t *bgcolor;
+    lv_color_t bgcolor;
     int gct_sz;
+    size_t gct_pos, px_size;
+    uint8_t opaque;
     gd_GIF *gif = NULL;
 
     /* Header */
@@ -106,59 +223,35 @@ static gd_GIF * gif_open(gd_GIF * gif_base)
     f_gif_read(gif_base, &bgidx, 1);
     /* Aspect Ratio */
     f_gif_read(gif_base, &aspect, 1);
+    /* Look ahead whether the canvas can become transparent. */
+    gct_pos = f_gif_seek(gif_base, 0, LV_FS_SEEK_CUR);
+    f_gif_seek(gif_base, gct_pos + 3 * gct_sz, LV_FS_SEEK_SET);
+    opaque = !has_transparent_bg(gif_base);
+    f_gif_seek(gif_base, gct_pos, LV_FS_SEEK_SET);
+    px_size = opaque ? sizeof(lv_color_t) : LV_IMG_PX_SIZE_ALPHA_BYTE;
     /* Create gd_GIF Structure. */
-#if LV_COLOR_DEPTH == 32
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 5 * width * height);
-#elif LV_COLOR_DEPTH == 16
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 4 * width * height);
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif = lv_mem_alloc(sizeof(gd_GIF) + 3 * width * height);
-#endif
-
+    gif = lv_mem_alloc(sizeof(gd_GIF) + (px_size + 1) * width * height);
     if (!gif) goto fail;
     memcpy(gif, gif_base, sizeof(gd_GIF));
     gif->width  = width;
     gif->height = height;
     gif->depth  = depth;
+    gif->opaque = opaque;
     /* Read GCT */
     gif->gct.size = gct_sz;
     f_gif_read(gif, gif->gct.colors, 3 * gif->gct.size);
     gif->palette = &gif->gct;
     gif->bgindex = bgidx;
     gif->canvas = (uint8_t *) &gif[1];
-#if LV_COLOR_DEPTH == 32
-    gif->frame = &gif->canvas[4 * width * height];
-#elif LV_COLOR_DEPTH == 16
-    gif->frame = &gif->canvas[3 * width * height];
-#elif LV_COLOR_DEPTH == 8 || LV_COLOR_DEPTH == 1
-    gif->frame = &gif->canvas[2 * width * height];
-#endif
+    gif->frame = &gif->canvas[px_size * width * height];
     if (gif->bgindex) {
         memset(gif->frame, gif->bgindex, gif->width * gif->height);
     }
-    bgcolor = &gif->palette->colors[gif->bgindex*3];
-
-    for (i = 0; i < gif->width * gif->height; i++) {
-#if LV_COLOR_DEPTH == 32
-        gif->canvas[i*4 + 0] = *(bgcolor + 2);
-        gif->canvas[i*4 + 1] = *(bgcolor + 1);
-        gif->canvas[i*4 + 2] = *(bgcolor + 0);
-        gif->canvas[i*4 + 3] = 0xff;
-#elif LV_COLOR_DEPTH == 16
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*3 + 0] = c.full & 0xff;
-        gif->canvas[i*3 + 1] = (c.full >> 8) & 0xff;
-        gif->canvas[i*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.full;
-        gif->canvas[i*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-        lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-        gif->canvas[i*2 + 0] = c.ch.red > 128 ? 1 : 0;
-        gif->canvas[i*2 + 1] = 0xff;
-#endif
-    }
+    update_lut(gif);
+    bgcolor = gif->lut[gif->bgindex];
+
+    for (i = 0; i < gif->width * gif->height; i++)
+        set_pixel(gif, gif->canvas, i, bgcolor, 0xff);
     gif->anim_start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     gif->loop_count = -1;
     goto ok;
@@ -334,32 +427,51 @@ add_entry(Table **tablep, uint16_t length, uint16_t prefix, uint8_t suffix)
     return 0;
 }
 
-static uint16_t
-get_key(gd_GIF *gif, int key_size, uint8_t *sub_len, uint8_t *shift, uint8_t *byte)
+/* Refill the window of a file source.
+ * Return 0 if there is no more image data. */
+static int
+fill_window(gd_GIF *gif, Reader *r)
+{
+    size_t len;
+
+    if (!r->left) return 0;
+    len = MIN(r->left, READ_BUF_SIZE);
+    f_gif_read(gif, r->buf, len);
+    r->p = r->buf;
+    r->end = r->buf + len;
+    r->left -= len;
+    return 1;
+}
+
+static inline int
+read_byte(gd_GIF *gif, Reader *r)
+{
+    if (r->p == r->end && !fill_window(gif, r)) return -1;
+    return *r->p++;
+}
+
+/* Return the next key or 0x1000 at the end of the image data. */
+static inline uint16_t
+get_key(gd_GIF *gif, Reader *r, int key_size)
 {
-    int bits_read;
-    int rpad;
-    int frag_size;
+    int byte;
     uint16_t key;
 
-    key = 0;
-    for (bits_read = 0; bits_read < key_size; bits_read += frag_size) {
-        rpad = (*shift + bits_read) % 8;
-        if (rpad == 0) {
-            /* Update byte. */
-            if (*sub_len == 0) {
-                f_gif_read(gif, sub_len, 1); /* Must be nonzero! */
-                if (*sub_len == 0) return 0x1000;
-            }
-            f_gif_read(gif, byte, 1);
-            (*sub_len)--;
+    while (r->nbits < key_size) {
+        if (r->sub_len == 0) {
+            byte = read_byte(gif, r); /* Must be nonzero! */
+            if (byte <= 0) return 0x1000;
+            r->sub_len = byte;
         }
-        frag_size = MIN(key_size - bits_read, 8 - rpad);
-        key |= ((uint16_t) ((*byte) >> rpad)) << bits_read;
+        byte = read_byte(gif, r);
+        if (byte < 0) return 0x1000;
+        r->sub_len--;
+        r->bits |= (uint32_t) byte << r->nbits;
+        r->nbits += 8;
     }
-    /* Clear extra bits to the left. */
-    key &= (1 << key_size) - 1;
-    *shift = (*shift + key_size) % 8;
+    key = r->bits & ((1 << key_size) - 1);
+    r->bits >>= key_size;
+    r->nbits -= key_size;
     return key;
 }
 
@@ -390,13 +502,15 @@ interlaced_line_index(int h, int y)
 static int
 read_image_data(gd_GIF *gif, int interlace)
 {
-    uint8_t sub_len, shift, byte;
+    uint8_t byte;
     int init_key_size, key_size, table_is_full=0;
-    int frm_off, frm_size, str_len=0, i, p, x, y;
+    int frm_off, frm_size, str_len=0, i, x, y, ex, ey;
     uint16_t key, clear, stop;
     int ret;
     Table *table;
     Entry entry = {0};
+    Reader r = {0};
+    uint32_t *row_off;
     size_t start, end;
 
     f_gif_read(gif, &byte, 1);
@@ -404,15 +518,33 @@ read_image_data(gd_GIF *gif, int interlace)
     start = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
     discard_sub_blocks(gif);
     end = f_gif_seek(gif, 0, LV_FS_SEEK_CUR);
-    f_gif_seek(gif, start, LV_FS_SEEK_SET);
+    /* Offset of the frame rows in the canvas, in the order they are stored. */
+    row_off = lv_mem_alloc(gif->fh * sizeof(uint32_t) + (gif->is_file ? READ_BUF_SIZE : 0));
+    if (!row_off) return -1;
+    for (y = 0; y < gif->fh; y++)
+        row_off[y] = (gif->fy + (interlace ? interlaced_line_index((int) gif->fh, y) : y)) * gif->width + gif->fx;
+    if (gif->is_file) {
+        f_gif_seek(gif, start, LV_FS_SEEK_SET);
+        r.buf = (uint8_t *) &row_off[gif->fh];
+        r.p = r.end = r.buf;
+        r.left = end - start;
+    } else {
+        /* Decode straight from the source data. */
+        r.p = (const uint8_t *) &gif->data[start];
+        r.end = (const uint8_t *) &gif->data[end];
+    }
     clear = 1 << key_size;
     stop = clear + 1;
     table = new_table(key_size);
+    if (!table) {
+        lv_mem_free(row_off);
+        return -1;
+    }
     key_size++;
     init_key_size = key_size;
-    sub_len = shift = 0;
-    key = get_key(gif, key_size, &sub_len, &shift, &byte); /* clear code */
+    key = get_key(gif, &r, key_size); /* clear code */
     frm_off = 0;
+    x = y = 0;
     ret = 0;
     frm_size = gif->fw*gif->fh;
     while (frm_off < frm_size) {
@@ -424,6 +556,7 @@ read_image_data(gd_GIF *gif, int interlace)
             ret = add_entry(&table, str_len + 1, key, entry.suffix);
             if (ret == -1) {
                 lv_mem_free(table);
+                lv_mem_free(row_off);
                 return -1;
             }
             if (table->nentries == 0x1000) {
@@ -431,30 +564,43 @@ read_image_data(gd_GIF *gif, int interlace)
                 table_is_full = 1;
             }
         }
-        key = get_key(gif, key_size, &sub_len, &shift, &byte);
+        key = get_key(gif, &r, key_size);
         if (key == clear) continue;
         if (key == stop || key == 0x1000) break;
         if (ret == 1) key_size++;
         entry = table->entries[key];
         str_len = entry.length;
+        /* The string is stored backwards from its last pixel. */
+        ex = x + str_len - 1;
+        ey = y;
+        while (ex >= gif->fw) {
+            ex -= gif->fw;
+            ey++;
+        }
+        x = ex + 1;
+        y = ey;
+        if (x == gif->fw) {
+            x = 0;
+            y++;
+        }
         for (i = 0; i < str_len; i++) {
-            p = frm_off + entry.length - 1;
-            x = p % gif->fw;
-            y = p / gif->fw;
-            if (interlace)
-                y = interlaced_line_index((int) gif->fh, y);
-            gif->frame[(gif->fy + y) * gif->width + gif->fx + x] = entry.suffix;
+            if ((unsigned) ey < gif->fh)
+                gif->frame[row_off[ey] + ex] = entry.suffix;
             if (entry.prefix == 0xFFF)
                 break;
             else
                 entry = table->entries[entry.prefix];
+            if (ex-- == 0) {
+                ex = gif->fw - 1;
+                ey--;
+            }
         }
         frm_off += str_len;
         if (key < table->nentries - 1 && !table_is_full)
             table->entries[table->nentries - 1].suffix = entry.suffix;
     }
     lv_mem_free(table);
-    if (key == stop) f_gif_read(gif, &sub_len, 1); /* Must be zero! */
+    lv_mem_free(row_off);
     f_gif_seek(gif, end, LV_FS_SEEK_SET);
     return 0;
 }
@@ -483,6 +629,8 @@ read_image(gd_GIF *gif)
         gif->palette = &gif->lct;
     } else
         gif->palette = &gif->gct;
+    update_lut(gif);
+    gif->rendered = 0;
     /* Image Data. */
     return read_image_data(gif, interlace);
 }
@@ -490,35 +638,27 @@ read_image(gd_GIF *gif)
 static void
 render_frame_rect(gd_GIF *gif, uint8_t *buffer)
 {
-    int i, j, k;
-    uint8_t index, *color;
+    int i, j, k, x1, x2;
+    int transparency = gif->gce.transparency;
+    uint8_t tindex = gif->gce.tindex;
+    const uint8_t *index;
+
     i = gif->fy * gif->width + gif->fx;
     for (j = 0; j < gif->fh; j++) {
+        index = &gif->frame[i];
+        x1 = x2 = -1;
         for (k = 0; k < gif->fw; k++) {
-            index = gif->frame[(gif->fy + j) * gif->width + gif->fx + k];
-            color = &gif->palette->colors[index*3];
-            if (!gif->gce.transparency || index != gif->gce.tindex) {
-#if LV_COLOR_DEPTH == 32
-                buffer[(i+k)*4 + 0] = *(color + 2);
-                buffer[(i+k)*4 + 1] = *(color + 1);
-                buffer[(i+k)*4 + 2] = *(color + 0);
-                buffer[(i+k)*4 + 3] = 0xFF;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*3 + 0] = c.full & 0xff;
-                buffer[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                buffer[(i+k)*3 + 2] = 0xff;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(color + 0), *(color + 1), *(color + 2));
-                buffer[(i+k)*2 + 0] = c.full;
-                buffer[(i+k)*2 + 1] = 0xff;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(color + 0)) | (*(color + 1)) | (*(color + 2));
-                buffer[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                buffer[(i+k)*2 + 1] = 0xff;
-#endif
+            if (transparency && index[k] == tindex)
+                continue;
+            if (set_pixel(gif, buffer, i+k, gif->lut[index[k]], 0xff)) {
+                if (x1 < 0) x1 = k;
+                x2 = k;
             }
         }
+        if (x1 >= 0) {
+            mark_changed(gif, gif->fx + x1, gif->fy + j);
+            mark_changed(gif, gif->fx + x2, gif->fy + j);
+        }
         i += gif->width;
     }
 }
@@ -527,10 +667,10 @@ static void
 dispose(gd_GIF *gif)
 {
     int i, j, k;
-    uint8_t *bgcolor;
+    lv_color_t bgcolor;
     switch (gif->gce.disposal) {
     case 2: /* Restore to background color. */
-        bgcolor = &gif->palette->colors[gif->bgindex*3];
+        bgcolor = gif->lut[gif->bgindex];
 
         uint8_t opa = 0xff;
         if(gif->gce.transparency) opa = 0x00;
@@ -538,25 +678,8 @@ dispose(gd_GIF *gif)
         i = gif->fy * gif->width + gif->fx;
         for (j = 0; j < gif->fh; j++) {
             for (k = 0; k < gif->fw; k++) {
-#if LV_COLOR_DEPTH == 32
-                gif->canvas[(i+k)*4 + 0] = *(bgcolor + 2);
-                gif->canvas[(i+k)*4 + 1] = *(bgcolor + 1);
-                gif->canvas[(i+k)*4 + 2] = *(bgcolor + 0);
-                gif->canvas[(i+k)*4 + 3] = opa;
-#elif LV_COLOR_DEPTH == 16
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*3 + 0] = c.full & 0xff;
-                gif->canvas[(i+k)*3 + 1] = (c.full >> 8) & 0xff;
-                gif->canvas[(i+k)*3 + 2] = opa;
-#elif LV_COLOR_DEPTH == 8
-                lv_color_t c = lv_color_make(*(bgcolor + 0), *(bgcolor + 1), *(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = c.full;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#elif LV_COLOR_DEPTH == 1
-                uint8_t b = (*(bgcolor + 0)) | (*(bgcolor + 1)) | (*(bgcolor + 2));
-                gif->canvas[(i+k)*2 + 0] = b > 128 ? 1 : 0;
-                gif->canvas[(i+k)*2 + 1] = opa;
-#endif
+                if (set_pixel(gif, gif->canvas, i+k, bgcolor, opa))
+                    mark_changed(gif, gif->fx + k, gif->fy + j);
             }
             i += gif->width;
         }
@@ -565,7 +688,8 @@ dispose(gd_GIF *gif)
         break;
     default:
         /* Add frame non-transparent pixels to canvas. */
-        render_frame_rect(gif, gif->canvas);
+        if (!gif->rendered)
+            render_frame_rect(gif, gif->canvas);
     }
 }
 
@@ -580,6 +704,7 @@ gd_get_frame(gd_GIF *gif)
     while (sep != ',') {
         if (sep == ';') {
             f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
+            gif->frame_no = 0;
             if(gif->loop_count == 1 || gif->loop_count < 0) {
                 return 0;
             }
@@ -594,6 +719,7 @@ gd_get_frame(gd_GIF *gif)
     }
     if (read_image(gif) == -1)
         return -1;
+    gif->frame_no++;
     return 1;
 }
 
@@ -610,12 +736,15 @@ gd_render_frame(gd_GIF *gif, uint8_t *buffer)
 //    }
 //    memcpy(buffer, gif->canvas, gif->width * gif->height * 3);
     render_frame_rect(gif, buffer);
+    if (buffer == gif->canvas)
+        gif->rendered = 1;
 }
 
 void
 gd_rewind(gd_GIF *gif)
 {
     gif->loop_count = -1;
+    gif->frame_no = 0;
     f_gif_seek(gif, gif->anim_start, LV_FS_SEEK_SET);
 }
 
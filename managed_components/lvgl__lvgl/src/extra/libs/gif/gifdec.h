@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_color.h"
 
 #if LV_USE_GIF
 
@@ -30,6 +31,8 @@ typedef struct gd_GIF {
     uint16_t width, height;
     uint16_t depth;
     int32_t loop_count;
+    /* Number of the current frame in the loop, starting from 1. */
+    uint32_t frame_no;
     gd_GCE gce;
     gd_Palette *palette;
     gd_Palette lct, gct;
@@ -42,6 +45,15 @@ typedef struct gd_GIF {
     void (*application)(struct gd_GIF *gif, char id[8], char auth[3]);
     uint16_t fx, fy, fw, fh;
     uint8_t bgindex;
+    uint8_t opaque;
+    /* `palette` converted to the canvas' color format. */
+    gd_Palette *lut_palette;
+    lv_color_t lut[0x100];
+    /* The current frame was already rendered to the canvas. */
+    uint8_t rendered;
+    /* Bounding box of the canvas pixels changed since `changed` was cleared. */
+    uint8_t changed;
+    uint16_t cx1, cy1, cx2, cy2;
     uint8_t *canvas, *frame;
 } gd_GIF;
 
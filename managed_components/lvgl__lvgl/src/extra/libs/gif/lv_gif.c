@@ -10,15 +10,26 @@
 #if LV_USE_GIF
 
 #include "gifdec.h"
+#include <string.h>
 
 /*********************
  *      DEFINES
  *********************/
 #define MY_CLASS    &lv_gif_class
 
+/*Grow the array of cached frames by this many frames*/
+#define FRAME_ALLOC_STEP    8
+
 /**********************
  *      TYPEDEFS
  **********************/
+enum {
+    CACHE_OFF,      /*No budget for the frames*/
+    CACHE_WAIT,     /*Wait for the first frame of a loop to start recording*/
+    CACHE_RECORD,   /*Store the decoded frames*/
+    CACHE_REPLAY,   /*Show the frames from the cache*/
+    CACHE_STREAM,   /*The frames didn't fit in the budget, decode them in every loop*/
+};
 
 /**********************
  *  STATIC PROTOTYPES
@@ -26,6 +37,14 @@
 static void lv_gif_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void next_frame_task_cb(lv_timer_t * t);
+static void cache_frame(lv_gif_t * gifobj, int has_next);
+static void replay_frame(lv_gif_t * gifobj);
+static bool next_loop(gd_GIF * gif);
+static void cache_reset(lv_gif_t * gifobj);
+static void cache_clear(lv_gif_t * gifobj);
+static void * cache_alloc(size_t size);
+static void cache_free(void * p);
+static uint32_t px_size(gd_GIF * gif);
 
 /**********************
  *  STATIC VARIABLES
@@ -37,6 +56,9 @@ const lv_obj_class_t lv_gif_class = {
     .base_class = &lv_img_class
 };
 
+static lv_img_cache_alloc_cb_t cache_alloc_cb;
+static lv_img_cache_free_cb_t cache_free_cb;
+
 /**********************
  *      MACROS
  **********************/
@@ -61,6 +83,7 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
     /*Close previous gif if any*/
     if(gifobj->gif) {
         lv_img_cache_invalidate_src(&gifobj->imgdsc);
+        cache_clear(gifobj);
         gd_close_gif(gifobj->gif);
         gifobj->gif = NULL;
         gifobj->imgdsc.data = NULL;
@@ -80,10 +103,14 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     gifobj->imgdsc.data = gifobj->gif->canvas;
     gifobj->imgdsc.header.always_zero = 0;
-    gifobj->imgdsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    /*Without transparent background the canvas has no alpha channel and the GIF can cover its area*/
+    gifobj->imgdsc.header.cf = gifobj->gif->opaque ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
     gifobj->imgdsc.header.h = gifobj->gif->height;
     gifobj->imgdsc.header.w = gifobj->gif->width;
     gifobj->last_call = lv_tick_get();
+    gifobj->hits = 0;
+    gifobj->misses = 0;
+    cache_reset(gifobj);
 
     lv_img_set_src(obj, &gifobj->imgdsc);
 
@@ -92,16 +119,60 @@ void lv_gif_set_src(lv_obj_t * obj, const void * src)
 
     next_frame_task_cb(gifobj->timer);
 
+    /*The loop count is read with the first frame. Restore it when the cached frames are restarted.*/
+    gifobj->loop_count = gifobj->gif->loop_count;
 }
 
 void lv_gif_restart(lv_obj_t * obj)
 {
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     gd_rewind(gifobj->gif);
+    if(gifobj->cache_state == CACHE_REPLAY) {
+        gifobj->gif->loop_count = gifobj->loop_count;
+        gifobj->frame_act = 0;
+    }
+    else if(gifobj->cache_state == CACHE_RECORD) {
+        /*Record again from the first frame*/
+        cache_reset(gifobj);
+    }
     lv_timer_resume(gifobj->timer);
     lv_timer_reset(gifobj->timer);
 }
 
+void lv_gif_set_cache_budget(lv_obj_t * obj, uint32_t budget)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    if(gifobj->cache_budget == budget) return;
+
+    gifobj->cache_budget = budget;
+    if(gifobj->gif && gifobj->cache_state == CACHE_REPLAY) {
+        /*The decoder was stopped at the end of the first loop, continue from the first frame*/
+        gd_rewind(gifobj->gif);
+        gifobj->gif->loop_count = gifobj->loop_count;
+    }
+    cache_reset(gifobj);
+}
+
+void lv_gif_set_cache_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb)
+{
+    cache_alloc_cb = alloc_cb;
+    cache_free_cb = free_cb;
+}
+
+void lv_gif_get_cache_stats(lv_obj_t * obj, lv_gif_cache_stats_t * stats)
+{
+    lv_gif_t * gifobj = (lv_gif_t *) obj;
+    lv_memset_00(stats, sizeof(lv_gif_cache_stats_t));
+    stats->hits = gifobj->hits;
+    stats->misses = gifobj->misses;
+    stats->mem_used = gifobj->cache_mem;
+    stats->frame_cnt = gifobj->frame_cnt;
+    stats->streaming = gifobj->cache_state == CACHE_STREAM;
+
+    uint64_t shown = (uint64_t)gifobj->hits + gifobj->misses;
+    if(shown) stats->hit_rate = (uint64_t)gifobj->hits * 100 / shown;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -122,6 +193,7 @@ static void lv_gif_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     LV_UNUSED(class_p);
     lv_gif_t * gifobj = (lv_gif_t *) obj;
     lv_img_cache_invalidate_src(&gifobj->imgdsc);
+    cache_clear(gifobj);
     if(gifobj->gif)
         gd_close_gif(gifobj->gif);
     lv_timer_del(gifobj->timer);
@@ -136,18 +208,206 @@ static void next_frame_task_cb(lv_timer_t * t)
 
     gifobj->last_call = lv_tick_get();
 
-    int has_next = gd_get_frame(gifobj->gif);
-    if(has_next == 0) {
-        /*It was the last repeat*/
-        lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
-        lv_timer_pause(t);
-        if(res != LV_FS_RES_OK) return;
+    gd_GIF * gif = gifobj->gif;
+    if(gifobj->cache_state == CACHE_REPLAY) {
+        if(gifobj->frame_act == gifobj->frame_cnt) {
+            if(!next_loop(gif)) {
+                /*It was the last repeat*/
+                lv_event_send(obj, LV_EVENT_READY, NULL);
+                lv_timer_pause(t);
+                return;
+            }
+            gifobj->frame_act = 0;
+        }
+        replay_frame(gifobj);
     }
+    else {
+        int has_next = gd_get_frame(gifobj->gif);
+        if(has_next == 0) {
+            /*It was the last repeat*/
+            cache_frame(gifobj, has_next);
+            lv_res_t res = lv_event_send(obj, LV_EVENT_READY, NULL);
+            lv_timer_pause(t);
+            if(res != LV_FS_RES_OK) return;
+        }
 
-    gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+        gd_render_frame(gifobj->gif, (uint8_t *)gifobj->imgdsc.data);
+        if(has_next == 1) {
+            gifobj->misses++;
+            cache_frame(gifobj, has_next);
+        }
+    }
 
     lv_img_cache_invalidate_src(lv_img_get_src(obj));
-    lv_obj_invalidate(obj);
+
+    /*Redraw only the pixels changed by disposing the previous frame and rendering the new one*/
+    if(gif->changed) {
+        lv_area_t changed_area;
+        lv_area_set(&changed_area, gif->cx1, gif->cy1, gif->cx2, gif->cy2);
+        lv_img_invalidate_src_area(obj, &changed_area);
+        gif->changed = 0;
+    }
+}
+
+/**
+ * Store the frame just rendered to the canvas if the frames are being recorded.
+ * @param gifobj    pointer to a GIF object
+ * @param has_next  return value of `gd_get_frame`
+ */
+static void cache_frame(lv_gif_t * gifobj, int has_next)
+{
+    gd_GIF * gif = gifobj->gif;
+
+    if(gifobj->cache_state == CACHE_WAIT) {
+        /*The first frame is stored entirely, so the recording can start only at the first frame of a loop*/
+        if(has_next != 1 || gif->frame_no != 1) return;
+        gifobj->cache_state = CACHE_RECORD;
+    }
+
+    if(gifobj->cache_state != CACHE_RECORD) return;
+
+    if(has_next == 0) {
+        /*The GIF was played once and ended, it can be replayed after a restart*/
+        gifobj->cache_state = CACHE_REPLAY;
+        gifobj->frame_act = gifobj->frame_cnt;
+        return;
+    }
+
+    if(gif->frame_no == 1 && gifobj->frame_cnt) {
+        /*A new loop started. Its first frame was decoded already, replay the next ones.*/
+        gifobj->cache_state = CACHE_REPLAY;
+        gifobj->frame_act = 1;
+        return;
+    }
+
+    lv_area_t area;
+    if(gifobj->frame_cnt == 0) lv_area_set(&area, 0, 0, gif->width - 1, gif->height - 1);
+    else if(gif->changed) lv_area_set(&area, gif->cx1, gif->cy1, gif->cx2, gif->cy2);
+    else lv_area_set(&area, 0, 0, -1, -1);
+
+    uint32_t row_size = lv_area_get_width(&area) * px_size(gif);
+    uint32_t size = row_size * lv_area_get_height(&area);
+    if(gifobj->cache_mem + size + sizeof(lv_gif_frame_t) > gifobj->cache_budget || gifobj->frame_cnt == UINT16_MAX) {
+        LV_LOG_INFO("the frames don't fit in the budget, decode them in every loop");
+        cache_clear(gifobj);
+        gifobj->cache_state = CACHE_STREAM;
+        return;
+    }
+
+    if(gifobj->frame_cnt % FRAME_ALLOC_STEP == 0) {
+        lv_gif_frame_t * frames = lv_mem_realloc(gifobj->frames,
+                                                 (gifobj->frame_cnt + FRAME_ALLOC_STEP) * sizeof(lv_gif_frame_t));
+        if(frames == NULL) {
+            LV_LOG_WARN("out of memory, decode the frames in every loop");
+            cache_clear(gifobj);
+            gifobj->cache_state = CACHE_STREAM;
+            return;
+        }
+        gifobj->frames = frames;
+    }
+
+    lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_cnt];
+    frame->area = area;
+    frame->delay = gif->gce.delay;
+    frame->data = NULL;
+    if(size) {
+        frame->data = cache_alloc(size);
+        if(frame->data == NULL) {
+            LV_LOG_WARN("out of memory, decode the frames in every loop");
+            cache_clear(gifobj);
+            gifobj->cache_state = CACHE_STREAM;
+            return;
+        }
+
+        lv_coord_t y;
+        for(y = area.y1; y <= area.y2; y++) {
+            lv_memcpy(&frame->data[(y - area.y1) * row_size],
+                      &gif->canvas[(y * gif->width + area.x1) * px_size(gif)], row_size);
+        }
+    }
+
+    gifobj->frame_cnt++;
+    gifobj->cache_mem += size + sizeof(lv_gif_frame_t);
+}
+
+/**
+ * Copy the next cached frame to the canvas and mark the area it changed.
+ * @param gifobj    pointer to a GIF object
+ */
+static void replay_frame(lv_gif_t * gifobj)
+{
+    gd_GIF * gif = gifobj->gif;
+    lv_gif_frame_t * frame = &gifobj->frames[gifobj->frame_act];
+    uint32_t row_size = lv_area_get_width(&frame->area) * px_size(gif);
+    lv_coord_t y;
+
+    for(y = frame->area.y1; y <= frame->area.y2; y++) {
+        uint8_t * dest = &gif->canvas[(y * gif->width + frame->area.x1) * px_size(gif)];
+        const uint8_t * src = &frame->data[(y - frame->area.y1) * row_size];
+
+        /*The first frame is stored entirely, so skip the rows it doesn't change*/
+        if(gifobj->frame_act == 0 && memcmp(dest, src, row_size) == 0) continue;
+
+        lv_memcpy(dest, src, row_size);
+        if(!gif->changed) {
+            gif->changed = 1;
+            gif->cx1 = frame->area.x1;
+            gif->cx2 = frame->area.x2;
+            gif->cy1 = y;
+        }
+        gif->cy2 = y;
+    }
+
+    gif->gce.delay = frame->delay;
+    gifobj->frame_act++;
+    gifobj->hits++;
+}
+
+/**
+ * Start a new loop of the cached frames the same way `gd_get_frame` does at the end of the GIF.
+ * @param gif       pointer to the decoder
+ * @return          false: it was the last repeat
+ */
+static bool next_loop(gd_GIF * gif)
+{
+    if(gif->loop_count == 1 || gif->loop_count < 0) return false;
+    if(gif->loop_count > 1) gif->loop_count--;
+    return true;
+}
+
+static void cache_reset(lv_gif_t * gifobj)
+{
+    cache_clear(gifobj);
+    gifobj->cache_state = gifobj->cache_budget ? CACHE_WAIT : CACHE_OFF;
+}
+
+static void cache_clear(lv_gif_t * gifobj)
+{
+    uint32_t i;
+    for(i = 0; i < gifobj->frame_cnt; i++) {
+        if(gifobj->frames[i].data) cache_free(gifobj->frames[i].data);
+    }
+    lv_mem_free(gifobj->frames);
+    gifobj->frames = NULL;
+    gifobj->frame_cnt = 0;
+    gifobj->frame_act = 0;
+    gifobj->cache_mem = 0;
+}
+
+static void * cache_alloc(size_t size)
+{
+    return cache_alloc_cb ? cache_alloc_cb(size) : lv_mem_alloc(size);
+}
+
+static void cache_free(void * p)
+{
+    if(cache_alloc_cb) cache_free_cb(p);
+    else lv_mem_free(p);
+}
+
+static uint32_t px_size(gd_GIF * gif)
+{
+    return gif->opaque ? sizeof(lv_color_t) : LV_IMG_PX_SIZE_ALPHA_BYTE;
 }
 
 #endif /*LV_USE_GIF*/
@@ -27,12 +27,40 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A frame in the cache of decoded frames*/
+typedef struct {
+    lv_area_t area;     /**< Area of the canvas stored in `data`. The first frame of the loop is stored entirely*/
+    uint8_t * data;     /**< Pixels of `area` after rendering the frame*/
+    uint16_t delay;     /**< Delay of the frame in 10 ms units*/
+} lv_gif_frame_t;
+
+/** Statistics of the frame cache of a GIF*/
+typedef struct {
+    uint32_t hits;          /**< Frames shown from the cache*/
+    uint32_t misses;        /**< Frames decoded*/
+    uint32_t mem_used;      /**< Bytes used by the cached frames*/
+    uint16_t frame_cnt;     /**< Number of cached frames*/
+    uint8_t hit_rate;       /**< `hits` in percentage of all the shown frames*/
+    uint8_t streaming : 1;  /**< 1: the frames didn't fit in the budget and they are decoded in every loop*/
+} lv_gif_cache_stats_t;
+
 typedef struct {
     lv_img_t img;
     gd_GIF * gif;
     lv_timer_t * timer;
     lv_img_dsc_t imgdsc;
     uint32_t last_call;
+
+    /*Cache of decoded frames*/
+    lv_gif_frame_t * frames;
+    uint16_t frame_cnt;
+    uint16_t frame_act;     /*Index of the next frame to replay*/
+    uint32_t cache_budget;
+    uint32_t cache_mem;
+    uint32_t hits;
+    uint32_t misses;
+    int32_t loop_count;     /*Loop count of the GIF after its first frame*/
+    uint8_t cache_state;
 } lv_gif_t;
 
 extern const lv_obj_class_t lv_gif_class;
@@ -45,6 +73,29 @@ lv_obj_t * lv_gif_create(lv_obj_t * parent);
 void lv_gif_set_src(lv_obj_t * obj, const void * src);
 void lv_gif_restart(lv_obj_t * gif);
 
+/**
+ * Keep the decoded frames of the GIF and replay them instead of decoding the frames again in every loop.
+ * The frames are recorded during the first loop: the first frame entirely, the others as the area they changed.
+ * If the frames need more memory than the budget they are freed and the GIF is decoded in every loop.
+ * @param obj       pointer to a GIF object
+ * @param budget    the memory the frames can use in bytes. 0: don't cache the frames (default)
+ */
+void lv_gif_set_cache_budget(lv_obj_t * obj, uint32_t budget);
+
+/**
+ * Set where the cached frames of the GIFs are stored. E.g. in external RAM.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_gif_set_cache_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb);
+
+/**
+ * Get the statistics of the frame cache of a GIF.
+ * @param obj       pointer to a GIF object
+ * @param stats     store the statistics here
+ */
+void lv_gif_get_cache_stats(lv_obj_t * obj, lv_gif_cache_stats_t * stats);
+
 /**********************
  *      MACROS
  **********************/
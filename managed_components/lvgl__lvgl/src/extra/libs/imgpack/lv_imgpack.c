@@ -0,0 +1,766 @@
+/**
+ * @file lv_imgpack.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_IMGPACK
+
+#include "lv_imgpack.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PACK_MAGIC          "LVIP"
+#define PACK_VERSION        1
+#define PACK_HEADER_SIZE    16
+#define PACK_ENTRY_SIZE     48
+#define PACK_FLAG_16_SWAP   0x01
+
+#define IMG_MAGIC           0x4C564950  /*"LVIP"*/
+#define TILE_NONE           UINT32_MAX
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*An opened image of a pack*/
+typedef struct {
+    const lv_imgpack_img_t * img;
+    lv_fs_file_t f;
+    bool is_file;
+    const uint8_t * data;       /*The image data in memory or NULL*/
+    uint32_t * tile_ofs;        /*The tile offsets read from the file*/
+    uint8_t * tile_buf;         /*The decoded tile or the row read from the file*/
+    uint8_t * in_buf;           /*The compressed tile read from the file*/
+    uint32_t tile_idx;          /*Index of the tile in `tile_buf`*/
+    uint32_t stride;            /*Bytes per row, without the alpha plane of RGB565A8*/
+    uint32_t palette_size;      /*Bytes of the palette before the pixels*/
+    lv_color_t * palette;       /*The colors of an indexed image*/
+    lv_opa_t * palette_opa;
+} imgpack_dsc_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t parse_header(const uint8_t * header, uint32_t * img_cnt);
+static lv_res_t parse_img(lv_imgpack_t * pack, lv_imgpack_img_t * img, const uint8_t * entry, uint32_t pack_size);
+static const lv_imgpack_img_t * get_img(const void * src);
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, uint8_t * buf);
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc);
+static lv_res_t open_tiles(imgpack_dsc_t * p);
+static lv_res_t open_palette(imgpack_dsc_t * p);
+static lv_res_t read_at(imgpack_dsc_t * p, uint32_t ofs, void * buf, uint32_t len);
+static lv_res_t get_row(imgpack_dsc_t * p, uint32_t y, const uint8_t ** row, const uint8_t ** alpha);
+static lv_res_t decode_tile(imgpack_dsc_t * p, uint32_t tile);
+static void convert_row(const imgpack_dsc_t * p, lv_color_t color, const uint8_t * row, const uint8_t * alpha,
+                        uint32_t x, uint32_t len, uint8_t * buf);
+static bool lz4_decode(const uint8_t * in, uint32_t in_len, uint8_t * out, uint32_t out_len);
+static const uint8_t * rle_decode(const uint8_t * in, const uint8_t * in_end, uint8_t * out, uint32_t out_len,
+                                  uint32_t unit);
+static lv_img_cf_t output_cf(uint8_t cf);
+static uint32_t get_stride(uint8_t cf, uint32_t w);
+static uint32_t get_u32(const uint8_t * p);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_imgpack_init(void)
+{
+    lv_img_decoder_t * dec = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(dec, decoder_info);
+    lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_decode_cb(dec, decoder_decode);
+    lv_img_decoder_set_close_cb(dec, decoder_close);
+}
+
+lv_res_t lv_imgpack_open_data(lv_imgpack_t * pack, const void * data, uint32_t size)
+{
+    lv_memset_00(pack, sizeof(lv_imgpack_t));
+    if(size < PACK_HEADER_SIZE) return LV_RES_INV;
+
+    uint32_t img_cnt;
+    if(parse_header(data, &img_cnt) != LV_RES_OK) return LV_RES_INV;
+    if(img_cnt > (size - PACK_HEADER_SIZE) / PACK_ENTRY_SIZE) return LV_RES_INV;
+
+    pack->data = data;
+    pack->imgs = lv_mem_alloc(img_cnt * sizeof(lv_imgpack_img_t) + 1);
+    LV_ASSERT_MALLOC(pack->imgs);
+    if(pack->imgs == NULL) return LV_RES_INV;
+
+    const uint8_t * entry = pack->data + PACK_HEADER_SIZE;
+    for(pack->img_cnt = 0; pack->img_cnt < img_cnt; pack->img_cnt++) {
+        if(parse_img(pack, &pack->imgs[pack->img_cnt], entry, size) != LV_RES_OK) {
+            lv_imgpack_close(pack);
+            return LV_RES_INV;
+        }
+        entry += PACK_ENTRY_SIZE;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_imgpack_open_file(lv_imgpack_t * pack, const char * path)
+{
+    lv_memset_00(pack, sizeof(lv_imgpack_t));
+
+    lv_fs_file_t f;
+    if(lv_fs_open(&f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+
+    uint8_t buf[PACK_ENTRY_SIZE];
+    uint32_t size = 0;
+    uint32_t img_cnt = 0;
+    uint32_t br = 0;
+    lv_res_t res = LV_RES_INV;
+    if(lv_fs_seek(&f, 0, LV_FS_SEEK_END) == LV_FS_RES_OK && lv_fs_tell(&f, &size) == LV_FS_RES_OK &&
+       lv_fs_seek(&f, 0, LV_FS_SEEK_SET) == LV_FS_RES_OK &&
+       lv_fs_read(&f, buf, PACK_HEADER_SIZE, &br) == LV_FS_RES_OK && br == PACK_HEADER_SIZE) {
+        res = parse_header(buf, &img_cnt);
+    }
+    if(res == LV_RES_OK && img_cnt > (size - PACK_HEADER_SIZE) / PACK_ENTRY_SIZE) res = LV_RES_INV;
+
+    if(res == LV_RES_OK) {
+        pack->path = lv_mem_alloc(strlen(path) + 1);
+        pack->imgs = lv_mem_alloc(img_cnt * sizeof(lv_imgpack_img_t) + 1);
+        LV_ASSERT_MALLOC(pack->path);
+        LV_ASSERT_MALLOC(pack->imgs);
+        if(pack->path && pack->imgs) strcpy(pack->path, path);
+        else res = LV_RES_INV;
+    }
+
+    while(res == LV_RES_OK && pack->img_cnt < img_cnt) {
+        if(lv_fs_read(&f, buf, PACK_ENTRY_SIZE, &br) != LV_FS_RES_OK || br != PACK_ENTRY_SIZE) res = LV_RES_INV;
+        else res = parse_img(pack, &pack->imgs[pack->img_cnt], buf, size);
+        if(res == LV_RES_OK) pack->img_cnt++;
+    }
+
+    lv_fs_close(&f);
+    if(res != LV_RES_OK) lv_imgpack_close(pack);
+    return res;
+}
+
+const lv_img_dsc_t * lv_imgpack_get(const lv_imgpack_t * pack, const char * name)
+{
+    /*The images are sorted by name*/
+    uint32_t first = 0;
+    uint32_t last = pack->img_cnt;
+    while(first < last) {
+        uint32_t mid = (first + last) / 2;
+        int cmp = strcmp(name, pack->imgs[mid].name);
+        if(cmp == 0) return &pack->imgs[mid].dsc;
+        if(cmp < 0) last = mid;
+        else first = mid + 1;
+    }
+
+    return NULL;
+}
+
+void lv_imgpack_close(lv_imgpack_t * pack)
+{
+    uint32_t i;
+    for(i = 0; i < pack->img_cnt; i++) {
+        lv_img_cache_invalidate_src(&pack->imgs[i].dsc);
+    }
+
+    if(pack->imgs) lv_mem_free(pack->imgs);
+    if(pack->path) lv_mem_free(pack->path);
+    lv_memset_00(pack, sizeof(lv_imgpack_t));
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Check the header of a pack: magic, version and that it's converted for the color format of LVGL
+ */
+static lv_res_t parse_header(const uint8_t * header, uint32_t * img_cnt)
+{
+    if(memcmp(header, PACK_MAGIC, 4) != 0 || header[4] != PACK_VERSION) return LV_RES_INV;
+    if(header[5] != LV_COLOR_DEPTH) {
+        LV_LOG_WARN("the image pack is converted for %d bit colors", header[5]);
+        return LV_RES_INV;
+    }
+#if LV_COLOR_DEPTH == 16
+    if(!(header[6] & PACK_FLAG_16_SWAP) != !LV_COLOR_16_SWAP) {
+        LV_LOG_WARN("the image pack is converted with an other LV_COLOR_16_SWAP");
+        return LV_RES_INV;
+    }
+#endif
+
+    *img_cnt = get_u32(header + 8);
+    return LV_RES_OK;
+}
+
+/**
+ * Read an entry of the index. The images of a pack in memory are drawn from the pack if they aren't compressed.
+ */
+static lv_res_t parse_img(lv_imgpack_t * pack, lv_imgpack_img_t * img, const uint8_t * entry, uint32_t pack_size)
+{
+    lv_memset_00(img, sizeof(lv_imgpack_img_t));
+    if(memchr(entry, '\0', LV_IMGPACK_NAME_MAX) == NULL) return LV_RES_INV;
+    lv_memcpy(img->name, entry, LV_IMGPACK_NAME_MAX);
+
+    /*Sorted and unique names*/
+    if(pack->img_cnt && strcmp(img[-1].name, img->name) >= 0) return LV_RES_INV;
+
+    img->magic = IMG_MAGIC;
+    img->pack = pack;
+    img->ofs = get_u32(entry + 32);
+    img->size = get_u32(entry + 36);
+    uint32_t w = entry[40] | entry[41] << 8;
+    uint32_t h = entry[42] | entry[43] << 8;
+    img->cf = entry[44];
+    img->compress = entry[45];
+    img->tile_h = entry[46] | entry[47] << 8;
+
+    switch(img->cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        case LV_IMG_CF_ALPHA_8BIT:
+        case LV_IMG_CF_INDEXED_1BIT:
+        case LV_IMG_CF_INDEXED_2BIT:
+        case LV_IMG_CF_INDEXED_4BIT:
+        case LV_IMG_CF_INDEXED_8BIT:
+#if LV_COLOR_DEPTH == 16
+        case LV_IMG_CF_RGB565A8:
+#endif
+            break;
+        default:
+            return LV_RES_INV;
+    }
+
+    if(w == 0 || h == 0 || w > 2047 || h > 2047 || img->tile_h == 0) return LV_RES_INV;
+    if(img->compress > LV_IMGPACK_COMPRESS_LZ4) return LV_RES_INV;
+    if(img->compress == LV_IMGPACK_COMPRESS_NONE && img->size < lv_img_buf_get_img_size(w, h, img->cf)) {
+        return LV_RES_INV;
+    }
+    /*Aligned for the pixels drawn in place*/
+    if(img->ofs % 4 || img->ofs > pack_size || img->size > pack_size - img->ofs) return LV_RES_INV;
+
+    img->dsc.header.w = w;
+    img->dsc.header.h = h;
+    /*The built-in decoder can't transform indexed images, they are converted by the decoder of the packs*/
+    bool indexed = img->cf >= LV_IMG_CF_INDEXED_1BIT && img->cf <= LV_IMG_CF_INDEXED_8BIT;
+    if(pack->data && img->compress == LV_IMGPACK_COMPRESS_NONE && !indexed) {
+        img->dsc.header.cf = img->cf;
+        img->dsc.data = pack->data + img->ofs;
+        img->dsc.data_size = img->size;
+    }
+    else {
+        img->dsc.header.cf = LV_IMG_CF_USER_ENCODED_0;
+        img->dsc.data = (const uint8_t *)img;
+        img->dsc.data_size = sizeof(lv_imgpack_img_t);
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Get the image of a pack from an image source
+ * @return the image or NULL if the source is not an image of a pack
+ */
+static const lv_imgpack_img_t * get_img(const void * src)
+{
+    if(lv_img_src_get_type(src) != LV_IMG_SRC_VARIABLE) return NULL;
+
+    const lv_img_dsc_t * img_dsc = src;
+    if(img_dsc->header.cf != LV_IMG_CF_USER_ENCODED_0 || img_dsc->data_size != sizeof(lv_imgpack_img_t)) return NULL;
+
+    const lv_imgpack_img_t * img = (const lv_imgpack_img_t *)img_dsc->data;
+    if(img->magic != IMG_MAGIC) return NULL;
+    return img;
+}
+
+static lv_res_t decoder_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    const lv_imgpack_img_t * img = get_img(src);
+    if(img == NULL) return LV_RES_INV;
+
+    header->always_zero = 0;
+    header->w = img->dsc.header.w;
+    header->h = img->dsc.header.h;
+    header->cf = output_cf(img->cf);
+    return LV_RES_OK;
+}
+
+/**
+ * Open an image of a pack. The tiles are decoded later, when their rows are needed.
+ */
+static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    const lv_imgpack_img_t * img = get_img(dsc->src);
+    if(img == NULL) return LV_RES_INV;
+
+    imgpack_dsc_t * p = lv_mem_alloc(sizeof(imgpack_dsc_t));
+    LV_ASSERT_MALLOC(p);
+    if(p == NULL) return LV_RES_INV;
+    lv_memset_00(p, sizeof(imgpack_dsc_t));
+    p->img = img;
+    p->tile_idx = TILE_NONE;
+    p->stride = get_stride(img->cf, img->dsc.header.w);
+    dsc->user_data = p;
+
+    if(img->pack->data) {
+        p->data = img->pack->data + img->ofs;
+    }
+    else {
+        if(lv_fs_open(&p->f, img->pack->path, LV_FS_MODE_RD) != LV_FS_RES_OK) {
+            decoder_close(decoder, dsc);
+            return LV_RES_INV;
+        }
+        p->is_file = true;
+    }
+
+    if(open_palette(p) != LV_RES_OK || open_tiles(p) != LV_RES_OK) {
+        decoder_close(decoder, dsc);
+        return LV_RES_INV;
+    }
+
+    dsc->header.cf = output_cf(img->cf);
+    dsc->img_data = NULL;
+    return LV_RES_OK;
+}
+
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    imgpack_dsc_t * p = dsc->user_data;
+    if(p == NULL) return LV_RES_INV;
+
+    const uint8_t * row;
+    const uint8_t * alpha;
+    if(get_row(p, y, &row, &alpha) != LV_RES_OK) return LV_RES_INV;
+
+    convert_row(p, dsc->color, row, alpha, x, len, buf);
+    return LV_RES_OK;
+}
+
+/**
+ * Decode the whole image into a buffer of the caller. RGB565A8 images are decoded with their alpha plane.
+ */
+static lv_res_t decoder_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    imgpack_dsc_t * p = dsc->user_data;
+    if(p == NULL) return LV_RES_INV;
+
+    uint32_t w = p->img->dsc.header.w;
+    uint32_t h = p->img->dsc.header.h;
+    uint32_t line_size = w * (output_cf(p->img->cf) == LV_IMG_CF_TRUE_COLOR ? sizeof(lv_color_t) :
+                              LV_IMG_PX_SIZE_ALPHA_BYTE);
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        const uint8_t * row;
+        const uint8_t * alpha;
+        if(get_row(p, y, &row, &alpha) != LV_RES_OK) return LV_RES_INV;
+
+        if(p->img->cf == LV_IMG_CF_RGB565A8) {
+            lv_memcpy(buf + y * p->stride, row, p->stride);
+            lv_memcpy(buf + h * p->stride + y * w, alpha, w);
+        }
+        else {
+            convert_row(p, dsc->color, row, alpha, 0, w, buf + y * line_size);
+        }
+    }
+
+    return LV_RES_OK;
+}
+
+static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    imgpack_dsc_t * p = dsc->user_data;
+    if(p == NULL) return;
+
+    if(p->is_file) lv_fs_close(&p->f);
+    if(p->tile_ofs) lv_mem_free(p->tile_ofs);
+    if(p->tile_buf) lv_mem_free(p->tile_buf);
+    if(p->in_buf) lv_mem_free(p->in_buf);
+    if(p->palette) lv_mem_free(p->palette);
+    lv_mem_free(p);
+    dsc->user_data = NULL;
+}
+
+/**
+ * Convert the palette of an indexed image into LVGL's colors
+ */
+static lv_res_t open_palette(imgpack_dsc_t * p)
+{
+    uint8_t cf = p->img->cf;
+    if(cf < LV_IMG_CF_INDEXED_1BIT || cf > LV_IMG_CF_INDEXED_8BIT) return LV_RES_OK;
+
+    uint32_t color_cnt = 1 << (1 << (cf - LV_IMG_CF_INDEXED_1BIT));
+    p->palette_size = color_cnt * sizeof(lv_color32_t);
+    if(p->palette_size > p->img->size) return LV_RES_INV;
+
+    p->palette = lv_mem_alloc(color_cnt * (sizeof(lv_color_t) + sizeof(lv_opa_t)));
+    LV_ASSERT_MALLOC(p->palette);
+    if(p->palette == NULL) return LV_RES_INV;
+    p->palette_opa = (lv_opa_t *)(p->palette + color_cnt);
+
+    uint32_t i;
+    for(i = 0; i < color_cnt; i++) {
+        uint8_t c[4];   /*lv_color32_t: blue, green, red, alpha*/
+        if(read_at(p, i * 4, c, 4) != LV_RES_OK) return LV_RES_INV;
+        p->palette[i] = lv_color_make(c[2], c[1], c[0]);
+        p->palette_opa[i] = c[3];
+    }
+
+    return LV_RES_OK;
+}
+
+/**
+ * Check the tile offsets and allocate the buffers to decode a tile.
+ * The rows of uncompressed images in a file are read one by one.
+ */
+static lv_res_t open_tiles(imgpack_dsc_t * p)
+{
+    const lv_imgpack_img_t * img = p->img;
+    uint32_t w = img->dsc.header.w;
+    uint32_t h = img->dsc.header.h;
+    uint32_t alpha_stride = img->cf == LV_IMG_CF_RGB565A8 ? w : 0;
+
+    if(img->compress == LV_IMGPACK_COMPRESS_NONE) {
+        if(p->is_file) {
+            p->tile_buf = lv_mem_alloc(p->stride + alpha_stride);
+            LV_ASSERT_MALLOC(p->tile_buf);
+            if(p->tile_buf == NULL) return LV_RES_INV;
+        }
+        return LV_RES_OK;
+    }
+
+    uint32_t tile_cnt = (h + img->tile_h - 1) / img->tile_h;
+    uint32_t table_size = (tile_cnt + 1) * 4;
+    if(p->palette_size + table_size > img->size) return LV_RES_INV;
+
+    const uint8_t * table = p->data ? p->data + p->palette_size : NULL;
+    if(p->is_file) {
+        p->tile_ofs = lv_mem_alloc(table_size);
+        LV_ASSERT_MALLOC(p->tile_ofs);
+        if(p->tile_ofs == NULL || read_at(p, p->palette_size, p->tile_ofs, table_size) != LV_RES_OK) return LV_RES_INV;
+        table = (const uint8_t *)p->tile_ofs;
+    }
+
+    /*The tiles are stored in order after the table*/
+    uint32_t max_size = 0;
+    uint32_t prev = p->palette_size + table_size;
+    uint32_t i;
+    for(i = 0; i <= tile_cnt; i++) {
+        uint32_t ofs = get_u32(table + i * 4);
+        if(ofs < prev || ofs > img->size) return LV_RES_INV;
+        max_size = LV_MAX(max_size, ofs - prev);
+        prev = ofs;
+    }
+
+    if(p->is_file) {
+        /*Keep the offsets in the byte order of the CPU*/
+        for(i = 0; i <= tile_cnt; i++) p->tile_ofs[i] = get_u32(table + i * 4);
+        p->in_buf = lv_mem_alloc(max_size + 1);
+        LV_ASSERT_MALLOC(p->in_buf);
+        if(p->in_buf == NULL) return LV_RES_INV;
+    }
+
+    p->tile_buf = lv_mem_alloc(img->tile_h * (p->stride + alpha_stride));
+    LV_ASSERT_MALLOC(p->tile_buf);
+    if(p->tile_buf == NULL) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+/**
+ * Read bytes of the image data
+ * @param ofs       offset in the image data
+ */
+static lv_res_t read_at(imgpack_dsc_t * p, uint32_t ofs, void * buf, uint32_t len)
+{
+    if(ofs > p->img->size || len > p->img->size - ofs) return LV_RES_INV;
+
+    if(!p->is_file) {
+        lv_memcpy(buf, p->data + ofs, len);
+        return LV_RES_OK;
+    }
+
+    uint32_t br = 0;
+    if(lv_fs_seek(&p->f, p->img->ofs + ofs, LV_FS_SEEK_SET) != LV_FS_RES_OK) return LV_RES_INV;
+    if(lv_fs_read(&p->f, buf, len, &br) != LV_FS_RES_OK || br != len) return LV_RES_INV;
+    return LV_RES_OK;
+}
+
+/**
+ * Get the pixels of a row, decoding their tile if needed
+ * @param row       store the pointer to the pixels here
+ * @param alpha     store the pointer to the alpha values of an RGB565A8 image here
+ */
+static lv_res_t get_row(imgpack_dsc_t * p, uint32_t y, const uint8_t ** row, const uint8_t ** alpha)
+{
+    const lv_imgpack_img_t * img = p->img;
+    uint32_t w = img->dsc.header.w;
+    uint32_t h = img->dsc.header.h;
+    if(y >= h) return LV_RES_INV;
+
+    if(img->compress == LV_IMGPACK_COMPRESS_NONE) {
+        uint32_t row_ofs = p->palette_size + y * p->stride;
+        uint32_t alpha_ofs = h * p->stride + y * w;
+        if(!p->is_file) {
+            *row = p->data + row_ofs;
+            *alpha = p->data + alpha_ofs;
+            return LV_RES_OK;
+        }
+
+        if(read_at(p, row_ofs, p->tile_buf, p->stride) != LV_RES_OK) return LV_RES_INV;
+        if(img->cf == LV_IMG_CF_RGB565A8 &&
+           read_at(p, alpha_ofs, p->tile_buf + p->stride, w) != LV_RES_OK) return LV_RES_INV;
+        *row = p->tile_buf;
+        *alpha = p->tile_buf + p->stride;
+        return LV_RES_OK;
+    }
+
+    uint32_t tile = y / img->tile_h;
+    if(tile != p->tile_idx && decode_tile(p, tile) != LV_RES_OK) return LV_RES_INV;
+
+    uint32_t tile_rows = LV_MIN(img->tile_h, h - tile * img->tile_h);
+    uint32_t r = y - tile * img->tile_h;
+    *row = p->tile_buf + r * p->stride;
+    *alpha = p->tile_buf + tile_rows * p->stride + r * w;
+    return LV_RES_OK;
+}
+
+/**
+ * Decompress a tile into `tile_buf`: its rows and the alpha plane of its rows with RGB565A8
+ */
+static lv_res_t decode_tile(imgpack_dsc_t * p, uint32_t tile)
+{
+    const lv_imgpack_img_t * img = p->img;
+    uint32_t w = img->dsc.header.w;
+    uint32_t h = img->dsc.header.h;
+
+    uint32_t start;
+    uint32_t end;
+    const uint8_t * in;
+    if(p->is_file) {
+        start = p->tile_ofs[tile];
+        end = p->tile_ofs[tile + 1];
+        if(read_at(p, start, p->in_buf, end - start) != LV_RES_OK) return LV_RES_INV;
+        in = p->in_buf;
+    }
+    else {
+        const uint8_t * table = p->data + p->palette_size;
+        start = get_u32(table + tile * 4);
+        end = get_u32(table + tile * 4 + 4);
+        in = p->data + start;
+    }
+
+    uint32_t tile_rows = LV_MIN(img->tile_h, h - tile * img->tile_h);
+    uint32_t color_size = tile_rows * p->stride;
+    uint32_t alpha_size = img->cf == LV_IMG_CF_RGB565A8 ? tile_rows * w : 0;
+
+    /*Not valid if the decoding fails*/
+    p->tile_idx = TILE_NONE;
+
+    if(img->compress == LV_IMGPACK_COMPRESS_LZ4) {
+        if(!lz4_decode(in, end - start, p->tile_buf, color_size + alpha_size)) return LV_RES_INV;
+    }
+    else {
+        /*The units of the runs are the pixels, or bytes with less than 8 bits per pixel*/
+        uint32_t unit;
+        if(img->cf == LV_IMG_CF_TRUE_COLOR || img->cf == LV_IMG_CF_RGB565A8) unit = sizeof(lv_color_t);
+        else if(img->cf == LV_IMG_CF_TRUE_COLOR_ALPHA) unit = LV_IMG_PX_SIZE_ALPHA_BYTE;
+        else unit = 1;
+
+        const uint8_t * in_end = in + (end - start);
+        in = rle_decode(in, in_end, p->tile_buf, color_size, unit);
+        if(in && alpha_size) in = rle_decode(in, in_end, p->tile_buf + color_size, alpha_size, 1);
+        if(in == NULL) return LV_RES_INV;
+    }
+
+    p->tile_idx = tile;
+    return LV_RES_OK;
+}
+
+/**
+ * Convert `len` pixels of a row from `x` to the format of `lv_img_decoder_read_line()`.
+ * The line of an RGB565A8 image is its colors followed by its alpha values,
+ * alpha only and indexed images give true color pixels with alpha.
+ */
+static void convert_row(const imgpack_dsc_t * p, lv_color_t color, const uint8_t * row, const uint8_t * alpha,
+                        uint32_t x, uint32_t len, uint8_t * buf)
+{
+    uint8_t cf = p->img->cf;
+    uint32_t i;
+
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+            lv_memcpy(buf, row + x * sizeof(lv_color_t), len * sizeof(lv_color_t));
+            break;
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            lv_memcpy(buf, row + x * LV_IMG_PX_SIZE_ALPHA_BYTE, len * LV_IMG_PX_SIZE_ALPHA_BYTE);
+            break;
+        case LV_IMG_CF_RGB565A8:
+            lv_memcpy(buf, row + x * sizeof(lv_color_t), len * sizeof(lv_color_t));
+            lv_memcpy(buf + len * sizeof(lv_color_t), alpha + x, len);
+            break;
+        case LV_IMG_CF_ALPHA_8BIT:
+            for(i = 0; i < len; i++) {
+                lv_memcpy(buf, &color, sizeof(lv_color_t));
+                buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = row[x + i];
+                buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+            }
+            break;
+        default: {
+                /*Indexed, the first pixel is in the most significant bits*/
+                uint32_t bpp = 1 << (cf - LV_IMG_CF_INDEXED_1BIT);
+                uint32_t mask = (1 << bpp) - 1;
+                for(i = x; i < x + len; i++) {
+                    uint32_t bit = i * bpp;
+                    uint32_t idx = (row[bit >> 3] >> (8 - bpp - (bit & 7))) & mask;
+                    lv_memcpy(buf, &p->palette[idx], sizeof(lv_color_t));
+                    buf[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = p->palette_opa[idx];
+                    buf += LV_IMG_PX_SIZE_ALPHA_BYTE;
+                }
+            }
+            break;
+    }
+}
+
+/**
+ * Decompress an LZ4 block
+ * @return true: `out` is filled exactly; false: invalid data
+ */
+static bool lz4_decode(const uint8_t * in, uint32_t in_len, uint8_t * out, uint32_t out_len)
+{
+    const uint8_t * in_end = in + in_len;
+    uint32_t o = 0;
+
+    while(in < in_end) {
+        uint8_t token = *in++;
+
+        uint32_t len = token >> 4;
+        if(len == 15) {
+            uint8_t b;
+            do {
+                if(in >= in_end) return false;
+                b = *in++;
+                len += b;
+            } while(b == 255);
+        }
+        if(len > (uint32_t)(in_end - in) || len > out_len - o) return false;
+        lv_memcpy(out + o, in, len);
+        in += len;
+        o += len;
+
+        /*The last sequence has only literals*/
+        if(in == in_end) break;
+
+        if(in_end - in < 2) return false;
+        uint32_t dist = in[0] | in[1] << 8;
+        in += 2;
+        if(dist == 0 || dist > o) return false;
+
+        len = (token & 0x0F) + 4;
+        if((token & 0x0F) == 15) {
+            uint8_t b;
+            do {
+                if(in >= in_end) return false;
+                b = *in++;
+                len += b;
+            } while(b == 255);
+        }
+        if(len > out_len - o) return false;
+
+        /*The match can overlap the bytes it writes*/
+        const uint8_t * m = out + o - dist;
+        uint32_t i;
+        for(i = 0; i < len; i++) out[o + i] = m[i];
+        o += len;
+    }
+
+    return o == out_len;
+}
+
+/**
+ * Decode run-length encoded units. A control byte `c` is followed by one unit repeated `(c & 0x7F) + 1` times
+ * if bit 7 is set, else by `c + 1` different units.
+ * @return the data after the decoded units or NULL if the data is invalid
+ */
+static const uint8_t * rle_decode(const uint8_t * in, const uint8_t * in_end, uint8_t * out, uint32_t out_len,
+                                  uint32_t unit)
+{
+    while(out_len) {
+        if(in >= in_end) return NULL;
+        uint8_t c = *in++;
+        uint32_t size = ((c & 0x7F) + 1) * unit;
+        if(size > out_len) return NULL;
+
+        if(c & 0x80) {
+            if((uint32_t)(in_end - in) < unit) return NULL;
+            uint32_t i;
+            for(i = 0; i < size; i += unit) lv_memcpy(out + i, in, unit);
+            in += unit;
+        }
+        else {
+            if((uint32_t)(in_end - in) < size) return NULL;
+            lv_memcpy(out, in, size);
+            in += size;
+        }
+        out += size;
+        out_len -= size;
+    }
+
+    return in;
+}
+
+/**
+ * The color format of the decoded pixels
+ */
+static lv_img_cf_t output_cf(uint8_t cf)
+{
+    if(cf == LV_IMG_CF_ALPHA_8BIT) return LV_IMG_CF_TRUE_COLOR_ALPHA;
+    if(cf >= LV_IMG_CF_INDEXED_1BIT && cf <= LV_IMG_CF_INDEXED_8BIT) return LV_IMG_CF_TRUE_COLOR_ALPHA;
+    return cf;
+}
+
+/**
+ * Bytes per row of the stored pixels, without the alpha plane of RGB565A8
+ */
+static uint32_t get_stride(uint8_t cf, uint32_t w)
+{
+    switch(cf) {
+        case LV_IMG_CF_TRUE_COLOR:
+        case LV_IMG_CF_RGB565A8:
+            return w * sizeof(lv_color_t);
+        case LV_IMG_CF_TRUE_COLOR_ALPHA:
+            return w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+        case LV_IMG_CF_ALPHA_8BIT:
+            return w;
+        default:
+            return (w * (1 << (cf - LV_IMG_CF_INDEXED_1BIT)) + 7) >> 3;
+    }
+}
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+#endif /*LV_USE_IMGPACK*/
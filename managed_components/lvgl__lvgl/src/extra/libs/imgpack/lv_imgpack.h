@@ -0,0 +1,112 @@
+/**
+ * @file lv_imgpack.h
+ * Image packs: images converted offline by `scripts/imgpack_conv.py` into LVGL's color formats,
+ * optionally compressed in tiles, with an index of their names.
+ */
+
+#ifndef LV_IMGPACK_H
+#define LV_IMGPACK_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#if LV_USE_IMGPACK
+
+#include "../../../draw/lv_img_buf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_IMGPACK_NAME_MAX     32  /*With the terminating '\0'*/
+
+/*Compression of the tiles of an image*/
+#define LV_IMGPACK_COMPRESS_NONE    0
+#define LV_IMGPACK_COMPRESS_RLE     1
+#define LV_IMGPACK_COMPRESS_LZ4     2
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_imgpack_t;
+
+/** An image of a pack*/
+typedef struct {
+    /**The image source to draw. The pixels in the pack if they are in memory, not compressed and not indexed,
+     * else an `LV_IMG_CF_USER_ENCODED_0` image decoded by the pack's decoder.*/
+    lv_img_dsc_t dsc;
+    uint32_t magic;
+    const struct _lv_imgpack_t * pack;
+    char name[LV_IMGPACK_NAME_MAX];
+    uint32_t ofs;           /**< Offset of the image data in the pack*/
+    uint32_t size;          /**< Size of the image data*/
+    uint16_t tile_h;        /**< Rows per compressed tile*/
+    uint8_t cf;             /**< Color format of the pixels, `LV_IMG_CF_...`*/
+    uint8_t compress;       /**< `LV_IMGPACK_COMPRESS_...`*/
+} lv_imgpack_img_t;
+
+typedef struct _lv_imgpack_t {
+    const uint8_t * data;   /**< The pack in memory (e.g. a memory mapped flash partition) or NULL*/
+    char * path;            /**< Path of the pack file if it's not in memory*/
+    lv_imgpack_img_t * imgs;    /**< Sorted by name*/
+    uint32_t img_cnt;
+} lv_imgpack_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Register the decoder of the compressed images and the images read from pack files
+ */
+void lv_imgpack_init(void);
+
+/**
+ * Open an image pack in memory. The uncompressed images are drawn from `data` without copying.
+ * @param pack      pointer to a pack to initialize
+ * @param data      the pack, aligned to 4 bytes. It needs to stay valid while the pack is open.
+ * @param size      size of `data` in bytes
+ * @return          LV_RES_OK: the pack is opened; LV_RES_INV: invalid pack or it's for an other color format
+ */
+lv_res_t lv_imgpack_open_data(lv_imgpack_t * pack, const void * data, uint32_t size);
+
+/**
+ * Open an image pack file. Only its index is loaded, the images are read from the file when they are decoded.
+ * @param pack      pointer to a pack to initialize
+ * @param path      path of the file
+ * @return          LV_RES_OK: the pack is opened; LV_RES_INV: the file can't be read, invalid pack
+ *                  or it's for an other color format
+ */
+lv_res_t lv_imgpack_open_file(lv_imgpack_t * pack, const char * path);
+
+/**
+ * Get an image of a pack
+ * @param pack      pointer to an opened pack
+ * @param name      name of the image
+ * @return          the image source to use with `lv_img_set_src()` or NULL if not found.
+ *                  It's valid until the pack is closed.
+ */
+const lv_img_dsc_t * lv_imgpack_get(const lv_imgpack_t * pack, const char * name);
+
+/**
+ * Close a pack. Its images are removed from the image cache but they must not be used anymore.
+ * @param pack      pointer to a pack
+ */
+void lv_imgpack_close(lv_imgpack_t * pack);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_IMGPACK*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_IMGPACK_H*/
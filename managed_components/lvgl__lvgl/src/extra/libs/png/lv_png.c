@@ -10,6 +10,7 @@
 #if LV_USE_PNG
 
 #include "lv_png.h"
+#include "lv_png_stream.h"
 #include "lodepng.h"
 #include <stdlib.h>
 
@@ -20,14 +21,25 @@
 /**********************
  *      TYPEDEFS
  **********************/
+/*An image decoded row by row*/
+typedef struct {
+    lv_png_stream_t stream;
+    uint8_t * palette;      /*The colors of the palette in the output format*/
+} png_dsc_t;
 
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header);
 static lv_res_t decoder_open(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf);
+static lv_res_t decoder_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, uint8_t * buf);
 static void decoder_close(lv_img_decoder_t * dec, lv_img_decoder_dsc_t * dsc);
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt);
+static lv_res_t stream_open(lv_png_stream_t * s, const void * src);
+static lv_res_t decode_interlaced(lv_img_decoder_dsc_t * dsc, bool alpha);
+static void convert_row(const png_dsc_t * png, uint32_t x, uint32_t len, uint8_t * buf);
+static void convert_color_depth(uint8_t * img, uint32_t px_cnt, bool alpha);
 
 /**********************
  *  STATIC VARIABLES
@@ -49,7 +61,12 @@ void lv_png_init(void)
     lv_img_decoder_t * dec = lv_img_decoder_create();
     lv_img_decoder_set_info_cb(dec, decoder_info);
     lv_img_decoder_set_open_cb(dec, decoder_open);
+    lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+    lv_img_decoder_set_decode_cb(dec, decoder_decode);
     lv_img_decoder_set_close_cb(dec, decoder_close);
+
+    /*The PNGs in memory are decoded with `lv_mem_alloc` only*/
+    dec->thread_safe = 1;
 }
 
 /**********************
@@ -65,151 +82,126 @@ void lv_png_init(void)
 static lv_res_t decoder_info(struct _lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
 {
     (void) decoder; /*Unused*/
-    lv_img_src_t src_type = lv_img_src_get_type(src);          /*Get the source type*/
-
-    /*If it's a PNG file...*/
-    if(src_type == LV_IMG_SRC_FILE) {
-        const char * fn = src;
-        if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
-
-            /* Read the width and height from the file. They have a constant location:
-             * [16..23]: width
-             * [24..27]: height
-             */
-            uint32_t size[2];
-            lv_fs_file_t f;
-            lv_fs_res_t res = lv_fs_open(&f, fn, LV_FS_MODE_RD);
-            if(res != LV_FS_RES_OK) return LV_RES_INV;
-
-            lv_fs_seek(&f, 16, LV_FS_SEEK_SET);
-
-            uint32_t rn;
-            lv_fs_read(&f, &size, 8, &rn);
-            lv_fs_close(&f);
-
-            if(rn != 8) return LV_RES_INV;
-
-            /*Save the data in the header*/
-            header->always_zero = 0;
-            header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
-            /*The width and height are stored in Big endian format so convert them to little endian*/
-            header->w = (lv_coord_t)((size[0] & 0xff000000) >> 24) + ((size[0] & 0x00ff0000) >> 8);
-            header->h = (lv_coord_t)((size[1] & 0xff000000) >> 24) + ((size[1] & 0x00ff0000) >> 8);
-
-            return LV_RES_OK;
-        }
-    }
-    /*If it's a PNG file in a  C array...*/
-    else if(src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = src;
-        const uint32_t data_size = img_dsc->data_size;
-        const uint32_t * size = ((uint32_t *)img_dsc->data) + 4;
-        const uint8_t magic[] = {0x89, 0x50, 0x4e, 0x47, 0x0d, 0x0a, 0x1a, 0x0a};
-        if(data_size < sizeof(magic)) return LV_RES_INV;
-        if(memcmp(magic, img_dsc->data, sizeof(magic))) return LV_RES_INV;
-        header->always_zero = 0;
-
-        if(img_dsc->header.cf) {
-            header->cf = img_dsc->header.cf;       /*Save the color format*/
-        }
-        else {
-            header->cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
-        }
 
-        if(img_dsc->header.w) {
-            header->w = img_dsc->header.w;         /*Save the image width*/
-        }
-        else {
-            header->w = (lv_coord_t)((size[0] & 0xff000000) >> 24) + ((size[0] & 0x00ff0000) >> 8);
-        }
+    /*Read the header and look for transparent colors before the image data*/
+    lv_png_stream_t s;
+    if(stream_open(&s, src) != LV_RES_OK) return LV_RES_INV;
+    lv_png_stream_close(&s);
 
-        if(img_dsc->header.h) {
-            header->h = img_dsc->header.h;         /*Save the color height*/
-        }
-        else {
-            header->h = (lv_coord_t)((size[1] & 0xff000000) >> 24) + ((size[1] & 0x00ff0000) >> 8);
-        }
+    header->always_zero = 0;
+    header->cf = s.has_alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    header->w = (lv_coord_t)s.w;
+    header->h = (lv_coord_t)s.h;
 
-        return LV_RES_OK;
+    /*If it's a PNG file in a  C array the descriptor can tell the info*/
+    if(lv_img_src_get_type(src) == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        if(img_dsc->header.cf) header->cf = img_dsc->header.cf;
+        if(img_dsc->header.w) header->w = img_dsc->header.w;
+        if(img_dsc->header.h) header->h = img_dsc->header.h;
     }
 
-    return LV_RES_INV;         /*If didn't succeeded earlier then it's an error*/
+    return LV_RES_OK;
 }
 
 /**
- * Open a PNG image and return the decided image
- * @param src can be file name or pointer to a C array
- * @param style style of the image object (unused now but certain formats might use it)
- * @return pointer to the decoded image or `LV_IMG_DECODER_OPEN_FAIL` if failed
+ * Open a PNG image. The rows are decoded later, in `decoder_read_line` or `decoder_decode`.
+ * Only the interlaced images are decoded at once.
+ * @param decoder pointer to the decoder
+ * @param dsc pointer to the decoder descriptor
+ * @return LV_RES_OK: the image is opened; LV_RES_INV: the image can't be decoded
  */
 static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
-
     (void) decoder; /*Unused*/
-    uint32_t error;                 /*For the return values of PNG decoder functions*/
 
-    uint8_t * img_data = NULL;
-
-    /*If it's a PNG file...*/
-    if(dsc->src_type == LV_IMG_SRC_FILE) {
-        const char * fn = dsc->src;
-        if(strcmp(lv_fs_get_ext(fn), "png") == 0) {              /*Check the extension*/
+    png_dsc_t * png = lv_mem_alloc(sizeof(png_dsc_t));
+    LV_ASSERT_MALLOC(png);
+    if(png == NULL) return LV_RES_INV;
+    lv_memset_00(png, sizeof(png_dsc_t));
 
-            /*Load the PNG file into buffer. It's still compressed (not decoded)*/
-            unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
-            size_t png_data_size;          /*Size of `png_data` in bytes*/
+    lv_png_stream_t * s = &png->stream;
+    if(stream_open(s, dsc->src) != LV_RES_OK) {
+        lv_mem_free(png);
+        return LV_RES_INV;
+    }
 
-            error = lodepng_load_file(&png_data, &png_data_size, fn);   /*Load the file*/
-            if(error) {
-                LV_LOG_WARN("error %" LV_PRIu32 ": %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
-            }
+    /*The pixels are written in the size and format of the header*/
+    bool alpha = s->has_alpha;
+    dsc->header.cf = alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR;
+    if(s->w != (uint32_t)dsc->header.w || s->h != (uint32_t)dsc->header.h) {
+        LV_LOG_WARN("the size of the PNG (%" LV_PRIu32 "x%" LV_PRIu32 ") is not supported or doesn't match the header",
+                    s->w, s->h);
+        lv_png_stream_close(s);
+        lv_mem_free(png);
+        return LV_RES_INV;
+    }
 
-            /*Decode the PNG image*/
-            unsigned png_width;             /*Will be the width of the decoded image*/
-            unsigned png_height;            /*Will be the width of the decoded image*/
-
-            /*Decode the loaded image in ARGB8888 */
-            error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
-            lv_mem_free(png_data); /*Free the loaded file*/
-            if(error) {
-                if(img_data != NULL) {
-                    lv_mem_free(img_data);
-                }
-                LV_LOG_WARN("error %" LV_PRIu32 ": %s\n", error, lodepng_error_text(error));
-                return LV_RES_INV;
-            }
+    if(s->interlace) {
+        lv_png_stream_close(s);
+        lv_mem_free(png);
+        return decode_interlaced(dsc, alpha);
+    }
 
-            /*Convert the image to the system's color depth*/
-            convert_color_depth(img_data,  png_width * png_height);
-            dsc->img_data = img_data;
-            return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
+    if(s->color_type == LV_PNG_COLOR_PALETTE) {
+        /*Converted in place from RGBA*/
+        png->palette = lv_mem_alloc(256 * 4);
+        LV_ASSERT_MALLOC(png->palette);
+        if(png->palette == NULL) {
+            lv_png_stream_close(s);
+            lv_mem_free(png);
+            return LV_RES_INV;
         }
+        lv_memcpy(png->palette, s->palette, 256 * 4);
+        convert_color_depth(png->palette, 256, alpha);
     }
-    /*If it's a PNG file in a  C array...*/
-    else if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        const lv_img_dsc_t * img_dsc = dsc->src;
-        unsigned png_width;             /*No used, just required by he decoder*/
-        unsigned png_height;            /*No used, just required by he decoder*/
 
-        /*Decode the image in ARGB8888 */
-        error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
+    dsc->img_data = NULL;
+    dsc->user_data = png;
+    return LV_RES_OK;
+}
 
-        if(error) {
-            if(img_data != NULL) {
-                lv_mem_free(img_data);
-            }
-            return LV_RES_INV;
-        }
+/**
+ * Decode `len` pixels of a row. The rows are decoded forward, an earlier row is decoded from the first row again.
+ */
+static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc,
+                                  lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    png_dsc_t * png = dsc->user_data;
+    if(png == NULL) return LV_RES_INV;
+
+    lv_png_stream_t * s = &png->stream;
+    if(s->row_idx > (uint32_t)y + 1 && lv_png_stream_rewind(s) != LV_RES_OK) return LV_RES_INV;
+    while(s->row_idx <= (uint32_t)y) {
+        if(lv_png_stream_read_row(s) != LV_RES_OK) return LV_RES_INV;
+    }
 
-        /*Convert the image to the system's color depth*/
-        convert_color_depth(img_data,  png_width * png_height);
+    convert_row(png, x, len, buf);
+    return LV_RES_OK;
+}
 
-        dsc->img_data = img_data;
-        return LV_RES_OK;     /*Return with its pointer*/
+/**
+ * Decode the whole image into a buffer of the caller
+ */
+static lv_res_t decoder_decode(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    png_dsc_t * png = dsc->user_data;
+    if(png == NULL) return LV_RES_INV;
+
+    lv_png_stream_t * s = &png->stream;
+    if(s->row_idx && lv_png_stream_rewind(s) != LV_RES_OK) return LV_RES_INV;
+
+    uint32_t line_size = s->w * (s->has_alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t));
+    uint32_t y;
+    for(y = 0; y < s->h; y++) {
+        if(lv_png_stream_read_row(s) != LV_RES_OK) return LV_RES_INV;
+        convert_row(png, 0, s->w, buf);
+        buf += line_size;
     }
 
-    return LV_RES_INV;    /*If not returned earlier then it failed*/
+    return LV_RES_OK;
 }
 
 /**
@@ -218,58 +210,203 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
 static void decoder_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
 {
     LV_UNUSED(decoder); /*Unused*/
+    if(dsc->user_data) {
+        png_dsc_t * png = dsc->user_data;
+        lv_png_stream_close(&png->stream);
+        if(png->palette) lv_mem_free(png->palette);
+        lv_mem_free(png);
+        dsc->user_data = NULL;
+    }
+
     if(dsc->img_data) {
         lv_mem_free((uint8_t *)dsc->img_data);
         dsc->img_data = NULL;
     }
 }
 
+static lv_res_t stream_open(lv_png_stream_t * s, const void * src)
+{
+    lv_img_src_t src_type = lv_img_src_get_type(src);
+    if(src_type == LV_IMG_SRC_FILE) {
+        if(strcmp(lv_fs_get_ext(src), "png") != 0) return LV_RES_INV;
+        return lv_png_stream_open_file(s, src);
+    }
+    else if(src_type == LV_IMG_SRC_VARIABLE) {
+        const lv_img_dsc_t * img_dsc = src;
+        return lv_png_stream_open_data(s, img_dsc->data, img_dsc->data_size);
+    }
+
+    return LV_RES_INV;
+}
+
 /**
- * If the display is not in 32 bit format (ARGB888) then covert the image to the current color depth
- * @param img the ARGB888 image
- * @param px_cnt number of pixels in `img`
+ * Adam7 interlaced images can't be decoded row by row, decode them at once with LodePNG
  */
-static void convert_color_depth(uint8_t * img, uint32_t px_cnt)
+static lv_res_t decode_interlaced(lv_img_decoder_dsc_t * dsc, bool alpha)
 {
-#if LV_COLOR_DEPTH == 32
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
-    lv_color_t * img_c = (lv_color_t *) img;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img_c[i].ch.red = c.ch.blue;
-        img_c[i].ch.blue = c.ch.red;
+    uint32_t error;                 /*For the return values of PNG decoder functions*/
+    uint8_t * img_data = NULL;
+    unsigned png_width;
+    unsigned png_height;
+
+    if(dsc->src_type == LV_IMG_SRC_FILE) {
+        /*Load the PNG file into buffer. It's still compressed (not decoded)*/
+        unsigned char * png_data;      /*Pointer to the loaded data. Same as the original file just loaded into the RAM*/
+        size_t png_data_size;          /*Size of `png_data` in bytes*/
+
+        error = lodepng_load_file(&png_data, &png_data_size, dsc->src);   /*Load the file*/
+        if(error) {
+            LV_LOG_WARN("error %" LV_PRIu32 ": %s\n", error, lodepng_error_text(error));
+            return LV_RES_INV;
+        }
+
+        /*Decode the loaded image in ARGB8888 */
+        error = lodepng_decode32(&img_data, &png_width, &png_height, png_data, png_data_size);
+        lv_mem_free(png_data); /*Free the loaded file*/
     }
+    else {
+        const lv_img_dsc_t * img_dsc = dsc->src;
+        error = lodepng_decode32(&img_data, &png_width, &png_height, img_dsc->data, img_dsc->data_size);
+    }
+
+    if(error) {
+        if(img_data != NULL) {
+            lv_mem_free(img_data);
+        }
+        LV_LOG_WARN("error %" LV_PRIu32 ": %s\n", error, lodepng_error_text(error));
+        return LV_RES_INV;
+    }
+
+    /*Convert the image to the system's color depth*/
+    convert_color_depth(img_data, png_width * png_height, alpha);
+    dsc->img_data = img_data;
+    return LV_RES_OK;     /*The image is fully decoded. Return with its pointer*/
+}
+
+static inline void put_px(uint8_t * buf, uint8_t r, uint8_t g, uint8_t b, uint8_t a, bool alpha)
+{
+    lv_color_t c = lv_color_make(r, g, b);
+#if LV_COLOR_DEPTH == 32
+    c.ch.alpha = a;
+    lv_memcpy_small(buf, &c, sizeof(c));
+    LV_UNUSED(alpha);
 #elif LV_COLOR_DEPTH == 16
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
+    buf[0] = c.full & 0xFF;
+    buf[1] = c.full >> 8;
+    if(alpha) buf[2] = a;
+#else
+    buf[0] = c.full;
+    if(alpha) buf[1] = a;
+#endif
+}
+
+static inline uint32_t get_sample(const uint8_t * row, uint32_t i, uint32_t bit_depth)
+{
+    uint32_t bit = i * bit_depth;
+    return (row[bit >> 3] >> (8 - bit_depth - (bit & 7))) & ((1 << bit_depth) - 1);
+}
+
+/**
+ * Convert `len` pixels of the last decoded row from the `x`th pixel to the system's color depth
+ */
+static void convert_row(const png_dsc_t * png, uint32_t x, uint32_t len, uint8_t * buf)
+{
+    const lv_png_stream_t * s = &png->stream;
+    const uint8_t * row = s->row;
+    bool alpha = s->has_alpha;
+    uint32_t px_size = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
     uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.blue, img_argb[i].ch.green, img_argb[i].ch.red);
-        img[i * 3 + 2] = img_argb[i].ch.alpha;
-        img[i * 3 + 1] = c.full >> 8;
-        img[i * 3 + 0] = c.full & 0xFF;
+
+    /*The 16-bit samples are rounded to their most significant byte but they are compared with the key in full*/
+    if(s->color_type == LV_PNG_COLOR_RGBA) {
+        if(s->bit_depth == 8) {
+            const uint8_t * p = row + x * 4;
+            for(i = 0; i < len; i++, p += 4, buf += px_size) put_px(buf, p[0], p[1], p[2], p[3], alpha);
+        }
+        else {
+            const uint8_t * p = row + x * 8;
+            for(i = 0; i < len; i++, p += 8, buf += px_size) put_px(buf, p[0], p[2], p[4], p[6], alpha);
+        }
     }
-#elif LV_COLOR_DEPTH == 8
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    lv_color_t c;
-    uint32_t i;
-    for(i = 0; i < px_cnt; i++) {
-        c = lv_color_make(img_argb[i].ch.red, img_argb[i].ch.green, img_argb[i].ch.blue);
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = c.full;
+    else if(s->color_type == LV_PNG_COLOR_RGB) {
+        if(s->bit_depth == 8) {
+            const uint8_t * p = row + x * 3;
+            for(i = 0; i < len; i++, p += 3, buf += px_size) {
+                bool key = s->has_key && p[0] == s->key[0] && p[1] == s->key[1] && p[2] == s->key[2];
+                put_px(buf, p[0], p[1], p[2], key ? 0 : 0xFF, alpha);
+            }
+        }
+        else {
+            const uint8_t * p = row + x * 6;
+            for(i = 0; i < len; i++, p += 6, buf += px_size) {
+                bool key = s->has_key && ((p[0] << 8) | p[1]) == s->key[0] && ((p[2] << 8) | p[3]) == s->key[1] &&
+                           ((p[4] << 8) | p[5]) == s->key[2];
+                put_px(buf, p[0], p[2], p[4], key ? 0 : 0xFF, alpha);
+            }
+        }
+    }
+    else if(s->color_type == LV_PNG_COLOR_PALETTE) {
+        const uint8_t * palette = png->palette;
+        if(s->bit_depth == 8) {
+            const uint8_t * p = row + x;
+            for(i = 0; i < len; i++, buf += px_size) lv_memcpy_small(buf, &palette[p[i] * px_size], px_size);
+        }
+        else {
+            for(i = 0; i < len; i++, buf += px_size) {
+                uint32_t idx = get_sample(row, x + i, s->bit_depth);
+                lv_memcpy_small(buf, &palette[idx * px_size], px_size);
+            }
+        }
+    }
+    else if(s->color_type == LV_PNG_COLOR_GRAY_ALPHA) {
+        uint32_t step = s->bit_depth == 8 ? 2 : 4;
+        const uint8_t * p = row + x * step;
+        for(i = 0; i < len; i++, p += step, buf += px_size) put_px(buf, p[0], p[0], p[0], p[step / 2], alpha);
     }
-#elif LV_COLOR_DEPTH == 1
-    lv_color32_t * img_argb = (lv_color32_t *)img;
-    uint8_t b;
+    else {
+        if(s->bit_depth == 8) {
+            const uint8_t * p = row + x;
+            for(i = 0; i < len; i++, buf += px_size) {
+                bool key = s->has_key && p[i] == s->key[0];
+                put_px(buf, p[i], p[i], p[i], key ? 0 : 0xFF, alpha);
+            }
+        }
+        else if(s->bit_depth == 16) {
+            const uint8_t * p = row + x * 2;
+            for(i = 0; i < len; i++, p += 2, buf += px_size) {
+                bool key = s->has_key && ((p[0] << 8) | p[1]) == s->key[0];
+                put_px(buf, p[0], p[0], p[0], key ? 0 : 0xFF, alpha);
+            }
+        }
+        else {
+            uint32_t max = (1 << s->bit_depth) - 1;
+            for(i = 0; i < len; i++, buf += px_size) {
+                uint32_t v = get_sample(row, x + i, s->bit_depth);
+                uint8_t gray = (uint8_t)(v * 255 / max);
+                put_px(buf, gray, gray, gray, s->has_key && v == s->key[0] ? 0 : 0xFF, alpha);
+            }
+        }
+    }
+}
+
+/**
+ * Convert an RGBA8888 image in place to the system's color depth
+ * @param img the RGBA8888 image
+ * @param px_cnt number of pixels in `img`
+ * @param alpha true: keep the alpha channel (LV_IMG_CF_TRUE_COLOR_ALPHA); false: drop it (LV_IMG_CF_TRUE_COLOR)
+ */
+static void convert_color_depth(uint8_t * img, uint32_t px_cnt, bool alpha)
+{
+    uint32_t px_size = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
     uint32_t i;
     for(i = 0; i < px_cnt; i++) {
-        b = img_argb[i].ch.red | img_argb[i].ch.green | img_argb[i].ch.blue;
-        img[i * 2 + 1] = img_argb[i].ch.alpha;
-        img[i * 2 + 0] = b > 128 ? 1 : 0;
+        /*The output is never larger than the input so it can be written to the same buffer*/
+        uint8_t r = img[i * 4 + 0];
+        uint8_t g = img[i * 4 + 1];
+        uint8_t b = img[i * 4 + 2];
+        uint8_t a = img[i * 4 + 3];
+        put_px(&img[i * px_size], r, g, b, a, alpha);
     }
-#endif
 }
 
 #endif /*LV_USE_PNG*/
@@ -0,0 +1,791 @@
+/**
+ * @file lv_png_stream.c
+ * The compressed data is read through a small buffer and inflated into a sliding window,
+ * so besides the window only two rows are kept in the memory.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lvgl.h"
+#if LV_USE_PNG
+
+#include "lv_png_stream.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+#define IN_BUF_SIZE     512
+#define FAST_BITS       9       /*The codes not longer than this are decoded with one table lookup*/
+#define MAX_BITS        15
+#define LIT_CNT_MAX     288
+#define DIST_CNT_MAX    32
+
+#define CHUNK_TYPE(a, b, c, d)  (((uint32_t)(a) << 24) | ((uint32_t)(b) << 16) | ((uint32_t)(c) << 8) | (uint32_t)(d))
+#define CHUNK_IHDR  CHUNK_TYPE('I', 'H', 'D', 'R')
+#define CHUNK_PLTE  CHUNK_TYPE('P', 'L', 'T', 'E')
+#define CHUNK_TRNS  CHUNK_TYPE('t', 'R', 'N', 'S')
+#define CHUNK_IDAT  CHUNK_TYPE('I', 'D', 'A', 'T')
+#define CHUNK_IEND  CHUNK_TYPE('I', 'E', 'N', 'D')
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Canonical Huffman code with a lookup table for the short codes*/
+typedef struct {
+    uint16_t fast[1 << FAST_BITS];  /*symbol << 4 | length of the codes not longer than FAST_BITS, 0: longer code*/
+    uint16_t count[MAX_BITS + 1];   /*Number of codes of each length*/
+    uint16_t symbol[LIT_CNT_MAX];   /*The symbols ordered by their codes*/
+} huff_t;
+
+typedef enum {
+    BLOCK_NONE,         /*The header of the next block comes*/
+    BLOCK_STORED,
+    BLOCK_HUFFMAN,
+    BLOCK_END,          /*The last block is finished*/
+} block_t;
+
+typedef struct _lv_png_inflate_t {
+    huff_t lit;
+    huff_t dist;
+    uint8_t * window;           /*The last inflated bytes for the back references*/
+    uint32_t window_mask;
+    uint32_t out_cnt;           /*Number of inflated bytes*/
+    uint32_t bit_buf;
+    uint8_t bit_cnt;
+    uint8_t block;              /*A `block_t`*/
+    uint8_t final;              /*1: the current block is the last one*/
+    uint8_t error;
+    uint8_t idat_end;           /*1: there are no more IDAT chunks*/
+    uint32_t stored_left;       /*Bytes left from a stored block*/
+    uint32_t match_len;         /*Bytes left from a back reference*/
+    uint32_t match_dist;
+} inflate_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static lv_res_t read_chunks(lv_png_stream_t * s);
+static lv_res_t decode_start(lv_png_stream_t * s);
+static lv_res_t zlib_header(lv_png_stream_t * s, uint32_t * window_size);
+static lv_res_t inflate_read(lv_png_stream_t * s, uint8_t * dst, uint32_t len);
+static lv_res_t read_block_header(lv_png_stream_t * s);
+static lv_res_t read_dynamic_codes(lv_png_stream_t * s);
+static lv_res_t huff_build(huff_t * h, const uint8_t * lens, uint32_t n);
+static lv_res_t unfilter(uint8_t * row, const uint8_t * prev, uint32_t stride, uint32_t bpp, uint8_t type);
+static lv_res_t src_read(lv_png_stream_t * s, uint8_t * buf, uint32_t len);
+static lv_res_t src_skip(lv_png_stream_t * s, uint32_t len);
+static lv_res_t src_seek(lv_png_stream_t * s, uint32_t pos);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static const uint16_t len_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31, 35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+
+static const uint8_t len_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+
+static const uint16_t dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193, 257, 385, 513, 769, 1025, 1537, 2049, 3073,
+    4097, 6145, 8193, 12289, 16385, 24577
+};
+
+static const uint8_t dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+lv_res_t lv_png_stream_open_file(lv_png_stream_t * s, const char * path)
+{
+    lv_memset_00(s, sizeof(lv_png_stream_t));
+
+    if(lv_fs_open(&s->f, path, LV_FS_MODE_RD) != LV_FS_RES_OK) return LV_RES_INV;
+    s->is_file = true;
+
+    s->in_buf = lv_mem_alloc(IN_BUF_SIZE);
+    LV_ASSERT_MALLOC(s->in_buf);
+    if(s->in_buf == NULL || read_chunks(s) != LV_RES_OK) {
+        lv_png_stream_close(s);
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_png_stream_open_data(lv_png_stream_t * s, const uint8_t * data, uint32_t size)
+{
+    lv_memset_00(s, sizeof(lv_png_stream_t));
+
+    s->data = data;
+    s->data_size = size;
+    s->in = data;
+    s->in_left = size;
+
+    if(read_chunks(s) != LV_RES_OK) {
+        lv_png_stream_close(s);
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+lv_res_t lv_png_stream_read_row(lv_png_stream_t * s)
+{
+    if(s->interlace || s->row_idx >= s->h) return LV_RES_INV;
+    if(s->inflate == NULL && decode_start(s) != LV_RES_OK) return LV_RES_INV;
+
+    /*The filters use the previous row*/
+    uint8_t * tmp = s->prev_row;
+    s->prev_row = s->row;
+    s->row = tmp;
+
+    uint8_t filter;
+    if(inflate_read(s, &filter, 1) != LV_RES_OK) return LV_RES_INV;
+    if(inflate_read(s, s->row, s->stride) != LV_RES_OK) return LV_RES_INV;
+    if(unfilter(s->row, s->prev_row, s->stride, s->filter_bpp, filter) != LV_RES_OK) {
+        s->inflate->error = 1;
+        return LV_RES_INV;
+    }
+
+    s->row_idx++;
+    return LV_RES_OK;
+}
+
+lv_res_t lv_png_stream_rewind(lv_png_stream_t * s)
+{
+    s->row_idx = 0;
+
+    /*Nothing was read yet*/
+    if(s->inflate == NULL) return LV_RES_OK;
+
+    inflate_t * z = s->inflate;
+    z->out_cnt = 0;
+    z->bit_buf = 0;
+    z->bit_cnt = 0;
+    z->block = BLOCK_NONE;
+    z->final = 0;
+    z->error = 0;
+    z->idat_end = 0;
+    z->stored_left = 0;
+    z->match_len = 0;
+    lv_memset_00(s->row, s->stride);
+    lv_memset_00(s->prev_row, s->stride);
+
+    s->chunk_left = s->idat_len;
+    uint32_t window_size;
+    if(src_seek(s, s->idat_pos) != LV_RES_OK || zlib_header(s, &window_size) != LV_RES_OK) {
+        z->error = 1;
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+void lv_png_stream_close(lv_png_stream_t * s)
+{
+    if(s->is_file) {
+        lv_fs_close(&s->f);
+        s->is_file = false;
+    }
+
+    if(s->inflate) {
+        if(s->inflate->window) lv_mem_free(s->inflate->window);
+        lv_mem_free(s->inflate);
+        s->inflate = NULL;
+    }
+
+    /*`prev_row` is in the same buffer*/
+    if(s->row) lv_mem_free(LV_MIN(s->row, s->prev_row));
+    s->row = NULL;
+    s->prev_row = NULL;
+
+    if(s->palette) lv_mem_free(s->palette);
+    s->palette = NULL;
+
+    if(s->in_buf) lv_mem_free(s->in_buf);
+    s->in_buf = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+
+/*Read the header and the chunks until the first IDAT chunk*/
+static lv_res_t read_chunks(lv_png_stream_t * s)
+{
+    static const uint8_t signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    static const uint8_t channels[7] = {1, 0, 3, 1, 2, 0, 4};
+
+    /*Signature, IHDR length and type, IHDR data, CRC*/
+    uint8_t head[8 + 8 + 13 + 4];
+    if(src_read(s, head, sizeof(head)) != LV_RES_OK) return LV_RES_INV;
+    if(memcmp(head, signature, sizeof(signature)) != 0) return LV_RES_INV;
+    if(get_u32(&head[8]) != 13 || get_u32(&head[12]) != CHUNK_IHDR) return LV_RES_INV;
+
+    s->w = get_u32(&head[16]);
+    s->h = get_u32(&head[20]);
+    s->bit_depth = head[24];
+    s->color_type = head[25];
+    s->interlace = head[28];
+
+    uint8_t bd = s->bit_depth;
+    bool bd_ok;
+    switch(s->color_type) {
+        case LV_PNG_COLOR_GRAY:
+            bd_ok = bd == 1 || bd == 2 || bd == 4 || bd == 8 || bd == 16;
+            break;
+        case LV_PNG_COLOR_PALETTE:
+            bd_ok = bd == 1 || bd == 2 || bd == 4 || bd == 8;
+            break;
+        case LV_PNG_COLOR_RGB:
+        case LV_PNG_COLOR_GRAY_ALPHA:
+        case LV_PNG_COLOR_RGBA:
+            bd_ok = bd == 8 || bd == 16;
+            break;
+        default:
+            bd_ok = false;
+    }
+
+    /*Compression, filter and interlace methods*/
+    if(!bd_ok || head[26] != 0 || head[27] != 0 || s->interlace > 1) return LV_RES_INV;
+    if(s->w == 0 || s->h == 0 || s->w > 0x7FFFFF || s->h > 0x7FFFFF) return LV_RES_INV;
+
+    uint32_t px_bits = channels[s->color_type] * bd;
+    s->stride = (s->w * px_bits + 7) / 8;
+    s->filter_bpp = px_bits < 8 ? 1 : px_bits / 8;
+
+    while(1) {
+        uint8_t chunk[8];
+        if(src_read(s, chunk, sizeof(chunk)) != LV_RES_OK) return LV_RES_INV;
+        uint32_t len = get_u32(&chunk[0]);
+        uint32_t type = get_u32(&chunk[4]);
+
+        if(type == CHUNK_IDAT) {
+            s->idat_pos = s->pos;
+            s->idat_len = len;
+            s->chunk_left = len;
+            break;
+        }
+        else if(type == CHUNK_IEND) {
+            return LV_RES_INV;
+        }
+        else if(type == CHUNK_PLTE) {
+            if(len % 3 != 0 || len > 256 * 3 || s->palette) return LV_RES_INV;
+            /*The colors missing from the palette are opaque black*/
+            s->palette = lv_mem_alloc(256 * 4);
+            LV_ASSERT_MALLOC(s->palette);
+            if(s->palette == NULL) return LV_RES_INV;
+            uint32_t i;
+            for(i = 0; i < 256; i++) {
+                s->palette[i][0] = 0;
+                s->palette[i][1] = 0;
+                s->palette[i][2] = 0;
+                s->palette[i][3] = 0xFF;
+            }
+            s->palette_size = len / 3;
+            for(i = 0; i < s->palette_size; i++) {
+                if(src_read(s, s->palette[i], 3) != LV_RES_OK) return LV_RES_INV;
+            }
+        }
+        else if(type == CHUNK_TRNS) {
+            if(s->color_type == LV_PNG_COLOR_PALETTE) {
+                if(s->palette == NULL || len > s->palette_size) return LV_RES_INV;
+                uint32_t i;
+                for(i = 0; i < len; i++) {
+                    if(src_read(s, &s->palette[i][3], 1) != LV_RES_OK) return LV_RES_INV;
+                    if(s->palette[i][3] != 0xFF) s->has_alpha = 1;
+                }
+            }
+            else if(s->color_type == LV_PNG_COLOR_GRAY || s->color_type == LV_PNG_COLOR_RGB) {
+                uint32_t key_cnt = s->color_type == LV_PNG_COLOR_GRAY ? 1 : 3;
+                uint8_t key[6];
+                if(len != key_cnt * 2 || src_read(s, key, len) != LV_RES_OK) return LV_RES_INV;
+                uint32_t i;
+                for(i = 0; i < key_cnt; i++) s->key[i] = ((uint16_t)key[i * 2] << 8) | key[i * 2 + 1];
+                s->has_key = 1;
+                s->has_alpha = 1;
+            }
+            else {
+                return LV_RES_INV;
+            }
+        }
+        else {
+            if(src_skip(s, len) != LV_RES_OK) return LV_RES_INV;
+        }
+
+        /*CRC*/
+        if(src_skip(s, 4) != LV_RES_OK) return LV_RES_INV;
+    }
+
+    if(s->color_type == LV_PNG_COLOR_PALETTE && s->palette == NULL) return LV_RES_INV;
+    if(s->color_type == LV_PNG_COLOR_GRAY_ALPHA || s->color_type == LV_PNG_COLOR_RGBA) s->has_alpha = 1;
+
+    return LV_RES_OK;
+}
+
+/*Allocate the buffers at the first row*/
+static lv_res_t decode_start(lv_png_stream_t * s)
+{
+    inflate_t * z = lv_mem_alloc(sizeof(inflate_t));
+    LV_ASSERT_MALLOC(z);
+    if(z == NULL) return LV_RES_INV;
+    lv_memset_00(z, sizeof(inflate_t));
+    s->inflate = z;
+
+    /*On error `inflate` stays allocated with `error` set, so the next rows fail too*/
+    s->row = lv_mem_alloc(s->stride * 2);
+    LV_ASSERT_MALLOC(s->row);
+    if(s->row == NULL) {
+        z->error = 1;
+        return LV_RES_INV;
+    }
+    s->prev_row = s->row + s->stride;
+    lv_memset_00(s->row, s->stride * 2);
+
+    uint32_t window_size;
+    if(zlib_header(s, &window_size) != LV_RES_OK) {
+        z->error = 1;
+        return LV_RES_INV;
+    }
+
+    /*The references can't point before the start of the data so a small image needs a smaller window*/
+    uint32_t raw_size = s->h * (s->stride + 1);
+    if(raw_size / s->h != s->stride + 1) raw_size = UINT32_MAX;
+    while(window_size > 256 && window_size / 2 >= raw_size) window_size /= 2;
+
+    z->window = lv_mem_alloc(window_size);
+    LV_ASSERT_MALLOC(z->window);
+    if(z->window == NULL) {
+        z->error = 1;
+        return LV_RES_INV;
+    }
+    z->window_mask = window_size - 1;
+
+    return LV_RES_OK;
+}
+
+/*Get the next byte of the zlib stream from the IDAT chunks*/
+static int32_t next_byte(lv_png_stream_t * s)
+{
+    inflate_t * z = s->inflate;
+    while(s->chunk_left == 0) {
+        if(z->idat_end) return -1;
+
+        /*CRC of the previous chunk, length and type of the next one*/
+        uint8_t head[12];
+        if(src_read(s, head, sizeof(head)) != LV_RES_OK || get_u32(&head[8]) != CHUNK_IDAT) {
+            z->idat_end = 1;
+            return -1;
+        }
+        s->chunk_left = get_u32(&head[4]);
+    }
+
+    if(s->in_left == 0 && src_read(s, NULL, 0) != LV_RES_OK) return -1;
+
+    s->chunk_left--;
+    s->in_left--;
+    s->pos++;
+    return *s->in++;
+}
+
+static lv_res_t zlib_header(lv_png_stream_t * s, uint32_t * window_size)
+{
+    int32_t cmf = next_byte(s);
+    int32_t flg = next_byte(s);
+    if(cmf < 0 || flg < 0) return LV_RES_INV;
+
+    /*Deflate with at most 32 kB window, without preset dictionary*/
+    if((cmf & 0x0F) != 8 || (cmf >> 4) > 7 || (cmf * 256 + flg) % 31 != 0 || (flg & 0x20)) return LV_RES_INV;
+
+    *window_size = (uint32_t)1 << ((cmf >> 4) + 8);
+    return LV_RES_OK;
+}
+
+/*Have as many bits as possible, but at least 25 if the data isn't finished*/
+static inline void fill_bits(lv_png_stream_t * s, inflate_t * z)
+{
+    while(z->bit_cnt <= 24) {
+        int32_t b = next_byte(s);
+        if(b < 0) return;
+        z->bit_buf |= (uint32_t)b << z->bit_cnt;
+        z->bit_cnt += 8;
+    }
+}
+
+static inline uint32_t get_bits(lv_png_stream_t * s, inflate_t * z, uint32_t n)
+{
+    if(z->bit_cnt < n) {
+        fill_bits(s, z);
+        if(z->bit_cnt < n) {
+            z->error = 1;
+            return 0;
+        }
+    }
+
+    uint32_t v = z->bit_buf & (((uint32_t)1 << n) - 1);
+    z->bit_buf >>= n;
+    z->bit_cnt -= n;
+    return v;
+}
+
+static inline uint32_t decode_sym(lv_png_stream_t * s, inflate_t * z, const huff_t * h)
+{
+    if(z->bit_cnt < MAX_BITS) fill_bits(s, z);
+
+    uint32_t e = h->fast[z->bit_buf & ((1 << FAST_BITS) - 1)];
+    if(e && (e & 0x0F) <= z->bit_cnt) {
+        z->bit_buf >>= e & 0x0F;
+        z->bit_cnt -= e & 0x0F;
+        return e >> 4;
+    }
+
+    /*A longer code: go through the codes of each length. The codes are stored in reversed bit order.*/
+    uint32_t bits = z->bit_buf;
+    int32_t code = 0;
+    int32_t first = 0;
+    int32_t index = 0;
+    uint32_t len;
+    for(len = 1; len <= MAX_BITS && len <= z->bit_cnt; len++) {
+        code |= bits & 1;
+        bits >>= 1;
+        int32_t count = h->count[len];
+        if(code - count < first) {
+            z->bit_buf >>= len;
+            z->bit_cnt -= len;
+            return h->symbol[index + (code - first)];
+        }
+        index += count;
+        first += count;
+        first <<= 1;
+        code <<= 1;
+    }
+
+    z->error = 1;
+    return 0;
+}
+
+/*Inflate the next `len` bytes of the zlib stream*/
+static lv_res_t inflate_read(lv_png_stream_t * s, uint8_t * dst, uint32_t len)
+{
+    inflate_t * z = s->inflate;
+    uint8_t * window = z->window;
+    uint32_t mask = z->window_mask;
+
+    while(len) {
+        if(z->error) return LV_RES_INV;
+
+        if(z->match_len) {
+            uint32_t n = LV_MIN(len, z->match_len);
+            z->match_len -= n;
+            len -= n;
+            uint32_t from = z->out_cnt - z->match_dist;
+            uint32_t to = z->out_cnt;
+            z->out_cnt += n;
+            while(n--) {
+                uint8_t b = window[from++ & mask];
+                window[to++ & mask] = b;
+                *dst++ = b;
+            }
+        }
+        else if(z->block == BLOCK_HUFFMAN) {
+            uint32_t sym = decode_sym(s, z, &z->lit);
+            if(sym < 256) {
+                window[z->out_cnt++ & mask] = (uint8_t)sym;
+                *dst++ = (uint8_t)sym;
+                len--;
+            }
+            else if(sym == 256) {
+                z->block = z->final ? BLOCK_END : BLOCK_NONE;
+            }
+            else {
+                sym -= 257;
+                if(sym >= 29) return LV_RES_INV;
+                uint32_t match_len = len_base[sym] + get_bits(s, z, len_extra[sym]);
+                uint32_t d = decode_sym(s, z, &z->dist);
+                if(d >= 30) return LV_RES_INV;
+                uint32_t dist = dist_base[d] + get_bits(s, z, dist_extra[d]);
+                if(z->error || dist > z->out_cnt || dist > mask + 1) {
+                    z->error = 1;
+                    return LV_RES_INV;
+                }
+                z->match_len = match_len;
+                z->match_dist = dist;
+            }
+        }
+        else if(z->block == BLOCK_STORED) {
+            if(z->stored_left == 0) {
+                z->block = z->final ? BLOCK_END : BLOCK_NONE;
+                continue;
+            }
+            /*The bytes already in the bit buffer are taken first*/
+            uint8_t b = (uint8_t)get_bits(s, z, 8);
+            z->stored_left--;
+            window[z->out_cnt++ & mask] = b;
+            *dst++ = b;
+            len--;
+        }
+        else if(z->block == BLOCK_NONE) {
+            if(read_block_header(s) != LV_RES_OK) {
+                z->error = 1;
+                return LV_RES_INV;
+            }
+        }
+        else {
+            /*More rows than data*/
+            z->error = 1;
+            return LV_RES_INV;
+        }
+    }
+
+    return z->error ? LV_RES_INV : LV_RES_OK;
+}
+
+static lv_res_t read_block_header(lv_png_stream_t * s)
+{
+    inflate_t * z = s->inflate;
+    z->final = (uint8_t)get_bits(s, z, 1);
+    uint32_t type = get_bits(s, z, 2);
+    if(z->error) return LV_RES_INV;
+
+    if(type == 0) {
+        /*Skip to the byte boundary*/
+        get_bits(s, z, z->bit_cnt & 7);
+        uint32_t len = get_bits(s, z, 16);
+        uint32_t nlen = get_bits(s, z, 16);
+        if(z->error || (len ^ 0xFFFF) != nlen) return LV_RES_INV;
+        z->stored_left = len;
+        z->block = BLOCK_STORED;
+    }
+    else if(type == 1) {
+        uint8_t lens[LIT_CNT_MAX];
+        uint32_t i;
+        for(i = 0; i < 144; i++) lens[i] = 8;
+        for(; i < 256; i++) lens[i] = 9;
+        for(; i < 280; i++) lens[i] = 7;
+        for(; i < LIT_CNT_MAX; i++) lens[i] = 8;
+        huff_build(&z->lit, lens, LIT_CNT_MAX);
+
+        for(i = 0; i < 30; i++) lens[i] = 5;
+        huff_build(&z->dist, lens, 30);
+        z->block = BLOCK_HUFFMAN;
+    }
+    else if(type == 2) {
+        if(read_dynamic_codes(s) != LV_RES_OK) return LV_RES_INV;
+        z->block = BLOCK_HUFFMAN;
+    }
+    else {
+        return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+static lv_res_t read_dynamic_codes(lv_png_stream_t * s)
+{
+    static const uint8_t order[19] = {16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15};
+
+    inflate_t * z = s->inflate;
+    uint32_t lit_cnt = get_bits(s, z, 5) + 257;
+    uint32_t dist_cnt = get_bits(s, z, 5) + 1;
+    uint32_t clen_cnt = get_bits(s, z, 4) + 4;
+    if(z->error || lit_cnt > 286 || dist_cnt > 30) return LV_RES_INV;
+
+    uint8_t lens[LIT_CNT_MAX + DIST_CNT_MAX];
+    lv_memset_00(lens, 19);
+    uint32_t i;
+    for(i = 0; i < clen_cnt; i++) lens[order[i]] = (uint8_t)get_bits(s, z, 3);
+
+    /*The code of the code lengths is built temporarily in the distance code*/
+    if(z->error || huff_build(&z->dist, lens, 19) != LV_RES_OK) return LV_RES_INV;
+
+    i = 0;
+    while(i < lit_cnt + dist_cnt) {
+        uint32_t sym = decode_sym(s, z, &z->dist);
+        if(z->error) return LV_RES_INV;
+
+        if(sym < 16) {
+            lens[i++] = (uint8_t)sym;
+            continue;
+        }
+
+        uint8_t v = 0;
+        uint32_t rep;
+        if(sym == 16) {
+            if(i == 0) return LV_RES_INV;
+            v = lens[i - 1];
+            rep = 3 + get_bits(s, z, 2);
+        }
+        else if(sym == 17) {
+            rep = 3 + get_bits(s, z, 3);
+        }
+        else {
+            rep = 11 + get_bits(s, z, 7);
+        }
+
+        if(z->error || i + rep > lit_cnt + dist_cnt) return LV_RES_INV;
+        while(rep--) lens[i++] = v;
+    }
+
+    /*The end of block code is required*/
+    if(lens[256] == 0) return LV_RES_INV;
+
+    if(huff_build(&z->lit, lens, lit_cnt) != LV_RES_OK) return LV_RES_INV;
+    if(huff_build(&z->dist, lens + lit_cnt, dist_cnt) != LV_RES_OK) return LV_RES_INV;
+
+    return LV_RES_OK;
+}
+
+static lv_res_t huff_build(huff_t * h, const uint8_t * lens, uint32_t n)
+{
+    uint32_t i;
+    lv_memset_00(h->count, sizeof(h->count));
+    for(i = 0; i < n; i++) h->count[lens[i]]++;
+    h->count[0] = 0;
+
+    /*Over-subscribed codes are invalid, incomplete codes fail only when an unused code is met*/
+    int32_t left = 1;
+    uint32_t len;
+    for(len = 1; len <= MAX_BITS; len++) {
+        left <<= 1;
+        left -= h->count[len];
+        if(left < 0) return LV_RES_INV;
+    }
+
+    uint16_t offs[MAX_BITS + 2];
+    offs[1] = 0;
+    for(len = 1; len <= MAX_BITS; len++) offs[len + 1] = offs[len] + h->count[len];
+    for(i = 0; i < n; i++) {
+        if(lens[i]) h->symbol[offs[lens[i]]++] = (uint16_t)i;
+    }
+
+    /*Fill the entries of the short codes in the lookup table with every possible following bits*/
+    lv_memset_00(h->fast, sizeof(h->fast));
+    uint32_t code = 0;
+    uint32_t idx = 0;
+    for(len = 1; len <= FAST_BITS; len++) {
+        uint32_t k;
+        for(k = 0; k < h->count[len]; k++) {
+            uint32_t rev = 0;
+            uint32_t b;
+            for(b = 0; b < len; b++) rev |= ((code >> b) & 1) << (len - 1 - b);
+
+            uint16_t e = (uint16_t)((h->symbol[idx] << 4) | len);
+            for(; rev < (1 << FAST_BITS); rev += 1 << len) h->fast[rev] = e;
+            code++;
+            idx++;
+        }
+        code <<= 1;
+    }
+
+    return LV_RES_OK;
+}
+
+static inline uint8_t paeth(uint8_t a, uint8_t b, uint8_t c)
+{
+    int32_t p = (int32_t)a + b - c;
+    int32_t pa = LV_ABS(p - a);
+    int32_t pb = LV_ABS(p - b);
+    int32_t pc = LV_ABS(p - c);
+    if(pa <= pb && pa <= pc) return a;
+    if(pb <= pc) return b;
+    return c;
+}
+
+static lv_res_t unfilter(uint8_t * row, const uint8_t * prev, uint32_t stride, uint32_t bpp, uint8_t type)
+{
+    uint32_t i;
+    switch(type) {
+        case 0:
+            break;
+        case 1:
+            for(i = bpp; i < stride; i++) row[i] += row[i - bpp];
+            break;
+        case 2:
+            for(i = 0; i < stride; i++) row[i] += prev[i];
+            break;
+        case 3:
+            for(i = 0; i < bpp; i++) row[i] += prev[i] >> 1;
+            for(; i < stride; i++) row[i] += (uint8_t)(((uint32_t)row[i - bpp] + prev[i]) >> 1);
+            break;
+        case 4:
+            for(i = 0; i < bpp; i++) row[i] += prev[i];
+            for(; i < stride; i++) row[i] += paeth(row[i - bpp], prev[i], prev[i - bpp]);
+            break;
+        default:
+            return LV_RES_INV;
+    }
+
+    return LV_RES_OK;
+}
+
+/*Read `len` bytes from the PNG. With `len == 0` only refill the read buffer if it's empty.*/
+static lv_res_t src_read(lv_png_stream_t * s, uint8_t * buf, uint32_t len)
+{
+    do {
+        if(s->in_left == 0) {
+            if(!s->is_file) return LV_RES_INV;
+            uint32_t rn = 0;
+            if(lv_fs_read(&s->f, s->in_buf, IN_BUF_SIZE, &rn) != LV_FS_RES_OK || rn == 0) return LV_RES_INV;
+            s->in = s->in_buf;
+            s->in_left = rn;
+        }
+
+        uint32_t n = LV_MIN(len, s->in_left);
+        if(n) {
+            lv_memcpy(buf, s->in, n);
+            s->in += n;
+            s->in_left -= n;
+            s->pos += n;
+            buf += n;
+            len -= n;
+        }
+    } while(len);
+
+    return LV_RES_OK;
+}
+
+static lv_res_t src_skip(lv_png_stream_t * s, uint32_t len)
+{
+    if(len <= s->in_left) {
+        s->in += len;
+        s->in_left -= len;
+        s->pos += len;
+        return LV_RES_OK;
+    }
+
+    return src_seek(s, s->pos + len);
+}
+
+static lv_res_t src_seek(lv_png_stream_t * s, uint32_t pos)
+{
+    s->pos = pos;
+
+    if(s->is_file) {
+        s->in_left = 0;
+        return lv_fs_seek(&s->f, pos, LV_FS_SEEK_SET) == LV_FS_RES_OK ? LV_RES_OK : LV_RES_INV;
+    }
+
+    if(pos > s->data_size) return LV_RES_INV;
+    s->in = s->data + pos;
+    s->in_left = s->data_size - pos;
+    return LV_RES_OK;
+}
+
+#endif /*LV_USE_PNG*/
@@ -0,0 +1,124 @@
+/**
+ * @file lv_png_stream.h
+ * Decode the rows of a PNG image one by one, without loading the file or inflating the whole image.
+ */
+
+#ifndef LV_PNG_STREAM_H
+#define LV_PNG_STREAM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../../lv_conf_internal.h"
+#if LV_USE_PNG
+
+#include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_PNG_COLOR_GRAY           0
+#define LV_PNG_COLOR_RGB            2
+#define LV_PNG_COLOR_PALETTE        3
+#define LV_PNG_COLOR_GRAY_ALPHA     4
+#define LV_PNG_COLOR_RGBA           6
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_png_inflate_t;
+
+typedef struct {
+    /*Source*/
+    lv_fs_file_t f;
+    bool is_file;
+    const uint8_t * data;       /*The PNG file in memory if not `is_file`*/
+    uint32_t data_size;
+    uint8_t * in_buf;           /*Read buffer of the file*/
+    const uint8_t * in;         /*The next byte to read*/
+    uint32_t in_left;           /*Bytes available from `in`*/
+    uint32_t pos;               /*Position of `in` in the PNG*/
+    uint32_t idat_pos;          /*Position of the data of the first IDAT chunk*/
+    uint32_t idat_len;
+    uint32_t chunk_left;        /*Bytes left in the current IDAT chunk*/
+
+    /*Header*/
+    uint32_t w;
+    uint32_t h;
+    uint8_t bit_depth;
+    uint8_t color_type;         /*LV_PNG_COLOR_...*/
+    uint8_t interlace;          /*1: Adam7, the rows can't be streamed*/
+    uint8_t has_key;            /*1: tRNS of a gray or RGB image, the color `key` is transparent*/
+    uint8_t has_alpha;          /*1: the image has an alpha channel or transparent colors*/
+    uint8_t filter_bpp;         /*Bytes per pixel for the filters, at least 1*/
+    uint16_t key[3];
+    uint32_t stride;            /*Bytes per row without the filter type*/
+    uint8_t (*palette)[4];      /*256 RGBA colors or NULL*/
+    uint16_t palette_size;
+
+    /*Decoding*/
+    struct _lv_png_inflate_t * inflate;
+    uint8_t * row;              /*The last decoded row, `stride` bytes*/
+    uint8_t * prev_row;
+    uint32_t row_idx;           /*Index of the next row to decode*/
+} lv_png_stream_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Open a PNG file and read its header and the chunks before the image data
+ * @param s         pointer to a stream to initialize
+ * @param path      path to the file
+ * @return          LV_RES_OK: it's a valid PNG; LV_RES_INV: it can't be read or it's not a PNG
+ */
+lv_res_t lv_png_stream_open_file(lv_png_stream_t * s, const char * path);
+
+/**
+ * Open a PNG file loaded into the memory and read its header and the chunks before the image data
+ * @param s         pointer to a stream to initialize
+ * @param data      the PNG file. It needs to stay valid while the stream is open.
+ * @param size      size of `data` in bytes
+ * @return          LV_RES_OK: it's a valid PNG; LV_RES_INV: it's not a PNG
+ */
+lv_res_t lv_png_stream_open_data(lv_png_stream_t * s, const uint8_t * data, uint32_t size);
+
+/**
+ * Decode the next row of a non-interlaced PNG into `s->row`.
+ * The buffers of the decoding are allocated at the first call.
+ * @param s         pointer to an opened stream
+ * @return          LV_RES_OK: the row is decoded; LV_RES_INV: no more rows or invalid data
+ */
+lv_res_t lv_png_stream_read_row(lv_png_stream_t * s);
+
+/**
+ * Decode the rows again from the first one
+ * @param s         pointer to an opened stream
+ * @return          LV_RES_OK: success; LV_RES_INV: the file can't be read
+ */
+lv_res_t lv_png_stream_rewind(lv_png_stream_t * s);
+
+/**
+ * Close a stream and free its buffers
+ * @param s         pointer to a stream
+ */
+void lv_png_stream_close(lv_png_stream_t * s);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_PNG*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_PNG_STREAM_H*/
@@ -51,6 +51,7 @@
 #include "tjpgd.h"
 #include "lv_sjpg.h"
 #include "../../../misc/lv_fs.h"
+#include "../../../misc/lv_lru.h"
 
 /*********************
  *      DEFINES
@@ -65,6 +66,12 @@
 #define SJPEG_BLOCK_WIDTH_OFFSET        20
 #define SJPEG_FRAME_INFO_ARRAY_OFFSET   22
 
+/*Estimated size of a decoded fragment to size the hash table of the fragment cache*/
+#define AVG_FRAG_SIZE                   8192
+
+/*The decoded RGB888 pixels are stored after the fragment's header*/
+#define FRAG_PIXELS(frag)               ((uint8_t *)&(frag)[1])
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -85,6 +92,8 @@ typedef struct {
     uint32_t raw_sjpg_data_next_read_pos; //Used for all types.
 } io_source_t;
 
+typedef struct _frag_job_t frag_job_t;
+
 typedef struct {
     uint8_t * sjpeg_data;
     uint32_t sjpeg_data_size;
@@ -95,12 +104,45 @@ typedef struct {
     int sjpeg_cache_frame_index;
     uint8_t ** frame_base_array;        //to save base address of each split frames upto sjpeg_total_frames.
     int * frame_base_offset;            //to save base offset for fseek
-    uint8_t * frame_cache;
+    uint8_t * frame_cache;              //decoded fragment if it's not in the fragment cache
+    const uint8_t * frame_pixels;       //decoded pixels of `sjpeg_cache_frame_index`
     uint8_t * workb;                    //JPG work buffer for jpeg library
     JDEC * tjpeg_jd;
     io_source_t io;
+    uint32_t sjpeg_file_size;           //0 until it's needed to read the last fragment in advance
+    uint32_t access_cnt;                //number of times a new fragment was needed
+    int last_index;                     //the last needed fragment
+    int pass_start_index;               //the first fragment of the area being drawn
+    int8_t access_dir;                  //direction the drawn areas move in, 0 is handled as 1
+    frag_job_t * job;                   //the fragment being decoded in advance
 } SJPEG;
 
+typedef struct {
+    SJPEG * sjpeg;
+    int index;
+} frag_key_t;
+
+/*A decoded fragment in the cache. The pixels follow it*/
+typedef struct {
+    frag_key_t key;
+    lv_img_cache_free_cb_t free_cb;     /*NULL: allocated with `lv_mem_alloc`*/
+    uint32_t size;
+    bool prefetched;                    /*Decoded in advance and not drawn yet*/
+} frag_t;
+
+struct _frag_job_t {
+    lv_sjpg_job_t pub;                  /*First, so the jobs given to the worker can be converted back*/
+    JDEC jd;
+    uint32_t workb[TJPGD_WORKBUFF_SIZE / sizeof(uint32_t)];
+    io_source_t io;
+    uint8_t * src_buf;                  /*The compressed fragment read from a file*/
+    uint32_t src_buf_size;
+    frag_t * frag;
+    lv_sjpg_wait_cb_t wait_cb;          /*Not NULL if the job was given to the worker*/
+    bool ok;
+    bool pending;
+};
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -113,10 +155,37 @@ static size_t input_func(JDEC * jd, uint8_t * buff, size_t ndata);
 static int is_jpg(const uint8_t * raw_data, size_t len);
 static void lv_sjpg_cleanup(SJPEG * sjpeg);
 static void lv_sjpg_free(SJPEG * sjpeg);
+static const uint8_t * frame_get(SJPEG * sjpeg, int index);
+static JRESULT frame_decode(SJPEG * sjpeg, int index, uint8_t * out);
+static JRESULT frag_decode(JDEC * jd, void * workb, io_source_t * io, uint8_t * out);
+static uint32_t frag_data_size(SJPEG * sjpeg, int index);
+#if LV_SJPG_CACHE_DEF_BUDGET
+    static void cache_create(uint32_t budget);
+    static void cache_invalidate(SJPEG * sjpeg);
+    static frag_t * frag_create(SJPEG * sjpeg, int index);
+    static frag_t * frag_find(SJPEG * sjpeg, int index);
+    static void frag_add(frag_t * frag);
+    static void frag_free(frag_t * frag);
+    static void lru_value_free(void * v);
+    static void prefetch(SJPEG * sjpeg, int index);
+    static void job_finish(SJPEG * sjpeg, int needed);
+    static void job_cancel(SJPEG * sjpeg);
+    static void job_async_cb(void * p);
+    static void key_init(frag_key_t * key, SJPEG * sjpeg, int index);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_sjpg_cache_stats_t stats;
+#if LV_SJPG_CACHE_DEF_BUDGET
+    static lv_lru_t * frag_lru;
+    static lv_img_cache_alloc_cb_t mem_alloc_cb;
+    static lv_img_cache_free_cb_t mem_free_cb;
+    static lv_sjpg_submit_cb_t worker_submit_cb;
+    static lv_sjpg_wait_cb_t worker_wait_cb;
+    static bool invalidating;
+#endif
 
 /**********************
  *      MACROS
@@ -132,6 +201,109 @@ void lv_split_jpeg_init(void)
     lv_img_decoder_set_open_cb(dec, decoder_open);
     lv_img_decoder_set_close_cb(dec, decoder_close);
     lv_img_decoder_set_read_line_cb(dec, decoder_read_line);
+
+    lv_memset_00(&stats, sizeof(stats));
+#if LV_SJPG_CACHE_DEF_BUDGET
+    frag_lru = NULL;
+    mem_alloc_cb = NULL;
+    mem_free_cb = NULL;
+    worker_submit_cb = NULL;
+    worker_wait_cb = NULL;
+    cache_create(LV_SJPG_CACHE_DEF_BUDGET);
+#endif
+}
+
+/**
+ * Set the memory the decoded fragments of the JPGs can use.
+ * The least recently used fragments are removed to stay within the budget.
+ * @param budget    size in bytes. 0: keep only the current fragment of each image
+ */
+void lv_sjpg_set_cache_budget(uint32_t budget)
+{
+#if LV_SJPG_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(budget);
+    LV_LOG_WARN("Can't change the SJPG cache budget because it's disabled by LV_SJPG_CACHE_DEF_BUDGET = 0");
+#else
+    cache_create(budget);
+#endif
+}
+
+/**
+ * Set where the decoded fragments are stored. E.g. in external RAM.
+ * The cached fragments are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_sjpg_set_cache_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb)
+{
+#if LV_SJPG_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(alloc_cb);
+    LV_UNUSED(free_cb);
+    LV_LOG_WARN("Can't set the SJPG cache memory because it's disabled by LV_SJPG_CACHE_DEF_BUDGET = 0");
+#else
+    cache_invalidate(NULL);
+
+    /*The fragments being decoded in advance remember how to free themselves*/
+    mem_alloc_cb = free_cb ? alloc_cb : NULL;
+    mem_free_cb = free_cb;
+#endif
+}
+
+/**
+ * Decode the fragments in advance in another thread instead of the LVGL thread.
+ * @param submit_cb     function to pass a job to the worker or NULL to decode in `lv_timer_handler`
+ * @param wait_cb       function to wait for a submitted job
+ */
+void lv_sjpg_set_worker(lv_sjpg_submit_cb_t submit_cb, lv_sjpg_wait_cb_t wait_cb)
+{
+#if LV_SJPG_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(submit_cb);
+    LV_UNUSED(wait_cb);
+    LV_LOG_WARN("Can't set the SJPG worker because the fragments are not cached (LV_SJPG_CACHE_DEF_BUDGET = 0)");
+#else
+    /*The submitted jobs remember their `wait_cb`*/
+    worker_submit_cb = wait_cb ? submit_cb : NULL;
+    worker_wait_cb = wait_cb;
+#endif
+}
+
+/**
+ * Decode the fragment of a job. Can be called from any thread, it uses only the memory of the job.
+ * @param job       pointer to a job given to `submit_cb`
+ */
+void lv_sjpg_job_run(lv_sjpg_job_t * job)
+{
+#if LV_SJPG_CACHE_DEF_BUDGET
+    frag_job_t * fjob = (frag_job_t *)job;
+    fjob->io.raw_sjpg_data_next_read_pos = 0;
+    fjob->ok = frag_decode(&fjob->jd, fjob->workb, &fjob->io, FRAG_PIXELS(fjob->frag)) == JDR_OK;
+#endif
+    job->done = true;
+}
+
+/**
+ * Get the statistics of the fragment cache.
+ * @param stats_out     store the statistics here
+ */
+void lv_sjpg_get_cache_stats(lv_sjpg_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+#if LV_SJPG_CACHE_DEF_BUDGET
+    if(frag_lru) stats_out->size = (uint32_t)(frag_lru->total_memory - frag_lru->free_memory);
+#endif
+}
+
+/**
+ * Clear the counters of the fragment cache.
+ */
+void lv_sjpg_reset_cache_stats(void)
+{
+    stats.hits = 0;
+    stats.decodes = 0;
+    stats.prefetches = 0;
+    stats.worker_decodes = 0;
+    stats.prefetch_hits = 0;
+    stats.evictions = 0;
 }
 
 /**********************
@@ -395,13 +567,6 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[i] = sjpeg->frame_base_array[i - 1] + offset;
             }
             sjpeg->sjpeg_cache_frame_index = -1;
-            sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3/*2*/);
-            if(! sjpeg->frame_cache) {
-                lv_sjpg_cleanup(sjpeg);
-                sjpeg = NULL;
-                return LV_RES_INV;
-            }
-            sjpeg->io.img_cache_buff = sjpeg->frame_cache;
             sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
             sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
             if(! sjpeg->workb) {
@@ -457,14 +622,6 @@ static lv_res_t decoder_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t *
                 sjpeg->frame_base_array[0] = img_frame_base;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_sjpg_cleanup(sjpeg);
-                    sjpeg = NULL;
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -574,13 +731,6 @@ end:
                 }
 
                 sjpeg->sjpeg_cache_frame_index = -1; //INVALID AT BEGINNING for a forced compare mismatch at first time.
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -661,14 +811,6 @@ end:
                 sjpeg->frame_base_offset[0] = img_frame_start_offset;
 
                 sjpeg->sjpeg_cache_frame_index = -1;
-                sjpeg->frame_cache = (void *)lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
-                if(! sjpeg->frame_cache) {
-                    lv_fs_close(&lv_file);
-                    lv_sjpg_cleanup(sjpeg);
-                    return LV_RES_INV;
-                }
-
-                sjpeg->io.img_cache_buff = sjpeg->frame_cache;
                 sjpeg->io.img_cache_x_res = sjpeg->sjpeg_x_res;
                 sjpeg->workb =   lv_mem_alloc(TJPGD_WORKBUFF_SIZE);
                 if(! sjpeg->workb) {
@@ -717,141 +859,52 @@ static lv_res_t decoder_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc
                                   lv_coord_t len, uint8_t * buf)
 {
     LV_UNUSED(decoder);
-    if(dsc->src_type == LV_IMG_SRC_VARIABLE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
+    SJPEG * sjpeg = (SJPEG *) dsc->user_data;
+    if(sjpeg == NULL) return LV_RES_INV;
 
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[ sjpeg_req_frame_index ];
-            if(sjpeg_req_frame_index == (sjpeg->sjpeg_total_frames - 1)) {
-                /*This is the last frame. */
-                const uint32_t frame_offset = (uint32_t)(sjpeg->io.raw_sjpg_data - sjpeg->sjpeg_data);
-                sjpeg->io.raw_sjpg_data_size = sjpeg->sjpeg_data_size - frame_offset;
-            }
-            else {
-                sjpeg->io.raw_sjpg_data_size =
-                    (uint32_t)(sjpeg->frame_base_array[sjpeg_req_frame_index + 1] - sjpeg->io.raw_sjpg_data);
-            }
-            sjpeg->io.raw_sjpg_data_next_read_pos = 0;
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
+    const uint8_t * cache = frame_get(sjpeg, y / sjpeg->sjpeg_single_frame_height);
+    if(cache == NULL) return LV_RES_INV;
 
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
+    int offset = 0;
+    cache += x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res * 3;
 
 #if  LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
-
-#elif  LV_COLOR_DEPTH == 16
-
-        for(int i = 0; i < len; i++) {
-            uint16_t col_16bit = (*cache++ & 0xf8) << 8;
-            col_16bit |= (*cache++ & 0xFC) << 3;
-            col_16bit |= (*cache++ >> 3);
-#if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_16bit >> 8;
-            buf[offset++] = col_16bit & 0xff;
-#else
-            buf[offset++] = col_16bit & 0xff;
-            buf[offset++] = col_16bit >> 8;
-#endif // LV_BIG_ENDIAN_SYSTEM
-        }
-
-#elif  LV_COLOR_DEPTH == 8
-
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-#else
-#error Unsupported LV_COLOR_DEPTH
-
-#endif // LV_COLOR_DEPTH
-        return LV_RES_OK;
+    for(int i = 0; i < len; i++) {
+        buf[offset + 3] = 0xff;
+        buf[offset + 2] = *cache++;
+        buf[offset + 1] = *cache++;
+        buf[offset + 0] = *cache++;
+        offset += 4;
     }
-    else if(dsc->src_type == LV_IMG_SRC_FILE) {
-        SJPEG * sjpeg = (SJPEG *) dsc->user_data;
-        JRESULT rc;
-        int sjpeg_req_frame_index = y / sjpeg->sjpeg_single_frame_height;
-
-        lv_fs_file_t * lv_file_p = &(sjpeg->io.lv_file);
-        if(!lv_file_p) goto end;
-
-        /*If line not from cache, refresh cache */
-        if(sjpeg_req_frame_index != sjpeg->sjpeg_cache_frame_index) {
-            sjpeg->io.raw_sjpg_data_next_read_pos = (int)(sjpeg->frame_base_offset [ sjpeg_req_frame_index ]);
-            lv_fs_seek(&(sjpeg->io.lv_file), sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
-
-            rc = jd_prepare(sjpeg->tjpeg_jd, input_func, sjpeg->workb, (size_t)TJPGD_WORKBUFF_SIZE, &(sjpeg->io));
-            if(rc != JDR_OK) return LV_RES_INV;
 
-            rc = jd_decomp(sjpeg->tjpeg_jd, img_data_cb, 0);
-            if(rc != JDR_OK) return LV_RES_INV;
-
-            sjpeg->sjpeg_cache_frame_index = sjpeg_req_frame_index;
-        }
-
-        int offset = 0;
-        uint8_t * cache = (uint8_t *)sjpeg->frame_cache + x * 3 + (y % sjpeg->sjpeg_single_frame_height) * sjpeg->sjpeg_x_res *
-                          3;
-
-#if LV_COLOR_DEPTH == 32
-        for(int i = 0; i < len; i++) {
-            buf[offset + 3] = 0xff;
-            buf[offset + 2] = *cache++;
-            buf[offset + 1] = *cache++;
-            buf[offset + 0] = *cache++;
-            offset += 4;
-        }
 #elif  LV_COLOR_DEPTH == 16
 
-        for(int i = 0; i < len; i++) {
-            uint16_t col_8bit = (*cache++ & 0xf8) << 8;
-            col_8bit |= (*cache++ & 0xFC) << 3;
-            col_8bit |= (*cache++ >> 3);
+    for(int i = 0; i < len; i++) {
+        uint16_t col_16bit = (*cache++ & 0xf8) << 8;
+        col_16bit |= (*cache++ & 0xFC) << 3;
+        col_16bit |= (*cache++ >> 3);
 #if  LV_BIG_ENDIAN_SYSTEM == 1 || LV_COLOR_16_SWAP == 1
-            buf[offset++] = col_8bit >> 8;
-            buf[offset++] = col_8bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
 #else
-            buf[offset++] = col_8bit & 0xff;
-            buf[offset++] = col_8bit >> 8;
+        buf[offset++] = col_16bit & 0xff;
+        buf[offset++] = col_16bit >> 8;
 #endif // LV_BIG_ENDIAN_SYSTEM
-        }
+    }
 
 #elif  LV_COLOR_DEPTH == 8
 
-        for(int i = 0; i < len; i++) {
-            uint8_t col_8bit = (*cache++ & 0xC0);
-            col_8bit |= (*cache++ & 0xe0) >> 2;
-            col_8bit |= (*cache++ & 0xe0) >> 5;
-            buf[offset++] = col_8bit;
-        }
-
+    for(int i = 0; i < len; i++) {
+        uint8_t col_8bit = (*cache++ & 0xC0);
+        col_8bit |= (*cache++ & 0xe0) >> 2;
+        col_8bit |= (*cache++ & 0xe0) >> 5;
+        buf[offset++] = col_8bit;
+    }
 #else
 #error Unsupported LV_COLOR_DEPTH
 
 #endif // LV_COLOR_DEPTH
-
-        return LV_RES_OK;
-    }
-end:
-    return LV_RES_INV;
+    return LV_RES_OK;
 }
 
 /**
@@ -892,6 +945,14 @@ static int is_jpg(const uint8_t * raw_data, size_t len)
 
 static void lv_sjpg_free(SJPEG * sjpeg)
 {
+#if LV_SJPG_CACHE_DEF_BUDGET
+    if(sjpeg->job) {
+        job_cancel(sjpeg);
+        if(sjpeg->job->src_buf) lv_mem_free(sjpeg->job->src_buf);
+        lv_mem_free(sjpeg->job);
+    }
+    cache_invalidate(sjpeg);
+#endif
     if(sjpeg->frame_cache) lv_mem_free(sjpeg->frame_cache);
     if(sjpeg->frame_base_array) lv_mem_free(sjpeg->frame_base_array);
     if(sjpeg->frame_base_offset) lv_mem_free(sjpeg->frame_base_offset);
@@ -907,4 +968,362 @@ static void lv_sjpg_cleanup(SJPEG * sjpeg)
     lv_mem_free(sjpeg);
 }
 
+
+/*Get the decoded RGB888 pixels of a fragment. It's decoded if it's not cached.*/
+static const uint8_t * frame_get(SJPEG * sjpeg, int index)
+{
+    if(index == sjpeg->sjpeg_cache_frame_index) return sjpeg->frame_pixels;
+    if(index < 0 || index >= sjpeg->sjpeg_total_frames) return NULL;
+
+    /*The areas are drawn from top to bottom, so a jump starts drawing a new area.
+     *The direction is where the start of the areas moves, e.g. while scrolling.*/
+    if(sjpeg->access_cnt == 0) {
+        sjpeg->pass_start_index = index;
+    }
+    else if(index != sjpeg->last_index && index != sjpeg->last_index + 1) {
+        if(index > sjpeg->pass_start_index) sjpeg->access_dir = 1;
+        else if(index < sjpeg->pass_start_index) sjpeg->access_dir = -1;
+        sjpeg->pass_start_index = index;
+    }
+    sjpeg->last_index = index;
+    sjpeg->access_cnt++;
+    sjpeg->sjpeg_cache_frame_index = -1;
+    sjpeg->frame_pixels = NULL;
+
+    const uint8_t * pixels = NULL;
+#if LV_SJPG_CACHE_DEF_BUDGET
+    /*It might be the fragment being decoded in advance*/
+    frag_job_t * job = sjpeg->job;
+    if(job && job->pending && (job->frag->key.index == index || job->pub.done)) job_finish(sjpeg, index);
+
+    frag_t * frag = frag_find(sjpeg, index);
+    if(frag) {
+        stats.hits++;
+        if(frag->prefetched) {
+            stats.prefetch_hits++;
+            frag->prefetched = false;
+        }
+        pixels = FRAG_PIXELS(frag);
+    }
+    else {
+        frag = frag_create(sjpeg, index);
+        if(frag) {
+            if(frame_decode(sjpeg, index, FRAG_PIXELS(frag)) != JDR_OK) {
+                frag_free(frag);
+                return NULL;
+            }
+            stats.decodes++;
+            frag_add(frag);
+            pixels = FRAG_PIXELS(frag);
+        }
+    }
+#endif
+
+    if(pixels == NULL) {
+        /*The fragment can't be cached, decode it into the own buffer of the image*/
+        if(sjpeg->frame_cache == NULL) {
+            sjpeg->frame_cache = lv_mem_alloc(sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3);
+            if(sjpeg->frame_cache == NULL) return NULL;
+        }
+        if(frame_decode(sjpeg, index, sjpeg->frame_cache) != JDR_OK) return NULL;
+        stats.decodes++;
+        pixels = sjpeg->frame_cache;
+    }
+
+    sjpeg->sjpeg_cache_frame_index = index;
+    sjpeg->frame_pixels = pixels;
+
+#if LV_SJPG_CACHE_DEF_BUDGET
+    prefetch(sjpeg, index + (sjpeg->access_dir < 0 ? -1 : 1));
+#endif
+
+    return pixels;
+}
+
+/*Decode a fragment of an image with the decoder of the image*/
+static JRESULT frame_decode(SJPEG * sjpeg, int index, uint8_t * out)
+{
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        sjpeg->io.raw_sjpg_data = sjpeg->frame_base_array[index];
+        sjpeg->io.raw_sjpg_data_size = frag_data_size(sjpeg, index);
+        sjpeg->io.raw_sjpg_data_next_read_pos = 0;
+    }
+    else {
+        sjpeg->io.raw_sjpg_data_next_read_pos = sjpeg->frame_base_offset[index];
+        lv_fs_seek(&sjpeg->io.lv_file, sjpeg->io.raw_sjpg_data_next_read_pos, LV_FS_SEEK_SET);
+    }
+
+    return frag_decode(sjpeg->tjpeg_jd, sjpeg->workb, &sjpeg->io, out);
+}
+
+/*Decode a JPG fragment into RGB888 pixels. Uses only the given memory*/
+static JRESULT frag_decode(JDEC * jd, void * workb, io_source_t * io, uint8_t * out)
+{
+    io->img_cache_buff = out;
+    JRESULT rc = jd_prepare(jd, input_func, workb, (size_t)TJPGD_WORKBUFF_SIZE, io);
+    if(rc != JDR_OK) return rc;
+
+    return jd_decomp(jd, img_data_cb, 0);
+}
+
+/*Size of the compressed data of a fragment*/
+static uint32_t frag_data_size(SJPEG * sjpeg, int index)
+{
+    const bool last = index == sjpeg->sjpeg_total_frames - 1;
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        if(last) return sjpeg->sjpeg_data_size - (uint32_t)(sjpeg->frame_base_array[index] - sjpeg->sjpeg_data);
+        return (uint32_t)(sjpeg->frame_base_array[index + 1] - sjpeg->frame_base_array[index]);
+    }
+
+    if(!last) return (uint32_t)(sjpeg->frame_base_offset[index + 1] - sjpeg->frame_base_offset[index]);
+
+    if(sjpeg->sjpeg_file_size == 0) {
+        lv_fs_seek(&sjpeg->io.lv_file, 0, LV_FS_SEEK_END);
+        lv_fs_tell(&sjpeg->io.lv_file, &sjpeg->sjpeg_file_size);
+    }
+    return sjpeg->sjpeg_file_size - (uint32_t)sjpeg->frame_base_offset[index];
+}
+
+#if LV_SJPG_CACHE_DEF_BUDGET
+
+/*Drop the cached fragments and create a new LRU with the given budget*/
+static void cache_create(uint32_t budget)
+{
+    if(frag_lru) {
+        cache_invalidate(NULL);
+        lv_lru_del(frag_lru);
+        frag_lru = NULL;
+    }
+
+    if(budget == 0) return;
+
+    frag_lru = lv_lru_create(budget, LV_MIN(budget, AVG_FRAG_SIZE), lru_value_free, NULL);
+    LV_ASSERT_MALLOC(frag_lru);
+}
+
+/*Remove the cached fragments of an image or every fragment if `sjpeg` is NULL*/
+static void cache_invalidate(SJPEG * sjpeg)
+{
+    if(frag_lru == NULL) return;
+
+    invalidating = true;
+    if(sjpeg == NULL) {
+        while(stats.frag_cnt) lv_lru_remove_lru_item(frag_lru);
+    }
+    else {
+        frag_key_t key;
+        for(int i = 0; i < sjpeg->sjpeg_total_frames; i++) {
+            key_init(&key, sjpeg, i);
+            lv_lru_remove(frag_lru, &key, sizeof(key));
+        }
+    }
+    invalidating = false;
+}
+
+/*Allocate a fragment for the decoded pixels. NULL if it doesn't fit into the cache.*/
+static frag_t * frag_create(SJPEG * sjpeg, int index)
+{
+    if(frag_lru == NULL) return NULL;
+
+    uint32_t size = sizeof(frag_t) + (uint32_t)sjpeg->sjpeg_x_res * sjpeg->sjpeg_single_frame_height * 3;
+    if(size > frag_lru->total_memory) return NULL;
+
+    frag_t * frag = mem_alloc_cb ? mem_alloc_cb(size) : lv_mem_alloc(size);
+    if(frag == NULL) {
+        LV_LOG_WARN("SJPG cache: couldn't allocate %" LV_PRIu32 " bytes", size);
+        return NULL;
+    }
+
+    key_init(&frag->key, sjpeg, index);
+    frag->free_cb = mem_alloc_cb ? mem_free_cb : NULL;
+    frag->size = size;
+    frag->prefetched = false;
+    return frag;
+}
+
+static frag_t * frag_find(SJPEG * sjpeg, int index)
+{
+    if(frag_lru == NULL) return NULL;
+
+    frag_key_t key;
+    key_init(&key, sjpeg, index);
+    void * value = NULL;
+    lv_lru_get(frag_lru, &key, sizeof(key), &value);
+    return value;
+}
+
+/*Put a decoded fragment into the cache. It's freed if it doesn't fit anymore.*/
+static void frag_add(frag_t * frag)
+{
+    if(frag_lru == NULL || frag->size > frag_lru->total_memory) {
+        frag_free(frag);
+        return;
+    }
+
+    stats.frag_cnt++;
+    lv_lru_set(frag_lru, &frag->key, sizeof(frag_key_t), frag, frag->size);
+}
+
+static void frag_free(frag_t * frag)
+{
+    if(frag->free_cb) frag->free_cb(frag);
+    else lv_mem_free(frag);
+}
+
+/*Called by the LRU when a fragment is evicted or removed*/
+static void lru_value_free(void * v)
+{
+    frag_t * frag = v;
+
+    if(!invalidating) {
+        stats.evictions++;
+        LV_LOG_TRACE("SJPG cache: remove the least recently used fragment");
+    }
+
+    /*The image needs to look it up again*/
+    SJPEG * sjpeg = frag->key.sjpeg;
+    if(sjpeg->frame_pixels == FRAG_PIXELS(frag)) {
+        sjpeg->sjpeg_cache_frame_index = -1;
+        sjpeg->frame_pixels = NULL;
+    }
+
+    stats.frag_cnt--;
+    frag_free(frag);
+}
+
+/*Start decoding a fragment in advance if it's not cached yet. Only one fragment of an image is decoded at once.*/
+static void prefetch(SJPEG * sjpeg, int index)
+{
+    if(index < 0 || index >= sjpeg->sjpeg_total_frames) return;
+    if(sjpeg->job && sjpeg->job->pending) return;
+    if(frag_find(sjpeg, index)) return;
+
+    if(sjpeg->job == NULL) {
+        sjpeg->job = lv_mem_alloc(sizeof(frag_job_t));
+        if(sjpeg->job == NULL) return;
+        lv_memset_00(sjpeg->job, sizeof(frag_job_t));
+    }
+    frag_job_t * job = sjpeg->job;
+
+    frag_t * frag = frag_create(sjpeg, index);
+    if(frag == NULL) return;
+
+    /*The worker can't use `lv_fs`, so the compressed fragment is read here*/
+    const uint32_t data_size = frag_data_size(sjpeg, index);
+    job->io.type = SJPEG_IO_SOURCE_C_ARRAY;
+    job->io.img_cache_x_res = sjpeg->sjpeg_x_res;
+    job->io.raw_sjpg_data_size = data_size;
+    if(sjpeg->io.type == SJPEG_IO_SOURCE_C_ARRAY) {
+        job->io.raw_sjpg_data = sjpeg->frame_base_array[index];
+    }
+    else {
+        if(job->src_buf_size < data_size) {
+            uint8_t * buf = lv_mem_realloc(job->src_buf, data_size);
+            if(buf == NULL) {
+                frag_free(frag);
+                return;
+            }
+            job->src_buf = buf;
+            job->src_buf_size = data_size;
+        }
+
+        uint32_t rn = 0;
+        lv_fs_seek(&sjpeg->io.lv_file, sjpeg->frame_base_offset[index], LV_FS_SEEK_SET);
+        lv_fs_res_t res = lv_fs_read(&sjpeg->io.lv_file, job->src_buf, data_size, &rn);
+        if(res != LV_FS_RES_OK || rn != data_size) {
+            frag_free(frag);
+            return;
+        }
+        job->io.raw_sjpg_data = job->src_buf;
+    }
+
+    job->frag = frag;
+    job->ok = false;
+    job->pending = true;
+    job->wait_cb = NULL;
+    job->pub.user_data = NULL;
+    job->pub.done = false;
+
+    if(worker_submit_cb && worker_submit_cb(&job->pub)) {
+        job->wait_cb = worker_wait_cb;
+    }
+    else if(lv_async_call(job_async_cb, job) != LV_RES_OK) {
+        job->pending = false;
+        job->frag = NULL;
+        frag_free(frag);
+    }
+}
+
+/**
+ * Put the fragment of a finished job into the cache.
+ * Without a worker the fragment is decoded now if it's the `needed` one, else it's dropped.
+ */
+static void job_finish(SJPEG * sjpeg, int needed)
+{
+    frag_job_t * job = sjpeg->job;
+    frag_t * frag = job->frag;
+    bool ahead = true;
+
+    if(job->wait_cb) {
+        job->wait_cb(&job->pub);
+    }
+    else if(!job->pub.done) {
+        lv_async_call_cancel(job_async_cb, job);
+        if(frag->key.index == needed) {
+            lv_sjpg_job_run(&job->pub);
+            ahead = false;
+        }
+    }
+
+    job->pending = false;
+    job->frag = NULL;
+
+    if(!job->pub.done || !job->ok) {
+        frag_free(frag);
+        return;
+    }
+
+    if(ahead) {
+        stats.prefetches++;
+        if(job->wait_cb) stats.worker_decodes++;
+        frag->prefetched = true;
+    }
+    else {
+        stats.decodes++;
+    }
+    frag_add(frag);
+}
+
+/*Drop the job of an image being closed*/
+static void job_cancel(SJPEG * sjpeg)
+{
+    frag_job_t * job = sjpeg->job;
+    if(!job->pending) return;
+
+    if(job->wait_cb) job->wait_cb(&job->pub);
+    else lv_async_call_cancel(job_async_cb, job);
+
+    frag_free(job->frag);
+    job->frag = NULL;
+    job->pending = false;
+}
+
+/*Decode the fragment in advance in `lv_timer_handler` if there is no worker*/
+static void job_async_cb(void * p)
+{
+    frag_job_t * job = p;
+    lv_sjpg_job_run(&job->pub);
+    job_finish(job->frag->key.sjpeg, -1);
+}
+
+/*The key is hashed byte by byte, so clear the padding too*/
+static void key_init(frag_key_t * key, SJPEG * sjpeg, int index)
+{
+    lv_memset_00(key, sizeof(frag_key_t));
+    key->sjpeg = sjpeg;
+    key->index = index;
+}
+
+#endif /*LV_SJPG_CACHE_DEF_BUDGET*/
+
 #endif /*LV_USE_SJPG*/
@@ -13,7 +13,7 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
-
+#include "../../../lvgl.h"
 #if LV_USE_SJPG
 
 /*********************
@@ -24,12 +24,82 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/** A JPG fragment to decode in advance by a worker. See `lv_sjpg_set_worker`*/
+typedef struct {
+    void * user_data;       /**< Free to use by the worker. NULL when the job is submitted*/
+    volatile bool done;     /**< Set by `lv_sjpg_job_run` when the fragment is decoded*/
+} lv_sjpg_job_t;
+
+/**
+ * Pass a job to a worker thread which calls `lv_sjpg_job_run(job)`. Called from the LVGL thread.
+ * Return false if the job can't be queued now, LVGL decodes the fragment in the next `lv_timer_handler` then.
+ */
+typedef bool (*lv_sjpg_submit_cb_t)(lv_sjpg_job_t * job);
+
+/**
+ * Wait until the worker has finished a submitted job. Called from the LVGL thread when the fragment is needed
+ * or the image is closed. The pixels written by the worker need to be visible when it returns,
+ * e.g. wait for a semaphore given by the worker after `lv_sjpg_job_run`.
+ */
+typedef void (*lv_sjpg_wait_cb_t)(lv_sjpg_job_t * job);
+
+/** Statistics of the cache of the decoded fragments*/
+typedef struct {
+    uint32_t hits;          /**< Fragments found in the cache*/
+    uint32_t decodes;       /**< Fragments decoded when they were drawn*/
+    uint32_t prefetches;    /**< Fragments decoded in advance*/
+    uint32_t worker_decodes;/**< Fragments decoded in advance by the worker*/
+    uint32_t prefetch_hits; /**< Fragments decoded in advance which were drawn later*/
+    uint32_t evictions;     /**< Fragments removed to make space for new ones*/
+    uint32_t size;          /**< Bytes used by the cached fragments*/
+    uint32_t frag_cnt;      /**< Number of cached fragments*/
+} lv_sjpg_cache_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 void lv_split_jpeg_init(void);
 
+/**
+ * Set the memory the decoded fragments of the JPGs can use.
+ * The least recently used fragments are removed to stay within the budget.
+ * @param budget    size in bytes. 0: keep only the current fragment of each image
+ */
+void lv_sjpg_set_cache_budget(uint32_t budget);
+
+/**
+ * Set where the decoded fragments are stored. E.g. in external RAM.
+ * The cached fragments are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_sjpg_set_cache_mem_cb(lv_img_cache_alloc_cb_t alloc_cb, lv_img_cache_free_cb_t free_cb);
+
+/**
+ * Decode the fragments in advance in another thread instead of the LVGL thread.
+ * @param submit_cb     function to pass a job to the worker or NULL to decode in `lv_timer_handler`
+ * @param wait_cb       function to wait for a submitted job
+ */
+void lv_sjpg_set_worker(lv_sjpg_submit_cb_t submit_cb, lv_sjpg_wait_cb_t wait_cb);
+
+/**
+ * Decode the fragment of a job. Can be called from any thread, it uses only the memory of the job.
+ * @param job       pointer to a job given to `submit_cb`
+ */
+void lv_sjpg_job_run(lv_sjpg_job_t * job);
+
+/**
+ * Get the statistics of the fragment cache.
+ * @param stats     store the statistics here
+ */
+void lv_sjpg_get_cache_stats(lv_sjpg_cache_stats_t * stats);
+
+/**
+ * Clear the counters of the fragment cache.
+ */
+void lv_sjpg_reset_cache_stats(void);
+
 /**********************
  *      MACROS
  **********************/
@@ -258,6 +258,8 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
         LV_LOG_ERROR("invalid font size: %"PRIx32, font_size);
         return;
     }
+    /*The cached glyphs have the old size*/
+    lv_glyph_cache_invalidate_font(font);
     ttf_font_desc_t * dsc = (ttf_font_desc_t *)font->dsc;
     dsc->scale = stbtt_ScaleForMappingEmToPixels(&dsc->info, font_size);
     int line_gap = 0;
@@ -268,6 +270,7 @@ void lv_tiny_ttf_set_size(lv_font_t * font, lv_coord_t font_size)
 void lv_tiny_ttf_destroy(lv_font_t * font)
 {
     if(font != NULL) {
+        lv_glyph_cache_invalidate_font(font);
         if(font->dsc != NULL) {
             ttf_font_desc_t * ttf = (ttf_font_desc_t *)font->dsc;
 #if LV_TINY_TTF_FILE_SUPPORT
@@ -14,10 +14,14 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../misc/lv_printf.h"
 
 /*********************
  *      DEFINES
  *********************/
+/*A 256 code point block of the BMP gets a page in `LV_FONT_FMT_TXT_INDEX_PAGES` mode
+ *if it has at least this many glyphs. A page costs 512 bytes, a hashed glyph ~12 bytes*/
+#define INDEX_PAGE_MIN_GLYPHS   48
 
 /**********************
  *      TYPEDEFS
@@ -32,6 +36,16 @@ typedef enum {
  *  STATIC PROTOTYPES
  **********************/
 static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter);
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+static inline bool in_first_tiny_cmap(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter);
+static const lv_font_fmt_txt_index_t * get_index(const lv_font_fmt_txt_dsc_t * fdsc);
+static inline uint32_t index_lookup(const lv_font_fmt_txt_index_t * index, uint32_t letter);
+static inline uint32_t index_hash(uint32_t letter, uint8_t bits);
+static void index_create(lv_font_fmt_txt_glyph_cache_t * cache, const lv_font_fmt_txt_dsc_t * fdsc);
+static lv_font_fmt_txt_index_t * index_build(const lv_font_fmt_txt_dsc_t * fdsc);
+static uint32_t index_size(const lv_font_fmt_txt_index_t * index);
+static uint32_t cmap_get_letter_cnt(const lv_font_fmt_txt_cmap_t * cmap);
+static uint32_t cmap_get_letter(const lv_font_fmt_txt_cmap_t * cmap, uint32_t i);
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right);
 static int32_t unicode_list_compare(const void * ref, const void * element);
 static int32_t kern_pair_8_compare(const void * ref, const void * element);
@@ -49,6 +63,10 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element);
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_font_fmt_txt_index_mode_t index_mode;
+
+/*Marks the fonts whose index couldn't be built to not try it at every letter*/
+static const lv_font_fmt_txt_index_t index_failed;
 #if LV_USE_FONT_COMPRESSED
     static uint32_t rle_rdp;
     static const uint8_t * rle_in;
@@ -202,6 +220,98 @@ void _lv_font_clean_up_fmt_txt(void)
 #endif
 }
 
+/**
+ * Initialize the index of the fonts with `LV_FONT_FMT_TXT_INDEX`
+ */
+void _lv_font_fmt_txt_index_init(void)
+{
+    _lv_ll_init(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll), sizeof(lv_font_fmt_txt_glyph_cache_t *));
+    index_mode = LV_FONT_FMT_TXT_INDEX;
+}
+
+/**
+ * Free the indexes built for the fonts.
+ */
+void _lv_font_fmt_txt_index_deinit(void)
+{
+    lv_font_fmt_txt_glyph_cache_t ** cache_p = _lv_ll_get_head(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll));
+    while(cache_p) {
+        lv_font_fmt_txt_glyph_cache_t * cache = *cache_p;
+        if(cache->index != &index_failed) lv_mem_free((void *)cache->index);
+        cache->index = NULL;
+
+        _lv_ll_remove(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll), cache_p);
+        lv_mem_free(cache_p);
+        cache_p = _lv_ll_get_head(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll));
+    }
+}
+
+/**
+ * Set the kind of index to build for the fonts. The indexes built so far are freed.
+ * The indexes generated into the fonts' C files are used unless the mode is `LV_FONT_FMT_TXT_INDEX_NONE`.
+ * @param mode      `LV_FONT_FMT_TXT_INDEX_NONE/HASH/PAGES`
+ */
+void lv_font_fmt_txt_set_index_mode(lv_font_fmt_txt_index_mode_t mode)
+{
+    _lv_font_fmt_txt_index_deinit();
+    index_mode = mode;
+}
+
+/**
+ * Get the kind of index built for the fonts.
+ * @return          `LV_FONT_FMT_TXT_INDEX_NONE/HASH/PAGES`
+ */
+lv_font_fmt_txt_index_mode_t lv_font_fmt_txt_get_index_mode(void)
+{
+    return index_mode;
+}
+
+/**
+ * Build the index of a font now instead of at its first use. E.g. to avoid a delay when the first text is drawn.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ * @return          LV_RES_OK: the font has an index; LV_RES_INV: the index is disabled or it couldn't be built
+ */
+lv_res_t lv_font_fmt_txt_build_index(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    return get_index(font->dsc) ? LV_RES_OK : LV_RES_INV;
+}
+
+/**
+ * Free the index built for a font. It will be built again at the next use.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ */
+void lv_font_fmt_txt_free_index(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    if(fdsc == NULL || fdsc->cache == NULL || fdsc->cache->index == NULL) return;
+
+    lv_font_fmt_txt_glyph_cache_t ** cache_p;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll), cache_p) {
+        if(*cache_p == fdsc->cache) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll), cache_p);
+            lv_mem_free(cache_p);
+            break;
+        }
+    }
+
+    if(fdsc->cache->index != &index_failed) lv_mem_free((void *)fdsc->cache->index);
+    fdsc->cache->index = NULL;
+}
+
+/**
+ * Get the size of the index of a font.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ * @return          size of the index in bytes or 0 if the font has no index
+ */
+uint32_t lv_font_fmt_txt_get_index_size(const lv_font_t * font)
+{
+    LV_ASSERT_NULL(font);
+    const lv_font_fmt_txt_index_t * index = get_index(font->dsc);
+    return index ? index_size(index) : 0;
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -212,15 +322,34 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+    /*The first cmap is usually the ASCII range. Its glyphs are found without an index too*/
+    if(in_first_tiny_cmap(fdsc, letter)) return fdsc->cmaps[0].glyph_id_start + letter - fdsc->cmaps[0].range_start;
+
+    const lv_font_fmt_txt_index_t * index = get_index(fdsc);
+    if(index) return index_lookup(index, letter);
+
     /*Check the cache first*/
     if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
 
+    uint32_t glyph_id = search_glyph_dsc_id(fdsc, letter);
+
+    /*Update the cache*/
+    if(fdsc->cache) {
+        fdsc->cache->last_letter = letter;
+        fdsc->cache->last_glyph_id = glyph_id;
+    }
+    return glyph_id;
+}
+
+/*Find the glyph ID of a letter in the cmaps*/
+static uint32_t search_glyph_dsc_id(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -251,20 +380,207 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
             }
         }
 
-        /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
-        }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    return 0;
+}
+
+/*Is the letter in the first cmap if it's a `LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY` one? These aren't indexed*/
+static inline bool in_first_tiny_cmap(const lv_font_fmt_txt_dsc_t * fdsc, uint32_t letter)
+{
+    return fdsc->cmap_num && fdsc->cmaps[0].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY &&
+           letter - fdsc->cmaps[0].range_start < fdsc->cmaps[0].range_length;
+}
+
+/*Get the index of a font, build it if needed. NULL if the cmaps need to be searched*/
+static const lv_font_fmt_txt_index_t * get_index(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    if(index_mode == LV_FONT_FMT_TXT_INDEX_NONE) return NULL;
+    if(fdsc->index) return fdsc->index;
+
+    /*The built index is stored in the cache as the font descriptor is usually constant*/
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+    if(cache == NULL) return NULL;
+
+    if(cache->index == NULL) index_create(cache, fdsc);
+    return cache->index == &index_failed ? NULL : cache->index;
+}
+
+static inline uint32_t index_lookup(const lv_font_fmt_txt_index_t * index, uint32_t letter)
+{
+    if(letter <= 0xFFFF && index->page_cnt) {
+        uint32_t page = index->page_map[letter >> 8];
+        if(page) return index->pages[((page - 1) << 8) + (letter & 0xFF)];
     }
+
+    if(index->hash_bits == 0) return 0;
+
+    uint32_t mask = (1 << index->hash_bits) - 1;
+    uint32_t i = index_hash(letter, index->hash_bits);
+    while(index->hash_keys[i]) {
+        if(index->hash_keys[i] == letter) return index->hash_glyph_ids[i];
+        i = (i + 1) & mask;
+    }
+
     return 0;
+}
 
+/*Fibonacci hashing: the upper bits of the product are well mixed even for consecutive letters*/
+static inline uint32_t index_hash(uint32_t letter, uint8_t bits)
+{
+    return (uint32_t)(letter * 0x9E3779B1u) >> (32 - bits);
+}
+
+/*Build the index and remember it to free it later*/
+static void index_create(lv_font_fmt_txt_glyph_cache_t * cache, const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    lv_font_fmt_txt_glyph_cache_t ** cache_p = _lv_ll_ins_head(&LV_GC_ROOT(_lv_font_fmt_txt_index_ll));
+    LV_ASSERT_MALLOC(cache_p);
+    if(cache_p == NULL) return;
+    *cache_p = cache;
+
+    lv_font_fmt_txt_index_t * index = index_build(fdsc);
+    if(index == NULL) {
+        cache->index = &index_failed;
+        return;
+    }
+
+    cache->index = index;
+    LV_LOG_INFO("%" LV_PRIu32 " bytes index built for %d cmaps", index_size(index), fdsc->cmap_num);
+}
+
+/*Build an index which finds the same glyph IDs as `search_glyph_dsc_id`*/
+static lv_font_fmt_txt_index_t * index_build(const lv_font_fmt_txt_dsc_t * fdsc)
+{
+    /*Count the glyphs per 256 code point block of the BMP*/
+    uint16_t * block_glyph_cnt = lv_mem_buf_get(256 * sizeof(uint16_t));
+    if(block_glyph_cnt == NULL) return NULL;
+    lv_memset_00(block_glyph_cnt, 256 * sizeof(uint16_t));
+
+    uint32_t glyph_cnt = 0;
+    uint32_t c;
+    uint32_t i;
+    for(c = 0; c < fdsc->cmap_num; c++) {
+        uint32_t letter_cnt = cmap_get_letter_cnt(&fdsc->cmaps[c]);
+        for(i = 0; i < letter_cnt; i++) {
+            uint32_t letter = cmap_get_letter(&fdsc->cmaps[c], i);
+            if(in_first_tiny_cmap(fdsc, letter)) continue;
+            uint32_t glyph_id = search_glyph_dsc_id(fdsc, letter);
+            if(glyph_id == 0) continue;
+            if(glyph_id > UINT16_MAX) {
+                LV_LOG_WARN("can't index the font as it has more than %d glyphs", UINT16_MAX);
+                lv_mem_buf_release(block_glyph_cnt);
+                return NULL;
+            }
+            glyph_cnt++;
+            if(letter <= 0xFFFF) block_glyph_cnt[letter >> 8]++;
+        }
+    }
+
+    uint32_t page_cnt = 0;
+    uint32_t hashed_cnt = glyph_cnt;
+    if(index_mode == LV_FONT_FMT_TXT_INDEX_PAGES) {
+        for(i = 0; i < 256; i++) {
+            if(block_glyph_cnt[i] >= INDEX_PAGE_MIN_GLYPHS) {
+                page_cnt++;
+                hashed_cnt -= block_glyph_cnt[i];
+            }
+        }
+    }
+
+    /*Keep the hash table at most 3/4 full to keep the probe sequences short*/
+    uint8_t hash_bits = 0;
+    if(hashed_cnt) {
+        hash_bits = 1;
+        while((1UL << hash_bits) * 3 < hashed_cnt * 4) hash_bits++;
+    }
+
+    uint32_t slot_cnt = hash_bits ? 1 << hash_bits : 0;
+    uint32_t size = sizeof(lv_font_fmt_txt_index_t) + slot_cnt * sizeof(uint32_t) + slot_cnt * sizeof(uint16_t);
+    if(page_cnt) size += (256 + page_cnt * 256) * sizeof(uint16_t);
+
+    lv_font_fmt_txt_index_t * index = lv_mem_alloc(size);
+    LV_ASSERT_MALLOC(index);
+    if(index == NULL) {
+        LV_LOG_WARN("couldn't allocate %" LV_PRIu32 " bytes for the index", size);
+        lv_mem_buf_release(block_glyph_cnt);
+        return NULL;
+    }
+    lv_memset_00(index, size);
+
+    /*The 32 bit keys first to keep them aligned*/
+    uint32_t * hash_keys = (uint32_t *)&index[1];
+    uint16_t * hash_glyph_ids = (uint16_t *)&hash_keys[slot_cnt];
+    uint16_t * page_map = &hash_glyph_ids[slot_cnt];
+    uint16_t * pages = &page_map[256];
+
+    index->hash_bits = hash_bits;
+    index->hash_keys = hash_bits ? hash_keys : NULL;
+    index->hash_glyph_ids = hash_bits ? hash_glyph_ids : NULL;
+    index->page_cnt = page_cnt;
+    index->page_map = page_cnt ? page_map : NULL;
+    index->pages = page_cnt ? pages : NULL;
+
+    if(page_cnt) {
+        uint32_t page = 0;
+        for(i = 0; i < 256; i++) {
+            if(block_glyph_cnt[i] >= INDEX_PAGE_MIN_GLYPHS) page_map[i] = ++page;
+        }
+    }
+    lv_mem_buf_release(block_glyph_cnt);
+
+    for(c = 0; c < fdsc->cmap_num; c++) {
+        uint32_t letter_cnt = cmap_get_letter_cnt(&fdsc->cmaps[c]);
+        for(i = 0; i < letter_cnt; i++) {
+            uint32_t letter = cmap_get_letter(&fdsc->cmaps[c], i);
+            if(in_first_tiny_cmap(fdsc, letter)) continue;
+            uint32_t glyph_id = search_glyph_dsc_id(fdsc, letter);
+            if(glyph_id == 0) continue;
+
+            if(letter <= 0xFFFF && page_cnt && page_map[letter >> 8]) {
+                pages[((page_map[letter >> 8] - 1) << 8) + (letter & 0xFF)] = glyph_id;
+                continue;
+            }
+
+            /*A letter can be in more cmaps. The search finds the same glyph for it*/
+            uint32_t slot = index_hash(letter, hash_bits);
+            while(hash_keys[slot] && hash_keys[slot] != letter) slot = (slot + 1) & (slot_cnt - 1);
+            hash_keys[slot] = letter;
+            hash_glyph_ids[slot] = glyph_id;
+        }
+    }
+
+    return index;
+}
+
+static uint32_t index_size(const lv_font_fmt_txt_index_t * index)
+{
+    uint32_t size = sizeof(lv_font_fmt_txt_index_t);
+    if(index->hash_bits) size += (sizeof(uint32_t) + sizeof(uint16_t)) << index->hash_bits;
+    if(index->page_cnt) size += (256 + index->page_cnt * 256) * sizeof(uint16_t);
+    return size;
+}
+
+/*Number of letters listed in a cmap. Some of them might have no glyph*/
+static uint32_t cmap_get_letter_cnt(const lv_font_fmt_txt_cmap_t * cmap)
+{
+    if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+        return cmap->range_length;
+    }
+    else {
+        return cmap->list_length;
+    }
+}
+
+static uint32_t cmap_get_letter(const lv_font_fmt_txt_cmap_t * cmap, uint32_t i)
+{
+    if(cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL) {
+        return cmap->range_start + i;
+    }
+    else {
+        return cmap->range_start + cmap->unicode_list[i];
+    }
 }
 
 static int8_t get_kern_value(const lv_font_t * font, uint32_t gid_left, uint32_t gid_right)
@@ -17,6 +17,7 @@ extern "C" {
 #include <stddef.h>
 #include <stdbool.h>
 #include "lv_font.h"
+#include "../misc/lv_types.h"
 
 /*********************
  *      DEFINES
@@ -151,9 +152,50 @@ typedef enum {
     LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
 } lv_font_fmt_txt_bitmap_format_t;
 
+/**
+ * Index to find the glyph ID of a letter without searching the cmaps.
+ * The code points of the dense 256 code point blocks of the BMP are looked up directly in pages,
+ * the others in an open addressing hash table.
+ * It's built at the first use of the font (see `LV_FONT_FMT_TXT_INDEX`)
+ * or generated into the font's C file with `scripts/font_index_gen.py`.
+ */
+typedef struct {
+    /*Page of the `letter >> 8` blocks of the BMP. 0: no page, else the glyph IDs are in
+     *`pages[(page_map[letter >> 8] - 1) * 256 + (letter & 0xFF)]`. NULL if there are no pages*/
+    const uint16_t * page_map;
+
+    /*Glyph IDs of the code points of the pages. 0: the font has no such letter*/
+    const uint16_t * pages;
+
+    /*Code points not on a page in a hash table of `1 << hash_bits` slots with linear probing.
+     *The first slot is `(letter * 0x9E3779B1) >> (32 - hash_bits)`. 0: empty slot*/
+    const uint32_t * hash_keys;
+
+    /*Glyph IDs of the code points in `hash_keys`*/
+    const uint16_t * hash_glyph_ids;
+
+    /*Number of pages*/
+    uint16_t page_cnt;
+
+    /*Size of the hash table as a power of 2. 0: no hash table*/
+    uint8_t hash_bits;
+} lv_font_fmt_txt_index_t;
+
+/*Kind of index to build for the fonts, see `LV_FONT_FMT_TXT_INDEX`*/
+enum {
+    LV_FONT_FMT_TXT_INDEX_NONE = 0,     /*Search the cmaps*/
+    LV_FONT_FMT_TXT_INDEX_HASH = 1,     /*Hash table of all the code points*/
+    LV_FONT_FMT_TXT_INDEX_PAGES = 2,    /*Pages for the dense blocks of the BMP, hash table for the others*/
+};
+
+typedef uint8_t lv_font_fmt_txt_index_mode_t;
+
 typedef struct {
     uint32_t last_letter;
     uint32_t last_glyph_id;
+
+    /*Index built at the first use of the font*/
+    const lv_font_fmt_txt_index_t * index;
 } lv_font_fmt_txt_glyph_cache_t;
 
 /*Describe store additional data for fonts*/
@@ -195,6 +237,9 @@ typedef struct {
 
     /*Cache the last letter and is glyph id*/
     lv_font_fmt_txt_glyph_cache_t * cache;
+
+    /*Index generated into the font's C file. NULL: build it at the first use if `cache` is set*/
+    const lv_font_fmt_txt_index_t * index;
 } lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -225,6 +270,49 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
  */
 void _lv_font_clean_up_fmt_txt(void);
 
+/**
+ * Initialize the index of the fonts with `LV_FONT_FMT_TXT_INDEX`
+ */
+void _lv_font_fmt_txt_index_init(void);
+
+/**
+ * Free the indexes built for the fonts.
+ */
+void _lv_font_fmt_txt_index_deinit(void);
+
+/**
+ * Set the kind of index to build for the fonts. The indexes built so far are freed.
+ * The indexes generated into the fonts' C files are used unless the mode is `LV_FONT_FMT_TXT_INDEX_NONE`.
+ * @param mode      `LV_FONT_FMT_TXT_INDEX_NONE/HASH/PAGES`
+ */
+void lv_font_fmt_txt_set_index_mode(lv_font_fmt_txt_index_mode_t mode);
+
+/**
+ * Get the kind of index built for the fonts.
+ * @return          `LV_FONT_FMT_TXT_INDEX_NONE/HASH/PAGES`
+ */
+lv_font_fmt_txt_index_mode_t lv_font_fmt_txt_get_index_mode(void);
+
+/**
+ * Build the index of a font now instead of at its first use. E.g. to avoid a delay when the first text is drawn.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ * @return          LV_RES_OK: the font has an index; LV_RES_INV: the index is disabled or it couldn't be built
+ */
+lv_res_t lv_font_fmt_txt_build_index(const lv_font_t * font);
+
+/**
+ * Free the index built for a font. It will be built again at the next use.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ */
+void lv_font_fmt_txt_free_index(const lv_font_t * font);
+
+/**
+ * Get the size of the index of a font.
+ * @param font      pointer to a font in the `lv_font_fmt_txt` format
+ * @return          size of the index in bytes or 0 if the font has no index
+ */
+uint32_t lv_font_fmt_txt_get_index_size(const lv_font_t * font);
+
 /**********************
  *      MACROS
  **********************/
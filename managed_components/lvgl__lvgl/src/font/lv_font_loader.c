@@ -117,10 +117,16 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+        lv_glyph_cache_invalidate_font(font);
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
         if(NULL != dsc) {
 
+            if(NULL != dsc->cache) {
+                lv_font_fmt_txt_free_index(font);
+                lv_mem_free(dsc->cache);
+            }
+
             if(dsc->kern_classes == 0) {
                 lv_font_fmt_txt_kern_pair_t * kern_dsc =
                     (lv_font_fmt_txt_kern_pair_t *)dsc->kern_dsc;
@@ -489,6 +495,13 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     font->dsc = font_dsc;
 
+    /*The cache stores the index of the font too*/
+    font_dsc->cache = lv_mem_alloc(sizeof(lv_font_fmt_txt_glyph_cache_t));
+    if(font_dsc->cache == NULL) {
+        return false;
+    }
+    memset(font_dsc->cache, 0, sizeof(lv_font_fmt_txt_glyph_cache_t));
+
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
     if(header_length < 0) {
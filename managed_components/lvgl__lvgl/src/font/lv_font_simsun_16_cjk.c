@@ -23722,6 +23722,335 @@ static const lv_font_fmt_txt_cmap_t cmaps[] = {
     }
 };
 
+/*--------------------
+ *  CODE POINT INDEX
+ *--------------------*/
+
+/*Generated by scripts/font_index_gen.py --mode pages --page-min 48*/
+static const uint16_t index_page_map[] = {
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x1, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0
+};
+
+static const uint16_t index_pages[] = {
+    0x0, 0x61, 0x62, 0x0, 0x0, 0x63, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x64, 0x65, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x66, 0x67, 0x68, 0x69, 0x0, 0x6a, 0x6b, 0x6c, 0x0, 0x6d, 0x6e, 0x6f, 0x70, 0x71, 0x72,
+    0x73, 0x74, 0x75, 0x76, 0x77, 0x78, 0x79, 0x7a, 0x7b, 0x7c, 0x7d, 0x7e, 0x7f, 0x80, 0x81, 0x82,
+    0x83, 0x84, 0x0, 0x85, 0x86, 0x87, 0x88, 0x89, 0x8a, 0x8b, 0x8c, 0x8d, 0x8e, 0x8f, 0x90, 0x91,
+    0x92, 0x93, 0x94, 0x95, 0x96, 0x97, 0x98, 0x99, 0x9a, 0x9b, 0x9c, 0x9d, 0x9e, 0x9f, 0xa0, 0xa1,
+    0xa2, 0xa3, 0xa4, 0xa5, 0xa6, 0xa7, 0xa8, 0xa9, 0xaa, 0xab, 0xac, 0xad, 0xae, 0xaf, 0x0, 0xb0,
+    0xb0, 0xb0, 0xb1, 0xb2, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0, 0xb0,
+    0xb0, 0xb3, 0xb4, 0xb5, 0xb6, 0xb0, 0xb7, 0xb8, 0xb9, 0xb0, 0xba, 0xbb, 0xbc, 0xbd, 0xbe, 0xbf,
+    0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7, 0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xb0, 0xce,
+    0xcf, 0xd0, 0xb0, 0xd1, 0xd2, 0xb0, 0xd3, 0xd4, 0xd5, 0xd6, 0xd7, 0xd8, 0xb0, 0xd9, 0xda, 0xdb,
+    0xdc, 0xdd, 0xde, 0xdf, 0xe0, 0xe1, 0xe2, 0xe3, 0xb0, 0xe4, 0xe5, 0xe6, 0xe7, 0xe8, 0xe9, 0xea,
+    0xeb, 0xec, 0xed, 0xee, 0xef, 0xf0, 0xb0, 0xf1, 0xf2, 0xf3, 0xf4, 0xf5, 0xf6, 0xf7, 0x0, 0xf8,
+    0x0, 0x0, 0x0, 0xf9, 0x0, 0x0, 0xfa, 0x0, 0x0, 0x0, 0x0, 0x0, 0xfb, 0x0, 0x0, 0x0,
+    0xfc, 0x0, 0x0, 0xfd, 0x0, 0x0, 0x0, 0xfe, 0xff, 0x100, 0x101, 0x102, 0x0, 0x103, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x104, 0x105, 0x0, 0x106, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x107, 0x0, 0x0, 0x0, 0x0, 0x108, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x109, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x10a, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x10b, 0x0, 0x0, 0x0, 0x0, 0x0, 0x10c, 0x0, 0x0, 0x10d, 0x10e,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x10f, 0x0, 0x0, 0x0, 0x0, 0x0, 0x110, 0x0, 0x111,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x112, 0x0, 0x113, 0x114, 0x0, 0x115, 0x116, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x117, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x118, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x119, 0x0, 0x0, 0x11a, 0x0, 0x11b, 0x0, 0x0, 0x0, 0x0, 0x0, 0x11c, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x11d, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x11e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x11f, 0x120, 0x0, 0x121, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x122, 0x123, 0x0, 0x124, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x125, 0x126, 0x127, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x128, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x129, 0x0, 0x0, 0x0, 0x0, 0x12a, 0x0, 0x12b, 0x0, 0x0
+};
+
+static const uint32_t index_hash_keys[] = {
+    0x5584, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x616e, 0x537b, 0x63d0, 0x5c1a, 0x5ff5, 0x72ac, 0x7e3d, 0x671b, 0x7dad,
+    0x697d, 0x91dd, 0x0, 0x0, 0x80f8, 0x525b, 0x914d, 0x8fd4, 0x571f, 0x0, 0x0, 0x6c38, 0x0, 0x5e45, 0x8907, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x4fc2, 0x0, 0x5224, 0x0, 0x7530, 0x0, 0x983c, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x5104, 0x0, 0x9ed2, 0x4f8b, 0x6c5a, 0x7a4d, 0xf07b, 0x5074, 0x9805, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x5883, 0x0, 0x50cd, 0x675f, 0x985e, 0x5fa9, 0x7260, 0x5e30, 0x6848, 0x0, 0x529f, 0x7d61, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x6728, 0x4f1d, 0x8a34, 0xf00d, 0x0, 0x8b1d, 0x6cd5, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x8a8d, 0x9707, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5148, 0x6bb5, 0x0, 0x0, 0x0, 0x5eab, 0x0, 0x0,
+    0x0, 0x5957, 0x5bb9, 0x8cb8, 0x5403, 0x0, 0x0, 0x691c, 0x7d4c, 0x9003, 0x0, 0x5373, 0x0, 0x51fa, 0x5e74, 0x0,
+    0x0, 0x5920, 0x6975, 0x0, 0x0, 0x0, 0x0, 0x0, 0x793a, 0x6f22, 0x898f, 0x0, 0x5979, 0x96f2, 0xf051, 0x0,
+    0x0, 0x66dc, 0x6301, 0x0, 0x9662, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7528, 0x56e0, 0x5305, 0x0, 0x5ba4, 0x65bc,
+    0x7236, 0x96bb, 0x5275, 0x6ce2, 0x6b69, 0x0, 0x0, 0x5fd8, 0x0, 0x0, 0x0, 0x0, 0x66fe, 0x6d3b, 0x8a0a, 0x0,
+    0x0, 0x0, 0x666e, 0x7d00, 0x0, 0x50c5, 0x6b32, 0x7de9, 0x5589, 0x5bc6, 0x5fa1, 0x0, 0x66c7, 0x62ec, 0x0, 0x6b8b,
+    0x9010, 0x964d, 0xf095, 0x5207, 0x0, 0x0, 0x0, 0x7db2, 0x6982, 0x9069, 0x5177, 0x5df1, 0x0, 0x80fd, 0x8d77, 0x9152,
+    0x0, 0x0, 0x0, 0x5fc3, 0x0, 0x0, 0x0, 0x91ab, 0x773e, 0x0, 0x5b58, 0x6570, 0x75c5, 0x9032, 0x5229, 0x627e,
+    0x7535, 0x0, 0x0, 0x5f8c, 0xf027, 0x5199, 0x0, 0x0, 0x0, 0x7d44, 0x6539, 0x9a13, 0x8208, 0x0, 0x0, 0x0,
+    0x82f1, 0x0, 0x670b, 0x91cd, 0x696d, 0x6bcf, 0x9054, 0x0, 0x0, 0x0, 0x0, 0x85ac, 0x0, 0x5d4c, 0x4f59, 0x0,
+    0x6210, 0x7edf, 0x5a5a, 0x96ea, 0x7d66, 0x0, 0x0, 0x822a, 0x0, 0x55ef, 0x7cd6, 0xf304, 0x0, 0x672d, 0x0, 0x0,
+    0x0, 0x0, 0x53e6, 0x500b, 0x8efd, 0x0, 0x0, 0x6b61, 0x81f3, 0x0, 0x0, 0x51dd, 0x0, 0x7b26, 0x9593, 0x0,
+    0x9a57, 0x514d, 0x7834, 0x0, 0xf0c4, 0x5236, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5408, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x4f9d, 0x662f, 0x7684, 0x0, 0x0, 0x9817, 0x0, 0x554a, 0x5b87, 0x5f62, 0x800c, 0x88ab,
+    0x0, 0x0, 0x6b4c, 0x6771, 0x5341, 0x7ba1, 0x8fd1, 0x0, 0x0, 0x7b11, 0x0, 0x0, 0x5b50, 0x0, 0x539a, 0x4fbf,
+    0x6e07, 0x8ad6, 0x0, 0x0, 0x673a, 0x5947, 0x65c1, 0x6d77, 0x53f3, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0xf078, 0x623f, 0x0, 0x0, 0x6703, 0x8170, 0x0, 0x0, 0x515a, 0x6e29, 0x4fe1, 0x8af8, 0x72ed, 0x897f, 0x611f, 0x81c9,
+    0x8fbc, 0x0, 0x96e2, 0x5e2d, 0x0, 0x0, 0x8db3, 0x0, 0x0, 0x0, 0x0, 0x663c, 0x5c24, 0x72b6, 0x7518, 0x80a9,
+    0x52f5, 0x4f1a, 0x8a31, 0x0, 0x0, 0xf0f3, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x8072, 0x6c42, 0x0, 0x505c,
+    0x958b, 0x0, 0x0, 0x5145, 0x0, 0x6a39, 0x9f13, 0x0, 0x0, 0x753a, 0x0, 0x5317, 0x4f3c, 0x5bb6, 0x0, 0xff08,
+    0x0, 0x0, 0x0, 0x653e, 0x6163, 0x6b7b, 0x6a02, 0x5c0f, 0x5834, 0x767c, 0x8aac, 0x9000, 0x0, 0x0, 0x5167, 0x6bd4,
+    0x0, 0x4fee, 0x9b5a, 0x0, 0x54b2, 0x0, 0x0, 0x69cb, 0x0, 0x0, 0x0, 0x0, 0x52a9, 0x0, 0x0, 0x0,
+    0x7e54, 0x0, 0x5c31, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5f7c, 0x65b9, 0x5e03, 0x53eb, 0x70ba, 0x5272, 0x8ca0, 0x50f9,
+    0x8feb, 0x0, 0xf070, 0x5bfa, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5152, 0x6e21, 0xf242, 0xf0c9, 0x523b, 0x0,
+    0x0, 0x0, 0x0, 0x5f9e, 0x7a0b, 0x540d, 0x0, 0x8131, 0x0, 0x0, 0x0, 0x7802, 0x0, 0x0, 0x0, 0x5e7e,
+    0x0, 0x671d, 0x0, 0x592a, 0x554f, 0x5b8c, 0x53d6, 0x5dee, 0x61c9, 0x6cca, 0x96a3, 0x0, 0x0, 0x639b, 0x69d8, 0x51cd,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x539f, 0x0, 0x0, 0x0, 0x0, 0x95dc, 0x7dd1, 0x0, 0x8033,
+    0x0, 0x53f8, 0x0, 0x0, 0x0, 0x54e1, 0x6b73, 0x77ed, 0x0, 0x5c07, 0x661f, 0x0, 0x0, 0x6708, 0x5915, 0x6d45,
+    0x7c21, 0x67f1, 0x7d9a, 0x8def, 0x968e, 0x0, 0x0, 0x50cf, 0x6761, 0x0, 0x90aa, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x901a, 0x0, 0x6df7, 0x0, 0x0, 0x0, 0x5473, 0x0, 0x672a, 0x0, 0x0, 0x5b99, 0x0, 0x53e3, 0x0, 0x0,
+    0x0, 0x5b09, 0x7576, 0x63a8, 0x7f8e, 0x8077, 0xf068, 0x0, 0x0, 0x0, 0x0, 0x0, 0x8c61, 0x98db, 0x7a93, 0x5c4b,
+    0x9762, 0x5ead, 0x610f, 0x99c4, 0x0, 0x0, 0x61f8, 0xf293, 0x0, 0x0, 0x62e1, 0x8da3, 0x0, 0x5750, 0x0, 0x0,
+    0x7cbe, 0x0, 0x0, 0x0, 0x0, 0x4f0a, 0x0, 0x516c, 0x5de6, 0x969b, 0x0, 0x0, 0x793c, 0x8fce, 0x0, 0x843d,
+    0xf053, 0x5bdd, 0x0, 0x5427, 0x0, 0x0, 0x58eb, 0x7fd2, 0x71df, 0x59d4, 0x9664, 0x0, 0x68b0, 0x5abd, 0x0, 0x6d74,
+    0x0, 0xf01c, 0x7238, 0x53f0, 0x0, 0x0, 0x7d39, 0x795e, 0x7bc0, 0x6790, 0x77e5, 0x0, 0x0, 0x82e6, 0x0, 0x6700,
+    0x97ff, 0x0, 0x6587, 0x0, 0x0, 0x561b, 0x6295, 0x6a4b, 0x754c, 0x0, 0x9858, 0x4f4e, 0xf03e, 0x8cc7, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5e83, 0x0, 0x0, 0x0, 0x0, 0x96a8, 0x9ce5, 0x5a18,
+    0x0, 0x9154, 0x0, 0x0, 0x0, 0x0, 0x5fc5, 0x806f, 0x0, 0x0, 0x8b70, 0x7740, 0x0, 0x5f35, 0x0, 0x0,
+    0x0, 0x0, 0x6280, 0x0, 0x7537, 0x0, 0x5951, 0x79fb, 0x5bb3, 0x0, 0x0, 0x0, 0x0, 0x89c0, 0x8ffd, 0x0,
+    0x0, 0x0, 0x0, 0x5831, 0x0, 0x0, 0x52dd, 0x591a, 0x670d, 0x8001, 0x5dde, 0x83dc, 0x5c65, 0x524d, 0x8b02, 0x7559,
+    0x8d64, 0x5973, 0x8a72, 0x91cf, 0x57fa, 0xf04b, 0x0, 0x0, 0x0, 0x75b2, 0x822c, 0x7814, 0x6a21, 0x7a76, 0x72c0, 0x7522,
+    0x7f3a, 0x8607, 0x73a9, 0x5b9e, 0x5186, 0x5f79, 0x8acb, 0x76f4, 0x901f, 0x7956, 0x614b, 0x6b63, 0x5358, 0x8457, 0x9078, 0x9ec4,
+    0x0, 0x66f8, 0x7372, 0x695a, 0x8ddf, 0x0, 0x0, 0x0, 0x5238, 0x0, 0x0, 0x0, 0x6751, 0x4f46, 0x0, 0x8cbf,
+    0xff12, 0x0, 0x0, 0x0, 0x6548, 0x0, 0x0, 0x63cf, 0x0, 0x7686, 0x0, 0x0, 0x0, 0x0, 0x5927, 0x5171,
+    0x5b89, 0x79d1, 0x0, 0x0, 0x5897, 0x8996, 0x0, 0x5343, 0x0, 0x9ad4, 0x6c37, 0x0, 0x0, 0x0, 0x58f0, 0x7d75,
+    0x0, 0x6e09, 0x8239, 0x706b, 0x9752, 0x0, 0x64da, 0x8584, 0x0, 0xf021, 0x0, 0x0, 0x88cf, 0x606f, 0x0, 0x0,
+    0x85dd, 0x0, 0x0, 0x0, 0x5c04, 0x8089, 0x0, 0x8b8a, 0x95a2, 0x52d5, 0x904e, 0x0, 0x0, 0x0, 0x0, 0x9774,
+    0x8981, 0x0, 0x0, 0x0, 0x4f53, 0x65e5, 0x5e2f, 0xf043, 0x503c, 0x6d0b, 0x0, 0x0, 0x0, 0x0, 0x6a19, 0x0,
+    0x0, 0x0, 0x751a, 0xf7c2, 0x0, 0x5f71, 0x8a33, 0xf00c, 0x0, 0x6697, 0x62bc, 0x0, 0x0, 0x0, 0x63a5, 0x8a8c,
+    0x6607, 0x9ebc, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5230, 0x6eff, 0x0, 0x0, 0x0,
+    0x5f93, 0x8a55, 0x88dc, 0x8cb7, 0x0, 0x0, 0x0, 0x0, 0x884c, 0x9ede, 0x0, 0x5c11, 0x5e73, 0x767e, 0x0, 0x0,
+    0x0, 0x6599, 0x5169, 0x53cb, 0x67fb, 0x76d7, 0x8ee2, 0xf0e0, 0x0, 0x533b, 0x4f60, 0x559d, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x6562, 0x0, 0x0, 0x8eab, 0x600e, 0x6c88, 0x5e95, 0x547d, 0x7063, 0x0, 0x0, 0x5566, 0xf019, 0x0, 0x0,
+    0x0, 0x62c9, 0x0, 0x81fa, 0xf1eb, 0x0, 0x6614, 0x0, 0x0, 0x0, 0xf15b, 0x0, 0x0, 0x0, 0xf244, 0x0,
+    0x0, 0x5c55, 0x5eb7, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0xf124, 0x0, 0x58d3, 0x89d2, 0x6b8a, 0x900f,
+    0x0, 0x0, 0x5206, 0x5468, 0x0, 0x671f, 0x0, 0x0, 0x5176, 0x0, 0x0, 0x0, 0x0, 0x0, 0x54c1, 0x756b,
+    0x5348, 0x0, 0x0, 0x7279, 0x0, 0x8155, 0x0, 0x0, 0x5b57, 0x9031, 0x0, 0x0, 0x5c40, 0x0, 0x0, 0x0,
+    0x7159, 0x0, 0x5f8b, 0x908a, 0x682a, 0x501f, 0xf026, 0x732b, 0x9a12, 0x0, 0x8207, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x79c1, 0x9053, 0x6bce, 0x53c3, 0x98f2, 0x667a, 0x524a, 0x7f6e, 0x0, 0x0, 0x6388, 0xf048, 0x5bd2, 0x57f7,
+    0x0, 0x8b58, 0x0, 0x0, 0x512a, 0x0, 0x59c9, 0x0, 0x0, 0x0, 0x751f, 0x672c, 0x0, 0x0, 0xf011, 0x722d,
+    0x53e5, 0x643a, 0x0, 0x0, 0x0, 0x0, 0x5730, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x6d32, 0x0, 0x0,
+    0x0, 0x6e1b, 0x707d, 0x628a, 0x7e70, 0x0, 0x0, 0x7de0, 0x0, 0x0, 0x0, 0x88e1, 0x0, 0xf11c, 0x7d50, 0x6545,
+    0x9644, 0x0, 0x0, 0x0, 0x6253, 0x5e78, 0x0, 0x0, 0x0, 0x0, 0x6bdb, 0x9060, 0x0, 0x6687, 0x7d19, 0x793e,
+    0x0, 0x0, 0x5340, 0x597d, 0x5bdf, 0x6c34, 0x6e96, 0x5a66, 0x986f, 0x0, 0x0, 0x0, 0x0, 0x63ee, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x8ca7, 0x0, 0x53f2, 0x7ad9, 0x8f09, 0x0, 0x0, 0x0, 0x0, 0x8a9e, 0xf077,
+    0x0, 0x0, 0x60c5, 0x0, 0x590f, 0x8a0e, 0x904b, 0x53bb, 0x0, 0x0, 0x72ec, 0x7d04, 0x0, 0x0, 0x9e97, 0x65e2,
+    0x0, 0x82b1, 0x0, 0x0, 0x529b, 0x5f15, 0x7720, 0x0, 0x6df1, 0x0, 0x90fd, 0x689d, 0x0, 0x7b54, 0x0, 0x5931,
+    0x6fc3, 0x8655, 0x0, 0x0, 0x0, 0x0, 0x0, 0x7570, 0x5728, 0x63a2, 0x81ea, 0x0, 0x0, 0x8535, 0x0, 0x0,
+    0x5f37, 0x5144, 0x6574, 0x0, 0x0, 0x5c45, 0x5ea7, 0x5acc, 0x6b21, 0x5316, 0x8fa6, 0x0, 0x7247, 0x0, 0x5024, 0x6cf3,
+    0x62db, 0x770b, 0x796d, 0x574a, 0x9178, 0x90e8, 0x5c0e, 0x624b, 0x0, 0x91d1, 0x591c, 0x8003, 0x0, 0x0, 0x53c8, 0x8edf,
+    0x0, 0x898b, 0x0, 0x0, 0x0, 0x0, 0xf04d, 0x7269, 0x8f38, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x6a23,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5e02, 0x53ea, 0x70b9, 0x0, 0x0, 0x6b65, 0x0, 0x0,
+    0x4f7f, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x5b69, 0x53b3, 0x8eca, 0x76bf, 0x9769, 0xf241, 0x0, 0x0,
+    0x0, 0x0, 0x6c17, 0x683c, 0x540c, 0x96d9, 0x0, 0x0, 0x0, 0x0, 0x7e3e, 0x4fa1, 0x59b9, 0x90f5, 0x9ee8, 0x8ba1,
+    0x0, 0x4f11, 0x5929, 0xf001, 0x8272, 0x0, 0xf0ea, 0x0, 0x68ee, 0x6b50, 0x0, 0x5982, 0x0, 0x96fb, 0x0, 0x0,
+    0x60a8, 0x0, 0x58f2, 0x902e, 0x0, 0x0, 0x0, 0x5225, 0x6c92, 0x7531, 0x8f9e, 0x0, 0x0, 0x5f88, 0x65c5, 0x53f7,
+    0x8cac, 0x0, 0x0, 0x89ba, 0x6b72, 0x6797, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x8a13, 0x0, 0x0,
+    0x98ef, 0x0, 0x5247, 0x0, 0x0, 0x570b, 0x0, 0x4f55, 0x0, 0x51b7, 0x0, 0x0, 0x0, 0x52a0, 0x6557, 0x9019,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x64c7, 0x0, 0x0, 0x0, 0x5b98, 0x65b0, 0x0, 0x0, 0x76ee, 0x0, 0x6f38,
+    0x0, 0x5352, 0x63a7, 0x9244, 0xf067, 0x0, 0x8b77, 0x66f2, 0x0, 0x0, 0x5149, 0x9678, 0x0, 0x6025, 0x5c4a, 0x0,
+    0x0, 0x0, 0x6d88, 0x0, 0x6c0f, 0x57df, 0x5404, 0x96d1, 0xff0c, 0x0, 0x0, 0x6167, 0x0, 0x8ab0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x52e4, 0x5546, 0x516b, 0x5b83, 0x53cd, 0x5de5, 0x5c6c, 0x6a5f, 0x6cc1, 0x5718, 0x6392, 0x79cb, 0xf052,
+    0x0, 0x5426, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x521d, 0x5e97, 0x64d4, 0x0, 0x0, 0x5f80,
+    0x518d, 0x53ef, 0x65bd, 0x907f, 0x6ce3, 0x795d, 0x0, 0x0, 0x0, 0x5fd9, 0x51e6, 0x5bfe, 0x623b, 0x66ff, 0x82e5, 0x8cfd,
+    0x75db, 0xf074, 0x0, 0x4fdd, 0x666f, 0x0, 0x0, 0x611b, 0x0, 0x4f4d, 0x0, 0x0, 0x5411, 0x0, 0x0, 0x62ed,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x9999, 0xf55a, 0x0, 0x592e, 0x79d8, 0x8a2d, 0x5df2, 0x0, 0x6691,
+    0x589e, 0x0, 0x0, 0x534a, 0x8449, 0x0, 0x6226, 0x9700, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x601d,
+    0x9759, 0x0, 0x548c, 0x0, 0x6368, 0x4f38, 0xf028, 0x0, 0x0, 0x0, 0x5283, 0x0, 0x0, 0x5747, 0x679c, 0x6b77,
+    0x55ce, 0x6c60, 0x8209, 0x5a92, 0x91ce, 0x0, 0x4f01, 0x8a18, 0x5ddd, 0x9055, 0x0, 0x6cb9, 0x0, 0x0, 0x6765, 0x0,
+    0x8a71, 0x0, 0x6211, 0x5e36, 0x0, 0x0, 0x0, 0x5f1f, 0x0, 0x8868, 0x59cb, 0x80b2, 0x9280, 0x0, 0x0, 0x0,
+    0x982d, 0xf013, 0x5185, 0x0, 0x0, 0x0, 0x7d30, 0x89aa, 0x6b62, 0x8d85, 0x5357, 0x0, 0x660e, 0x9332, 0x5440, 0x5065,
+    0x0, 0x0, 0x5b66, 0x578b, 0x967d, 0x98df, 0xf0c5, 0x8336, 0x0, 0x0, 0x6750, 0x0, 0x0, 0x5bbf, 0x6839, 0x6c14,
+    0x96d6, 0xff11, 0x0, 0x0, 0x0, 0x8853, 0x98a8, 0x0, 0x6255, 0x5462, 0x7b49, 0x9818, 0x0, 0x5b88, 0x826f, 0x0,
+    0x0, 0x5c71, 0x8d70, 0xf0e7, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x6307, 0x0, 0x0, 0x8c50,
+    0x6e08, 0x6015, 0x5c3a, 0x5e9c, 0x8f9b, 0x0, 0x0, 0x5f85, 0x9084, 0x8ca9, 0x5e0c, 0x5019, 0x6ce8, 0x0, 0x0, 0x6b6f,
+    0x7bc4, 0x0, 0xf079, 0x6240, 0x0, 0x0, 0x0, 0x6d41, 0x83d3, 0x9803, 0x0, 0x0, 0x6674, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x5bcc, 0x96e3, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x63db, 0x0, 0x584a, 0x6c7a,
+    0x7b56, 0x0, 0x0, 0xf00b, 0x65ad, 0x0, 0x0, 0x6696, 0x8b1b, 0x5ee0, 0x0, 0x0, 0x6dbc, 0x0, 0x0, 0x0,
+    0x0, 0x60b2, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x80cc, 0x975e, 0x0, 0x753b, 0x56f3, 0x7dda, 0x5f92, 0x65cf,
+    0x0, 0xff09, 0x0, 0x0, 0x0, 0x54ea, 0x653f, 0x5371, 0x5feb, 0x6628, 0x624d, 0x767d, 0x8aad, 0x9001, 0x0, 0x8005,
+    0x5168, 0x53ca, 0x7e8c, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x559c, 0x6216, 0x6e90, 0x805e, 0x88fd, 0x52aa, 0x62ff,
+    0x6d17, 0x89e6, 0x9023, 0x59d0, 0x7a7a, 0x9577, 0x547c, 0x56de, 0x0, 0x0, 0x5ba2, 0x518a, 0x8ca1, 0x5011, 0x76f8, 0x8d8a,
+    0x8f03, 0x0, 0x0, 0x7406, 0x6613, 0x8a98, 0xf071, 0x0, 0x7b2c, 0x0, 0x5909, 0x5b6b, 0x67e5, 0x8a08, 0x9045, 0xf243,
+    0x0, 0x0, 0x0, 0x9854, 0x0, 0x5bc4, 0x51ac, 0x8cc3, 0x0, 0x0, 0x733f, 0x5f0f, 0x0, 0x0, 0x59bb, 0xf093,
+    0x72af, 0x9996, 0x0, 0x7136, 0x592b, 0x8a2a, 0x0, 0xf8a2, 0x53d7, 0x0, 0x7d20, 0x899a, 0x756a, 0x0, 0x0, 0x7a2e,
+    0x5be6, 0x9322, 0x6e9d, 0x60aa, 0x9ad8, 0x0, 0x5f31, 0x0, 0x67d0, 0x0, 0x0, 0x0, 0x0, 0x7533, 0x0, 0x7dd2,
+    0x6fdf, 0x96c6, 0xf287, 0x9928, 0x0, 0x7d42, 0x5efa, 0x0, 0x71b1, 0x925b, 0x0, 0x5c08, 0x6620, 0x0, 0x7121, 0x56b4,
+    0x52d9, 0x5916, 0x5b78, 0x53c2, 0x5f53, 0x6709, 0x6bcd, 0x6e2f, 0x79c0, 0x570d, 0x7df4, 0x9808, 0x65e9, 0x5e33, 0x96e8, 0x0,
+    0x0, 0x0, 0x6559, 0x0, 0x0, 0x8ac7, 0x6642, 0x80af, 0x0, 0x5099, 0x672b, 0x0, 0x0, 0x5b9a, 0x53e4, 0x7acb,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x5354, 0x55b6, 0x6230, 0x73fe, 0x932f, 0x66f4, 0x6319, 0x8a00, 0x5b63, 0x514b, 0x97f3,
+    0x6027, 0x0, 0x0, 0x99c5, 0x0, 0x984c, 0x0, 0x5f97, 0x6c11, 0x8cbb, 0x74b0, 0x0, 0x58ca, 0x0, 0x0, 0x0,
+    0x59b3, 0x4f9b, 0x8ab2, 0xf2ed, 0x0, 0x7b46, 0x0, 0x79cd, 0x516d, 0x5b85, 0x67ff, 0x969c, 0x9f3b, 0x0, 0x0, 0x0,
+    0x676f, 0x0, 0x65f6, 0xf054, 0x0, 0x0, 0x0, 0x7d71, 0x0, 0x0, 0x6e05, 0x6a2a, 0x6012, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x6821, 0x0, 0x0, 0x0, 0x8377, 0x652f, 0x0, 0x0, 0x4f86, 0x0, 0x0, 0x544a,
+    0x0, 0x6d3e, 0x7d93, 0x904a, 0x0, 0x0, 0x7e7c, 0x0, 0x0, 0x0, 0x8fba, 0x0, 0x0, 0x4f4f, 0x7c73, 0x6843,
+    0x5e2b, 0x725b, 0x771f, 0x7981, 0x8a66, 0x8f2a, 0x90a3, 0x8abf, 0x9650, 0x520a, 0x64c1, 0x0, 0x0, 0x0, 0xf008, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x63a1, 0x55ae, 0x5beb, 0x78ba, 0x8cea, 0x505a, 0x9589, 0x0, 0x0,
+    0x5143, 0x63fa, 0x0, 0x0, 0x5869, 0x5ea6, 0x50b3, 0x56f0, 0x6108, 0x0, 0x0, 0x0, 0x7ae5, 0x8f15, 0x0, 0x7fa9,
+    0x0, 0x77f3, 0x0, 0x8aaa, 0x5c0d, 0x6625, 0x767a, 0x8b93, 0x5cf6, 0x0, 0x0, 0x5165, 0x0, 0x0, 0x6cbb, 0x0,
+    0x0, 0x50d5, 0x5712, 0x4f5c, 0x7b97, 0x8a73, 0x5e38, 0xf04c, 0x0, 0x0, 0x89e3, 0x9020, 0x0, 0x0, 0x0, 0x5217,
+    0x0, 0x7523, 0x56db, 0x60f3, 0x6355, 0x5b9f, 0x65b7, 0x6e56, 0x819d, 0xf015, 0x62c5, 0x0, 0x6b64, 0x0, 0x7403, 0x807d,
+    0x8a95, 0x9aea, 0xf06e, 0x8166, 0x52c9, 0x0, 0x0, 0xf240, 0x0, 0x6669, 0x7cfb, 0xf0c7, 0x8fb2, 0x56fd, 0x0, 0x0
+};
+
+static const uint16_t index_hash_glyph_ids[] = {
+    0x1d6, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2aa, 0x1a5, 0x2d3, 0x24c, 0x296, 0x3a5, 0x420, 0x317, 0x418,
+    0x33c, 0x4f1, 0x0, 0x0, 0x43b, 0x187, 0x4e8, 0x4c6, 0x1ea, 0x0, 0x0, 0x365, 0x0, 0x26b, 0x467, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x143, 0x0, 0x17d, 0x0, 0x3b9, 0x0, 0x525, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x158, 0x0, 0x540, 0x13e, 0x367, 0x3f1, 0x566, 0x150, 0x520, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x1f8, 0x0, 0x154, 0x322, 0x529, 0x290, 0x3a2, 0x267, 0x334, 0x0, 0x18c, 0x412, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x31a, 0x130, 0x47e, 0x549, 0x0, 0x495, 0x370, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x485, 0x516, 0x0, 0x0, 0x0, 0x0, 0x0, 0x15d, 0x359, 0x0, 0x0, 0x0, 0x276, 0x0, 0x0,
+    0x0, 0x20f, 0x239, 0x4a4, 0x1be, 0x0, 0x0, 0x338, 0x410, 0x4cb, 0x0, 0x1a4, 0x0, 0x177, 0x26d, 0x0,
+    0x0, 0x206, 0x33b, 0x0, 0x0, 0x0, 0x0, 0x0, 0x3e0, 0x38f, 0x46b, 0x0, 0x211, 0x513, 0x559, 0x0,
+    0x0, 0x30b, 0x2c5, 0x0, 0x501, 0x0, 0x0, 0x0, 0x0, 0x0, 0x3b8, 0x1e2, 0x196, 0x0, 0x236, 0x2ed,
+    0x39e, 0x50a, 0x189, 0x371, 0x351, 0x0, 0x0, 0x293, 0x0, 0x0, 0x0, 0x0, 0x30f, 0x378, 0x476, 0x0,
+    0x0, 0x0, 0x302, 0x408, 0x0, 0x153, 0x349, 0x41e, 0x1d7, 0x23c, 0x28f, 0x0, 0x30a, 0x2c2, 0x0, 0x358,
+    0x4cd, 0x4ff, 0x568, 0x179, 0x0, 0x0, 0x0, 0x419, 0x33d, 0x4de, 0x16c, 0x25f, 0x0, 0x43c, 0x4ad, 0x4e9,
+    0x0, 0x0, 0x0, 0x291, 0x0, 0x0, 0x0, 0x4ec, 0x3d7, 0x0, 0x224, 0x2e5, 0x3c7, 0x4d5, 0x17f, 0x2b9,
+    0x3bc, 0x0, 0x0, 0x28a, 0x551, 0x171, 0x0, 0x0, 0x0, 0x40f, 0x2dd, 0x536, 0x447, 0x0, 0x0, 0x0,
+    0x451, 0x0, 0x315, 0x4ed, 0x33a, 0x35c, 0x4db, 0x0, 0x0, 0x0, 0x0, 0x45b, 0x0, 0x259, 0x139, 0x0,
+    0x2ad, 0x426, 0x21c, 0x512, 0x413, 0x0, 0x0, 0x449, 0x0, 0x1dd, 0x406, 0x57d, 0x0, 0x31e, 0x0, 0x0,
+    0x0, 0x0, 0x1b5, 0x147, 0x4b8, 0x0, 0x0, 0x34c, 0x444, 0x0, 0x0, 0x175, 0x0, 0x3f9, 0x4fb, 0x0,
+    0x537, 0x160, 0x3de, 0x0, 0x569, 0x181, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1c0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x140, 0x2fe, 0x3cd, 0x0, 0x0, 0x522, 0x0, 0x1d3, 0x22c, 0x282, 0x42f, 0x462,
+    0x0, 0x0, 0x34a, 0x326, 0x19b, 0x400, 0x4c5, 0x0, 0x0, 0x3f8, 0x0, 0x0, 0x222, 0x0, 0x1a6, 0x142,
+    0x383, 0x491, 0x0, 0x0, 0x31f, 0x20d, 0x2ef, 0x37d, 0x1bb, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x564, 0x2b3, 0x0, 0x0, 0x312, 0x440, 0x0, 0x0, 0x162, 0x388, 0x145, 0x492, 0x3aa, 0x468, 0x2a6, 0x442,
+    0x4c3, 0x0, 0x50f, 0x265, 0x0, 0x0, 0x4b1, 0x0, 0x0, 0x0, 0x0, 0x2ff, 0x24d, 0x3a7, 0x3b3, 0x437,
+    0x195, 0x12f, 0x47c, 0x0, 0x0, 0x570, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x433, 0x366, 0x0, 0x14e,
+    0x4fa, 0x0, 0x0, 0x15c, 0x0, 0x345, 0x543, 0x0, 0x0, 0x3be, 0x0, 0x198, 0x132, 0x238, 0x0, 0x581,
+    0x0, 0x0, 0x0, 0x2de, 0x2a8, 0x356, 0x340, 0x24a, 0x1f5, 0x3ca, 0x48a, 0x4c9, 0x0, 0x0, 0x164, 0x35d,
+    0x0, 0x146, 0x53b, 0x0, 0x1ce, 0x0, 0x0, 0x33e, 0x0, 0x0, 0x0, 0x0, 0x18e, 0x0, 0x0, 0x0,
+    0x422, 0x0, 0x24e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x285, 0x2ec, 0x262, 0x1b7, 0x397, 0x188, 0x49e, 0x157,
+    0x4c7, 0x0, 0x560, 0x243, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x161, 0x387, 0x577, 0x56c, 0x183, 0x0,
+    0x0, 0x0, 0x0, 0x28e, 0x3ef, 0x1c2, 0x0, 0x43d, 0x0, 0x0, 0x0, 0x3dc, 0x0, 0x0, 0x0, 0x26f,
+    0x0, 0x318, 0x0, 0x209, 0x1d4, 0x22f, 0x1b0, 0x25e, 0x2ab, 0x36f, 0x508, 0x0, 0x0, 0x2cc, 0x33f, 0x174,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1a7, 0x0, 0x0, 0x0, 0x0, 0x4fd, 0x41a, 0x0, 0x430,
+    0x0, 0x1bd, 0x0, 0x0, 0x0, 0x1d0, 0x354, 0x3da, 0x0, 0x246, 0x2fa, 0x0, 0x0, 0x313, 0x202, 0x37b,
+    0x403, 0x32c, 0x417, 0x4b3, 0x505, 0x0, 0x0, 0x155, 0x323, 0x0, 0x4e4, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x4cf, 0x0, 0x381, 0x0, 0x0, 0x0, 0x1ca, 0x0, 0x31b, 0x0, 0x0, 0x231, 0x0, 0x1b2, 0x0, 0x0,
+    0x0, 0x221, 0x3c5, 0x2d1, 0x429, 0x434, 0x55e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x49d, 0x52c, 0x3f4, 0x253,
+    0x51a, 0x277, 0x2a4, 0x533, 0x0, 0x0, 0x2ac, 0x57b, 0x0, 0x0, 0x2c1, 0x4b0, 0x0, 0x1ef, 0x0, 0x0,
+    0x405, 0x0, 0x0, 0x0, 0x0, 0x12d, 0x0, 0x168, 0x25d, 0x506, 0x0, 0x0, 0x3e1, 0x4c4, 0x0, 0x456,
+    0x55b, 0x23f, 0x0, 0x1c5, 0x0, 0x0, 0x1fd, 0x42b, 0x39c, 0x21a, 0x502, 0x0, 0x336, 0x21f, 0x0, 0x37c,
+    0x0, 0x54e, 0x39f, 0x1b9, 0x0, 0x0, 0x40d, 0x3e5, 0x401, 0x327, 0x3d9, 0x0, 0x0, 0x450, 0x0, 0x311,
+    0x51e, 0x0, 0x2e7, 0x0, 0x0, 0x1de, 0x2bc, 0x346, 0x3c0, 0x0, 0x528, 0x135, 0x553, 0x4a8, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x270, 0x0, 0x0, 0x0, 0x0, 0x509, 0x53c, 0x21b,
+    0x0, 0x4ea, 0x0, 0x0, 0x0, 0x0, 0x292, 0x432, 0x0, 0x0, 0x497, 0x3d8, 0x0, 0x27f, 0x0, 0x0,
+    0x0, 0x0, 0x2ba, 0x0, 0x3bd, 0x0, 0x20e, 0x3ee, 0x237, 0x0, 0x0, 0x0, 0x0, 0x470, 0x4c8, 0x0,
+    0x0, 0x0, 0x0, 0x1f4, 0x0, 0x0, 0x193, 0x204, 0x316, 0x42c, 0x25b, 0x455, 0x255, 0x186, 0x493, 0x3c1,
+    0x4ab, 0x210, 0x482, 0x4ef, 0x1f3, 0x556, 0x0, 0x0, 0x0, 0x3c6, 0x44a, 0x3dd, 0x342, 0x3f2, 0x3a8, 0x3b6,
+    0x427, 0x45d, 0x3ae, 0x233, 0x16e, 0x284, 0x490, 0x3d2, 0x4d0, 0x3e3, 0x2a7, 0x34e, 0x1a2, 0x458, 0x4df, 0x53f,
+    0x0, 0x30e, 0x3ad, 0x339, 0x4b2, 0x0, 0x0, 0x0, 0x182, 0x0, 0x0, 0x0, 0x321, 0x133, 0x0, 0x4a6,
+    0x585, 0x0, 0x0, 0x0, 0x2e1, 0x0, 0x0, 0x2d2, 0x0, 0x3ce, 0x0, 0x0, 0x0, 0x0, 0x207, 0x16a,
+    0x22e, 0x3ec, 0x0, 0x0, 0x1f9, 0x46c, 0x0, 0x19c, 0x0, 0x538, 0x364, 0x0, 0x0, 0x0, 0x1fe, 0x415,
+    0x0, 0x385, 0x44b, 0x394, 0x517, 0x0, 0x2db, 0x45a, 0x0, 0x54f, 0x0, 0x0, 0x463, 0x29d, 0x0, 0x0,
+    0x45c, 0x0, 0x0, 0x0, 0x245, 0x436, 0x0, 0x499, 0x4fc, 0x191, 0x4d9, 0x0, 0x0, 0x0, 0x0, 0x51c,
+    0x469, 0x0, 0x0, 0x0, 0x137, 0x2f3, 0x266, 0x554, 0x14c, 0x375, 0x0, 0x0, 0x0, 0x0, 0x341, 0x0,
+    0x0, 0x0, 0x3b4, 0x57f, 0x0, 0x283, 0x47d, 0x548, 0x0, 0x309, 0x2bd, 0x0, 0x0, 0x0, 0x2cf, 0x484,
+    0x2f6, 0x53e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x180, 0x38e, 0x0, 0x0, 0x0,
+    0x28c, 0x47f, 0x464, 0x4a3, 0x0, 0x0, 0x0, 0x0, 0x45f, 0x541, 0x0, 0x24b, 0x26c, 0x3cc, 0x0, 0x0,
+    0x0, 0x2e8, 0x166, 0x1ae, 0x32d, 0x3d0, 0x4b7, 0x56d, 0x0, 0x199, 0x13b, 0x1d9, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x2e4, 0x0, 0x0, 0x4b4, 0x297, 0x36a, 0x271, 0x1cc, 0x393, 0x0, 0x0, 0x1d5, 0x54d, 0x0, 0x0,
+    0x0, 0x2bf, 0x0, 0x445, 0x574, 0x0, 0x2f9, 0x0, 0x0, 0x0, 0x573, 0x0, 0x0, 0x0, 0x579, 0x0,
+    0x0, 0x254, 0x278, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x572, 0x0, 0x1fc, 0x471, 0x357, 0x4cc,
+    0x0, 0x0, 0x178, 0x1c9, 0x0, 0x319, 0x0, 0x0, 0x16b, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1cf, 0x3c3,
+    0x19d, 0x0, 0x0, 0x3a4, 0x0, 0x43e, 0x0, 0x0, 0x223, 0x4d4, 0x0, 0x0, 0x250, 0x0, 0x0, 0x0,
+    0x39a, 0x0, 0x289, 0x4e2, 0x330, 0x14a, 0x550, 0x3ab, 0x535, 0x0, 0x446, 0x0, 0x0, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x3e9, 0x4da, 0x35b, 0x1ab, 0x52f, 0x305, 0x185, 0x428, 0x0, 0x0, 0x2ca, 0x555, 0x23e, 0x1f2,
+    0x0, 0x496, 0x0, 0x0, 0x159, 0x0, 0x217, 0x0, 0x0, 0x0, 0x3b5, 0x31d, 0x0, 0x0, 0x54a, 0x39d,
+    0x1b4, 0x2d7, 0x0, 0x0, 0x0, 0x0, 0x1ec, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x377, 0x0, 0x0,
+    0x0, 0x386, 0x395, 0x2bb, 0x423, 0x0, 0x0, 0x41d, 0x0, 0x0, 0x0, 0x465, 0x0, 0x571, 0x411, 0x2e0,
+    0x4fe, 0x0, 0x0, 0x0, 0x2b7, 0x26e, 0x0, 0x0, 0x0, 0x0, 0x35e, 0x4dd, 0x0, 0x306, 0x40a, 0x3e2,
+    0x0, 0x0, 0x19a, 0x212, 0x240, 0x363, 0x38c, 0x21d, 0x52a, 0x0, 0x0, 0x0, 0x0, 0x2d5, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x4a0, 0x0, 0x1ba, 0x3f6, 0x4ba, 0x0, 0x0, 0x0, 0x0, 0x488, 0x563,
+    0x0, 0x0, 0x2a1, 0x0, 0x201, 0x477, 0x4d8, 0x1a9, 0x0, 0x0, 0x3a9, 0x409, 0x0, 0x0, 0x53d, 0x2f2,
+    0x0, 0x44e, 0x0, 0x0, 0x18b, 0x27c, 0x3d6, 0x0, 0x380, 0x0, 0x4e7, 0x335, 0x0, 0x3fd, 0x0, 0x20c,
+    0x391, 0x45e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x3c4, 0x1eb, 0x2ce, 0x443, 0x0, 0x0, 0x459, 0x0, 0x0,
+    0x280, 0x15b, 0x2e6, 0x0, 0x0, 0x251, 0x275, 0x220, 0x348, 0x197, 0x4c0, 0x0, 0x3a0, 0x0, 0x14b, 0x374,
+    0x2c0, 0x3d4, 0x3e6, 0x1ee, 0x4eb, 0x4e5, 0x249, 0x2b5, 0x0, 0x4f0, 0x205, 0x42d, 0x0, 0x0, 0x1ac, 0x4b6,
+    0x0, 0x46a, 0x0, 0x0, 0x0, 0x0, 0x558, 0x3a3, 0x4bd, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x343,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x261, 0x1b6, 0x396, 0x0, 0x0, 0x350, 0x0, 0x0,
+    0x13c, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x227, 0x1a8, 0x4b5, 0x3cf, 0x51b, 0x576, 0x0, 0x0,
+    0x0, 0x0, 0x362, 0x332, 0x1c1, 0x50e, 0x0, 0x0, 0x0, 0x0, 0x421, 0x141, 0x215, 0x4e6, 0x542, 0x49b,
+    0x0, 0x12e, 0x208, 0x545, 0x44d, 0x0, 0x56f, 0x0, 0x337, 0x34b, 0x0, 0x213, 0x0, 0x514, 0x0, 0x0,
+    0x29e, 0x0, 0x1ff, 0x4d3, 0x0, 0x0, 0x0, 0x17e, 0x36b, 0x3ba, 0x4bf, 0x0, 0x0, 0x288, 0x2f0, 0x1bc,
+    0x4a2, 0x0, 0x0, 0x46f, 0x353, 0x328, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x478, 0x0, 0x0,
+    0x52e, 0x0, 0x184, 0x0, 0x0, 0x1e6, 0x0, 0x138, 0x0, 0x173, 0x0, 0x0, 0x0, 0x18d, 0x2e2, 0x4ce,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x2d9, 0x0, 0x0, 0x0, 0x230, 0x2ea, 0x0, 0x0, 0x3d1, 0x0, 0x390,
+    0x0, 0x19f, 0x2d0, 0x4f2, 0x55d, 0x0, 0x498, 0x30c, 0x0, 0x0, 0x15e, 0x503, 0x0, 0x29b, 0x252, 0x0,
+    0x0, 0x0, 0x37e, 0x0, 0x35f, 0x1f1, 0x1bf, 0x50c, 0x583, 0x0, 0x0, 0x2a9, 0x0, 0x48c, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x194, 0x1d2, 0x167, 0x22a, 0x1af, 0x25c, 0x256, 0x347, 0x36e, 0x1e9, 0x2cb, 0x3ea, 0x55a,
+    0x0, 0x1c4, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x17c, 0x272, 0x2da, 0x0, 0x0, 0x286,
+    0x170, 0x1b8, 0x2ee, 0x4e0, 0x372, 0x3e4, 0x0, 0x0, 0x0, 0x294, 0x176, 0x244, 0x2b2, 0x310, 0x44f, 0x4aa,
+    0x3c8, 0x562, 0x0, 0x144, 0x303, 0x0, 0x0, 0x2a5, 0x0, 0x134, 0x0, 0x0, 0x1c3, 0x0, 0x0, 0x2c3,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x532, 0x57e, 0x0, 0x20b, 0x3ed, 0x47b, 0x260, 0x0, 0x307,
+    0x1fa, 0x0, 0x0, 0x19e, 0x457, 0x0, 0x2b0, 0x515, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x29a,
+    0x518, 0x0, 0x1cd, 0x0, 0x2c9, 0x131, 0x552, 0x0, 0x0, 0x0, 0x18a, 0x0, 0x0, 0x1ed, 0x329, 0x355,
+    0x1dc, 0x368, 0x448, 0x21e, 0x4ee, 0x0, 0x12c, 0x479, 0x25a, 0x4dc, 0x0, 0x36c, 0x0, 0x0, 0x324, 0x0,
+    0x481, 0x0, 0x2ae, 0x269, 0x0, 0x0, 0x0, 0x27d, 0x0, 0x461, 0x218, 0x439, 0x4f4, 0x0, 0x0, 0x0,
+    0x524, 0x54b, 0x16d, 0x0, 0x0, 0x0, 0x40c, 0x46e, 0x34d, 0x4ae, 0x1a1, 0x0, 0x2f7, 0x4f7, 0x1c6, 0x14f,
+    0x0, 0x0, 0x226, 0x1f0, 0x504, 0x52d, 0x56a, 0x452, 0x0, 0x0, 0x320, 0x0, 0x0, 0x23a, 0x331, 0x361,
+    0x50d, 0x584, 0x0, 0x0, 0x0, 0x460, 0x52b, 0x0, 0x2b8, 0x1c8, 0x3fc, 0x523, 0x0, 0x22d, 0x44c, 0x0,
+    0x0, 0x257, 0x4ac, 0x56e, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2c6, 0x0, 0x0, 0x49c,
+    0x384, 0x299, 0x24f, 0x273, 0x4be, 0x0, 0x0, 0x287, 0x4e1, 0x4a1, 0x263, 0x149, 0x373, 0x0, 0x0, 0x352,
+    0x402, 0x0, 0x565, 0x2b4, 0x0, 0x0, 0x0, 0x37a, 0x454, 0x51f, 0x0, 0x0, 0x304, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x23d, 0x510, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2d4, 0x0, 0x1f6, 0x369,
+    0x3fe, 0x0, 0x0, 0x547, 0x2e9, 0x0, 0x0, 0x308, 0x494, 0x279, 0x0, 0x0, 0x37f, 0x0, 0x0, 0x0,
+    0x0, 0x2a0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x43a, 0x519, 0x0, 0x3bf, 0x1e4, 0x41c, 0x28b, 0x2f1,
+    0x0, 0x582, 0x0, 0x0, 0x0, 0x1d1, 0x2df, 0x1a3, 0x295, 0x2fd, 0x2b6, 0x3cb, 0x48b, 0x4ca, 0x0, 0x42e,
+    0x165, 0x1ad, 0x425, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x1d8, 0x2af, 0x38b, 0x431, 0x466, 0x18f, 0x2c4,
+    0x376, 0x473, 0x4d2, 0x219, 0x3f3, 0x4f8, 0x1cb, 0x1e1, 0x0, 0x0, 0x235, 0x16f, 0x49f, 0x148, 0x3d3, 0x4af,
+    0x4b9, 0x0, 0x0, 0x3b1, 0x2f8, 0x487, 0x561, 0x0, 0x3fa, 0x0, 0x200, 0x228, 0x32b, 0x475, 0x4d6, 0x578,
+    0x0, 0x0, 0x0, 0x527, 0x0, 0x23b, 0x172, 0x4a7, 0x0, 0x0, 0x3ac, 0x27b, 0x0, 0x0, 0x216, 0x567,
+    0x3a6, 0x531, 0x0, 0x399, 0x20a, 0x47a, 0x0, 0x580, 0x1b1, 0x0, 0x40b, 0x46d, 0x3c2, 0x0, 0x0, 0x3f0,
+    0x241, 0x4f5, 0x38d, 0x29f, 0x539, 0x0, 0x27e, 0x0, 0x32a, 0x0, 0x0, 0x0, 0x0, 0x3bb, 0x0, 0x41b,
+    0x392, 0x50b, 0x57a, 0x530, 0x0, 0x40e, 0x27a, 0x0, 0x39b, 0x4f3, 0x0, 0x247, 0x2fb, 0x0, 0x398, 0x1df,
+    0x192, 0x203, 0x229, 0x1aa, 0x281, 0x314, 0x35a, 0x389, 0x3e8, 0x1e7, 0x41f, 0x521, 0x2f4, 0x268, 0x511, 0x0,
+    0x0, 0x0, 0x2e3, 0x0, 0x0, 0x48f, 0x300, 0x438, 0x0, 0x151, 0x31c, 0x0, 0x0, 0x232, 0x1b3, 0x3f5,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x1a0, 0x1db, 0x2b1, 0x3af, 0x4f6, 0x30d, 0x2c7, 0x474, 0x225, 0x15f, 0x51d,
+    0x29c, 0x0, 0x0, 0x534, 0x0, 0x526, 0x0, 0x28d, 0x360, 0x4a5, 0x3b2, 0x0, 0x1fb, 0x0, 0x0, 0x0,
+    0x214, 0x13f, 0x48d, 0x57c, 0x0, 0x3fb, 0x0, 0x3eb, 0x169, 0x22b, 0x32e, 0x507, 0x544, 0x0, 0x0, 0x0,
+    0x325, 0x0, 0x2f5, 0x55c, 0x0, 0x0, 0x0, 0x414, 0x0, 0x0, 0x382, 0x344, 0x298, 0x0, 0x0, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x32f, 0x0, 0x0, 0x0, 0x453, 0x2dc, 0x0, 0x0, 0x13d, 0x0, 0x0, 0x1c7,
+    0x0, 0x379, 0x416, 0x4d7, 0x0, 0x0, 0x424, 0x0, 0x0, 0x0, 0x4c2, 0x0, 0x0, 0x136, 0x404, 0x333,
+    0x264, 0x3a1, 0x3d5, 0x3e7, 0x480, 0x4bc, 0x4e3, 0x48e, 0x500, 0x17a, 0x2d8, 0x0, 0x0, 0x0, 0x546, 0x0,
+    0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x0, 0x2cd, 0x1da, 0x242, 0x3df, 0x4a9, 0x14d, 0x4f9, 0x0, 0x0,
+    0x15a, 0x2d6, 0x0, 0x0, 0x1f7, 0x274, 0x152, 0x1e3, 0x2a3, 0x0, 0x0, 0x0, 0x3f7, 0x4bb, 0x0, 0x42a,
+    0x0, 0x3db, 0x0, 0x489, 0x248, 0x2fc, 0x3c9, 0x49a, 0x258, 0x0, 0x0, 0x163, 0x0, 0x0, 0x36d, 0x0,
+    0x0, 0x156, 0x1e8, 0x13a, 0x3ff, 0x483, 0x26a, 0x557, 0x0, 0x0, 0x472, 0x4d1, 0x0, 0x0, 0x0, 0x17b,
+    0x0, 0x3b7, 0x1e0, 0x2a2, 0x2c8, 0x234, 0x2eb, 0x38a, 0x441, 0x54c, 0x2be, 0x0, 0x34f, 0x0, 0x3b0, 0x435,
+    0x486, 0x53a, 0x55f, 0x43f, 0x190, 0x0, 0x0, 0x575, 0x0, 0x301, 0x407, 0x56b, 0x4c1, 0x1e5, 0x0, 0x0
+};
+
+static const lv_font_fmt_txt_index_t font_index = {
+    .page_map = index_page_map, .pages = index_pages,
+    .hash_keys = index_hash_keys, .hash_glyph_ids = index_hash_glyph_ids,
+    .page_cnt = 2, .hash_bits = 11
+};
+
+/*End of the code point index*/
+
 /*--------------------
  *  ALL CUSTOM DATA
  *--------------------*/
@@ -23743,7 +24072,8 @@ static lv_font_fmt_txt_dsc_t font_dsc = {
     .kern_classes = 0,
     .bitmap_format = 0,
 #if LV_VERSION_CHECK(8, 0, 0)
-    .cache = &cache
+    .cache = &cache,
+    .index = &font_index
 #endif
 };
 
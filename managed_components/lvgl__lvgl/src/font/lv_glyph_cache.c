@@ -0,0 +1,341 @@
+/**
+ * @file lv_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_glyph_cache.h"
+#include "../misc/lv_assert.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_lru.h"
+#include "../misc/lv_mem.h"
+#include "../misc/lv_log.h"
+#include "../misc/lv_printf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Estimated size of a glyph to size the hash table*/
+#define AVG_GLYPH_SIZE  256
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+} cache_key_t;
+
+typedef struct {
+    _lv_glyph_cache_entry_t entry;
+    cache_key_t key;
+    uint32_t size;
+} cache_item_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    static cache_item_t * item_create(const lv_font_t * font, uint32_t letter);
+    static void cache_create(uint32_t budget);
+    static void lru_value_free(void * v);
+    static void item_free(cache_item_t * item);
+    static void key_init(cache_key_t * key, const lv_font_t * font, uint32_t letter);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_glyph_cache_stats_t stats;
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    static lv_glyph_cache_alloc_cb_t mem_alloc_cb;
+    static lv_glyph_cache_free_cb_t mem_free_cb;
+    static bool invalidating;
+#endif
+
+/**********************
+ *  GLOBAL VARIABLES
+ **********************/
+extern const uint8_t _lv_bpp1_opa_table[2];
+extern const uint8_t _lv_bpp2_opa_table[4];
+extern const uint8_t _lv_bpp4_opa_table[16];
+extern const uint8_t _lv_bpp8_opa_table[256];
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the glyph cache with `LV_GLYPH_CACHE_DEF_BUDGET`
+ */
+void _lv_glyph_cache_init(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    _lv_ll_init(&LV_GC_ROOT(_lv_glyph_cache_ll), sizeof(cache_item_t *));
+    LV_GC_ROOT(_lv_glyph_cache_lru) = NULL;
+    mem_alloc_cb = NULL;
+    mem_free_cb = NULL;
+    cache_create(LV_GLYPH_CACHE_DEF_BUDGET);
+#endif
+}
+
+/**
+ * Get the unpacked glyph of a letter. The glyph is unpacked and cached if it's not cached yet.
+ * The returned entry is valid until the next call.
+ * @param font      pointer to a font
+ * @param letter    a UNICODE letter code
+ * @return          pointer to the cache entry or NULL if the glyph can't be cached.
+ *                  E.g. the cache is disabled, the letter is not found or it's sub-pixel rendered.
+ */
+const _lv_glyph_cache_entry_t * _lv_glyph_cache_get(const lv_font_t * font, uint32_t letter)
+{
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    if(LV_GC_ROOT(_lv_glyph_cache_lru) == NULL) return NULL;
+
+    cache_key_t key;
+    key_init(&key, font, letter);
+    void * value = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_glyph_cache_lru), &key, sizeof(key), &value);
+    if(value) {
+        stats.hits++;
+        return &((cache_item_t *)value)->entry;
+    }
+
+    cache_item_t * item = item_create(font, letter);
+    if(item == NULL) return NULL;
+
+    stats.misses++;
+    if(item->size > LV_GC_ROOT(_lv_glyph_cache_lru)->total_memory) {
+        LV_LOG_INFO("glyph cache: U+%" LV_PRIX32 " doesn't fit into the cache", letter);
+        item_free(item);
+        return NULL;
+    }
+
+    cache_item_t ** item_p = _lv_ll_ins_head(&LV_GC_ROOT(_lv_glyph_cache_ll));
+    LV_ASSERT_MALLOC(item_p);
+    if(item_p == NULL) {
+        item_free(item);
+        return NULL;
+    }
+    *item_p = item;
+    stats.entry_cnt++;
+
+    lv_lru_set(LV_GC_ROOT(_lv_glyph_cache_lru), &key, sizeof(key), item, item->size);
+    return &item->entry;
+#else
+    LV_UNUSED(font);
+    LV_UNUSED(letter);
+    return NULL;
+#endif
+}
+
+/**
+ * Set the memory the cached glyphs can use.
+ * The least recently used glyphs are removed to stay within the budget.
+ * @param budget    size in bytes. 0: disable the cache
+ */
+void lv_glyph_cache_set_budget(uint32_t budget)
+{
+#if LV_GLYPH_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(budget);
+    LV_LOG_WARN("Can't change the glyph cache budget because it's disabled by LV_GLYPH_CACHE_DEF_BUDGET = 0");
+#else
+    cache_create(budget);
+#endif
+}
+
+/**
+ * Set where the cached glyphs are stored. E.g. in external RAM.
+ * The cached glyphs are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_glyph_cache_set_mem_cb(lv_glyph_cache_alloc_cb_t alloc_cb, lv_glyph_cache_free_cb_t free_cb)
+{
+#if LV_GLYPH_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(alloc_cb);
+    LV_UNUSED(free_cb);
+    LV_LOG_WARN("Can't set the glyph cache memory because it's disabled by LV_GLYPH_CACHE_DEF_BUDGET = 0");
+#else
+    /*The cached glyphs need to be freed with the callback they were allocated with*/
+    lv_glyph_cache_invalidate_font(NULL);
+
+    mem_alloc_cb = free_cb ? alloc_cb : NULL;
+    mem_free_cb = free_cb;
+#endif
+}
+
+/**
+ * Remove the glyphs of a font from the cache. Needs to be called before a font is freed.
+ * @param font      pointer to a font or NULL to remove every glyph
+ */
+void lv_glyph_cache_invalidate_font(const lv_font_t * font)
+{
+    LV_UNUSED(font);
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    if(LV_GC_ROOT(_lv_glyph_cache_lru) == NULL) return;
+
+    invalidating = true;
+    cache_item_t ** item_p = _lv_ll_get_head(&LV_GC_ROOT(_lv_glyph_cache_ll));
+    while(item_p) {
+        cache_item_t ** next = _lv_ll_get_next(&LV_GC_ROOT(_lv_glyph_cache_ll), item_p);
+        cache_item_t * item = *item_p;
+        if(font == NULL || item->key.font == font) {
+            lv_lru_remove(LV_GC_ROOT(_lv_glyph_cache_lru), &item->key, sizeof(cache_key_t));
+        }
+        item_p = next;
+    }
+    invalidating = false;
+#endif
+}
+
+/**
+ * Get the statistics of the glyph cache.
+ * @param stats_out     store the statistics here
+ */
+void lv_glyph_cache_get_stats(lv_glyph_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+#if LV_GLYPH_CACHE_DEF_BUDGET
+    lv_lru_t * lru = LV_GC_ROOT(_lv_glyph_cache_lru);
+    if(lru) stats_out->size = (uint32_t)(lru->total_memory - lru->free_memory);
+#endif
+}
+
+/**
+ * Clear the hit, miss and eviction counters.
+ */
+void lv_glyph_cache_reset_stats(void)
+{
+    stats.hits = 0;
+    stats.misses = 0;
+    stats.evictions = 0;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_GLYPH_CACHE_DEF_BUDGET
+
+/*Unpack the glyph of a letter into an item allocated with `mem_alloc_cb`*/
+static cache_item_t * item_create(const lv_font_t * font, uint32_t letter)
+{
+    lv_font_glyph_dsc_t g;
+    if(!lv_font_get_glyph_dsc(font, &g, letter, '\0')) return NULL;
+
+    /*Sub-pixel rendered glyphs and image fonts are drawn in a different way*/
+    uint32_t bpp = g.bpp;
+    if(bpp == 3) bpp = 4;
+    if(g.resolved_font->subpx || (bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8)) return NULL;
+
+    const uint8_t * bpp_opa_table;
+    switch(bpp) {
+        case 1:
+            bpp_opa_table = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            bpp_opa_table = _lv_bpp2_opa_table;
+            break;
+        case 4:
+            bpp_opa_table = _lv_bpp4_opa_table;
+            break;
+        default:
+            bpp_opa_table = _lv_bpp8_opa_table;
+            break;
+    }
+
+    uint32_t px_cnt = (uint32_t)g.box_w * g.box_h;
+    const uint8_t * map_p = NULL;
+    if(px_cnt) {
+        map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if(map_p == NULL) return NULL;
+    }
+
+    uint32_t size = sizeof(cache_item_t) + px_cnt;
+    cache_item_t * item = mem_alloc_cb ? mem_alloc_cb(size) : lv_mem_alloc(size);
+    if(item == NULL) {
+        LV_LOG_WARN("glyph cache: couldn't allocate %" LV_PRIu32 " bytes", size);
+        return NULL;
+    }
+
+    item->entry.dsc = g;
+    key_init(&item->key, font, letter);
+    item->size = size;
+
+    /*The pixels are stored after each other without padding at the end of the rows*/
+    uint8_t * a8 = (uint8_t *)&item[1];
+    uint32_t mask = (1 << bpp) - 1;
+    uint32_t bit = 0;
+    uint32_t i;
+    for(i = 0; i < px_cnt; i++) {
+        uint32_t px = (map_p[bit >> 3] >> (8 - bpp - (bit & 0x7))) & mask;
+        a8[i] = bpp_opa_table[px];
+        bit += bpp;
+    }
+    item->entry.map = a8;
+
+    return item;
+}
+
+/*Drop the cached glyphs and create a new LRU with the given budget*/
+static void cache_create(uint32_t budget)
+{
+    if(LV_GC_ROOT(_lv_glyph_cache_lru)) {
+        lv_glyph_cache_invalidate_font(NULL);
+        lv_lru_del(LV_GC_ROOT(_lv_glyph_cache_lru));
+        LV_GC_ROOT(_lv_glyph_cache_lru) = NULL;
+    }
+
+    if(budget == 0) return;
+
+    LV_GC_ROOT(_lv_glyph_cache_lru) = lv_lru_create(budget, AVG_GLYPH_SIZE, lru_value_free, NULL);
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_glyph_cache_lru));
+}
+
+/*Called by the LRU when a glyph is evicted or removed*/
+static void lru_value_free(void * v)
+{
+    cache_item_t * item = v;
+
+    if(!invalidating) {
+        stats.evictions++;
+        LV_LOG_TRACE("glyph cache: remove the least recently used glyph");
+    }
+
+    /*Forget it in the list of the items*/
+    cache_item_t ** item_p;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_glyph_cache_ll), item_p) {
+        if(*item_p == item) {
+            _lv_ll_remove(&LV_GC_ROOT(_lv_glyph_cache_ll), item_p);
+            lv_mem_free(item_p);
+            stats.entry_cnt--;
+            break;
+        }
+    }
+
+    item_free(item);
+}
+
+static void item_free(cache_item_t * item)
+{
+    if(mem_alloc_cb) mem_free_cb(item);
+    else lv_mem_free(item);
+}
+
+/*The key is hashed byte by byte, so clear the padding too*/
+static void key_init(cache_key_t * key, const lv_font_t * font, uint32_t letter)
+{
+    lv_memset_00(key, sizeof(cache_key_t));
+    key->font = font;
+    key->letter = letter;
+}
+
+#endif /*LV_GLYPH_CACHE_DEF_BUDGET*/
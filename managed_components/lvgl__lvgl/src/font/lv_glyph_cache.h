@@ -0,0 +1,107 @@
+/**
+ * @file lv_glyph_cache.h
+ *
+ */
+
+#ifndef LV_GLYPH_CACHE_H
+#define LV_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**
+ * Drawing a letter unpacks the 1, 2, 4 or 8 bpp bitmap of its glyph and maps the values to opacities.
+ *
+ * To avoid repeating it for every redraw the unpacked glyphs can be cached.
+ */
+typedef struct {
+    lv_font_glyph_dsc_t dsc;    /**< Descriptor of the glyph without kerning*/
+    const uint8_t * map;        /**< `box_w * box_h` opacity values*/
+} _lv_glyph_cache_entry_t;
+
+/** Statistics of the glyph cache*/
+typedef struct {
+    uint32_t hits;          /**< Number of glyphs found in the cache*/
+    uint32_t misses;        /**< Number of glyphs which needed to be unpacked*/
+    uint32_t evictions;     /**< Number of glyphs removed to make space for new ones*/
+    uint32_t size;          /**< Bytes used by the cached glyphs*/
+    uint16_t entry_cnt;     /**< Number of cached glyphs*/
+} lv_glyph_cache_stats_t;
+
+typedef void * (*lv_glyph_cache_alloc_cb_t)(size_t size);
+typedef void (*lv_glyph_cache_free_cb_t)(void * p);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the glyph cache with `LV_GLYPH_CACHE_DEF_BUDGET`
+ */
+void _lv_glyph_cache_init(void);
+
+/**
+ * Get the unpacked glyph of a letter. The glyph is unpacked and cached if it's not cached yet.
+ * The returned entry is valid until the next call.
+ * @param font      pointer to a font
+ * @param letter    a UNICODE letter code
+ * @return          pointer to the cache entry or NULL if the glyph can't be cached.
+ *                  E.g. the cache is disabled, the letter is not found or it's sub-pixel rendered.
+ */
+const _lv_glyph_cache_entry_t * _lv_glyph_cache_get(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Set the memory the cached glyphs can use.
+ * The least recently used glyphs are removed to stay within the budget.
+ * @param budget    size in bytes. 0: disable the cache
+ */
+void lv_glyph_cache_set_budget(uint32_t budget);
+
+/**
+ * Set where the cached glyphs are stored. E.g. in external RAM.
+ * The cached glyphs are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_glyph_cache_set_mem_cb(lv_glyph_cache_alloc_cb_t alloc_cb, lv_glyph_cache_free_cb_t free_cb);
+
+/**
+ * Remove the glyphs of a font from the cache. Needs to be called before a font is freed.
+ * @param font      pointer to a font or NULL to remove every glyph
+ */
+void lv_glyph_cache_invalidate_font(const lv_font_t * font);
+
+/**
+ * Get the statistics of the glyph cache.
+ * @param stats     store the statistics here
+ */
+void lv_glyph_cache_get_stats(lv_glyph_cache_stats_t * stats);
+
+/**
+ * Clear the hit, miss and eviction counters.
+ */
+void lv_glyph_cache_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_GLYPH_CACHE_H*/
@@ -204,6 +204,11 @@ lv_disp_t * lv_disp_drv_register(lv_disp_drv_t * driver)
         LV_LOG_WARN("full_refresh requires at least screen sized draw buffer(s)");
     }
 
+    if(driver->render_rotated && (driver->direct_mode || driver->set_px_cb || driver->screen_transp)) {
+        driver->render_rotated = 0;
+        LV_LOG_WARN("render_rotated can't be used with direct_mode, set_px_cb or screen_transp");
+    }
+
     disp->bg_color = lv_color_white();
 #if LV_COLOR_SCREEN_TRANSP
     disp->bg_opa = LV_OPA_TRANSP;
@@ -257,6 +262,12 @@ void lv_disp_drv_update(lv_disp_t * disp, lv_disp_drv_t * new_drv)
         LV_LOG_WARN("full_refresh requires at least screen sized draw buffer(s)");
     }
 
+    if(disp->driver->render_rotated &&
+       (disp->driver->direct_mode || disp->driver->set_px_cb || disp->driver->screen_transp)) {
+        disp->driver->render_rotated = 0;
+        LV_LOG_WARN("render_rotated can't be used with direct_mode, set_px_cb or screen_transp");
+    }
+
     lv_coord_t w = lv_disp_get_hor_res(disp);
     lv_coord_t h = lv_disp_get_ver_res(disp);
     uint32_t i;
@@ -319,6 +330,8 @@ void lv_disp_remove(lv_disp_t * disp)
 
     _lv_ll_remove(&LV_GC_ROOT(_lv_disp_ll), disp);
     _lv_ll_clear(&disp->sync_areas);
+    lv_mem_free(disp->rot_bufs[0]);
+    lv_mem_free(disp->rot_bufs[1]);
     if(disp->refr_timer) lv_timer_del(disp->refr_timer);
     lv_mem_free(disp);
 
@@ -518,6 +531,11 @@ lv_coord_t lv_disp_get_dpi(const lv_disp_t * disp)
  */
 void LV_ATTRIBUTE_FLUSH_READY lv_disp_flush_ready(lv_disp_drv_t * disp_drv)
 {
+#if LV_USE_PERF_MONITOR
+    lv_disp_draw_buf_t * draw_buf = disp_drv->draw_buf;
+    if(draw_buf->flushing) draw_buf->flush_time_sum += lv_tick_elaps(draw_buf->flush_start);
+#endif
+
     disp_drv->draw_buf->flushing = 0;
     disp_drv->draw_buf->flushing_last = 0;
 }
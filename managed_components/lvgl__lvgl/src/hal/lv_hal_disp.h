@@ -32,6 +32,10 @@ extern "C" {
 #define LV_INV_BUF_SIZE 32 /*Buffer size for invalid areas*/
 #endif
 
+#ifndef LV_INV_AREA_OVERHEAD
+#define LV_INV_AREA_OVERHEAD 512 /*Cost of redrawing an area besides its pixels (drawing the objects, flushing) in pixels*/
+#endif
+
 #ifndef LV_ATTRIBUTE_FLUSH_READY
 #define LV_ATTRIBUTE_FLUSH_READY
 #endif
@@ -61,6 +65,10 @@ typedef struct _lv_disp_draw_buf_t {
     volatile int flushing_last;
     volatile uint32_t last_area         : 1; /*1: the last area is being rendered*/
     volatile uint32_t last_part         : 1; /*1: the last part of the current area is being rendered*/
+#if LV_USE_PERF_MONITOR
+    uint32_t flush_start;               /*Tick when the current flush was started*/
+    volatile uint32_t flush_time_sum;   /*Time spent with flushing, collected by the performance monitor*/
+#endif
 } lv_disp_draw_buf_t;
 
 typedef enum {
@@ -95,6 +103,8 @@ typedef struct _lv_disp_drv_t {
     uint32_t direct_mode : 1;        /**< 1: Use screen-sized buffers and draw to absolute coordinates*/
     uint32_t full_refresh : 1;       /**< 1: Always make the whole screen redrawn*/
     uint32_t sw_rotate : 1;          /**< 1: use software rotation (slower)*/
+    uint32_t render_rotated : 1;     /**< 1: with `sw_rotate` render directly in the display's native orientation
+                                       * instead of rotating the rendered areas before flushing them*/
     uint32_t antialiasing : 1;       /**< 1: anti-aliasing is enabled on this display.*/
     uint32_t rotated : 2;            /**< 1: turn the display by 90 degree. @warning Does not update coordinates for you!*/
     uint32_t screen_transp : 1;      /**Handle if the screen doesn't have a solid (opa == LV_OPA_COVER) background.
@@ -151,6 +161,15 @@ typedef struct _lv_disp_drv_t {
 
 } lv_disp_drv_t;
 
+/**
+ * Statistics of the invalidated areas. They are only counted, write 0 to reset them.
+ */
+typedef struct {
+    uint32_t areas_in;      /**< Number of areas invalidated on the screen*/
+    uint32_t areas_out;     /**< Number of areas redrawn after joining the invalidated areas*/
+    uint32_t overdraw_px;   /**< Pixels redrawn only because two areas were joined*/
+} lv_disp_inv_stats_t;
+
 /**
  * Display structure.
  * @note `lv_disp_drv_t` should be the first member of the structure.
@@ -186,10 +205,15 @@ typedef struct _lv_disp_t {
     uint8_t inv_area_joined[LV_INV_BUF_SIZE];
     uint16_t inv_p;
     int32_t inv_en_cnt;
+    lv_disp_inv_stats_t inv_stats;
 
     /** Double buffer sync areas */
     lv_ll_t sync_areas;
 
+    /** Buffers for the chunks rotated by `sw_rotate`. They are used in turns to rotate the next chunk
+     *  while the previous one is being flushed*/
+    lv_color_t * rot_bufs[2];
+
     /*Miscellaneous data*/
     uint32_t last_activity_time;        /**< Last time when there was activity on this display*/
 } lv_disp_t;
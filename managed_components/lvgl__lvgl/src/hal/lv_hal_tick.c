@@ -28,6 +28,7 @@
 /**********************
  *  STATIC VARIABLES
  **********************/
+static lv_tick_get_cb_t tick_get_cb;
 #if !LV_TICK_CUSTOM
     static uint32_t sys_time = 0;
     static volatile uint8_t tick_irq_flag;
@@ -59,6 +60,8 @@ void LV_ATTRIBUTE_TICK_INC lv_tick_inc(uint32_t tick_period)
  */
 uint32_t lv_tick_get(void)
 {
+    if(tick_get_cb) return tick_get_cb();
+
 #if LV_TICK_CUSTOM == 0
 
     /*If `lv_tick_inc` is called from an interrupt while `sys_time` is read
@@ -78,6 +81,15 @@ uint32_t lv_tick_get(void)
 #endif
 }
 
+/**
+ * Read the tick from a monotonic clock instead of counting it
+ * @param cb function returning the elapsed milliseconds or NULL to use the counted tick again
+ */
+void lv_tick_set_cb(lv_tick_get_cb_t cb)
+{
+    tick_get_cb = cb;
+}
+
 /**
  * Get the elapsed milliseconds since a previous time stamp
  * @param prev_tick a previous time stamp (return value of lv_tick_get() )
@@ -29,6 +29,12 @@ extern "C" {
  *      TYPEDEFS
  **********************/
 
+/**
+ * Tell the elapsed milliseconds from a monotonic clock of the system. See `lv_tick_set_cb`
+ * @return the elapsed milliseconds, may overflow
+ */
+typedef uint32_t (*lv_tick_get_cb_t)(void);
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,6 +57,13 @@ void /* LV_ATTRIBUTE_TICK_INC */ lv_tick_inc(uint32_t tick_period);
  */
 uint32_t lv_tick_get(void);
 
+/**
+ * Read the tick from a monotonic clock instead of counting it with `lv_tick_inc()` or `LV_TICK_CUSTOM`.
+ * `lv_tick_inc()` doesn't need to be called then and the time is correct after any long sleep.
+ * @param cb    function returning the elapsed milliseconds or NULL to use the counted tick again
+ */
+void lv_tick_set_cb(lv_tick_get_cb_t cb);
+
 /**
  * Get the elapsed milliseconds since a previous time stamp
  * @param prev_tick a previous time stamp (return value of lv_tick_get() )
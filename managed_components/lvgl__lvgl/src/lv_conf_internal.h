@@ -229,6 +229,27 @@
     #endif
 #endif
 
+/*Number of commands which can wait in the queue of `lv_cmd_queue_post_...()`.
+ *Other threads post text, style and value changes there without locks and `lv_timer_handler` applies them.
+ *Must be a power of 2. 0: to disable the command queue*/
+#ifndef LV_CMD_QUEUE_LEN
+    #ifdef CONFIG_LV_CMD_QUEUE_LEN
+        #define LV_CMD_QUEUE_LEN CONFIG_LV_CMD_QUEUE_LEN
+    #else
+        #define LV_CMD_QUEUE_LEN 0
+    #endif
+#endif
+
+/*Maximal length of a text posted with `lv_cmd_queue_post_text()`, including the terminating 0.
+ *Every command of the queue has this size at least.*/
+#ifndef LV_CMD_QUEUE_TEXT_LEN
+    #ifdef CONFIG_LV_CMD_QUEUE_TEXT_LEN
+        #define LV_CMD_QUEUE_TEXT_LEN CONFIG_LV_CMD_QUEUE_TEXT_LEN
+    #else
+        #define LV_CMD_QUEUE_TEXT_LEN 32
+    #endif
+#endif
+
 /*Use a custom tick source that tells the elapsed time in milliseconds.
  *It removes the need to manually update the tick with `lv_tick_inc()`)*/
 #ifndef LV_TICK_CUSTOM
@@ -315,6 +336,21 @@
     #endif
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Max. number of horizontal bands the software renderer splits large blends and images into.
+ *The bands are drawn in parallel by the workers set with `lv_draw_sw_bands_set_worker()`.
+ *1: draw everything in the LVGL thread*/
+#ifndef LV_DRAW_SW_BANDS
+    #ifdef _LV_KCONFIG_PRESENT
+        #ifdef CONFIG_LV_DRAW_SW_BANDS
+            #define LV_DRAW_SW_BANDS CONFIG_LV_DRAW_SW_BANDS
+        #else
+            #define LV_DRAW_SW_BANDS 0
+        #endif
+    #else
+        #define LV_DRAW_SW_BANDS 1
+    #endif
+#endif
+
 /**
  * "Simple layers" are used when a widget has `style_opa < 255` to buffer the widget into a layer
  * and blend it as an image with the given opacity.
@@ -356,6 +392,29 @@
     #endif
 #endif
 
+/*Default memory budget of the image cache in bytes.
+ *The least recently used images are closed to stay within the budget and larger images are not cached.
+ *0: no limit, only the number of images is limited*/
+#ifndef LV_IMG_CACHE_DEF_BUDGET
+    #ifdef CONFIG_LV_IMG_CACHE_DEF_BUDGET
+        #define LV_IMG_CACHE_DEF_BUDGET CONFIG_LV_IMG_CACHE_DEF_BUDGET
+    #else
+        #define LV_IMG_CACHE_DEF_BUDGET 0
+    #endif
+#endif
+
+/*Number of images which can wait to be decoded in the background for `lv_img`s with `lv_img_set_async`.
+ *A placeholder is drawn until the image is decoded into the image cache by the worker thread
+ *set with `lv_img_async_set_worker` or in `lv_timer_handler`. Requires LV_IMG_CACHE_DEF_SIZE.
+ *0: to disable decoding in the background*/
+#ifndef LV_IMG_ASYNC_QUEUE_LEN
+    #ifdef CONFIG_LV_IMG_ASYNC_QUEUE_LEN
+        #define LV_IMG_ASYNC_QUEUE_LEN CONFIG_LV_IMG_ASYNC_QUEUE_LEN
+    #else
+        #define LV_IMG_ASYNC_QUEUE_LEN 0
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -412,6 +471,18 @@
     #endif
 #endif
 
+/*Number of style snapshots. A snapshot keeps the resolved draw properties (colors, opacities, widths, font etc.)
+ *of a part of an object in a state, so redrawing the object doesn't search its styles again.
+ *About 64 * sizeof(lv_style_value_t) bytes are used per snapshot.
+ *0: to disable the snapshots*/
+#ifndef LV_OBJ_STYLE_SNAPSHOT_CNT
+    #ifdef CONFIG_LV_OBJ_STYLE_SNAPSHOT_CNT
+        #define LV_OBJ_STYLE_SNAPSHOT_CNT CONFIG_LV_OBJ_STYLE_SNAPSHOT_CNT
+    #else
+        #define LV_OBJ_STYLE_SNAPSHOT_CNT 0
+    #endif
+#endif
+
 /*-------------
  * GPU
  *-----------*/
@@ -1261,6 +1332,30 @@
     #endif
 #endif
 
+/*Default memory budget of the glyph cache in bytes.
+ *The unpacked glyphs are cached to draw the letters faster.
+ *0: to disable the glyph cache*/
+#ifndef LV_GLYPH_CACHE_DEF_BUDGET
+    #ifdef CONFIG_LV_GLYPH_CACHE_DEF_BUDGET
+        #define LV_GLYPH_CACHE_DEF_BUDGET CONFIG_LV_GLYPH_CACHE_DEF_BUDGET
+    #else
+        #define LV_GLYPH_CACHE_DEF_BUDGET 0
+    #endif
+#endif
+
+/*Find the glyphs of the letters of the built-in (lv_font_fmt_txt) fonts with an index instead of searching the cmaps.
+ *The index is built at the first use or can be generated into the font's C file with `scripts/font_index_gen.py`
+ *0: no index, search the cmaps
+ *1: hash table of the code points (~12 bytes/glyph)
+ *2: hash table plus direct lookup pages for the dense blocks of the BMP (e.g. CJK). Fastest but uses more memory*/
+#ifndef LV_FONT_FMT_TXT_INDEX
+    #ifdef CONFIG_LV_FONT_FMT_TXT_INDEX
+        #define LV_FONT_FMT_TXT_INDEX CONFIG_LV_FONT_FMT_TXT_INDEX
+    #else
+        #define LV_FONT_FMT_TXT_INDEX 0
+    #endif
+#endif
+
 /*=================
  *  TEXT SETTINGS
  *=================*/
@@ -1978,6 +2073,26 @@
 
 /*File system interfaces for common APIs */
 
+/*Default memory budget of the block cache of the files in bytes.
+ *The files of the drivers below are read in blocks which are shared by the opened files of the same path.
+ *0: to disable the block cache*/
+#ifndef LV_FS_CACHE_DEF_BUDGET
+    #ifdef CONFIG_LV_FS_CACHE_DEF_BUDGET
+        #define LV_FS_CACHE_DEF_BUDGET CONFIG_LV_FS_CACHE_DEF_BUDGET
+    #else
+        #define LV_FS_CACHE_DEF_BUDGET 0
+    #endif
+#endif
+
+/*Size of a cached block in bytes*/
+#ifndef LV_FS_CACHE_BLOCK_SIZE
+    #ifdef CONFIG_LV_FS_CACHE_BLOCK_SIZE
+        #define LV_FS_CACHE_BLOCK_SIZE CONFIG_LV_FS_CACHE_BLOCK_SIZE
+    #else
+        #define LV_FS_CACHE_BLOCK_SIZE 512
+    #endif
+#endif
+
 /*API for fopen, fread, etc*/
 #ifndef LV_USE_FS_STDIO
     #ifdef CONFIG_LV_USE_FS_STDIO
@@ -2151,6 +2266,18 @@
         #define LV_USE_SJPG 0
     #endif
 #endif
+#if LV_USE_SJPG
+    /*Memory used to cache the decoded fragments [bytes]. The least recently used ones are removed first.
+     *The next fragment in the direction of drawing is decoded in advance too.
+     *0: keep only the current fragment of each image*/
+    #ifndef LV_SJPG_CACHE_DEF_BUDGET
+        #ifdef CONFIG_LV_SJPG_CACHE_DEF_BUDGET
+            #define LV_SJPG_CACHE_DEF_BUDGET CONFIG_LV_SJPG_CACHE_DEF_BUDGET
+        #else
+            #define LV_SJPG_CACHE_DEF_BUDGET 0
+        #endif
+    #endif
+#endif
 
 /*GIF decoder library*/
 #ifndef LV_USE_GIF
@@ -2161,6 +2288,15 @@
     #endif
 #endif
 
+/*Image packs converted by scripts/imgpack_conv.py: pixels in LVGL's color formats, optionally compressed in tiles*/
+#ifndef LV_USE_IMGPACK
+    #ifdef CONFIG_LV_USE_IMGPACK
+        #define LV_USE_IMGPACK CONFIG_LV_USE_IMGPACK
+    #else
+        #define LV_USE_IMGPACK 0
+    #endif
+#endif
+
 /*QR code library*/
 #ifndef LV_USE_QRCODE
     #ifdef CONFIG_LV_USE_QRCODE
@@ -20,10 +20,25 @@
  *********************/
 #define LV_ANIM_RESOLUTION 1024
 #define LV_ANIM_RES_SHIFT 10
+#define CHUNK_MIN_SIZE 4
+#define CHUNK_MAX_SIZE 64
+#define BUCKET_MIN_CNT 16
 
 /**********************
  *      TYPEDEFS
  **********************/
+typedef struct _lv_anim_slot_t {
+    lv_anim_t anim;                     /*Keep it first, the slot is the animation for the user*/
+    struct _lv_anim_slot_t * next;      /*The next slot in the same bucket or in the free list*/
+    void * key_var;                     /*`var` of the animation when it was started*/
+    bool used;
+} anim_slot_t;
+
+/*The slots of a chunk follow its header. They never move so the animations can be referenced by pointers.*/
+typedef struct _lv_anim_chunk_t {
+    struct _lv_anim_chunk_t * next;
+    uint32_t slot_cnt;
+} anim_chunk_t;
 
 /**********************
  *  STATIC PROTOTYPES
@@ -31,14 +46,23 @@
 static void anim_timer(lv_timer_t * param);
 static void anim_mark_list_change(void);
 static void anim_ready_handler(lv_anim_t * a);
+static anim_slot_t * slot_alloc(void);
+static void slot_free(anim_slot_t * slot);
+static void slot_del(anim_slot_t * slot);
+static void pool_release(void);
+static inline anim_slot_t * chunk_get_slots(anim_chunk_t * chunk);
+static inline uint32_t hash_var(const void * var);
+static bool hash_insert(anim_slot_t * slot);
+static void hash_remove(anim_slot_t * slot);
+static void hash_grow(void);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static uint32_t last_timer_run;
-static bool anim_list_changed;
 static bool anim_run_round;
 static lv_timer_t * _lv_anim_tmr;
+static uint32_t pool_busy;  /*The chunks are iterated, don't free them*/
 
 /**********************
  *      MACROS
@@ -55,10 +79,10 @@ static lv_timer_t * _lv_anim_tmr;
 
 void _lv_anim_core_init(void)
 {
-    _lv_ll_init(&LV_GC_ROOT(_lv_anim_ll), sizeof(lv_anim_t));
+    lv_memset_00(&LV_GC_ROOT(_lv_anim_pool), sizeof(lv_anim_pool_t));
+    pool_busy = 0;
     _lv_anim_tmr = lv_timer_create(anim_timer, LV_DISP_DEF_REFR_PERIOD, NULL);
     anim_mark_list_change(); /*Turn off the animation timer*/
-    anim_list_changed = false;
 }
 
 void lv_anim_init(lv_anim_t * a)
@@ -79,20 +103,29 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
     /*Do not let two animations for the same 'var' with the same 'exec_cb'*/
     if(a->exec_cb != NULL) lv_anim_del(a->var, a->exec_cb); /*exec_cb == NULL would delete all animations of var*/
 
-    /*If the list is empty the anim timer was suspended and it's last run measure is invalid*/
-    if(_lv_ll_is_empty(&LV_GC_ROOT(_lv_anim_ll))) {
+    /*If there are no animations the anim timer was suspended and it's last run measure is invalid*/
+    if(LV_GC_ROOT(_lv_anim_pool).cnt == 0) {
         last_timer_run = lv_tick_get();
     }
 
-    /*Add the new animation to the animation linked list*/
-    lv_anim_t * new_anim = _lv_ll_ins_head(&LV_GC_ROOT(_lv_anim_ll));
-    LV_ASSERT_MALLOC(new_anim);
-    if(new_anim == NULL) return NULL;
+    /*Add the new animation to the pool*/
+    anim_slot_t * slot = slot_alloc();
+    LV_ASSERT_MALLOC(slot);
+    if(slot == NULL) return NULL;
 
     /*Initialize the animation descriptor*/
+    lv_anim_t * new_anim = &slot->anim;
     lv_memcpy(new_anim, a, sizeof(lv_anim_t));
     if(a->var == a) new_anim->var = new_anim;
-    new_anim->run_round = anim_run_round;
+    new_anim->run_round = anim_run_round;   /*Don't run it in the ongoing round of `anim_timer`*/
+    slot->key_var = new_anim->var;
+    if(!hash_insert(slot)) {
+        LV_ASSERT_MALLOC(NULL);
+        slot_free(slot);
+        return NULL;
+    }
+    slot->used = true;
+    LV_GC_ROOT(_lv_anim_pool).cnt++;
 
     /*Set the start value*/
     if(new_anim->early_apply) {
@@ -105,8 +138,7 @@ lv_anim_t * lv_anim_start(const lv_anim_t * a)
         if(new_anim->exec_cb && new_anim->var) new_anim->exec_cb(new_anim->var, new_anim->start_value);
     }
 
-    /*Creating an animation changed the linked list.
-     *It's important if it happens in a ready callback. (see `anim_timer`)*/
+    /*Resume the anim timer if it was paused*/
     anim_mark_list_change();
 
     TRACE_ANIM("finished");
@@ -136,24 +168,38 @@ uint32_t lv_anim_get_playtime(lv_anim_t * a)
 
 bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    lv_anim_t * a_next;
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
     bool del = false;
-    a        = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-    while(a != NULL) {
-        /*'a' might be deleted, so get the next object while 'a' is valid*/
-        a_next = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
-
-        if((a->var == var || var == NULL) && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-            if(a->deleted_cb != NULL) a->deleted_cb(a);
-            lv_mem_free(a);
-            anim_mark_list_change(); /*Read by `anim_timer`. It need to know if a delete occurred in
-                                       the linked list*/
-            del = true;
+
+    /*Any variable: check all animations. The slots don't move even if `deleted_cb` starts or deletes animations.*/
+    if(var == NULL) {
+        pool_busy++;
+        anim_chunk_t * chunk;
+        for(chunk = pool->chunks; chunk; chunk = chunk->next) {
+            anim_slot_t * slots = chunk_get_slots(chunk);
+            uint32_t i;
+            for(i = 0; i < chunk->slot_cnt; i++) {
+                if(slots[i].used && (slots[i].anim.exec_cb == exec_cb || exec_cb == NULL)) {
+                    slot_del(&slots[i]);
+                    del = true;
+                }
+            }
         }
+        pool_busy--;
+        pool_release();
+        return del;
+    }
+
+    /*Only the bucket of `var` needs to be checked. Start again after a delete as `deleted_cb` can change the bucket.*/
+    while(pool->cnt) {
+        anim_slot_t * slot = pool->buckets[hash_var(var)];
+        while(slot && !(slot->key_var == var && (slot->anim.exec_cb == exec_cb || exec_cb == NULL))) {
+            slot = slot->next;
+        }
+        if(slot == NULL) break;
 
-        a = a_next;
+        slot_del(slot);
+        del = true;
     }
 
     return del;
@@ -161,16 +207,37 @@ bool lv_anim_del(void * var, lv_anim_exec_xcb_t exec_cb)
 
 void lv_anim_del_all(void)
 {
-    _lv_ll_clear(&LV_GC_ROOT(_lv_anim_ll));
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+
+    /*Free the slots of the running animations without calling their callbacks.
+     *The chunks are freed only if they aren't iterated.*/
+    anim_chunk_t * chunk;
+    for(chunk = pool->chunks; chunk; chunk = chunk->next) {
+        anim_slot_t * slots = chunk_get_slots(chunk);
+        uint32_t i;
+        for(i = 0; i < chunk->slot_cnt; i++) {
+            if(!slots[i].used) continue;
+            slots[i].used = false;
+            slots[i].next = pool->free_slots;
+            pool->free_slots = &slots[i];
+        }
+    }
+    if(pool->buckets) lv_memset_00(pool->buckets, pool->bucket_cnt * sizeof(anim_slot_t *));
+    pool->cnt = 0;
+
+    pool_release();
     anim_mark_list_change();
 }
 
 lv_anim_t * lv_anim_get(void * var, lv_anim_exec_xcb_t exec_cb)
 {
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) {
-        if(a->var == var && (a->exec_cb == exec_cb || exec_cb == NULL)) {
-            return a;
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    if(pool->cnt == 0) return NULL;
+
+    anim_slot_t * slot;
+    for(slot = pool->buckets[hash_var(var)]; slot; slot = slot->next) {
+        if(slot->key_var == var && (slot->anim.exec_cb == exec_cb || exec_cb == NULL)) {
+            return &slot->anim;
         }
     }
 
@@ -184,11 +251,7 @@ struct _lv_timer_t * lv_anim_get_timer(void)
 
 uint16_t lv_anim_count_running(void)
 {
-    uint16_t cnt = 0;
-    lv_anim_t * a;
-    _LV_LL_READ(&LV_GC_ROOT(_lv_anim_ll), a) cnt++;
-
-    return cnt;
+    return (uint16_t)LV_GC_ROOT(_lv_anim_pool).cnt;
 }
 
 uint32_t lv_anim_speed_to_time(uint32_t speed, int32_t start, int32_t end)
@@ -355,17 +418,20 @@ static void anim_timer(lv_timer_t * param)
     /*Flip the run round*/
     anim_run_round = anim_run_round ? false : true;
 
-    lv_anim_t * a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-
-    while(a != NULL) {
-        /*It can be set by `lv_anim_del()` typically in `end_cb`. If set then an animation delete
-         * happened in `anim_ready_handler` which could make this linked list reading corrupt
-         * because the list is changed meanwhile
-         */
-        anim_list_changed = false;
-
-        if(a->run_round != anim_run_round) {
-            a->run_round = anim_run_round; /*The list readying might be reset so need to know which anim has run already*/
+    /*Go through the slots of the chunks in memory order. The slots don't move and the chunks aren't freed
+     *meanwhile, so the callbacks can start and delete animations. The new animations are marked as
+     *already run in this round.*/
+    pool_busy++;
+    anim_chunk_t * chunk;
+    for(chunk = LV_GC_ROOT(_lv_anim_pool).chunks; chunk; chunk = chunk->next) {
+        anim_slot_t * slots = chunk_get_slots(chunk);
+        uint32_t i;
+        for(i = 0; i < chunk->slot_cnt; i++) {
+            if(!slots[i].used) continue;
+
+            lv_anim_t * a = &slots[i].anim;
+            if(a->run_round == anim_run_round) continue;
+            a->run_round = anim_run_round;
 
             /*The animation will run now for the first time. Call `start_cb`*/
             int32_t new_act_time = a->act_time + elaps;
@@ -377,6 +443,9 @@ static void anim_timer(lv_timer_t * param)
                 }
                 if(a->start_cb) a->start_cb(a);
                 a->start_cb_called = 1;
+
+                /*`start_cb` might have deleted it*/
+                if(!slots[i].used) continue;
             }
             a->act_time += elaps;
             if(a->act_time >= 0) {
@@ -391,20 +460,15 @@ static void anim_timer(lv_timer_t * param)
                     if(a->exec_cb) a->exec_cb(a->var, new_value);
                 }
 
-                /*If the time is elapsed the animation is ready*/
-                if(a->act_time >= a->time) {
+                /*If the time is elapsed the animation is ready. `exec_cb` might have deleted it.*/
+                if(slots[i].used && a->act_time >= a->time) {
                     anim_ready_handler(a);
                 }
             }
         }
-
-        /*If the linked list changed due to anim. delete then it's not safe to continue
-         *the reading of the list from here -> start from the head*/
-        if(anim_list_changed)
-            a = _lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll));
-        else
-            a = _lv_ll_get_next(&LV_GC_ROOT(_lv_anim_ll), a);
     }
+    pool_busy--;
+    pool_release();
 
     last_timer_run = lv_tick_get();
 }
@@ -426,16 +490,18 @@ static void anim_ready_handler(lv_anim_t * a)
      * - no repeat, play back is enabled and play back is ready*/
     if(a->repeat_cnt == 0 && (a->playback_time == 0 || a->playback_now == 1)) {
 
-        /*Delete the animation from the list.
+        /*Delete the animation from the pool but keep its slot until the callbacks return.
          * This way the `ready_cb` will see the animations like it's animation is ready deleted*/
-        _lv_ll_remove(&LV_GC_ROOT(_lv_anim_ll), a);
-        /*Flag that the list has changed*/
+        anim_slot_t * slot = (anim_slot_t *)a;
+        hash_remove(slot);
+        slot->used = false;
+        LV_GC_ROOT(_lv_anim_pool).cnt--;
         anim_mark_list_change();
 
         /*Call the callback function at the end*/
         if(a->ready_cb != NULL) a->ready_cb(a);
         if(a->deleted_cb != NULL) a->deleted_cb(a);
-        lv_mem_free(a);
+        slot_free(slot);
     }
     /*If the animation is not deleted then restart it*/
     else {
@@ -461,9 +527,153 @@ static void anim_ready_handler(lv_anim_t * a)
 
 static void anim_mark_list_change(void)
 {
-    anim_list_changed = true;
-    if(_lv_ll_get_head(&LV_GC_ROOT(_lv_anim_ll)) == NULL)
+    if(LV_GC_ROOT(_lv_anim_pool).cnt == 0)
         lv_timer_pause(_lv_anim_tmr);
     else
         lv_timer_resume(_lv_anim_tmr);
 }
+
+/**
+ * Get an unused slot. Allocate a new chunk if there is no one.
+ * The chunks grow with the number of animations to keep the few animations of a simple UI small.
+ * @return      pointer to a slot or NULL if out of memory
+ */
+static anim_slot_t * slot_alloc(void)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    if(pool->free_slots == NULL) {
+        uint32_t slot_cnt = LV_CLAMP(CHUNK_MIN_SIZE, pool->cnt, CHUNK_MAX_SIZE);
+        anim_chunk_t * chunk = lv_mem_alloc(sizeof(anim_chunk_t) + slot_cnt * sizeof(anim_slot_t));
+        if(chunk == NULL) return NULL;
+
+        chunk->slot_cnt = slot_cnt;
+        chunk->next = pool->chunks;
+        pool->chunks = chunk;
+
+        /*Add the slots in reverse order to use them in memory order*/
+        anim_slot_t * slots = chunk_get_slots(chunk);
+        uint32_t i;
+        for(i = slot_cnt; i > 0; i--) {
+            slots[i - 1].used = false;
+            slots[i - 1].next = pool->free_slots;
+            pool->free_slots = &slots[i - 1];
+        }
+    }
+
+    anim_slot_t * slot = pool->free_slots;
+    pool->free_slots = slot->next;
+    slot->next = NULL;
+    return slot;
+}
+
+static void slot_free(anim_slot_t * slot)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    slot->next = pool->free_slots;
+    pool->free_slots = slot;
+    pool_release();
+}
+
+/**
+ * Delete a running animation and call its `deleted_cb`
+ * @param slot      slot of the animation
+ */
+static void slot_del(anim_slot_t * slot)
+{
+    hash_remove(slot);
+    slot->used = false;
+    LV_GC_ROOT(_lv_anim_pool).cnt--;
+
+    /*Keep the chunk of the slot even if `deleted_cb` deletes the last animation*/
+    pool_busy++;
+    if(slot->anim.deleted_cb != NULL) slot->anim.deleted_cb(&slot->anim);
+    pool_busy--;
+    slot_free(slot);
+    anim_mark_list_change();
+}
+
+/**
+ * Free the chunks and the hash table if there are no animations and the chunks aren't iterated
+ */
+static void pool_release(void)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    if(pool->cnt || pool_busy) return;
+
+    anim_chunk_t * chunk = pool->chunks;
+    while(chunk) {
+        anim_chunk_t * next = chunk->next;
+        lv_mem_free(chunk);
+        chunk = next;
+    }
+    lv_mem_free(pool->buckets);
+    lv_memset_00(pool, sizeof(lv_anim_pool_t));
+}
+
+static inline anim_slot_t * chunk_get_slots(anim_chunk_t * chunk)
+{
+    return (anim_slot_t *)(chunk + 1);
+}
+
+static inline uint32_t hash_var(const void * var)
+{
+    lv_uintptr_t p = (lv_uintptr_t)var;
+    uint32_t h = (uint32_t)(p ^ (p >> 16 >> 16));
+    h *= 2654435761u;
+    h ^= h >> 15;
+    return h & (LV_GC_ROOT(_lv_anim_pool).bucket_cnt - 1);
+}
+
+/**
+ * Add a slot to the hash table. Grow the table if needed.
+ * @param slot      slot with `key_var` set
+ * @return          true: added; false: the hash table couldn't be allocated
+ */
+static bool hash_insert(anim_slot_t * slot)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    if(pool->cnt >= pool->bucket_cnt) hash_grow();
+    if(pool->buckets == NULL) return false;
+
+    uint32_t i = hash_var(slot->key_var);
+    slot->next = pool->buckets[i];
+    pool->buckets[i] = slot;
+    return true;
+}
+
+static void hash_remove(anim_slot_t * slot)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    anim_slot_t ** prev = &pool->buckets[hash_var(slot->key_var)];
+    while(*prev != slot) prev = &(*prev)->next;
+    *prev = slot->next;
+    slot->next = NULL;
+}
+
+/**
+ * Double the hash table. If there is no memory the old table is kept with longer chains.
+ */
+static void hash_grow(void)
+{
+    lv_anim_pool_t * pool = &LV_GC_ROOT(_lv_anim_pool);
+    uint32_t new_cnt = pool->bucket_cnt ? pool->bucket_cnt * 2 : BUCKET_MIN_CNT;
+    anim_slot_t ** buckets = lv_mem_alloc(new_cnt * sizeof(anim_slot_t *));
+    if(buckets == NULL) return;
+    lv_memset_00(buckets, new_cnt * sizeof(anim_slot_t *));
+
+    lv_mem_free(pool->buckets);
+    pool->buckets = buckets;
+    pool->bucket_cnt = new_cnt;
+
+    anim_chunk_t * chunk;
+    for(chunk = pool->chunks; chunk; chunk = chunk->next) {
+        anim_slot_t * slots = chunk_get_slots(chunk);
+        uint32_t i;
+        for(i = 0; i < chunk->slot_cnt; i++) {
+            if(!slots[i].used) continue;
+            uint32_t b = hash_var(slots[i].key_var);
+            slots[i].next = buckets[b];
+            buckets[b] = &slots[i];
+        }
+    }
+}
@@ -98,6 +98,15 @@ typedef struct _lv_anim_t {
     uint8_t start_cb_called : 1;    /**< Indicates that the `start_cb` was already called*/
 } lv_anim_t;
 
+/** The running animations. They are allocated in chunks and found by their variable in a hash table.*/
+typedef struct {
+    struct _lv_anim_chunk_t * chunks;       /**< The memory of the animations*/
+    struct _lv_anim_slot_t * free_slots;    /**< The unused slots of the chunks*/
+    struct _lv_anim_slot_t ** buckets;      /**< Hash table of the animations by their `var`*/
+    uint32_t bucket_cnt;                    /**< Size of the hash table, a power of 2*/
+    uint32_t cnt;                           /**< Number of running animations*/
+} lv_anim_pool_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_fs.h"
+#include "lv_fs_cache.h"
 
 #include "../misc/lv_assert.h"
 #include "lv_ll.h"
@@ -90,8 +91,12 @@ lv_fs_res_t lv_fs_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mo
 
     file_p->drv = drv;
     file_p->file_d = file_d;
+    file_p->cache = NULL;
 
-    if(drv->cache_size) {
+    if(drv->block_cache && _lv_fs_cache_open(file_p, path, mode)) {
+        /*The blocks of the file are shared with the other files of the same path*/
+    }
+    else if(drv->cache_size) {
         file_p->cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t));
         LV_ASSERT_MALLOC(file_p->cache);
         lv_memset_00(file_p->cache, sizeof(lv_fs_file_cache_t));
@@ -114,7 +119,11 @@ lv_fs_res_t lv_fs_close(lv_fs_file_t * file_p)
 
     lv_fs_res_t res = file_p->drv->close_cb(file_p->drv, file_p->file_d);
 
-    if(file_p->drv->cache_size && file_p->cache) {
+    if(file_p->cache) {
+        if(file_p->cache->node) {
+            _lv_fs_cache_close(file_p);
+        }
+
         if(file_p->cache->buffer) {
             lv_mem_free(file_p->cache->buffer);
         }
@@ -157,6 +166,9 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
                 /*If remaining data chuck is bigger than buffer size, then do not use cache, instead read it directly from FS*/
                 res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)(buf + buffer_remaining_length),
                                            btr - buffer_remaining_length, &bytes_read_to_buffer);
+                /*The FS position is after the cached range now, so a later seek into it has to seek in the FS*/
+                file_p->cache->start = UINT32_MAX;
+                file_p->cache->end = UINT32_MAX - 1;
             }
             else {
                 /*If remaining data chunk is smaller than buffer size, then read into cache buffer*/
@@ -175,6 +187,8 @@ static lv_fs_res_t lv_fs_read_cached(lv_fs_file_t * file_p, char * buf, uint32_t
         if(btr > buffer_size) {
             /*If bigger data is requested, then do not use cache, instead read it directly*/
             res = file_p->drv->read_cb(file_p->drv, file_p->file_d, (void *)buf, btr, br);
+            file_p->cache->start = UINT32_MAX;
+            file_p->cache->end = UINT32_MAX - 1;
         }
         else {
             /*If small data is requested, then read from FS into cache buffer*/
@@ -211,7 +225,10 @@ lv_fs_res_t lv_fs_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t
     uint32_t br_tmp = 0;
     lv_fs_res_t res;
 
-    if(file_p->drv->cache_size) {
+    if(file_p->cache && file_p->cache->node) {
+        res = _lv_fs_cache_read(file_p, buf, btr, &br_tmp);
+    }
+    else if(file_p->drv->cache_size) {
         res = lv_fs_read_cached(file_p, (char *)buf, btr, &br_tmp);
     }
     else {
@@ -236,7 +253,13 @@ lv_fs_res_t lv_fs_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, u
     }
 
     uint32_t bw_tmp = 0;
-    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    lv_fs_res_t res;
+    if(file_p->cache && file_p->cache->node) {
+        res = _lv_fs_cache_write(file_p, buf, btw, &bw_tmp);
+    }
+    else {
+        res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, &bw_tmp);
+    }
     if(bw != NULL) *bw = bw_tmp;
 
     return res;
@@ -253,7 +276,10 @@ lv_fs_res_t lv_fs_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whenc
     }
 
     lv_fs_res_t res = LV_FS_RES_OK;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache && file_p->cache->node) {
+        res = _lv_fs_cache_seek(file_p, pos, whence);
+    }
+    else if(file_p->drv->cache_size) {
         switch(whence) {
             case LV_FS_SEEK_SET: {
                     file_p->cache->file_position = pos;
@@ -310,7 +336,7 @@ lv_fs_res_t lv_fs_tell(lv_fs_file_t * file_p, uint32_t * pos)
     }
 
     lv_fs_res_t res;
-    if(file_p->drv->cache_size) {
+    if(file_p->cache) {
         *pos = file_p->cache->file_position;
         res = LV_FS_RES_OK;
     }
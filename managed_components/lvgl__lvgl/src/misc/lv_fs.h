@@ -69,6 +69,7 @@ typedef enum {
 typedef struct _lv_fs_drv_t {
     char letter;
     uint16_t cache_size;
+    bool block_cache;   /**< Read the files through the block cache shared by the files of the same path*/
     bool (*ready_cb)(struct _lv_fs_drv_t * drv);
 
     void * (*open_cb)(struct _lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode);
@@ -87,11 +88,18 @@ typedef struct _lv_fs_drv_t {
 #endif
 } lv_fs_drv_t;
 
+struct _lv_fs_cache_node_t;
+
 typedef struct {
     uint32_t start;
     uint32_t end;
     uint32_t file_position;
     void * buffer;
+    struct _lv_fs_cache_node_t * node;  /**< The cached blocks of the path. NULL if the file is not block cached*/
+    uint32_t drv_position;              /**< Position of the driver in the block cached file*/
+    uint32_t next_block;                /**< The block a sequential read continues with*/
+    uint8_t seq_cnt;                    /**< Number of sequential reads since the last jump*/
+    uint8_t writer : 1;                 /**< Opened for writing*/
 } lv_fs_file_cache_t;
 
 typedef struct {
@@ -0,0 +1,651 @@
+/**
+ * @file lv_fs_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs_cache.h"
+#include "lv_assert.h"
+#include "lv_gc.h"
+#include "lv_lru.h"
+#include "lv_mem.h"
+#include "lv_log.h"
+#include "lv_printf.h"
+#include <string.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Blocks read with one driver call at most when a file is read sequentially*/
+#define READ_AHEAD_MAX  8
+
+#define ITEM_SIZE       (sizeof(cache_item_t) + LV_FS_CACHE_BLOCK_SIZE)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+/*The files opened with the same path share the cached blocks*/
+struct _lv_fs_cache_node_t {
+    char * path;            /*Path of the file with the driver letter*/
+    uint16_t open_cnt;      /*Number of opened files with this path*/
+    uint16_t writer_cnt;    /*Number of them opened for writing*/
+    uint32_t block_cnt;     /*Number of cached blocks of the path*/
+};
+
+typedef struct _lv_fs_cache_node_t cache_node_t;
+
+typedef struct {
+    cache_node_t * node;
+    uint32_t idx;
+} cache_key_t;
+
+/*The data of the block follows the item*/
+typedef struct {
+    cache_key_t key;
+    void * ll_node;         /*Its node in `_lv_fs_cache_ll` to forget it without searching*/
+    uint32_t len;           /*Bytes in the block. Less than the block size only at the end of the file*/
+} cache_item_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+#if LV_FS_CACHE_DEF_BUDGET
+    static cache_item_t * block_get(cache_node_t * node, uint32_t idx);
+    static void block_add(cache_node_t * node, uint32_t idx, const uint8_t * data, uint32_t len);
+    static lv_fs_res_t drv_read_at(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br);
+    static lv_fs_res_t read_direct(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
+    static cache_node_t * node_get(const char * path);
+    static void node_invalidate(cache_node_t * node);
+    static void node_release(cache_node_t * node);
+    static void cache_create(uint32_t budget);
+    static void lru_value_free(void * v);
+    static void item_free(cache_item_t * item);
+    static void key_init(cache_key_t * key, cache_node_t * node, uint32_t idx);
+#endif
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_fs_cache_stats_t stats;
+#if LV_FS_CACHE_DEF_BUDGET
+    static lv_fs_cache_alloc_cb_t mem_alloc_cb;
+    static lv_fs_cache_free_cb_t mem_free_cb;
+    static uint32_t read_max;
+    static bool invalidating;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+/**
+ * Initialize the block cache with `LV_FS_CACHE_DEF_BUDGET`
+ */
+void _lv_fs_cache_init(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+#if LV_FS_CACHE_DEF_BUDGET
+    _lv_ll_init(&LV_GC_ROOT(_lv_fs_cache_ll), sizeof(cache_item_t *));
+    _lv_ll_init(&LV_GC_ROOT(_lv_fs_cache_node_ll), sizeof(cache_node_t));
+    LV_GC_ROOT(_lv_fs_cache_lru) = NULL;
+    mem_alloc_cb = NULL;
+    mem_free_cb = NULL;
+    cache_create(LV_FS_CACHE_DEF_BUDGET);
+#endif
+}
+
+/**
+ * Use the block cache for a file just opened by a driver with `block_cache` enabled.
+ * @param file_p    pointer to the opened file
+ * @param path      the path of the file with the driver letter
+ * @param mode      the mode the file was opened with
+ * @return          true: the file uses the block cache; false: the cache is disabled or there is no memory
+ */
+bool _lv_fs_cache_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mode)
+{
+#if LV_FS_CACHE_DEF_BUDGET
+    if(LV_GC_ROOT(_lv_fs_cache_lru) == NULL) return false;
+
+    /*The driver is moved to the blocks to read*/
+    if(file_p->drv->seek_cb == NULL) return false;
+
+    cache_node_t * node = node_get(path);
+    if(node == NULL) return false;
+
+    file_p->cache = lv_mem_alloc(sizeof(lv_fs_file_cache_t));
+    LV_ASSERT_MALLOC(file_p->cache);
+    if(file_p->cache == NULL) {
+        node_release(node);
+        return false;
+    }
+    lv_memset_00(file_p->cache, sizeof(lv_fs_file_cache_t));
+    file_p->cache->start = UINT32_MAX;  /*The window of `cache_size` is not used*/
+    file_p->cache->end = UINT32_MAX - 1;
+    file_p->cache->node = node;
+
+    node->open_cnt++;
+    if(mode & LV_FS_MODE_WR) {
+        /*The files of the path are read from the driver until it's closed*/
+        file_p->cache->writer = 1;
+        node->writer_cnt++;
+        node_invalidate(node);
+    }
+
+    return true;
+#else
+    LV_UNUSED(file_p);
+    LV_UNUSED(path);
+    LV_UNUSED(mode);
+    return false;
+#endif
+}
+
+/**
+ * Detach a block cached file from the cache before it's closed.
+ * @param file_p    pointer to a block cached file
+ */
+void _lv_fs_cache_close(lv_fs_file_t * file_p)
+{
+#if LV_FS_CACHE_DEF_BUDGET
+    cache_node_t * node = file_p->cache->node;
+    if(file_p->cache->writer) {
+        node->writer_cnt--;
+        node_invalidate(node);
+    }
+
+    node->open_cnt--;
+    node_release(node);
+    file_p->cache->node = NULL;
+#else
+    LV_UNUSED(file_p);
+#endif
+}
+
+/**
+ * Read from a block cached file.
+ * @param file_p    pointer to a block cached file
+ * @param buf       pointer to a buffer where the read bytes are stored
+ * @param btr       Bytes To Read
+ * @param br        store the number of read bytes here
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+#if LV_FS_CACHE_DEF_BUDGET
+    lv_fs_file_cache_t * fc = file_p->cache;
+    cache_node_t * node = fc->node;
+    stats.reads++;
+    *br = 0;
+
+    /*The blocks can't be trusted while the file is written*/
+    if(LV_GC_ROOT(_lv_fs_cache_lru) == NULL || node->writer_cnt) {
+        return read_direct(file_p, buf, btr, br);
+    }
+
+    uint8_t * dst = buf;
+    while(btr) {
+        uint32_t idx = fc->file_position / LV_FS_CACHE_BLOCK_SIZE;
+        uint32_t ofs = fc->file_position % LV_FS_CACHE_BLOCK_SIZE;
+
+        cache_item_t * item = block_get(node, idx);
+        if(item) {
+            stats.hits++;
+            if(ofs >= item->len) break;    /*End of the file*/
+
+            uint32_t n = LV_MIN(item->len - ofs, btr);
+            lv_memcpy(dst, (uint8_t *)&item[1] + ofs, n);
+            dst += n;
+            btr -= n;
+            fc->file_position += n;
+            fc->next_block = idx + 1;
+
+            /*Only the last block of the file is shorter*/
+            if(item->len < LV_FS_CACHE_BLOCK_SIZE) break;
+            continue;
+        }
+
+        /*A miss at the block where the previous read stopped means the file is read sequentially*/
+        if(idx == fc->next_block) {
+            if(fc->seq_cnt < 8) fc->seq_cnt++;
+        }
+        else {
+            fc->seq_cnt = 0;
+        }
+
+        /*Not cached whole blocks of a request larger than the read ahead are read into the buffer directly*/
+        if(ofs == 0 && btr > read_max * LV_FS_CACHE_BLOCK_SIZE) {
+            uint32_t full = btr / LV_FS_CACHE_BLOCK_SIZE;
+            uint32_t cnt = 1;
+            while(cnt < full && block_get(node, idx + cnt) == NULL) cnt++;
+            if(cnt > read_max) {
+                uint32_t rn = 0;
+                lv_fs_res_t res = drv_read_at(file_p, fc->file_position, dst, cnt * LV_FS_CACHE_BLOCK_SIZE, &rn);
+                if(res != LV_FS_RES_OK) {
+                    *br = dst - (uint8_t *)buf;
+                    return res;
+                }
+                stats.misses += cnt;
+                dst += rn;
+                btr -= rn;
+                fc->file_position += rn;
+                fc->next_block = idx + cnt;
+                if(rn < cnt * LV_FS_CACHE_BLOCK_SIZE) break;
+                continue;
+            }
+        }
+
+        /*Read the blocks of the request and when reading sequentially some more ahead with one driver call.
+         *The read ahead grows with the number of sequential reads.*/
+        uint32_t req_cnt = (ofs + btr + LV_FS_CACHE_BLOCK_SIZE - 1) / LV_FS_CACHE_BLOCK_SIZE;
+        uint32_t cnt = req_cnt;
+        if(fc->seq_cnt) cnt = LV_MAX(cnt, (uint32_t)1 << fc->seq_cnt);
+        cnt = LV_MIN(cnt, read_max);
+
+        /*Don't read again what is cached already*/
+        uint32_t i = 1;
+        while(i < cnt && block_get(node, idx + i) == NULL) i++;
+        cnt = i;
+
+        uint32_t rn = 0;
+        uint8_t * tmp = lv_mem_buf_get(cnt * LV_FS_CACHE_BLOCK_SIZE);
+        LV_ASSERT_MALLOC(tmp);
+        if(tmp == NULL) {
+            lv_fs_res_t res = read_direct(file_p, dst, btr, &rn);
+            *br = dst - (uint8_t *)buf + rn;
+            return res;
+        }
+
+        lv_fs_res_t res = drv_read_at(file_p, idx * LV_FS_CACHE_BLOCK_SIZE, tmp, cnt * LV_FS_CACHE_BLOCK_SIZE, &rn);
+        if(res != LV_FS_RES_OK) {
+            lv_mem_buf_release(tmp);
+            *br = dst - (uint8_t *)buf;
+            return res;
+        }
+
+        uint32_t read_cnt = (rn + LV_FS_CACHE_BLOCK_SIZE - 1) / LV_FS_CACHE_BLOCK_SIZE;
+        stats.misses += LV_MIN(read_cnt, req_cnt);
+        if(read_cnt > req_cnt) stats.read_ahead += read_cnt - req_cnt;
+
+        for(i = 0; i * LV_FS_CACHE_BLOCK_SIZE < rn; i++) {
+            block_add(node, idx + i, tmp + i * LV_FS_CACHE_BLOCK_SIZE, LV_MIN(LV_FS_CACHE_BLOCK_SIZE,
+                                                                              rn - i * LV_FS_CACHE_BLOCK_SIZE));
+        }
+
+        uint32_t n = rn > ofs ? LV_MIN(rn - ofs, btr) : 0;
+        lv_memcpy(dst, tmp + ofs, n);
+        lv_mem_buf_release(tmp);
+        dst += n;
+        btr -= n;
+        fc->file_position += n;
+        fc->next_block = (fc->file_position + LV_FS_CACHE_BLOCK_SIZE - 1) / LV_FS_CACHE_BLOCK_SIZE;
+
+        /*End of the file*/
+        if(rn < cnt * LV_FS_CACHE_BLOCK_SIZE) break;
+    }
+
+    *br = dst - (uint8_t *)buf;
+    return LV_FS_RES_OK;
+#else
+    LV_UNUSED(file_p);
+    LV_UNUSED(buf);
+    LV_UNUSED(btr);
+    *br = 0;
+    return LV_FS_RES_NOT_IMP;
+#endif
+}
+
+/**
+ * Write into a block cached file. The cached blocks of its path are removed.
+ * @param file_p    pointer to a block cached file
+ * @param buf       pointer to the data to write
+ * @param btw       Bytes To Write
+ * @param bw        store the number of written bytes here
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+#if LV_FS_CACHE_DEF_BUDGET
+    lv_fs_file_cache_t * fc = file_p->cache;
+    *bw = 0;
+
+    if(fc->drv_position != fc->file_position) {
+        stats.drv_seeks++;
+        lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, fc->file_position, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) return res;
+        fc->drv_position = fc->file_position;
+    }
+
+    lv_fs_res_t res = file_p->drv->write_cb(file_p->drv, file_p->file_d, buf, btw, bw);
+    if(res == LV_FS_RES_OK) {
+        fc->file_position += *bw;
+        fc->drv_position = fc->file_position;
+    }
+
+    node_invalidate(fc->node);
+    return res;
+#else
+    LV_UNUSED(file_p);
+    LV_UNUSED(buf);
+    LV_UNUSED(btw);
+    *bw = 0;
+    return LV_FS_RES_NOT_IMP;
+#endif
+}
+
+/**
+ * Set the position in a block cached file. The driver seeks only when it reads the next time.
+ * @param file_p    pointer to a block cached file
+ * @param pos       the new position
+ * @param whence    tells from where to interpret the `pos`. See @lv_fs_whence_t
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+#if LV_FS_CACHE_DEF_BUDGET
+    lv_fs_file_cache_t * fc = file_p->cache;
+    stats.seeks++;
+
+    switch(whence) {
+        case LV_FS_SEEK_SET:
+            fc->file_position = pos;
+            break;
+        case LV_FS_SEEK_CUR:
+            fc->file_position += pos;
+            break;
+        case LV_FS_SEEK_END: {
+                /*The size of the file is known only by the driver*/
+                stats.drv_seeks++;
+                lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, whence);
+                if(res != LV_FS_RES_OK) return res;
+
+                uint32_t tmp_position;
+                res = file_p->drv->tell_cb(file_p->drv, file_p->file_d, &tmp_position);
+                if(res != LV_FS_RES_OK) return res;
+
+                fc->file_position = tmp_position;
+                fc->drv_position = tmp_position;
+                break;
+            }
+    }
+
+    return LV_FS_RES_OK;
+#else
+    LV_UNUSED(file_p);
+    LV_UNUSED(pos);
+    LV_UNUSED(whence);
+    return LV_FS_RES_NOT_IMP;
+#endif
+}
+
+/**
+ * Set the memory the cached blocks can use.
+ * The least recently used blocks are removed to stay within the budget.
+ * The files opened while the budget is 0 don't use the block cache.
+ * @param budget    size in bytes. 0: disable the cache
+ */
+void lv_fs_cache_set_budget(uint32_t budget)
+{
+#if LV_FS_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(budget);
+    LV_LOG_WARN("Can't change the FS cache budget because it's disabled by LV_FS_CACHE_DEF_BUDGET = 0");
+#else
+    cache_create(budget);
+#endif
+}
+
+/**
+ * Set where the cached blocks are stored. E.g. in external RAM.
+ * The cached blocks are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_fs_cache_set_mem_cb(lv_fs_cache_alloc_cb_t alloc_cb, lv_fs_cache_free_cb_t free_cb)
+{
+#if LV_FS_CACHE_DEF_BUDGET == 0
+    LV_UNUSED(alloc_cb);
+    LV_UNUSED(free_cb);
+    LV_LOG_WARN("Can't set the FS cache memory because it's disabled by LV_FS_CACHE_DEF_BUDGET = 0");
+#else
+    /*The cached blocks need to be freed with the callback they were allocated with*/
+    lv_fs_cache_invalidate(NULL);
+
+    mem_alloc_cb = free_cb ? alloc_cb : NULL;
+    mem_free_cb = free_cb;
+#endif
+}
+
+/**
+ * Remove the cached blocks of a file. Needs to be called if the file was changed without `lv_fs`.
+ * @param path      path of the file with the driver letter (e.g. "S:folder/file.png") or NULL to remove every block
+ */
+void lv_fs_cache_invalidate(const char * path)
+{
+    LV_UNUSED(path);
+#if LV_FS_CACHE_DEF_BUDGET
+    /*Removing the last block of a closed file frees its node*/
+    cache_node_t * node = _lv_ll_get_head(&LV_GC_ROOT(_lv_fs_cache_node_ll));
+    while(node) {
+        cache_node_t * next = _lv_ll_get_next(&LV_GC_ROOT(_lv_fs_cache_node_ll), node);
+        if(path == NULL || strcmp(node->path, path) == 0) node_invalidate(node);
+        node = next;
+    }
+#endif
+}
+
+/**
+ * Get the statistics of the block cache.
+ * @param stats_out     store the statistics here
+ */
+void lv_fs_cache_get_stats(lv_fs_cache_stats_t * stats_out)
+{
+    *stats_out = stats;
+#if LV_FS_CACHE_DEF_BUDGET
+    lv_lru_t * lru = LV_GC_ROOT(_lv_fs_cache_lru);
+    if(lru) stats_out->size = (uint32_t)(lru->total_memory - lru->free_memory);
+#endif
+}
+
+/**
+ * Clear the counters of the block cache.
+ */
+void lv_fs_cache_reset_stats(void)
+{
+    uint32_t block_cnt = stats.block_cnt;
+    lv_memset_00(&stats, sizeof(stats));
+    stats.block_cnt = block_cnt;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+#if LV_FS_CACHE_DEF_BUDGET
+
+static cache_item_t * block_get(cache_node_t * node, uint32_t idx)
+{
+    cache_key_t key;
+    key_init(&key, node, idx);
+    void * value = NULL;
+    lv_lru_get(LV_GC_ROOT(_lv_fs_cache_lru), &key, sizeof(key), &value);
+    return value;
+}
+
+/*Copy a block read from the driver into the cache*/
+static void block_add(cache_node_t * node, uint32_t idx, const uint8_t * data, uint32_t len)
+{
+    uint32_t size = sizeof(cache_item_t) + len;
+    cache_item_t * item = mem_alloc_cb ? mem_alloc_cb(size) : lv_mem_alloc(size);
+    if(item == NULL) {
+        LV_LOG_WARN("FS cache: couldn't allocate %" LV_PRIu32 " bytes", size);
+        return;
+    }
+
+    cache_item_t ** item_p = _lv_ll_ins_head(&LV_GC_ROOT(_lv_fs_cache_ll));
+    LV_ASSERT_MALLOC(item_p);
+    if(item_p == NULL) {
+        item_free(item);
+        return;
+    }
+    *item_p = item;
+
+    key_init(&item->key, node, idx);
+    item->ll_node = item_p;
+    item->len = len;
+    lv_memcpy(&item[1], data, len);
+
+    node->block_cnt++;
+    stats.block_cnt++;
+    lv_lru_set(LV_GC_ROOT(_lv_fs_cache_lru), &item->key, sizeof(cache_key_t), item, size);
+}
+
+/*Read with the driver from a position, seek only if the driver is not there*/
+static lv_fs_res_t drv_read_at(lv_fs_file_t * file_p, uint32_t pos, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_file_cache_t * fc = file_p->cache;
+    *br = 0;
+
+    if(fc->drv_position != pos) {
+        stats.drv_seeks++;
+        lv_fs_res_t res = file_p->drv->seek_cb(file_p->drv, file_p->file_d, pos, LV_FS_SEEK_SET);
+        if(res != LV_FS_RES_OK) return res;
+        fc->drv_position = pos;
+    }
+
+    stats.drv_reads++;
+    lv_fs_res_t res = file_p->drv->read_cb(file_p->drv, file_p->file_d, buf, btr, br);
+    if(res == LV_FS_RES_OK) fc->drv_position += *br;
+    else fc->drv_position = UINT32_MAX;     /*Unknown, seek before the next read*/
+
+    return res;
+}
+
+/*Read without the cached blocks*/
+static lv_fs_res_t read_direct(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    lv_fs_res_t res = drv_read_at(file_p, file_p->cache->file_position, buf, btr, br);
+    if(res == LV_FS_RES_OK) file_p->cache->file_position += *br;
+    return res;
+}
+
+/*Find the node of a path or create a new one*/
+static cache_node_t * node_get(const char * path)
+{
+    cache_node_t * node;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_fs_cache_node_ll), node) {
+        if(strcmp(node->path, path) == 0) return node;
+    }
+
+    node = _lv_ll_ins_head(&LV_GC_ROOT(_lv_fs_cache_node_ll));
+    LV_ASSERT_MALLOC(node);
+    if(node == NULL) return NULL;
+
+    lv_memset_00(node, sizeof(cache_node_t));
+    size_t len = strlen(path) + 1;
+    node->path = lv_mem_alloc(len);
+    LV_ASSERT_MALLOC(node->path);
+    if(node->path == NULL) {
+        _lv_ll_remove(&LV_GC_ROOT(_lv_fs_cache_node_ll), node);
+        lv_mem_free(node);
+        return NULL;
+    }
+    lv_memcpy(node->path, path, len);
+
+    return node;
+}
+
+/*Remove the cached blocks of a node*/
+static void node_invalidate(cache_node_t * node)
+{
+    if(node->block_cnt == 0) return;
+
+    invalidating = true;
+    cache_item_t ** item_p = _lv_ll_get_head(&LV_GC_ROOT(_lv_fs_cache_ll));
+    while(item_p && node->block_cnt) {
+        cache_item_t ** next = _lv_ll_get_next(&LV_GC_ROOT(_lv_fs_cache_ll), item_p);
+        cache_item_t * item = *item_p;
+        if(item->key.node == node) {
+            lv_lru_remove(LV_GC_ROOT(_lv_fs_cache_lru), &item->key, sizeof(cache_key_t));
+        }
+        item_p = next;
+    }
+    invalidating = false;
+
+    node_release(node);
+}
+
+/*Free a node if no file is opened with it and it has no blocks*/
+static void node_release(cache_node_t * node)
+{
+    if(node->open_cnt || node->block_cnt) return;
+
+    lv_mem_free(node->path);
+    _lv_ll_remove(&LV_GC_ROOT(_lv_fs_cache_node_ll), node);
+    lv_mem_free(node);
+}
+
+/*Drop the cached blocks and create a new LRU with the given budget*/
+static void cache_create(uint32_t budget)
+{
+    if(LV_GC_ROOT(_lv_fs_cache_lru)) {
+        lv_fs_cache_invalidate(NULL);
+        lv_lru_del(LV_GC_ROOT(_lv_fs_cache_lru));
+        LV_GC_ROOT(_lv_fs_cache_lru) = NULL;
+    }
+
+    if(budget == 0) return;
+
+    /*A few blocks are needed to read ahead without evicting the blocks of the same read*/
+    if(budget < 4 * ITEM_SIZE) {
+        LV_LOG_WARN("FS cache: the budget should be at least %d bytes, the cache is disabled", (int)(4 * ITEM_SIZE));
+        return;
+    }
+
+    read_max = LV_MIN(READ_AHEAD_MAX, budget / ITEM_SIZE / 4);
+
+    LV_GC_ROOT(_lv_fs_cache_lru) = lv_lru_create(budget, ITEM_SIZE, lru_value_free, NULL);
+    LV_ASSERT_MALLOC(LV_GC_ROOT(_lv_fs_cache_lru));
+}
+
+/*Called by the LRU when a block is evicted or removed*/
+static void lru_value_free(void * v)
+{
+    cache_item_t * item = v;
+
+    if(!invalidating) {
+        stats.evictions++;
+        LV_LOG_TRACE("FS cache: remove the least recently used block");
+    }
+
+    _lv_ll_remove(&LV_GC_ROOT(_lv_fs_cache_ll), item->ll_node);
+    lv_mem_free(item->ll_node);
+    stats.block_cnt--;
+
+    /*The node of a closed file is freed with its last block*/
+    cache_node_t * node = item->key.node;
+    node->block_cnt--;
+    if(!invalidating) node_release(node);
+
+    item_free(item);
+}
+
+static void item_free(cache_item_t * item)
+{
+    if(mem_alloc_cb) mem_free_cb(item);
+    else lv_mem_free(item);
+}
+
+/*The key is hashed byte by byte, so clear the padding too*/
+static void key_init(cache_key_t * key, cache_node_t * node, uint32_t idx)
+{
+    lv_memset_00(key, sizeof(cache_key_t));
+    key->node = node;
+    key->idx = idx;
+}
+
+#endif /*LV_FS_CACHE_DEF_BUDGET*/
@@ -0,0 +1,138 @@
+/**
+ * @file lv_fs_cache.h
+ *
+ */
+
+#ifndef LV_FS_CACHE_H
+#define LV_FS_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_fs.h"
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** Statistics of the block cache of the files*/
+typedef struct {
+    uint32_t reads;         /**< Number of `lv_fs_read` calls on the block cached files*/
+    uint32_t seeks;         /**< Number of `lv_fs_seek` calls on the block cached files*/
+    uint32_t hits;          /**< Number of blocks found in the cache*/
+    uint32_t misses;        /**< Number of requested blocks read from the drivers*/
+    uint32_t read_ahead;    /**< Number of blocks read from the drivers ahead of the requests*/
+    uint32_t evictions;     /**< Number of blocks removed to make space for new ones*/
+    uint32_t drv_reads;     /**< Number of reads issued to the drivers*/
+    uint32_t drv_seeks;     /**< Number of seeks issued to the drivers*/
+    uint32_t size;          /**< Bytes used by the cached blocks*/
+    uint32_t block_cnt;     /**< Number of cached blocks*/
+} lv_fs_cache_stats_t;
+
+typedef void * (*lv_fs_cache_alloc_cb_t)(size_t size);
+typedef void (*lv_fs_cache_free_cb_t)(void * p);
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Initialize the block cache with `LV_FS_CACHE_DEF_BUDGET`
+ */
+void _lv_fs_cache_init(void);
+
+/**
+ * Use the block cache for a file just opened by a driver with `block_cache` enabled.
+ * @param file_p    pointer to the opened file
+ * @param path      the path of the file with the driver letter
+ * @param mode      the mode the file was opened with
+ * @return          true: the file uses the block cache; false: the cache is disabled or there is no memory
+ */
+bool _lv_fs_cache_open(lv_fs_file_t * file_p, const char * path, lv_fs_mode_t mode);
+
+/**
+ * Detach a block cached file from the cache before it's closed.
+ * @param file_p    pointer to a block cached file
+ */
+void _lv_fs_cache_close(lv_fs_file_t * file_p);
+
+/**
+ * Read from a block cached file.
+ * @param file_p    pointer to a block cached file
+ * @param buf       pointer to a buffer where the read bytes are stored
+ * @param btr       Bytes To Read
+ * @param br        store the number of read bytes here
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_read(lv_fs_file_t * file_p, void * buf, uint32_t btr, uint32_t * br);
+
+/**
+ * Write into a block cached file. The cached blocks of its path are removed.
+ * @param file_p    pointer to a block cached file
+ * @param buf       pointer to the data to write
+ * @param btw       Bytes To Write
+ * @param bw        store the number of written bytes here
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_write(lv_fs_file_t * file_p, const void * buf, uint32_t btw, uint32_t * bw);
+
+/**
+ * Set the position in a block cached file. The driver seeks only when it reads the next time.
+ * @param file_p    pointer to a block cached file
+ * @param pos       the new position
+ * @param whence    tells from where to interpret the `pos`. See @lv_fs_whence_t
+ * @return          LV_FS_RES_OK or an error from the driver
+ */
+lv_fs_res_t _lv_fs_cache_seek(lv_fs_file_t * file_p, uint32_t pos, lv_fs_whence_t whence);
+
+/**
+ * Set the memory the cached blocks can use.
+ * The least recently used blocks are removed to stay within the budget.
+ * The files opened while the budget is 0 don't use the block cache.
+ * @param budget    size in bytes. 0: disable the cache
+ */
+void lv_fs_cache_set_budget(uint32_t budget);
+
+/**
+ * Set where the cached blocks are stored. E.g. in external RAM.
+ * The cached blocks are removed.
+ * @param alloc_cb  function to allocate memory or NULL to use `lv_mem_alloc`
+ * @param free_cb   function to free the memory allocated by `alloc_cb`
+ */
+void lv_fs_cache_set_mem_cb(lv_fs_cache_alloc_cb_t alloc_cb, lv_fs_cache_free_cb_t free_cb);
+
+/**
+ * Remove the cached blocks of a file. Needs to be called if the file was changed without `lv_fs`.
+ * @param path      path of the file with the driver letter (e.g. "S:folder/file.png") or NULL to remove every block
+ */
+void lv_fs_cache_invalidate(const char * path);
+
+/**
+ * Get the statistics of the block cache.
+ * @param stats     store the statistics here
+ */
+void lv_fs_cache_get_stats(lv_fs_cache_stats_t * stats);
+
+/**
+ * Clear the counters of the block cache.
+ */
+void lv_fs_cache_reset_stats(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_FS_CACHE_H*/
@@ -18,7 +18,9 @@ extern "C" {
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_timer.h"
+#include "lv_anim.h"
 #include "lv_types.h"
+#include "lv_lru.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
 #include "../core/lv_obj_pos.h"
@@ -32,6 +34,24 @@ extern "C" {
 #    define LV_IMG_CACHE_DEF            0
 #endif
 
+#if LV_IMG_ASYNC_QUEUE_LEN
+#    define LV_IMG_ASYNC_DEF            1
+#else
+#    define LV_IMG_ASYNC_DEF            0
+#endif
+
+#if LV_GLYPH_CACHE_DEF_BUDGET
+#    define LV_GLYPH_CACHE_DEF          1
+#else
+#    define LV_GLYPH_CACHE_DEF          0
+#endif
+
+#if LV_FS_CACHE_DEF_BUDGET
+#    define LV_FS_CACHE_DEF             1
+#else
+#    define LV_FS_CACHE_DEF             0
+#endif
+
 #define LV_DISPATCH(f, t, n)            f(t, n)
 #define LV_DISPATCH_COND(f, t, n, m, v) LV_CONCAT3(LV_DISPATCH, m, v)(f, t, n)
 
@@ -42,16 +62,20 @@ extern "C" {
 
 #define LV_ITERATE_ROOTS(f)                                                                            \
     LV_DISPATCH(f, lv_ll_t, _lv_timer_ll) /*Linked list to store the lv_timers*/                       \
+    LV_DISPATCH(f, lv_timer_t **, _lv_timer_heap) /*The scheduled timers ordered by their deadlines*/  \
     LV_DISPATCH(f, lv_ll_t, _lv_disp_ll)  /*Linked list of display device*/                            \
     LV_DISPATCH(f, lv_ll_t, _lv_indev_ll) /*Linked list of input device*/                              \
     LV_DISPATCH(f, lv_ll_t, _lv_fsdrv_ll)                                                              \
-    LV_DISPATCH(f, lv_ll_t, _lv_anim_ll)                                                               \
+    LV_DISPATCH(f, lv_anim_pool_t, _lv_anim_pool)                                                     \
     LV_DISPATCH(f, lv_ll_t, _lv_group_ll)                                                              \
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH_COND(f, lv_lru_t*, _lv_img_cache_lru, LV_IMG_CACHE_DEF, 1)                             \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_img_cache_ll, LV_IMG_CACHE_DEF, 1)                                \
+    LV_DISPATCH(f, _lv_img_cache_entry_t, _lv_img_cache_single)                                        \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_img_async_ll, LV_IMG_ASYNC_DEF, 1)                                \
+    LV_DISPATCH_COND(f, lv_timer_t*, _lv_img_async_timer, LV_IMG_ASYNC_DEF, 1)                         \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
     LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
     LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
@@ -59,6 +83,12 @@ extern "C" {
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
     LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
+    LV_DISPATCH_COND(f, lv_lru_t*, _lv_glyph_cache_lru, LV_GLYPH_CACHE_DEF, 1)                         \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_glyph_cache_ll, LV_GLYPH_CACHE_DEF, 1)                            \
+    LV_DISPATCH_COND(f, lv_lru_t*, _lv_fs_cache_lru, LV_FS_CACHE_DEF, 1)                               \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_fs_cache_ll, LV_FS_CACHE_DEF, 1)                                  \
+    LV_DISPATCH_COND(f, lv_ll_t, _lv_fs_cache_node_ll, LV_FS_CACHE_DEF, 1)                             \
+    LV_DISPATCH(f, lv_ll_t, _lv_font_fmt_txt_index_ll)                                                 \
     LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)                                                     \
     LV_DISPATCH(f, uint8_t * , _lv_style_custom_prop_flag_lookup_table)
 
@@ -139,6 +139,7 @@ uint32_t _lv_style_custom_prop_flag_lookup_table_size = 0;
 
 static uint16_t last_custom_prop_id = (uint16_t)_LV_STYLE_LAST_BUILT_IN_PROP;
 static const lv_style_value_t null_style_value = { .num = 0 };
+static uint32_t change_cnt;
 
 /**********************
  *      MACROS
@@ -171,6 +172,8 @@ void lv_style_reset(lv_style_t * style)
         return;
     }
 
+    change_cnt++;
+
     if(style->prop_cnt > 1) lv_mem_free(style->v_p.values_and_props);
     lv_memset_00(style, sizeof(lv_style_t));
 #if LV_USE_ASSERT_STYLE
@@ -230,6 +233,8 @@ bool lv_style_remove_prop(lv_style_t * style, lv_style_prop_t prop)
 
     if(style->prop_cnt == 0)  return false;
 
+    change_cnt++;
+
     if(style->prop_cnt == 1) {
         if(LV_STYLE_PROP_ID_MASK(style->prop1) == prop) {
             style->prop1 = LV_STYLE_PROP_INV;
@@ -371,6 +376,11 @@ bool lv_style_is_empty(const lv_style_t * style)
     return style->prop_cnt == 0 ? true : false;
 }
 
+uint32_t _lv_style_get_change_cnt(void)
+{
+    return change_cnt;
+}
+
 uint8_t _lv_style_get_prop_group(lv_style_prop_t prop)
 {
     uint16_t group = (prop & 0x1FF) >> 4;
@@ -422,6 +432,8 @@ static void lv_style_set_prop_internal(lv_style_t * style, lv_style_prop_t prop_
         return;
     }
 
+    change_cnt++;
+
     lv_style_prop_t prop_id = LV_STYLE_PROP_ID_MASK(prop_and_meta);
 
     if(style->prop_cnt > 1) {
@@ -11,12 +11,14 @@
 #include "lv_mem.h"
 #include "lv_ll.h"
 #include "lv_gc.h"
+#include "../core/lv_cmd_queue.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define IDLE_MEAS_PERIOD 500 /*[ms]*/
 #define DEF_PERIOD 500
+#define HEAP_MIN_SIZE 16
 
 /**********************
  *      TYPEDEFS
@@ -25,16 +27,29 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
-static bool lv_timer_exec(lv_timer_t * timer);
-static uint32_t lv_timer_time_remaining(lv_timer_t * timer);
+static void lv_timer_exec(lv_timer_t * timer);
+static void timer_schedule(lv_timer_t * timer, uint32_t deadline);
+static bool heap_resize(uint32_t size);
+static void heap_insert(lv_timer_t * timer);
+static void heap_remove(lv_timer_t * timer);
+static void heap_update(lv_timer_t * timer);
+static void heap_up(uint32_t i);
+static void heap_down(uint32_t i);
+static inline bool heap_less(const lv_timer_t * a, const lv_timer_t * b);
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 static bool lv_timer_run = false;
 static uint8_t idle_last = 0;
-static bool timer_deleted;
-static bool timer_created;
+static uint32_t timer_cnt;
+static uint32_t heap_cnt;
+static uint32_t heap_size;
+static uint32_t timer_id;
+static uint32_t handler_start;
+/*ID of the current (or next) call of `lv_timer_handler`. Incremented when a call finishes
+ *so that only the timers which ran in the ongoing call have this ID.*/
+static uint32_t run_id;
 
 /**********************
  *      MACROS
@@ -55,6 +70,11 @@ static bool timer_created;
 void _lv_timer_core_init(void)
 {
     _lv_ll_init(&LV_GC_ROOT(_lv_timer_ll), sizeof(lv_timer_t));
+    LV_GC_ROOT(_lv_timer_heap) = NULL;
+    timer_cnt = 0;
+    heap_cnt = 0;
+    heap_size = 0;
+    heap_resize(HEAP_MIN_SIZE);
 
     /*Initially enable the lv_timer handling*/
     lv_timer_enable(true);
@@ -84,7 +104,10 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
     static uint32_t idle_period_start = 0;
     static uint32_t busy_time         = 0;
 
-    uint32_t handler_start = lv_tick_get();
+    handler_start = lv_tick_get();
+
+    /*Apply the changes posted by other threads before the timers see the objects*/
+    _lv_cmd_queue_drain();
 
     if(handler_start == 0) {
         static uint32_t run_cnt = 0;
@@ -95,39 +118,22 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         }
     }
 
-    /*Run all timer from the list*/
-    lv_timer_t * next;
-    do {
-        timer_deleted             = false;
-        timer_created             = false;
-        LV_GC_ROOT(_lv_timer_act) = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-        while(LV_GC_ROOT(_lv_timer_act)) {
-            /*The timer might be deleted if it runs only once ('repeat_count = 1')
-             *So get next element until the current is surely valid*/
-            next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), LV_GC_ROOT(_lv_timer_act));
-
-            if(lv_timer_exec(LV_GC_ROOT(_lv_timer_act))) {
-                /*If a timer was created or deleted then this or the next item might be corrupted*/
-                if(timer_created || timer_deleted) {
-                    TIMER_TRACE("Start from the first timer again because a timer was created or deleted");
-                    break;
-                }
-            }
-
-            LV_GC_ROOT(_lv_timer_act) = next; /*Load the next timer*/
-        }
-    } while(LV_GC_ROOT(_lv_timer_act));
+    /*Run the ready timers in the order of their deadlines. A timer which ran is rescheduled
+     *after `handler_start` so it can't run again in this call even if its period is 0.
+     *The timers created, deleted or made ready in the callbacks are handled in the heap the same way.*/
+    while(heap_cnt) {
+        lv_timer_t * timer = LV_GC_ROOT(_lv_timer_heap)[0];
+        if((int32_t)(timer->deadline - handler_start) > 0) break;
 
-    uint32_t time_till_next = LV_NO_TIMER_READY;
-    next = _lv_ll_get_head(&LV_GC_ROOT(_lv_timer_ll));
-    while(next) {
-        if(!next->paused) {
-            uint32_t delay = lv_timer_time_remaining(next);
-            if(delay < time_till_next)
-                time_till_next = delay;
-        }
+        LV_GC_ROOT(_lv_timer_act) = timer;
+        lv_timer_exec(timer);
+    }
+    LV_GC_ROOT(_lv_timer_act) = NULL;
 
-        next = _lv_ll_get_next(&LV_GC_ROOT(_lv_timer_ll), next); /*Find the next timer*/
+    uint32_t time_till_next = LV_NO_TIMER_READY;
+    if(heap_cnt) {
+        int32_t delay = (int32_t)(LV_GC_ROOT(_lv_timer_heap)[0]->deadline - lv_tick_get());
+        time_till_next = delay > 0 ? (uint32_t)delay : 0;
     }
 
     busy_time += lv_tick_elaps(handler_start);
@@ -139,6 +145,7 @@ uint32_t LV_ATTRIBUTE_TIMER_HANDLER lv_timer_handler(void)
         idle_period_start = lv_tick_get();
     }
 
+    run_id++;
     already_running = false; /*Release the mutex*/
 
     TIMER_TRACE("finished (%d ms until the next timer call)", time_till_next);
@@ -168,6 +175,11 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
 {
     lv_timer_t * new_timer = NULL;
 
+    if(timer_cnt == heap_size && !heap_resize(heap_size * 2)) {
+        LV_LOG_WARN("couldn't allocate memory for the timer heap");
+        return NULL;
+    }
+
     new_timer = _lv_ll_ins_head(&LV_GC_ROOT(_lv_timer_ll));
     LV_ASSERT_MALLOC(new_timer);
     if(new_timer == NULL) return NULL;
@@ -178,8 +190,12 @@ lv_timer_t * lv_timer_create(lv_timer_cb_t timer_xcb, uint32_t period, void * us
     new_timer->paused = 0;
     new_timer->last_run = lv_tick_get();
     new_timer->user_data = user_data;
+    new_timer->heap_idx = LV_TIMER_NOT_SCHEDULED;
+    new_timer->id = timer_id++;
+    new_timer->run_id = run_id - 1;
+    timer_cnt++;
 
-    timer_created = true;
+    timer_schedule(new_timer, new_timer->last_run + period);
 
     return new_timer;
 }
@@ -200,10 +216,16 @@ void lv_timer_set_cb(lv_timer_t * timer, lv_timer_cb_t timer_cb)
  */
 void lv_timer_del(lv_timer_t * timer)
 {
+    if(timer->heap_idx != LV_TIMER_NOT_SCHEDULED) heap_remove(timer);
     _lv_ll_remove(&LV_GC_ROOT(_lv_timer_ll), timer);
-    timer_deleted = true;
+
+    /*Let `lv_timer_handler` know that the running timer was deleted in its callback*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) LV_GC_ROOT(_lv_timer_act) = NULL;
 
     lv_mem_free(timer);
+    timer_cnt--;
+
+    if(heap_size > HEAP_MIN_SIZE && timer_cnt < heap_size / 4) heap_resize(heap_size / 2);
 }
 
 /**
@@ -213,11 +235,14 @@ void lv_timer_del(lv_timer_t * timer)
 void lv_timer_pause(lv_timer_t * timer)
 {
     timer->paused = true;
+    if(timer->heap_idx != LV_TIMER_NOT_SCHEDULED) heap_remove(timer);
 }
 
 void lv_timer_resume(lv_timer_t * timer)
 {
+    if(!timer->paused) return;
     timer->paused = false;
+    timer_schedule(timer, timer->last_run + timer->period);
 }
 
 /**
@@ -228,6 +253,7 @@ void lv_timer_resume(lv_timer_t * timer)
 void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 {
     timer->period = period;
+    timer_schedule(timer, timer->last_run + period);
 }
 
 /**
@@ -237,6 +263,7 @@ void lv_timer_set_period(lv_timer_t * timer, uint32_t period)
 void lv_timer_ready(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get() - timer->period - 1;
+    timer_schedule(timer, timer->last_run + timer->period);
 }
 
 /**
@@ -247,6 +274,9 @@ void lv_timer_ready(lv_timer_t * timer)
 void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 {
     timer->repeat_count = repeat_count;
+
+    /*The timer is deleted without calling it when it's handled next*/
+    if(repeat_count == 0) timer_schedule(timer, lv_tick_get());
 }
 
 /**
@@ -257,6 +287,7 @@ void lv_timer_set_repeat_count(lv_timer_t * timer, int32_t repeat_count)
 void lv_timer_reset(lv_timer_t * timer)
 {
     timer->last_run = lv_tick_get();
+    timer_schedule(timer, timer->last_run + timer->period);
 }
 
 /**
@@ -293,49 +324,134 @@ lv_timer_t * lv_timer_get_next(lv_timer_t * timer)
  **********************/
 
 /**
- * Execute timer if its remaining time is zero
+ * Execute a ready timer and schedule its next run
  * @param timer pointer to lv_timer
- * @return true: execute, false: not executed
  */
-static bool lv_timer_exec(lv_timer_t * timer)
+static void lv_timer_exec(lv_timer_t * timer)
 {
-    if(timer->paused) return false;
-
-    bool exec = false;
-    if(lv_timer_time_remaining(timer) == 0) {
-        /* Decrement the repeat count before executing the timer_cb.
-         * If any timer is deleted `if(timer->repeat_count == 0)` is not executed below
-         * but at least the repeat count is zero and the timer can be deleted in the next round*/
-        int32_t original_repeat_count = timer->repeat_count;
-        if(timer->repeat_count > 0) timer->repeat_count--;
-        timer->last_run = lv_tick_get();
-        TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
-        if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
-        TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
-        LV_ASSERT_MEM_INTEGRITY();
-        exec = true;
-    }
+    /* Decrement the repeat count before executing the timer_cb.
+     * If the timer is deleted in the callback `if(timer->repeat_count == 0)` is not executed below*/
+    int32_t original_repeat_count = timer->repeat_count;
+    if(timer->repeat_count > 0) timer->repeat_count--;
+    timer->last_run = lv_tick_get();
+    timer->run_id = run_id;
+    timer_schedule(timer, timer->last_run + timer->period);
+
+    TIMER_TRACE("calling timer callback: %p", *((void **)&timer->timer_cb));
+    if(timer->timer_cb && original_repeat_count != 0) timer->timer_cb(timer);
+    TIMER_TRACE("timer callback %p finished", *((void **)&timer->timer_cb));
+    LV_ASSERT_MEM_INTEGRITY();
 
-    if(timer_deleted == false) { /*The timer might be deleted by itself as well*/
+    if(LV_GC_ROOT(_lv_timer_act) == timer) { /*The timer might be deleted by itself as well*/
         if(timer->repeat_count == 0) { /*The repeat count is over, delete the timer*/
             TIMER_TRACE("deleting timer with %p callback because the repeat count is over", *((void **)&timer->timer_cb));
             lv_timer_del(timer);
         }
     }
+}
 
-    return exec;
+/**
+ * Set the next deadline of a timer and update its place in the heap.
+ * A timer which already ran in the ongoing `lv_timer_handler` call is postponed to the next call.
+ * @param timer     pointer to lv_timer
+ * @param deadline  when the timer should run
+ */
+static void timer_schedule(lv_timer_t * timer, uint32_t deadline)
+{
+    if(timer->run_id == run_id && (int32_t)(deadline - handler_start) <= 0) deadline = handler_start + 1;
+    timer->deadline = deadline;
+
+    if(timer->paused) return;
+    if(timer->heap_idx == LV_TIMER_NOT_SCHEDULED) heap_insert(timer);
+    else heap_update(timer);
 }
 
 /**
- * Find out how much time remains before a timer must be run.
- * @param timer pointer to lv_timer
- * @return the time remaining, or 0 if it needs to be run again
+ * Reallocate the heap. It has space for all timers, including the paused ones, so scheduling a timer can't fail.
+ * @param size      the new number of slots
+ * @return          true: success; false: out of memory, the heap is unchanged
+ */
+static bool heap_resize(uint32_t size)
+{
+    if(size < HEAP_MIN_SIZE) size = HEAP_MIN_SIZE;
+    lv_timer_t ** heap = lv_mem_realloc(LV_GC_ROOT(_lv_timer_heap), size * sizeof(lv_timer_t *));
+    if(heap == NULL) return false;
+
+    LV_GC_ROOT(_lv_timer_heap) = heap;
+    heap_size = size;
+    return true;
+}
+
+static void heap_insert(lv_timer_t * timer)
+{
+    LV_ASSERT(heap_cnt < heap_size);
+    LV_GC_ROOT(_lv_timer_heap)[heap_cnt] = timer;
+    timer->heap_idx = heap_cnt;
+    heap_cnt++;
+    heap_up(timer->heap_idx);
+}
+
+static void heap_remove(lv_timer_t * timer)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    uint32_t i = timer->heap_idx;
+    timer->heap_idx = LV_TIMER_NOT_SCHEDULED;
+    heap_cnt--;
+    if(i == heap_cnt) return;
+
+    /*Move the last timer into the hole and restore the heap from there*/
+    heap[i] = heap[heap_cnt];
+    heap[i]->heap_idx = i;
+    heap_update(heap[i]);
+}
+
+static void heap_update(lv_timer_t * timer)
+{
+    uint32_t i = timer->heap_idx;
+    if(i > 0 && heap_less(timer, LV_GC_ROOT(_lv_timer_heap)[(i - 1) / 2])) heap_up(i);
+    else heap_down(i);
+}
+
+static void heap_up(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    while(i > 0) {
+        uint32_t parent = (i - 1) / 2;
+        if(!heap_less(timer, heap[parent])) break;
+        heap[i] = heap[parent];
+        heap[i]->heap_idx = i;
+        i = parent;
+    }
+    heap[i] = timer;
+    timer->heap_idx = i;
+}
+
+static void heap_down(uint32_t i)
+{
+    lv_timer_t ** heap = LV_GC_ROOT(_lv_timer_heap);
+    lv_timer_t * timer = heap[i];
+    while(true) {
+        uint32_t child = 2 * i + 1;
+        if(child >= heap_cnt) break;
+        if(child + 1 < heap_cnt && heap_less(heap[child + 1], heap[child])) child++;
+        if(!heap_less(heap[child], timer)) break;
+        heap[i] = heap[child];
+        heap[i]->heap_idx = i;
+        i = child;
+    }
+    heap[i] = timer;
+    timer->heap_idx = i;
+}
+
+/**
+ * Compare the deadlines of two timers, the deadlines can wrap around.
+ * The newer timer runs first if the deadlines are the same like when the timers were in a list.
+ * @return true: `a` should run before `b`
  */
-static uint32_t lv_timer_time_remaining(lv_timer_t * timer)
+static inline bool heap_less(const lv_timer_t * a, const lv_timer_t * b)
 {
-    /*Check if at least 'period' time elapsed*/
-    uint32_t elp = lv_tick_elaps(timer->last_run);
-    if(elp >= timer->period)
-        return 0;
-    return timer->period - elp;
+    int32_t diff = (int32_t)(a->deadline - b->deadline);
+    if(diff != 0) return diff < 0;
+    return (int32_t)(a->id - b->id) > 0;
 }
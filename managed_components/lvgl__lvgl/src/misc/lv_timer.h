@@ -26,6 +26,7 @@ extern "C" {
 #endif
 
 #define LV_NO_TIMER_READY 0xFFFFFFFF
+#define LV_TIMER_NOT_SCHEDULED 0xFFFFFFFF
 
 /**********************
  *      TYPEDEFS
@@ -48,6 +49,12 @@ typedef struct _lv_timer_t {
     void * user_data; /**< Custom user data*/
     int32_t repeat_count; /**< 1: One time;  -1 : infinity;  n>0: residual times*/
     uint32_t paused : 1;
+
+    /*Used by the scheduler. Change the timers only with the `lv_timer_...` functions to keep them up to date.*/
+    uint32_t deadline; /**< When the timer should run next*/
+    uint32_t heap_idx; /**< Index in the heap of the scheduled timers, `LV_TIMER_NOT_SCHEDULED` if paused*/
+    uint32_t id; /**< Creation order, the newer timers run first if their deadlines are the same*/
+    uint32_t run_id; /**< The call of `lv_timer_handler` which ran the timer last*/
 } lv_timer_t;
 
 /**********************
@@ -63,6 +70,7 @@ void _lv_timer_core_init(void);
 
 /**
  * Call it periodically to handle lv_timers.
+ * The ready timers run in the order of their deadlines, each of them at most once per call.
  * @return time till it needs to be run next (in ms)
  */
 uint32_t /* LV_ATTRIBUTE_TIMER_HANDLER */ lv_timer_handler(void);
@@ -99,7 +107,7 @@ lv_timer_t * lv_timer_create_basic(void);
  * @param timer_xcb a callback to call periodically.
  *                 (the 'x' in the argument name indicates that it's not a fully generic function because it not follows
  *                  the `func_name(object, callback, ...)` convention)
- * @param period call period in ms unit
+ * @param period call period in ms unit (less than 2^31)
  * @param user_data custom parameter
  * @return pointer to the new timer
  */
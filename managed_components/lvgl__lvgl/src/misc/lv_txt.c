@@ -204,7 +204,7 @@ static uint32_t lv_txt_get_next_word(const char * txt, const lv_font_t * font,
             }
         }
 
-        letter_w = lv_font_get_glyph_width(font, letter, letter_next);
+        letter_w = _lv_txt_get_letter_width(font, letter, letter_next, flag);
         cur_w += letter_w;
 
         if(letter_w > 0) {
@@ -329,7 +329,7 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
     if(i == 0) {
         uint32_t letter = _lv_txt_encoded_next(txt, &i);
         if(used_width != NULL) {
-            line_w = lv_font_get_glyph_width(font, letter, '\0');
+            line_w = _lv_txt_get_letter_width(font, letter, '\0', flag);
         }
     }
 
@@ -363,7 +363,7 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
                 }
             }
 
-            lv_coord_t char_width = lv_font_get_glyph_width(font, letter, letter_next);
+            lv_coord_t char_width = _lv_txt_get_letter_width(font, letter, letter_next, flag);
             if(char_width > 0) {
                 width += char_width;
                 width += letter_space;
@@ -379,6 +379,26 @@ lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t *
     return width;
 }
 
+uint16_t _lv_txt_get_letter_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next, lv_text_flag_t flag)
+{
+    if(flag & LV_TEXT_FLAG_FIXED_DIGITS) {
+        if(letter >= '0' && letter <= '9') {
+            uint16_t max_w = 0;
+            uint32_t d;
+            for(d = '0'; d <= '9'; d++) {
+                uint16_t w = lv_font_get_glyph_width(font, d, '\0');
+                if(w > max_w) max_w = w;
+            }
+            return max_w;
+        }
+
+        /*Kerning would move the next digit out of its cell*/
+        if(letter_next >= '0' && letter_next <= '9') letter_next = '\0';
+    }
+
+    return lv_font_get_glyph_width(font, letter, letter_next);
+}
+
 bool _lv_txt_is_cmd(lv_text_cmd_state_t * state, uint32_t c)
 {
     bool ret = false;
@@ -44,6 +44,7 @@ enum {
     LV_TEXT_FLAG_RECOLOR = 0x01, /**< Enable parsing of recolor command*/
     LV_TEXT_FLAG_EXPAND  = 0x02, /**< Ignore max-width to avoid automatic word wrapping*/
     LV_TEXT_FLAG_FIT     = 0x04, /**< Max-width is already equal to the longest line. (Used to skip some calculation)*/
+    LV_TEXT_FLAG_FIXED_DIGITS = 0x08, /**< All digits are as wide as the widest one, e.g. for clocks and counters*/
 };
 typedef uint8_t lv_text_flag_t;
 
@@ -112,6 +113,17 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coor
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag);
 
+/**
+ * Get the advance of a letter like `lv_font_get_glyph_width` but taking the text flags into account.
+ * With `LV_TEXT_FLAG_FIXED_DIGITS` the digits get the advance of the widest digit and no kerning.
+ * @param font pointer to a font
+ * @param letter a UNICODE letter
+ * @param letter_next the next letter after `letter`. Used for kerning
+ * @param flag settings for the text from ::lv_text_flag_t
+ * @return the advance of the letter
+ */
+uint16_t _lv_txt_get_letter_width(const lv_font_t * font, uint32_t letter, uint32_t letter_next, lv_text_flag_t flag);
+
 /**
  * Check next character in a string and decide if the character is part of the command or not
  * @param state pointer to a txt_cmd_state_t variable which stores the current state of command
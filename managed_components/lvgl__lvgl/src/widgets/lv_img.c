@@ -33,6 +33,10 @@ static void lv_img_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_img_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_img_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_img(lv_event_t * e);
+static lv_point_t lv_img_get_transformed_size(lv_obj_t * obj);
+static bool async_pending(lv_obj_t * obj);
+static void get_draw_areas(lv_obj_t * obj, lv_area_t * bg_coords, lv_area_t * img_max_area,
+                           lv_area_t * img_clip_area);
 
 /**********************
  *  STATIC VARIABLES
@@ -76,6 +80,9 @@ void lv_img_set_src(lv_obj_t * obj, const void * src)
     lv_img_src_t src_type = lv_img_src_get_type(src);
     lv_img_t * img = (lv_img_t *)obj;
 
+    /*The new image is requested when it's drawn*/
+    if(img->async) _lv_img_async_cancel(obj);
+
 #if LV_USE_LOG && LV_LOG_LEVEL >= LV_LOG_LEVEL_INFO
     switch(src_type) {
         case LV_IMG_SRC_FILE:
@@ -304,6 +311,38 @@ void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode)
     lv_obj_invalidate(obj);
 }
 
+void lv_img_set_async(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    if(en == img->async) return;
+
+    if(!en) _lv_img_async_cancel(obj);
+    img->async = en;
+    lv_obj_invalidate(obj);
+}
+
+void lv_img_set_placeholder(lv_obj_t * obj, const void * src)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+
+    const void * old_src = img->placeholder;
+    if(src && lv_img_src_get_type(src) == LV_IMG_SRC_FILE) {
+        char * new_str = lv_mem_alloc(strlen(src) + 1);
+        LV_ASSERT_MALLOC(new_str);
+        if(new_str == NULL) return;
+        strcpy(new_str, src);
+        img->placeholder = new_str;
+    }
+    else {
+        img->placeholder = src;
+    }
+
+    if(old_src && lv_img_src_get_type(old_src) == LV_IMG_SRC_FILE) lv_mem_free((void *)old_src);
+    lv_obj_invalidate(obj);
+}
+
 /*=====================
  * Getter functions
  *====================*/
@@ -378,6 +417,73 @@ lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj)
     return img->obj_size_mode;
 }
 
+bool lv_img_get_async(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    return img->async ? true : false;
+}
+
+const void * lv_img_get_placeholder(lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+    return img->placeholder;
+}
+
+/*=====================
+ * Other functions
+ *====================*/
+
+void lv_img_invalidate_src_area(lv_obj_t * obj, const lv_area_t * area)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+    lv_img_t * img = (lv_img_t *)obj;
+
+    if(img->src_type != LV_IMG_SRC_FILE && img->src_type != LV_IMG_SRC_VARIABLE) {
+        lv_obj_invalidate(obj);
+        return;
+    }
+
+    if(img->h == 0 || img->w == 0) return;
+    if(img->zoom == 0) return;
+
+    lv_area_t bg_coords;
+    lv_area_t img_max_area;
+    lv_area_t img_clip_area;
+    get_draw_areas(obj, &bg_coords, &img_max_area, &img_clip_area);
+
+    /*Transform the area around the pivot of the image*/
+    lv_point_t pivot;
+    pivot.x = img->pivot.x - area->x1;
+    pivot.y = img->pivot.y - area->y1;
+    lv_area_t area_tr;
+    _lv_img_buf_get_transformed_area(&area_tr, lv_area_get_width(area), lv_area_get_height(area),
+                                     img->angle, img->zoom, &pivot);
+    lv_area_move(&area_tr, area->x1, area->y1);
+
+    /*Invalidate the area in every tile drawn by `draw_img`*/
+    lv_point_t img_size_final = lv_img_get_transformed_size(obj);
+    lv_area_t coords_tmp;
+    lv_coord_t offset_x = img->offset.x % img->w;
+    lv_coord_t offset_y = img->offset.y % img->h;
+    coords_tmp.y1 = img_max_area.y1 + offset_y;
+    if(coords_tmp.y1 > img_max_area.y1) coords_tmp.y1 -= img->h;
+
+    for(; coords_tmp.y1 < img_max_area.y2; coords_tmp.y1 += img_size_final.y) {
+        coords_tmp.x1 = img_max_area.x1 + offset_x;
+        if(coords_tmp.x1 > img_max_area.x1) coords_tmp.x1 -= img->w;
+
+        for(; coords_tmp.x1 < img_max_area.x2; coords_tmp.x1 += img_size_final.x) {
+            lv_area_t inv_area = area_tr;
+            lv_area_move(&inv_area, coords_tmp.x1, coords_tmp.y1);
+            if(_lv_area_intersect(&inv_area, &inv_area, &img_clip_area)) {
+                lv_obj_invalidate_area(obj, &inv_area);
+            }
+        }
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -402,6 +508,8 @@ static void lv_img_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     img->pivot.x = 0;
     img->pivot.y = 0;
     img->obj_size_mode = LV_IMG_SIZE_MODE_VIRTUAL;
+    img->async = 0;
+    img->placeholder = NULL;
 
     lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_flag(obj, LV_OBJ_FLAG_ADV_HITTEST);
@@ -413,11 +521,16 @@ static void lv_img_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 {
     LV_UNUSED(class_p);
     lv_img_t * img = (lv_img_t *)obj;
+    if(img->async) _lv_img_async_cancel(obj);
     if(img->src_type == LV_IMG_SRC_FILE || img->src_type == LV_IMG_SRC_SYMBOL) {
         lv_mem_free((void *)img->src);
         img->src      = NULL;
         img->src_type = LV_IMG_SRC_UNKNOWN;
     }
+    if(img->placeholder && lv_img_src_get_type(img->placeholder) == LV_IMG_SRC_FILE) {
+        lv_mem_free((void *)img->placeholder);
+        img->placeholder = NULL;
+    }
 }
 
 static lv_point_t lv_img_get_transformed_size(lv_obj_t * obj)
@@ -528,6 +641,12 @@ static void draw_img(lv_event_t * e)
             return;
         }
 
+        /*The placeholder might not cover the image's area*/
+        if(async_pending(obj)) {
+            info->res = LV_COVER_RES_NOT_COVER;
+            return;
+        }
+
         /*Non true color format might have "holes"*/
         if(img->cf != LV_IMG_CF_TRUE_COLOR && img->cf != LV_IMG_CF_RAW) {
             info->res = LV_COVER_RES_NOT_COVER;
@@ -545,7 +664,21 @@ static void draw_img(lv_event_t * e)
             return;
         }
 
-        const lv_area_t * clip_area = lv_event_get_param(e);
+        const lv_area_t * clip_area = info->area;
+
+        /*A true color image covers its content area even on a transparent background.
+         *The tiles of the image fill the whole content area.*/
+        if(img->cf == LV_IMG_CF_TRUE_COLOR && img->zoom == LV_IMG_ZOOM_NONE && img->w && img->h &&
+           lv_obj_get_style_opa(obj, LV_PART_MAIN) >= LV_OPA_MAX &&
+           lv_obj_get_style_blend_mode(obj, LV_PART_MAIN) == LV_BLEND_MODE_NORMAL) {
+            lv_area_t content_coords;
+            lv_obj_get_content_coords(obj, &content_coords);
+            if(_lv_area_is_in(clip_area, &content_coords, 0)) {
+                info->res = LV_COVER_RES_COVER;
+                return;
+            }
+        }
+
         if(img->zoom == LV_IMG_ZOOM_NONE) {
             if(_lv_area_is_in(clip_area, &obj->coords, 0) == false) {
                 info->res = LV_COVER_RES_NOT_COVER;
@@ -568,34 +701,10 @@ static void draw_img(lv_event_t * e)
     }
     else if(code == LV_EVENT_DRAW_MAIN || code == LV_EVENT_DRAW_POST) {
 
-        lv_coord_t obj_w = lv_obj_get_width(obj);
-        lv_coord_t obj_h = lv_obj_get_height(obj);
-
-        lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
-        lv_coord_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
-        lv_coord_t pright = lv_obj_get_style_pad_right(obj, LV_PART_MAIN) + border_width;
-        lv_coord_t ptop = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width;
-        lv_coord_t pbottom = lv_obj_get_style_pad_bottom(obj, LV_PART_MAIN) + border_width;
-
-        lv_point_t bg_pivot;
-        bg_pivot.x = img->pivot.x + pleft;
-        bg_pivot.y = img->pivot.y + ptop;
         lv_area_t bg_coords;
-
-        if(img->obj_size_mode == LV_IMG_SIZE_MODE_REAL) {
-            /*Object size equals to transformed image size*/
-            lv_obj_get_coords(obj, &bg_coords);
-        }
-        else {
-            _lv_img_buf_get_transformed_area(&bg_coords, obj_w, obj_h,
-                                             img->angle, img->zoom, &bg_pivot);
-
-            /*Modify the coordinates to draw the background for the rotated and scaled coordinates*/
-            bg_coords.x1 += obj->coords.x1;
-            bg_coords.y1 += obj->coords.y1;
-            bg_coords.x2 += obj->coords.x1;
-            bg_coords.y2 += obj->coords.y1;
-        }
+        lv_area_t img_max_area;
+        lv_area_t img_clip_area;
+        get_draw_areas(obj, &bg_coords, &img_max_area, &img_clip_area);
 
         lv_area_t ori_coords;
         lv_area_copy(&ori_coords, &obj->coords);
@@ -612,27 +721,8 @@ static void draw_img(lv_event_t * e)
 
             lv_draw_ctx_t * draw_ctx = lv_event_get_draw_ctx(e);
 
-            lv_area_t img_max_area;
-            lv_area_copy(&img_max_area, &obj->coords);
-
             lv_point_t img_size_final = lv_img_get_transformed_size(obj);
 
-            if(img->obj_size_mode == LV_IMG_SIZE_MODE_REAL) {
-                img_max_area.x1 -= ((img->w - img_size_final.x) + 1) / 2;
-                img_max_area.x2 -= ((img->w - img_size_final.x) + 1) / 2;
-                img_max_area.y1 -= ((img->h - img_size_final.y) + 1) / 2;
-                img_max_area.y2 -= ((img->h - img_size_final.y) + 1) / 2;
-            }
-            else {
-                img_max_area.x2 = img_max_area.x1 + lv_area_get_width(&bg_coords) - 1;
-                img_max_area.y2 = img_max_area.y1 + lv_area_get_height(&bg_coords) - 1;
-            }
-
-            img_max_area.x1 += pleft;
-            img_max_area.y1 += ptop;
-            img_max_area.x2 -= pright;
-            img_max_area.y2 -= pbottom;
-
             if(img->src_type == LV_IMG_SRC_FILE || img->src_type == LV_IMG_SRC_VARIABLE) {
                 lv_draw_img_dsc_t img_dsc;
                 lv_draw_img_dsc_init(&img_dsc);
@@ -644,14 +734,30 @@ static void draw_img(lv_event_t * e)
                 img_dsc.pivot.y = img->pivot.y;
                 img_dsc.antialias = img->antialias;
 
-                lv_area_t img_clip_area;
-                img_clip_area.x1 = bg_coords.x1 + pleft;
-                img_clip_area.y1 = bg_coords.y1 + ptop;
-                img_clip_area.x2 = bg_coords.x2 - pright;
-                img_clip_area.y2 = bg_coords.y2 - pbottom;
                 const lv_area_t * clip_area_ori = draw_ctx->clip_area;
 
                 if(!_lv_area_intersect(&img_clip_area, draw_ctx->clip_area, &img_clip_area)) return;
+
+                /*Draw the placeholder zoomed to the width of the image while the image is decoded*/
+                const void * src = img->src;
+                lv_coord_t src_w = img->w;
+                lv_coord_t src_h = img->h;
+                if(async_pending(obj)) {
+                    lv_img_header_t header;
+                    if(img->placeholder == NULL || lv_img_decoder_get_info(img->placeholder, &header) != LV_RES_OK ||
+                       header.w == 0 || header.h == 0) return;
+
+                    src = img->placeholder;
+                    src_w = header.w;
+                    src_h = header.h;
+                    img_dsc.zoom = (uint16_t)LV_MIN((uint32_t)img->zoom * img->w / header.w, UINT16_MAX);
+
+                    /*Without transformation zoom from the corner to cover the image exactly*/
+                    bool transformed = img->angle || img->zoom != LV_IMG_ZOOM_NONE;
+                    img_dsc.pivot.x = transformed ? (lv_coord_t)((int32_t)img->pivot.x * header.w / img->w) : 0;
+                    img_dsc.pivot.y = transformed ? (lv_coord_t)((int32_t)img->pivot.y * header.w / img->w) : 0;
+                }
+
                 draw_ctx->clip_area = &img_clip_area;
 
                 lv_area_t coords_tmp;
@@ -659,15 +765,15 @@ static void draw_img(lv_event_t * e)
                 lv_coord_t offset_y = img->offset.y % img->h;
                 coords_tmp.y1 = img_max_area.y1 + offset_y;
                 if(coords_tmp.y1 > img_max_area.y1) coords_tmp.y1 -= img->h;
-                coords_tmp.y2 = coords_tmp.y1 + img->h - 1;
+                coords_tmp.y2 = coords_tmp.y1 + src_h - 1;
 
                 for(; coords_tmp.y1 < img_max_area.y2; coords_tmp.y1 += img_size_final.y, coords_tmp.y2 += img_size_final.y) {
                     coords_tmp.x1 = img_max_area.x1 + offset_x;
                     if(coords_tmp.x1 > img_max_area.x1) coords_tmp.x1 -= img->w;
-                    coords_tmp.x2 = coords_tmp.x1 + img->w - 1;
+                    coords_tmp.x2 = coords_tmp.x1 + src_w - 1;
 
                     for(; coords_tmp.x1 < img_max_area.x2; coords_tmp.x1 += img_size_final.x, coords_tmp.x2 += img_size_final.x) {
-                        lv_draw_img(draw_ctx, &img_dsc, &coords_tmp, img->src);
+                        lv_draw_img(draw_ctx, &img_dsc, &coords_tmp, src);
                     }
                 }
                 draw_ctx->clip_area = clip_area_ori;
@@ -688,4 +794,89 @@ static void draw_img(lv_event_t * e)
     }
 }
 
+/**
+ * Request the image to be decoded in the background if it's not in the image cache yet
+ * @param obj       pointer to an image object
+ * @return          true: the image is being decoded, draw the placeholder
+ */
+static bool async_pending(lv_obj_t * obj)
+{
+    lv_img_t * img = (lv_img_t *)obj;
+    if(!img->async) return false;
+    if(img->src_type != LV_IMG_SRC_FILE && img->src_type != LV_IMG_SRC_VARIABLE) return false;
+
+    /*The image is cached with the recolor it's drawn with*/
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    if(lv_obj_get_style_img_recolor_opa(obj, LV_PART_MAIN) > 0) {
+        img_dsc.recolor = lv_obj_get_style_img_recolor_filtered(obj, LV_PART_MAIN);
+    }
+
+    return _lv_img_async_request(img->src, img_dsc.recolor, obj) == LV_RES_OK;
+}
+
+/**
+ * Get the areas used to draw an image
+ * @param obj               pointer to an image object
+ * @param bg_coords         store the area of the (transformed) background here
+ * @param img_max_area      store the area where the first tile of the image is drawn here
+ * @param img_clip_area     store the area the image is clipped to here
+ */
+static void get_draw_areas(lv_obj_t * obj, lv_area_t * bg_coords, lv_area_t * img_max_area,
+                           lv_area_t * img_clip_area)
+{
+    lv_img_t * img = (lv_img_t *)obj;
+
+    lv_coord_t obj_w = lv_obj_get_width(obj);
+    lv_coord_t obj_h = lv_obj_get_height(obj);
+
+    lv_coord_t border_width = lv_obj_get_style_border_width(obj, LV_PART_MAIN);
+    lv_coord_t pleft = lv_obj_get_style_pad_left(obj, LV_PART_MAIN) + border_width;
+    lv_coord_t pright = lv_obj_get_style_pad_right(obj, LV_PART_MAIN) + border_width;
+    lv_coord_t ptop = lv_obj_get_style_pad_top(obj, LV_PART_MAIN) + border_width;
+    lv_coord_t pbottom = lv_obj_get_style_pad_bottom(obj, LV_PART_MAIN) + border_width;
+
+    if(img->obj_size_mode == LV_IMG_SIZE_MODE_REAL) {
+        /*Object size equals to transformed image size*/
+        lv_obj_get_coords(obj, bg_coords);
+    }
+    else {
+        lv_point_t bg_pivot;
+        bg_pivot.x = img->pivot.x + pleft;
+        bg_pivot.y = img->pivot.y + ptop;
+        _lv_img_buf_get_transformed_area(bg_coords, obj_w, obj_h,
+                                         img->angle, img->zoom, &bg_pivot);
+
+        /*Modify the coordinates to draw the background for the rotated and scaled coordinates*/
+        bg_coords->x1 += obj->coords.x1;
+        bg_coords->y1 += obj->coords.y1;
+        bg_coords->x2 += obj->coords.x1;
+        bg_coords->y2 += obj->coords.y1;
+    }
+
+    lv_area_copy(img_max_area, &obj->coords);
+
+    if(img->obj_size_mode == LV_IMG_SIZE_MODE_REAL) {
+        lv_point_t img_size_final = lv_img_get_transformed_size(obj);
+        img_max_area->x1 -= ((img->w - img_size_final.x) + 1) / 2;
+        img_max_area->x2 -= ((img->w - img_size_final.x) + 1) / 2;
+        img_max_area->y1 -= ((img->h - img_size_final.y) + 1) / 2;
+        img_max_area->y2 -= ((img->h - img_size_final.y) + 1) / 2;
+    }
+    else {
+        img_max_area->x2 = img_max_area->x1 + lv_area_get_width(bg_coords) - 1;
+        img_max_area->y2 = img_max_area->y1 + lv_area_get_height(bg_coords) - 1;
+    }
+
+    img_max_area->x1 += pleft;
+    img_max_area->y1 += ptop;
+    img_max_area->x2 -= pright;
+    img_max_area->y2 -= pbottom;
+
+    img_clip_area->x1 = bg_coords->x1 + pleft;
+    img_clip_area->y1 = bg_coords->y1 + ptop;
+    img_clip_area->x2 = bg_coords->x2 - pright;
+    img_clip_area->y2 = bg_coords->y2 - pbottom;
+}
+
 #endif
@@ -50,6 +50,8 @@ typedef struct {
     uint8_t cf : 5;        /*Color format from `lv_img_color_format_t`*/
     uint8_t antialias : 1; /*Apply anti-aliasing in transformations (rotate, zoom)*/
     uint8_t obj_size_mode: 2; /*Image size mode when image size and object size is different.*/
+    uint8_t async : 1;     /*Decode the image in the background and draw the placeholder meanwhile*/
+    const void * placeholder; /*Image drawn while the image is decoded in the background*/
 } lv_img_t;
 
 extern const lv_obj_class_t lv_img_class;
@@ -156,6 +158,22 @@ void lv_img_set_antialias(lv_obj_t * obj, bool antialias);
  * @param mode      the new size mode.
  */
 void lv_img_set_size_mode(lv_obj_t * obj, lv_img_size_mode_t mode);
+
+/**
+ * Decode the image in the background when it's not in the image cache.
+ * The placeholder is drawn until the image is decoded. Requires `LV_IMG_ASYNC_QUEUE_LEN > 0`.
+ * @param obj       pointer to an image object
+ * @param en        true: decode in the background; false: decode when the image is drawn
+ */
+void lv_img_set_async(lv_obj_t * obj, bool en);
+
+/**
+ * Set an image to draw while the image is decoded in the background, e.g. a small preview of it.
+ * It's zoomed to the width of the image.
+ * @param obj       pointer to an image object
+ * @param src       pointer to an ::lv_img_dsc_t descriptor, path to an image file or NULL to draw nothing
+ */
+void lv_img_set_placeholder(lv_obj_t * obj, const void * src);
 /*=====================
  * Getter functions
  *====================*/
@@ -216,6 +234,32 @@ bool lv_img_get_antialias(lv_obj_t * obj);
  */
 lv_img_size_mode_t lv_img_get_size_mode(lv_obj_t * obj);
 
+/**
+ * Get whether the image is decoded in the background.
+ * @param obj       pointer to an image object
+ * @return          true: decoded in the background
+ */
+bool lv_img_get_async(lv_obj_t * obj);
+
+/**
+ * Get the image drawn while the image is decoded in the background.
+ * @param obj       pointer to an image object
+ * @return          the placeholder image or NULL
+ */
+const void * lv_img_get_placeholder(lv_obj_t * obj);
+
+/*=====================
+ * Other functions
+ *====================*/
+
+/**
+ * Redraw only a part of the image. Useful if only some pixels of the image source were changed.
+ * The area is transformed, clipped and repeated the same way as the image is drawn.
+ * @param obj       pointer to an image object
+ * @param area      the changed area in the coordinates of the image source (0;0 is the top left pixel)
+ */
+void lv_img_invalidate_src_area(lv_obj_t * obj, const lv_area_t * area);
+
 /**********************
  *      MACROS
  **********************/
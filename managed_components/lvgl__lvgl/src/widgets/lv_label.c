@@ -41,6 +41,12 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 
 static void lv_label_refr_text(lv_obj_t * obj);
+static void lv_label_refr_text_core(lv_obj_t * obj);
+static void lv_label_text_replaced(lv_obj_t * obj, char * old_txt, bool old_static);
+static bool lv_label_invalidate_changed(lv_obj_t * obj, const char * old_txt, const char * new_txt);
+static lv_coord_t lv_label_measure_line(const char * txt, uint32_t start, uint32_t end, const lv_font_t * font,
+                                        lv_coord_t letter_space, lv_text_flag_t flag, lv_coord_t * ink_x1, lv_coord_t * ink_x2,
+                                        lv_coord_t * end_x);
 static void lv_label_revert_dots(lv_obj_t * label);
 
 static bool lv_label_set_dot_tmp(lv_obj_t * label, char * data, uint32_t len);
@@ -87,12 +93,12 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_label_t * label = (lv_label_t *)obj;
 
-    lv_obj_invalidate(obj);
-
     /*If text is NULL then just refresh with the current text*/
     if(text == NULL) text = label->text;
 
     if(label->text == text && label->static_txt == 0) {
+        lv_obj_invalidate(obj);
+
         /*If set its own text then reallocate it (maybe its size changed)*/
 #if LV_USE_ARABIC_PERSIAN_CHARS
         /*Get the size of the text and process it*/
@@ -111,11 +117,9 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         if(label->text == NULL) return;
     }
     else {
-        /*Free the old text*/
-        if(label->text != NULL && label->static_txt == 0) {
-            lv_mem_free(label->text);
-            label->text = NULL;
-        }
+        /*Keep the old text until the new one is ready to invalidate only the changed letters*/
+        char * old_txt = label->text;
+        bool old_static = label->static_txt;
 
 #if LV_USE_ARABIC_PERSIAN_CHARS
         /*Get the size of the text and process it*/
@@ -123,9 +127,7 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
 
         label->text = lv_mem_alloc(len);
         LV_ASSERT_MALLOC(label->text);
-        if(label->text == NULL) return;
-
-        _lv_txt_ap_proc(text, label->text);
+        if(label->text != NULL) _lv_txt_ap_proc(text, label->text);
 #else
         /*Get the size of the text*/
         size_t len = strlen(text) + 1;
@@ -133,15 +135,17 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
         /*Allocate space for the new text*/
         label->text = lv_mem_alloc(len);
         LV_ASSERT_MALLOC(label->text);
-        if(label->text == NULL) return;
-        strcpy(label->text, text);
+        if(label->text != NULL) strcpy(label->text, text);
 #endif
 
         /*Now the text is dynamically allocated*/
         label->static_txt = 0;
+
+        lv_label_text_replaced(obj, old_txt, old_static);
+        if(label->text == NULL) return;
     }
 
-    lv_label_refr_text(obj);
+    lv_label_refr_text_core(obj);
 }
 
 void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
@@ -149,7 +153,6 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     LV_ASSERT_NULL(fmt);
 
-    lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
 
     /*If text is NULL then refresh*/
@@ -158,10 +161,9 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
         return;
     }
 
-    if(label->text != NULL && label->static_txt == 0) {
-        lv_mem_free(label->text);
-        label->text = NULL;
-    }
+    /*Keep the old text until the new one is ready to invalidate only the changed letters*/
+    char * old_txt = label->text;
+    bool old_static = label->static_txt;
 
     va_list args;
     va_start(args, fmt);
@@ -169,7 +171,8 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     va_end(args);
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
-    lv_label_refr_text(obj);
+    lv_label_text_replaced(obj, old_txt, old_static);
+    lv_label_refr_text_core(obj);
 }
 
 void lv_label_set_text_static(lv_obj_t * obj, const char * text)
@@ -229,6 +232,17 @@ void lv_label_set_recolor(lv_obj_t * obj, bool en)
     lv_label_refr_text(obj);
 }
 
+void lv_label_set_fixed_width_digits(lv_obj_t * obj, bool en)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_label_t * label = (lv_label_t *)obj;
+    if(label->fixed_digits == en) return;
+
+    label->fixed_digits = en == false ? 0 : 1;
+    lv_label_refr_text(obj);
+}
+
 void lv_label_set_text_sel_start(lv_obj_t * obj, uint32_t index)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -283,6 +297,14 @@ bool lv_label_get_recolor(const lv_obj_t * obj)
     return label->recolor == 0 ? false : true;
 }
 
+bool lv_label_get_fixed_width_digits(const lv_obj_t * obj)
+{
+    LV_ASSERT_OBJ(obj, MY_CLASS);
+
+    lv_label_t * label = (lv_label_t *)obj;
+    return label->fixed_digits == 0 ? false : true;
+}
+
 void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t * pos)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
@@ -323,6 +345,7 @@ void lv_label_get_letter_pos(const lv_obj_t * obj, uint32_t char_id, lv_point_t
 
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     uint32_t byte_id = _lv_txt_encoded_get_byte_id(txt, char_id);
@@ -424,6 +447,7 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
 
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, label->text);
@@ -488,7 +512,7 @@ uint32_t lv_label_get_letter_on(const lv_obj_t * obj, lv_point_t * pos_in)
                 }
             }
 
-            lv_coord_t gw = lv_font_get_glyph_width(font, letter, letter_next);
+            lv_coord_t gw = _lv_txt_get_letter_width(font, letter, letter_next, flag);
 
             /*Finish if the x position or the last char of the next line is reached*/
             if(pos.x < x + gw || i + line_start == new_line_start ||  txt[i_act + line_start] == '\0') {
@@ -544,6 +568,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
 
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     /*Search the line of the index letter*/;
@@ -590,7 +615,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
                 }
             }
             last_x = x;
-            x += lv_font_get_glyph_width(font, letter, letter_next);
+            x += _lv_txt_get_letter_width(font, letter, letter_next, flag);
             if(pos->x < x) {
                 i = i_current;
                 break;
@@ -600,7 +625,7 @@ bool lv_label_is_char_under_pos(const lv_obj_t * obj, lv_point_t * pos)
         }
     }
 
-    int32_t max_diff = lv_font_get_glyph_width(font, letter, letter_next) + letter_space + 1;
+    int32_t max_diff = _lv_txt_get_letter_width(font, letter, letter_next, flag) + letter_space + 1;
     return (pos->x >= (last_x - letter_space) && pos->x <= (last_x + max_diff));
 }
 
@@ -695,6 +720,7 @@ static void lv_label_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
     label->text       = NULL;
     label->static_txt = 0;
     label->recolor    = 0;
+    label->fixed_digits = 0;
     label->dot_end    = LV_LABEL_DOT_END_INV;
     label->long_mode  = LV_LABEL_LONG_WRAP;
     label->offset.x = 0;
@@ -770,6 +796,7 @@ static void lv_label_event(const lv_obj_class_t * class_p, lv_event_t * e)
         lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
         if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
         if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+        if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
 
         lv_coord_t w = lv_obj_get_content_width(obj);
         if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) w = LV_COORD_MAX;
@@ -798,6 +825,7 @@ static void draw_main(lv_event_t * e)
     lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     lv_draw_label_dsc_t label_draw_dsc;
@@ -890,7 +918,21 @@ static void draw_main(lv_event_t * e)
  * Refresh the label with its text stored in its extended data
  * @param label pointer to a label object
  */
+/**
+ * Refresh the label with its text and invalidate it
+ * @param obj       pointer to a label object
+ */
 static void lv_label_refr_text(lv_obj_t * obj)
+{
+    lv_label_refr_text_core(obj);
+    lv_obj_invalidate(obj);
+}
+
+/**
+ * Refresh the size, the scroll animation and the dots of the label but don't invalidate it.
+ * @param obj       pointer to a label object
+ */
+static void lv_label_refr_text_core(lv_obj_t * obj)
 {
     lv_label_t * label = (lv_label_t *)obj;
     if(label->text == NULL) return;
@@ -910,6 +952,7 @@ static void lv_label_refr_text(lv_obj_t * obj)
     lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
     if(label->recolor != 0) flag |= LV_TEXT_FLAG_RECOLOR;
     if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
     if(lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) flag |= LV_TEXT_FLAG_FIT;
 
     lv_txt_get_size(&size, label->text, font, letter_space, line_space, max_w, flag);
@@ -1162,8 +1205,176 @@ static void lv_label_refr_text(lv_obj_t * obj)
     else if(label->long_mode == LV_LABEL_LONG_CLIP) {
         /*Do nothing*/
     }
+}
 
-    lv_obj_invalidate(obj);
+/**
+ * Invalidate the label after its text was replaced and free the old text
+ * @param obj           pointer to a label object
+ * @param old_txt       the previous text of the label or NULL
+ * @param old_static    true: `old_txt` was set by `lv_label_set_text_static`, don't free it
+ */
+static void lv_label_text_replaced(lv_obj_t * obj, char * old_txt, bool old_static)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*A static text might have been modified in place so it's not known what was drawn*/
+    if(old_txt == NULL || old_static || label->text == NULL ||
+       !lv_label_invalidate_changed(obj, old_txt, label->text)) {
+        lv_obj_invalidate(obj);
+    }
+
+    if(old_txt != NULL && !old_static) lv_mem_free(old_txt);
+}
+
+/**
+ * Invalidate only the letters which are changed if the text is a single line
+ * and the unchanged letters remain where they were.
+ * @param obj       pointer to a label object
+ * @param old_txt   the text drawn so far
+ * @param new_txt   the new text
+ * @return          true: the changes were invalidated; false: the whole label needs to be invalidated
+ */
+static bool lv_label_invalidate_changed(lv_obj_t * obj, const char * old_txt, const char * new_txt)
+{
+    lv_label_t * label = (lv_label_t *)obj;
+
+    /*The letters are drawn in the same line without scrolling or dots*/
+    if(label->long_mode != LV_LABEL_LONG_WRAP && label->long_mode != LV_LABEL_LONG_CLIP) return false;
+    if(label->recolor) return false;
+    if(lv_label_get_text_selection_start(obj) != LV_LABEL_TEXT_SELECTION_OFF ||
+       lv_label_get_text_selection_end(obj) != LV_LABEL_TEXT_SELECTION_OFF) return false;
+    if(lv_obj_get_style_text_decor(obj, LV_PART_MAIN) != LV_TEXT_DECOR_NONE) return false;
+    if(strchr(old_txt, '\n') || strchr(old_txt, '\r') || strchr(new_txt, '\n') || strchr(new_txt, '\r')) return false;
+
+#if LV_USE_BIDI
+    /*Only left-to-right texts are drawn in their logical order*/
+    if(lv_obj_get_style_base_dir(obj, LV_PART_MAIN) == LV_BASE_DIR_RTL) return false;
+    const char * t;
+    for(t = old_txt; *t != '\0'; t++) if((uint8_t)*t >= 0x80) return false;
+    for(t = new_txt; *t != '\0'; t++) if((uint8_t)*t >= 0x80) return false;
+#endif
+
+    /*Find the changed bytes between the common beginning and end*/
+    uint32_t old_len = strlen(old_txt);
+    uint32_t new_len = strlen(new_txt);
+    uint32_t pre = 0;
+    while(pre < old_len && pre < new_len && old_txt[pre] == new_txt[pre]) pre++;
+    if(pre == old_len && pre == new_len) return true;   /*Nothing has changed*/
+
+    uint32_t suf = 0;
+    while(suf < old_len - pre && suf < new_len - pre && old_txt[old_len - suf - 1] == new_txt[new_len - suf - 1]) suf++;
+
+#if LV_TXT_ENC == LV_TXT_ENC_UTF8
+    /*Don't split the UTF-8 characters*/
+    while(pre > 0 && (((uint8_t)old_txt[pre] & 0xC0) == 0x80 || ((uint8_t)new_txt[pre] & 0xC0) == 0x80)) pre--;
+    while(suf > 0 && ((uint8_t)old_txt[old_len - suf] & 0xC0) == 0x80) suf--;
+#endif
+
+    /*The kerning of the last common letter depends on the next letter*/
+    if(pre > 0) _lv_txt_encoded_prev(new_txt, &pre);
+
+    const lv_font_t * font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+    lv_coord_t letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    lv_text_flag_t flag = LV_TEXT_FLAG_NONE;
+    if(label->expand != 0) flag |= LV_TEXT_FLAG_EXPAND;
+    if(label->fixed_digits != 0) flag |= LV_TEXT_FLAG_FIXED_DIGITS;
+    bool fit = lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout;
+
+    lv_coord_t ink_x1 = LV_COORD_MAX;
+    lv_coord_t ink_x2 = LV_COORD_MIN;
+    lv_coord_t old_end_x;
+    lv_coord_t new_end_x;
+    lv_coord_t old_w = lv_label_measure_line(old_txt, pre, old_len - suf, font, letter_space, flag,
+                                             &ink_x1, &ink_x2, &old_end_x);
+    lv_coord_t new_w = lv_label_measure_line(new_txt, pre, new_len - suf, font, letter_space, flag,
+                                             &ink_x1, &ink_x2, &new_end_x);
+
+    /*The size of the label changes or the text doesn't fit into one line*/
+    if(fit && old_w != new_w) return false;
+
+    lv_area_t txt_coords;
+    lv_obj_get_content_coords(obj, &txt_coords);
+    lv_coord_t max_w = lv_area_get_width(&txt_coords);
+    if(label->expand == 0 && (old_w > max_w || new_w > max_w)) return false;
+
+    /*The start of the line has to remain in place*/
+    lv_text_align_t align = lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, new_txt);
+    if(align != lv_obj_calculate_style_text_align(obj, LV_PART_MAIN, old_txt)) return false;
+    if(align == LV_TEXT_ALIGN_CENTER && (max_w - old_w) / 2 != (max_w - new_w) / 2) return false;
+    if(align == LV_TEXT_ALIGN_RIGHT && old_w != new_w) return false;
+
+    lv_coord_t line_x = txt_coords.x1 + label->offset.x;
+    if(align == LV_TEXT_ALIGN_CENTER) line_x += (max_w - new_w) / 2;
+    else if(align == LV_TEXT_ALIGN_RIGHT) line_x += max_w - new_w;
+
+    /*The end of the line moves if the changed part has a different width*/
+    if(old_end_x != new_end_x) {
+        lv_label_measure_line(old_txt, pre, old_len, font, letter_space, flag, &ink_x1, &ink_x2, &old_end_x);
+        lv_label_measure_line(new_txt, pre, new_len, font, letter_space, flag, &ink_x1, &ink_x2, &new_end_x);
+    }
+
+    /*Only letters without pixels have changed*/
+    if(ink_x1 > ink_x2) return true;
+
+    lv_coord_t ext_size = _lv_obj_get_ext_draw_size(obj);
+    lv_area_t inv_area;
+    inv_area.x1 = line_x + ink_x1;
+    inv_area.x2 = line_x + ink_x2;
+    inv_area.y1 = obj->coords.y1 - ext_size;
+    inv_area.y2 = obj->coords.y2 + ext_size;
+    lv_obj_invalidate_area(obj, &inv_area);
+
+    return true;
+}
+
+/**
+ * Measure a single line text the same way as it's drawn
+ * @param txt           the text
+ * @param start         byte index of the first letter whose pixels are needed
+ * @param end           byte index after the last letter whose pixels are needed
+ * @param font          the font of the text
+ * @param letter_space  the letter space of the text
+ * @param flag          settings for the text from ::lv_text_flag_t
+ * @param ink_x1        extended to the left most pixel of the letters in [start, end) relative to the line start
+ * @param ink_x2        extended to the right most pixel of the letters in [start, end) relative to the line start
+ * @param end_x         store the x coordinate of the letter at `end` here
+ * @return              the width of the line
+ */
+static lv_coord_t lv_label_measure_line(const char * txt, uint32_t start, uint32_t end, const lv_font_t * font,
+                                        lv_coord_t letter_space, lv_text_flag_t flag, lv_coord_t * ink_x1, lv_coord_t * ink_x2,
+                                        lv_coord_t * end_x)
+{
+    lv_coord_t x = 0;
+    uint32_t i = 0;
+    *end_x = 0;
+    while(txt[i] != '\0') {
+        uint32_t i_act = i;
+        if(i_act == end) *end_x = x;
+
+        uint32_t letter;
+        uint32_t letter_next;
+        _lv_txt_encoded_letter_next_2(txt, &letter, &letter_next, &i);
+        lv_coord_t letter_w = _lv_txt_get_letter_width(font, letter, letter_next, flag);
+
+        if(i_act >= start && i_act < end) {
+            lv_font_glyph_dsc_t g;
+            lv_font_get_glyph_dsc(font, &g, letter, '\0');
+            if(g.box_w > 0 && g.box_h > 0) {
+                lv_coord_t gx = x + g.ofs_x;
+                if((flag & LV_TEXT_FLAG_FIXED_DIGITS) && letter >= '0' && letter <= '9') {
+                    gx += (letter_w - lv_font_get_glyph_width(font, letter, '\0')) / 2;
+                }
+                if(gx < *ink_x1) *ink_x1 = gx;
+                if(gx + g.box_w - 1 > *ink_x2) *ink_x2 = gx + g.box_w - 1;
+            }
+        }
+
+        if(letter_w > 0) x += letter_w + letter_space;
+    }
+    if(i == end) *end_x = x;
+
+    /*Trim the last letter space like `lv_txt_get_width`*/
+    return x > 0 ? x - letter_space : 0;
 }
 
 static void lv_label_revert_dots(lv_obj_t * obj)
@@ -74,6 +74,7 @@ typedef struct {
     uint8_t recolor : 1;                /*Enable in-line letter re-coloring*/
     uint8_t expand : 1;                 /*Ignore real width (used by the library with LV_LABEL_LONG_SCROLL)*/
     uint8_t dot_tmp_alloc : 1;         /*1: dot is allocated, 0: dot directly holds up to 4 chars*/
+    uint8_t fixed_digits : 1;           /*All digits are as wide as the widest one*/
 } lv_label_t;
 
 extern const lv_obj_class_t lv_label_class;
@@ -132,6 +133,14 @@ void lv_label_set_long_mode(lv_obj_t * obj, lv_label_long_mode_t long_mode);
  */
 void lv_label_set_recolor(lv_obj_t * obj, bool en);
 
+/**
+ * Draw all digits as wide as the widest one. The text doesn't move when the digits change
+ * and only the changed digits are redrawn, e.g. in clocks and counters.
+ * @param obj           pointer to a label object
+ * @param en            true: fixed width digits, false: use the width of the glyphs
+ */
+void lv_label_set_fixed_width_digits(lv_obj_t * obj, bool en);
+
 /**
  * Set where text selection should start
  * @param obj       pointer to a label object
@@ -171,6 +180,13 @@ lv_label_long_mode_t lv_label_get_long_mode(const lv_obj_t * obj);
  */
 bool lv_label_get_recolor(const lv_obj_t * obj);
 
+/**
+ * Get whether the digits are drawn with fixed width
+ * @param obj       pointer to a label object
+ * @return          true: fixed width digits, false: the width of the glyphs is used
+ */
+bool lv_label_get_fixed_width_digits(const lv_obj_t * obj);
+
 /**
  * Get the relative x and y coordinates of a letter
  * @param obj       pointer to a label object
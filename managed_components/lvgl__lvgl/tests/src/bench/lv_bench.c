@@ -0,0 +1,1276 @@
+/**
+ * @file lv_bench.c
+ * Headless rendering benchmark with the display configuration of the EA5013 board:
+ * RGB565, 480x854 panel rotated by 270 degree, rendered with `render_rotated` and
+ * flushed into two frame buffers like `main/lv_port_disp.c` does.
+ *
+ * The results are printed as JSON to the file given as the first argument or to stdout.
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../../../lvgl.h"
+#include "../../../src/draw/sw/lv_draw_sw.h"
+#include "../../../src/extra/libs/png/lodepng.h"
+#include "../../../demos/lv_demos.h"
+#include "lv_bench_mem.h"
+#include "lv_port_fb.h"
+#include "clock_ui.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PANEL_HOR_RES       480
+#define PANEL_VER_RES       854
+#define DRAW_BUF_SIZE       (PANEL_HOR_RES * PANEL_VER_RES / 4)
+
+#define FRAME_PERIOD        LV_DISP_DEF_REFR_PERIOD
+#define STRESS_FRAME_CNT    300
+#define BENCHMARK_FRAME_CNT 30  /*Less than the benchmark's 1 s scene time*/
+#define CLOCK_UPDATE_CNT    60
+#define GIF_FRAME_CNT       300
+#define GIF_DECODE_FRAMES   60  /*4 loops of giphy.gif*/
+#define GIF_CACHE_BUDGET    (8 * 1024 * 1024)   /*The PSRAM of the board*/
+#define PNG_DECODE_LOOPS    20
+#define TIME_STR_FRAME_CNT  300
+#define WIDGETS_FRAME_CNT   30
+#define INIT_DRAW_LOOPS     200
+#define FONT_LOOKUP_CNT     2000000
+#define FONT_LOOKUP_MAX_LEN 128
+#define MAIN_LOOP_SECONDS   60
+#define MAIN_LOOP_POLL_MS   10  /*The delay of the polling loop of main.c*/
+#define TICK_INC_MS         2   /*The period of the esp_timer calling lv_tick_inc() in lv_port_disp.c*/
+#define TIMER_CALL_CNT      2000    /*Calls of lv_timer_handler, 1 ms apart*/
+#define ANIM_CNT            10000
+#define ANIM_STEP_CNT       20
+#define LAYOUT_ROW_CNT      40
+#define LAYOUT_COL_CNT      49  /*40 rows of 1 + 49 objects: 2000 objects*/
+#define LAYOUT_UPDATE_CNT   200
+
+/*Used for the size of the allocations. Keeps the returned pointers aligned.*/
+#define MEM_HEADER_SIZE     16
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+typedef enum {
+    PRIM_OTHER,
+    PRIM_RECT,
+    PRIM_ARC,
+    PRIM_IMG,
+    PRIM_LETTER,
+    PRIM_LINE,
+    PRIM_POLYGON,
+    PRIM_LAYER,
+    _PRIM_LAST,
+} prim_t;
+
+typedef struct {
+    uint32_t frames;
+    uint32_t flushes;
+    uint64_t scene_ns;
+    uint64_t render_ns;
+    uint64_t flush_ns;
+    uint64_t flushed_px;
+    uint64_t inv_px;
+    uint64_t blended_px[_PRIM_LAST];
+    size_t heap_peak;
+} scene_stats_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void disp_init(void);
+static void draw_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx);
+static void render_start_cb(lv_disp_drv_t * drv);
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p);
+static void swap_cb(lv_port_fb_panel_t * panel, lv_color_t * fb);
+static void blend_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static void draw_rect_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void draw_bg_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void draw_arc_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                        uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+static void draw_img_decoded_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                                const uint8_t * map_p, lv_img_cf_t color_format);
+static void draw_letter_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                           uint32_t letter);
+static void draw_line_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                         const lv_point_t * point2);
+static void draw_polygon_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                            uint16_t point_cnt);
+static void layer_blend_cb(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                           const lv_draw_img_dsc_t * dsc);
+static void scene_begin(void);
+static void scene_end(FILE * f, const char * name);
+static void run_frames(uint32_t cnt);
+static void load_empty_screen(void);
+static void bench_clock(FILE * f);
+static void bench_stress(FILE * f);
+static void bench_benchmark(FILE * f);
+static void bench_gif(FILE * f);
+static void bench_time_str(FILE * f);
+static void time_str_scene(FILE * f, lv_obj_t * label, const char * name);
+static void bench_widgets(FILE * f);
+static uint32_t init_draw_dsc_tree(lv_obj_t * obj);
+static void bench_gif_decode(FILE * f, const char * name, const void * src, bool is_file);
+static bool encode_test_png(const uint8_t * jpg_data, uint32_t jpg_size, const char * path);
+static void bench_png_decode(FILE * f, const char * name, const char * path);
+static void bench_font_lookup(FILE * f, const char * name, const lv_font_t * font, const char * txt);
+static void bench_main_loop(FILE * f, const char * name, bool tickless);
+static void bench_timers(FILE * f, const char * name, uint32_t timer_cnt, bool one_shot);
+static void bench_timer_cb(lv_timer_t * t);
+static void bench_one_shot_timer_cb(lv_timer_t * t);
+static void bench_anims(FILE * f);
+static void bench_anim_exec_cb(void * var, int32_t v);
+static void bench_layout(FILE * f);
+static void layout_scene_end(FILE * f, const char * name, uint64_t ns);
+static uint32_t sim_tick_cb(void);
+static uint8_t * load_asset(const char * name, uint32_t * size);
+static uint64_t time_ns(void);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_color_t fb_mem[2][PANEL_HOR_RES * PANEL_VER_RES];
+static lv_color_t draw_buf_mem1[DRAW_BUF_SIZE];
+static lv_color_t draw_buf_mem2[DRAW_BUF_SIZE];
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_port_fb_t fb_backend;
+static lv_port_fb_panel_t fb_panel;
+
+static lv_draw_sw_ctx_t draw_ctx_ori;
+static prim_t prim_act;
+
+static scene_stats_t stats;
+static uint64_t scene_start;
+static uint64_t render_start;
+static bool first_scene = true;
+
+static size_t mem_used;
+static size_t mem_peak;
+
+static lv_gif_cache_stats_t gif_cache_stats;
+static lv_glyph_cache_stats_t glyph_cache_stats;
+static lv_obj_style_snapshot_stats_t style_snapshot_stats;
+static uint32_t init_draw_ns[2];
+static uint32_t sim_tick;
+static uint32_t timer_runs;
+static uint32_t timer_rnd;
+
+static const char * prim_names[_PRIM_LAST] = {
+    "other", "rect", "arc", "img", "letter", "line", "polygon", "layer"
+};
+
+/**********************
+ *      MACROS
+ **********************/
+
+/*Attribute the blended pixels to the outermost primitive*/
+#define PRIM_CALL(prim, call)               \
+    do {                                    \
+        prim_t prim_prev = prim_act;        \
+        if(prim_prev == PRIM_OTHER) prim_act = prim; \
+        call;                               \
+        prim_act = prim_prev;               \
+    } while(0)
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+int main(int argc, char ** argv)
+{
+    FILE * f = stdout;
+    if(argc > 1) {
+        f = fopen(argv[1], "w");
+        if(f == NULL) {
+            fprintf(stderr, "Couldn't open %s\n", argv[1]);
+            return 1;
+        }
+    }
+
+    lv_init();
+    disp_init();
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"config\": {\"color_depth\": %d, \"hor_res\": %d, \"ver_res\": %d, \"rotation\": 270, "
+            "\"draw_buf_px\": %d, \"frame_period_ms\": %d},\n",
+            LV_COLOR_DEPTH, PANEL_HOR_RES, PANEL_VER_RES, DRAW_BUF_SIZE, FRAME_PERIOD);
+    fprintf(f, "  \"scenes\": [");
+
+    bench_clock(f);
+    bench_stress(f);
+    bench_benchmark(f);
+    bench_gif(f);
+    bench_time_str(f);
+    bench_widgets(f);
+
+    fprintf(f, "\n  ],\n  \"decode\": [");
+
+    first_scene = true;
+    uint32_t gif_size;
+    uint8_t * gif_data = load_asset("giphy.gif", &gif_size);
+    if(gif_data) {
+        bench_gif_decode(f, "gif_mem", gif_data, false);
+        bench_gif_decode(f, "gif_fs", "S:" LV_BENCH_ASSET_DIR "/giphy.gif", true);
+        free(gif_data);
+    }
+
+    fprintf(f, "\n  ],\n  \"png_decode\": [");
+
+    first_scene = true;
+    bench_png_decode(f, "wink", "S:" LV_BENCH_ASSET_DIR "/wink.png");
+    uint32_t jpg_size;
+    uint8_t * jpg_data = load_asset("test.png", &jpg_size);
+    if(jpg_data && encode_test_png(jpg_data, jpg_size, "S:/tmp/lv_bench_test.png")) {
+        bench_png_decode(f, "test", "S:/tmp/lv_bench_test.png");
+        remove("/tmp/lv_bench_test.png");
+    }
+    free(jpg_data);
+
+    fprintf(f, "\n  ],\n  \"font_lookup\": [");
+
+    first_scene = true;
+    bench_font_lookup(f, "ascii", &lv_font_montserrat_14, "The quick brown fox jumps over the lazy dog. 12:34:56");
+    bench_font_lookup(f, "mixed", &lv_font_simsun_16_cjk, "Wi-Fi: 連接 (Ping 12 ms), 音量 75%, Größe 中");
+    bench_font_lookup(f, "cjk", &lv_font_simsun_16_cjk, "我們的時間是中文字體，今天天很好。設置顯示度和聲音音量，請確認網路連接。");
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX);
+
+    fprintf(f, "\n  ],\n  \"main_loop\": [");
+
+    first_scene = true;
+    bench_main_loop(f, "polling", false);
+    bench_main_loop(f, "tickless", true);
+
+    fprintf(f, "\n  ],\n  \"timers\": [");
+
+    first_scene = true;
+    bench_timers(f, "periodic", 100, false);
+    bench_timers(f, "periodic", 1000, false);
+    bench_timers(f, "periodic", 5000, false);
+    bench_timers(f, "one_shot", 100, true);
+    bench_timers(f, "one_shot", 1000, true);
+    bench_timers(f, "one_shot", 5000, true);
+
+    fprintf(f, "\n  ],\n  \"anims\": [");
+
+    first_scene = true;
+    bench_anims(f);
+
+    fprintf(f, "\n  ],\n  \"layout\": [");
+
+    first_scene = true;
+    bench_layout(f);
+
+    fprintf(f, "\n  ],\n  \"gif_cache\": {\"hits\": %u, \"misses\": %u, \"hit_rate\": %u, \"mem_used\": %u, "
+            "\"frame_cnt\": %u, \"streaming\": %u},\n",
+            (unsigned)gif_cache_stats.hits, (unsigned)gif_cache_stats.misses, (unsigned)gif_cache_stats.hit_rate,
+            (unsigned)gif_cache_stats.mem_used, (unsigned)gif_cache_stats.frame_cnt, (unsigned)gif_cache_stats.streaming);
+    uint32_t glyph_lookups = glyph_cache_stats.hits + glyph_cache_stats.misses;
+    fprintf(f, "  \"glyph_cache\": {\"hits\": %u, \"misses\": %u, \"hit_rate\": %u, \"size\": %u, \"entry_cnt\": %u},\n",
+            (unsigned)glyph_cache_stats.hits, (unsigned)glyph_cache_stats.misses,
+            (unsigned)(glyph_lookups ? (uint64_t)glyph_cache_stats.hits * 100 / glyph_lookups : 0),
+            (unsigned)glyph_cache_stats.size, (unsigned)glyph_cache_stats.entry_cnt);
+    uint32_t style_lookups = style_snapshot_stats.hits + style_snapshot_stats.misses;
+    fprintf(f, "  \"style_snapshot\": {\"lookups_avoided\": %u, \"lookups_done\": %u, \"hit_rate\": %u, "
+            "\"evictions\": %u, \"invalidations\": %u, \"init_draw_ns_per_obj\": %u, "
+            "\"init_draw_ns_per_obj_snapshots\": %u}\n}\n",
+            (unsigned)style_snapshot_stats.hits, (unsigned)style_snapshot_stats.misses,
+            (unsigned)(style_lookups ? (uint64_t)style_snapshot_stats.hits * 100 / style_lookups : 0),
+            (unsigned)style_snapshot_stats.evictions, (unsigned)style_snapshot_stats.invalidations,
+            (unsigned)init_draw_ns[0], (unsigned)init_draw_ns[1]);
+    if(f != stdout) fclose(f);
+
+    return 0;
+}
+
+void lv_test_assert_fail(void)
+{
+    fprintf(stderr, "LVGL assert\n");
+    abort();
+}
+
+void * lv_bench_malloc(size_t size)
+{
+    uint8_t * p = malloc(size + MEM_HEADER_SIZE);
+    if(p == NULL) return NULL;
+
+    *(size_t *)p = size;
+    mem_used += size;
+    if(mem_used > mem_peak) mem_peak = mem_used;
+
+    return p + MEM_HEADER_SIZE;
+}
+
+void lv_bench_free(void * p)
+{
+    if(p == NULL) return;
+
+    uint8_t * h = (uint8_t *)p - MEM_HEADER_SIZE;
+    mem_used -= *(size_t *)h;
+    free(h);
+}
+
+void * lv_bench_realloc(void * p, size_t new_size)
+{
+    if(p == NULL) return lv_bench_malloc(new_size);
+
+    uint8_t * h = (uint8_t *)p - MEM_HEADER_SIZE;
+    size_t old_size = *(size_t *)h;
+    h = realloc(h, new_size + MEM_HEADER_SIZE);
+    if(h == NULL) return NULL;
+
+    *(size_t *)h = new_size;
+    mem_used = mem_used - old_size + new_size;
+    if(mem_used > mem_peak) mem_peak = mem_used;
+
+    return h + MEM_HEADER_SIZE;
+}
+
+size_t lv_bench_mem_get_used(void)
+{
+    return mem_used;
+}
+
+size_t lv_bench_mem_get_peak(void)
+{
+    return mem_peak;
+}
+
+void lv_bench_mem_reset_peak(void)
+{
+    mem_peak = mem_used;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void disp_init(void)
+{
+    fb_panel.swap_cb = swap_cb;
+    lv_port_fb_init(&fb_backend, &fb_panel, fb_mem[0], fb_mem[1], PANEL_HOR_RES, PANEL_VER_RES);
+
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_mem1, draw_buf_mem2, DRAW_BUF_SIZE);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = PANEL_HOR_RES;
+    disp_drv.ver_res = PANEL_VER_RES;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.render_start_cb = render_start_cb;
+    disp_drv.draw_ctx_init = draw_ctx_init;
+    disp_drv.sw_rotate = 1;
+    disp_drv.rotated = LV_DISP_ROT_270;
+    disp_drv.render_rotated = 1;
+    lv_disp_drv_register(&disp_drv);
+}
+
+/**
+ * Initialize the software renderer and wrap its callbacks to count the blended pixels per primitive
+ */
+static void draw_ctx_init(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
+{
+    lv_draw_sw_init_ctx(drv, draw_ctx);
+
+    lv_draw_sw_ctx_t * sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+    draw_ctx_ori = *sw_ctx;
+
+    sw_ctx->blend = blend_cb;
+    draw_ctx->draw_rect = draw_rect_cb;
+    draw_ctx->draw_bg = draw_bg_cb;
+    draw_ctx->draw_arc = draw_arc_cb;
+    draw_ctx->draw_img_decoded = draw_img_decoded_cb;
+    draw_ctx->draw_letter = draw_letter_cb;
+    draw_ctx->draw_line = draw_line_cb;
+    draw_ctx->draw_polygon = draw_polygon_cb;
+    draw_ctx->layer_blend = layer_blend_cb;
+}
+
+static void render_start_cb(lv_disp_drv_t * drv)
+{
+    LV_UNUSED(drv);
+    stats.frames++;
+
+    /*The areas to redraw after joining them*/
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    uint32_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(disp->inv_area_joined[i] == 0) stats.inv_px += lv_area_get_size(&disp->inv_areas[i]);
+    }
+
+    render_start = time_ns();
+}
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    bool last = lv_disp_flush_is_last(drv);
+    uint64_t t = time_ns();
+
+    lv_port_fb_flush(&fb_backend, area, color_p, last);
+    stats.flushes++;
+    stats.flushed_px += lv_area_get_size(area);
+
+    uint64_t now = time_ns();
+    stats.flush_ns += now - t;
+    if(last) stats.render_ns += now - render_start;
+
+    lv_disp_flush_ready(drv);
+}
+
+static void swap_cb(lv_port_fb_panel_t * panel, lv_color_t * fb)
+{
+    /*No panel, the buffers can be swapped immediately*/
+    LV_UNUSED(panel);
+    LV_UNUSED(fb);
+}
+
+static void blend_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    lv_area_t a;
+    if(_lv_area_intersect(&a, dsc->blend_area, draw_ctx->clip_area)) {
+        stats.blended_px[prim_act] += lv_area_get_size(&a);
+    }
+
+    draw_ctx_ori.blend(draw_ctx, dsc);
+}
+
+static void draw_rect_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    PRIM_CALL(PRIM_RECT, draw_ctx_ori.base_draw.draw_rect(draw_ctx, dsc, coords));
+}
+
+static void draw_bg_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    PRIM_CALL(PRIM_RECT, draw_ctx_ori.base_draw.draw_bg(draw_ctx, dsc, coords));
+}
+
+static void draw_arc_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                        uint16_t radius, uint16_t start_angle, uint16_t end_angle)
+{
+    PRIM_CALL(PRIM_ARC, draw_ctx_ori.base_draw.draw_arc(draw_ctx, dsc, center, radius, start_angle, end_angle));
+}
+
+static void draw_img_decoded_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_img_dsc_t * dsc, const lv_area_t * coords,
+                                const uint8_t * map_p, lv_img_cf_t color_format)
+{
+    PRIM_CALL(PRIM_IMG, draw_ctx_ori.base_draw.draw_img_decoded(draw_ctx, dsc, coords, map_p, color_format));
+}
+
+static void draw_letter_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
+                           uint32_t letter)
+{
+    PRIM_CALL(PRIM_LETTER, draw_ctx_ori.base_draw.draw_letter(draw_ctx, dsc, pos_p, letter));
+}
+
+static void draw_line_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
+                         const lv_point_t * point2)
+{
+    PRIM_CALL(PRIM_LINE, draw_ctx_ori.base_draw.draw_line(draw_ctx, dsc, point1, point2));
+}
+
+static void draw_polygon_cb(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_point_t * points,
+                            uint16_t point_cnt)
+{
+    PRIM_CALL(PRIM_POLYGON, draw_ctx_ori.base_draw.draw_polygon(draw_ctx, dsc, points, point_cnt));
+}
+
+static void layer_blend_cb(lv_draw_ctx_t * draw_ctx, lv_draw_layer_ctx_t * layer_ctx,
+                           const lv_draw_img_dsc_t * dsc)
+{
+    PRIM_CALL(PRIM_LAYER, draw_ctx_ori.base_draw.layer_blend(draw_ctx, layer_ctx, dsc));
+}
+
+static void scene_begin(void)
+{
+    lv_memset_00(&stats, sizeof(stats));
+    lv_bench_mem_reset_peak();
+    scene_start = time_ns();
+}
+
+static void scene_end(FILE * f, const char * name)
+{
+    stats.scene_ns = time_ns() - scene_start;
+    stats.heap_peak = lv_bench_mem_get_peak();
+
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"frames\": %u, \"scene_us\": %u, \"fps\": %u, "
+            "\"render_us\": %u, \"render_us_per_frame\": %u, "
+            "\"flush_us\": %u, \"flush_count\": %u, \"flushed_bytes_per_frame\": %u, "
+            "\"inv_px_per_frame\": %u, \"heap_peak\": %u, \"blended_px\": {",
+            first_scene ? "" : ",", name, (unsigned)stats.frames, (unsigned)(stats.scene_ns / 1000),
+            (unsigned)(stats.scene_ns ? (uint64_t)stats.frames * 1000000000 / stats.scene_ns : 0),
+            (unsigned)(stats.render_ns / 1000),
+            (unsigned)(stats.frames ? stats.render_ns / 1000 / stats.frames : 0),
+            (unsigned)(stats.flush_ns / 1000), (unsigned)stats.flushes,
+            (unsigned)(stats.frames ? stats.flushed_px * sizeof(lv_color_t) / stats.frames : 0),
+            (unsigned)(stats.frames ? stats.inv_px / stats.frames : 0),
+            (unsigned)stats.heap_peak);
+
+    uint32_t i;
+    for(i = 0; i < _PRIM_LAST; i++) {
+        fprintf(f, "%s\"%s\": %llu", i == 0 ? "" : ", ", prim_names[i], (unsigned long long)stats.blended_px[i]);
+    }
+    fprintf(f, "}}");
+
+    first_scene = false;
+}
+
+static void run_frames(uint32_t cnt)
+{
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        lv_tick_inc(FRAME_PERIOD);
+        lv_timer_handler();
+    }
+}
+
+static void load_empty_screen(void)
+{
+    lv_obj_t * scr_old = lv_scr_act();
+    lv_scr_load(lv_obj_create(NULL));
+    lv_obj_del(scr_old);
+    lv_refr_now(NULL);
+}
+
+/**
+ * The clock screen of the application, updated once per second
+ */
+static void bench_clock(FILE * f)
+{
+    lv_obj_t * scr = clock_ui_create();
+    lv_scr_load(scr);
+    clock_ui_update("12:00:00", "Friday, October 16, 2026", true);
+
+    scene_begin();
+    lv_refr_now(NULL);
+    scene_end(f, "clock load");
+
+    scene_begin();
+    uint32_t i;
+    for(i = 1; i <= CLOCK_UPDATE_CNT; i++) {
+        char time_str[16];
+        lv_snprintf(time_str, sizeof(time_str), "12:%02d:%02d", (int)(i / 60), (int)(i % 60));
+        clock_ui_update(time_str, "Friday, October 16, 2026", true);
+        lv_refr_now(NULL);
+    }
+    scene_end(f, "clock update");
+
+    load_empty_screen();
+}
+
+static void bench_stress(FILE * f)
+{
+    scene_begin();
+    lv_demo_stress();
+    run_frames(STRESS_FRAME_CNT);
+    lv_demo_stress_close();
+    scene_end(f, "stress");
+
+    load_empty_screen();
+}
+
+/**
+ * Every scene of the benchmark demo with and without opacity
+ */
+static void bench_benchmark(FILE * f)
+{
+    int_fast16_t scene_no;
+    for(scene_no = 0; ; scene_no++) {
+        scene_begin();
+        lv_demo_benchmark_run_scene(scene_no);
+
+        /*The first label is the title: "<scene_no>/<scene_cnt>: <name>"*/
+        const char * title = lv_label_get_text(lv_obj_get_child(lv_scr_act(), 0));
+        const char * name = strstr(title, ": ");
+        if(name == NULL) {
+            lv_demo_benchmark_close();
+            break;
+        }
+
+        char scene_name[64];
+        lv_snprintf(scene_name, sizeof(scene_name), "benchmark: %s", name + 2);
+
+        run_frames(BENCHMARK_FRAME_CNT);
+        lv_demo_benchmark_close();
+        scene_end(f, scene_name);
+    }
+
+    load_empty_screen();
+}
+
+/**
+ * The animated GIF of the application's assets, decoded from the RAM like the C array images
+ */
+static void bench_gif(FILE * f)
+{
+    uint32_t size;
+    uint8_t * data = load_asset("giphy.gif", &size);
+    if(data == NULL) return;
+
+    static lv_img_dsc_t gif_dsc;
+    gif_dsc.data = data;
+    gif_dsc.data_size = size;
+
+    lv_obj_t * gif = lv_gif_create(lv_scr_act());
+    lv_gif_set_src(gif, &gif_dsc);
+    lv_obj_center(gif);
+    lv_refr_now(NULL);
+
+    scene_begin();
+    run_frames(GIF_FRAME_CNT);
+    scene_end(f, "gif");
+
+    /*Replay the decoded frames after the first loop*/
+    lv_gif_set_cache_budget(gif, GIF_CACHE_BUDGET);
+    lv_gif_set_src(gif, &gif_dsc);
+    lv_refr_now(NULL);
+
+    scene_begin();
+    run_frames(GIF_FRAME_CNT);
+    scene_end(f, "gif cached");
+    lv_gif_get_cache_stats(gif, &gif_cache_stats);
+
+    lv_obj_del(gif);
+    free(data);
+
+    load_empty_screen();
+}
+
+static void time_str_scene(FILE * f, lv_obj_t * label, const char * name)
+{
+    lv_refr_now(NULL);
+
+    scene_begin();
+    uint32_t i;
+    for(i = 0; i < TIME_STR_FRAME_CNT; i++) {
+        lv_obj_invalidate(label);
+        lv_refr_now(NULL);
+    }
+    scene_end(f, name);
+}
+
+/**
+ * A 48 px time string redrawn in every frame, without and with the glyph cache
+ */
+static void bench_time_str(FILE * f)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_label_set_text(label, "12:34:56");
+    lv_obj_center(label);
+
+    lv_glyph_cache_set_budget(0);
+    time_str_scene(f, label, "time string");
+
+    lv_glyph_cache_set_budget(LV_GLYPH_CACHE_DEF_BUDGET);
+    lv_glyph_cache_reset_stats();
+    time_str_scene(f, label, "time string cached");
+    lv_glyph_cache_get_stats(&glyph_cache_stats);
+
+    load_empty_screen();
+}
+
+/**
+ * The tabs of the widgets demo fully redrawn in every frame, without and with the style snapshots
+ */
+static void bench_widgets(FILE * f)
+{
+    lv_demo_widgets();
+    lv_obj_t * tv = lv_obj_get_child(lv_scr_act(), 0);
+
+    static const char * tab_names[] = {"profile", "analytics", "shop"};
+    uint32_t tab;
+    for(tab = 0; tab < sizeof(tab_names) / sizeof(tab_names[0]); tab++) {
+        lv_tabview_set_act(tv, tab, LV_ANIM_OFF);
+
+        uint32_t snapshot;
+        for(snapshot = 0; snapshot < 2; snapshot++) {
+            lv_obj_enable_style_snapshot(snapshot == 1);
+            lv_obj_style_snapshot_reset_stats();
+            lv_refr_now(NULL);
+
+            scene_begin();
+            uint32_t i;
+            for(i = 0; i < WIDGETS_FRAME_CNT; i++) {
+                lv_obj_invalidate(lv_scr_act());
+                run_frames(1);
+            }
+
+            char scene_name[64];
+            lv_snprintf(scene_name, sizeof(scene_name), "widgets: %s%s", tab_names[tab],
+                        snapshot ? " snapshots" : "");
+            scene_end(f, scene_name);
+
+            if(snapshot) {
+                lv_obj_style_snapshot_stats_t s;
+                lv_obj_style_snapshot_get_stats(&s);
+                style_snapshot_stats.hits += s.hits;
+                style_snapshot_stats.misses += s.misses;
+                style_snapshot_stats.evictions += s.evictions;
+                style_snapshot_stats.invalidations += s.invalidations;
+            }
+        }
+    }
+
+    /*Only the resolution of the draw properties of the last tab's widgets*/
+    lv_obj_t * tab_act = lv_obj_get_child(lv_tabview_get_content(tv), lv_tabview_get_tab_act(tv));
+    uint32_t snapshot;
+    for(snapshot = 0; snapshot < 2; snapshot++) {
+        lv_obj_enable_style_snapshot(snapshot == 1);
+        uint64_t t = time_ns();
+        uint32_t obj_cnt = 0;
+        uint32_t i;
+        for(i = 0; i < INIT_DRAW_LOOPS; i++) obj_cnt += init_draw_dsc_tree(tab_act);
+        init_draw_ns[snapshot] = (uint32_t)((time_ns() - t) / obj_cnt);
+    }
+
+    lv_demo_widgets_close();
+    load_empty_screen();
+}
+
+/*Initialize the draw descriptors of the main part of the objects like their draw event does*/
+static uint32_t init_draw_dsc_tree(lv_obj_t * obj)
+{
+    lv_draw_rect_dsc_t rect_dsc;
+    lv_draw_rect_dsc_init(&rect_dsc);
+    lv_obj_init_draw_rect_dsc(obj, LV_PART_MAIN, &rect_dsc);
+
+    lv_draw_label_dsc_t label_dsc;
+    lv_draw_label_dsc_init(&label_dsc);
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &label_dsc);
+
+    uint32_t cnt = 1;
+    uint32_t i;
+    for(i = 0; i < lv_obj_get_child_cnt(obj); i++) {
+        cnt += init_draw_dsc_tree(lv_obj_get_child(obj, i));
+    }
+    return cnt;
+}
+
+/**
+ * Decode the frames of a GIF into its canvas, without drawing
+ * @param name      name of the result
+ * @param src       the GIF's data or the path of the file
+ * @param is_file   true: `src` is a path
+ */
+static void bench_gif_decode(FILE * f, const char * name, const void * src, bool is_file)
+{
+    lv_bench_mem_reset_peak();
+    uint64_t t = time_ns();
+
+    gd_GIF * gif = is_file ? gd_open_gif_file(src) : gd_open_gif_data(src);
+    if(gif == NULL) {
+        fprintf(stderr, "Couldn't open the GIF for %s\n", name);
+        return;
+    }
+
+    /*The GIF loops forever, so it never runs out of frames*/
+    uint32_t frames;
+    for(frames = 0; frames < GIF_DECODE_FRAMES; frames++) {
+        if(gd_get_frame(gif) != 1) break;
+        gd_render_frame(gif, gif->canvas);
+    }
+    gd_close_gif(gif);
+
+    uint64_t ns = time_ns() - t;
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"frames\": %u, \"us\": %u, \"us_per_frame\": %u, \"heap_peak\": %u}",
+            first_scene ? "" : ",", name, (unsigned)frames, (unsigned)(ns / 1000),
+            (unsigned)(frames ? ns / 1000 / frames : 0), (unsigned)lv_bench_mem_get_peak());
+
+    first_scene = false;
+}
+
+/**
+ * Save the pixels of `qr_data/test.png` as a real PNG. The asset is a JPEG with a PNG extension.
+ * @param jpg_data  the content of `test.png`
+ * @param jpg_size  size of `jpg_data`
+ * @param path      where to save the PNG
+ * @return          true: saved
+ */
+static bool encode_test_png(const uint8_t * jpg_data, uint32_t jpg_size, const char * path)
+{
+    lv_img_dsc_t jpg_dsc;
+    lv_memset_00(&jpg_dsc, sizeof(jpg_dsc));
+    jpg_dsc.data = jpg_data;
+    jpg_dsc.data_size = jpg_size;
+
+    lv_img_decoder_dsc_t dsc;
+    if(lv_img_decoder_open(&dsc, &jpg_dsc, lv_color_black(), 0) != LV_RES_OK) {
+        fprintf(stderr, "Couldn't open test.png\n");
+        return false;
+    }
+
+    uint32_t w = dsc.header.w;
+    uint32_t h = dsc.header.h;
+    uint8_t * rgb = malloc(w * h * 3);
+    lv_color_t * line = malloc(w * sizeof(lv_color_t));
+    uint32_t y;
+    for(y = 0; y < h; y++) {
+        if(dsc.img_data) lv_memcpy(line, dsc.img_data + y * w * sizeof(lv_color_t), w * sizeof(lv_color_t));
+        else lv_img_decoder_read_line(&dsc, 0, y, w, (uint8_t *)line);
+        uint32_t x;
+        for(x = 0; x < w; x++) {
+            uint32_t c32 = lv_color_to32(line[x]);
+            rgb[(y * w + x) * 3 + 0] = (c32 >> 16) & 0xFF;
+            rgb[(y * w + x) * 3 + 1] = (c32 >> 8) & 0xFF;
+            rgb[(y * w + x) * 3 + 2] = c32 & 0xFF;
+        }
+    }
+    lv_img_decoder_close(&dsc);
+
+    uint8_t * png = NULL;
+    size_t png_size = 0;
+    unsigned error = lodepng_encode24(&png, &png_size, rgb, w, h);
+    if(!error) error = lodepng_save_file(png, png_size, path);
+    lv_mem_free(png);
+    free(line);
+    free(rgb);
+    if(error) fprintf(stderr, "Couldn't save %s\n", path);
+    return error == 0;
+}
+
+/**
+ * Decode a PNG file the way `lv_png` did before streaming (the whole file and a 32-bit image in the heap),
+ * decode it into an image buffer like the image cache does and read it line by line like uncached drawing does.
+ * @param name      name of the result
+ * @param path      path of the PNG
+ */
+static void bench_png_decode(FILE * f, const char * name, const char * path)
+{
+    static const char * mode_names[] = {"lodepng", "decode", "read_line"};
+    uint32_t m;
+    for(m = 0; m < sizeof(mode_names) / sizeof(mode_names[0]); m++) {
+        size_t peak = 0;
+        uint32_t w = 0;
+        uint32_t h = 0;
+        bool ok = true;
+        uint32_t i;
+        uint64_t t = time_ns();
+        for(i = 0; i < PNG_DECODE_LOOPS && ok; i++) {
+            size_t used = lv_bench_mem_get_used();
+            lv_bench_mem_reset_peak();
+            if(m == 0) {
+                uint8_t * file_data = NULL;
+                size_t file_size;
+                uint8_t * rgba = NULL;
+                unsigned error = lodepng_load_file(&file_data, &file_size, path);
+                if(!error) error = lodepng_decode32(&rgba, &w, &h, file_data, file_size);
+                lv_mem_free(file_data);
+                ok = error == 0;
+                /*Convert to the color format in place*/
+                uint32_t px;
+                for(px = 0; ok && px < w * h; px++) {
+                    uint8_t * p = &rgba[px * 4];
+                    lv_color_t c = lv_color_make(p[0], p[1], p[2]);
+                    uint8_t a = p[3];
+                    lv_memcpy(&rgba[px * LV_IMG_PX_SIZE_ALPHA_BYTE], &c, sizeof(c));
+                    rgba[px * LV_IMG_PX_SIZE_ALPHA_BYTE + LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = a;
+                }
+                lv_mem_free(rgba);
+            }
+            else {
+                lv_img_decoder_dsc_t dsc;
+                ok = lv_img_decoder_open(&dsc, path, lv_color_black(), 0) == LV_RES_OK;
+                if(!ok) break;
+                w = dsc.header.w;
+                h = dsc.header.h;
+                uint32_t px_size = lv_img_cf_get_px_size(dsc.header.cf) >> 3;
+                uint8_t * buf = lv_mem_alloc(m == 1 ? w * h * px_size : w * px_size);
+                if(m == 1) {
+                    ok = lv_img_decoder_decode(&dsc, buf) == LV_RES_OK;
+                }
+                else {
+                    uint32_t y;
+                    for(y = 0; y < h && ok; y++) ok = lv_img_decoder_read_line(&dsc, 0, y, w, buf) == LV_RES_OK;
+                }
+                lv_mem_free(buf);
+                lv_img_decoder_close(&dsc);
+            }
+            peak = LV_MAX(peak, lv_bench_mem_get_peak() - used);
+        }
+        uint64_t ns = time_ns() - t;
+        if(!ok) {
+            fprintf(stderr, "Couldn't decode %s with %s\n", path, mode_names[m]);
+            continue;
+        }
+
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"mode\": \"%s\", \"w\": %u, \"h\": %u, \"us\": %u, \"heap_peak\": %u}",
+                first_scene ? "" : ",", name, mode_names[m], (unsigned)w, (unsigned)h,
+                (unsigned)(ns / 1000 / PNG_DECODE_LOOPS), (unsigned)peak);
+        first_scene = false;
+    }
+}
+
+/**
+ * Look up the glyphs of a text like the label drawing does: the letter with the next one for the kerning.
+ * Measured without index, with the index built in every mode or with the index generated into the font.
+ * @param name      name of the result
+ * @param font      a font in the `lv_font_fmt_txt` format
+ * @param txt       UTF-8 text
+ */
+static void bench_font_lookup(FILE * f, const char * name, const lv_font_t * font, const char * txt)
+{
+    uint32_t letters[FONT_LOOKUP_MAX_LEN + 1];
+    uint32_t letter_cnt = 0;
+    uint32_t ofs = 0;
+    while(txt[ofs] != '\0' && letter_cnt < FONT_LOOKUP_MAX_LEN) {
+        letters[letter_cnt++] = _lv_txt_encoded_next(txt, &ofs);
+    }
+    letters[letter_cnt] = '\0';
+
+    const lv_font_fmt_txt_dsc_t * fdsc = font->dsc;
+    static const lv_font_fmt_txt_index_mode_t modes[] = {
+        LV_FONT_FMT_TXT_INDEX_NONE, LV_FONT_FMT_TXT_INDEX_HASH, LV_FONT_FMT_TXT_INDEX_PAGES
+    };
+    static const char * mode_names[] = {"none", "hash", "pages"};
+    uint32_t m;
+    for(m = 0; m < sizeof(modes) / sizeof(modes[0]); m++) {
+        /*The generated index is the same in every mode*/
+        if(fdsc->index && modes[m] == LV_FONT_FMT_TXT_INDEX_HASH) continue;
+
+        lv_font_fmt_txt_set_index_mode(modes[m]);
+        lv_font_fmt_txt_build_index(font);
+
+        uint32_t found_cnt = 0;
+        uint32_t i;
+        uint64_t t = time_ns();
+        for(i = 0; i < FONT_LOOKUP_CNT; i++) {
+            uint32_t li = i % letter_cnt;
+            lv_font_glyph_dsc_t g;
+            if(lv_font_get_glyph_dsc(font, &g, letters[li], letters[li + 1])) found_cnt++;
+        }
+        uint64_t ns = time_ns() - t;
+
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"index\": \"%s\", \"letters\": %u, \"found\": %u, "
+                "\"ns_per_lookup\": %.1f, \"mlookups_per_s\": %.1f, \"index_size\": %u}",
+                first_scene ? "" : ",", name, fdsc->index && m ? "generated" : mode_names[m], (unsigned)letter_cnt,
+                (unsigned)(found_cnt / (FONT_LOOKUP_CNT / letter_cnt)), (double)ns / FONT_LOOKUP_CNT,
+                (double)FONT_LOOKUP_CNT * 1000 / (double)ns, (unsigned)lv_font_fmt_txt_get_index_size(font));
+        first_scene = false;
+    }
+}
+
+/**
+ * Read a file of the application's assets into memory
+ * @param name      file name in `qr_data`
+ * @param size      store the size of the file here
+ * @return          the content of the file allocated with `malloc` or NULL on error
+ */
+/**
+ * The clock screen for a minute of simulated time. The clock task posts the time in every second.
+ * The polling loop of the application calls `lv_timer_handler` in every 10 ms.
+ * The tickless loop sleeps for the time returned by `lv_timer_handler` or until a command is posted.
+ * The time spent in `lv_timer_handler` is measured on the host to tell the idle percentage.
+ */
+static void bench_main_loop(FILE * f, const char * name, bool tickless)
+{
+    const char * date_str = "Friday, October 16, 2026";
+    lv_obj_t * scr = clock_ui_create();
+    lv_scr_load(scr);
+    clock_ui_update("12:00:00", date_str, true);
+    lv_refr_now(NULL);
+
+    scene_begin();
+    sim_tick = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+
+    uint32_t start = sim_tick;
+    uint32_t end = start + MAIN_LOOP_SECONDS * 1000;
+    uint32_t next_post = start + 1000;
+    uint32_t wakeups = 0;
+    uint64_t busy_ns = 0;
+    while(sim_tick < end) {
+        if(sim_tick >= next_post) {
+            char time_str[16];
+            uint32_t sec = (sim_tick - start) / 1000;
+            lv_snprintf(time_str, sizeof(time_str), "12:%02d:%02d", (int)(sec / 60), (int)(sec % 60));
+            clock_ui_post_update(time_str, date_str, true);
+            next_post += 1000;
+        }
+
+        uint64_t t = time_ns();
+        uint32_t wait = lv_timer_handler();
+        busy_ns += time_ns() - t;
+        wakeups++;
+
+        uint32_t wake;
+        if(tickless) {
+            wake = wait >= end - sim_tick ? end : sim_tick + wait;
+            if(wake > next_post) wake = next_post;
+        }
+        else {
+            wake = sim_tick + MAIN_LOOP_POLL_MS;
+        }
+        sim_tick = wake;
+    }
+
+    /*Continue the counted tick from the simulated time*/
+    lv_tick_set_cb(NULL);
+    lv_tick_inc(sim_tick - start);
+
+    double busy_pct = (double)busy_ns * 100 / ((double)MAIN_LOOP_SECONDS * 1000000000);
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"seconds\": %d, \"wakeups_per_s\": %.1f, \"tick_irqs_per_s\": %d, "
+            "\"frames\": %u, \"busy_us_per_s\": %u, \"idle_pct\": %.3f}",
+            first_scene ? "" : ",", name, MAIN_LOOP_SECONDS, (double)wakeups / MAIN_LOOP_SECONDS,
+            tickless ? 0 : 1000 / TICK_INC_MS, (unsigned)stats.frames, (unsigned)(busy_ns / 1000 / MAIN_LOOP_SECONDS),
+            100 - busy_pct);
+    first_scene = false;
+
+    load_empty_screen();
+}
+
+/**
+ * Many timers with random periods between 10 and 1000 ms, like the timers of GIFs, animations and widgets.
+ * `lv_timer_handler` is called in every millisecond of simulated time.
+ * The one-shot timers create a new timer from their callback and are deleted after running, like `lv_async_call`.
+ * @param name          name of the result
+ * @param timer_cnt     number of timers
+ * @param one_shot      true: one-shot timers; false: periodic timers
+ */
+static void bench_timers(FILE * f, const char * name, uint32_t timer_cnt, bool one_shot)
+{
+    sim_tick = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+    timer_rnd = 1;
+    timer_runs = 0;
+
+    lv_timer_t ** timers = one_shot ? NULL : malloc(timer_cnt * sizeof(lv_timer_t *));
+    uint32_t i;
+    for(i = 0; i < timer_cnt; i++) {
+        timer_rnd = timer_rnd * 1103515245 + 12345;
+        lv_timer_t * t = lv_timer_create(one_shot ? bench_one_shot_timer_cb : bench_timer_cb,
+                                         10 + (timer_rnd >> 16) % 991, NULL);
+        if(one_shot) lv_timer_set_repeat_count(t, 1);
+        else timers[i] = t;
+    }
+
+    uint64_t t = time_ns();
+    for(i = 0; i < TIMER_CALL_CNT; i++) {
+        sim_tick++;
+        lv_timer_handler();
+    }
+    uint64_t ns = time_ns() - t;
+
+    /*The one-shot timers are recognized by their callback*/
+    if(one_shot) {
+        lv_timer_t * timer = lv_timer_get_next(NULL);
+        while(timer) {
+            lv_timer_t * next = lv_timer_get_next(timer);
+            if(timer->timer_cb == bench_one_shot_timer_cb) lv_timer_del(timer);
+            timer = next;
+        }
+    }
+    else {
+        for(i = 0; i < timer_cnt; i++) lv_timer_del(timers[i]);
+        free(timers);
+    }
+
+    lv_tick_set_cb(NULL);
+    lv_tick_inc(TIMER_CALL_CNT);
+
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"timers\": %u, \"calls\": %d, \"runs\": %u, "
+            "\"ns_per_call\": %u, \"ns_per_run\": %u}",
+            first_scene ? "" : ",", name, (unsigned)timer_cnt, TIMER_CALL_CNT, (unsigned)timer_runs,
+            (unsigned)(ns / TIMER_CALL_CNT), (unsigned)(timer_runs ? ns / timer_runs : 0));
+    first_scene = false;
+}
+
+static void bench_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    timer_runs++;
+}
+
+static void bench_one_shot_timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    timer_runs++;
+    timer_rnd = timer_rnd * 1103515245 + 12345;
+    lv_timer_t * next = lv_timer_create(bench_one_shot_timer_cb, 10 + (timer_rnd >> 16) % 991, NULL);
+    lv_timer_set_repeat_count(next, 1);
+}
+
+/**
+ * Start, restart, step and cancel many animations, e.g. the style transitions of a big screen.
+ * Every animation has its own variable. Restarting an animation replaces the running one.
+ */
+static void bench_anims(FILE * f)
+{
+    static int32_t vars[ANIM_CNT];
+    static const char * names[] = {"start", "restart", "step", "get", "cancel"};
+    uint64_t ns[5];
+    uint32_t cnt[5] = {ANIM_CNT, ANIM_CNT, ANIM_CNT * ANIM_STEP_CNT, ANIM_CNT, ANIM_CNT};
+
+    sim_tick = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_exec_cb(&a, bench_anim_exec_cb);
+    lv_anim_set_values(&a, 0, 1000);
+    lv_anim_set_time(&a, 100000);
+
+    uint32_t i;
+    uint64_t t = time_ns();
+    for(i = 0; i < ANIM_CNT; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_start(&a);
+    }
+    ns[0] = time_ns() - t;
+
+    t = time_ns();
+    for(i = 0; i < ANIM_CNT; i++) {
+        lv_anim_set_var(&a, &vars[i]);
+        lv_anim_start(&a);
+    }
+    ns[1] = time_ns() - t;
+
+    t = time_ns();
+    for(i = 0; i < ANIM_STEP_CNT; i++) {
+        sim_tick += FRAME_PERIOD;
+        lv_anim_refr_now();
+    }
+    ns[2] = time_ns() - t;
+
+    uint32_t found_cnt = 0;
+    t = time_ns();
+    for(i = 0; i < ANIM_CNT; i++) {
+        if(lv_anim_get(&vars[i], bench_anim_exec_cb)) found_cnt++;
+    }
+    ns[3] = time_ns() - t;
+
+    t = time_ns();
+    for(i = 0; i < ANIM_CNT; i++) {
+        lv_anim_del(&vars[i], bench_anim_exec_cb);
+    }
+    ns[4] = time_ns() - t;
+
+    lv_tick_set_cb(NULL);
+    lv_tick_inc(ANIM_STEP_CNT * FRAME_PERIOD);
+
+    for(i = 0; i < 5; i++) {
+        fprintf(f, "%s\n    {\"name\": \"%s\", \"anims\": %d, \"ops\": %u, \"ns_per_op\": %u}",
+                first_scene ? "" : ",", names[i], ANIM_CNT, (unsigned)cnt[i], (unsigned)(ns[i] / cnt[i]));
+        first_scene = false;
+    }
+    if(found_cnt != ANIM_CNT || lv_anim_count_running() != 0) fprintf(stderr, "Animations are lost\n");
+}
+
+/**
+ * Change one thing on a screen of 2000 objects in flex containers and update the layout.
+ * Report the objects visited and recalculated by an update.
+ */
+static void bench_layout(FILE * f)
+{
+    lv_obj_t * scr = lv_obj_create(NULL);
+    lv_obj_t * cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    lv_obj_t * rows[LAYOUT_ROW_CNT];
+    lv_obj_t * labels[LAYOUT_ROW_CNT];
+    uint32_t r;
+    for(r = 0; r < LAYOUT_ROW_CNT; r++) {
+        rows[r] = lv_obj_create(cont);
+        lv_obj_set_size(rows[r], lv_pct(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(rows[r], LV_FLEX_FLOW_ROW_WRAP);
+        uint32_t c;
+        for(c = 0; c < LAYOUT_COL_CNT; c++) {
+            lv_obj_t * label = lv_label_create(rows[r]);
+            lv_label_set_text_fmt(label, "%d", (int)c);
+            if(c == 0) labels[r] = label;
+        }
+    }
+    lv_obj_update_layout(scr);
+
+    /*A label gets wider*/
+    lv_obj_layout_reset_stats();
+    uint64_t t = time_ns();
+    uint32_t i;
+    for(i = 0; i < LAYOUT_UPDATE_CNT; i++) {
+        lv_label_set_text(labels[LAYOUT_ROW_CNT / 2], i % 2 ? "1" : "100");
+        lv_obj_update_layout(scr);
+    }
+    layout_scene_end(f, "label_text", time_ns() - t);
+
+    /*The gap of a row changes*/
+    lv_obj_layout_reset_stats();
+    t = time_ns();
+    for(i = 0; i < LAYOUT_UPDATE_CNT; i++) {
+        lv_obj_set_style_pad_column(rows[LAYOUT_ROW_CNT / 2], i % 2 ? 4 : 8, 0);
+        lv_obj_update_layout(scr);
+    }
+    layout_scene_end(f, "row_gap", time_ns() - t);
+
+    /*The width of all rows changes*/
+    lv_obj_layout_reset_stats();
+    t = time_ns();
+    for(i = 0; i < LAYOUT_UPDATE_CNT; i++) {
+        lv_obj_set_style_pad_hor(cont, i % 2 ? 4 : 8, 0);
+        lv_obj_update_layout(scr);
+    }
+    layout_scene_end(f, "cont_pad", time_ns() - t);
+
+    lv_obj_del(scr);
+}
+
+static void layout_scene_end(FILE * f, const char * name, uint64_t ns)
+{
+    lv_obj_layout_stats_t s;
+    lv_obj_layout_get_stats(&s);
+    fprintf(f, "%s\n    {\"name\": \"%s\", \"objs\": %d, \"updates\": %d, \"passes_per_update\": %u.%02u, "
+            "\"visited_per_update\": %u, \"refreshed_per_update\": %u, \"us_per_update\": %u}",
+            first_scene ? "" : ",", name, LAYOUT_ROW_CNT * (LAYOUT_COL_CNT + 1), LAYOUT_UPDATE_CNT,
+            (unsigned)(s.updates / LAYOUT_UPDATE_CNT), (unsigned)(s.updates * 100 / LAYOUT_UPDATE_CNT % 100),
+            (unsigned)(s.visited / LAYOUT_UPDATE_CNT), (unsigned)(s.refreshed / LAYOUT_UPDATE_CNT),
+            (unsigned)(ns / LAYOUT_UPDATE_CNT / 1000));
+    first_scene = false;
+}
+
+static void bench_anim_exec_cb(void * var, int32_t v)
+{
+    *(int32_t *)var = v;
+}
+
+static uint32_t sim_tick_cb(void)
+{
+    return sim_tick;
+}
+
+static uint8_t * load_asset(const char * name, uint32_t * size)
+{
+    char path[256];
+    lv_snprintf(path, sizeof(path), "%s/%s", LV_BENCH_ASSET_DIR, name);
+    FILE * file = fopen(path, "rb");
+    if(file == NULL) {
+        fprintf(stderr, "Couldn't open %s\n", path);
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    long file_size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    uint8_t * data = malloc(file_size);
+    size_t rn = data ? fread(data, 1, file_size, file) : 0;
+    fclose(file);
+    if(rn != (size_t)file_size) {
+        fprintf(stderr, "Couldn't read %s\n", path);
+        free(data);
+        return NULL;
+    }
+
+    *size = file_size;
+    return data;
+}
+
+static uint64_t time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
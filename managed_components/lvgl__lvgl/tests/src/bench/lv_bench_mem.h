@@ -0,0 +1,49 @@
+/**
+ * @file lv_bench_mem.h
+ * Heap of the benchmark. It's used as `LV_MEM_CUSTOM_INCLUDE` to measure the peak heap usage.
+ */
+
+#ifndef LV_BENCH_MEM_H
+#define LV_BENCH_MEM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include <stddef.h>
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+void * lv_bench_malloc(size_t size);
+
+void lv_bench_free(void * p);
+
+void * lv_bench_realloc(void * p, size_t new_size);
+
+/**
+ * Get the number of currently allocated bytes
+ * @return the allocated bytes
+ */
+size_t lv_bench_mem_get_used(void);
+
+/**
+ * Get the highest number of allocated bytes since the last `lv_bench_mem_reset_peak()`
+ * @return the peak usage in bytes
+ */
+size_t lv_bench_mem_get_peak(void);
+
+/**
+ * Start measuring the peak usage from the current usage
+ */
+void lv_bench_mem_reset_peak(void);
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_BENCH_MEM_H*/
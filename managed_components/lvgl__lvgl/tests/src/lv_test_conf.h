@@ -25,6 +25,14 @@ extern "C" {
 void lv_test_assert_fail(void);
 #define LV_ASSERT_HANDLER lv_test_assert_fail();
 
+#ifdef LV_BUILD_BENCH
+/*Measure the heap usage of the benchmark*/
+#define LV_MEM_CUSTOM_INCLUDE "lv_bench_mem.h"
+#define LV_MEM_CUSTOM_ALLOC   lv_bench_malloc
+#define LV_MEM_CUSTOM_FREE    lv_bench_free
+#define LV_MEM_CUSTOM_REALLOC lv_bench_realloc
+#endif
+
 /**********************
  *      TYPEDEFS
  **********************/
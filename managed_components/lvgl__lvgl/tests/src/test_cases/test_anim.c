@@ -0,0 +1,276 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+#define MANY_VAR_CNT    100
+
+typedef struct {
+    int32_t value;
+    uint32_t exec_cnt;
+    uint32_t ready_cnt;
+    uint32_t deleted_cnt;
+    void * other;       /*Deleted or started by the callbacks*/
+} anim_var_t;
+
+static uint32_t sim_time;
+
+static uint32_t sim_tick_cb(void)
+{
+    return sim_time;
+}
+
+static void exec_cb(void * var, int32_t v)
+{
+    anim_var_t * d = var;
+    d->value = v;
+    d->exec_cnt++;
+}
+
+static void exec2_cb(void * var, int32_t v)
+{
+    LV_UNUSED(var);
+    LV_UNUSED(v);
+}
+
+static void deleted_cb(lv_anim_t * a)
+{
+    anim_var_t * d = a->var;
+    d->deleted_cnt++;
+}
+
+static void start_anim(anim_var_t * var, lv_anim_exec_xcb_t cb, uint32_t time)
+{
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, var);
+    lv_anim_set_exec_cb(&a, cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, time);
+    lv_anim_set_deleted_cb(&a, deleted_cb);
+    lv_anim_start(&a);
+}
+
+static void ready_del_other_cb(lv_anim_t * a)
+{
+    anim_var_t * d = a->var;
+    d->ready_cnt++;
+    lv_anim_del(d->other, NULL);
+}
+
+static void ready_start_other_cb(lv_anim_t * a)
+{
+    anim_var_t * d = a->var;
+    d->ready_cnt++;
+    start_anim(d->other, exec_cb, 100);
+
+    /*Restart itself too. It's deleted already so it doesn't replace itself.*/
+    start_anim(d, exec_cb, 100);
+}
+
+static void deleted_del_other_cb(lv_anim_t * a)
+{
+    anim_var_t * d = a->var;
+    d->deleted_cnt++;
+    lv_anim_del(d->other, NULL);
+}
+
+/*Run the anim timer for `ms` milliseconds*/
+static void run(uint32_t ms)
+{
+    uint32_t end = sim_time + ms;
+    while(sim_time < end) {
+        sim_time += LV_DISP_DEF_REFR_PERIOD;
+        lv_timer_handler();
+    }
+}
+
+void setUp(void)
+{
+    /*The timers expect the time not to go back*/
+    if((int32_t)(lv_tick_get() - sim_time) > 0) sim_time = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+    lv_anim_del_all();
+}
+
+void tearDown(void)
+{
+    lv_anim_del_all();
+    lv_tick_set_cb(NULL);
+}
+
+void test_anim_start_replaces_the_same_anim(void)
+{
+    anim_var_t v1 = {0};
+    anim_var_t v2 = {0};
+
+    start_anim(&v1, exec_cb, 100);
+    start_anim(&v1, exec2_cb, 100);
+    start_anim(&v2, exec_cb, 100);
+    TEST_ASSERT_EQUAL(3, lv_anim_count_running());
+
+    /*The same var and exec_cb: the old one is deleted*/
+    start_anim(&v1, exec_cb, 200);
+    TEST_ASSERT_EQUAL(3, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(1, v1.deleted_cnt);
+
+    lv_anim_t * a = lv_anim_get(&v1, exec_cb);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_EQUAL_PTR(&v1, a->var);
+    TEST_ASSERT_EQUAL(200, a->time);
+    TEST_ASSERT_NOT_NULL(lv_anim_get(&v1, NULL));
+    TEST_ASSERT_EQUAL_PTR(&v2, lv_anim_get(&v2, exec_cb)->var);
+    TEST_ASSERT_NULL(lv_anim_get(&v2, exec2_cb));
+
+    /*It's applied until it's ready*/
+    run(300);
+    TEST_ASSERT_EQUAL(100, v1.value);
+    TEST_ASSERT_EQUAL(100, v2.value);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_NULL(lv_anim_get(&v1, NULL));
+}
+
+void test_anim_del(void)
+{
+    anim_var_t v1 = {0};
+    anim_var_t v2 = {0};
+
+    start_anim(&v1, exec_cb, 100);
+    start_anim(&v1, exec2_cb, 100);
+    start_anim(&v2, exec_cb, 100);
+    start_anim(&v2, exec2_cb, 100);
+
+    /*By var and exec_cb*/
+    TEST_ASSERT_TRUE(lv_anim_del(&v1, exec2_cb));
+    TEST_ASSERT_FALSE(lv_anim_del(&v1, exec2_cb));
+    TEST_ASSERT_EQUAL(3, lv_anim_count_running());
+
+    /*By exec_cb only*/
+    TEST_ASSERT_TRUE(lv_anim_del(NULL, exec_cb));
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+    TEST_ASSERT_NOT_NULL(lv_anim_get(&v2, exec2_cb));
+
+    /*By var only*/
+    TEST_ASSERT_TRUE(lv_anim_del(&v2, NULL));
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(2, v1.deleted_cnt);
+    TEST_ASSERT_EQUAL(2, v2.deleted_cnt);
+
+    /*All without calling the callbacks*/
+    start_anim(&v1, exec_cb, 100);
+    start_anim(&v2, exec_cb, 100);
+    lv_anim_del_all();
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_EQUAL(2, v1.deleted_cnt);
+    run(300);
+    TEST_ASSERT_EQUAL(0, v1.value);
+}
+
+void test_anim_del_in_callbacks(void)
+{
+    anim_var_t v1 = {0};
+    anim_var_t v2 = {0};
+    anim_var_t v3 = {0};
+
+    /*The ready callback of the first deletes the second one*/
+    v1.other = &v2;
+    start_anim(&v1, exec_cb, 50);
+    lv_anim_get(&v1, exec_cb)->ready_cb = ready_del_other_cb;
+    start_anim(&v2, exec_cb, 200);
+
+    /*The deleted callback of the third deletes the first one*/
+    v3.other = &v1;
+    start_anim(&v3, exec_cb, 100);
+    lv_anim_get(&v3, exec_cb)->deleted_cb = deleted_del_other_cb;
+
+    run(50);
+    TEST_ASSERT_EQUAL(1, v1.ready_cnt);
+    TEST_ASSERT_EQUAL(1, v2.deleted_cnt);
+    TEST_ASSERT_EQUAL(1, lv_anim_count_running());
+
+    /*v1 is ready so deleting v3 doesn't delete anything else*/
+    lv_anim_del(&v3, NULL);
+    TEST_ASSERT_EQUAL(1, v3.deleted_cnt);
+    TEST_ASSERT_EQUAL(1, v1.deleted_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+
+    /*The deleted callback deletes another running animation*/
+    start_anim(&v1, exec_cb, 100);
+    start_anim(&v3, exec_cb, 100);
+    lv_anim_get(&v3, exec_cb)->deleted_cb = deleted_del_other_cb;
+    lv_anim_del(&v3, NULL);
+    TEST_ASSERT_EQUAL(2, v1.deleted_cnt);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_anim_start_in_ready_cb(void)
+{
+    anim_var_t v1 = {0};
+    anim_var_t v2 = {0};
+
+    v1.other = &v2;
+    start_anim(&v1, exec_cb, 30);
+    lv_anim_get(&v1, exec_cb)->ready_cb = ready_start_other_cb;
+
+    run(30);
+    TEST_ASSERT_EQUAL(1, v1.ready_cnt);
+    TEST_ASSERT_EQUAL(2, lv_anim_count_running());
+
+    /*The new animations don't run in the same round, only their start value is applied*/
+    TEST_ASSERT_EQUAL(0, v1.value);
+    TEST_ASSERT_EQUAL(1, v2.exec_cnt);
+    TEST_ASSERT_EQUAL(0, v2.value);
+
+    run(100);
+    TEST_ASSERT_EQUAL(100, v2.value);
+    TEST_ASSERT_NULL(lv_anim_get(&v2, NULL));
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+}
+
+void test_many_anims(void)
+{
+    static anim_var_t vars[MANY_VAR_CNT];
+    lv_memset_00(vars, sizeof(vars));
+
+    /*Two animations per variable*/
+    uint32_t i;
+    for(i = 0; i < MANY_VAR_CNT; i++) {
+        start_anim(&vars[i], exec_cb, 100 + i);
+        start_anim(&vars[i], exec2_cb, 1000);
+    }
+    TEST_ASSERT_EQUAL(2 * MANY_VAR_CNT, lv_anim_count_running());
+
+    for(i = 0; i < MANY_VAR_CNT; i++) {
+        lv_anim_t * a = lv_anim_get(&vars[i], exec_cb);
+        TEST_ASSERT_NOT_NULL(a);
+        TEST_ASSERT_EQUAL(100 + i, a->time);
+        TEST_ASSERT_EQUAL_PTR(&vars[i], a->var);
+    }
+
+    /*Delete every second variable*/
+    for(i = 0; i < MANY_VAR_CNT; i += 2) {
+        TEST_ASSERT_TRUE(lv_anim_del(&vars[i], NULL));
+    }
+    TEST_ASSERT_EQUAL(MANY_VAR_CNT, lv_anim_count_running());
+    for(i = 0; i < MANY_VAR_CNT; i++) {
+        TEST_ASSERT_EQUAL(i % 2 ? 1 : 0, lv_anim_get(&vars[i], NULL) != NULL);
+    }
+
+    /*The first animations get ready one by one, the others are still running*/
+    run(100 + MANY_VAR_CNT);
+    TEST_ASSERT_EQUAL(MANY_VAR_CNT / 2, lv_anim_count_running());
+    for(i = 1; i < MANY_VAR_CNT; i += 2) {
+        TEST_ASSERT_EQUAL(100, vars[i].value);
+        TEST_ASSERT_NULL(lv_anim_get(&vars[i], exec_cb));
+        TEST_ASSERT_NOT_NULL(lv_anim_get(&vars[i], exec2_cb));
+    }
+
+    /*The memory of the pool is freed when the last one is ready*/
+    run(1000);
+    TEST_ASSERT_EQUAL(0, lv_anim_count_running());
+    TEST_ASSERT_NULL(LV_GC_ROOT(_lv_anim_pool).chunks);
+    TEST_ASSERT_NULL(LV_GC_ROOT(_lv_anim_pool).buckets);
+}
+
+#endif
@@ -0,0 +1,75 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static uint32_t diff_size(const lv_area_t * res, int8_t res_c)
+{
+    uint32_t size = 0;
+    int8_t i;
+    for(i = 0; i < res_c; i++) size += lv_area_get_size(&res[i]);
+    return size;
+}
+
+void test_area_diff_should_return_minus_one_if_no_common_parts(void)
+{
+    lv_area_t res[4];
+    lv_area_t a1 = {0, 0, 9, 9};
+    lv_area_t a2 = {10, 0, 19, 9};
+
+    TEST_ASSERT_EQUAL_INT8(-1, _lv_area_diff(res, &a1, &a2));
+}
+
+void test_area_diff_should_return_zero_if_fully_covered(void)
+{
+    lv_area_t res[4];
+    lv_area_t a1 = {5, 5, 9, 9};
+    lv_area_t a2 = {0, 0, 19, 19};
+
+    TEST_ASSERT_EQUAL_INT8(0, _lv_area_diff(res, &a1, &a2));
+}
+
+void test_area_diff_should_not_overlap_the_removed_area(void)
+{
+    lv_area_t res[4];
+    lv_area_t a1 = {0, 0, 19, 19};
+    lv_area_t a2 = {5, 6, 14, 15};
+
+    int8_t res_c = _lv_area_diff(res, &a1, &a2);
+    TEST_ASSERT_EQUAL_INT8(4, res_c);
+
+    int8_t i;
+    for(i = 0; i < res_c; i++) {
+        TEST_ASSERT_FALSE(_lv_area_is_on(&res[i], &a2));
+        TEST_ASSERT_TRUE(_lv_area_is_in(&res[i], &a1, 0));
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&a1) - lv_area_get_size(&a2), diff_size(res, res_c));
+}
+
+void test_area_diff_should_keep_the_sides_of_a_single_row(void)
+{
+    lv_area_t res[4];
+    lv_area_t a1 = {0, 0, 19, 19};
+    lv_area_t a2 = {5, 10, 14, 10};
+
+    int8_t res_c = _lv_area_diff(res, &a1, &a2);
+    TEST_ASSERT_EQUAL_INT8(4, res_c);
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&a1) - lv_area_get_size(&a2), diff_size(res, res_c));
+}
+
+void test_area_diff_should_handle_partial_overlap(void)
+{
+    lv_area_t res[4];
+    lv_area_t a1 = {0, 0, 19, 19};
+    lv_area_t a2 = {10, -5, 30, 4};
+
+    int8_t res_c = _lv_area_diff(res, &a1, &a2);
+    TEST_ASSERT_EQUAL_INT8(2, res_c);
+
+    lv_area_t common;
+    _lv_area_intersect(&common, &a1, &a2);
+    TEST_ASSERT_EQUAL_UINT32(lv_area_get_size(&a1) - lv_area_get_size(&common), diff_size(res, res_c));
+}
+
+#endif
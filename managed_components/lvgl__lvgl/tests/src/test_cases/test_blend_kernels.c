@@ -0,0 +1,240 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#define ROW_MAX     67
+#define ITER_CNT    2000
+
+static lv_color_t dest_ref[ROW_MAX];
+static lv_color_t dest_act[ROW_MAX];
+static lv_color_t src_buf[ROW_MAX];
+static lv_opa_t mask_buf[ROW_MAX + 8];
+static uint8_t argb_buf[ROW_MAX * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+static uint32_t rnd_state;
+
+static uint32_t rnd(void)
+{
+    /*xorshift32, reproducible on every platform*/
+    rnd_state ^= rnd_state << 13;
+    rnd_state ^= rnd_state >> 17;
+    rnd_state ^= rnd_state << 5;
+    return rnd_state;
+}
+
+static lv_color_t rnd_color(void)
+{
+    lv_color_t c;
+    uint32_t v = rnd();
+#if LV_COLOR_DEPTH == 32
+    c.full = v | 0xFF000000;
+#else
+    c.full = v;
+#endif
+    return c;
+}
+
+/*Masks are mostly transparent or opaque with some anti-aliased pixels like in a real drawing*/
+static lv_opa_t rnd_opa(void)
+{
+    uint32_t v = rnd() % 8;
+    if(v < 2) return LV_OPA_TRANSP;
+    if(v < 5) return LV_OPA_COVER;
+    return rnd() & 0xFF;
+}
+
+static void rnd_buffers(int32_t len)
+{
+    int32_t i;
+    /*Repeat some colors to exercise the buffered results*/
+    lv_color_t bg = rnd_color();
+    for(i = 0; i < len; i++) {
+        dest_ref[i] = (rnd() % 3) ? bg : rnd_color();
+        dest_act[i] = dest_ref[i];
+        src_buf[i] = rnd_color();
+    }
+
+    for(i = 0; i < ROW_MAX + 8; i++) mask_buf[i] = rnd_opa();
+    for(i = 0; i < (int32_t)sizeof(argb_buf); i++) argb_buf[i] = rnd();
+}
+
+/*The per pixel blending of `lv_draw_sw_blend.c` before the kernels were introduced*/
+static void fill_opa_ref(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+#if LV_COLOR_MIX_ROUND_OFS == 0 && LV_COLOR_DEPTH == 16
+    opa = (uint32_t)((uint32_t)opa + 4) >> 3;
+    opa = opa << 3;
+#endif
+    uint16_t color_premult[3];
+    lv_color_premult(color, opa, color_premult);
+    int32_t x;
+    for(x = 0; x < len; x++) dest[x] = lv_color_mix_premult(color_premult, dest[x], 255 - opa);
+}
+
+static void fill_mask_ref(lv_color_t * dest, int32_t len, lv_color_t color, const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x] == LV_OPA_COVER) dest[x] = color;
+        else dest[x] = lv_color_mix(color, dest[x], mask[x]);
+    }
+}
+
+static void fill_mask_opa_ref(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa,
+                              const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x] == 0) continue;
+        lv_opa_t opa_tmp = mask[x] == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+        if(opa_tmp == LV_OPA_COVER) dest[x] = color;
+        else dest[x] = lv_color_mix(color, dest[x], opa_tmp);
+    }
+}
+
+static void map_opa_ref(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) dest[x] = lv_color_mix(src[x], dest[x], opa);
+}
+
+static void map_mask_ref(lv_color_t * dest, const lv_color_t * src, int32_t len, const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x] == 0) continue;
+        if(mask[x] == LV_OPA_COVER) dest[x] = src[x];
+        else dest[x] = lv_color_mix(src[x], dest[x], mask[x]);
+    }
+}
+
+static void map_mask_opa_ref(lv_color_t * dest, const lv_color_t * src, int32_t len, lv_opa_t opa,
+                             const lv_opa_t * mask)
+{
+    int32_t x;
+    for(x = 0; x < len; x++) {
+        if(mask[x] == 0) continue;
+        lv_opa_t opa_tmp = mask[x] >= LV_OPA_MAX ? opa : ((opa * mask[x]) >> 8);
+        dest[x] = lv_color_mix(src[x], dest[x], opa_tmp);
+    }
+}
+
+static void compare_kernels(const lv_draw_sw_blend_kernels_t * k)
+{
+    rnd_state = 0x12345678;
+
+    uint32_t i;
+    for(i = 0; i < ITER_CNT; i++) {
+        int32_t len = 1 + rnd() % ROW_MAX;
+        /*Misaligned masks too*/
+        const lv_opa_t * mask = &mask_buf[rnd() % 8];
+        lv_color_t color = rnd_color();
+        lv_opa_t opa = rnd() & 0xFF;
+
+        rnd_buffers(len);
+        switch(i % 6) {
+            case 0:
+                if(opa >= LV_OPA_MAX) opa = LV_OPA_MAX - 1;
+                fill_opa_ref(dest_ref, len, color, opa);
+                k->fill_opa(dest_act, len, color, opa);
+                break;
+            case 1:
+                fill_mask_ref(dest_ref, len, color, mask);
+                k->fill_mask(dest_act, len, color, mask);
+                break;
+            case 2:
+                if(opa >= LV_OPA_MAX) opa = LV_OPA_MAX - 1;
+                fill_mask_opa_ref(dest_ref, len, color, opa, mask);
+                k->fill_mask_opa(dest_act, len, color, opa, mask);
+                break;
+            case 3:
+                if(opa >= LV_OPA_MAX) opa = LV_OPA_MAX - 1;
+                map_opa_ref(dest_ref, src_buf, len, opa);
+                k->map_opa(dest_act, src_buf, len, opa);
+                break;
+            case 4:
+                map_mask_ref(dest_ref, src_buf, len, mask);
+                k->map_mask(dest_act, src_buf, len, mask);
+                break;
+            case 5:
+                if(opa > LV_OPA_MAX) opa = LV_OPA_MAX;
+                map_mask_opa_ref(dest_ref, src_buf, len, opa, mask);
+                k->map_mask_opa(dest_act, src_buf, len, opa, mask);
+                break;
+        }
+
+        TEST_ASSERT_EQUAL_MEMORY(dest_ref, dest_act, len * sizeof(lv_color_t));
+    }
+}
+
+void test_blend_kernels_scalar_matches_reference(void)
+{
+    compare_kernels(&lv_draw_sw_blend_kernels_scalar);
+}
+
+void test_blend_kernels_swar_matches_reference(void)
+{
+#if LV_DRAW_SW_BLEND_SWAR
+    compare_kernels(&lv_draw_sw_blend_kernels_swar);
+#else
+    TEST_IGNORE_MESSAGE("Only with LV_COLOR_DEPTH 16");
+#endif
+}
+
+void test_blend_kernels_sse2_matches_reference(void)
+{
+#if LV_DRAW_SW_BLEND_SSE2
+    compare_kernels(&lv_draw_sw_blend_kernels_sse2);
+#else
+    TEST_IGNORE_MESSAGE("Only with LV_COLOR_DEPTH 16 on SSE2 hosts");
+#endif
+}
+
+void test_blend_kernels_argb_split(void)
+{
+    const lv_draw_sw_blend_kernels_t * k = lv_draw_sw_blend_get_kernels();
+    lv_opa_t abuf[ROW_MAX];
+
+    rnd_state = 0x9abcdef0;
+    rnd_buffers(ROW_MAX);
+    k->argb_split(dest_act, abuf, argb_buf, ROW_MAX);
+
+    int32_t x;
+    for(x = 0; x < ROW_MAX; x++) {
+        const uint8_t * px = &argb_buf[x * LV_IMG_PX_SIZE_ALPHA_BYTE];
+        TEST_ASSERT_EQUAL_UINT8(px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1], abuf[x]);
+        TEST_ASSERT_EQUAL_MEMORY(px, &dest_act[x], LV_IMG_PX_SIZE_ALPHA_BYTE - 1);
+    }
+}
+
+static uint32_t cnt_fill_opa;
+
+static void fill_opa_counted(lv_color_t * dest, int32_t len, lv_color_t color, lv_opa_t opa)
+{
+    cnt_fill_opa += len;
+    lv_draw_sw_blend_kernels_scalar.fill_opa(dest, len, color, opa);
+}
+
+void test_blend_kernels_can_be_replaced(void)
+{
+    lv_draw_sw_blend_kernels_t k = *lv_draw_sw_blend_get_kernels();
+    k.fill_opa = fill_opa_counted;
+    lv_draw_sw_blend_set_kernels(&k);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 100, 50);
+    lv_obj_set_style_radius(obj, 0, 0);
+    lv_obj_set_style_border_width(obj, 0, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_50, 0);
+
+    cnt_fill_opa = 0;
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(100 * 50, cnt_fill_opa);
+
+    lv_draw_sw_blend_set_kernels(NULL);
+    lv_obj_del(obj);
+}
+
+#endif
@@ -0,0 +1,277 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/core/lv_cmd_queue.h"
+
+#include "unity/unity.h"
+
+#if LV_CMD_QUEUE_LEN
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+#define PRODUCER_CNT    4
+#define POST_CNT        2000
+
+static lv_obj_t * bars[PRODUCER_CNT];
+static lv_obj_t * labels[PRODUCER_CNT];
+static int32_t last_values[PRODUCER_CNT];
+static uint32_t last_texts[PRODUCER_CNT];
+static uint32_t value_cb_cnt;
+static volatile uint32_t producers_running;
+
+void setUp(void)
+{
+    _lv_cmd_queue_drain();
+    lv_cmd_queue_reset_stats();
+    value_cb_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+static lv_cmd_queue_stats_t get_stats(void)
+{
+    lv_cmd_queue_stats_t stats;
+    lv_cmd_queue_get_stats(&stats);
+    return stats;
+}
+
+static void bar_value_cb(lv_obj_t * obj, int32_t value)
+{
+    value_cb_cnt++;
+    lv_bar_set_value(obj, value, LV_ANIM_OFF);
+}
+
+/*Check that the values of a producer are applied in order*/
+static void ordered_value_cb(lv_obj_t * obj, int32_t value)
+{
+    uint32_t i;
+    for(i = 0; i < PRODUCER_CNT; i++) {
+        if(bars[i] == obj) break;
+    }
+    TEST_ASSERT_LESS_THAN(PRODUCER_CNT, i);
+    TEST_ASSERT_GREATER_THAN(last_values[i], value);
+    last_values[i] = value;
+    value_cb_cnt++;
+}
+
+static void * producer_main(void * arg)
+{
+    uint32_t id = (uintptr_t)arg;
+    char buf[LV_CMD_QUEUE_TEXT_LEN];
+    uint32_t i;
+    for(i = 1; i <= POST_CNT; i++) {
+        while(!lv_cmd_queue_post_value(bars[id], ordered_value_cb, i)) sched_yield();
+
+        lv_snprintf(buf, sizeof(buf), "p%d-%d", (int)id, (int)i);
+        while(!lv_cmd_queue_post_text(labels[id], buf)) sched_yield();
+    }
+    __atomic_fetch_sub(&producers_running, 1, __ATOMIC_RELEASE);
+    return NULL;
+}
+
+/*Verify that a label shows a whole text of its producer and not older than the previous one*/
+static void check_label(uint32_t id)
+{
+    const char * txt = lv_label_get_text(labels[id]);
+    if(txt[0] == '\0') return;
+
+    int producer = -1;
+    int n = -1;
+    TEST_ASSERT_EQUAL(2, sscanf(txt, "p%d-%d", &producer, &n));
+    TEST_ASSERT_EQUAL(id, producer);
+    TEST_ASSERT_GREATER_OR_EQUAL(last_texts[id], n);
+    last_texts[id] = n;
+}
+
+void test_latest_text_is_applied(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, "first"));
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, "second"));
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, "third"));
+
+    /*Nothing changes until the LVGL thread drains the queue*/
+    TEST_ASSERT_EQUAL_STRING("Text", lv_label_get_text(label));
+
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING("third", lv_label_get_text(label));
+
+    lv_cmd_queue_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(3, stats.posted);
+    TEST_ASSERT_EQUAL(1, stats.applied);
+    TEST_ASSERT_EQUAL(2, stats.coalesced);
+    TEST_ASSERT_EQUAL(1, stats.batches);
+}
+
+void test_too_long_text_is_rejected(void)
+{
+    char txt[LV_CMD_QUEUE_TEXT_LEN + 1];
+    lv_memset(txt, 'a', sizeof(txt) - 1);
+    txt[sizeof(txt) - 1] = '\0';
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    TEST_ASSERT_FALSE(lv_cmd_queue_post_text(label, txt));
+
+    txt[LV_CMD_QUEUE_TEXT_LEN - 1] = '\0';
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, txt));
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_STRING(txt, lv_label_get_text(label));
+}
+
+void test_different_properties_are_not_coalesced(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_style_value_t v;
+
+    v.color = lv_palette_main(LV_PALETTE_RED);
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_style(obj, LV_STYLE_BG_COLOR, v, LV_PART_MAIN));
+    v.color = lv_palette_main(LV_PALETTE_BLUE);
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_style(obj, LV_STYLE_BG_COLOR, v, LV_PART_MAIN | LV_STATE_PRESSED));
+    v.num = 7;
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_style(obj, LV_STYLE_PAD_TOP, v, LV_PART_MAIN));
+    v.num = 9;
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_style(obj, LV_STYLE_PAD_TOP, v, LV_PART_MAIN));
+
+    lv_obj_t * bar = lv_bar_create(lv_scr_act());
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_value(bar, bar_value_cb, 30));
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_value(bar, bar_value_cb, 40));
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_RED), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    lv_obj_add_state(obj, LV_STATE_PRESSED);
+    TEST_ASSERT_EQUAL_COLOR(lv_palette_main(LV_PALETTE_BLUE), lv_obj_get_style_bg_color(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(9, lv_obj_get_style_pad_top(obj, LV_PART_MAIN));
+    TEST_ASSERT_EQUAL(40, lv_bar_get_value(bar));
+    TEST_ASSERT_EQUAL(1, value_cb_cnt);
+
+    lv_cmd_queue_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(4, stats.applied);
+    TEST_ASSERT_EQUAL(2, stats.coalesced);
+}
+
+void test_commands_of_deleted_objects_are_skipped(void)
+{
+    lv_obj_t * bar = lv_bar_create(lv_scr_act());
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_value(bar, bar_value_cb, 10));
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, "gone"));
+    lv_obj_del(bar);
+    lv_obj_del(label);
+
+    lv_timer_handler();
+
+    TEST_ASSERT_EQUAL(0, value_cb_cnt);
+    lv_cmd_queue_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(0, stats.applied);
+    TEST_ASSERT_EQUAL(2, stats.invalid);
+}
+
+void test_full_queue_drops_the_command(void)
+{
+    lv_obj_t * bar = lv_bar_create(lv_scr_act());
+    uint32_t i;
+    for(i = 0; i < LV_CMD_QUEUE_LEN; i++) {
+        TEST_ASSERT_TRUE(lv_cmd_queue_post_value(bar, bar_value_cb, i));
+    }
+    TEST_ASSERT_FALSE(lv_cmd_queue_post_value(bar, bar_value_cb, 100));
+    TEST_ASSERT_EQUAL(1, get_stats().dropped);
+
+    /*The slots are reusable after draining*/
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(LV_CMD_QUEUE_LEN - 1, lv_bar_get_value(bar));
+    TEST_ASSERT_TRUE(lv_cmd_queue_post_value(bar, bar_value_cb, 50));
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(50, lv_bar_get_value(bar));
+}
+
+void test_producer_threads(void)
+{
+    pthread_t threads[PRODUCER_CNT];
+    uint32_t i;
+    for(i = 0; i < PRODUCER_CNT; i++) {
+        bars[i] = lv_bar_create(lv_scr_act());
+        labels[i] = lv_label_create(lv_scr_act());
+        lv_label_set_text(labels[i], "");
+        last_values[i] = 0;
+        last_texts[i] = 0;
+    }
+
+    producers_running = PRODUCER_CNT;
+    for(i = 0; i < PRODUCER_CNT; i++) {
+        TEST_ASSERT_EQUAL(0, pthread_create(&threads[i], NULL, producer_main, (void *)(uintptr_t)i));
+    }
+
+    /*Drain while posting, then once more for the commands posted after the last check*/
+    while(__atomic_load_n(&producers_running, __ATOMIC_ACQUIRE)) {
+        _lv_cmd_queue_drain();
+        for(i = 0; i < PRODUCER_CNT; i++) check_label(i);
+    }
+    _lv_cmd_queue_drain();
+
+    for(i = 0; i < PRODUCER_CNT; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    /*The latest value of every producer is applied and nothing is lost*/
+    char buf[LV_CMD_QUEUE_TEXT_LEN];
+    for(i = 0; i < PRODUCER_CNT; i++) {
+        TEST_ASSERT_EQUAL(POST_CNT, last_values[i]);
+        lv_snprintf(buf, sizeof(buf), "p%d-%d", (int)i, POST_CNT);
+        TEST_ASSERT_EQUAL_STRING(buf, lv_label_get_text(labels[i]));
+    }
+
+    lv_cmd_queue_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL(PRODUCER_CNT * POST_CNT * 2, stats.posted);
+    TEST_ASSERT_EQUAL(stats.posted, stats.applied + stats.coalesced);
+    TEST_ASSERT_EQUAL(0, stats.invalid);
+    TEST_ASSERT_EQUAL(0, _lv_cmd_queue_drain());
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_latest_text_is_applied(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+void test_too_long_text_is_rejected(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+void test_different_properties_are_not_coalesced(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+void test_commands_of_deleted_objects_are_skipped(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+void test_full_queue_drops_the_command(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+void test_producer_threads(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+}
+
+#endif
+
+#endif
@@ -15,6 +15,9 @@ static void loop_through_stress_test(void)
 }
 void test_demo_stress(void)
 {
+    /*The cached glyphs are allocated between the objects of the first loop
+     *and change how the freed blocks are merged. Measure the objects only.*/
+    lv_glyph_cache_set_budget(0);
 #if LV_USE_DEMO_STRESS
     lv_demo_stress();
 #endif
@@ -26,6 +29,7 @@ void test_demo_stress(void)
         loop_through_stress_test();
     }
     TEST_ASSERT_EQUAL(mem_before, lv_test_get_free_mem());
+    lv_glyph_cache_set_budget(LV_GLYPH_CACHE_DEF_BUDGET);
 }
 
 #endif
@@ -0,0 +1,342 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/draw/sw/lv_draw_sw.h"
+
+#include "unity/unity.h"
+
+#if LV_DRAW_SW_BANDS > 1
+
+#include <pthread.h>
+
+#define HOR_RES     800
+#define VER_RES     480
+#define ARGB_W      64
+#define RGB_W       200
+#define RGB_H       100
+#define WORKER_QUEUE_LEN    (LV_DRAW_SW_BANDS - 1)
+
+extern lv_color_t test_fb[];
+
+static lv_color_t ref_fb[HOR_RES * VER_RES];
+static uint8_t argb_px[ARGB_W * ARGB_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_img_dsc_t argb_dsc;
+static lv_color_t rgb_px[RGB_W * RGB_H];
+static lv_img_dsc_t rgb_dsc;
+
+/*A worker thread drawing the submitted bands in order*/
+static pthread_t worker_thread;
+static pthread_mutex_t worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worker_cond = PTHREAD_COND_INITIALIZER;
+static lv_draw_sw_bands_job_t * worker_queue[WORKER_QUEUE_LEN];
+static uint32_t worker_queue_cnt;
+static bool worker_quit;
+
+static void * worker_main(void * arg)
+{
+    LV_UNUSED(arg);
+    pthread_mutex_lock(&worker_mutex);
+    while(true) {
+        while(worker_queue_cnt == 0 && !worker_quit) pthread_cond_wait(&worker_cond, &worker_mutex);
+        if(worker_queue_cnt == 0) break;
+
+        lv_draw_sw_bands_job_t * job = worker_queue[0];
+        worker_queue_cnt--;
+        lv_memcpy(worker_queue, worker_queue + 1, worker_queue_cnt * sizeof(worker_queue[0]));
+        pthread_mutex_unlock(&worker_mutex);
+
+        lv_draw_sw_bands_job_run(job);
+
+        pthread_mutex_lock(&worker_mutex);
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return NULL;
+}
+
+static bool worker_submit(lv_draw_sw_bands_job_t * job)
+{
+    pthread_mutex_lock(&worker_mutex);
+    bool ok = worker_queue_cnt < WORKER_QUEUE_LEN;
+    if(ok) {
+        worker_queue[worker_queue_cnt] = job;
+        worker_queue_cnt++;
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return ok;
+}
+
+static void worker_wait(lv_draw_sw_bands_job_t * job)
+{
+    /*The mutex makes the pixels of the worker visible*/
+    pthread_mutex_lock(&worker_mutex);
+    while(!job->done) pthread_cond_wait(&worker_cond, &worker_mutex);
+    pthread_mutex_unlock(&worker_mutex);
+}
+
+static bool worker_reject(lv_draw_sw_bands_job_t * job)
+{
+    LV_UNUSED(job);
+    return false;
+}
+
+static void worker_start(void)
+{
+    worker_quit = false;
+    TEST_ASSERT_EQUAL(0, pthread_create(&worker_thread, NULL, worker_main, NULL));
+    lv_draw_sw_bands_set_worker(worker_submit, worker_wait);
+}
+
+static void worker_stop(void)
+{
+    lv_draw_sw_bands_set_worker(NULL, NULL);
+    pthread_mutex_lock(&worker_mutex);
+    worker_quit = true;
+    pthread_cond_broadcast(&worker_cond);
+    pthread_mutex_unlock(&worker_mutex);
+    pthread_join(worker_thread, NULL);
+}
+
+static lv_draw_sw_bands_stats_t get_stats(void)
+{
+    lv_draw_sw_bands_stats_t stats;
+    lv_draw_sw_bands_get_stats(&stats);
+    return stats;
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/*Render the screen in the LVGL thread only, then with the worker and compare the frames*/
+static void assert_same_with_worker(void)
+{
+    refresh();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_bands_reset_stats();
+    worker_start();
+    refresh();
+    worker_stop();
+
+    TEST_ASSERT_GREATER_THAN(0, get_stats().worker_bands);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+static void create_images(void)
+{
+    uint32_t x, y;
+    uint8_t * px = argb_px;
+    for(y = 0; y < ARGB_W; y++) {
+        for(x = 0; x < ARGB_W; x++) {
+            lv_color_t c = lv_color_make(x * 4, y * 4, 255 - x * 2);
+            lv_memcpy(px, &c, sizeof(lv_color_t));
+            px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1] = (x + y) * 2;
+            px += LV_IMG_PX_SIZE_ALPHA_BYTE;
+        }
+    }
+
+    argb_dsc.header.always_zero = 0;
+    argb_dsc.header.cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    argb_dsc.header.w = ARGB_W;
+    argb_dsc.header.h = ARGB_W;
+    argb_dsc.data_size = sizeof(argb_px);
+    argb_dsc.data = argb_px;
+
+    for(y = 0; y < RGB_H; y++) {
+        for(x = 0; x < RGB_W; x++) {
+            rgb_px[y * RGB_W + x] = lv_color_make(x, y * 2, (x * y) & 0xff);
+        }
+    }
+
+    rgb_dsc.header.always_zero = 0;
+    rgb_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    rgb_dsc.header.w = RGB_W;
+    rgb_dsc.header.h = RGB_H;
+    rgb_dsc.data_size = sizeof(rgb_px);
+    rgb_dsc.data = (const uint8_t *)rgb_px;
+}
+
+void setUp(void)
+{
+    create_images();
+    lv_obj_clean(lv_scr_act());
+}
+
+void tearDown(void)
+{
+    lv_disp_get_default()->driver->antialiasing = 1;
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_fills_are_the_same_in_bands(void)
+{
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_main(LV_PALETTE_BLUE_GREY), 0);
+
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 500, 400);
+    lv_obj_set_style_radius(obj, 40, 0);
+    lv_obj_set_style_bg_opa(obj, LV_OPA_60, 0);
+    lv_obj_set_style_border_width(obj, 7, 0);
+
+    obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 300, 300);
+    lv_obj_align(obj, LV_ALIGN_RIGHT_MID, 0, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_obj_set_style_bg_grad_color(obj, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_set_style_bg_grad_dir(obj, LV_GRAD_DIR_VER, 0);
+
+    obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 400, 200);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_LEFT, 0, 0);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_ORANGE), 0);
+    lv_obj_set_style_blend_mode(obj, LV_BLEND_MODE_ADDITIVE, 0);
+
+    assert_same_with_worker();
+
+    /*The masks are rounded to opaque and transparent pixels for every band*/
+    lv_disp_get_default()->driver->antialiasing = 0;
+    assert_same_with_worker();
+}
+
+void test_images_are_the_same_in_bands(void)
+{
+    /*Copied as it is*/
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &rgb_dsc);
+
+    /*Zoomed and rotated with alpha*/
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &argb_dsc);
+    lv_img_set_zoom(img, 1024);
+    lv_img_set_angle(img, 300);
+    lv_obj_align(img, LV_ALIGN_CENTER, 0, 0);
+
+    /*Recolored and tiled*/
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &argb_dsc);
+    lv_obj_set_size(img, 300, 200);
+    lv_obj_align(img, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_obj_set_style_img_recolor(img, lv_palette_main(LV_PALETTE_PURPLE), 0);
+    lv_obj_set_style_img_recolor_opa(img, LV_OPA_40, 0);
+
+    /*Masked by the rounded corner of the parent*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 260, 260);
+    lv_obj_align(cont, LV_ALIGN_TOP_RIGHT, 0, 0);
+    lv_obj_set_style_radius(cont, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    img = lv_img_create(cont);
+    lv_img_set_src(img, &rgb_dsc);
+    lv_img_set_zoom(img, 700);
+    lv_obj_center(img);
+
+    assert_same_with_worker();
+
+    lv_disp_get_default()->driver->antialiasing = 0;
+    assert_same_with_worker();
+}
+
+void test_layers_are_the_same_in_bands(void)
+{
+    /*Simple layer*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 400, 300);
+    lv_obj_set_style_opa(obj, LV_OPA_50, 0);
+    lv_obj_t * img = lv_img_create(obj);
+    lv_img_set_src(img, &rgb_dsc);
+
+    /*Layer with a rounded child and a label*/
+    obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 300, 250);
+    lv_obj_align(obj, LV_ALIGN_BOTTOM_RIGHT, -50, -50);
+    lv_obj_set_style_bg_color(obj, lv_palette_main(LV_PALETTE_TEAL), 0);
+    lv_obj_set_style_opa(obj, LV_OPA_70, 0);
+    lv_obj_t * child = lv_obj_create(obj);
+    lv_obj_set_size(child, 200, 150);
+    lv_obj_set_style_radius(child, 50, 0);
+    lv_obj_t * label = lv_label_create(child);
+    lv_label_set_text(label, "Bands");
+
+    assert_same_with_worker();
+}
+
+void test_rejected_bands_are_drawn_by_the_lvgl_thread(void)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &argb_dsc);
+    lv_img_set_zoom(img, 2048);
+    lv_obj_center(img);
+
+    refresh();
+    lv_memcpy(ref_fb, test_fb, sizeof(ref_fb));
+
+    lv_draw_sw_bands_reset_stats();
+    lv_draw_sw_bands_set_worker(worker_reject, NULL);
+    refresh();
+    lv_draw_sw_bands_set_worker(NULL, NULL);
+
+    lv_draw_sw_bands_stats_t stats = get_stats();
+    TEST_ASSERT_GREATER_THAN(0, stats.split);
+    TEST_ASSERT_EQUAL(0, stats.worker_bands);
+    TEST_ASSERT_GREATER_THAN(0, stats.rejected);
+    TEST_ASSERT_EQUAL_MEMORY(ref_fb, test_fb, sizeof(ref_fb));
+}
+
+void test_small_areas_are_not_split(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(obj, 20, 20);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_palette_main(LV_PALETTE_RED), 0);
+    refresh();
+
+    lv_draw_sw_bands_reset_stats();
+    lv_draw_sw_bands_set_worker(worker_reject, NULL);
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    lv_draw_sw_bands_set_worker(NULL, NULL);
+
+    TEST_ASSERT_EQUAL(0, get_stats().split);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_fills_are_the_same_in_bands(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_DRAW_SW_BANDS > 1");
+}
+
+void test_images_are_the_same_in_bands(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_DRAW_SW_BANDS > 1");
+}
+
+void test_layers_are_the_same_in_bands(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_DRAW_SW_BANDS > 1");
+}
+
+void test_rejected_bands_are_drawn_by_the_lvgl_thread(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_DRAW_SW_BANDS > 1");
+}
+
+void test_small_areas_are_not_split(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_DRAW_SW_BANDS > 1");
+}
+
+#endif
+
+#endif
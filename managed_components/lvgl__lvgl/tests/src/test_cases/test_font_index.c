@@ -0,0 +1,165 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_helpers.h"
+
+#define CHUNK_SIZE  4096
+
+typedef struct {
+    uint32_t bitmap_hash;
+    uint16_t adv_w;
+    bool found;
+} lookup_t;
+
+static lookup_t ref[CHUNK_SIZE];
+
+/*The bitmap of a letter identifies its glyph. Its content is compared because the compressed
+ *bitmaps are returned from the glyph cache, and the cache can move them.
+ *The kerning with the next letter needs the glyph ID of that letter too.*/
+static void lookup(const lv_font_t * font, uint32_t letter, lookup_t * res)
+{
+    lv_font_glyph_dsc_t g;
+    res->found = lv_font_get_glyph_dsc(font, &g, letter, 'A');
+    res->adv_w = res->found ? g.adv_w : 0;
+    res->bitmap_hash = 0;
+
+    const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, letter);
+    if(bitmap == NULL) return;
+
+    uint32_t size = res->found ? (g.box_w * g.box_h * g.bpp + 7) / 8 : 0;
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) hash = (hash ^ bitmap[i]) * 16777619u;
+    res->bitmap_hash = hash | 1;    /*Not 0 even without pixels as there is a bitmap*/
+}
+
+/*Look up every letter of the first two planes with and without index*/
+static void check_same_glyphs(const lv_font_t * font, lv_font_fmt_txt_index_mode_t mode)
+{
+    uint32_t start;
+    uint32_t i;
+    uint32_t found_cnt = 0;
+    for(start = 0; start < 0x20000; start += CHUNK_SIZE) {
+        lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_NONE);
+        for(i = 0; i < CHUNK_SIZE; i++) lookup(font, start + i, &ref[i]);
+
+        lv_font_fmt_txt_set_index_mode(mode);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_font_fmt_txt_build_index(font));
+        for(i = 0; i < CHUNK_SIZE; i++) {
+            lookup_t res;
+            lookup(font, start + i, &res);
+            TEST_ASSERT_EQUAL_MESSAGE(ref[i].found, res.found, "found");
+            TEST_ASSERT_EQUAL_MESSAGE(ref[i].adv_w, res.adv_w, "adv_w");
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(ref[i].bitmap_hash, res.bitmap_hash, "bitmap");
+            if(res.found) found_cnt++;
+        }
+    }
+
+    TEST_ASSERT_GREATER_THAN_UINT32(0, found_cnt);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX);
+}
+
+void test_font_index_finds_the_same_glyphs(void)
+{
+    check_same_glyphs(&lv_font_montserrat_14, LV_FONT_FMT_TXT_INDEX_HASH);
+    check_same_glyphs(&lv_font_montserrat_14, LV_FONT_FMT_TXT_INDEX_PAGES);
+
+#if LV_USE_FS_STDIO
+    /*The index of the loaded fonts is built in their cache*/
+    const char * paths[] = {"A:src/test_fonts/font_1.fnt", "A:src/test_fonts/font_2.fnt"};
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        lv_font_t * font = lv_font_load(paths[i]);
+        TEST_ASSERT_NOT_NULL(font);
+        check_same_glyphs(font, LV_FONT_FMT_TXT_INDEX_HASH);
+        check_same_glyphs(font, LV_FONT_FMT_TXT_INDEX_PAGES);
+        lv_font_free(font);
+    }
+#endif
+
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    check_same_glyphs(&lv_font_dejavu_16_persian_hebrew, LV_FONT_FMT_TXT_INDEX_PAGES);
+#endif
+
+#if LV_FONT_SIMSUN_16_CJK
+    /*Uses the index generated into the font*/
+    check_same_glyphs(&lv_font_simsun_16_cjk, LV_FONT_FMT_TXT_INDEX_PAGES);
+#endif
+}
+
+void test_font_index_modes(void)
+{
+    const lv_font_t * font = &lv_font_montserrat_14;
+
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_NONE);
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_font_fmt_txt_build_index(font));
+    TEST_ASSERT_EQUAL_UINT32(0, lv_font_fmt_txt_get_index_size(font));
+
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_HASH);
+    TEST_ASSERT_EQUAL(LV_FONT_FMT_TXT_INDEX_HASH, lv_font_fmt_txt_get_index_mode());
+    uint32_t hash_size = lv_font_fmt_txt_get_index_size(font);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, hash_size);
+
+    /*The ASCII letters aren't indexed and the symbols are too sparse for a page*/
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_PAGES);
+    uint32_t pages_size = lv_font_fmt_txt_get_index_size(font);
+    TEST_ASSERT_EQUAL_UINT32(hash_size, pages_size);
+
+    /*Built again after freeing it*/
+    lv_font_fmt_txt_free_index(font);
+    TEST_ASSERT_EQUAL_UINT32(pages_size, lv_font_fmt_txt_get_index_size(font));
+
+#if LV_FONT_DEJAVU_16_PERSIAN_HEBREW
+    /*The Arabic and Hebrew blocks are dense enough to be smaller on pages than in the hash table*/
+    font = &lv_font_dejavu_16_persian_hebrew;
+    pages_size = lv_font_fmt_txt_get_index_size(font);
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_HASH);
+    hash_size = lv_font_fmt_txt_get_index_size(font);
+    TEST_ASSERT_LESS_THAN_UINT32(hash_size, pages_size);
+#endif
+
+#if LV_FONT_SIMSUN_16_CJK
+    /*The generated index is used in any mode except NONE*/
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_HASH);
+    const lv_font_fmt_txt_dsc_t * fdsc = lv_font_simsun_16_cjk.dsc;
+    TEST_ASSERT_NOT_NULL(fdsc->index);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, lv_font_fmt_txt_get_index_size(&lv_font_simsun_16_cjk));
+    TEST_ASSERT_NULL(fdsc->cache->index);
+#endif
+}
+
+void test_font_index_of_loaded_font_is_freed(void)
+{
+#if LV_USE_FS_STDIO
+    lv_mem_monitor_t m1;
+    lv_mem_monitor(&m1);
+
+    lv_font_fmt_txt_set_index_mode(LV_FONT_FMT_TXT_INDEX_PAGES);
+    lv_font_t * font = lv_font_load("A:src/test_fonts/font_1.fnt");
+    TEST_ASSERT_NOT_NULL(font);
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_font_fmt_txt_build_index(font));
+
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, 'A', 'V'));
+    TEST_ASSERT_FALSE(lv_font_get_glyph_dsc(font, &g, 0x4E2D, '\0'));
+
+    lv_font_free(font);
+
+    lv_mem_monitor_t m2;
+    lv_mem_monitor(&m2);
+    LV_HEAP_CHECK(TEST_ASSERT_EQUAL_UINT32(m1.free_size, m2.free_size));
+#else
+    TEST_IGNORE_MESSAGE("Needs the stdio file system driver");
+#endif
+}
+
+#endif
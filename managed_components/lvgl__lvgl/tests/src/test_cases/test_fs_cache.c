@@ -0,0 +1,467 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_FS_CACHE_DEF_BUDGET && LV_USE_PNG && LV_USE_SJPG && LV_USE_GIF
+
+#include <stdio.h>
+
+#define BUDGET          32768
+
+/*The assets of the application. `test.png` is a JPEG in fact, it's copied to a .jpg file for SJPG*/
+#define PNG_PATH        "C:../../../qr_data/wink.png"
+#define JPG_SRC_PATH    "C:../../../qr_data/test.png"
+#define GIF_PATH        "C:../../../qr_data/giphy.gif"
+#define JPG_PATH        "C:/tmp/lv_test_fs_cache.jpg"
+#define TMP_PATH        "C:/tmp/lv_test_fs_cache.bin"
+
+#define GIF_FRAMES      10
+
+/*A stdio driver counting the calls which reach it*/
+static lv_fs_drv_t counter_drv;
+static uint32_t drv_read_cnt;
+static uint32_t drv_seek_cnt;
+
+static uint32_t mem_alloc_cnt;
+static uint32_t mem_free_cnt;
+
+static void * counter_open(lv_fs_drv_t * drv, const char * path, lv_fs_mode_t mode)
+{
+    LV_UNUSED(drv);
+    const char * flags = "";
+    if(mode == LV_FS_MODE_WR) flags = "wb";
+    else if(mode == LV_FS_MODE_RD) flags = "rb";
+    else if(mode == (LV_FS_MODE_WR | LV_FS_MODE_RD)) flags = "rb+";
+    return fopen(path, flags);
+}
+
+static lv_fs_res_t counter_close(lv_fs_drv_t * drv, void * file_p)
+{
+    LV_UNUSED(drv);
+    fclose(file_p);
+    return LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counter_read(lv_fs_drv_t * drv, void * file_p, void * buf, uint32_t btr, uint32_t * br)
+{
+    LV_UNUSED(drv);
+    drv_read_cnt++;
+    *br = fread(buf, 1, btr, file_p);
+    return ferror(file_p) ? LV_FS_RES_UNKNOWN : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counter_write(lv_fs_drv_t * drv, void * file_p, const void * buf, uint32_t btw, uint32_t * bw)
+{
+    LV_UNUSED(drv);
+    *bw = fwrite(buf, 1, btw, file_p);
+    return ferror(file_p) ? LV_FS_RES_UNKNOWN : LV_FS_RES_OK;
+}
+
+static lv_fs_res_t counter_seek(lv_fs_drv_t * drv, void * file_p, uint32_t pos, lv_fs_whence_t whence)
+{
+    LV_UNUSED(drv);
+    drv_seek_cnt++;
+    int w = whence == LV_FS_SEEK_SET ? SEEK_SET : (whence == LV_FS_SEEK_CUR ? SEEK_CUR : SEEK_END);
+    return fseek(file_p, pos, w) == 0 ? LV_FS_RES_OK : LV_FS_RES_UNKNOWN;
+}
+
+static lv_fs_res_t counter_tell(lv_fs_drv_t * drv, void * file_p, uint32_t * pos_p)
+{
+    LV_UNUSED(drv);
+    *pos_p = ftell(file_p);
+    return LV_FS_RES_OK;
+}
+
+static void * mem_alloc(size_t size)
+{
+    mem_alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static void mem_free(void * p)
+{
+    mem_free_cnt++;
+    lv_mem_free(p);
+}
+
+static uint8_t * load_file(const char * path, uint32_t * size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, size));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_SET));
+
+    uint8_t * data = lv_mem_alloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, data, *size, &br));
+    TEST_ASSERT_EQUAL(*size, br);
+    lv_fs_close(&f);
+    return data;
+}
+
+static void save_file(const char * path, const uint8_t * data, uint32_t size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_WR));
+    uint32_t bw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, data, size, &bw));
+    TEST_ASSERT_EQUAL(size, bw);
+    lv_fs_close(&f);
+}
+
+static uint32_t hash_add(uint32_t hash, const uint8_t * p, uint32_t size)
+{
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*Decode an image without the image cache and return the FNV-1a hash of its pixels*/
+static uint32_t decode_img(const char * path)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, path, lv_color_black(), 0));
+
+    uint32_t w = dsc.header.w;
+    uint32_t h = dsc.header.h;
+    uint32_t px_size = lv_img_cf_get_px_size(dsc.header.cf) / 8;
+    if(px_size == 0) px_size = sizeof(lv_color_t);  /*SJPG decodes the raw JPEG to colors*/
+    uint32_t hash = 2166136261u;
+    if(dsc.img_data) {
+        hash = hash_add(hash, dsc.img_data, w * h * px_size);
+    }
+    else {
+        uint8_t * line = lv_mem_alloc(w * px_size);
+        uint32_t y;
+        for(y = 0; y < h; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, w, line));
+            hash = hash_add(hash, line, w * px_size);
+        }
+        lv_mem_free(line);
+    }
+
+    lv_img_decoder_close(&dsc);
+    return hash;
+}
+
+/*Render the first frames of a GIF and return the FNV-1a hash of them*/
+static uint32_t decode_gif(const char * path)
+{
+    gd_GIF * gif = gd_open_gif_file(path);
+    TEST_ASSERT_NOT_NULL(gif);
+
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < GIF_FRAMES; i++) {
+        TEST_ASSERT_EQUAL(1, gd_get_frame(gif));
+        gd_render_frame(gif, gif->canvas);
+        hash = hash_add(hash, gif->canvas, gif->width * gif->height * 4);
+    }
+    gd_close_gif(gif);
+    return hash;
+}
+
+static uint32_t decode(const char * path)
+{
+    return strcmp(lv_fs_get_ext(path), "gif") == 0 ? decode_gif(path) : decode_img(path);
+}
+
+void setUp(void)
+{
+    if(lv_fs_get_drv('C') == NULL) {
+        lv_fs_drv_init(&counter_drv);
+        counter_drv.letter = 'C';
+        counter_drv.block_cache = true;
+        counter_drv.open_cb = counter_open;
+        counter_drv.close_cb = counter_close;
+        counter_drv.read_cb = counter_read;
+        counter_drv.write_cb = counter_write;
+        counter_drv.seek_cb = counter_seek;
+        counter_drv.tell_cb = counter_tell;
+        lv_fs_drv_register(&counter_drv);
+
+        /*SJPG decodes only the files with .jpg extension*/
+        uint32_t size;
+        uint8_t * jpg = load_file(JPG_SRC_PATH, &size);
+        save_file(JPG_PATH, jpg, size);
+        lv_mem_free(jpg);
+    }
+
+    lv_fs_cache_set_budget(BUDGET);
+    lv_fs_cache_reset_stats();
+    drv_read_cnt = 0;
+    drv_seek_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_fs_cache_set_mem_cb(NULL, NULL);
+    lv_fs_cache_set_budget(LV_FS_CACHE_DEF_BUDGET);
+}
+
+void test_decoders_read_less_from_the_driver(void)
+{
+    const char * paths[] = {PNG_PATH, JPG_PATH, GIF_PATH};
+    uint32_t i;
+    for(i = 0; i < sizeof(paths) / sizeof(paths[0]); i++) {
+        /*Every read and seek reaches the driver without the block cache*/
+        lv_fs_cache_set_budget(0);
+        drv_read_cnt = 0;
+        drv_seek_cnt = 0;
+        uint32_t hash_direct = decode(paths[i]);
+        uint32_t read_direct = drv_read_cnt;
+        uint32_t seek_direct = drv_seek_cnt;
+
+        lv_fs_cache_set_budget(BUDGET);
+        lv_fs_cache_reset_stats();
+        drv_read_cnt = 0;
+        drv_seek_cnt = 0;
+        uint32_t hash_cached = decode(paths[i]);
+
+        lv_fs_cache_stats_t stats;
+        lv_fs_cache_get_stats(&stats);
+        printf("%s: %u reads, %u seeks without block cache; %u reads, %u seeks with it (%u hits, %u read ahead)\n",
+               paths[i], (unsigned)read_direct, (unsigned)seek_direct, (unsigned)drv_read_cnt, (unsigned)drv_seek_cnt,
+               (unsigned)stats.hits, (unsigned)stats.read_ahead);
+
+        TEST_ASSERT_EQUAL_UINT32(hash_direct, hash_cached);
+        TEST_ASSERT_EQUAL_UINT32(drv_read_cnt, stats.drv_reads);
+        /*A file finding the first blocks in the cache has to seek to the first missing one*/
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(read_direct + seek_direct, drv_read_cnt + drv_seek_cnt);
+    }
+
+    /*The GIF and JPEG decoders read a few bytes at a time*/
+    lv_fs_cache_set_budget(0);
+    drv_read_cnt = 0;
+    decode(GIF_PATH);
+    uint32_t gif_direct = drv_read_cnt;
+    lv_fs_cache_set_budget(BUDGET);
+    drv_read_cnt = 0;
+    decode(GIF_PATH);
+    TEST_ASSERT_LESS_THAN_UINT32(gif_direct / 10, drv_read_cnt);
+
+    lv_fs_cache_set_budget(0);
+    drv_read_cnt = 0;
+    decode(JPG_PATH);
+    uint32_t jpg_direct = drv_read_cnt;
+    lv_fs_cache_set_budget(BUDGET);
+    drv_read_cnt = 0;
+    decode(JPG_PATH);
+    TEST_ASSERT_LESS_THAN_UINT32(jpg_direct, drv_read_cnt);
+}
+
+void test_blocks_are_shared_across_opens(void)
+{
+    uint32_t size;
+    uint8_t * exp = load_file(PNG_PATH, &size);
+
+    /*The second file of the same path finds every block in the cache*/
+    lv_fs_file_t f1;
+    lv_fs_file_t f2;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f1, PNG_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f2, PNG_PATH, LV_FS_MODE_RD));
+
+    uint8_t buf[100];
+    uint32_t pos;
+    uint32_t br;
+    for(pos = 0; pos < size; pos += br) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f1, buf, sizeof(buf), &br));
+        TEST_ASSERT_EQUAL_UINT32(LV_MIN(sizeof(buf), size - pos), br);
+        TEST_ASSERT_EQUAL_MEMORY(exp + pos, buf, br);
+    }
+    uint32_t drv_reads = drv_read_cnt;
+
+    for(pos = 0; pos < size; pos += br) {
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f2, buf, sizeof(buf), &br));
+        TEST_ASSERT_EQUAL_UINT32(LV_MIN(sizeof(buf), size - pos), br);
+        TEST_ASSERT_EQUAL_MEMORY(exp + pos, buf, br);
+    }
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f2, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL_UINT32(0, br);
+    TEST_ASSERT_EQUAL_UINT32(drv_reads, drv_read_cnt);
+
+    lv_fs_close(&f1);
+    lv_fs_close(&f2);
+
+    /*The blocks stay cached after the files are closed*/
+    lv_fs_cache_stats_t stats;
+    lv_fs_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32((size + LV_FS_CACHE_BLOCK_SIZE - 1) / LV_FS_CACHE_BLOCK_SIZE, stats.block_cnt);
+
+    drv_seek_cnt = 0;
+    lv_fs_file_t f3;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f3, PNG_PATH, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f3, size - 10, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f3, buf, 10, &br));
+    TEST_ASSERT_EQUAL_MEMORY(exp + size - 10, buf, 10);
+    lv_fs_close(&f3);
+    TEST_ASSERT_EQUAL_UINT32(drv_reads, drv_read_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, drv_seek_cnt);
+
+    lv_fs_cache_invalidate(PNG_PATH);
+    lv_fs_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.block_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+
+    lv_mem_free(exp);
+}
+
+void test_random_reads_match_the_file(void)
+{
+    uint32_t size;
+    uint8_t * exp = load_file(JPG_PATH, &size);
+    lv_fs_cache_invalidate(NULL);
+
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, JPG_PATH, LV_FS_MODE_RD));
+
+    uint32_t end;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &end));
+    TEST_ASSERT_EQUAL_UINT32(size, end);
+
+    /*Small, block sized and large reads at random positions, also over the end of the file*/
+    uint32_t sizes[] = {1, 7, LV_FS_CACHE_BLOCK_SIZE, LV_FS_CACHE_BLOCK_SIZE + 3, 5 * LV_FS_CACHE_BLOCK_SIZE, 3000};
+    uint8_t * buf = lv_mem_alloc(5000);
+    uint32_t i;
+    for(i = 0; i < 500; i++) {
+        uint32_t pos = lv_rand(0, size + 10);
+        uint32_t btr = sizes[lv_rand(0, sizeof(sizes) / sizeof(sizes[0]) - 1)];
+        if(lv_rand(0, 3) == 0) {
+            /*Align to a block*/
+            pos -= pos % LV_FS_CACHE_BLOCK_SIZE;
+        }
+
+        uint32_t cur;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &cur));
+        if(lv_rand(0, 1)) TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos, LV_FS_SEEK_SET));
+        else TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, pos - cur, LV_FS_SEEK_CUR));
+
+        uint32_t br;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, buf, btr, &br));
+        uint32_t exp_br = pos < size ? LV_MIN(btr, size - pos) : 0;
+        TEST_ASSERT_EQUAL_UINT32(exp_br, br);
+        if(br) TEST_ASSERT_EQUAL_MEMORY(exp + pos, buf, br);
+
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, &cur));
+        TEST_ASSERT_EQUAL_UINT32(pos + br, cur);
+    }
+
+    lv_fs_close(&f);
+    lv_mem_free(buf);
+    lv_mem_free(exp);
+
+    lv_fs_cache_stats_t stats;
+    lv_fs_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(BUDGET, stats.size);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.hits);
+}
+
+void test_writes_invalidate_the_blocks(void)
+{
+    uint8_t data[2000];
+    uint32_t i;
+    for(i = 0; i < sizeof(data); i++) data[i] = i;
+    save_file(TMP_PATH, data, sizeof(data));
+
+    lv_fs_file_t fr;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fr, TMP_PATH, LV_FS_MODE_RD));
+    uint8_t buf[sizeof(data)];
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, 100, &br));
+    TEST_ASSERT_EQUAL_MEMORY(data, buf, 100);
+
+    /*Overwrite a part of the file while it's opened for reading*/
+    lv_fs_file_t fw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&fw, TMP_PATH, LV_FS_MODE_WR | LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fw, 50, LV_FS_SEEK_SET));
+    uint8_t new_data[100];
+    lv_memset(new_data, 0xAA, sizeof(new_data));
+    uint32_t bw;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&fw, new_data, sizeof(new_data), &bw));
+    lv_memcpy(data + 50, new_data, sizeof(new_data));
+
+    uint32_t pos;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&fw, &pos));
+    TEST_ASSERT_EQUAL_UINT32(150, pos);
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fw, buf, 10, &br));
+    TEST_ASSERT_EQUAL_MEMORY(data + 150, buf, 10);
+    lv_fs_close(&fw);
+
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&fr, 0, LV_FS_SEEK_SET));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&fr, buf, sizeof(buf), &br));
+    TEST_ASSERT_EQUAL_UINT32(sizeof(data), br);
+    TEST_ASSERT_EQUAL_MEMORY(data, buf, sizeof(data));
+    lv_fs_close(&fr);
+}
+
+void test_budget_and_memory(void)
+{
+    lv_fs_cache_set_mem_cb(mem_alloc, mem_free);
+    mem_alloc_cnt = 0;
+    mem_free_cnt = 0;
+
+    /*Read more than the budget*/
+    decode(GIF_PATH);
+    lv_fs_cache_stats_t stats;
+    lv_fs_cache_get_stats(&stats);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(BUDGET, stats.size);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.evictions);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.read_ahead);
+    TEST_ASSERT_EQUAL_UINT32(mem_alloc_cnt - mem_free_cnt, stats.block_cnt);
+
+    lv_fs_cache_set_mem_cb(NULL, NULL);
+    TEST_ASSERT_EQUAL_UINT32(mem_alloc_cnt, mem_free_cnt);
+
+    /*The files opened without budget don't use the block cache*/
+    lv_fs_cache_set_budget(0);
+    lv_fs_cache_reset_stats();
+    decode(PNG_PATH);
+    lv_fs_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.reads);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.block_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_decoders_read_less_from_the_driver(void)
+{
+    TEST_IGNORE_MESSAGE("The FS block cache or the decoders are disabled");
+}
+
+void test_blocks_are_shared_across_opens(void)
+{
+    TEST_IGNORE_MESSAGE("The FS block cache or the decoders are disabled");
+}
+
+void test_random_reads_match_the_file(void)
+{
+    TEST_IGNORE_MESSAGE("The FS block cache or the decoders are disabled");
+}
+
+void test_writes_invalidate_the_blocks(void)
+{
+    TEST_IGNORE_MESSAGE("The FS block cache or the decoders are disabled");
+}
+
+void test_budget_and_memory(void)
+{
+    TEST_IGNORE_MESSAGE("The FS block cache or the decoders are disabled");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,243 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+/*8x8 GIF with 2 frames: a black background, then a red 3x2 rectangle at (2;3)*/
+static const uint8_t gif_opaque[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x08, 0x00, 0x08, 0x00, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00,
+    0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x02, 0x06, 0x84, 0x8f, 0xa9,
+    0xcb, 0xed, 0x5d, 0x00, 0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x02, 0x00, 0x03,
+    0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x02, 0x02, 0x94, 0x5f, 0x00, 0x3b,
+};
+
+/*Same but the 1st frame is white and it's restored to transparent background*/
+static const uint8_t gif_transp[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x08, 0x00, 0x08, 0x00, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0x21, 0xf9, 0x04, 0x09, 0x00, 0x00, 0x03,
+    0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x02, 0x06, 0x8c, 0x8f, 0xa9,
+    0xcb, 0xed, 0x5d, 0x00, 0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x02, 0x00, 0x03,
+    0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x02, 0x02, 0x94, 0x5f, 0x00, 0x3b,
+};
+
+/*8x8 GIF looping forever with 3 frames: a black background, a red 3x2 rectangle at (2;3)
+ *and a blue 2x2 rectangle at (5;5)*/
+static const uint8_t gif_loop[] = {
+    0x47, 0x49, 0x46, 0x38, 0x39, 0x61, 0x08, 0x00, 0x08, 0x00, 0x91, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x00, 0xff, 0x21, 0xff, 0x0b, 0x4e, 0x45, 0x54, 0x53,
+    0x43, 0x41, 0x50, 0x45, 0x32, 0x2e, 0x30, 0x03, 0x01, 0x00, 0x00, 0x00, 0x21, 0xf9, 0x04, 0x04,
+    0x00, 0x00, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x08, 0x00, 0x00, 0x02, 0x06,
+    0x84, 0x8f, 0xa9, 0xcb, 0xed, 0x5d, 0x00, 0x21, 0xf9, 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x2c,
+    0x02, 0x00, 0x03, 0x00, 0x03, 0x00, 0x02, 0x00, 0x00, 0x02, 0x02, 0x94, 0x5f, 0x00, 0x21, 0xf9,
+    0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x05, 0x00, 0x05, 0x00, 0x02, 0x00, 0x02, 0x00, 0x00,
+    0x02, 0x02, 0x9c, 0x57, 0x00, 0x3b,
+};
+
+static lv_img_dsc_t gif_dsc;
+static lv_disp_t * disp;
+static uint32_t ready_cnt;
+
+static lv_obj_t * gif_create(const uint8_t * data, uint32_t data_size)
+{
+    gif_dsc.data = data;
+    gif_dsc.data_size = data_size;
+
+    lv_obj_t * gif = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(gif, 20, 30);
+    lv_gif_set_src(gif, &gif_dsc);
+    return gif;
+}
+
+/*Show the next frame and return the area invalidated on the GIF*/
+static lv_area_t next_frame(lv_obj_t * gif)
+{
+    lv_refr_now(disp);
+    lv_timer_t * timer = ((lv_gif_t *)gif)->timer;
+    timer->timer_cb(timer);
+
+    /*Other areas might be invalidated too, e.g. by the performance monitor*/
+    uint16_t i;
+    for(i = 0; i < disp->inv_p; i++) {
+        if(_lv_area_is_on(&disp->inv_areas[i], &gif->coords)) return disp->inv_areas[i];
+    }
+
+    TEST_FAIL_MESSAGE("The GIF wasn't invalidated");
+    return gif->coords;
+}
+
+static void ready_event_cb(lv_event_t * e)
+{
+    LV_UNUSED(e);
+    ready_cnt++;
+}
+
+static const lv_color_t * gif_canvas(lv_obj_t * gif)
+{
+    return (const lv_color_t *)((lv_gif_t *)gif)->imgdsc.data;
+}
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    ready_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_gif_canvas_has_alpha_only_if_needed(void)
+{
+    lv_obj_t * gif = gif_create(gif_opaque, sizeof(gif_opaque));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR, ((lv_gif_t *)gif)->imgdsc.header.cf);
+    lv_obj_del(gif);
+
+    gif = gif_create(gif_transp, sizeof(gif_transp));
+    TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, ((lv_gif_t *)gif)->imgdsc.header.cf);
+}
+
+void test_gif_frame_invalidates_the_changed_area(void)
+{
+    lv_obj_t * gif = gif_create(gif_opaque, sizeof(gif_opaque));
+    lv_area_t a = next_frame(gif);
+
+    TEST_ASSERT_EQUAL(22, a.x1);
+    TEST_ASSERT_EQUAL(33, a.y1);
+    TEST_ASSERT_EQUAL(24, a.x2);
+    TEST_ASSERT_EQUAL(34, a.y2);
+
+    const lv_color_t * canvas = (const lv_color_t *)((lv_gif_t *)gif)->imgdsc.data;
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_make(0xff, 0x00, 0x00)), lv_color_to32(canvas[3 * 8 + 2]));
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_black()), lv_color_to32(canvas[3 * 8 + 1]));
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_black()), lv_color_to32(canvas[8 * 8 - 1]));
+}
+
+void test_gif_zoomed_frame_invalidates_the_scaled_area(void)
+{
+#if LV_DRAW_COMPLEX == 0
+    TEST_IGNORE_MESSAGE("Images are zoomed only with LV_DRAW_COMPLEX");
+#endif
+    lv_obj_t * gif = gif_create(gif_opaque, sizeof(gif_opaque));
+    lv_img_set_pivot(gif, 0, 0);
+    lv_img_set_zoom(gif, 512);
+    lv_area_t a = next_frame(gif);
+
+    /*(4;6)..(9;9) of the image with some margin for the rounding*/
+    TEST_ASSERT_LESS_OR_EQUAL(24, a.x1);
+    TEST_ASSERT_LESS_OR_EQUAL(36, a.y1);
+    TEST_ASSERT_GREATER_OR_EQUAL(29, a.x2);
+    TEST_ASSERT_GREATER_OR_EQUAL(39, a.y2);
+    TEST_ASSERT_LESS_OR_EQUAL(6 + 5, lv_area_get_width(&a));
+    TEST_ASSERT_LESS_OR_EQUAL(4 + 5, lv_area_get_height(&a));
+}
+
+void test_gif_disposed_frame_invalidates_its_area(void)
+{
+    lv_obj_t * gif = gif_create(gif_transp, sizeof(gif_transp));
+    lv_area_t a = next_frame(gif);
+
+    /*The whole 1st frame became transparent*/
+    TEST_ASSERT_EQUAL(20, a.x1);
+    TEST_ASSERT_EQUAL(30, a.y1);
+    TEST_ASSERT_EQUAL(27, a.x2);
+    TEST_ASSERT_EQUAL(37, a.y2);
+}
+
+void test_gif_cache_replays_the_frames(void)
+{
+    lv_obj_t * gif = lv_gif_create(lv_scr_act());
+    lv_obj_set_pos(gif, 20, 30);
+    lv_gif_set_cache_budget(gif, 4096);
+    gif_dsc.data = gif_loop;
+    gif_dsc.data_size = sizeof(gif_loop);
+    lv_gif_set_src(gif, &gif_dsc);
+
+    /*Decode the 1st loop*/
+    static lv_color_t canvas[3][64];
+    lv_memcpy(canvas[0], gif_canvas(gif), sizeof(canvas[0]));
+    next_frame(gif);
+    lv_memcpy(canvas[1], gif_canvas(gif), sizeof(canvas[1]));
+    next_frame(gif);
+    lv_memcpy(canvas[2], gif_canvas(gif), sizeof(canvas[2]));
+
+    lv_gif_cache_stats_t stats;
+    lv_gif_get_cache_stats(gif, &stats);
+    TEST_ASSERT_EQUAL_UINT16(3, stats.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32((64 + 6 + 4) * sizeof(lv_color_t) + 3 * sizeof(lv_gif_frame_t), stats.mem_used);
+    TEST_ASSERT_FALSE(stats.streaming);
+
+    /*The 1st frame of the next loop is decoded, the others come from the cache*/
+    uint32_t i;
+    for(i = 0; i < 7; i++) {
+        lv_area_t a = next_frame(gif);
+        TEST_ASSERT_EQUAL_MEMORY(canvas[i % 3], gif_canvas(gif), sizeof(canvas[0]));
+
+        /*Only the rectangle of the frame is redrawn*/
+        if(i % 3 == 1) {
+            TEST_ASSERT_EQUAL(22, a.x1);
+            TEST_ASSERT_EQUAL(33, a.y1);
+            TEST_ASSERT_EQUAL(24, a.x2);
+            TEST_ASSERT_EQUAL(34, a.y2);
+        }
+    }
+
+    lv_gif_get_cache_stats(gif, &stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.hits);
+    TEST_ASSERT_EQUAL_UINT8(60, stats.hit_rate);
+}
+
+void test_gif_cache_falls_back_to_streaming(void)
+{
+    lv_obj_t * gif = lv_gif_create(lv_scr_act());
+    /*Only the 1st frame fits*/
+    lv_gif_set_cache_budget(gif, 64 * sizeof(lv_color_t) + sizeof(lv_gif_frame_t) + 1);
+    gif_dsc.data = gif_loop;
+    gif_dsc.data_size = sizeof(gif_loop);
+    lv_gif_set_src(gif, &gif_dsc);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) next_frame(gif);
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_make(0x00, 0x00, 0xff)), lv_color_to32(gif_canvas(gif)[5 * 8 + 5]));
+
+    lv_gif_cache_stats_t stats;
+    lv_gif_get_cache_stats(gif, &stats);
+    TEST_ASSERT_TRUE(stats.streaming);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.mem_used);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.frame_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.misses);
+}
+
+void test_gif_cache_replays_after_restart(void)
+{
+    lv_obj_t * gif = lv_gif_create(lv_scr_act());
+    lv_obj_add_event_cb(gif, ready_event_cb, LV_EVENT_READY, NULL);
+    lv_gif_set_cache_budget(gif, 4096);
+    gif_dsc.data = gif_opaque;
+    gif_dsc.data_size = sizeof(gif_opaque);
+    lv_gif_set_src(gif, &gif_dsc);
+    next_frame(gif);
+
+    /*The GIF is played only once*/
+    lv_timer_t * timer = ((lv_gif_t *)gif)->timer;
+    timer->timer_cb(timer);
+    TEST_ASSERT_EQUAL_UINT32(1, ready_cnt);
+
+    lv_gif_restart(gif);
+    next_frame(gif);
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_black()), lv_color_to32(gif_canvas(gif)[3 * 8 + 2]));
+    next_frame(gif);
+    TEST_ASSERT_EQUAL_UINT32(lv_color_to32(lv_color_make(0xff, 0x00, 0x00)), lv_color_to32(gif_canvas(gif)[3 * 8 + 2]));
+    timer->timer_cb(timer);
+    TEST_ASSERT_EQUAL_UINT32(2, ready_cnt);
+
+    lv_gif_cache_stats_t stats;
+    lv_gif_get_cache_stats(gif, &stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hits);
+}
+
+#endif
@@ -0,0 +1,275 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_GLYPH_CACHE_DEF_BUDGET
+
+static uint32_t mem_alloc_cnt;
+static uint32_t mem_free_cnt;
+
+static void * mem_alloc(size_t size)
+{
+    mem_alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static void mem_free(void * p)
+{
+    mem_free_cnt++;
+    lv_mem_free(p);
+}
+
+static uint32_t glyph_size(const lv_font_t * font, uint32_t letter)
+{
+    const _lv_glyph_cache_entry_t * e = _lv_glyph_cache_get(font, letter);
+    TEST_ASSERT_NOT_NULL(e);
+    lv_glyph_cache_stats_t stats;
+    lv_glyph_cache_get_stats(&stats);
+    return stats.size;
+}
+
+/*Render the screen and return the FNV-1a hash of its pixels*/
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(lv_disp_get_default());
+    const uint8_t * p = draw_buf->buf1;
+    uint32_t size = draw_buf->size * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+void setUp(void)
+{
+    /*Count the glyphs of the tests only, not the ones of the performance and memory monitors*/
+    lv_obj_add_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+    lv_glyph_cache_invalidate_font(NULL);
+    lv_glyph_cache_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_clear_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+    lv_glyph_cache_set_mem_cb(NULL, NULL);
+    lv_glyph_cache_set_budget(LV_GLYPH_CACHE_DEF_BUDGET);
+}
+
+void test_glyph_cache_redraw_unpacks_once(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_label_set_text(label, "12:34");
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    lv_glyph_cache_stats_t stats;
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(5, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(4 * 5, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT16(5, stats.entry_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.size);
+
+    /*The same letter of an other font is a different glyph*/
+    lv_label_set_text(label, "1");
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_24, 0);
+    lv_refr_now(NULL);
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(6, stats.misses);
+    TEST_ASSERT_EQUAL_UINT16(6, stats.entry_cnt);
+
+    /*Drop the glyphs of a font only*/
+    lv_glyph_cache_invalidate_font(&lv_font_montserrat_48);
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+}
+
+void test_glyph_cache_unpacks_to_8_bit(void)
+{
+    /*4 bpp*/
+    const lv_font_t * font = &lv_font_montserrat_48;
+    const _lv_glyph_cache_entry_t * e = _lv_glyph_cache_get(font, '8');
+    TEST_ASSERT_NOT_NULL(e);
+
+    lv_font_glyph_dsc_t g;
+    TEST_ASSERT_TRUE(lv_font_get_glyph_dsc(font, &g, '8', '\0'));
+    TEST_ASSERT_EQUAL(g.box_w, e->dsc.box_w);
+    TEST_ASSERT_EQUAL(g.box_h, e->dsc.box_h);
+    TEST_ASSERT_EQUAL(g.ofs_x, e->dsc.ofs_x);
+    TEST_ASSERT_EQUAL(g.ofs_y, e->dsc.ofs_y);
+
+    const uint8_t * bitmap = lv_font_get_glyph_bitmap(font, '8');
+    uint32_t i;
+    for(i = 0; i < (uint32_t)g.box_w * g.box_h; i++) {
+        uint8_t px = (bitmap[i / 2] >> (i & 1 ? 0 : 4)) & 0xF;
+        TEST_ASSERT_EQUAL_UINT8(px * 17, e->map[i]);
+    }
+
+    /*1 bpp*/
+    font = &lv_font_unscii_8;
+    e = _lv_glyph_cache_get(font, 'A');
+    TEST_ASSERT_NOT_NULL(e);
+    bitmap = lv_font_get_glyph_bitmap(font, 'A');
+    for(i = 0; i < (uint32_t)e->dsc.box_w * e->dsc.box_h; i++) {
+        uint8_t px = (bitmap[i / 8] >> (7 - (i & 7))) & 0x1;
+        TEST_ASSERT_EQUAL_UINT8(px ? 255 : 0, e->map[i]);
+    }
+
+    /*Sub-pixel rendered glyphs are not cached*/
+    TEST_ASSERT_NULL(_lv_glyph_cache_get(&lv_font_montserrat_12_subpx, 'A'));
+    /*Missing glyphs neither*/
+    TEST_ASSERT_NULL(_lv_glyph_cache_get(&lv_font_montserrat_14, 0x4E2D));
+}
+
+void test_glyph_cache_budget_evicts_least_recently_used(void)
+{
+    /*'2', '3' and '5' have the same size*/
+    const lv_font_t * font = &lv_font_montserrat_48;
+    uint32_t size = glyph_size(font, '2');
+    lv_glyph_cache_set_budget(size * 5 / 2);
+    lv_glyph_cache_reset_stats();
+
+    _lv_glyph_cache_get(font, '2');
+    _lv_glyph_cache_get(font, '3');
+    _lv_glyph_cache_get(font, '2');
+
+    /*'3' is the least recently used*/
+    _lv_glyph_cache_get(font, '5');
+    _lv_glyph_cache_get(font, '2');
+
+    lv_glyph_cache_stats_t stats;
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * size, stats.size);
+
+    _lv_glyph_cache_get(font, '3');
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.misses);
+
+    /*Larger than the budget: not cached*/
+    lv_glyph_cache_set_budget(size / 2);
+    TEST_ASSERT_NULL(_lv_glyph_cache_get(font, '0'));
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT16(0, stats.entry_cnt);
+
+    /*Disabled*/
+    lv_glyph_cache_set_budget(0);
+    TEST_ASSERT_NULL(_lv_glyph_cache_get(font, '0'));
+}
+
+void test_glyph_cache_glyphs_in_cache_memory(void)
+{
+    mem_alloc_cnt = 0;
+    mem_free_cnt = 0;
+    lv_glyph_cache_set_mem_cb(mem_alloc, mem_free);
+
+    TEST_ASSERT_NOT_NULL(_lv_glyph_cache_get(&lv_font_montserrat_48, '1'));
+    TEST_ASSERT_NOT_NULL(_lv_glyph_cache_get(&lv_font_montserrat_48, '2'));
+    TEST_ASSERT_EQUAL_UINT32(2, mem_alloc_cnt);
+
+    lv_glyph_cache_invalidate_font(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, mem_free_cnt);
+}
+
+void test_glyph_cache_draws_the_same_pixels(void)
+{
+    /*Full and partial opacity, clipped and masked letters with 1, 4 and compressed 3 bpp fonts*/
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_label_set_text(label, "12:34 Ag");
+    lv_obj_set_pos(label, -10, 0);
+
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_obj_set_style_text_opa(label, LV_OPA_50, 0);
+    lv_obj_set_style_text_color(label, lv_palette_main(LV_PALETTE_RED), 0);
+    lv_label_set_text(label, "12:34 Ag");
+    lv_obj_set_pos(label, 0, 60);
+
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_28_compressed, 0);
+    lv_label_set_text(label, "Compressed 0123");
+    lv_obj_set_pos(label, 0, 130);
+
+    label = lv_label_create(lv_scr_act());
+    lv_obj_set_style_text_font(label, &lv_font_unscii_8, 0);
+    lv_label_set_text(label, "Unscii 8 bitmap font");
+    lv_obj_set_pos(label, 0, 180);
+
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 200, 120);
+    lv_obj_set_pos(cont, 400, 200);
+    lv_obj_set_style_radius(cont, 50, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    lv_obj_set_style_pad_all(cont, 0, 0);
+    label = lv_label_create(cont);
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+    lv_label_set_text(label, "88888\n88888");
+    lv_obj_set_pos(label, -5, -5);
+
+    lv_glyph_cache_set_budget(0);
+    uint32_t ref = render_hash();
+
+    lv_glyph_cache_set_budget(LV_GLYPH_CACHE_DEF_BUDGET);
+    TEST_ASSERT_EQUAL_HEX32(ref, render_hash());
+    TEST_ASSERT_EQUAL_HEX32(ref, render_hash());
+
+    lv_glyph_cache_stats_t stats;
+    lv_glyph_cache_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.hits);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_glyph_cache_redraw_unpacks_once(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_GLYPH_CACHE_DEF_BUDGET > 0");
+}
+
+void test_glyph_cache_unpacks_to_8_bit(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_GLYPH_CACHE_DEF_BUDGET > 0");
+}
+
+void test_glyph_cache_budget_evicts_least_recently_used(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_GLYPH_CACHE_DEF_BUDGET > 0");
+}
+
+void test_glyph_cache_glyphs_in_cache_memory(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_GLYPH_CACHE_DEF_BUDGET > 0");
+}
+
+void test_glyph_cache_draws_the_same_pixels(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_GLYPH_CACHE_DEF_BUDGET > 0");
+}
+
+#endif
+
+#endif
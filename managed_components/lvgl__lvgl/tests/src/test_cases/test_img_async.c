@@ -0,0 +1,405 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_ASYNC_QUEUE_LEN && LV_USE_PNG
+
+#include <pthread.h>
+#include <unistd.h>
+
+/*50x50 pixels with alpha channel*/
+#define PNG_PATH        "A:../../../qr_data/wink.png"
+#define PNG_W           50
+
+#define SRC_CNT         (LV_IMG_ASYNC_QUEUE_LEN + 2)
+#define PLACEHOLDER_W   5
+
+#define WORKER_QUEUE_LEN    4
+
+extern lv_color_t test_fb[];
+
+static uint8_t * png_data;
+static lv_img_dsc_t png_dsc[SRC_CNT];
+static lv_color_t placeholder_px[PLACEHOLDER_W * PLACEHOLDER_W];
+static lv_img_dsc_t placeholder_dsc;
+
+#if LV_MEM_CUSTOM
+/*A worker thread decoding the submitted jobs in order. It doesn't start a job while it's held.*/
+static pthread_t worker_thread;
+static pthread_mutex_t worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worker_cond = PTHREAD_COND_INITIALIZER;
+static lv_img_async_job_t * worker_queue[WORKER_QUEUE_LEN];
+static uint32_t worker_queue_cnt;
+static bool worker_quit;
+static bool worker_hold;
+static uint32_t worker_run_cnt;
+
+static void * worker_main(void * arg)
+{
+    LV_UNUSED(arg);
+    pthread_mutex_lock(&worker_mutex);
+    while(true) {
+        while((worker_queue_cnt == 0 || worker_hold) && !worker_quit) pthread_cond_wait(&worker_cond, &worker_mutex);
+        if(worker_queue_cnt == 0) break;
+
+        lv_img_async_job_t * job = worker_queue[0];
+        worker_queue_cnt--;
+        lv_memcpy(worker_queue, worker_queue + 1, worker_queue_cnt * sizeof(worker_queue[0]));
+        pthread_mutex_unlock(&worker_mutex);
+
+        lv_img_async_job_run(job);
+
+        pthread_mutex_lock(&worker_mutex);
+        worker_run_cnt++;
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return NULL;
+}
+
+static bool worker_submit(lv_img_async_job_t * job)
+{
+    pthread_mutex_lock(&worker_mutex);
+    bool ok = worker_queue_cnt < WORKER_QUEUE_LEN;
+    if(ok) {
+        worker_queue[worker_queue_cnt] = job;
+        worker_queue_cnt++;
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return ok;
+}
+
+static void worker_wait(lv_img_async_job_t * job)
+{
+    /*The mutex makes the pixels of the worker visible*/
+    pthread_mutex_lock(&worker_mutex);
+    while(!job->done) pthread_cond_wait(&worker_cond, &worker_mutex);
+    pthread_mutex_unlock(&worker_mutex);
+}
+
+static void worker_start(void)
+{
+    worker_quit = false;
+    worker_hold = false;
+    worker_run_cnt = 0;
+    TEST_ASSERT_EQUAL(0, pthread_create(&worker_thread, NULL, worker_main, NULL));
+    lv_img_async_set_worker(worker_submit, worker_wait);
+}
+
+static void worker_stop(void)
+{
+    lv_img_async_set_worker(NULL, NULL);
+    pthread_mutex_lock(&worker_mutex);
+    worker_quit = true;
+    worker_hold = false;
+    pthread_cond_broadcast(&worker_cond);
+    pthread_mutex_unlock(&worker_mutex);
+    pthread_join(worker_thread, NULL);
+}
+
+static void worker_set_hold(bool hold)
+{
+    pthread_mutex_lock(&worker_mutex);
+    worker_hold = hold;
+    pthread_cond_broadcast(&worker_cond);
+    pthread_mutex_unlock(&worker_mutex);
+}
+#endif
+
+static lv_img_async_stats_t get_stats(void)
+{
+    lv_img_async_stats_t stats;
+    lv_img_async_get_stats(&stats);
+    return stats;
+}
+
+/*Let the timer of the background decoding run now*/
+static void timer_run(void)
+{
+    lv_timer_t * timer = LV_GC_ROOT(_lv_img_async_timer);
+    if(timer) lv_timer_ready(timer);
+    lv_timer_handler();
+}
+
+static void wait_decoded(void)
+{
+    uint32_t i;
+    for(i = 0; i < 2000 && get_stats().queued; i++) {
+        timer_run();
+        usleep(1000);
+    }
+    TEST_ASSERT_EQUAL_UINT16(0, get_stats().queued);
+}
+
+static void refresh(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static lv_color_t get_px(lv_coord_t x, lv_coord_t y)
+{
+    return test_fb[y * LV_HOR_RES + x];
+}
+
+static bool is_cached(const void * src)
+{
+    return _lv_img_cache_contains(src, lv_color_black());
+}
+
+static lv_obj_t * img_create(const void * src, lv_coord_t x)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_async(img, true);
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, x, 0);
+    return img;
+}
+
+void setUp(void)
+{
+    lv_fs_file_t f;
+    uint32_t size;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, PNG_PATH, LV_FS_MODE_RD));
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    png_data = lv_mem_alloc(size);
+    uint32_t br;
+    lv_fs_read(&f, png_data, size, &br);
+    lv_fs_close(&f);
+    TEST_ASSERT_EQUAL_UINT32(size, br);
+
+    /*The same PNG with different sources. The PNGs in C arrays are `LV_IMG_CF_RAW_ALPHA`.*/
+    uint32_t i;
+    for(i = 0; i < SRC_CNT; i++) {
+        lv_memset_00(&png_dsc[i], sizeof(lv_img_dsc_t));
+        png_dsc[i].header.cf = LV_IMG_CF_RAW_ALPHA;
+        png_dsc[i].header.w = PNG_W;
+        png_dsc[i].header.h = PNG_W;
+        png_dsc[i].data = png_data;
+        png_dsc[i].data_size = size;
+    }
+
+    for(i = 0; i < PLACEHOLDER_W * PLACEHOLDER_W; i++) placeholder_px[i] = lv_palette_main(LV_PALETTE_RED);
+    lv_memset_00(&placeholder_dsc, sizeof(lv_img_dsc_t));
+    placeholder_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    placeholder_dsc.header.w = PLACEHOLDER_W;
+    placeholder_dsc.header.h = PLACEHOLDER_W;
+    placeholder_dsc.data = (const uint8_t *)placeholder_px;
+    placeholder_dsc.data_size = sizeof(placeholder_px);
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_async_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_invalidate_src(NULL);
+    lv_mem_free(png_data);
+}
+
+void test_placeholder_until_decoded(void)
+{
+    lv_obj_t * img = img_create(&png_dsc[0], 0);
+    lv_img_set_placeholder(img, &placeholder_dsc);
+
+    /*The placeholder is zoomed to the size of the image*/
+    refresh();
+    lv_img_async_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.requests);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.queued);
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[0]));
+    TEST_ASSERT_EQUAL_HEX32(lv_color_to32(lv_palette_main(LV_PALETTE_RED)), lv_color_to32(get_px(PNG_W / 2, PNG_W / 2)));
+
+    /*Drawn again while it waits*/
+    refresh();
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats().requests);
+
+    /*Decoded in the timer without a worker and redrawn*/
+    wait_decoded();
+    stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.timer_decodes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.worker_decodes);
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[0]));
+
+    refresh();
+    TEST_ASSERT_NOT_EQUAL(lv_color_to32(lv_palette_main(LV_PALETTE_RED)), lv_color_to32(get_px(PNG_W / 2, PNG_W / 2)));
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats().requests);
+}
+
+void test_deleted_images_are_canceled(void)
+{
+    lv_obj_t * img0 = img_create(&png_dsc[0], 0);
+    lv_obj_t * img1 = img_create(&png_dsc[1], PNG_W);
+    lv_obj_t * img2 = img_create(&png_dsc[2], 2 * PNG_W);
+    lv_obj_t * img2b = img_create(&png_dsc[2], 3 * PNG_W);
+    refresh();
+
+    lv_img_async_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(3, stats.requests);
+    TEST_ASSERT_EQUAL_UINT16(3, stats.queued);
+
+    /*The image of the other object is still needed*/
+    lv_obj_del(img2b);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stats().canceled);
+
+    lv_obj_del(img0);
+    lv_img_set_src(img1, &png_dsc[3]);
+    stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.canceled);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.queued);
+
+    wait_decoded();
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[2]));
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[0]));
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[1]));
+
+    /*The new source of `img1` is requested when it's drawn*/
+    refresh();
+    wait_decoded();
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[3]));
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().timer_decodes);
+    LV_UNUSED(img2);
+}
+
+void test_visible_images_are_decoded_first(void)
+{
+    lv_obj_t * img0 = img_create(&png_dsc[0], 0);
+    lv_obj_t * img1 = img_create(&png_dsc[1], PNG_W);
+    img_create(&png_dsc[2], 2 * PNG_W);
+    refresh();
+    TEST_ASSERT_EQUAL_UINT16(3, get_stats().queued);
+
+    /*Scrolled out before they were decoded*/
+    lv_obj_set_y(img0, -1000);
+    lv_obj_set_y(img1, -1000);
+    lv_obj_update_layout(lv_scr_act());
+
+    timer_run();
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[2]));
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[0]));
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[1]));
+
+    /*The hidden ones are decoded later in order*/
+    timer_run();
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[0]));
+    TEST_ASSERT_FALSE(is_cached(&png_dsc[1]));
+    wait_decoded();
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[1]));
+}
+
+void test_queue_is_bounded(void)
+{
+    uint32_t i;
+    for(i = 0; i < SRC_CNT; i++) img_create(&png_dsc[i], (lv_coord_t)(i * PNG_W));
+    refresh();
+
+    /*The images which don't fit into the queue are decoded while they are drawn*/
+    lv_img_async_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(LV_IMG_ASYNC_QUEUE_LEN, stats.requests);
+    TEST_ASSERT_EQUAL_UINT16(LV_IMG_ASYNC_QUEUE_LEN, stats.queued);
+    TEST_ASSERT_EQUAL_UINT32(SRC_CNT - LV_IMG_ASYNC_QUEUE_LEN, stats.rejected);
+    for(i = 0; i < SRC_CNT; i++) TEST_ASSERT_EQUAL(i >= LV_IMG_ASYNC_QUEUE_LEN, is_cached(&png_dsc[i]));
+
+    wait_decoded();
+    for(i = 0; i < SRC_CNT; i++) TEST_ASSERT_TRUE(is_cached(&png_dsc[i]));
+    TEST_ASSERT_EQUAL_UINT32(LV_IMG_ASYNC_QUEUE_LEN, get_stats().timer_decodes);
+}
+
+void test_worker_decodes_in_background(void)
+{
+#if LV_MEM_CUSTOM
+    /*The reference image is decoded in the LVGL thread*/
+    lv_obj_t * ref = lv_img_create(lv_scr_act());
+    lv_img_set_src(ref, PNG_PATH);
+    refresh();
+    lv_color_t ref_px[PNG_W];
+    lv_coord_t i;
+    for(i = 0; i < PNG_W; i++) ref_px[i] = get_px(i, PNG_W / 2);
+    lv_obj_del(ref);
+    lv_img_cache_invalidate_src(NULL);
+
+    worker_start();
+    lv_obj_t * img_file = img_create(PNG_PATH, 0);
+    img_create(&png_dsc[0], PNG_W);
+    refresh();
+    wait_decoded();
+
+    lv_img_async_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(2, stats.worker_decodes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.timer_decodes);
+    TEST_ASSERT_EQUAL_UINT32(2, worker_run_cnt);
+    TEST_ASSERT_TRUE(is_cached(PNG_PATH));
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[0]));
+
+    refresh();
+    for(i = 0; i < PNG_W; i++) {
+        TEST_ASSERT_EQUAL_HEX32(lv_color_to32(ref_px[i]), lv_color_to32(get_px(i, PNG_W / 2)));
+        TEST_ASSERT_EQUAL_HEX32(lv_color_to32(ref_px[i]), lv_color_to32(get_px(PNG_W + i, PNG_W / 2)));
+    }
+
+    /*The image being decoded is still cached when its object is deleted*/
+    lv_obj_del(img_file);
+    lv_img_cache_invalidate_src(NULL);
+    worker_set_hold(true);
+    lv_obj_t * img = img_create(&png_dsc[1], 0);
+    refresh();
+    timer_run();
+    lv_obj_del(img);
+    worker_set_hold(false);
+    wait_decoded();
+
+    stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(0, stats.canceled);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.worker_decodes);
+    TEST_ASSERT_TRUE(is_cached(&png_dsc[1]));
+
+    worker_stop();
+#else
+    TEST_IGNORE_MESSAGE("The worker needs a thread safe lv_mem_alloc (LV_MEM_CUSTOM)");
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_placeholder_until_decoded(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_ASYNC_QUEUE_LEN and LV_USE_PNG");
+}
+
+void test_deleted_images_are_canceled(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_ASYNC_QUEUE_LEN and LV_USE_PNG");
+}
+
+void test_visible_images_are_decoded_first(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_ASYNC_QUEUE_LEN and LV_USE_PNG");
+}
+
+void test_queue_is_bounded(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_ASYNC_QUEUE_LEN and LV_USE_PNG");
+}
+
+void test_worker_decodes_in_background(void)
+{
+    TEST_IGNORE_MESSAGE("Requires LV_IMG_ASYNC_QUEUE_LEN and LV_USE_PNG");
+}
+
+#endif
+
+#endif
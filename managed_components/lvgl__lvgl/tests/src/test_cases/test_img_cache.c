@@ -0,0 +1,288 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/misc/lv_gc.h"
+
+#include "unity/unity.h"
+
+#if LV_IMG_CACHE_DEF_SIZE
+
+/*The assets of the application. `test.png` is a JPEG in fact, so it's decoded by SJPG*/
+#define JPG_PATH    "A:../../../qr_data/test.png"
+#define PNG_PATH    "A:../../../qr_data/wink.png"
+
+static uint8_t * jpg_data;
+static lv_img_dsc_t jpg_dsc[3];
+
+static lv_img_decoder_t * counter;
+static lv_img_decoder_t * sjpg;
+static uint32_t open_cnt;
+static uint32_t close_cnt;
+
+static uint32_t mem_alloc_cnt;
+static uint32_t mem_free_cnt;
+
+/*Forward everything to the SJPG decoder but count the opens*/
+static lv_res_t counter_info(lv_img_decoder_t * decoder, const void * src, lv_img_header_t * header)
+{
+    LV_UNUSED(decoder);
+    return sjpg->info_cb(sjpg, src, header);
+}
+
+static lv_res_t counter_open(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    lv_res_t res = sjpg->open_cb(sjpg, dsc);
+    if(res == LV_RES_OK) open_cnt++;
+    return res;
+}
+
+static lv_res_t counter_read_line(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc, lv_coord_t x,
+                                  lv_coord_t y, lv_coord_t len, uint8_t * buf)
+{
+    LV_UNUSED(decoder);
+    return sjpg->read_line_cb(sjpg, dsc, x, y, len, buf);
+}
+
+static void counter_close(lv_img_decoder_t * decoder, lv_img_decoder_dsc_t * dsc)
+{
+    LV_UNUSED(decoder);
+    close_cnt++;
+    sjpg->close_cb(sjpg, dsc);
+}
+
+static void * mem_alloc(size_t size)
+{
+    mem_alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static void mem_free(void * p)
+{
+    mem_free_cnt++;
+    lv_mem_free(p);
+}
+
+void setUp(void)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, JPG_PATH, LV_FS_MODE_RD));
+    uint32_t size;
+    lv_fs_seek(&f, 0, LV_FS_SEEK_END);
+    lv_fs_tell(&f, &size);
+    lv_fs_seek(&f, 0, LV_FS_SEEK_SET);
+    jpg_data = lv_mem_alloc(size);
+    uint32_t rn;
+    lv_fs_read(&f, jpg_data, size, &rn);
+    lv_fs_close(&f);
+    TEST_ASSERT_EQUAL_UINT32(size, rn);
+
+    /*Same data with different sources*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_memset_00(&jpg_dsc[i], sizeof(lv_img_dsc_t));
+        jpg_dsc[i].header.cf = LV_IMG_CF_RAW;
+        jpg_dsc[i].data = jpg_data;
+        jpg_dsc[i].data_size = size;
+    }
+
+    /*Find the decoder of JPG images*/
+    lv_img_header_t header;
+    sjpg = NULL;
+    lv_img_decoder_t * d;
+    _LV_LL_READ(&LV_GC_ROOT(_lv_img_decoder_ll), d) {
+        if(d->info_cb(d, &jpg_dsc[0], &header) == LV_RES_OK) {
+            sjpg = d;
+            break;
+        }
+    }
+    TEST_ASSERT_NOT_NULL(sjpg);
+
+    counter = lv_img_decoder_create();
+    lv_img_decoder_set_info_cb(counter, counter_info);
+    lv_img_decoder_set_open_cb(counter, counter_open);
+    lv_img_decoder_set_read_line_cb(counter, counter_read_line);
+    lv_img_decoder_set_close_cb(counter, counter_close);
+
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_cache_reset_stats();
+    open_cnt = 0;
+    close_cnt = 0;
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_img_cache_set_mem_cb(NULL, NULL);
+    lv_img_cache_set_budget(LV_IMG_CACHE_DEF_BUDGET);
+    lv_img_cache_invalidate_src(NULL);
+    lv_img_decoder_delete(counter);
+    lv_mem_free(jpg_data);
+}
+
+void test_img_cache_redraw_decodes_once(void)
+{
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, &jpg_dsc[0]);
+    lv_obj_center(img);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(NULL);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+    TEST_ASSERT_EQUAL_UINT32(0, close_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(4, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.entry_cnt);
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(224 * 280 * LV_IMG_PX_SIZE_ALPHA_BYTE, stats.size);
+
+    /*Changing the source needs a new decoding*/
+    lv_img_cache_invalidate_src(&jpg_dsc[0]);
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(2, open_cnt);
+}
+
+void test_img_cache_budget_evicts_least_recently_used(void)
+{
+    _lv_img_cache_entry_t * e = _lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e);
+    uint32_t entry_size = e->size;
+
+    /*Room for 2 images*/
+    lv_img_cache_set_budget(entry_size * 5 / 2);
+    lv_img_cache_reset_stats();
+    open_cnt = 0;
+
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[1], lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(2, open_cnt);
+
+    /*The 2nd image is the least recently used*/
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[2], lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[1], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.hits);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.misses);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.evictions);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.entry_cnt);
+    TEST_ASSERT_EQUAL_UINT32(2 * entry_size, stats.size);
+
+    /*Larger than the budget: opened only while used*/
+    lv_img_cache_set_budget(entry_size / 2);
+    open_cnt = 0;
+    close_cnt = 0;
+    e = _lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e);
+    _lv_img_cache_release(e);
+    TEST_ASSERT_EQUAL_UINT32(1, open_cnt);
+    TEST_ASSERT_EQUAL_UINT32(1, close_cnt);
+}
+
+void test_img_cache_pinned_image_is_kept(void)
+{
+    _lv_img_cache_entry_t * e = _lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0);
+    uint32_t entry_size = e->size;
+
+    /*Room for 1 image*/
+    lv_img_cache_set_budget(entry_size * 3 / 2);
+    open_cnt = 0;
+
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_cache_pin(&jpg_dsc[0], lv_color_black()));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[1], lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[2], lv_color_black(), 0));
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(entry_size, stats.pinned_size);
+    TEST_ASSERT_EQUAL_UINT32(entry_size, stats.size);
+    TEST_ASSERT_EQUAL_UINT16(2, stats.entry_cnt);
+
+    /*Unpinned it replaces the 3rd image in the cache*/
+    lv_img_cache_unpin(&jpg_dsc[0], lv_color_black());
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[0], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(3, open_cnt);
+    _lv_img_cache_release(_lv_img_cache_open(&jpg_dsc[2], lv_color_black(), 0));
+    TEST_ASSERT_EQUAL_UINT32(4, open_cnt);
+
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.pinned_size);
+    TEST_ASSERT_EQUAL_UINT16(1, stats.entry_cnt);
+}
+
+void test_img_cache_pixels_in_cache_memory(void)
+{
+    mem_alloc_cnt = 0;
+    mem_free_cnt = 0;
+    lv_img_cache_set_mem_cb(mem_alloc, mem_free);
+
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, PNG_PATH);
+    lv_refr_now(NULL);
+
+    /*The PNG decoder's buffer is replaced by the one from the callback*/
+    _lv_img_cache_entry_t * e = _lv_img_cache_open(PNG_PATH, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(1, mem_alloc_cnt);
+    TEST_ASSERT_TRUE(e->cache_mem);
+    TEST_ASSERT_EQUAL_UINT32(50, e->dec_dsc.header.w);
+
+    lv_obj_invalidate(img);
+    lv_refr_now(NULL);
+
+    lv_img_cache_stats_t stats;
+    lv_img_cache_get_stats(&stats);
+    TEST_ASSERT_EQUAL_UINT32(1, stats.misses);
+
+    lv_img_cache_invalidate_src(PNG_PATH);
+    TEST_ASSERT_EQUAL_UINT32(1, mem_free_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_img_cache_redraw_decodes_once(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_IMG_CACHE_DEF_SIZE > 0");
+}
+
+void test_img_cache_budget_evicts_least_recently_used(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_IMG_CACHE_DEF_SIZE > 0");
+}
+
+void test_img_cache_pinned_image_is_kept(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_IMG_CACHE_DEF_SIZE > 0");
+}
+
+void test_img_cache_pixels_in_cache_memory(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_IMG_CACHE_DEF_SIZE > 0");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,424 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/extra/libs/png/lodepng.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_IMGPACK && LV_USE_PNG && LV_USE_FS_STDIO && defined(LV_TEST_IMGPACK_DIR)
+
+#define WINK_PATH       "A:../../../qr_data/wink.png"
+#define COGWHEEL_PATH   "A:../examples/assets/img_cogwheel_indexed16.png"
+#define MAX_W           100
+
+#if LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP
+#define PACK_DEPTH      "16swap"
+#elif LV_COLOR_DEPTH == 16
+#define PACK_DEPTH      "16"
+#elif LV_COLOR_DEPTH == 8
+#define PACK_DEPTH      "8"
+#else
+#define PACK_DEPTH      "32"
+#endif
+
+static const char * compress_names[] = {"none", "rle", "lz4"};
+
+/*Big enough for the packs of the tests, aligned as the images are drawn from it*/
+static uint32_t pack_buf[80 * 1024 / 4];
+static lv_imgpack_t pack;
+
+static uint8_t line[MAX_W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static lv_color_t ref_colors[MAX_W];
+static lv_opa_t ref_opas[MAX_W];
+static lv_color_t colors[MAX_W];
+static lv_opa_t opas[MAX_W];
+
+static const char * pack_path(const char * depth, const char * compress)
+{
+    static char path[256];
+    lv_snprintf(path, sizeof(path), "A:%s/test_%s_%s.lvip", LV_TEST_IMGPACK_DIR, depth, compress);
+    return path;
+}
+
+static uint32_t load_pack(const char * depth, const char * compress)
+{
+    lv_fs_file_t f;
+    uint32_t size = 0;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, pack_path(depth, compress), LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, pack_buf, sizeof(pack_buf), &size));
+    lv_fs_close(&f);
+    TEST_ASSERT_LESS_THAN_UINT32(sizeof(pack_buf), size);
+    return size;
+}
+
+static uint32_t get_u32(const uint8_t * p)
+{
+    return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static void set_u32(uint8_t * p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+/*Get the colors and opacities of a row from an opened decoder in any of the formats it can give*/
+static void read_row(lv_img_decoder_dsc_t * dsc, lv_coord_t y, lv_color_t * c, lv_opa_t * opa)
+{
+    lv_coord_t w = dsc->header.w;
+    lv_img_cf_t cf = dsc->header.cf;
+    const uint8_t * px;
+    const uint8_t * alpha = NULL;
+
+    if(dsc->img_data) {
+        switch(cf) {
+            case LV_IMG_CF_TRUE_COLOR:
+                px = dsc->img_data + y * w * sizeof(lv_color_t);
+                break;
+            case LV_IMG_CF_TRUE_COLOR_ALPHA:
+                px = dsc->img_data + y * w * LV_IMG_PX_SIZE_ALPHA_BYTE;
+                break;
+            case LV_IMG_CF_RGB565A8:
+                px = dsc->img_data + y * w * sizeof(lv_color_t);
+                alpha = dsc->img_data + dsc->header.h * w * sizeof(lv_color_t) + y * w;
+                break;
+            case LV_IMG_CF_ALPHA_8BIT: {
+                    lv_coord_t x;
+                    for(x = 0; x < w; x++) {
+                        c[x] = dsc->color;
+                        opa[x] = dsc->img_data[y * w + x];
+                    }
+                    return;
+                }
+            default:
+                TEST_FAIL_MESSAGE("Unexpected color format");
+                return;
+        }
+    }
+    else {
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, w, line));
+        px = line;
+        if(cf == LV_IMG_CF_RGB565A8) alpha = line + w * sizeof(lv_color_t);
+        /*Alpha only and indexed images are read as true color with alpha*/
+        else if(cf != LV_IMG_CF_TRUE_COLOR) cf = LV_IMG_CF_TRUE_COLOR_ALPHA;
+    }
+
+    uint32_t px_size = cf == LV_IMG_CF_TRUE_COLOR_ALPHA ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    lv_coord_t x;
+    for(x = 0; x < w; x++) {
+        lv_memcpy(&c[x], px + x * px_size, sizeof(lv_color_t));
+        if(cf == LV_IMG_CF_TRUE_COLOR_ALPHA) opa[x] = px[x * px_size + LV_IMG_PX_SIZE_ALPHA_BYTE - 1];
+        else if(alpha) opa[x] = alpha[x];
+        else opa[x] = LV_OPA_COVER;
+    }
+}
+
+/*Compare an image of the pack with the output of the PNG decoder*/
+static void check_img(const char * name, const char * png_path, bool colors_only, bool alpha_only)
+{
+    const lv_img_dsc_t * src = lv_imgpack_get(&pack, name);
+    TEST_ASSERT_NOT_NULL_MESSAGE(src, name);
+
+    lv_color_t color = lv_color_hex(0x3a6eb4);
+    lv_img_decoder_dsc_t ref;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&ref, png_path, color, 0));
+    TEST_ASSERT_EQUAL_MESSAGE(LV_RES_OK, lv_img_decoder_open(&dsc, src, color, 0), name);
+    TEST_ASSERT_EQUAL(ref.header.w, dsc.header.w);
+    TEST_ASSERT_EQUAL(ref.header.h, dsc.header.h);
+
+    /*From the bottom to read the tiles out of order*/
+    lv_coord_t y;
+    for(y = dsc.header.h - 1; y >= 0; y--) {
+        read_row(&ref, y, ref_colors, ref_opas);
+        read_row(&dsc, y, colors, opas);
+        lv_coord_t x;
+        for(x = 0; x < dsc.header.w; x++) {
+            lv_color_t exp_color = alpha_only ? color : ref_colors[x];
+            lv_opa_t exp_opa = colors_only ? LV_OPA_COVER : ref_opas[x];
+            TEST_ASSERT_EQUAL_HEX32_MESSAGE(lv_color_to32(exp_color) & 0xFFFFFF,
+                                            lv_color_to32(colors[x]) & 0xFFFFFF, name);
+            TEST_ASSERT_EQUAL_HEX8_MESSAGE(exp_opa, opas[x], name);
+        }
+    }
+
+    lv_img_decoder_close(&dsc);
+    lv_img_decoder_close(&ref);
+}
+
+static void check_pack(void)
+{
+    TEST_ASSERT_EQUAL_UINT32(5, pack.img_cnt);
+    TEST_ASSERT_NULL(lv_imgpack_get(&pack, "win"));
+    TEST_ASSERT_NULL(lv_imgpack_get(&pack, "winks"));
+
+    check_img("wink", WINK_PATH, false, false);
+    check_img("wink_tc", WINK_PATH, true, false);
+    check_img("wink_tca", WINK_PATH, false, false);
+    check_img("wink_a8", WINK_PATH, false, true);
+    check_img("cogwheel", COGWHEEL_PATH, false, false);
+}
+
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(lv_disp_get_default());
+    const uint8_t * p = draw_buf->buf1;
+    uint32_t size = draw_buf->size * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*Draw the image normally and transformed*/
+static uint32_t draw_hash(const void * src)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, 10, 10);
+    img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, src);
+    lv_obj_set_pos(img, 150, 50);
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 400);
+    return render_hash();
+}
+
+void setUp(void)
+{
+    /*Without the performance and memory monitors, they change in every frame*/
+    lv_obj_add_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_clear_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+    lv_imgpack_close(&pack);
+}
+
+void test_imgpack_file_decodes_like_png(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_file(&pack, pack_path(PACK_DEPTH, compress_names[i])));
+        TEST_ASSERT_NULL(pack.data);
+        check_pack();
+        lv_imgpack_close(&pack);
+    }
+}
+
+void test_imgpack_data_decodes_like_png(void)
+{
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        uint32_t size = load_pack(PACK_DEPTH, compress_names[i]);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_data(&pack, pack_buf, size));
+        check_pack();
+
+        /*The uncompressed images are used from the pack*/
+        const lv_img_dsc_t * img = lv_imgpack_get(&pack, "wink_tca");
+        const uint8_t * data = (const uint8_t *)pack_buf;
+        if(i == 0) {
+            TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR_ALPHA, img->header.cf);
+            TEST_ASSERT_TRUE(img->data > data && img->data + img->data_size <= data + size);
+        }
+        else {
+            TEST_ASSERT_EQUAL(LV_IMG_CF_USER_ENCODED_0, img->header.cf);
+        }
+        lv_imgpack_close(&pack);
+    }
+}
+
+void test_imgpack_draws_like_png(void)
+{
+    uint32_t ref = draw_hash(WINK_PATH);
+    uint32_t ref_cogwheel = draw_hash(COGWHEEL_PATH);
+
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        uint32_t size = load_pack(PACK_DEPTH, compress_names[i]);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_data(&pack, pack_buf, size));
+        TEST_ASSERT_EQUAL_HEX32(ref, draw_hash(lv_imgpack_get(&pack, "wink_tca")));
+        TEST_ASSERT_EQUAL_HEX32(ref_cogwheel, draw_hash(lv_imgpack_get(&pack, "cogwheel")));
+        lv_obj_clean(lv_scr_act());
+        lv_imgpack_close(&pack);
+
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_file(&pack, pack_path(PACK_DEPTH, compress_names[i])));
+        TEST_ASSERT_EQUAL_HEX32(ref, draw_hash(lv_imgpack_get(&pack, "wink_tca")));
+        lv_obj_clean(lv_scr_act());
+        lv_imgpack_close(&pack);
+    }
+}
+
+void test_imgpack_invalid_packs(void)
+{
+    uint8_t * data = (uint8_t *)pack_buf;
+    uint32_t size = load_pack(PACK_DEPTH, "none");
+
+    /*Truncated index or images*/
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, 12));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, 16 + 48 * 2));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, size - 1));
+    TEST_ASSERT_EQUAL_UINT32(0, pack.img_cnt);
+    TEST_ASSERT_NULL(pack.imgs);
+
+    /*Converted for an other color depth*/
+    const char * other = LV_COLOR_DEPTH == 32 ? "16" : "32";
+    size = load_pack(other, "none");
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, size));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_file(&pack, pack_path(other, "lz4")));
+
+    /*Bad magic, names out of order and unknown color format*/
+    size = load_pack(PACK_DEPTH, "none");
+    data[0] = 'X';
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, size));
+    data[0] = 'L';
+    data[16] = 'z';
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, size));
+    data[16] = 'c';
+    data[16 + 44] = LV_IMG_CF_USER_ENCODED_1;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_data(&pack, data, size));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_imgpack_open_file(&pack, "A:nothing.lvip"));
+
+    /*Damaged tiles are not decoded. The first image is "cogwheel".*/
+    uint32_t i;
+    for(i = 1; i < 3; i++) {
+        size = load_pack(PACK_DEPTH, compress_names[i]);
+        uint32_t ofs = get_u32(data + 16 + 32);
+        uint32_t img_size = get_u32(data + 16 + 36);
+        /*Cut the first tile*/
+        uint8_t * tile_ofs = data + ofs + 256 * 4;
+        set_u32(tile_ofs + 4, get_u32(tile_ofs) + 1);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_data(&pack, data, size));
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, lv_imgpack_get(&pack, "cogwheel"), lv_color_black(), 0));
+        TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, 0, 100, line));
+        lv_img_decoder_close(&dsc);
+        lv_imgpack_close(&pack);
+
+        /*Offsets of the tiles out of the image*/
+        size = load_pack(PACK_DEPTH, compress_names[i]);
+        set_u32(tile_ofs + 4, img_size + 1);
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_data(&pack, data, size));
+        TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_open(&dsc, lv_imgpack_get(&pack, "cogwheel"), lv_color_black(), 0));
+        lv_imgpack_close(&pack);
+
+        /*Random data in the tiles*/
+        size = load_pack(PACK_DEPTH, compress_names[i]);
+        uint32_t j;
+        uint32_t seed = 1;
+        for(j = 256 * 4 + 14 * 4; j < img_size; j++) {
+            seed = seed * 1103515245 + 12345;
+            data[ofs + j] = (uint8_t)(seed >> 16);
+        }
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_imgpack_open_data(&pack, data, size));
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, lv_imgpack_get(&pack, "cogwheel"), lv_color_black(), 0));
+        lv_coord_t y;
+        for(y = 0; y < 100; y++) lv_img_decoder_read_line(&dsc, 0, y, 100, line);
+        lv_img_decoder_close(&dsc);
+        lv_imgpack_close(&pack);
+    }
+}
+
+/*The packs for the other color depths are checked against the color conversion of LVGL*/
+void test_imgpack_converts_to_every_color_depth(void)
+{
+    uint8_t * rgba = NULL;
+    unsigned w;
+    unsigned h;
+    TEST_ASSERT_EQUAL(0, lodepng_decode32_file(&rgba, &w, &h, WINK_PATH));
+
+    static const char * depths[] = {"8", "16", "16swap", "32"};
+    uint32_t d;
+    for(d = 0; d < 4; d++) {
+        const uint8_t * data = (const uint8_t *)pack_buf;
+        load_pack(depths[d], "none");
+        TEST_ASSERT_EQUAL_MEMORY("LVIP", data, 4);
+        TEST_ASSERT_EQUAL(d == 0 ? 8 : d == 3 ? 32 : 16, data[5]);
+
+        /*The index is sorted: cogwheel, wink, wink_a8, wink_tc, wink_tca*/
+        const uint8_t * entry = data + 16 + 3 * 48;
+        TEST_ASSERT_EQUAL_STRING("wink_tc", (const char *)entry);
+        TEST_ASSERT_EQUAL(LV_IMG_CF_TRUE_COLOR, entry[44]);
+        const uint8_t * px = data + get_u32(entry + 32);
+
+        uint32_t i;
+        for(i = 0; i < w * h; i++) {
+            uint8_t r = rgba[i * 4];
+            uint8_t g = rgba[i * 4 + 1];
+            uint8_t b = rgba[i * 4 + 2];
+            if(d == 0) {
+                TEST_ASSERT_EQUAL_HEX8((r >> 5) << 5 | (g >> 5) << 2 | b >> 6, px[i]);
+            }
+            else if(d == 3) {
+                TEST_ASSERT_EQUAL_HEX8(b, px[i * 4]);
+                TEST_ASSERT_EQUAL_HEX8(g, px[i * 4 + 1]);
+                TEST_ASSERT_EQUAL_HEX8(r, px[i * 4 + 2]);
+                TEST_ASSERT_EQUAL_HEX8(0xFF, px[i * 4 + 3]);
+            }
+            else {
+                uint16_t c = (r >> 3) << 11 | (g >> 2) << 5 | b >> 3;
+                uint16_t stored = d == 2 ? (px[i * 2] << 8 | px[i * 2 + 1]) : (px[i * 2] | px[i * 2 + 1] << 8);
+                TEST_ASSERT_EQUAL_HEX16(c, stored);
+            }
+        }
+
+        /*RGB565A8 with 16 bit colors and the alpha plane after the colors*/
+        entry = data + 16 + 48;
+        TEST_ASSERT_EQUAL_STRING("wink", (const char *)entry);
+        TEST_ASSERT_EQUAL(d == 1 || d == 2 ? LV_IMG_CF_RGB565A8 : LV_IMG_CF_TRUE_COLOR_ALPHA, entry[44]);
+        if(entry[44] == LV_IMG_CF_RGB565A8) {
+            px = data + get_u32(entry + 32) + w * h * 2;
+            for(i = 0; i < w * h; i++) TEST_ASSERT_EQUAL_HEX8(rgba[i * 4 + 3], px[i]);
+        }
+    }
+
+    lv_mem_free(rgba);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_imgpack_file_decodes_like_png(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_IMGPACK, LV_USE_PNG and LV_USE_FS_STDIO");
+}
+
+void test_imgpack_data_decodes_like_png(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_IMGPACK, LV_USE_PNG and LV_USE_FS_STDIO");
+}
+
+void test_imgpack_draws_like_png(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_IMGPACK, LV_USE_PNG and LV_USE_FS_STDIO");
+}
+
+void test_imgpack_invalid_packs(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_IMGPACK, LV_USE_PNG and LV_USE_FS_STDIO");
+}
+
+void test_imgpack_converts_to_every_color_depth(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_IMGPACK, LV_USE_PNG and LV_USE_FS_STDIO");
+}
+
+#endif
+
+#endif
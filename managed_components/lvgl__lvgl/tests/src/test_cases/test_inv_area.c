@@ -0,0 +1,107 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+static lv_disp_t * disp;
+
+void setUp(void)
+{
+    disp = lv_disp_get_default();
+    lv_obj_clean(lv_scr_act());
+    lv_refr_now(disp);
+    lv_memset_00(&disp->inv_stats, sizeof(disp->inv_stats));
+}
+
+void tearDown(void)
+{
+    /* Function run after every test */
+}
+
+static void inv_area(lv_coord_t x, lv_coord_t y, lv_coord_t w, lv_coord_t h)
+{
+    lv_area_t a = {x, y, x + w - 1, y + h - 1};
+    _lv_inv_area(disp, &a);
+}
+
+void test_inv_area_close_areas_are_joined(void)
+{
+    inv_area(100, 100, 20, 10);
+    inv_area(125, 100, 20, 10);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_stats.areas_in);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_stats.areas_out);
+    TEST_ASSERT_EQUAL_UINT32(5 * 10, disp->inv_stats.overdraw_px);
+}
+
+void test_inv_area_distant_areas_are_not_joined(void)
+{
+    inv_area(10, 10, 20, 10);
+    inv_area(700, 400, 20, 10);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_stats.areas_in);
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_stats.areas_out);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_stats.overdraw_px);
+}
+
+void test_inv_area_overlapping_areas_count_only_new_pixels_as_overdraw(void)
+{
+    inv_area(100, 100, 20, 20);
+    inv_area(110, 110, 20, 20);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_stats.areas_out);
+    /*30x30 joined area, 20x20 + 20x20 - 10x10 was invalidated*/
+    TEST_ASSERT_EQUAL_UINT32(30 * 30 - 700, disp->inv_stats.overdraw_px);
+}
+
+void test_inv_area_many_areas_should_not_redraw_the_screen(void)
+{
+    /*Like a dashboard with many small ticking labels*/
+    lv_area_t areas[64];
+    uint32_t i;
+    for(i = 0; i < 64; i++) {
+        areas[i].x1 = (i % 8) * 100;
+        areas[i].y1 = (i / 8) * 60;
+        areas[i].x2 = areas[i].x1 + 39;
+        areas[i].y2 = areas[i].y1 + 15;
+        _lv_inv_area(disp, &areas[i]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT16(LV_INV_BUF_SIZE, disp->inv_p);
+
+    /*Every invalidated area is still covered but not by the whole screen*/
+    uint32_t scr_size = lv_disp_get_hor_res(disp) * lv_disp_get_ver_res(disp);
+    for(i = 0; i < 64; i++) {
+        bool covered = false;
+        uint32_t j;
+        for(j = 0; j < disp->inv_p; j++) {
+            TEST_ASSERT_LESS_THAN_UINT32(scr_size, lv_area_get_size(&disp->inv_areas[j]));
+            if(_lv_area_is_in(&areas[i], &disp->inv_areas[j], 0)) covered = true;
+        }
+        TEST_ASSERT_TRUE(covered);
+    }
+
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(64, disp->inv_stats.areas_in);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(LV_INV_BUF_SIZE, disp->inv_stats.areas_out);
+    TEST_ASSERT_LESS_THAN_UINT32(scr_size / 2, disp->inv_stats.overdraw_px);
+}
+
+void test_inv_area_contained_area_is_not_saved(void)
+{
+    inv_area(100, 100, 50, 50);
+    inv_area(110, 110, 10, 10);
+
+    TEST_ASSERT_EQUAL_UINT16(1, disp->inv_p);
+    lv_refr_now(disp);
+
+    TEST_ASSERT_EQUAL_UINT32(2, disp->inv_stats.areas_in);
+    TEST_ASSERT_EQUAL_UINT32(1, disp->inv_stats.areas_out);
+    TEST_ASSERT_EQUAL_UINT32(0, disp->inv_stats.overdraw_px);
+}
+
+#endif
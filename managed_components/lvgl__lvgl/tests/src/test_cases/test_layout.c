@@ -0,0 +1,172 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define ROW_CNT     6
+#define COL_CNT     8
+
+static lv_obj_t * scr;
+static lv_obj_t * cont;
+static lv_obj_t * rows[ROW_CNT];
+static lv_obj_t * labels[ROW_CNT][COL_CNT];
+
+/*A flex column of flex rows of labels*/
+static void create_flex_screen(void)
+{
+    cont = lv_obj_create(scr);
+    lv_obj_set_size(cont, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_COLUMN);
+
+    uint32_t r;
+    for(r = 0; r < ROW_CNT; r++) {
+        rows[r] = lv_obj_create(cont);
+        lv_obj_set_size(rows[r], lv_pct(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(rows[r], LV_FLEX_FLOW_ROW_WRAP);
+        uint32_t c;
+        for(c = 0; c < COL_CNT; c++) {
+            labels[r][c] = lv_label_create(rows[r]);
+            lv_label_set_text_fmt(labels[r][c], "%d", (int)c);
+        }
+    }
+    lv_obj_update_layout(scr);
+}
+
+/*Check that the coordinates are the same as the ones of a screen laid out from scratch*/
+static void check_coords_from_scratch(void)
+{
+    lv_obj_t * scr2 = lv_obj_create(NULL);
+    lv_obj_t * cont2 = lv_obj_create(scr2);
+    lv_obj_set_size(cont2, lv_pct(100), lv_pct(100));
+    lv_obj_set_flex_flow(cont2, LV_FLEX_FLOW_COLUMN);
+    lv_obj_set_style_pad_hor(cont2, lv_obj_get_style_pad_left(cont, 0), 0);
+
+    uint32_t r;
+    for(r = 0; r < ROW_CNT; r++) {
+        lv_obj_t * row2 = lv_obj_create(cont2);
+        lv_obj_set_size(row2, lv_pct(100), LV_SIZE_CONTENT);
+        lv_obj_set_flex_flow(row2, LV_FLEX_FLOW_ROW_WRAP);
+        lv_obj_set_style_pad_column(row2, lv_obj_get_style_pad_column(rows[r], 0), 0);
+        uint32_t c;
+        for(c = 0; c < COL_CNT; c++) {
+            lv_obj_t * label2 = lv_label_create(row2);
+            lv_label_set_text(label2, lv_label_get_text(labels[r][c]));
+        }
+    }
+    lv_obj_update_layout(scr2);
+
+    for(r = 0; r < ROW_CNT; r++) {
+        lv_obj_t * row2 = lv_obj_get_child(cont2, r);
+        TEST_ASSERT_EQUAL_MEMORY(&row2->coords, &rows[r]->coords, sizeof(lv_area_t));
+        uint32_t c;
+        for(c = 0; c < COL_CNT; c++) {
+            lv_obj_t * label2 = lv_obj_get_child(row2, c);
+            TEST_ASSERT_EQUAL_MEMORY(&label2->coords, &labels[r][c]->coords, sizeof(lv_area_t));
+        }
+    }
+
+    lv_obj_del(scr2);
+}
+
+void setUp(void)
+{
+    scr = lv_obj_create(NULL);
+    create_flex_screen();
+    lv_obj_layout_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_del(scr);
+}
+
+void test_layout_visits_only_the_dirty_branch(void)
+{
+    lv_label_set_text(labels[5][0], "a longer text");
+    lv_obj_update_layout(scr);
+
+    /*At most the screen, the container, the row and the label in a pass*/
+    lv_obj_layout_stats_t stats;
+    lv_obj_layout_get_stats(&stats);
+    TEST_ASSERT_GREATER_THAN(0, stats.updates);
+    TEST_ASSERT_LESS_OR_EQUAL(4 * stats.updates, stats.visited);
+    check_coords_from_scratch();
+
+    /*Nothing to do*/
+    lv_obj_layout_reset_stats();
+    lv_obj_update_layout(scr);
+    lv_obj_layout_get_stats(&stats);
+    TEST_ASSERT_EQUAL(0, stats.visited);
+}
+
+void test_layout_of_resized_flex_doesnt_measure_the_children_again(void)
+{
+    /*The rows change their width, but the labels keep their size*/
+    lv_obj_set_style_pad_hor(cont, 40, 0);
+    lv_obj_update_layout(scr);
+
+    lv_obj_layout_stats_t stats;
+    lv_obj_layout_get_stats(&stats);
+    TEST_ASSERT_LESS_THAN(ROW_CNT * COL_CNT, stats.refreshed);
+    check_coords_from_scratch();
+
+    /*A row wraps the labels if it's narrow*/
+    lv_obj_set_style_pad_hor(cont, lv_obj_get_width(cont) / 2 - 20, 0);
+    lv_obj_update_layout(scr);
+    TEST_ASSERT_GREATER_THAN(lv_obj_get_y(labels[0][0]), lv_obj_get_y(labels[0][COL_CNT - 1]));
+    check_coords_from_scratch();
+
+    /*The gap of a row moves only its labels*/
+    lv_obj_set_style_pad_column(rows[3], 30, 0);
+    lv_obj_update_layout(scr);
+    check_coords_from_scratch();
+}
+
+void test_layout_updates_the_children_depending_on_the_parent_size(void)
+{
+    lv_obj_t * parent = lv_obj_create(scr);
+    lv_obj_set_size(parent, 200, 100);
+    lv_obj_set_flex_flow(parent, LV_FLEX_FLOW_ROW);
+    lv_obj_set_style_pad_all(parent, 0, 0);
+    lv_obj_set_style_border_width(parent, 0, 0);
+
+    /*Sized in percentage in the flex container*/
+    lv_obj_t * pct_child = lv_obj_create(parent);
+    lv_obj_set_size(pct_child, lv_pct(50), lv_pct(50));
+
+    /*Aligned without layout*/
+    lv_obj_t * aligned = lv_obj_create(parent);
+    lv_obj_add_flag(aligned, LV_OBJ_FLAG_IGNORE_LAYOUT);
+    lv_obj_set_size(aligned, 20, 20);
+    lv_obj_align(aligned, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+    lv_obj_update_layout(scr);
+
+    TEST_ASSERT_EQUAL(100, lv_obj_get_width(pct_child));
+    TEST_ASSERT_EQUAL(180, lv_obj_get_x(aligned));
+
+    lv_obj_set_size(parent, 300, 200);
+    lv_obj_update_layout(scr);
+    TEST_ASSERT_EQUAL(150, lv_obj_get_width(pct_child));
+    TEST_ASSERT_EQUAL(100, lv_obj_get_height(pct_child));
+    TEST_ASSERT_EQUAL(280, lv_obj_get_x(aligned));
+    TEST_ASSERT_EQUAL(180, lv_obj_get_y(aligned));
+}
+
+void test_layout_readjusts_the_scroll_after_delete(void)
+{
+    lv_obj_t * parent = lv_obj_create(scr);
+    lv_obj_set_size(parent, 100, 100);
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_set_size(child, 50, 300);
+    lv_obj_update_layout(scr);
+
+    lv_obj_scroll_to_y(parent, 200, LV_ANIM_OFF);
+    TEST_ASSERT_GREATER_THAN(0, lv_obj_get_scroll_y(parent));
+
+    /*Nothing to scroll anymore*/
+    lv_obj_del(child);
+    lv_obj_update_layout(scr);
+    TEST_ASSERT_EQUAL(0, lv_obj_get_scroll_y(parent));
+}
+
+#endif
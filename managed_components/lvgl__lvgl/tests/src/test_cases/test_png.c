@@ -0,0 +1,368 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+#include "../src/extra/libs/png/lodepng.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_PNG
+
+#define PNG_PATH    "A:../../../qr_data/wink.png"
+#define W           37
+#define H           23
+
+/*The encoder of LodePNG needs a few hundred kB*/
+#define ENCODER_MEM (LV_MEM_CUSTOM || LV_MEM_SIZE >= 1024 * 1024)
+
+#if ENCODER_MEM
+static uint8_t raw[W * H * 8];
+static uint8_t pixels[W * H * LV_IMG_PX_SIZE_ALPHA_BYTE];
+static uint8_t line[W * LV_IMG_PX_SIZE_ALPHA_BYTE];
+
+/*Rows of gradients and repeated patterns compress to Huffman codes with references, the random rows don't*/
+static void fill_raw(uint32_t size)
+{
+    uint32_t seed = 12345;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        seed = seed * 1103515245 + 12345;
+        uint32_t y = i * H / size;
+        if(y % 3 == 0) raw[i] = (uint8_t)(seed >> 16);
+        else if(y % 3 == 1) raw[i] = (uint8_t)(i * 7);
+        else raw[i] = (uint8_t)((i / 11) & 0x5A);
+    }
+}
+
+/*Encode `raw` as it is in the given mode*/
+static uint8_t * encode(LodePNGColorType color_type, uint32_t bit_depth, uint32_t btype, bool key,
+                        uint32_t interlace, size_t * size)
+{
+    LodePNGState state;
+    lodepng_state_init(&state);
+    state.encoder.auto_convert = 0;
+    state.encoder.zlibsettings.btype = btype;
+    state.info_png.interlace_method = interlace;
+
+    LodePNGColorMode * modes[2] = {&state.info_raw, &state.info_png.color};
+    uint32_t m;
+    for(m = 0; m < 2; m++) {
+        modes[m]->colortype = color_type;
+        modes[m]->bitdepth = bit_depth;
+        if(color_type == LCT_PALETTE) {
+            /*Half of the colors are transparent. The indices above the palette are drawn black.*/
+            uint32_t i;
+            uint32_t cnt = (1 << bit_depth) - (bit_depth > 1 ? 3 : 0);
+            for(i = 0; i < cnt; i++) {
+                lodepng_palette_add(modes[m], (uint8_t)(i * 53), (uint8_t)(i * 101), (uint8_t)(255 - i * 7),
+                                    i & 1 ? 255 : (uint8_t)(i * 17));
+            }
+        }
+        if(key) {
+            modes[m]->key_defined = 1;
+            modes[m]->key_r = raw[0] << (bit_depth == 16 ? 8 : 0) | (bit_depth == 16 ? raw[1] : 0);
+            if(bit_depth < 8) modes[m]->key_r = raw[0] >> (8 - bit_depth);
+            modes[m]->key_g = color_type == LCT_RGB ? (bit_depth == 16 ? (raw[2] << 8 | raw[3]) : raw[1]) : 0;
+            modes[m]->key_b = color_type == LCT_RGB ? (bit_depth == 16 ? (raw[4] << 8 | raw[5]) : raw[2]) : 0;
+        }
+    }
+
+    uint8_t * png = NULL;
+    uint32_t error = lodepng_encode(&png, size, raw, W, H, &state);
+    lodepng_state_cleanup(&state);
+    TEST_ASSERT_EQUAL_UINT32_MESSAGE(0, error, lodepng_error_text(error));
+    return png;
+}
+
+/*Check a pixel of the decoder against the RGBA8888 pixel of LodePNG*/
+static void check_px(const uint8_t * px, const uint8_t * rgba, bool alpha)
+{
+    lv_color_t c;
+    lv_memcpy(&c, px, sizeof(lv_color_t));
+    lv_color_t ref = lv_color_make(rgba[0], rgba[1], rgba[2]);
+    TEST_ASSERT_EQUAL_UINT8(LV_COLOR_GET_R(ref), LV_COLOR_GET_R(c));
+    TEST_ASSERT_EQUAL_UINT8(LV_COLOR_GET_G(ref), LV_COLOR_GET_G(c));
+    TEST_ASSERT_EQUAL_UINT8(LV_COLOR_GET_B(ref), LV_COLOR_GET_B(c));
+    if(alpha) TEST_ASSERT_EQUAL_UINT8(rgba[3], px[LV_IMG_PX_SIZE_ALPHA_BYTE - 1]);
+}
+
+/*Decode a PNG in memory with the decoder and compare it with LodePNG*/
+static void check_decode(const uint8_t * png, size_t size, bool alpha)
+{
+    uint8_t * ref = NULL;
+    unsigned w;
+    unsigned h;
+    TEST_ASSERT_EQUAL_UINT32(0, lodepng_decode32(&ref, &w, &h, png, size));
+
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.data = png;
+    img_dsc.data_size = size;
+
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(&img_dsc, &header));
+    TEST_ASSERT_EQUAL(alpha ? LV_IMG_CF_TRUE_COLOR_ALPHA : LV_IMG_CF_TRUE_COLOR, header.cf);
+    TEST_ASSERT_EQUAL(W, header.w);
+    TEST_ASSERT_EQUAL(H, header.h);
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    uint32_t px_size = alpha ? LV_IMG_PX_SIZE_ALPHA_BYTE : sizeof(lv_color_t);
+    uint32_t x;
+    uint32_t y;
+
+    if(dsc.img_data == NULL) {
+        /*Whole image*/
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_decode(&dsc, pixels));
+        for(y = 0; y < H; y++) {
+            for(x = 0; x < W; x++) check_px(&pixels[(y * W + x) * px_size], &ref[(y * W + x) * 4], alpha);
+        }
+
+        /*Parts of the lines, backward too*/
+        for(y = 0; y < H; y++) {
+            uint32_t row = (y * 7) % H;
+            uint32_t x1 = (y * 5) % W;
+            uint32_t len = W - x1;
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, x1, row, len, line));
+            for(x = 0; x < len; x++) check_px(&line[x * px_size], &ref[(row * W + x1 + x) * 4], alpha);
+        }
+
+        /*The whole image again after reading lines*/
+        lv_memset_00(pixels, sizeof(pixels));
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_decode(&dsc, pixels));
+        check_px(&pixels[(W * H - 1) * px_size], &ref[(W * H - 1) * 4], alpha);
+    }
+    else {
+        /*Interlaced images are decoded at once*/
+        for(y = 0; y < H; y++) {
+            for(x = 0; x < W; x++) check_px(&dsc.img_data[(y * W + x) * px_size], &ref[(y * W + x) * 4], alpha);
+        }
+    }
+
+    lv_img_decoder_close(&dsc);
+    lv_mem_free(ref);
+}
+
+static void check_mode(LodePNGColorType color_type, uint32_t bit_depth, bool key, bool alpha)
+{
+    uint32_t btype;
+    for(btype = 0; btype <= 2; btype++) {
+        size_t size;
+        uint8_t * png = encode(color_type, bit_depth, btype, key, 0, &size);
+        check_decode(png, size, alpha);
+        lv_mem_free(png);
+    }
+}
+
+#endif
+
+#if LV_IMG_CACHE_DEF_SIZE && LV_USE_FS_STDIO
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(lv_disp_get_default());
+    const uint8_t * p = draw_buf->buf1;
+    uint32_t size = draw_buf->size * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+#endif
+
+void setUp(void)
+{
+    /*Without the performance and memory monitors, they change in every frame*/
+    lv_obj_add_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+#if ENCODER_MEM
+    fill_raw(sizeof(raw));
+#endif
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_clear_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_set_budget(LV_IMG_CACHE_DEF_BUDGET);
+    lv_img_cache_invalidate_src(NULL);
+#endif
+}
+
+#if ENCODER_MEM
+void test_png_decodes_every_color_type(void)
+{
+    check_mode(LCT_GREY, 1, false, false);
+    check_mode(LCT_GREY, 2, false, false);
+    check_mode(LCT_GREY, 4, true, true);
+    check_mode(LCT_GREY, 8, false, false);
+    check_mode(LCT_GREY, 8, true, true);
+    check_mode(LCT_GREY, 16, true, true);
+    check_mode(LCT_RGB, 8, false, false);
+    check_mode(LCT_RGB, 8, true, true);
+    check_mode(LCT_RGB, 16, true, true);
+    check_mode(LCT_PALETTE, 1, false, true);
+    check_mode(LCT_PALETTE, 2, false, true);
+    check_mode(LCT_PALETTE, 4, false, true);
+    check_mode(LCT_PALETTE, 8, false, true);
+    check_mode(LCT_GREY_ALPHA, 8, false, true);
+    check_mode(LCT_GREY_ALPHA, 16, false, true);
+    check_mode(LCT_RGBA, 8, false, true);
+    check_mode(LCT_RGBA, 16, false, true);
+}
+
+void test_png_interlaced_and_split_data(void)
+{
+    size_t size;
+    uint8_t * png = encode(LCT_RGBA, 8, 2, false, 1, &size);
+    check_decode(png, size, true);
+    lv_mem_free(png);
+
+    /*Split the image data into small IDAT chunks*/
+    png = encode(LCT_RGB, 8, 2, false, 0, &size);
+    const uint8_t * idat = lodepng_chunk_find_const(png + 8, png + size, "IDAT");
+    TEST_ASSERT_NOT_NULL(idat);
+    uint32_t idat_len = lodepng_chunk_length(idat);
+
+    uint8_t * split = NULL;
+    size_t split_size = idat - png;
+    split = lv_mem_alloc(split_size);
+    lv_memcpy(split, png, split_size);
+    uint32_t i;
+    for(i = 0; i < idat_len; i += 100) {
+        uint32_t len = LV_MIN(100, idat_len - i);
+        TEST_ASSERT_EQUAL_UINT32(0, lodepng_chunk_create(&split, &split_size, len, "IDAT",
+                                                         lodepng_chunk_data_const(idat) + i));
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, lodepng_chunk_create(&split, &split_size, 0, "IEND", NULL));
+    lv_mem_free(png);
+
+    check_decode(split, split_size, false);
+    lv_mem_free(split);
+}
+
+void test_png_invalid_data(void)
+{
+    size_t size;
+    uint8_t * png = encode(LCT_RGBA, 8, 2, false, 0, &size);
+
+    lv_img_dsc_t img_dsc;
+    lv_memset_00(&img_dsc, sizeof(img_dsc));
+    img_dsc.data = png;
+
+    /*Truncated in the image data: it's opened but its last rows can't be read*/
+    img_dsc.data_size = size / 2;
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 0, W, line));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_read_line(&dsc, 0, H - 1, W, line));
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_decode(&dsc, pixels));
+    lv_img_decoder_close(&dsc);
+
+    /*Truncated in the header*/
+    img_dsc.data_size = 30;
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_INV, lv_img_decoder_get_info(&img_dsc, &header));
+
+    /*Corrupted compressed data*/
+    img_dsc.data_size = size;
+    const uint8_t * idat = lodepng_chunk_find_const(png + 8, png + size, "IDAT");
+    uint8_t * data = (uint8_t *)lodepng_chunk_data_const(idat);
+    for(size_t i = 2; i < lodepng_chunk_length(idat); i += 3) data[i] ^= 0x5A;
+    if(lv_img_decoder_open(&dsc, &img_dsc, lv_color_black(), 0) == LV_RES_OK) {
+        lv_img_decoder_decode(&dsc, pixels);
+        lv_img_decoder_close(&dsc);
+    }
+
+    lv_mem_free(png);
+}
+
+#else
+
+void test_png_decodes_every_color_type(void)
+{
+    TEST_IGNORE_MESSAGE("Only with a heap for the PNG encoder");
+}
+
+void test_png_interlaced_and_split_data(void)
+{
+    TEST_IGNORE_MESSAGE("Only with a heap for the PNG encoder");
+}
+
+void test_png_invalid_data(void)
+{
+    TEST_IGNORE_MESSAGE("Only with a heap for the PNG encoder");
+}
+
+#endif
+
+void test_png_draws_the_same_pixels_from_lines(void)
+{
+#if LV_IMG_CACHE_DEF_SIZE && LV_USE_FS_STDIO
+    lv_obj_t * img = lv_img_create(lv_scr_act());
+    lv_img_set_src(img, PNG_PATH);
+    lv_obj_set_pos(img, 10, 10);
+
+    lv_obj_t * img_zoomed = lv_img_create(lv_scr_act());
+    lv_img_set_src(img_zoomed, PNG_PATH);
+    lv_obj_set_pos(img_zoomed, 100, 10);
+    lv_img_set_zoom(img_zoomed, 512);
+    lv_img_set_angle(img_zoomed, 300);
+
+    /*Cached, decoded into the cache's buffer*/
+    uint32_t ref = render_hash();
+    _lv_img_cache_entry_t * e = _lv_img_cache_open(PNG_PATH, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_FALSE(e->transient);
+    TEST_ASSERT_NOT_NULL(e->dec_dsc.img_data);
+    _lv_img_cache_release(e);
+
+    /*Not cached, drawn line by line and decoded temporarily for the transformation*/
+    lv_img_cache_set_budget(1000);
+    e = _lv_img_cache_open(PNG_PATH, lv_color_black(), 0);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_TRUE(e->transient);
+    TEST_ASSERT_NULL(e->dec_dsc.img_data);
+    _lv_img_cache_release(e);
+
+    TEST_ASSERT_EQUAL_HEX32(ref, render_hash());
+#else
+    TEST_IGNORE_MESSAGE("Only with LV_IMG_CACHE_DEF_SIZE > 0 and LV_USE_FS_STDIO");
+#endif
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_png_decodes_every_color_type(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_PNG");
+}
+
+void test_png_interlaced_and_split_data(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_PNG");
+}
+
+void test_png_invalid_data(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_PNG");
+}
+
+void test_png_draws_the_same_pixels_from_lines(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_USE_PNG");
+}
+
+#endif
+
+#endif
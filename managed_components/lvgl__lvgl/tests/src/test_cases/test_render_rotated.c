@@ -0,0 +1,283 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define NATIVE_HOR_RES  480
+#define NATIVE_VER_RES  854
+#define DRAW_BUF_SIZE   (NATIVE_HOR_RES * NATIVE_VER_RES / 10)
+#define BENCH_FRAME_CNT 50
+
+static lv_color_t fb_rotate_after[NATIVE_HOR_RES * NATIVE_VER_RES];
+static lv_color_t fb_render_rotated[NATIVE_HOR_RES * NATIVE_VER_RES];
+static lv_color_t draw_buf_mem[DRAW_BUF_SIZE];
+static lv_color_t draw_buf_mem2[DRAW_BUF_SIZE];
+static lv_color_t img_map[32 * 32];
+
+static lv_color_t * fb_act;
+static uint32_t flush_cnt;
+
+/*A flush started by `async_flush_cb` and finished later in `async_wait_cb` like a DMA transfer*/
+static lv_area_t pending_area;
+static lv_color_t * pending_color_p;
+static bool pending;
+
+static lv_disp_draw_buf_t draw_buf;
+static lv_disp_drv_t disp_drv;
+static lv_disp_t * disp;
+static lv_disp_t * disp_ori;
+
+static void flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    /*The flushed area is always in the display's native orientation*/
+    TEST_ASSERT_TRUE(area->x1 >= 0 && area->x2 < NATIVE_HOR_RES);
+    TEST_ASSERT_TRUE(area->y1 >= 0 && area->y2 < NATIVE_VER_RES);
+
+    lv_coord_t w = lv_area_get_width(area);
+    lv_coord_t y;
+    for(y = area->y1; y <= area->y2; y++) {
+        lv_memcpy(&fb_act[y * NATIVE_HOR_RES + area->x1], color_p, w * sizeof(lv_color_t));
+        color_p += w;
+    }
+
+    flush_cnt++;
+    lv_disp_flush_ready(drv);
+}
+
+static void async_flush_cb(lv_disp_drv_t * drv, const lv_area_t * area, lv_color_t * color_p)
+{
+    LV_UNUSED(drv);
+    TEST_ASSERT_FALSE(pending);
+    pending_area = *area;
+    pending_color_p = color_p;
+    pending = true;
+}
+
+static void async_flush_complete(lv_disp_drv_t * drv)
+{
+    if(!pending) return;
+
+    /*Read the pixels only now: they are corrupted if LVGL wrote the buffer in the meantime*/
+    pending = false;
+    flush_cb(drv, &pending_area, pending_color_p);
+}
+
+static void async_wait_cb(lv_disp_drv_t * drv)
+{
+    async_flush_complete(drv);
+}
+
+void setUp(void)
+{
+    disp_ori = lv_disp_get_default();
+
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_mem, NULL, DRAW_BUF_SIZE);
+    lv_disp_drv_init(&disp_drv);
+    disp_drv.hor_res = NATIVE_HOR_RES;
+    disp_drv.ver_res = NATIVE_VER_RES;
+    disp_drv.draw_buf = &draw_buf;
+    disp_drv.flush_cb = flush_cb;
+    disp_drv.sw_rotate = 1;
+    disp_drv.rotated = LV_DISP_ROT_270;
+    disp = lv_disp_drv_register(&disp_drv);
+    lv_disp_set_default(disp);
+
+    /*The perf. and memory monitors change between renders*/
+    lv_obj_add_flag(lv_disp_get_layer_sys(disp), LV_OBJ_FLAG_HIDDEN);
+}
+
+void tearDown(void)
+{
+    lv_disp_remove(disp);
+    lv_disp_set_default(disp_ori);
+}
+
+static void create_ui(void)
+{
+    lv_obj_t * scr = lv_scr_act();
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x102040), 0);
+    lv_obj_set_style_bg_grad_color(scr, lv_color_hex(0x405060), 0);
+    lv_obj_set_style_bg_grad_dir(scr, LV_GRAD_DIR_VER, 0);
+
+    lv_obj_t * label = lv_label_create(scr);
+#if LV_FONT_MONTSERRAT_48
+    lv_obj_set_style_text_font(label, &lv_font_montserrat_48, 0);
+#endif
+    lv_label_set_text(label, "12:34:56");
+    lv_obj_align(label, LV_ALIGN_CENTER, 0, -40);
+
+#if LV_FONT_MONTSERRAT_12_SUBPX
+    lv_obj_t * label_subpx = lv_label_create(scr);
+    lv_obj_set_style_text_font(label_subpx, &lv_font_montserrat_12_subpx, 0);
+    lv_label_set_text(label_subpx, "Subpixel rendered text");
+    lv_obj_align(label_subpx, LV_ALIGN_CENTER, 0, 20);
+#endif
+
+    lv_obj_t * btn = lv_btn_create(scr);
+    lv_obj_set_size(btn, 200, 60);
+    lv_obj_set_style_bg_opa(btn, LV_OPA_70, 0);
+    lv_obj_set_style_shadow_width(btn, 20, 0);
+    lv_obj_align(btn, LV_ALIGN_TOP_LEFT, 30, 30);
+
+    lv_obj_t * arc = lv_arc_create(scr);
+    lv_obj_set_size(arc, 150, 150);
+    lv_arc_set_value(arc, 60);
+    lv_obj_align(arc, LV_ALIGN_BOTTOM_RIGHT, -30, -30);
+
+    lv_obj_t * blended = lv_obj_create(scr);
+    lv_obj_set_size(blended, 120, 80);
+    lv_obj_set_style_radius(blended, 20, 0);
+    lv_obj_set_style_bg_color(blended, lv_color_hex(0x808000), 0);
+    lv_obj_set_style_blend_mode(blended, LV_BLEND_MODE_ADDITIVE, 0);
+    lv_obj_align(blended, LV_ALIGN_BOTTOM_LEFT, 30, -30);
+
+    uint32_t i;
+    for(i = 0; i < sizeof(img_map) / sizeof(img_map[0]); i++) {
+        img_map[i] = lv_color_make(i * 8, 255 - (i % 32) * 8, (i / 32) * 8);
+    }
+    static lv_img_dsc_t img_dsc;
+    img_dsc.header.always_zero = 0;
+    img_dsc.header.w = 32;
+    img_dsc.header.h = 32;
+    img_dsc.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img_dsc.data_size = sizeof(img_map);
+    img_dsc.data = (const uint8_t *)img_map;
+
+    lv_obj_t * img = lv_img_create(scr);
+    lv_img_set_src(img, &img_dsc);
+#if LV_DRAW_COMPLEX
+    lv_img_set_angle(img, 300);
+    lv_img_set_zoom(img, 512);
+#endif
+    lv_obj_set_style_img_opa(img, LV_OPA_80, 0);
+    lv_obj_align(img, LV_ALIGN_TOP_RIGHT, -60, 60);
+
+    lv_obj_t * line = lv_line_create(scr);
+    static lv_point_t line_points[] = {{0, 0}, {300, 40}, {500, 0}};
+    lv_line_set_points(line, line_points, 3);
+    lv_obj_set_style_line_width(line, 6, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    lv_obj_align(line, LV_ALIGN_CENTER, 0, 60);
+}
+
+static uint32_t render(lv_color_t * fb, bool render_rotated)
+{
+    fb_act = fb;
+    flush_cnt = 0;
+    disp_drv.render_rotated = render_rotated;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    return flush_cnt;
+}
+
+static void render_and_compare(lv_disp_rot_t rot)
+{
+    lv_disp_set_rotation(disp, rot);
+    lv_obj_update_layout(lv_scr_act());
+
+    lv_memset_00(fb_rotate_after, sizeof(fb_rotate_after));
+    lv_memset_ff(fb_render_rotated, sizeof(fb_render_rotated));
+
+    render(fb_rotate_after, false);
+    render(fb_render_rotated, true);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_rotate_after, fb_render_rotated, sizeof(fb_rotate_after));
+}
+
+void test_render_rotated_270_matches_rotate_after_render(void)
+{
+    create_ui();
+    render_and_compare(LV_DISP_ROT_270);
+}
+
+void test_render_rotated_90_matches_rotate_after_render(void)
+{
+    create_ui();
+    render_and_compare(LV_DISP_ROT_90);
+}
+
+void test_render_rotated_180_matches_rotate_after_render(void)
+{
+    create_ui();
+    render_and_compare(LV_DISP_ROT_180);
+}
+
+void test_render_rotated_partial_area(void)
+{
+    create_ui();
+    lv_disp_set_rotation(disp, LV_DISP_ROT_270);
+    render(fb_render_rotated, true);
+
+    /*Only the label is redrawn: it fits into one draw buffer so it should be flushed once*/
+    lv_obj_t * label = lv_obj_get_child(lv_scr_act(), 0);
+    lv_label_set_text(label, "12:34:57");
+    flush_cnt = 0;
+    lv_refr_now(disp);
+    TEST_ASSERT_EQUAL(1, flush_cnt);
+
+    render(fb_rotate_after, false);
+    TEST_ASSERT_EQUAL_MEMORY(fb_rotate_after, fb_render_rotated, sizeof(fb_rotate_after));
+}
+
+static void render_async_and_compare(lv_disp_rot_t rot, bool render_rotated)
+{
+    lv_disp_set_rotation(disp, rot);
+    render(fb_rotate_after, false);
+
+    /*Double buffering: rendering continues while the previous area is being flushed*/
+    lv_disp_draw_buf_init(&draw_buf, draw_buf_mem, draw_buf_mem2, DRAW_BUF_SIZE);
+    disp_drv.flush_cb = async_flush_cb;
+    disp_drv.wait_cb = async_wait_cb;
+
+    lv_memset_ff(fb_render_rotated, sizeof(fb_render_rotated));
+    render(fb_render_rotated, render_rotated);
+    async_flush_complete(&disp_drv);
+
+    TEST_ASSERT_EQUAL_MEMORY(fb_rotate_after, fb_render_rotated, sizeof(fb_rotate_after));
+}
+
+void test_render_rotated_270_async_flush(void)
+{
+    create_ui();
+    render_async_and_compare(LV_DISP_ROT_270, true);
+}
+
+void test_rotate_after_render_270_async_flush(void)
+{
+    create_ui();
+    render_async_and_compare(LV_DISP_ROT_270, false);
+}
+
+void test_rotate_after_render_90_async_flush(void)
+{
+    create_ui();
+    render_async_and_compare(LV_DISP_ROT_90, false);
+}
+
+void test_render_rotated_frame_time(void)
+{
+    create_ui();
+    lv_disp_set_rotation(disp, LV_DISP_ROT_270);
+
+    uint32_t i;
+    uint32_t flush_rotate_after = 0;
+    uint32_t t = custom_tick_get();
+    for(i = 0; i < BENCH_FRAME_CNT; i++) flush_rotate_after += render(fb_rotate_after, false);
+    uint32_t time_rotate_after = custom_tick_get() - t;
+
+    uint32_t flush_render_rotated = 0;
+    t = custom_tick_get();
+    for(i = 0; i < BENCH_FRAME_CNT; i++) flush_render_rotated += render(fb_render_rotated, true);
+    uint32_t time_render_rotated = custom_tick_get() - t;
+
+    TEST_PRINTF("rotate after render: %d us/frame, %d flush/frame",
+                (int)(time_rotate_after * 1000 / BENCH_FRAME_CNT), (int)(flush_rotate_after / BENCH_FRAME_CNT));
+    TEST_PRINTF("render rotated:      %d us/frame, %d flush/frame",
+                (int)(time_render_rotated * 1000 / BENCH_FRAME_CNT), (int)(flush_render_rotated / BENCH_FRAME_CNT));
+
+    /*One flush per rendered part instead of one per rotated chunk*/
+    TEST_ASSERT_LESS_THAN(flush_rotate_after, flush_render_rotated);
+    TEST_ASSERT_EQUAL_MEMORY(fb_rotate_after, fb_render_rotated, sizeof(fb_rotate_after));
+}
+
+#endif
@@ -0,0 +1,372 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_USE_SJPG && LV_SJPG_CACHE_DEF_BUDGET
+
+#include <pthread.h>
+#include <stdio.h>
+
+/*320x240 pixels in 15 fragments of 16 rows*/
+#define SJPG_PATH       "A:../examples/libs/sjpg/small_image.sjpg"
+#define SJPG_W          320
+#define SJPG_H          240
+#define FRAG_H          16
+#define FRAG_CNT        (SJPG_H / FRAG_H)
+
+/*`test.png` of the application is a JPEG in fact, it's copied to a .jpg file for SJPG*/
+#define JPG_SRC_PATH    "A:../../../qr_data/test.png"
+#define JPG_PATH        "A:/tmp/lv_test_sjpg_cache.jpg"
+
+/*Rows drawn at once and the step of scrolling*/
+#define VIEW_H          64
+#define SCROLL_STEP     8
+
+#define FRAG_SIZE       (SJPG_W * FRAG_H * 3)
+
+#define WORKER_QUEUE_LEN    4
+
+static lv_img_dsc_t sjpg_dsc;
+static uint8_t * sjpg_data;
+static uint32_t * row_hashes;
+
+static uint32_t mem_alloc_cnt;
+static uint32_t mem_free_cnt;
+
+/*A worker thread decoding the submitted jobs in order*/
+static pthread_t worker_thread;
+static pthread_mutex_t worker_mutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t worker_cond = PTHREAD_COND_INITIALIZER;
+static lv_sjpg_job_t * worker_queue[WORKER_QUEUE_LEN];
+static uint32_t worker_queue_cnt;
+static bool worker_quit;
+static uint32_t worker_run_cnt;
+
+static void * worker_main(void * arg)
+{
+    LV_UNUSED(arg);
+    pthread_mutex_lock(&worker_mutex);
+    while(true) {
+        while(worker_queue_cnt == 0 && !worker_quit) pthread_cond_wait(&worker_cond, &worker_mutex);
+        if(worker_queue_cnt == 0) break;
+
+        lv_sjpg_job_t * job = worker_queue[0];
+        worker_queue_cnt--;
+        lv_memcpy(worker_queue, worker_queue + 1, worker_queue_cnt * sizeof(worker_queue[0]));
+        pthread_mutex_unlock(&worker_mutex);
+
+        lv_sjpg_job_run(job);
+
+        pthread_mutex_lock(&worker_mutex);
+        worker_run_cnt++;
+        job->user_data = job;    /*Finished*/
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return NULL;
+}
+
+static bool worker_submit(lv_sjpg_job_t * job)
+{
+    pthread_mutex_lock(&worker_mutex);
+    bool ok = worker_queue_cnt < WORKER_QUEUE_LEN;
+    if(ok) {
+        worker_queue[worker_queue_cnt] = job;
+        worker_queue_cnt++;
+        pthread_cond_broadcast(&worker_cond);
+    }
+    pthread_mutex_unlock(&worker_mutex);
+    return ok;
+}
+
+static void worker_wait(lv_sjpg_job_t * job)
+{
+    pthread_mutex_lock(&worker_mutex);
+    while(job->user_data == NULL) pthread_cond_wait(&worker_cond, &worker_mutex);
+    pthread_mutex_unlock(&worker_mutex);
+}
+
+static void worker_start(void)
+{
+    worker_quit = false;
+    worker_run_cnt = 0;
+    TEST_ASSERT_EQUAL(0, pthread_create(&worker_thread, NULL, worker_main, NULL));
+    lv_sjpg_set_worker(worker_submit, worker_wait);
+}
+
+static void worker_stop(void)
+{
+    lv_sjpg_set_worker(NULL, NULL);
+    pthread_mutex_lock(&worker_mutex);
+    worker_quit = true;
+    pthread_cond_broadcast(&worker_cond);
+    pthread_mutex_unlock(&worker_mutex);
+    pthread_join(worker_thread, NULL);
+}
+
+static void * mem_alloc(size_t size)
+{
+    mem_alloc_cnt++;
+    return lv_mem_alloc(size);
+}
+
+static void mem_free(void * p)
+{
+    mem_free_cnt++;
+    lv_mem_free(p);
+}
+
+static uint8_t * load_file(const char * path, uint32_t * size)
+{
+    lv_fs_file_t f;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, path, LV_FS_MODE_RD));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_END));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_tell(&f, size));
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_seek(&f, 0, LV_FS_SEEK_SET));
+
+    uint8_t * data = lv_mem_alloc(*size);
+    TEST_ASSERT_NOT_NULL(data);
+    uint32_t br;
+    TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_read(&f, data, *size, &br));
+    TEST_ASSERT_EQUAL(*size, br);
+    lv_fs_close(&f);
+    return data;
+}
+
+/*FNV-1a hash of a row*/
+static uint32_t hash_row(const uint8_t * p, uint32_t size)
+{
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+/*Read rows of an opened image and compare them with the rows decoded without cache*/
+static void read_rows(lv_img_decoder_dsc_t * dsc, int32_t y1, int32_t y2)
+{
+    uint8_t line[SJPG_W * sizeof(lv_color_t)];
+    int32_t y;
+    for(y = y1; y <= y2; y++) {
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(dsc, 0, y, SJPG_W, line));
+        TEST_ASSERT_EQUAL_UINT32(row_hashes[y], hash_row(line, sizeof(line)));
+    }
+}
+
+/*Draw a view of the image like an image being scrolled down or up, one step at a time*/
+static void scroll(const void * src, bool down)
+{
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, src, lv_color_black(), 0));
+
+    int32_t i;
+    for(i = 0; i <= (SJPG_H - VIEW_H) / SCROLL_STEP; i++) {
+        /*The whole view is redrawn as the image moves*/
+        int32_t top = down ? i * SCROLL_STEP : SJPG_H - VIEW_H - i * SCROLL_STEP;
+        read_rows(&dsc, top, top + VIEW_H - 1);
+
+        /*The fragments are decoded in advance between the refreshes if there is no worker*/
+        lv_timer_handler();
+    }
+
+    lv_img_decoder_close(&dsc);
+}
+
+static lv_sjpg_cache_stats_t get_stats(void)
+{
+    lv_sjpg_cache_stats_t stats;
+    lv_sjpg_get_cache_stats(&stats);
+    return stats;
+}
+
+void setUp(void)
+{
+    if(sjpg_data == NULL) {
+        uint32_t size;
+        sjpg_data = load_file(SJPG_PATH, &size);
+        sjpg_dsc.header.always_zero = 0;
+        sjpg_dsc.header.cf = LV_IMG_CF_RAW;
+        sjpg_dsc.header.w = SJPG_W;
+        sjpg_dsc.header.h = SJPG_H;
+        sjpg_dsc.data = sjpg_data;
+        sjpg_dsc.data_size = size;
+
+        /*SJPG decodes only the files with .jpg extension*/
+        uint8_t * jpg = load_file(JPG_SRC_PATH, &size);
+        lv_fs_file_t f;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_open(&f, JPG_PATH, LV_FS_MODE_WR));
+        uint32_t bw;
+        TEST_ASSERT_EQUAL(LV_FS_RES_OK, lv_fs_write(&f, jpg, size, &bw));
+        lv_fs_close(&f);
+        lv_mem_free(jpg);
+
+        /*The reference rows are decoded one fragment at a time*/
+        lv_sjpg_set_cache_budget(0);
+        row_hashes = lv_mem_alloc(SJPG_H * sizeof(uint32_t));
+        lv_img_decoder_dsc_t dsc;
+        TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+        uint8_t line[SJPG_W * sizeof(lv_color_t)];
+        uint32_t y;
+        for(y = 0; y < SJPG_H; y++) {
+            TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, y, SJPG_W, line));
+            row_hashes[y] = hash_row(line, sizeof(line));
+        }
+        lv_img_decoder_close(&dsc);
+    }
+
+    lv_sjpg_set_cache_budget(LV_SJPG_CACHE_DEF_BUDGET);
+    lv_sjpg_reset_cache_stats();
+}
+
+void tearDown(void)
+{
+    lv_sjpg_set_cache_mem_cb(NULL, NULL);
+    lv_sjpg_set_cache_budget(LV_SJPG_CACHE_DEF_BUDGET);
+}
+
+void test_scrolling_decodes_each_fragment_once(void)
+{
+    const void * srcs[] = {SJPG_PATH, &sjpg_dsc};
+    uint32_t i;
+    for(i = 0; i < sizeof(srcs) / sizeof(srcs[0]); i++) {
+        /*Without the cache the fragment at the edge of the view is decoded again in every step*/
+        lv_sjpg_set_cache_budget(0);
+        lv_sjpg_reset_cache_stats();
+        scroll(srcs[i], true);
+        uint32_t decodes_uncached = get_stats().decodes;
+
+        lv_sjpg_set_cache_budget(FRAG_CNT * (FRAG_SIZE + 64));
+        lv_sjpg_reset_cache_stats();
+        scroll(srcs[i], true);
+        lv_sjpg_cache_stats_t stats = get_stats();
+        printf("%s: %u decodes without the cache; %u decodes, %u in advance (%u used) with it\n",
+               i == 0 ? "file" : "variable", (unsigned)decodes_uncached, (unsigned)stats.decodes,
+               (unsigned)stats.prefetches, (unsigned)stats.prefetch_hits);
+
+        TEST_ASSERT_GREATER_THAN_UINT32(FRAG_CNT, decodes_uncached);
+        TEST_ASSERT_EQUAL_UINT32(FRAG_CNT, stats.decodes + stats.prefetches);
+        /*Only the fragments of the first view are needed before they could be decoded in advance*/
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(VIEW_H / FRAG_H, stats.decodes);
+        TEST_ASSERT_EQUAL_UINT32(stats.prefetches, stats.prefetch_hits);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.worker_decodes);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.evictions);
+
+        /*The closed image's fragments are removed*/
+        TEST_ASSERT_EQUAL_UINT32(0, stats.frag_cnt);
+        TEST_ASSERT_EQUAL_UINT32(0, stats.size);
+    }
+}
+
+void test_scrolling_up_prefetches_upwards(void)
+{
+    lv_sjpg_set_cache_budget(FRAG_CNT * (FRAG_SIZE + 64));
+    scroll(SJPG_PATH, false);
+
+    lv_sjpg_cache_stats_t stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(FRAG_CNT, stats.decodes + stats.prefetches);
+    /*The direction is known after the first step up*/
+    TEST_ASSERT_GREATER_OR_EQUAL_UINT32(FRAG_CNT - VIEW_H / FRAG_H - 1, stats.prefetch_hits);
+}
+
+void test_worker_decodes_in_advance(void)
+{
+    const void * srcs[] = {SJPG_PATH, &sjpg_dsc};
+    uint32_t i;
+    for(i = 0; i < sizeof(srcs) / sizeof(srcs[0]); i++) {
+        lv_sjpg_set_cache_budget(FRAG_CNT * (FRAG_SIZE + 64));
+        lv_sjpg_reset_cache_stats();
+        worker_start();
+        scroll(srcs[i], true);
+        scroll(srcs[i], false);
+        worker_stop();
+
+        lv_sjpg_cache_stats_t stats = get_stats();
+        printf("%s: %u decodes, %u by the worker\n", i == 0 ? "file" : "variable", (unsigned)stats.decodes,
+               (unsigned)stats.worker_decodes);
+
+        TEST_ASSERT_EQUAL_UINT32(worker_run_cnt, stats.worker_decodes);
+        TEST_ASSERT_EQUAL_UINT32(stats.prefetches, stats.worker_decodes);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, stats.worker_decodes);
+        TEST_ASSERT_EQUAL_UINT32(2 * FRAG_CNT, stats.decodes + stats.prefetches);
+    }
+}
+
+void test_budget_and_memory(void)
+{
+    /*Only 2 fragments fit*/
+    lv_sjpg_set_cache_mem_cb(mem_alloc, mem_free);
+    lv_sjpg_set_cache_budget(2 * (FRAG_SIZE + 64));
+    mem_alloc_cnt = 0;
+    mem_free_cnt = 0;
+
+    lv_img_decoder_dsc_t dsc;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, SJPG_PATH, lv_color_black(), 0));
+    read_rows(&dsc, 0, SJPG_H - 1);
+
+    lv_sjpg_cache_stats_t stats = get_stats();
+    TEST_ASSERT_GREATER_THAN_UINT32(0, stats.evictions);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2 * (FRAG_SIZE + 64), stats.size);
+    TEST_ASSERT_LESS_OR_EQUAL_UINT32(2, stats.frag_cnt);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, mem_alloc_cnt);
+
+    /*Reading the rows backwards after the fragments were evicted*/
+    read_rows(&dsc, SJPG_H / 2, SJPG_H - 1);
+    read_rows(&dsc, 0, SJPG_H / 2 - 1);
+
+    lv_img_decoder_close(&dsc);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL_UINT32(mem_alloc_cnt, mem_free_cnt);
+
+    /*A JPG larger than the budget is decoded without caching it*/
+    lv_sjpg_reset_cache_stats();
+    lv_img_header_t header;
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_get_info(JPG_PATH, &header));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_open(&dsc, JPG_PATH, lv_color_black(), 0));
+    uint8_t * line = lv_mem_alloc(header.w * sizeof(lv_color_t));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, 0, header.w, line));
+    TEST_ASSERT_EQUAL(LV_RES_OK, lv_img_decoder_read_line(&dsc, 0, header.h - 1, header.w, line));
+    lv_mem_free(line);
+    lv_img_decoder_close(&dsc);
+
+    stats = get_stats();
+    TEST_ASSERT_EQUAL_UINT32(1, stats.decodes);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.frag_cnt);
+    TEST_ASSERT_EQUAL_UINT32(mem_alloc_cnt, mem_free_cnt);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_scrolling_decodes_each_fragment_once(void)
+{
+    TEST_IGNORE_MESSAGE("Needs LV_USE_SJPG and LV_SJPG_CACHE_DEF_BUDGET");
+}
+
+void test_scrolling_up_prefetches_upwards(void)
+{
+    TEST_IGNORE_MESSAGE("Needs LV_USE_SJPG and LV_SJPG_CACHE_DEF_BUDGET");
+}
+
+void test_worker_decodes_in_advance(void)
+{
+    TEST_IGNORE_MESSAGE("Needs LV_USE_SJPG and LV_SJPG_CACHE_DEF_BUDGET");
+}
+
+void test_budget_and_memory(void)
+{
+    TEST_IGNORE_MESSAGE("Needs LV_USE_SJPG and LV_SJPG_CACHE_DEF_BUDGET");
+}
+
+#endif
+
+#endif
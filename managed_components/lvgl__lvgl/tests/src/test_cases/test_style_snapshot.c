@@ -0,0 +1,272 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#if LV_OBJ_STYLE_SNAPSHOT_CNT
+
+static lv_obj_style_snapshot_stats_t get_stats(void)
+{
+    lv_obj_style_snapshot_stats_t stats;
+    lv_obj_style_snapshot_get_stats(&stats);
+    return stats;
+}
+
+static uint32_t text_color(const lv_obj_t * obj)
+{
+    return lv_color_to32(lv_obj_get_style_text_color(obj, LV_PART_MAIN));
+}
+
+/*Render the screen and return the FNV-1a hash of its pixels*/
+static uint32_t render_hash(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    lv_disp_draw_buf_t * draw_buf = lv_disp_get_draw_buf(lv_disp_get_default());
+    const uint8_t * p = draw_buf->buf1;
+    uint32_t size = draw_buf->size * sizeof(lv_color_t);
+    uint32_t hash = 2166136261u;
+    uint32_t i;
+    for(i = 0; i < size; i++) {
+        hash = (hash ^ p[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static lv_color_t darken(const lv_color_filter_dsc_t * dsc, lv_color_t color, lv_opa_t opa)
+{
+    LV_UNUSED(dsc);
+    return lv_color_darken(color, opa);
+}
+
+void setUp(void)
+{
+    lv_obj_add_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_style_snapshot_reset_stats();
+}
+
+void tearDown(void)
+{
+    lv_obj_clean(lv_scr_act());
+    lv_obj_clear_flag(lv_layer_sys(), LV_OBJ_FLAG_HIDDEN);
+    lv_obj_enable_style_snapshot(true);
+}
+
+void test_style_snapshot_counts_lookups_avoided(void)
+{
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_set_style_bg_color(obj, lv_color_hex(0xff0000), 0);
+    lv_obj_style_snapshot_reset_stats();
+
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats().misses);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stats().hits);
+
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_UINT32(1, get_stats().misses);
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().hits);
+
+    /*Other parts have their own snapshot*/
+    lv_obj_get_style_bg_color(obj, LV_PART_SCROLLBAR);
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().misses);
+
+    /*Only the draw properties are stored*/
+    lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
+    lv_obj_get_style_pad_top(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().misses);
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().hits);
+
+#if LV_USE_PERF_MONITOR == 0 && LV_USE_MEM_MONITOR == 0
+    /*Redrawing an unchanged object needs no lookups (the monitors would change their labels)*/
+    lv_refr_now(NULL);
+    lv_obj_style_snapshot_reset_stats();
+    lv_obj_invalidate(obj);
+    lv_refr_now(NULL);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stats().misses);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, get_stats().hits);
+#endif
+
+    lv_obj_enable_style_snapshot(false);
+    lv_obj_style_snapshot_reset_stats();
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stats().misses);
+    TEST_ASSERT_EQUAL_UINT32(0, get_stats().hits);
+}
+
+void test_style_snapshot_follows_the_changes(void)
+{
+    lv_obj_t * parent = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(parent);
+    lv_obj_t * child = lv_obj_create(parent);
+    lv_obj_remove_style_all(child);
+    lv_obj_t * label = lv_label_create(child);
+
+    /*Local style of a grandparent*/
+    lv_obj_set_style_text_color(parent, lv_color_hex(0xff0000), 0);
+    TEST_ASSERT_EQUAL_HEX32(0xffff0000, text_color(label));
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x0000ff), 0);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000ff, text_color(label));
+
+    /*State of the parent*/
+    lv_obj_set_style_text_color(child, lv_color_hex(0x00ff00), LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000ff, text_color(label));
+    lv_obj_add_state(child, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_HEX32(0xff00ff00, text_color(label));
+    lv_obj_clear_state(child, LV_STATE_CHECKED);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000ff, text_color(label));
+
+    /*Shared style reported to the objects*/
+    static lv_style_t style;
+    lv_style_init(&style);
+    lv_style_set_text_color(&style, lv_color_hex(0xffff00));
+    lv_obj_add_style(child, &style, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xffffff00, text_color(label));
+    lv_style_set_text_color(&style, lv_color_hex(0x00ffff));
+    lv_obj_report_style_change(&style);
+    TEST_ASSERT_EQUAL_HEX32(0xff00ffff, text_color(label));
+
+    /*Shared style changed without report, e.g. only a redraw was requested*/
+    lv_style_set_text_color(&style, lv_color_hex(0xff00ff));
+    TEST_ASSERT_EQUAL_HEX32(0xffff00ff, text_color(label));
+
+    /*New parent*/
+    lv_obj_set_parent(label, parent);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000ff, text_color(label));
+
+    /*Removed style*/
+    lv_obj_set_parent(label, child);
+    lv_obj_remove_style(child, &style, 0);
+    TEST_ASSERT_EQUAL_HEX32(0xff0000ff, text_color(label));
+
+    /*The opacity of the parents*/
+    lv_obj_get_style_opa_recursive(label, LV_PART_MAIN);
+    lv_obj_set_style_opa(parent, LV_OPA_50, 0);
+    TEST_ASSERT_EQUAL_UINT8(LV_OPA_50 * 255 >> 8, lv_obj_get_style_opa_recursive(label, LV_PART_MAIN));
+
+    /*Changed while the refreshing is disabled*/
+    lv_obj_enable_style_refresh(false);
+    lv_obj_set_style_text_color(parent, lv_color_hex(0x123456), 0);
+    lv_obj_enable_style_refresh(true);
+    TEST_ASSERT_EQUAL_HEX32(0xff123456, text_color(label));
+
+    lv_style_reset(&style);
+    TEST_ASSERT_GREATER_THAN_UINT32(0, get_stats().invalidations);
+}
+
+void test_style_snapshot_of_deleted_object_is_dropped(void)
+{
+    /*Without styles nothing is refreshed when it's deleted*/
+    lv_obj_t * obj = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(obj);
+    lv_obj_get_style_bg_color(obj, LV_PART_MAIN);
+    lv_obj_get_style_bg_color(obj, LV_PART_SCROLLBAR);
+    lv_obj_style_snapshot_reset_stats();
+    lv_obj_del(obj);
+    TEST_ASSERT_EQUAL_UINT32(2, get_stats().invalidations);
+
+    uint32_t i;
+    for(i = 0; i < 2 * LV_OBJ_STYLE_SNAPSHOT_CNT; i++) {
+        /*The new object is likely allocated where the previous one was*/
+        obj = lv_obj_create(lv_scr_act());
+        lv_obj_remove_style_all(obj);
+        if(i & 1) lv_obj_set_style_bg_color(obj, lv_color_hex(0x00ff00), 0);
+        uint32_t expected = (i & 1) ? 0xff00ff00 : lv_color_to32(lv_style_prop_get_default(LV_STYLE_BG_COLOR).color);
+        TEST_ASSERT_EQUAL_HEX32(expected, lv_color_to32(lv_obj_get_style_bg_color(obj, LV_PART_MAIN)));
+        lv_obj_del(obj);
+    }
+}
+
+void test_style_snapshot_draws_the_same_pixels(void)
+{
+    /*Widgets with several parts, states, inherited text properties, opacity and color filter*/
+    lv_obj_t * cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 700, 450);
+    lv_obj_set_flex_flow(cont, LV_FLEX_FLOW_ROW_WRAP);
+    lv_obj_set_style_text_color(cont, lv_palette_main(LV_PALETTE_RED), 0);
+
+    lv_obj_t * btn = lv_btn_create(cont);
+    lv_label_set_text(lv_label_create(btn), "Button");
+    lv_obj_t * btn_checked = lv_btn_create(cont);
+    lv_obj_add_flag(btn_checked, LV_OBJ_FLAG_CHECKABLE);
+    lv_obj_add_state(btn_checked, LV_STATE_CHECKED);
+    lv_label_set_text(lv_label_create(btn_checked), "Checked");
+
+    lv_obj_t * slider = lv_slider_create(cont);
+    lv_slider_set_value(slider, 40, LV_ANIM_OFF);
+    lv_obj_t * arc = lv_arc_create(cont);
+    lv_arc_set_value(arc, 70);
+    lv_obj_t * cb = lv_checkbox_create(cont);
+    lv_checkbox_set_text(cb, "Checkbox");
+    lv_obj_t * sw = lv_switch_create(cont);
+    lv_obj_add_state(sw, LV_STATE_CHECKED);
+    lv_obj_t * label = lv_label_create(cont);
+    lv_label_set_text(label, "Inherited color");
+
+    lv_obj_t * faded = lv_obj_create(cont);
+    lv_obj_set_style_opa(faded, LV_OPA_50, 0);
+    lv_label_set_text(lv_label_create(faded), "Faded");
+
+    static lv_color_filter_dsc_t filter;
+    lv_color_filter_dsc_init(&filter, darken);
+    lv_obj_t * filtered = lv_btn_create(cont);
+    lv_obj_set_style_color_filter_dsc(filtered, &filter, 0);
+    lv_obj_set_style_color_filter_opa(filtered, LV_OPA_40, 0);
+    lv_label_set_text(lv_label_create(filtered), "Filtered");
+
+    lv_obj_enable_style_snapshot(false);
+    uint32_t ref = render_hash();
+
+    lv_obj_enable_style_snapshot(true);
+    TEST_ASSERT_EQUAL_HEX32(ref, render_hash());
+    TEST_ASSERT_EQUAL_HEX32(ref, render_hash());
+    TEST_ASSERT_GREATER_THAN_UINT32(0, get_stats().hits);
+
+    /*Change the styles and states after the snapshots were taken*/
+    lv_obj_set_style_text_color(cont, lv_palette_main(LV_PALETTE_GREEN), 0);
+    lv_obj_add_state(cb, LV_STATE_CHECKED);
+    lv_obj_clear_state(sw, LV_STATE_CHECKED);
+    lv_obj_set_style_bg_color(slider, lv_palette_main(LV_PALETTE_ORANGE), LV_PART_KNOB);
+    lv_obj_set_style_opa(faded, LV_OPA_70, 0);
+    uint32_t changed = render_hash();
+    TEST_ASSERT_NOT_EQUAL(ref, changed);
+
+    lv_obj_enable_style_snapshot(false);
+    TEST_ASSERT_EQUAL_HEX32(render_hash(), changed);
+}
+
+#else
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+void test_style_snapshot_counts_lookups_avoided(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_OBJ_STYLE_SNAPSHOT_CNT > 0");
+}
+
+void test_style_snapshot_follows_the_changes(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_OBJ_STYLE_SNAPSHOT_CNT > 0");
+}
+
+void test_style_snapshot_of_deleted_object_is_dropped(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_OBJ_STYLE_SNAPSHOT_CNT > 0");
+}
+
+void test_style_snapshot_draws_the_same_pixels(void)
+{
+    TEST_IGNORE_MESSAGE("Only with LV_OBJ_STYLE_SNAPSHOT_CNT > 0");
+}
+
+#endif
+
+#endif
@@ -0,0 +1,168 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+#include "lv_test_indev.h"
+
+#if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
+    /*The monitors are updated in every 300 ms and their labels are refreshed then,
+     *sometimes twice if the size of the label changes*/
+    #define MONITOR_WAKEUPS(ms)     ((ms) / 300 * 3 + 2)
+#else
+    #define MONITOR_WAKEUPS(ms)     0
+#endif
+
+static uint32_t sim_time;
+static uint32_t timer_cnt;
+static uint32_t notify_cnt;
+
+static uint32_t sim_tick_cb(void)
+{
+    return sim_time;
+}
+
+static void timer_cb(lv_timer_t * t)
+{
+    LV_UNUSED(t);
+    timer_cnt++;
+}
+
+#if LV_CMD_QUEUE_LEN
+static void notify_cb(void)
+{
+    notify_cnt++;
+}
+#endif
+
+static void set_indev_timers_paused(bool paused)
+{
+    lv_indev_t * indevs[] = {lv_test_mouse_indev, lv_test_keypad_indev, lv_test_encoder_indev};
+    uint32_t i;
+    for(i = 0; i < sizeof(indevs) / sizeof(indevs[0]); i++) {
+        lv_timer_t * t = indevs[i]->driver->read_timer;
+        if(paused) lv_timer_pause(t);
+        else lv_timer_resume(t);
+    }
+}
+
+/**
+ * Sleep until the time returned by `lv_timer_handler` like a tickless main loop.
+ * A text is posted to `label` in every `post_period` ms which wakes up the loop too.
+ * @return the number of wakeups
+ */
+static uint32_t run_tickless(uint32_t duration, lv_obj_t * label, uint32_t post_period)
+{
+    uint32_t end = sim_time + duration;
+    uint32_t next_post = label ? sim_time + post_period : UINT32_MAX;
+    uint32_t wakeups = 0;
+    while(true) {
+        uint32_t wait = lv_timer_handler();
+        wakeups++;
+
+        uint32_t wake = wait == LV_NO_TIMER_READY ? UINT32_MAX : sim_time + wait;
+        if(wake > next_post) wake = next_post;
+        if(wake > end) break;
+        sim_time = wake;
+
+        if(sim_time == next_post) {
+#if LV_CMD_QUEUE_LEN
+            char buf[16];
+            lv_snprintf(buf, sizeof(buf), "%u", (unsigned)sim_time);
+            TEST_ASSERT_TRUE(lv_cmd_queue_post_text(label, buf));
+#endif
+            next_post += post_period;
+        }
+    }
+    sim_time = end;
+    return wakeups;
+}
+
+void setUp(void)
+{
+    /*Continue the simulated time of the previous test, the timers expect it not to go back*/
+    if((int32_t)(lv_tick_get() - sim_time) > 0) sim_time = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+    set_indev_timers_paused(true);
+    timer_cnt = 0;
+    notify_cnt = 0;
+
+    /*Get rid of the pending refreshes*/
+    uint32_t i;
+    for(i = 0; i < 3; i++) {
+        lv_timer_handler();
+        sim_time += 100;
+    }
+}
+
+void tearDown(void)
+{
+    set_indev_timers_paused(false);
+    lv_cmd_queue_set_notify_cb(NULL);
+    lv_tick_set_cb(NULL);
+    lv_obj_clean(lv_scr_act());
+}
+
+void test_tick_is_read_from_the_callback(void)
+{
+    sim_time += 1234;
+    TEST_ASSERT_EQUAL(sim_time, lv_tick_get());
+    TEST_ASSERT_EQUAL(1234, lv_tick_elaps(sim_time - 1234));
+
+    /*lv_tick_inc() doesn't matter while the callback is set*/
+    lv_tick_inc(100);
+    TEST_ASSERT_EQUAL(sim_time, lv_tick_get());
+}
+
+void test_idle_screen_sleeps_until_woken_up(void)
+{
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "idle");
+    lv_timer_handler();
+
+#if MONITOR_WAKEUPS(1) == 0
+    /*Nothing to refresh and no timer to run*/
+    TEST_ASSERT_EQUAL(LV_NO_TIMER_READY, lv_timer_handler());
+#endif
+    TEST_ASSERT_LESS_OR_EQUAL(1 + MONITOR_WAKEUPS(10000), run_tickless(10000, NULL, 0));
+}
+
+void test_wakes_up_only_for_the_timers(void)
+{
+    lv_timer_t * t = lv_timer_create(timer_cb, 250, NULL);
+
+    uint32_t wakeups = run_tickless(5000, NULL, 0);
+    TEST_ASSERT_EQUAL(20, timer_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(21 + MONITOR_WAKEUPS(5000), wakeups);
+
+    /*A paused timer doesn't wake up the loop*/
+    lv_timer_pause(t);
+    TEST_ASSERT_LESS_OR_EQUAL(1 + MONITOR_WAKEUPS(5000), run_tickless(5000, NULL, 0));
+    TEST_ASSERT_EQUAL(20, timer_cnt);
+
+    lv_timer_del(t);
+}
+
+void test_posted_command_wakes_up(void)
+{
+#if LV_CMD_QUEUE_LEN
+    lv_cmd_queue_set_notify_cb(notify_cb);
+
+    lv_obj_t * label = lv_label_create(lv_scr_act());
+    lv_timer_handler();
+
+    /*Once per post: the label is refreshed in the same wakeup*/
+    uint32_t wakeups = run_tickless(10000, label, 1000);
+    TEST_ASSERT_EQUAL(10, notify_cnt);
+    TEST_ASSERT_LESS_OR_EQUAL(11 + MONITOR_WAKEUPS(10000), wakeups);
+
+    /*The last post is applied by the next wakeup*/
+    lv_timer_handler();
+    char buf[16];
+    lv_snprintf(buf, sizeof(buf), "%u", (unsigned)sim_time);
+    TEST_ASSERT_EQUAL_STRING(buf, lv_label_get_text(label));
+#else
+    TEST_IGNORE_MESSAGE("Requires LV_CMD_QUEUE_LEN");
+#endif
+}
+
+#endif
@@ -0,0 +1,333 @@
+#if LV_BUILD_TEST
+#include "../lvgl.h"
+
+#include "unity/unity.h"
+
+#define RANDOM_TIMER_CNT    500
+#define RANDOM_STEP_CNT     3000
+
+typedef struct {
+    uint32_t runs;
+    uint32_t prev_run;
+    lv_timer_t * other;     /*Deleted or made ready by the callback*/
+} timer_data_t;
+
+static uint32_t sim_time;
+static uint32_t order[16];
+static uint32_t order_cnt;
+static uint32_t rnd;
+
+static uint32_t sim_tick_cb(void)
+{
+    return sim_time;
+}
+
+static uint32_t next_rnd(void)
+{
+    rnd = rnd * 1103515245 + 12345;
+    return rnd >> 16;
+}
+
+/*`user_data` is the number to record in `order`*/
+static void record_cb(lv_timer_t * t)
+{
+    order[order_cnt++] = (uint32_t)(lv_uintptr_t)t->user_data;
+}
+
+static void count_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    d->runs++;
+}
+
+static void create_cb(lv_timer_t * t)
+{
+    record_cb(t);
+    lv_timer_t * created = lv_timer_create(record_cb, 0, (void *)10);
+    lv_timer_set_repeat_count(created, 1);
+}
+
+static void del_other_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    d->runs++;
+    if(d->other) {
+        lv_timer_del(d->other);
+        d->other = NULL;
+    }
+}
+
+static void del_self_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    d->runs++;
+    lv_timer_del(t);
+}
+
+static void ready_other_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    d->runs++;
+    lv_timer_ready(d->other);
+}
+
+/*Check that it didn't run earlier than its period*/
+static void random_cb(lv_timer_t * t)
+{
+    timer_data_t * d = t->user_data;
+    if(d->runs) TEST_ASSERT_GREATER_OR_EQUAL(t->period, sim_time - d->prev_run);
+    d->runs++;
+    d->prev_run = sim_time;
+}
+
+void setUp(void)
+{
+    /*The timers expect the time not to go back*/
+    if((int32_t)(lv_tick_get() - sim_time) > 0) sim_time = lv_tick_get();
+    lv_tick_set_cb(sim_tick_cb);
+    order_cnt = 0;
+    rnd = 1;
+}
+
+void tearDown(void)
+{
+    lv_tick_set_cb(NULL);
+}
+
+void test_timers_run_in_the_order_of_their_deadlines(void)
+{
+    lv_timer_t * t30 = lv_timer_create(record_cb, 30, (void *)30);
+    lv_timer_t * t10 = lv_timer_create(record_cb, 10, (void *)10);
+    lv_timer_t * t20 = lv_timer_create(record_cb, 20, (void *)20);
+
+    /*All of them are ready, the most overdue runs first*/
+    sim_time += 30;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(3, order_cnt);
+    TEST_ASSERT_EQUAL(10, order[0]);
+    TEST_ASSERT_EQUAL(20, order[1]);
+    TEST_ASSERT_EQUAL(30, order[2]);
+
+    /*The same deadline: the newer timer runs first like with the list*/
+    lv_timer_t * t30b = lv_timer_create(record_cb, 30, (void *)31);
+    lv_timer_set_period(t10, 30);
+    lv_timer_set_period(t20, 30);
+    lv_timer_reset(t10);
+    lv_timer_reset(t20);
+    lv_timer_reset(t30);
+    order_cnt = 0;
+    sim_time += 30;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(4, order_cnt);
+    TEST_ASSERT_EQUAL(31, order[0]);
+    TEST_ASSERT_EQUAL(20, order[1]);
+    TEST_ASSERT_EQUAL(10, order[2]);
+    TEST_ASSERT_EQUAL(30, order[3]);
+
+    lv_timer_del(t10);
+    lv_timer_del(t20);
+    lv_timer_del(t30);
+    lv_timer_del(t30b);
+}
+
+void test_timer_runs_at_most_once_per_call(void)
+{
+    timer_data_t d1 = {0};
+    timer_data_t d2 = {0};
+    lv_timer_t * t1 = lv_timer_create(ready_other_cb, 10, &d1);
+    lv_timer_t * t2 = lv_timer_create(ready_other_cb, 10, &d2);
+    d1.other = t2;
+    d2.other = t1;
+
+    /*They make each other ready again but they run only in the next ms*/
+    sim_time += 10;
+    TEST_ASSERT_EQUAL(1, lv_timer_handler());
+    TEST_ASSERT_EQUAL(1, d1.runs);
+    TEST_ASSERT_EQUAL(1, d2.runs);
+
+    sim_time += 1;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, d1.runs);
+    TEST_ASSERT_EQUAL(2, d2.runs);
+
+    lv_timer_del(t1);
+    lv_timer_del(t2);
+
+    /*A timer with 0 period runs in every ms*/
+    timer_data_t d0 = {0};
+    lv_timer_t * t0 = lv_timer_create(count_cb, 0, &d0);
+    lv_timer_handler();
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, d0.runs);
+    sim_time += 1;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, d0.runs);
+    lv_timer_del(t0);
+}
+
+void test_timer_created_in_callback(void)
+{
+    lv_timer_t * t = lv_timer_create(create_cb, 10, (void *)1);
+    lv_timer_set_repeat_count(t, 1);
+
+    /*The new timer is ready at once so it runs in the same call and it's deleted after that*/
+    sim_time += 10;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, order_cnt);
+    TEST_ASSERT_EQUAL(1, order[0]);
+    TEST_ASSERT_EQUAL(10, order[1]);
+
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        TEST_ASSERT_TRUE(timer->timer_cb != record_cb);
+        TEST_ASSERT_TRUE(timer->timer_cb != create_cb);
+    }
+}
+
+void test_timer_deleted_in_callback(void)
+{
+    timer_data_t d1 = {0};
+    timer_data_t d2 = {0};
+    timer_data_t d3 = {0};
+
+    /*The first one deletes the ready second one before it runs*/
+    lv_timer_t * t1 = lv_timer_create(del_other_cb, 10, &d1);
+    lv_timer_t * t2 = lv_timer_create(count_cb, 20, &d2);
+    d1.other = t2;
+    lv_timer_create(del_self_cb, 20, &d3);
+
+    sim_time += 20;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, d1.runs);
+    TEST_ASSERT_EQUAL(0, d2.runs);
+    TEST_ASSERT_EQUAL(1, d3.runs);
+
+    /*The deleted ones don't run anymore*/
+    sim_time += 20;
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, d1.runs);
+    TEST_ASSERT_EQUAL(0, d2.runs);
+    TEST_ASSERT_EQUAL(1, d3.runs);
+
+    lv_timer_del(t1);
+}
+
+void test_paused_timer(void)
+{
+    timer_data_t d = {0};
+    lv_timer_t * t = lv_timer_create(count_cb, 10, &d);
+    lv_timer_t * t_late = lv_timer_create(count_cb, 100, &d);
+
+    lv_timer_pause(t);
+    sim_time += 50;
+    uint32_t wait = lv_timer_handler();
+    TEST_ASSERT_EQUAL(0, d.runs);
+
+    /*The overdue paused timer doesn't shorten the wait*/
+    TEST_ASSERT_GREATER_THAN(0, wait);
+
+    /*It's overdue when resumed*/
+    lv_timer_resume(t);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(1, d.runs);
+
+    /*Pause in its own callback*/
+    lv_timer_set_cb(t, lv_timer_pause);
+    sim_time += 10;
+    lv_timer_handler();
+    TEST_ASSERT_TRUE(t->paused);
+    TEST_ASSERT_EQUAL(LV_TIMER_NOT_SCHEDULED, t->heap_idx);
+
+    lv_timer_del(t);
+    lv_timer_del(t_late);
+}
+
+void test_timer_repeat_count(void)
+{
+    timer_data_t d = {0};
+    lv_timer_t * t = lv_timer_create(count_cb, 10, &d);
+    lv_timer_set_repeat_count(t, 2);
+
+    uint32_t i;
+    for(i = 0; i < 5; i++) {
+        sim_time += 10;
+        lv_timer_handler();
+    }
+    TEST_ASSERT_EQUAL(2, d.runs);
+
+    /*Stopped by the repeat count: deleted in the next call without running it*/
+    t = lv_timer_create(count_cb, 1000, &d);
+    lv_timer_set_repeat_count(t, 0);
+    lv_timer_handler();
+    TEST_ASSERT_EQUAL(2, d.runs);
+
+    lv_timer_t * timer = NULL;
+    while((timer = lv_timer_get_next(timer)) != NULL) {
+        TEST_ASSERT_TRUE(timer->timer_cb != count_cb);
+    }
+}
+
+void test_many_random_timers(void)
+{
+    static timer_data_t data[RANDOM_TIMER_CNT];
+    static lv_timer_t * timers[RANDOM_TIMER_CNT];
+    lv_memset_00(data, sizeof(data));
+
+    uint32_t i;
+    for(i = 0; i < RANDOM_TIMER_CNT; i++) {
+        timers[i] = lv_timer_create(random_cb, 1 + next_rnd() % 500, &data[i]);
+    }
+
+    uint32_t step;
+    for(step = 0; step < RANDOM_STEP_CNT; step++) {
+        /*Change some timers*/
+        uint32_t j;
+        for(j = 0; j < 5; j++) {
+            i = next_rnd() % RANDOM_TIMER_CNT;
+            lv_timer_t * t = timers[i];
+            switch(next_rnd() % 6) {
+                case 0:
+                    lv_timer_del(t);
+                    data[i].runs = 0;
+                    timers[i] = lv_timer_create(random_cb, 1 + next_rnd() % 500, &data[i]);
+                    break;
+                case 1:
+                    lv_timer_pause(t);
+                    break;
+                case 2:
+                    lv_timer_resume(t);
+                    break;
+                case 3:
+                    lv_timer_set_period(t, 1 + next_rnd() % 500);
+                    data[i].runs = 0;
+                    break;
+                case 4:
+                    lv_timer_reset(t);
+                    data[i].runs = 0;
+                    break;
+                case 5:
+                    lv_timer_ready(t);
+                    data[i].runs = 0;
+                    break;
+            }
+        }
+
+        sim_time += next_rnd() % 20;
+        uint32_t wait = lv_timer_handler();
+
+        /*No ready timer is left and the wait is the time until the closest one*/
+        uint32_t min_remaining = LV_NO_TIMER_READY;
+        lv_timer_t * t = NULL;
+        while((t = lv_timer_get_next(t)) != NULL) {
+            if(t->paused) continue;
+            uint32_t elaps = sim_time - t->last_run;
+            TEST_ASSERT_LESS_THAN(t->period, elaps);
+            if(t->period - elaps < min_remaining) min_remaining = t->period - elaps;
+        }
+        TEST_ASSERT_EQUAL(min_remaining, wait);
+    }
+
+    for(i = 0; i < RANDOM_TIMER_CNT; i++) lv_timer_del(timers[i]);
+}
+
+#endif